@@ -27,6 +27,9 @@ extern "C" {
 
 #define MAX_ENC_PRESET                              7
 
+#define EB_CPU_MASK_WORD_COUNT                      16  // cpu_mask covers logical processors 0 to 1023
+#define EB_MAX_STAGE_THREAD_COUNT                   (EB_CPU_MASK_WORD_COUNT * 64) // per pipeline stage, one per logical processor of cpu_mask
+
 #ifdef _WIN32
 #define EB_API __declspec(dllexport)
 #else
@@ -109,6 +112,7 @@ EbBool is a 32 bit quantity and is aligned on a 32 bit word boundary.
 
 #if TILES
 #define EB_BUFFERFLAG_TG            0x00000004  // signals that the packet contains Tile Group header
+#define EB_BUFFERFLAG_PARTIAL       0x00000008  // signals a tile group of a picture whose last tile group comes in a later packet
 #endif
     // For 8-bit and 10-bit packed inputs, the luma, cb, and cr fields should be used
     //   for the three input picture planes.  However, for 10-bit unpacked planes the
@@ -132,6 +136,101 @@ EbBool is a 32 bit quantity and is aligned on a 32 bit word boundary.
 
     } EbSvtEncInput;
 
+    // Layout of the frame buffers sent when zero_copy_input is enabled. The
+    //   luma, cb and cr fields of EbSvtEncInput point to the first active
+    //   sample of each 8-bit plane; the planes must use the strides below and
+    //   extend lumaOffset / chromaOffset bytes before that sample and up to
+    //   lumaSize / chromaSize bytes in total.
+    typedef struct EbSvtInputLayout
+    {
+        uint32_t yStride;
+        uint32_t cbStride;
+        uint32_t crStride;
+
+        uint32_t lumaOffset;
+        uint32_t chromaOffset;
+        uint32_t lumaSize;
+        uint32_t chromaSize;
+
+    } EbSvtInputLayout;
+
+    // Returns a frame buffer sent with zero_copy_input to the application.
+    //   p_buffer is only valid during the call: its p_buffer field holds the
+    //   EbSvtEncInput planes that were sent, p_app_private and pts are the
+    //   ones of the sent header.
+    typedef void (*EbInputReleaseCallback)(
+        void               *release_context,
+        EbBufferHeaderType *p_buffer);
+
+    // Receives a packet or a recon picture as soon as the pipeline completes
+    //   it, see output_packet_callback. Called from the encoder threads.
+    typedef void (*EbOutputCallback)(
+        void               *output_context,
+        EbBufferHeaderType *p_buffer);
+
+    // Pipeline profiler events, see pipeline_profiling. Times are in
+    //   microseconds since eb_init_encoder. object_id is the picture number
+    //   carried by the object, ~0 when the object does not carry one.
+    typedef enum EbPipelineEventType
+    {
+        EB_PIPELINE_EVENT_ENQUEUE = 0,  // object posted to the stage input queue
+        EB_PIPELINE_EVENT_DEQUEUE = 1,  // object taken by a stage thread, duration is the time the thread waited
+        EB_PIPELINE_EVENT_BUSY    = 2   // a stage thread processed the object for duration
+    } EbPipelineEventType;
+
+    typedef struct EbPipelineEvent
+    {
+        uint64_t timestamp;
+        uint64_t duration;
+        uint64_t object_id;
+        uint32_t stage;
+        uint32_t thread_index;
+        uint32_t queue_depth;           // objects left in the stage input queue
+        uint32_t type;                  // EbPipelineEventType
+
+    } EbPipelineEvent;
+
+    typedef struct EbPipelineStageStats
+    {
+        const char *name;
+        uint32_t    thread_count;       // the *_process_init_count of the stage
+        uint64_t    busy_time;          // summed over the stage threads
+        uint64_t    idle_time;          // time the stage threads waited on the input queue
+        uint64_t    object_count;
+        uint32_t    max_queue_depth;
+        double      average_queue_depth;
+
+    } EbPipelineStageStats;
+
+    typedef struct EbPipelineProfile
+    {
+        uint32_t              stage_count;
+        EbPipelineStageStats *stage_array;
+        uint32_t              event_count;
+        EbPipelineEvent      *event_array;
+        uint64_t              dropped_event_count; // events past the recording capacity
+        uint64_t              elapsed_time;
+
+    } EbPipelineProfile;
+
+    // Startup profile, see eb_svt_enc_get_startup_profile
+    typedef struct EbStartupStep
+    {
+        const char *name;
+        uint64_t    time;               // microseconds
+        uint64_t    memory;             // bytes allocated by the step
+
+    } EbStartupStep;
+
+    typedef struct EbStartupProfile
+    {
+        uint32_t       step_count;
+        EbStartupStep *step_array;
+        uint64_t       total_time;      // microseconds spent in eb_init_encoder
+        uint64_t       total_memory;    // bytes allocated by the library
+
+    } EbStartupProfile;
+
 // Will contain the EbEncApi which will live in the EncHandle class
 // Only modifiable during config-time.
 typedef struct EbSvtAv1EncConfiguration
@@ -234,6 +333,29 @@ typedef struct EbSvtAv1EncConfiguration
      *
      * Default is 0. */
     uint32_t                 compressed_ten_bit_format;
+
+    /* Encode directly from the frame buffers passed to eb_svt_enc_send_picture
+     * instead of copying them. The buffers must follow the layout returned by
+     * eb_svt_enc_get_input_layout, the encoder writes to their padding and
+     * hands each one back through input_release_callback once it no longer
+     * reads it. Requires 8-bit input.
+     *
+     * Default is 0. */
+    uint32_t                 zero_copy_input;
+    EbInputReleaseCallback   input_release_callback;
+    void                    *input_release_context;
+
+    /* Hand each packet to output_packet_callback from the packetization
+     * thread as soon as its temporal unit is complete, instead of queuing it
+     * for eb_svt_get_packet. With recon_enabled, output_recon_callback gets
+     * the recon pictures the same way instead of eb_svt_get_recon. Either
+     * buffer belongs to the application until it is given back with
+     * eb_svt_release_out_buffer; the pipeline stalls when they are all held.
+     *
+     * Default is NULL. */
+    EbOutputCallback         output_packet_callback;
+    EbOutputCallback         output_recon_callback;
+    void                    *output_callback_context;
     /* Number of frames of sequence to be encoded. If number of frames is greater
      * than the number of frames in file, the encoder will loop to the beginning
      * and continue the encode.
@@ -348,6 +470,17 @@ typedef struct EbSvtAv1EncConfiguration
      *
      * Default depends on input resolution. */
     uint32_t                 search_area_height;
+    /* Size the search area of each SB from its HME results: the area shrinks
+     * around the HME center where the HME search regions agree on the motion,
+     * and grows up to twice its size where they do not.
+     *
+     * Default is 0. */
+    uint32_t                 adaptive_me_search_range;
+    /* Skip the motion search of the 64x64 SBs unchanged from the list 0
+     * reference, and code them as a single zero motion block.
+     *
+     * Default is 0. */
+    uint32_t                 static_sb_fast_path;
 
     // HME Parameters
     /* Number of search positions in width and height for the HME
@@ -507,6 +640,74 @@ typedef struct EbSvtAv1EncConfiguration
      * Default is -1. */
     int32_t                 target_socket;
 
+    /* NUMA node the encoder threads run on. The buffer pools are also
+     * allocated from this node: eb_init_encoder runs on its processors so
+     * that the pools are first touched there. Overrides logical_processors
+     * and target_socket.
+     *
+     * -1 = No node binding.
+     *
+     * Default is -1. */
+    int32_t                 numa_node;
+
+    /* Explicit set of logical processors the encoder threads run on, bit
+     * (n % 64) of cpu_mask[n / 64] selecting processor n. eb_init_encoder
+     * runs on the same set. Overrides numa_node, logical_processors and
+     * target_socket when any bit is set.
+     *
+     * On Windows processors are numbered across the processor groups in
+     * group order, and the threads run on the processors of the group of
+     * the first one selected.
+     *
+     * Default is all 0. */
+    uint64_t                cpu_mask[EB_CPU_MASK_WORD_COUNT];
+
+    /* Number of threads of each multi-threaded pipeline stage, at most
+     * EB_MAX_STAGE_THREAD_COUNT.
+     *
+     * 0 = Derived from the number of logical processors the encoder runs on.
+     *
+     * Default is 0. */
+    uint32_t                picture_analysis_thread_count;
+    uint32_t                motion_estimation_thread_count;
+    uint32_t                source_based_operations_thread_count;
+    uint32_t                mode_decision_configuration_thread_count;
+    uint32_t                enc_dec_thread_count;
+    uint32_t                dlf_thread_count;
+    uint32_t                cdef_thread_count;
+    uint32_t                rest_thread_count;
+    uint32_t                entropy_coding_thread_count;
+
+    /* Memory budget of the library in MB. The picture control set, reference
+     * picture and input buffer pools are allocated with the few buffers the
+     * pipeline needs to run, and grow on demand up to their default size as
+     * long as the budget allows. Buffers that stay unused are freed again.
+     * Once the budget is reached, the pipeline runs with the buffers it has
+     * instead of failing.
+     *
+     * 0 = No budget, all the pools are fully allocated by eb_init_encoder.
+     * Requires lock_free_queues.
+     *
+     * Default is 0. */
+    uint32_t                memory_budget;
+
+    /* Pass the objects between the pipeline stages through lock-free queues
+     * instead of the mutex and semaphore based fifos. The waiting threads
+     * spin for a short while before sleeping.
+     *
+     * Default is 0. */
+    uint32_t                lock_free_queues;
+
+    /* Let a picture enter EncDec before its references are complete. Each SB
+     * row of the picture waits until the rows of its references that its
+     * motion vectors can reach are coded, deblocked and padded, so that
+     * consecutive pictures overlap in EncDec. The deblocking filter runs one
+     * SB row behind EncDec and picks its levels from the QP. Disables CDEF
+     * and loop restoration.
+     *
+     * Default is 0. */
+    uint32_t                frame_row_overlap;
+
     // Debug tools
 
     /* Output reconstructed yuv used for debug purposes. The value is set through
@@ -514,12 +715,29 @@ typedef struct EbSvtAv1EncConfiguration
      *
      * Default is 0. */
     uint32_t                 recon_enabled;
+
+    /* Record the busy and idle time, the input queue occupancy and the
+     * per-picture queue timestamps of every pipeline stage, see
+     * eb_svt_enc_get_pipeline_profile. Adds a lock per queue operation.
+     *
+     * Default is 0. */
+    uint32_t                 pipeline_profiling;
 #if TILES
     /* Log 2 Tile Rows and colums . 0 means no tiling,1 means that we split the dimension
         * into 2
         * Default is 0. */
     int32_t                  tile_columns;
     int32_t                  tile_rows;
+    /* Hand each tile group of a picture but the last to output_packet_callback
+     * as soon as it is entropy coded, in a packet flagged EB_BUFFERFLAG_PARTIAL
+     * that holds one tile group OBU (the first one also holds the temporal
+     * delimiter, sequence header and frame header OBUs). The packet of the
+     * picture then only holds its last tile group. A picture coded ahead of
+     * one before it in decode order has all its tile groups in its packet.
+     * Requires tiles and output_packet_callback.
+     *
+     * Default is 0. */
+    uint32_t                 low_latency_tile_output;
 #endif
 
 } EbSvtAv1EncConfiguration;
@@ -547,6 +765,42 @@ typedef struct EbSvtAv1EncConfiguration
         EbComponentType           *svt_enc_component,
         EbSvtAv1EncConfiguration   *pComponentParameterStructure); // pComponentParameterStructure contents will be copied to the library
 
+    /* Opaque set of worker threads that several encoder handles can share. */
+    typedef struct EbThreadPool EbThreadPool;
+
+    /* OPTIONAL: Create a worker thread pool to be shared by several encoder
+     * handles of the same process. The EncDec, deblocking, CDEF and
+     * restoration stages of every attached handle then run as tasks on
+     * these threads instead of on dedicated per-handle threads.
+     *
+     * Parameter:
+     * @ **thread_pool_dbl_ptr  Returned pool.
+     * @ thread_count           Number of worker threads, 0 for one per logical processor. */
+    EB_API EbErrorType eb_svt_create_thread_pool(
+        EbThreadPool             **thread_pool_dbl_ptr,
+        uint32_t                   thread_count);
+
+    /* OPTIONAL: Attach an encoder handle to a shared thread pool. Must be
+     * called before eb_init_encoder, which creates the stage threads:
+     * EB_ErrorBadParameter is returned once the encoder is initialized. The
+     * handle is detached by eb_deinit_encoder, which cancels its running
+     * tasks as it does the dedicated stage threads.
+     *
+     * Parameter:
+     * @ *svt_enc_component  Encoder handler.
+     * @ *thread_pool_ptr    Pool created by eb_svt_create_thread_pool. */
+    EB_API EbErrorType eb_svt_enc_attach_thread_pool(
+        EbComponentType           *svt_enc_component,
+        EbThreadPool              *thread_pool_ptr);
+
+    /* OPTIONAL: Destroy a shared thread pool once every attached handle has
+     * been deinitialized.
+     *
+     * Parameter:
+     * @ *thread_pool_ptr    Pool created by eb_svt_create_thread_pool. */
+    EB_API EbErrorType eb_svt_destroy_thread_pool(
+        EbThreadPool              *thread_pool_ptr);
+
     /* STEP 3: Initialize encoder and allocates memory to necessary buffers.
      *
      * Parameter:
@@ -554,6 +808,17 @@ typedef struct EbSvtAv1EncConfiguration
     EB_API EbErrorType eb_init_encoder(
         EbComponentType *svt_enc_component);
 
+    /* OPTIONAL: Get the time and memory taken by each step of
+     * eb_init_encoder. The returned array is owned by the library and valid
+     * until eb_deinit_encoder.
+     *
+     * Parameter:
+     * @ *svt_enc_component  Encoder handler.
+     * @ *profile_ptr        Returned profile. */
+    EB_API EbErrorType eb_svt_enc_get_startup_profile(
+        EbComponentType      *svt_enc_component,
+        EbStartupProfile     *profile_ptr);
+
     /* OPTIONAL: Get stream headers at init time.
      *
      * Parameter:
@@ -572,6 +837,16 @@ typedef struct EbSvtAv1EncConfiguration
         EbComponentType           *svt_enc_component,
         EbBufferHeaderType       **output_stream_ptr);
 
+    /* OPTIONAL: Get the frame buffer layout required by zero_copy_input. Valid
+     * after eb_init_encoder.
+     *
+     * Parameter:
+     * @ *svt_enc_component  Encoder handler.
+     * @ *layout_ptr         Returned layout. */
+    EB_API EbErrorType eb_svt_enc_get_input_layout(
+        EbComponentType      *svt_enc_component,
+        EbSvtInputLayout     *layout_ptr);
+
     /* STEP 4: Send the picture.
      *
      * Parameter:
@@ -581,7 +856,7 @@ typedef struct EbSvtAv1EncConfiguration
         EbComponentType      *svt_enc_component,
         EbBufferHeaderType   *p_buffer);
 
-    /* STEP 5: Receive packet.
+    /* STEP 5: Receive packet, when output_packet_callback is not used.
      * Parameter:
     * @ *svt_enc_component  Encoder handler.
      * @ **p_buffer          Header pointer to return packet with.
@@ -595,11 +870,13 @@ typedef struct EbSvtAv1EncConfiguration
     /* STEP 5-1: Release output buffer back into the pool.
      *
      * Parameter:
-     * @ **p_buffer          Header pointer that contains the output packet to be released. */
+     * @ **p_buffer          Header pointer that contains the output packet (or the recon
+     *                       picture of output_recon_callback) to be released. */
     EB_API void eb_svt_release_out_buffer(
         EbBufferHeaderType  **p_buffer);
 
-    /* OPTIONAL: Fill buffer with reconstructed picture.
+    /* OPTIONAL: Fill buffer with reconstructed picture, when output_recon_callback
+     * is not used.
      *
      * Parameter:
      * @ *svt_enc_component  Encoder handler.
@@ -608,6 +885,17 @@ typedef struct EbSvtAv1EncConfiguration
         EbComponentType      *svt_enc_component,
         EbBufferHeaderType   *p_buffer);
 
+    /* OPTIONAL: Get the pipeline profile recorded so far when
+     * pipeline_profiling is enabled. The returned arrays are owned by the
+     * library and valid until eb_deinit_encoder.
+     *
+     * Parameter:
+     * @ *svt_enc_component  Encoder handler.
+     * @ *profile_ptr        Returned profile. */
+    EB_API EbErrorType eb_svt_enc_get_pipeline_profile(
+        EbComponentType      *svt_enc_component,
+        EbPipelineProfile    *profile_ptr);
+
     /* STEP 6: Deinitialize encoder library.
      *
      * Parameter:
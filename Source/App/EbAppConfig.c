@@ -9,6 +9,7 @@
 
 #include "EbAppConfig.h"
 #include "EbAppInputy4m.h"
+#include "EbAppInputReader.h"
 
 #ifdef _WIN32
 #else
@@ -27,10 +28,12 @@
 #define OUTPUT_RECON_TOKEN              "-o"
 #define ERROR_FILE_TOKEN                "-errlog"
 #define QP_FILE_TOKEN                   "-qp-file"
+#define PIPELINE_TRACE_TOKEN            "-pipeline-trace"
 #define WIDTH_TOKEN                     "-w"
 #define HEIGHT_TOKEN                    "-h"
 #define NUMBER_OF_PICTURES_TOKEN        "-n"
 #define BUFFERED_INPUT_TOKEN            "-nb"
+#define INPUT_PREFETCH_TOKEN            "-input-prefetch"
 #define BASE_LAYER_SWITCH_MODE_TOKEN    "-base-layer-switch-mode" // no Eval
 #define QP_TOKEN                        "-q"
 #define USE_QP_FILE_TOKEN               "-use-q-file"
@@ -62,6 +65,8 @@
 #define IN_LOOP_ME                      "-in-loop-me"
 #define SEARCH_AREA_WIDTH_TOKEN         "-search-w"
 #define SEARCH_AREA_HEIGHT_TOKEN        "-search-h"
+#define ADAPTIVE_SEARCH_AREA_TOKEN      "-adaptive-search"
+#define STATIC_SB_FAST_PATH_TOKEN       "-static-sb"
 #define NUM_HME_SEARCH_WIDTH_TOKEN      "-num-hme-w"
 #define NUM_HME_SEARCH_HEIGHT_TOKEN     "-num-hme-h"
 #define HME_SRCH_T_L0_WIDTH_TOKEN       "-hme-tot-l0-w"
@@ -100,6 +105,20 @@
 #define ASM_TYPE_TOKEN                  "-asm"
 #define THREAD_MGMNT                    "-lp"
 #define TARGET_SOCKET                   "-ss"
+#define NUMA_NODE_TOKEN                 "-numa-node"
+#define CPU_LIST_TOKEN                  "-cpu-list"
+#define PA_THREADS_TOKEN                "-pa-threads"
+#define ME_THREADS_TOKEN                "-me-threads"
+#define SBO_THREADS_TOKEN               "-sbo-threads"
+#define MDC_THREADS_TOKEN               "-mdc-threads"
+#define ENC_DEC_THREADS_TOKEN           "-enc-dec-threads"
+#define DLF_THREADS_TOKEN               "-dlf-threads"
+#define CDEF_THREADS_TOKEN              "-cdef-threads"
+#define REST_THREADS_TOKEN              "-rest-threads"
+#define EC_THREADS_TOKEN                "-ec-threads"
+#define MEMORY_BUDGET_TOKEN             "-memory-budget"
+#define FRAME_ROW_OVERLAP_TOKEN         "-frame-row-overlap"
+#define LOCK_FREE_QUEUES_TOKEN          "-lock-free"
 #define CONFIG_FILE_COMMENT_CHAR    '#'
 #define CONFIG_FILE_NEWLINE_CHAR    '\n'
 #define CONFIG_FILE_RETURN_CHAR     '\r'
@@ -161,12 +180,18 @@ static void SetCfgQpFile                        (const char *value, EbConfig_t *
     if (cfg->qpFile) { fclose(cfg->qpFile); }
     FOPEN(cfg->qpFile,value, "r");
 };
+static void SetCfgPipelineTraceFile             (const char *value, EbConfig_t *cfg)
+{
+    if (cfg->pipelineTraceFile) { fclose(cfg->pipelineTraceFile); }
+    FOPEN(cfg->pipelineTraceFile,value, "w");
+};
 static void SetCfgSourceWidth                   (const char *value, EbConfig_t *cfg) {cfg->sourceWidth = strtoul(value, NULL, 0);};
 static void SetInterlacedVideo                  (const char *value, EbConfig_t *cfg) {cfg->interlacedVideo  = (EbBool) strtoul(value, NULL, 0);};
 static void SetSeperateFields                   (const char *value, EbConfig_t *cfg) {cfg->separateFields = (EbBool) strtoul(value, NULL, 0);};
 static void SetCfgSourceHeight                  (const char *value, EbConfig_t *cfg) {cfg->sourceHeight = strtoul(value, NULL, 0) >> cfg->separateFields;};
 static void SetCfgFramesToBeEncoded             (const char *value, EbConfig_t *cfg) {cfg->framesToBeEncoded = strtol(value,  NULL, 0) << cfg->separateFields;};
 static void SetBufferedInput                    (const char *value, EbConfig_t *cfg) {cfg->bufferedInput = (strtol(value, NULL, 0) != -1 && cfg->separateFields) ? strtol(value, NULL, 0) << cfg->separateFields : strtol(value, NULL, 0);};
+static void SetInputPrefetch                     (const char *value, EbConfig_t *cfg) {cfg->inputPrefetch = (uint32_t)strtoul(value, NULL, 0);};
 static void SetFrameRate                        (const char *value, EbConfig_t *cfg) {
     cfg->frameRate = strtoul(value, NULL, 0);
     if (cfg->frameRate > 1000 ){
@@ -207,6 +232,8 @@ static void SetEnableHmeLevel1Flag              (const char *value, EbConfig_t *
 static void SetEnableHmeLevel2Flag              (const char *value, EbConfig_t *cfg) {cfg->enableHmeLevel2Flag  = (EbBool)strtoul(value, NULL, 0);};
 static void SetCfgSearchAreaWidth               (const char *value, EbConfig_t *cfg) {cfg->searchAreaWidth = strtoul(value, NULL, 0);};
 static void SetCfgSearchAreaHeight              (const char *value, EbConfig_t *cfg) {cfg->searchAreaHeight = strtoul(value, NULL, 0);};
+static void SetCfgAdaptiveSearchArea            (const char *value, EbConfig_t *cfg) {cfg->adaptiveSearchArea = strtoul(value, NULL, 0);};
+static void SetCfgStaticSbFastPath              (const char *value, EbConfig_t *cfg) {cfg->staticSbFastPath = strtoul(value, NULL, 0);};
 static void SetCfgNumberHmeSearchRegionInWidth  (const char *value, EbConfig_t *cfg) {cfg->numberHmeSearchRegionInWidth = strtoul(value, NULL, 0);};
 static void SetCfgNumberHmeSearchRegionInHeight (const char *value, EbConfig_t *cfg) {cfg->numberHmeSearchRegionInHeight = strtoul(value, NULL, 0);};
 static void SetCfgHmeLevel0TotalSearchAreaWidth (const char *value, EbConfig_t *cfg) {cfg->hmeLevel0TotalSearchAreaWidth = strtoul(value, NULL, 0);};
@@ -253,6 +280,38 @@ static void SetLatencyMode                      (const char *value, EbConfig_t *
 static void SetAsmType                          (const char *value, EbConfig_t *cfg)  {cfg->asmType                   = (uint32_t)strtoul(value, NULL, 0);};
 static void SetLogicalProcessors                (const char *value, EbConfig_t *cfg)  {cfg->logicalProcessors         = (uint32_t)strtoul(value, NULL, 0);};
 static void SetTargetSocket                     (const char *value, EbConfig_t *cfg)  {cfg->targetSocket              = (int32_t)strtol(value, NULL, 0);};
+static void SetNumaNode                         (const char *value, EbConfig_t *cfg)  {cfg->numaNode                  = (int32_t)strtol(value, NULL, 0);};
+// Processor list such as "0-15,32-47"
+static void SetCpuList                          (const char *value, EbConfig_t *cfg)
+{
+    char *p = (char*)value;
+
+    memset(cfg->cpuMask, 0, sizeof(cfg->cpuMask));
+    while (*p >= '0' && *p <= '9') {
+        uint32_t first = (uint32_t)strtoul(p, &p, 10);
+        uint32_t last = first;
+        uint32_t cpuIndex;
+
+        if (*p == '-')
+            last = (uint32_t)strtoul(p + 1, &p, 10);
+        for (cpuIndex = first; cpuIndex <= last && cpuIndex < EB_CPU_MASK_WORD_COUNT * 64; ++cpuIndex)
+            cfg->cpuMask[cpuIndex >> 6] |= (uint64_t)1 << (cpuIndex & 63);
+        if (*p == ',')
+            p++;
+    }
+};
+static void SetPictureAnalysisThreads           (const char *value, EbConfig_t *cfg)  {cfg->pictureAnalysisThreads          = (uint32_t)strtoul(value, NULL, 0);};
+static void SetMotionEstimationThreads          (const char *value, EbConfig_t *cfg)  {cfg->motionEstimationThreads         = (uint32_t)strtoul(value, NULL, 0);};
+static void SetSourceBasedOperationsThreads     (const char *value, EbConfig_t *cfg)  {cfg->sourceBasedOperationsThreads    = (uint32_t)strtoul(value, NULL, 0);};
+static void SetModeDecisionConfigurationThreads (const char *value, EbConfig_t *cfg)  {cfg->modeDecisionConfigurationThreads = (uint32_t)strtoul(value, NULL, 0);};
+static void SetEncDecThreads                    (const char *value, EbConfig_t *cfg)  {cfg->encDecThreads                   = (uint32_t)strtoul(value, NULL, 0);};
+static void SetDlfThreads                       (const char *value, EbConfig_t *cfg)  {cfg->dlfThreads                      = (uint32_t)strtoul(value, NULL, 0);};
+static void SetCdefThreads                      (const char *value, EbConfig_t *cfg)  {cfg->cdefThreads                     = (uint32_t)strtoul(value, NULL, 0);};
+static void SetRestThreads                      (const char *value, EbConfig_t *cfg)  {cfg->restThreads                     = (uint32_t)strtoul(value, NULL, 0);};
+static void SetEntropyCodingThreads             (const char *value, EbConfig_t *cfg)  {cfg->entropyCodingThreads            = (uint32_t)strtoul(value, NULL, 0);};
+static void SetMemoryBudget                     (const char *value, EbConfig_t *cfg)  {cfg->memoryBudget                    = (uint32_t)strtoul(value, NULL, 0);};
+static void SetFrameRowOverlap                  (const char *value, EbConfig_t *cfg)  {cfg->frameRowOverlap                 = (uint32_t)strtoul(value, NULL, 0);};
+static void SetLockFreeQueues                   (const char *value, EbConfig_t *cfg)  {cfg->lockFreeQueues                  = (uint32_t)strtoul(value, NULL, 0);};
 
 enum cfg_type{
     SINGLE_INPUT,   // Configuration parameters that have only 1 value input
@@ -280,6 +339,7 @@ config_entry_t config_entry[] = {
     { SINGLE_INPUT, ERROR_FILE_TOKEN, "ErrorFile", SetCfgErrorFile },
     { SINGLE_INPUT, OUTPUT_RECON_TOKEN, "ReconFile", SetCfgReconFile },
     { SINGLE_INPUT, QP_FILE_TOKEN, "QpFile", SetCfgQpFile },
+    { SINGLE_INPUT, PIPELINE_TRACE_TOKEN, "PipelineTraceFile", SetCfgPipelineTraceFile },
 
     // Interlaced Video
     { SINGLE_INPUT, INTERLACED_VIDEO_TOKEN , "InterlacedVideo" , SetInterlacedVideo },
@@ -292,6 +352,7 @@ config_entry_t config_entry[] = {
     // Prediction Structure
     { SINGLE_INPUT, NUMBER_OF_PICTURES_TOKEN, "FrameToBeEncoded", SetCfgFramesToBeEncoded },
     { SINGLE_INPUT, BUFFERED_INPUT_TOKEN, "BufferedInput", SetBufferedInput },
+    { SINGLE_INPUT, INPUT_PREFETCH_TOKEN, "InputPrefetch", SetInputPrefetch },
     { SINGLE_INPUT, BASE_LAYER_SWITCH_MODE_TOKEN, "BaseLayerSwitchMode", SetBaseLayerSwitchMode },
     { SINGLE_INPUT, ENCMODE_TOKEN, "EncoderMode", SetencMode},
     { SINGLE_INPUT, INTRA_PERIOD_TOKEN, "IntraPeriod", SetCfgIntraPeriod },
@@ -336,6 +397,8 @@ config_entry_t config_entry[] = {
     // ME Parameters
     { SINGLE_INPUT, SEARCH_AREA_WIDTH_TOKEN, "SearchAreaWidth", SetCfgSearchAreaWidth },
     { SINGLE_INPUT, SEARCH_AREA_HEIGHT_TOKEN, "SearchAreaHeight", SetCfgSearchAreaHeight },
+    { SINGLE_INPUT, ADAPTIVE_SEARCH_AREA_TOKEN, "AdaptiveSearchArea", SetCfgAdaptiveSearchArea },
+    { SINGLE_INPUT, STATIC_SB_FAST_PATH_TOKEN, "StaticSbFastPath", SetCfgStaticSbFastPath },
 
     // HME Parameters
     { SINGLE_INPUT, NUM_HME_SEARCH_WIDTH_TOKEN, "number_hme_search_region_in_width", SetCfgNumberHmeSearchRegionInWidth },
@@ -349,6 +412,20 @@ config_entry_t config_entry[] = {
     // Thread Management
     { SINGLE_INPUT, THREAD_MGMNT, "logicalProcessors", SetLogicalProcessors },
     { SINGLE_INPUT, TARGET_SOCKET, "TargetSocket", SetTargetSocket },
+    { SINGLE_INPUT, NUMA_NODE_TOKEN, "NumaNode", SetNumaNode },
+    { SINGLE_INPUT, CPU_LIST_TOKEN, "CpuList", SetCpuList },
+    { SINGLE_INPUT, PA_THREADS_TOKEN, "PictureAnalysisThreads", SetPictureAnalysisThreads },
+    { SINGLE_INPUT, ME_THREADS_TOKEN, "MotionEstimationThreads", SetMotionEstimationThreads },
+    { SINGLE_INPUT, SBO_THREADS_TOKEN, "SourceBasedOperationsThreads", SetSourceBasedOperationsThreads },
+    { SINGLE_INPUT, MDC_THREADS_TOKEN, "ModeDecisionConfigurationThreads", SetModeDecisionConfigurationThreads },
+    { SINGLE_INPUT, ENC_DEC_THREADS_TOKEN, "EncDecThreads", SetEncDecThreads },
+    { SINGLE_INPUT, DLF_THREADS_TOKEN, "DlfThreads", SetDlfThreads },
+    { SINGLE_INPUT, CDEF_THREADS_TOKEN, "CdefThreads", SetCdefThreads },
+    { SINGLE_INPUT, REST_THREADS_TOKEN, "RestThreads", SetRestThreads },
+    { SINGLE_INPUT, EC_THREADS_TOKEN, "EntropyCodingThreads", SetEntropyCodingThreads },
+    { SINGLE_INPUT, MEMORY_BUDGET_TOKEN, "MemoryBudget", SetMemoryBudget },
+    { SINGLE_INPUT, FRAME_ROW_OVERLAP_TOKEN, "FrameRowOverlap", SetFrameRowOverlap },
+    { SINGLE_INPUT, LOCK_FREE_QUEUES_TOKEN, "LockFreeQueues", SetLockFreeQueues },
 
     // Optional Features
 
@@ -399,6 +476,7 @@ void EbConfigCtor(EbConfig_t *config_ptr)
     config_ptr->reconFile                            = NULL;
     config_ptr->errorLogFile                         = stderr;
     config_ptr->qpFile                               = NULL;
+    config_ptr->pipelineTraceFile                    = NULL;
 
 
     config_ptr->frameRate                            = 30 << 16;
@@ -413,6 +491,8 @@ void EbConfigCtor(EbConfig_t *config_ptr)
     config_ptr->framesToBeEncoded                    = 0;
     config_ptr->bufferedInput                        = -1;
     config_ptr->sequenceBuffer                       = 0;
+    config_ptr->inputPrefetch                        = 0;
+    config_ptr->inputReader                          = NULL;
     config_ptr->latencyMode                          = 0;
 
     // Interlaced Video
@@ -444,6 +524,8 @@ void EbConfigCtor(EbConfig_t *config_ptr)
     config_ptr->enableHmeLevel2Flag                  = EB_FALSE;
     config_ptr->searchAreaWidth                      = 16;
     config_ptr->searchAreaHeight                     = 7;
+    config_ptr->adaptiveSearchArea                   = 0;
+    config_ptr->staticSbFastPath                     = 0;
     config_ptr->numberHmeSearchRegionInWidth         = 2;
     config_ptr->numberHmeSearchRegionInHeight        = 2;
     config_ptr->hmeLevel0TotalSearchAreaWidth        = 64;
@@ -520,6 +602,20 @@ void EbConfigCtor(EbConfig_t *config_ptr)
     config_ptr->stopEncoder                          = 0;
     config_ptr->logicalProcessors                    = 0;
     config_ptr->targetSocket                         = -1;
+    config_ptr->numaNode                             = -1;
+    memset(config_ptr->cpuMask, 0, sizeof(config_ptr->cpuMask));
+    config_ptr->pictureAnalysisThreads               = 0;
+    config_ptr->motionEstimationThreads              = 0;
+    config_ptr->sourceBasedOperationsThreads         = 0;
+    config_ptr->modeDecisionConfigurationThreads     = 0;
+    config_ptr->encDecThreads                        = 0;
+    config_ptr->dlfThreads                           = 0;
+    config_ptr->cdefThreads                          = 0;
+    config_ptr->restThreads                          = 0;
+    config_ptr->entropyCodingThreads                 = 0;
+    config_ptr->memoryBudget                         = 0;
+    config_ptr->frameRowOverlap                      = 0;
+    config_ptr->lockFreeQueues                       = 0;
     config_ptr->processedFrameCount                  = 0;
     config_ptr->processedByteCount                   = 0;
 #if TILES
@@ -543,6 +639,10 @@ void EbConfigDtor(EbConfig_t *config_ptr)
         config_ptr->configFile = (FILE *) NULL;
     }
 
+    // Stop the input reader before its file is closed
+    InputReaderDtor(config_ptr->inputReader);
+    config_ptr->inputReader = NULL;
+
     if (config_ptr->inputFile) {
         if (config_ptr->inputFile != stdin) fclose(config_ptr->inputFile);
         config_ptr->inputFile = (FILE *) NULL;
@@ -568,6 +668,11 @@ void EbConfigDtor(EbConfig_t *config_ptr)
         config_ptr->qpFile = (FILE *)NULL;
     }
 
+    if (config_ptr->pipelineTraceFile) {
+        fclose(config_ptr->pipelineTraceFile);
+        config_ptr->pipelineTraceFile = (FILE *)NULL;
+    }
+
     return;
 }
 
@@ -844,6 +949,12 @@ static EbErrorType VerifySettings(EbConfig_t *config, uint32_t channelNumber)
         return_error = EB_ErrorBadParameter;
     }
 
+    // NumaNode
+    if (config->numaNode < -1) {
+        fprintf(config->errorLogFile, "Error instance %u: Invalid NumaNode [-1 or node index], your input: %d\n", channelNumber + 1, config->numaNode);
+        return_error = EB_ErrorBadParameter;
+    }
+
     // Local Warped Motion
     if (config->enable_warped_motion != 0 && config->enable_warped_motion != 1) {
         fprintf(config->errorLogFile, "Error instance %u: Invalid warped motion flag [0 - 1], your input: %d\n", channelNumber + 1, config->targetSocket);
@@ -217,6 +217,8 @@ typedef struct EbConfig_s
 
     FILE                    *qpFile;
 
+    FILE                    *pipelineTraceFile;
+
     EbBool                  y4mInput;
     unsigned char           y4mBuf[9];
 
@@ -240,6 +242,8 @@ typedef struct EbConfig_s
     int32_t                  framesEncoded;
     int32_t                  bufferedInput;
     uint8_t                **sequenceBuffer;
+    uint32_t                 inputPrefetch;
+    struct EbInputReader_s  *inputReader;
 
     uint8_t                  latencyMode;
 
@@ -295,6 +299,8 @@ typedef struct EbConfig_s
      ****************************************/
     uint32_t                 searchAreaWidth;
     uint32_t                 searchAreaHeight;
+    uint32_t                 adaptiveSearchArea;
+    uint32_t                 staticSbFastPath;
 
     /****************************************
      * HME Parameters
@@ -380,6 +386,20 @@ typedef struct EbConfig_s
     uint32_t                active_channel_count;
     uint32_t                logicalProcessors;
     int32_t                 targetSocket;
+    int32_t                 numaNode;
+    uint64_t                cpuMask[EB_CPU_MASK_WORD_COUNT];
+    uint32_t                pictureAnalysisThreads;
+    uint32_t                motionEstimationThreads;
+    uint32_t                sourceBasedOperationsThreads;
+    uint32_t                modeDecisionConfigurationThreads;
+    uint32_t                encDecThreads;
+    uint32_t                dlfThreads;
+    uint32_t                cdefThreads;
+    uint32_t                restThreads;
+    uint32_t                entropyCodingThreads;
+    uint32_t                memoryBudget;
+    uint32_t                frameRowOverlap;
+    uint32_t                lockFreeQueues;
     EbBool                 stopEncoder;         // to signal CTRL+C Event, need to stop encoding.
 
     uint64_t                processedFrameCount;
@@ -8,9 +8,11 @@
  ***************************************/
 
 #include <stdlib.h>
+#include <string.h>
 
 #include "EbAppContext.h"
 #include "EbAppConfig.h"
+#include "EbAppInputReader.h"
 
 
 #define INPUT_SIZE_576p_TH                0x90000        // 0.58 Million
@@ -196,6 +198,8 @@ EbErrorType CopyConfigurationParameters(
     callbackData->ebEncParameters.enable_hme_level2_flag = (EbBool)config->enableHmeLevel2Flag;
     callbackData->ebEncParameters.search_area_width = config->searchAreaWidth;
     callbackData->ebEncParameters.search_area_height = config->searchAreaHeight;
+    callbackData->ebEncParameters.adaptive_me_search_range = config->adaptiveSearchArea;
+    callbackData->ebEncParameters.static_sb_fast_path = config->staticSbFastPath;
     callbackData->ebEncParameters.number_hme_search_region_in_width = config->numberHmeSearchRegionInWidth;
     callbackData->ebEncParameters.number_hme_search_region_in_height = config->numberHmeSearchRegionInHeight;
     callbackData->ebEncParameters.hme_level0_total_search_area_width = config->hmeLevel0TotalSearchAreaWidth;
@@ -222,7 +226,22 @@ EbErrorType CopyConfigurationParameters(
     callbackData->ebEncParameters.asm_type = config->asmType;
     callbackData->ebEncParameters.logical_processors = config->logicalProcessors;
     callbackData->ebEncParameters.target_socket = config->targetSocket;
+    callbackData->ebEncParameters.numa_node = config->numaNode;
+    memcpy(callbackData->ebEncParameters.cpu_mask, config->cpuMask, sizeof(config->cpuMask));
+    callbackData->ebEncParameters.picture_analysis_thread_count = config->pictureAnalysisThreads;
+    callbackData->ebEncParameters.motion_estimation_thread_count = config->motionEstimationThreads;
+    callbackData->ebEncParameters.source_based_operations_thread_count = config->sourceBasedOperationsThreads;
+    callbackData->ebEncParameters.mode_decision_configuration_thread_count = config->modeDecisionConfigurationThreads;
+    callbackData->ebEncParameters.enc_dec_thread_count = config->encDecThreads;
+    callbackData->ebEncParameters.dlf_thread_count = config->dlfThreads;
+    callbackData->ebEncParameters.cdef_thread_count = config->cdefThreads;
+    callbackData->ebEncParameters.rest_thread_count = config->restThreads;
+    callbackData->ebEncParameters.entropy_coding_thread_count = config->entropyCodingThreads;
+    callbackData->ebEncParameters.memory_budget = config->memoryBudget;
+    callbackData->ebEncParameters.frame_row_overlap = config->frameRowOverlap;
+    callbackData->ebEncParameters.lock_free_queues = config->lockFreeQueues;
     callbackData->ebEncParameters.recon_enabled = config->reconFile ? EB_TRUE : EB_FALSE;
+    callbackData->ebEncParameters.pipeline_profiling = config->pipelineTraceFile ? 1 : 0;
 
     for (hmeRegionIndex = 0; hmeRegionIndex < callbackData->ebEncParameters.number_hme_search_region_in_width; ++hmeRegionIndex) {
         callbackData->ebEncParameters.hme_level0_search_area_in_width_array[hmeRegionIndex] = config->hmeLevel0SearchAreaInWidthArray[hmeRegionIndex];
@@ -323,7 +342,8 @@ EbErrorType AllocateInputBuffers(
 
         EB_APP_MALLOC(uint8_t*, callbackData->inputBufferPool->p_buffer, sizeof(EbSvtEncInput), EB_N_PTR, EB_ErrorInsufficientResources);
 
-        if (config->bufferedInput == -1) {
+        // The frames of the input reader are passed in place
+        if (config->bufferedInput == -1 && config->inputReader == NULL) {
 
             // Allocate frame buffer for the p_buffer
             AllocateFrameBuffer(
@@ -619,6 +639,17 @@ EbErrorType InitEncoder(
 
     ///********************** APPLICATION INIT [START] ******************///
 
+    // Start reading the input ahead of the encoder
+    if (config->bufferedInput == -1 && config->inputPrefetch && !config->separateFields) {
+        return_error = InputReaderCtor(
+            &config->inputReader,
+            config);
+
+        if (return_error != EB_ErrorNone) {
+            return return_error;
+        }
+    }
+
     // STEP 6: Allocate input buffers carrying the yuv frames in
     return_error = AllocateInputBuffers(
         config,
@@ -0,0 +1,392 @@
+/*
+* Copyright(c) 2019 Intel Corporation
+* SPDX - License - Identifier: BSD - 2 - Clause - Patent
+*/
+
+/***************************************
+ * Includes
+ ***************************************/
+#include <stdlib.h>
+#include <string.h>
+
+#include "EbAppInputReader.h"
+#include "EbAppInputy4m.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#define SIZE_OF_ONE_FRAME_IN_BYTES(width, height,is16bit) ( ( ((width)*(height)*3)>>1 )<<is16bit)
+#define INPUT_READER_MIN_SLOT_COUNT     2
+#define INPUT_READER_PAGE_SIZE          4096
+
+typedef struct EbInputSlot_s {
+    uint8_t                *buffer;             // frame storage of the fread path
+    uint8_t                *frame;              // frame handed to the encoder
+    uint32_t                filledLen;
+} EbInputSlot_t;
+
+struct EbInputReader_s {
+    EbConfig_t             *config;
+
+    EbInputSlot_t          *slotArray;
+    uint32_t                slotCount;
+    uint32_t                readIndex;
+    uint32_t                writeIndex;
+    uint32_t                filledCount;
+    EbBool                  frameHeld;
+    EbBool                  endOfInput;
+    EbBool                  stop;
+
+    uint64_t                frameSize;
+    int64_t                 dataStart;          // offset of the first frame, after the y4m header
+    EbBool                  stdinPrefix;        // first bytes of a yuv stdin already read by checkIfY4m
+
+    // Memory mapped input
+    uint8_t                *mapPtr;
+    uint64_t                mapSize;
+    uint64_t                mapPos;
+
+#ifdef _WIN32
+    CRITICAL_SECTION        lock;
+    CONDITION_VARIABLE      notEmpty;
+    CONDITION_VARIABLE      notFull;
+    HANDLE                  threadHandle;
+#else
+    pthread_mutex_t         lock;
+    pthread_cond_t          notEmpty;
+    pthread_cond_t          notFull;
+    pthread_t               threadHandle;
+#endif
+    EbBool                  threadCreated;
+};
+
+/***************************************
+ * Synchronization
+ ***************************************/
+#ifdef _WIN32
+#define InputReaderLock(readerPtr)              EnterCriticalSection(&(readerPtr)->lock)
+#define InputReaderUnlock(readerPtr)            LeaveCriticalSection(&(readerPtr)->lock)
+#define InputReaderWait(readerPtr, cond)        SleepConditionVariableCS(cond, &(readerPtr)->lock, INFINITE)
+#define InputReaderSignal(cond)                 WakeConditionVariable(cond)
+#else
+#define InputReaderLock(readerPtr)              pthread_mutex_lock(&(readerPtr)->lock)
+#define InputReaderUnlock(readerPtr)            pthread_mutex_unlock(&(readerPtr)->lock)
+#define InputReaderWait(readerPtr, cond)        pthread_cond_wait(cond, &(readerPtr)->lock)
+#define InputReaderSignal(cond)                 pthread_cond_signal(cond)
+#endif
+
+/***************************************
+ * Memory mapped input
+ *  The frames are used in place, the reader thread touches their pages
+ *  so that the disk reads and page faults are not taken by the encoder.
+ ***************************************/
+#ifndef _WIN32
+static void InputReaderMapFile(
+    EbInputReader_t *readerPtr)
+{
+    struct stat fileStat;
+    void *mapPtr;
+    const int fd = fileno(readerPtr->config->inputFile);
+
+    if (fd < 0 || fstat(fd, &fileStat) != 0 || !S_ISREG(fileStat.st_mode))
+        return;
+
+    // Files without a complete frame are left to the fread path
+    if (readerPtr->dataStart < 0 || (uint64_t)fileStat.st_size < (uint64_t)readerPtr->dataStart + readerPtr->frameSize)
+        return;
+
+    mapPtr = mmap(NULL, (size_t)fileStat.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (mapPtr == MAP_FAILED)
+        return;
+
+    madvise(mapPtr, (size_t)fileStat.st_size, MADV_SEQUENTIAL);
+
+    readerPtr->mapPtr = (uint8_t*)mapPtr;
+    readerPtr->mapSize = (uint64_t)fileStat.st_size;
+    readerPtr->mapPos = (uint64_t)readerPtr->dataStart;
+}
+#endif
+
+static uint32_t InputReaderMapFrame(
+    EbInputReader_t  *readerPtr,
+    uint8_t         **framePtr)
+{
+    const uint8_t *mapPtr = readerPtr->mapPtr;
+    const uint64_t mapSize = readerPtr->mapSize;
+    volatile uint8_t touch = 0;
+    uint64_t pos;
+    uint64_t offset;
+    uint32_t pass;
+
+    for (pass = 0; pass < 2; ++pass) {
+        pos = readerPtr->mapPos;
+
+        // Skip the y4m FRAME line
+        if (readerPtr->config->y4mInput) {
+            const uint8_t *lineEnd = pos < mapSize ? (const uint8_t*)memchr(mapPtr + pos, '\n', (size_t)(mapSize - pos)) : NULL;
+            pos = lineEnd ? (uint64_t)(lineEnd - mapPtr) + 1 : mapSize;
+        }
+
+        if (pos + readerPtr->frameSize <= mapSize) {
+            for (offset = 0; offset < readerPtr->frameSize; offset += INPUT_READER_PAGE_SIZE)
+                touch += mapPtr[pos + offset];
+            touch += mapPtr[pos + readerPtr->frameSize - 1];
+
+            *framePtr = readerPtr->mapPtr + pos;
+            readerPtr->mapPos = pos + readerPtr->frameSize;
+            return (uint32_t)readerPtr->frameSize;
+        }
+
+        // Loop back to the first frame
+        readerPtr->mapPos = (uint64_t)readerPtr->dataStart;
+    }
+
+    return 0;
+}
+
+/***************************************
+ * fread input
+ ***************************************/
+static uint32_t InputReaderReadFrame(
+    EbInputReader_t  *readerPtr,
+    uint8_t          *buffer)
+{
+    EbConfig_t *config = readerPtr->config;
+    uint64_t filledLen;
+    uint32_t pass;
+
+    for (pass = 0; pass < 2; ++pass) {
+        filledLen = 0;
+
+        if (config->y4mInput == EB_TRUE)
+            readY4mFrameDelimiter(config);
+
+        if (readerPtr->stdinPrefix) {
+            memcpy(buffer, config->y4mBuf, sizeof(config->y4mBuf));
+            filledLen = sizeof(config->y4mBuf);
+            readerPtr->stdinPrefix = EB_FALSE;
+        }
+
+        filledLen += fread(buffer + filledLen, 1, (size_t)(readerPtr->frameSize - filledLen), config->inputFile);
+        if (filledLen == readerPtr->frameSize)
+            return (uint32_t)filledLen;
+
+        // Loop back to the first frame, when the input can seek
+        if (config->inputFile == stdin || fseeko64(config->inputFile, readerPtr->dataStart, SEEK_SET) != 0)
+            break;
+    }
+
+    return 0;
+}
+
+/***************************************
+ * Reader thread
+ ***************************************/
+#ifdef _WIN32
+static DWORD WINAPI InputReaderKernel(LPVOID inputPtr)
+#else
+static void *InputReaderKernel(void *inputPtr)
+#endif
+{
+    EbInputReader_t *readerPtr = (EbInputReader_t*)inputPtr;
+    EbInputSlot_t *slotPtr;
+    EbBool stop;
+
+    for (;;) {
+        InputReaderLock(readerPtr);
+        while (readerPtr->filledCount == readerPtr->slotCount && !readerPtr->stop)
+            InputReaderWait(readerPtr, &readerPtr->notFull);
+        stop = readerPtr->stop;
+        slotPtr = &readerPtr->slotArray[readerPtr->writeIndex];
+        InputReaderUnlock(readerPtr);
+
+        if (stop)
+            break;
+
+        // The slot is not visible to the encoder until it is counted as filled
+        if (readerPtr->mapPtr)
+            slotPtr->filledLen = InputReaderMapFrame(readerPtr, &slotPtr->frame);
+        else
+            slotPtr->filledLen = InputReaderReadFrame(readerPtr, slotPtr->buffer);
+
+        InputReaderLock(readerPtr);
+        if (slotPtr->filledLen) {
+            readerPtr->writeIndex = (readerPtr->writeIndex + 1) % readerPtr->slotCount;
+            readerPtr->filledCount++;
+        }
+        else
+            readerPtr->endOfInput = EB_TRUE;
+        stop = readerPtr->endOfInput;
+        InputReaderSignal(&readerPtr->notEmpty);
+        InputReaderUnlock(readerPtr);
+
+        if (stop)
+            break;
+    }
+
+    return 0;
+}
+
+/***************************************
+ * Constructor
+ ***************************************/
+EbErrorType InputReaderCtor(
+    EbInputReader_t **readerDblPtr,
+    EbConfig_t       *config)
+{
+    EbInputReader_t *readerPtr;
+    const uint64_t inputPaddedWidth = config->inputPaddedWidth;
+    const uint64_t inputPaddedHeight = config->inputPaddedHeight;
+    uint32_t slotIndex;
+
+    *readerDblPtr = (EbInputReader_t*)NULL;
+
+    readerPtr = (EbInputReader_t*)calloc(1, sizeof(EbInputReader_t));
+    if (readerPtr == (EbInputReader_t*)NULL)
+        return EB_ErrorInsufficientResources;
+
+    readerPtr->config = config;
+    readerPtr->slotCount = config->inputPrefetch < INPUT_READER_MIN_SLOT_COUNT ? INPUT_READER_MIN_SLOT_COUNT : config->inputPrefetch;
+    readerPtr->frameSize = (config->encoderBitDepth == 10 && config->compressedTenBitFormat == 1) ?
+        (inputPaddedWidth * inputPaddedHeight * 3) / 2 + (inputPaddedWidth / 4 * inputPaddedHeight * 3) / 2 :
+        SIZE_OF_ONE_FRAME_IN_BYTES(inputPaddedWidth, inputPaddedHeight, (uint64_t)(config->encoderBitDepth > 8));
+    readerPtr->dataStart = (config->inputFile == stdin) ? 0 : (int64_t)ftello64(config->inputFile);
+    readerPtr->stdinPrefix = (config->inputFile == stdin && config->y4mInput == EB_FALSE) ? EB_TRUE : EB_FALSE;
+
+#ifndef _WIN32
+    if (config->inputFile != stdin)
+        InputReaderMapFile(readerPtr);
+#endif
+
+    readerPtr->slotArray = (EbInputSlot_t*)calloc(readerPtr->slotCount, sizeof(EbInputSlot_t));
+    if (readerPtr->slotArray == (EbInputSlot_t*)NULL) {
+        InputReaderDtor(readerPtr);
+        return EB_ErrorInsufficientResources;
+    }
+
+    if (readerPtr->mapPtr == (uint8_t*)NULL) {
+        for (slotIndex = 0; slotIndex < readerPtr->slotCount; ++slotIndex) {
+            readerPtr->slotArray[slotIndex].buffer = (uint8_t*)calloc(1, (size_t)readerPtr->frameSize);
+            if (readerPtr->slotArray[slotIndex].buffer == (uint8_t*)NULL) {
+                InputReaderDtor(readerPtr);
+                return EB_ErrorInsufficientResources;
+            }
+            readerPtr->slotArray[slotIndex].frame = readerPtr->slotArray[slotIndex].buffer;
+        }
+    }
+
+#ifdef _WIN32
+    InitializeCriticalSection(&readerPtr->lock);
+    InitializeConditionVariable(&readerPtr->notEmpty);
+    InitializeConditionVariable(&readerPtr->notFull);
+    readerPtr->threadHandle = CreateThread(NULL, 0, InputReaderKernel, readerPtr, 0, NULL);
+    readerPtr->threadCreated = readerPtr->threadHandle != NULL ? EB_TRUE : EB_FALSE;
+#else
+    pthread_mutex_init(&readerPtr->lock, NULL);
+    pthread_cond_init(&readerPtr->notEmpty, NULL);
+    pthread_cond_init(&readerPtr->notFull, NULL);
+    readerPtr->threadCreated = pthread_create(&readerPtr->threadHandle, NULL, InputReaderKernel, readerPtr) == 0 ? EB_TRUE : EB_FALSE;
+#endif
+
+    if (readerPtr->threadCreated == EB_FALSE) {
+        InputReaderDtor(readerPtr);
+        return EB_ErrorInsufficientResources;
+    }
+
+    *readerDblPtr = readerPtr;
+
+    return EB_ErrorNone;
+}
+
+uint8_t *InputReaderGetFrame(
+    EbInputReader_t  *readerPtr,
+    uint32_t         *filledLen)
+{
+    EbInputSlot_t *slotPtr;
+    uint8_t *framePtr;
+
+    InputReaderLock(readerPtr);
+
+    while (readerPtr->filledCount == 0 && !readerPtr->endOfInput)
+        InputReaderWait(readerPtr, &readerPtr->notEmpty);
+
+    if (readerPtr->filledCount) {
+        slotPtr = &readerPtr->slotArray[readerPtr->readIndex];
+        *filledLen = slotPtr->filledLen;
+        readerPtr->frameHeld = EB_TRUE;
+    }
+    else {
+        // Exhausted input, hand out the last frame again
+        slotPtr = &readerPtr->slotArray[(readerPtr->readIndex + readerPtr->slotCount - 1) % readerPtr->slotCount];
+        *filledLen = 0;
+    }
+    framePtr = slotPtr->frame;
+
+    InputReaderUnlock(readerPtr);
+
+    return framePtr;
+}
+
+void InputReaderReleaseFrame(
+    EbInputReader_t  *readerPtr)
+{
+    InputReaderLock(readerPtr);
+
+    if (readerPtr->frameHeld) {
+        readerPtr->readIndex = (readerPtr->readIndex + 1) % readerPtr->slotCount;
+        readerPtr->filledCount--;
+        readerPtr->frameHeld = EB_FALSE;
+        InputReaderSignal(&readerPtr->notFull);
+    }
+
+    InputReaderUnlock(readerPtr);
+}
+
+/***************************************
+ * Destructor
+ ***************************************/
+void InputReaderDtor(
+    EbInputReader_t  *readerPtr)
+{
+    uint32_t slotIndex;
+
+    if (readerPtr == (EbInputReader_t*)NULL)
+        return;
+
+    if (readerPtr->threadCreated) {
+        InputReaderLock(readerPtr);
+        readerPtr->stop = EB_TRUE;
+        InputReaderSignal(&readerPtr->notFull);
+        InputReaderUnlock(readerPtr);
+
+#ifdef _WIN32
+        WaitForSingleObject(readerPtr->threadHandle, INFINITE);
+        CloseHandle(readerPtr->threadHandle);
+        DeleteCriticalSection(&readerPtr->lock);
+#else
+        pthread_join(readerPtr->threadHandle, NULL);
+        pthread_mutex_destroy(&readerPtr->lock);
+        pthread_cond_destroy(&readerPtr->notEmpty);
+        pthread_cond_destroy(&readerPtr->notFull);
+#endif
+    }
+
+    if (readerPtr->slotArray) {
+        for (slotIndex = 0; slotIndex < readerPtr->slotCount; ++slotIndex)
+            free(readerPtr->slotArray[slotIndex].buffer);
+        free(readerPtr->slotArray);
+    }
+
+#ifndef _WIN32
+    if (readerPtr->mapPtr)
+        munmap(readerPtr->mapPtr, (size_t)readerPtr->mapSize);
+#endif
+
+    free(readerPtr);
+}
@@ -0,0 +1,39 @@
+/*
+* Copyright(c) 2019 Intel Corporation
+* SPDX - License - Identifier: BSD - 2 - Clause - Patent
+*/
+
+#ifndef EbAppInputReader_h
+#define EbAppInputReader_h
+
+#include "EbAppConfig.h"
+
+/***************************************
+ * Input Reader
+ *  Reads the input frames ahead of the encoder on a thread of its own,
+ *  into a ring of InputPrefetch frames. Regular files are mapped in
+ *  memory (POSIX) and the frames are handed out in place, the reader
+ *  thread only faults their pages in; other inputs (pipes, Windows)
+ *  are read with fread into the ring. Like the synchronous path, the
+ *  input loops back to its first frame at the end of a file.
+ ***************************************/
+typedef struct EbInputReader_s EbInputReader_t;
+
+extern EbErrorType InputReaderCtor(
+    EbInputReader_t **readerDblPtr,
+    EbConfig_t       *config);
+
+// Blocks until the next frame is read. filledLen is 0 once a non seekable
+//  input is exhausted, the returned frame is then the last one read.
+extern uint8_t *InputReaderGetFrame(
+    EbInputReader_t  *readerPtr,
+    uint32_t         *filledLen);
+
+// Gives the frame back to the reader, once the encoder copied it
+extern void InputReaderReleaseFrame(
+    EbInputReader_t  *readerPtr);
+
+extern void InputReaderDtor(
+    EbInputReader_t  *readerPtr);
+
+#endif // EbAppInputReader_h
@@ -52,8 +52,176 @@ extern APPEXITCONDITIONTYPE ProcessOutputStreamBuffer(
     EbAppContext_t         *appCallBack,
     uint8_t           pic_send_done);
 
+extern void WritePipelineTrace(
+    EbConfig_t             *config,
+    EbAppContext_t         *appCallBack,
+    uint32_t                instanceIndex);
+
 volatile int32_t keepRunning = 1;
 
+/***************************************
+ * Channel Threads
+ *  Every channel is driven by an input thread, blocked in the library
+ *  while all of its input buffers are in use, and an output thread
+ *  blocked until the next packet. The library only returns the recon
+ *  without blocking, so its thread sleeps while the recon queue is empty.
+ ***************************************/
+#define RECON_POLL_INTERVAL_MS      1
+// After an error the end of stream may never come: the output thread then
+//  polls, and gives up once no packet came for OUTPUT_DRAIN_TIMEOUT_MS or
+//  after OUTPUT_MAX_ERROR_COUNT error packets.
+#define OUTPUT_DRAIN_TIMEOUT_MS     1000
+#define OUTPUT_MAX_ERROR_COUNT      64
+
+#ifdef _WIN32
+typedef HANDLE                      AppThreadHandle;
+#define APP_THREAD_FUNCTION(name)   DWORD WINAPI name(LPVOID context)
+#define APP_THREAD_RETURN           0
+#else
+typedef pthread_t                   AppThreadHandle;
+#define APP_THREAD_FUNCTION(name)   void *name(void *context)
+#define APP_THREAD_RETURN           NULL
+#endif
+
+typedef struct EbChannelContext_s {
+    EbConfig_t             *config;
+    EbAppContext_t         *appCallBack;
+    APPEXITCONDITIONTYPE    exitConditionInput;
+    APPEXITCONDITIONTYPE    exitConditionOutput;
+    APPEXITCONDITIONTYPE    exitConditionRecon;
+
+    AppThreadHandle         inputThread;
+    AppThreadHandle         outputThread;
+    AppThreadHandle         reconThread;
+    EbBool                  inputThreadCreated;
+    EbBool                  outputThreadCreated;
+    EbBool                  reconThreadCreated;
+} EbChannelContext_t;
+
+static EbBool AppCreateThread(
+    AppThreadHandle        *threadHandle,
+#ifdef _WIN32
+    LPTHREAD_START_ROUTINE  threadFunction,
+#else
+    void                 *(*threadFunction)(void*),
+#endif
+    EbChannelContext_t     *channelPtr)
+{
+#ifdef _WIN32
+    *threadHandle = CreateThread(NULL, 0, threadFunction, channelPtr, 0, NULL);
+    return *threadHandle != NULL ? EB_TRUE : EB_FALSE;
+#else
+    return pthread_create(threadHandle, NULL, threadFunction, channelPtr) == 0 ? EB_TRUE : EB_FALSE;
+#endif
+}
+
+static void AppJoinThread(
+    AppThreadHandle         threadHandle)
+{
+#ifdef _WIN32
+    WaitForSingleObject(threadHandle, INFINITE);
+    CloseHandle(threadHandle);
+#else
+    pthread_join(threadHandle, NULL);
+#endif
+}
+
+static APP_THREAD_FUNCTION(ChannelInputThread)
+{
+    EbChannelContext_t *channelPtr = (EbChannelContext_t*)context;
+
+    while (channelPtr->exitConditionInput == APP_ExitConditionNone)
+        channelPtr->exitConditionInput = ProcessInputBuffer(
+            channelPtr->config,
+            channelPtr->appCallBack);
+
+    // Flush the encoder after an input error, so that the output thread
+    //  is not left blocked waiting for the end of stream
+    if (channelPtr->exitConditionInput == APP_ExitConditionError) {
+        EbBufferHeaderType *headerPtr = channelPtr->appCallBack->inputBufferPool;
+
+        headerPtr->n_alloc_len   = 0;
+        headerPtr->n_filled_len  = 0;
+        headerPtr->n_tick_count  = 0;
+        headerPtr->p_app_private = NULL;
+        headerPtr->flags         = EB_BUFFERFLAG_EOS;
+        headerPtr->p_buffer      = NULL;
+        headerPtr->pic_type      = EB_INVALID_PICTURE;
+
+        eb_svt_enc_send_picture((EbComponentType*)channelPtr->appCallBack->svtEncoderHandle, headerPtr);
+    }
+
+    return APP_THREAD_RETURN;
+}
+
+static APP_THREAD_FUNCTION(ChannelOutputThread)
+{
+    EbChannelContext_t *channelPtr = (EbChannelContext_t*)context;
+    APPEXITCONDITIONTYPE exitCondition;
+    uint32_t errorCount = 0;
+    uint32_t idleTime = 0;
+
+    // After an error the packets are still taken up to the end of stream,
+    //  so that the pipeline and the input thread are not left blocked
+    do {
+        const EbBool draining = (EbBool)(errorCount || channelPtr->exitConditionInput == APP_ExitConditionError);
+        const uint64_t frameCount = channelPtr->config->performanceContext.frameCount;
+
+        exitCondition = ProcessOutputStreamBuffer(
+            channelPtr->config,
+            channelPtr->appCallBack,
+            draining ? 0 : 1);
+
+        if (exitCondition == APP_ExitConditionError) {
+            channelPtr->exitConditionOutput = APP_ExitConditionError;
+            if (++errorCount == OUTPUT_MAX_ERROR_COUNT)
+                break;
+            idleTime = 0;
+        }
+        else if (draining && exitCondition == APP_ExitConditionNone) {
+            if (channelPtr->config->performanceContext.frameCount != frameCount)
+                idleTime = 0;
+            else if (idleTime >= OUTPUT_DRAIN_TIMEOUT_MS)
+                break;
+            else {
+                EbSleep(RECON_POLL_INTERVAL_MS);
+                idleTime += RECON_POLL_INTERVAL_MS;
+            }
+        }
+    } while (exitCondition != APP_ExitConditionFinished);
+
+    // Given up: the input thread stops reading after its next picture
+    if (exitCondition != APP_ExitConditionFinished)
+        channelPtr->config->stopEncoder = EB_TRUE;
+
+    if (channelPtr->exitConditionOutput == APP_ExitConditionNone)
+        channelPtr->exitConditionOutput = APP_ExitConditionFinished;
+
+    return APP_THREAD_RETURN;
+}
+
+static APP_THREAD_FUNCTION(ChannelReconThread)
+{
+    EbChannelContext_t *channelPtr = (EbChannelContext_t*)context;
+    APPEXITCONDITIONTYPE exitCondition;
+
+    do {
+        exitCondition = ProcessOutputReconBuffer(
+            channelPtr->config,
+            channelPtr->appCallBack);
+
+        if (exitCondition == APP_ExitConditionError)
+            channelPtr->exitConditionRecon = APP_ExitConditionError;
+        else if (exitCondition == APP_ExitConditionNone)
+            EbSleep(RECON_POLL_INTERVAL_MS);
+    } while (exitCondition != APP_ExitConditionFinished);
+
+    if (channelPtr->exitConditionRecon == APP_ExitConditionNone)
+        channelPtr->exitConditionRecon = APP_ExitConditionFinished;
+
+    return APP_THREAD_RETURN;
+}
+
 void EventHandler(int32_t dummy) {
     (void)dummy;
     keepRunning = 0;
@@ -87,7 +255,6 @@ int32_t main(int32_t argc, char* argv[])
 #endif
     // GLOBAL VARIABLES
     EbErrorType            return_error = EB_ErrorNone;            // Error Handling
-    APPEXITCONDITIONTYPE    exitCondition = APP_ExitConditionNone;    // Processing loop exit condition
 
     EbErrorType            return_errors[MAX_CHANNEL_NUMBER];          // Error Handling
     APPEXITCONDITIONTYPE    exitConditions[MAX_CHANNEL_NUMBER];          // Processing loop exit condition
@@ -97,6 +264,7 @@ int32_t main(int32_t argc, char* argv[])
 
 
     EbBool                 channelActive[MAX_CHANNEL_NUMBER];
+    EbChannelContext_t     channels[MAX_CHANNEL_NUMBER];
 
     EbConfig_t             *configs[MAX_CHANNEL_NUMBER];        // Encoder Configuration
 
@@ -193,38 +361,58 @@ int32_t main(int32_t argc, char* argv[])
                 printf("Encoding          ");
                 fflush(stdout);
 
-                while (exitCondition == APP_ExitConditionNone) {
-                    exitCondition = APP_ExitConditionFinished;
-                    for (instanceCount = 0; instanceCount < numChannels; ++instanceCount) {
-                        if (channelActive[instanceCount] == EB_TRUE) {
-                            if (exitConditionsInput[instanceCount] == APP_ExitConditionNone)
-                                exitConditionsInput[instanceCount] = ProcessInputBuffer(
-                                                                            configs[instanceCount],
-                                                                            appCallbacks[instanceCount]);
-                            if (exitConditionsRecon[instanceCount] == APP_ExitConditionNone)
-                                exitConditionsRecon[instanceCount] = ProcessOutputReconBuffer(
-                                                                            configs[instanceCount],
-                                                                            appCallbacks[instanceCount]);
-                            if (exitConditionsOutput[instanceCount] == APP_ExitConditionNone)
-                                exitConditionsOutput[instanceCount] = ProcessOutputStreamBuffer(
-                                                                            configs[instanceCount],
-                                                                            appCallbacks[instanceCount],
-                                                                            (exitConditionsInput[instanceCount] == APP_ExitConditionNone) || (exitConditionsRecon[instanceCount] == APP_ExitConditionNone)? 0 : 1);
-                            if (((exitConditionsRecon[instanceCount] == APP_ExitConditionFinished || !configs[instanceCount]->reconFile)  && exitConditionsOutput[instanceCount] == APP_ExitConditionFinished && exitConditionsInput[instanceCount] == APP_ExitConditionFinished)||
-                                ((exitConditionsRecon[instanceCount] == APP_ExitConditionError && configs[instanceCount]->reconFile) || exitConditionsOutput[instanceCount] == APP_ExitConditionError || exitConditionsInput[instanceCount] == APP_ExitConditionError)){
-                                channelActive[instanceCount] = EB_FALSE;
-                                if (configs[instanceCount]->reconFile)
-                                    exitConditions[instanceCount] = (APPEXITCONDITIONTYPE)(exitConditionsRecon[instanceCount] | exitConditionsOutput[instanceCount] | exitConditionsInput[instanceCount]);
-                                else
-                                    exitConditions[instanceCount] = (APPEXITCONDITIONTYPE)(exitConditionsOutput[instanceCount] | exitConditionsInput[instanceCount]);
-                            }
-                        }
-                    }
-                    // check if all channels are inactive
-                    for (instanceCount = 0; instanceCount < numChannels; ++instanceCount) {
-                        if (channelActive[instanceCount] == EB_TRUE)
-                            exitCondition = APP_ExitConditionNone;
-                    }
+                // Start the channel threads
+                for (instanceCount = 0; instanceCount < numChannels; ++instanceCount) {
+                    EbChannelContext_t *channelPtr = &channels[instanceCount];
+
+                    channelPtr->config              = configs[instanceCount];
+                    channelPtr->appCallBack         = appCallbacks[instanceCount];
+                    channelPtr->exitConditionInput  = exitConditionsInput[instanceCount];
+                    channelPtr->exitConditionOutput = exitConditionsOutput[instanceCount];
+                    channelPtr->exitConditionRecon  = exitConditionsRecon[instanceCount];
+                    channelPtr->inputThreadCreated  = EB_FALSE;
+                    channelPtr->outputThreadCreated = EB_FALSE;
+                    channelPtr->reconThreadCreated  = EB_FALSE;
+
+                    if (channelActive[instanceCount] == EB_FALSE)
+                        continue;
+
+                    channelPtr->outputThreadCreated = AppCreateThread(&channelPtr->outputThread, ChannelOutputThread, channelPtr);
+                    if (channelPtr->exitConditionRecon == APP_ExitConditionNone)
+                        channelPtr->reconThreadCreated = AppCreateThread(&channelPtr->reconThread, ChannelReconThread, channelPtr);
+                    channelPtr->inputThreadCreated = AppCreateThread(&channelPtr->inputThread, ChannelInputThread, channelPtr);
+
+                    // A task whose thread could not be created runs on the main thread
+                    if (channelPtr->inputThreadCreated == EB_FALSE)
+                        ChannelInputThread(channelPtr);
+                    if (channelPtr->reconThreadCreated == EB_FALSE && channelPtr->exitConditionRecon == APP_ExitConditionNone)
+                        ChannelReconThread(channelPtr);
+                    if (channelPtr->outputThreadCreated == EB_FALSE)
+                        ChannelOutputThread(channelPtr);
+                }
+
+                // Wait for the end of every channel
+                for (instanceCount = 0; instanceCount < numChannels; ++instanceCount) {
+                    EbChannelContext_t *channelPtr = &channels[instanceCount];
+
+                    if (channelPtr->inputThreadCreated)
+                        AppJoinThread(channelPtr->inputThread);
+                    if (channelPtr->outputThreadCreated)
+                        AppJoinThread(channelPtr->outputThread);
+                    if (channelPtr->reconThreadCreated)
+                        AppJoinThread(channelPtr->reconThread);
+
+                    if (channelActive[instanceCount] == EB_FALSE)
+                        continue;
+
+                    exitConditionsInput[instanceCount]  = channelPtr->exitConditionInput;
+                    exitConditionsOutput[instanceCount] = channelPtr->exitConditionOutput;
+                    exitConditionsRecon[instanceCount]  = channelPtr->exitConditionRecon;
+                    channelActive[instanceCount] = EB_FALSE;
+                    if (configs[instanceCount]->reconFile)
+                        exitConditions[instanceCount] = (APPEXITCONDITIONTYPE)(exitConditionsRecon[instanceCount] | exitConditionsOutput[instanceCount] | exitConditionsInput[instanceCount]);
+                    else
+                        exitConditions[instanceCount] = (APPEXITCONDITIONTYPE)(exitConditionsOutput[instanceCount] | exitConditionsInput[instanceCount]);
                 }
 
                 for (instanceCount = 0; instanceCount < numChannels; ++instanceCount) {
@@ -301,6 +489,11 @@ int32_t main(int32_t argc, char* argv[])
                     printf("Error encoding at channel %u! Check error log file for more details ... \n", instanceCount + 1);
                 }
             }
+            // The profile is released with the encoder
+            for (instanceCount = 0; instanceCount < numChannels; ++instanceCount) {
+                if (configs[instanceCount]->pipelineTraceFile && return_errors[instanceCount] == EB_ErrorNone)
+                    WritePipelineTrace(configs[instanceCount], appCallbacks[instanceCount], instanceCount);
+            }
             // DeInit Encoder
             for (instanceCount = numChannels; instanceCount > 0; --instanceCount) {
                 if (return_errors[instanceCount - 1] == EB_ErrorNone)
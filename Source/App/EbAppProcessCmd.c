@@ -14,6 +14,7 @@
 #include "EbAppConfig.h"
 #include "EbErrorCodes.h"
 #include "EbAppInputy4m.h"
+#include "EbAppInputReader.h"
 
 #include "EbTime.h"
 
@@ -225,6 +226,14 @@ void LogErrorOutput(
         fprintf(errorLogFile, "Error: EncodeSplitFlag: context too large!\n");
         break;
 
+    case EB_ENC_EC_ERROR17:
+        fprintf(errorLogFile, "Error: EncodeSliceFinish: entropy coding buffer too small!\n");
+        break;
+
+    case EB_ENC_EC_ERROR18:
+        fprintf(errorLogFile, "Error: JoinEntropyCodingTiles: picture bitstream buffer too small!\n");
+        break;
+
     case EB_ENC_EC_ERROR26:
         fprintf(errorLogFile, "Error: Level not recognized!\n");
         break;
@@ -755,6 +764,102 @@ int32_t GetNextQpFromQpFile(
     return qp;
 }
 
+/***************************************
+ * Points the input planes into a frame
+ *  stored with the file layout
+ ***************************************/
+static void SetInputFramePlanes(
+    EbConfig_t                  *config,
+    uint8_t                      is16bit,
+    EbBufferHeaderType          *headerPtr,
+    uint8_t                     *framePtr){
+
+    uint32_t  inputPaddedWidth = config->inputPaddedWidth;
+    uint32_t  inputPaddedHeight = config->inputPaddedHeight;
+    uint64_t frameSize = (uint64_t)((inputPaddedWidth*inputPaddedHeight * 3) / 2 + (inputPaddedWidth / 4 * inputPaddedHeight * 3) / 2);
+
+    if (config->encoderBitDepth == 10 && config->compressedTenBitFormat == 1)
+    {
+        // Determine size of each plane
+
+        const size_t luma8bitSize = config->inputPaddedWidth * config->inputPaddedHeight;
+        const size_t chroma8bitSize = luma8bitSize >> 2;
+
+        const size_t luma2bitSize = luma8bitSize / 4; //4-2bit pixels into 1 byte
+        const size_t chroma2bitSize = luma2bitSize >> 2;
+
+        EbSvtEncInput* inputPtr = (EbSvtEncInput*)headerPtr->p_buffer;
+        inputPtr->yStride = config->inputPaddedWidth;
+        inputPtr->crStride = config->inputPaddedWidth >> 1;
+        inputPtr->cbStride = config->inputPaddedWidth >> 1;
+
+        inputPtr->luma = framePtr;
+        inputPtr->cb = framePtr + luma8bitSize;
+        inputPtr->cr = framePtr + luma8bitSize + chroma8bitSize;
+
+        inputPtr->luma = inputPtr->luma + ((config->inputPaddedWidth*TOP_INPUT_PADDING + LEFT_INPUT_PADDING));
+        inputPtr->cb = inputPtr->cb + (((config->inputPaddedWidth >> 1)*(TOP_INPUT_PADDING >> 1) + (LEFT_INPUT_PADDING >> 1)));
+        inputPtr->cr = inputPtr->cr + (((config->inputPaddedWidth >> 1)*(TOP_INPUT_PADDING >> 1) + (LEFT_INPUT_PADDING >> 1)));
+
+        if (is16bit) {
+            inputPtr->lumaExt = framePtr + luma8bitSize + 2 * chroma8bitSize;
+            inputPtr->cbExt = framePtr + luma8bitSize + 2 * chroma8bitSize + luma2bitSize;
+            inputPtr->crExt = framePtr + luma8bitSize + 2 * chroma8bitSize + luma2bitSize + chroma2bitSize;
+
+            inputPtr->lumaExt = inputPtr->lumaExt + config->inputPaddedWidth*TOP_INPUT_PADDING + LEFT_INPUT_PADDING;
+            inputPtr->cbExt = inputPtr->cbExt + (config->inputPaddedWidth >> 1)*(TOP_INPUT_PADDING >> 1) + (LEFT_INPUT_PADDING >> 1);
+            inputPtr->crExt = inputPtr->crExt + (config->inputPaddedWidth >> 1)*(TOP_INPUT_PADDING >> 1) + (LEFT_INPUT_PADDING >> 1);
+
+        }
+
+        headerPtr->n_filled_len = (uint32_t)frameSize;
+    }
+    else
+    {
+        const int32_t tenBitPackedMode = (config->encoderBitDepth > 8) && (config->compressedTenBitFormat == 0) ? 1 : 0;
+
+        // Determine size of each plane
+        const size_t luma8bitSize =
+            (config->inputPaddedWidth) *
+            (config->inputPaddedHeight) *
+            (1 << tenBitPackedMode);
+
+        const size_t chroma8bitSize = luma8bitSize >> 2;
+
+        const size_t luma10bitSize = (config->encoderBitDepth > 8 && tenBitPackedMode == 0) ? luma8bitSize : 0;
+        const size_t chroma10bitSize = (config->encoderBitDepth > 8 && tenBitPackedMode == 0) ? chroma8bitSize : 0;
+
+        EbSvtEncInput* inputPtr = (EbSvtEncInput*)headerPtr->p_buffer;
+
+        inputPtr->yStride = config->inputPaddedWidth;
+        inputPtr->crStride = config->inputPaddedWidth >> 1;
+        inputPtr->cbStride = config->inputPaddedWidth >> 1;
+
+        inputPtr->luma = framePtr;
+        inputPtr->cb = framePtr + luma8bitSize;
+        inputPtr->cr = framePtr + luma8bitSize + chroma8bitSize;
+        inputPtr->luma = inputPtr->luma + ((config->inputPaddedWidth*TOP_INPUT_PADDING + LEFT_INPUT_PADDING) << tenBitPackedMode);
+        inputPtr->cb = inputPtr->cb + (((config->inputPaddedWidth >> 1)*(TOP_INPUT_PADDING >> 1) + (LEFT_INPUT_PADDING >> 1)) << tenBitPackedMode);
+        inputPtr->cr = inputPtr->cr + (((config->inputPaddedWidth >> 1)*(TOP_INPUT_PADDING >> 1) + (LEFT_INPUT_PADDING >> 1)) << tenBitPackedMode);
+
+
+        if (is16bit) {
+            inputPtr->lumaExt = framePtr + luma8bitSize + 2 * chroma8bitSize;
+            inputPtr->cbExt = framePtr + luma8bitSize + 2 * chroma8bitSize + luma10bitSize;
+            inputPtr->crExt = framePtr + luma8bitSize + 2 * chroma8bitSize + luma10bitSize + chroma10bitSize;
+            inputPtr->lumaExt = inputPtr->lumaExt + config->inputPaddedWidth*TOP_INPUT_PADDING + LEFT_INPUT_PADDING;
+            inputPtr->cbExt = inputPtr->cbExt + (config->inputPaddedWidth >> 1)*(TOP_INPUT_PADDING >> 1) + (LEFT_INPUT_PADDING >> 1);
+            inputPtr->crExt = inputPtr->crExt + (config->inputPaddedWidth >> 1)*(TOP_INPUT_PADDING >> 1) + (LEFT_INPUT_PADDING >> 1);
+
+        }
+
+        headerPtr->n_filled_len = (uint32_t)(uint64_t)SIZE_OF_ONE_FRAME_IN_BYTES(inputPaddedWidth, inputPaddedHeight, is16bit);
+
+    }
+
+    return;
+}
+
 void ReadInputFrames(
     EbConfig_t                  *config,
     uint8_t                      is16bit,
@@ -767,11 +872,29 @@ void ReadInputFrames(
     uint8_t  *ebInputPtr;
     EbSvtEncInput* inputPtr = (EbSvtEncInput*)headerPtr->p_buffer;
 
-    uint64_t frameSize = (uint64_t)((inputPaddedWidth*inputPaddedHeight * 3) / 2 + (inputPaddedWidth / 4 * inputPaddedHeight * 3) / 2);
     inputPtr->yStride  = inputPaddedWidth;
     inputPtr->crStride = inputPaddedWidth >> 1;
     inputPtr->cbStride = inputPaddedWidth >> 1;
 
+    // Frames read ahead by the input reader thread, which owns the file
+    if (config->inputReader) {
+        uint32_t filledLen;
+
+        SetInputFramePlanes(
+            config,
+            is16bit,
+            headerPtr,
+            InputReaderGetFrame(config->inputReader, &filledLen));
+
+        headerPtr->n_filled_len = filledLen;
+
+        // End of a non seekable input
+        if (filledLen == 0)
+            config->stopEncoder = EB_TRUE;
+
+        return;
+    }
+
     if (config->bufferedInput == -1) {
 
         if (is16bit == 0 || (is16bit == 1 && config->compressedTenBitFormat == 0)) {
@@ -1042,88 +1165,12 @@ void ReadInputFrames(
         }
 
     }
-    else {
-        if (config->encoderBitDepth == 10 && config->compressedTenBitFormat == 1)
-        {
-            // Determine size of each plane
-
-            const size_t luma8bitSize = config->inputPaddedWidth * config->inputPaddedHeight;
-            const size_t chroma8bitSize = luma8bitSize >> 2;
-
-            const size_t luma2bitSize = luma8bitSize / 4; //4-2bit pixels into 1 byte
-            const size_t chroma2bitSize = luma2bitSize >> 2;
-
-            EbSvtEncInput* inputPtr = (EbSvtEncInput*)headerPtr->p_buffer;
-            inputPtr->yStride = config->inputPaddedWidth;
-            inputPtr->crStride = config->inputPaddedWidth >> 1;
-            inputPtr->cbStride = config->inputPaddedWidth >> 1;
-
-            inputPtr->luma = config->sequenceBuffer[config->processedFrameCount % config->bufferedInput];
-            inputPtr->cb = config->sequenceBuffer[config->processedFrameCount % config->bufferedInput] + luma8bitSize;
-            inputPtr->cr = config->sequenceBuffer[config->processedFrameCount % config->bufferedInput] + luma8bitSize + chroma8bitSize;
-
-            inputPtr->luma = inputPtr->luma + ((config->inputPaddedWidth*TOP_INPUT_PADDING + LEFT_INPUT_PADDING));
-            inputPtr->cb = inputPtr->cb + (((config->inputPaddedWidth >> 1)*(TOP_INPUT_PADDING >> 1) + (LEFT_INPUT_PADDING >> 1)));
-            inputPtr->cr = inputPtr->cr + (((config->inputPaddedWidth >> 1)*(TOP_INPUT_PADDING >> 1) + (LEFT_INPUT_PADDING >> 1)));
-
-            if (is16bit) {
-                inputPtr->lumaExt = config->sequenceBuffer[config->processedFrameCount % config->bufferedInput] + luma8bitSize + 2 * chroma8bitSize;
-                inputPtr->cbExt = config->sequenceBuffer[config->processedFrameCount % config->bufferedInput] + luma8bitSize + 2 * chroma8bitSize + luma2bitSize;
-                inputPtr->crExt = config->sequenceBuffer[config->processedFrameCount % config->bufferedInput] + luma8bitSize + 2 * chroma8bitSize + luma2bitSize + chroma2bitSize;
-
-                inputPtr->lumaExt = inputPtr->lumaExt + config->inputPaddedWidth*TOP_INPUT_PADDING + LEFT_INPUT_PADDING;
-                inputPtr->cbExt = inputPtr->cbExt + (config->inputPaddedWidth >> 1)*(TOP_INPUT_PADDING >> 1) + (LEFT_INPUT_PADDING >> 1);
-                inputPtr->crExt = inputPtr->crExt + (config->inputPaddedWidth >> 1)*(TOP_INPUT_PADDING >> 1) + (LEFT_INPUT_PADDING >> 1);
-
-            }
-
-            headerPtr->n_filled_len = (uint32_t)frameSize;
-        }
-        else
-        {
-            const int32_t tenBitPackedMode = (config->encoderBitDepth > 8) && (config->compressedTenBitFormat == 0) ? 1 : 0;
-
-            // Determine size of each plane
-            const size_t luma8bitSize =
-                (config->inputPaddedWidth) *
-                (config->inputPaddedHeight) *
-                (1 << tenBitPackedMode);
-
-            const size_t chroma8bitSize = luma8bitSize >> 2;
-
-            const size_t luma10bitSize = (config->encoderBitDepth > 8 && tenBitPackedMode == 0) ? luma8bitSize : 0;
-            const size_t chroma10bitSize = (config->encoderBitDepth > 8 && tenBitPackedMode == 0) ? chroma8bitSize : 0;
-
-            EbSvtEncInput* inputPtr = (EbSvtEncInput*)headerPtr->p_buffer;
-
-            inputPtr->yStride = config->inputPaddedWidth;
-            inputPtr->crStride = config->inputPaddedWidth >> 1;
-            inputPtr->cbStride = config->inputPaddedWidth >> 1;
-
-            inputPtr->luma = config->sequenceBuffer[config->processedFrameCount % config->bufferedInput];
-            inputPtr->cb = config->sequenceBuffer[config->processedFrameCount % config->bufferedInput] + luma8bitSize;
-            inputPtr->cr = config->sequenceBuffer[config->processedFrameCount % config->bufferedInput] + luma8bitSize + chroma8bitSize;
-            inputPtr->luma = inputPtr->luma + ((config->inputPaddedWidth*TOP_INPUT_PADDING + LEFT_INPUT_PADDING) << tenBitPackedMode);
-            inputPtr->cb = inputPtr->cb + (((config->inputPaddedWidth >> 1)*(TOP_INPUT_PADDING >> 1) + (LEFT_INPUT_PADDING >> 1)) << tenBitPackedMode);
-            inputPtr->cr = inputPtr->cr + (((config->inputPaddedWidth >> 1)*(TOP_INPUT_PADDING >> 1) + (LEFT_INPUT_PADDING >> 1)) << tenBitPackedMode);
-
-
-            if (is16bit) {
-                inputPtr->lumaExt = config->sequenceBuffer[config->processedFrameCount % config->bufferedInput] + luma8bitSize + 2 * chroma8bitSize;
-                inputPtr->cbExt = config->sequenceBuffer[config->processedFrameCount % config->bufferedInput] + luma8bitSize + 2 * chroma8bitSize + luma10bitSize;
-                inputPtr->crExt = config->sequenceBuffer[config->processedFrameCount % config->bufferedInput] + luma8bitSize + 2 * chroma8bitSize + luma10bitSize + chroma10bitSize;
-                inputPtr->lumaExt = inputPtr->lumaExt + config->inputPaddedWidth*TOP_INPUT_PADDING + LEFT_INPUT_PADDING;
-                inputPtr->cbExt = inputPtr->cbExt + (config->inputPaddedWidth >> 1)*(TOP_INPUT_PADDING >> 1) + (LEFT_INPUT_PADDING >> 1);
-                inputPtr->crExt = inputPtr->crExt + (config->inputPaddedWidth >> 1)*(TOP_INPUT_PADDING >> 1) + (LEFT_INPUT_PADDING >> 1);
-
-            }
-
-            headerPtr->n_filled_len = (uint32_t)(uint64_t)SIZE_OF_ONE_FRAME_IN_BYTES(inputPaddedWidth, inputPaddedHeight, is16bit);
-
-        }
-
-
-    }
+    else
+        SetInputFramePlanes(
+            config,
+            is16bit,
+            headerPtr,
+            config->sequenceBuffer[config->processedFrameCount % config->bufferedInput]);
 
     // If we reached the end of file, loop over again
     if (feof(inputFile) != 0) {
@@ -1236,6 +1283,10 @@ APPEXITCONDITIONTYPE ProcessInputBuffer(
         // Send the picture
         eb_svt_enc_send_picture(componentHandle, headerPtr);
 
+        // The picture is copied by the encoder, its frame can be read again
+        if (config->inputReader)
+            InputReaderReleaseFrame(config->inputReader);
+
         if ((config->processedFrameCount == (uint64_t)config->framesToBeEncoded) || config->stopEncoder) {
 
             headerPtr->n_alloc_len    = 0;
@@ -1363,9 +1414,6 @@ APPEXITCONDITIONTYPE ProcessOutputStreamBuffer(
     uint64_t               *totalLatency     = &config->performanceContext.totalLatency;
     uint32_t               *maxLatency       = &config->performanceContext.maxLatency;
 
-    // System performance variables
-    static int32_t         frameCount                = 0;
-
     // Local variables
     uint64_t                finishsTime     = 0;
     uint64_t                finishuTime     = 0;
@@ -1378,6 +1426,7 @@ APPEXITCONDITIONTYPE ProcessOutputStreamBuffer(
         LogErrorOutput(
             config->errorLogFile,
             headerPtr->flags);
+        eb_svt_release_out_buffer(&headerPtr);
         return APP_ExitConditionError;
     }
     else if (stream_status != EB_NoErrorEmptyQueue) {
@@ -1479,14 +1528,10 @@ APPEXITCONDITIONTYPE ProcessOutputStreamBuffer(
         // Release the output buffer
         eb_svt_release_out_buffer(&headerPtr);
 
-#if DEADLOCK_DEBUG
-        ++frameCount;
-#else
-        //++frameCount;
-        printf("\b\b\b\b\b\b\b\b\b%9d", ++frameCount);
+#if !DEADLOCK_DEBUG
+        printf("\b\b\b\b\b\b\b\b\b%9d", (int32_t)config->performanceContext.frameCount);
 #endif
 
-        //++frameCount;
         fflush(stdout);
 
         {
@@ -1494,10 +1539,10 @@ APPEXITCONDITIONTYPE ProcessOutputStreamBuffer(
             config->performanceContext.averageLatency = config->performanceContext.totalLatency / (double)(config->performanceContext.frameCount);
         }
 
-        if (!(frameCount % SPEED_MEASUREMENT_INTERVAL)) {
+        if (!(config->performanceContext.frameCount % SPEED_MEASUREMENT_INTERVAL)) {
             {
                 printf("\n");
-                printf("Average System Encoding Speed:        %.2f\n", (double)(frameCount) / config->performanceContext.total_encode_time);
+                printf("Average System Encoding Speed:        %.2f\n", (double)(config->performanceContext.frameCount) / config->performanceContext.total_encode_time);
             }
         }
     }
@@ -1544,3 +1589,71 @@ APPEXITCONDITIONTYPE ProcessOutputReconBuffer(
     return return_value;
 }
 
+/***************************************
+ * Pipeline Trace
+ *   Writes the pipeline profile of the channel as Chrome trace JSON
+ *   (chrome://tracing, Perfetto): one complete event per busy span, a
+ *   queue depth counter per stage and an async span per queued picture.
+ ***************************************/
+void WritePipelineTrace(
+    EbConfig_t             *config,
+    EbAppContext_t         *appCallBack,
+    uint32_t                instanceIndex)
+{
+    EbPipelineProfile   profile;
+    EbErrorType         return_error;
+    FILE               *traceFile = config->pipelineTraceFile;
+    const uint32_t      pid = instanceIndex + 1;
+    uint32_t            stageIndex;
+    uint32_t            eventIndex;
+
+    return_error = eb_svt_enc_get_pipeline_profile((EbComponentType*)appCallBack->svtEncoderHandle, &profile);
+    if (return_error != EB_ErrorNone) {
+        printf("\nChannel %u: pipeline profile unavailable\n", pid);
+        return;
+    }
+
+    printf("\nPIPELINE --------------------------------- Channel %u  --------------------------------\n", pid);
+    printf("%-26s %7s %8s %8s %8s %10s %10s\n", "Stage", "Threads", "Objects", "Busy %", "Idle %", "Avg Queue", "Max Queue");
+    for (stageIndex = 0; stageIndex < profile.stage_count; ++stageIndex) {
+        const EbPipelineStageStats *stats = &profile.stage_array[stageIndex];
+        const double threadTime = (double)profile.elapsed_time * stats->thread_count;
+
+        printf("%-26s %7u %8llu %8.1f %8.1f %10.2f %10u\n",
+            stats->name,
+            stats->thread_count,
+            (unsigned long long)stats->object_count,
+            threadTime > 0 ? 100.0 * (double)stats->busy_time / threadTime : 0.0,
+            threadTime > 0 ? 100.0 * (double)stats->idle_time / threadTime : 0.0,
+            stats->average_queue_depth,
+            stats->max_queue_depth);
+    }
+    if (profile.dropped_event_count)
+        printf("%llu events past the trace capacity were dropped\n", (unsigned long long)profile.dropped_event_count);
+    fflush(stdout);
+
+    fprintf(traceFile, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+    fprintf(traceFile, "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":%u,\"args\":{\"name\":\"Channel %u\"}}", pid, pid);
+
+    for (eventIndex = 0; eventIndex < profile.event_count; ++eventIndex) {
+        const EbPipelineEvent *event = &profile.event_array[eventIndex];
+        const char *name = profile.stage_array[event->stage].name;
+
+        if (event->type == EB_PIPELINE_EVENT_BUSY) {
+            fprintf(traceFile, ",\n{\"name\":\"%s\",\"cat\":\"busy\",\"ph\":\"X\",\"ts\":%llu,\"dur\":%llu,\"pid\":%u,\"tid\":%u,\"args\":{\"picture\":%lld}}",
+                name, (unsigned long long)event->timestamp, (unsigned long long)event->duration, pid, event->thread_index, (long long)event->object_id);
+            continue;
+        }
+
+        fprintf(traceFile, ",\n{\"name\":\"%s queue\",\"ph\":\"C\",\"ts\":%llu,\"pid\":%u,\"args\":{\"depth\":%u}}",
+            name, (unsigned long long)event->timestamp, pid, event->queue_depth);
+
+        // Time spent by the picture in the stage input queue
+        if (event->object_id != ~0ull)
+            fprintf(traceFile, ",\n{\"name\":\"%s wait\",\"cat\":\"queue\",\"ph\":\"%s\",\"id\":%llu,\"ts\":%llu,\"pid\":%u,\"tid\":0}",
+                name, event->type == EB_PIPELINE_EVENT_ENQUEUE ? "b" : "e", (unsigned long long)event->object_id, (unsigned long long)event->timestamp, pid);
+    }
+
+    fprintf(traceFile, "\n]}\n");
+    fflush(traceFile);
+}
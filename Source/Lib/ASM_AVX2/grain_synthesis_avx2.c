@@ -0,0 +1,196 @@
+/*
+* Copyright(c) 2019 Intel Corporation
+* SPDX - License - Identifier: BSD - 2 - Clause - Patent
+*/
+
+#include <immintrin.h>
+
+#include "EbDefinitions.h"
+#include "aom_dsp_rtcd.h"
+
+/*
+ * Film grain synthesis kernels, 8 samples at a time in 32-bit lanes. The
+ * scaling function lookups are gathers; the rest is the integer arithmetic
+ * of the C version, so the output is the same bit for bit.
+ */
+
+static INLINE __m256i clamp_epi32(__m256i v, __m256i min, __m256i max) {
+    return _mm256_min_epi32(_mm256_max_epi32(v, min), max);
+}
+
+// (scale * grain + rounding_offset) >> scaling_shift
+static INLINE __m256i scale_grain(__m256i scale, const int32_t *grain,
+    __m256i rounding_offset, __m128i scaling_shift) {
+    return _mm256_sra_epi32(_mm256_add_epi32(_mm256_mullo_epi32(scale,
+        _mm256_loadu_si256((const __m256i *)grain)), rounding_offset), scaling_shift);
+}
+
+// Interpolated lookup of scale_LUT(): x + 1 is clipped to 255, where the
+// difference to the next entry then vanishes as it does in the C version.
+static INLINE __m256i scale_lut_hbd(const int32_t *scaling_lut, __m256i index,
+    int32_t bit_depth) {
+    const __m128i shift = _mm_cvtsi32_si128(bit_depth - 8);
+    const __m256i x = _mm256_srl_epi32(index, shift);
+    const __m256i x_next = _mm256_min_epi32(_mm256_add_epi32(x, _mm256_set1_epi32(1)),
+        _mm256_set1_epi32(255));
+    const __m256i lut = _mm256_i32gather_epi32(scaling_lut, x, 4);
+    const __m256i lut_next = _mm256_i32gather_epi32(scaling_lut, x_next, 4);
+    const __m256i frac = _mm256_and_si256(index, _mm256_set1_epi32((1 << (bit_depth - 8)) - 1));
+    const __m256i round = _mm256_set1_epi32(bit_depth > 8 ? 1 << (bit_depth - 9) : 0);
+
+    return _mm256_add_epi32(lut, _mm256_sra_epi32(_mm256_add_epi32(
+        _mm256_mullo_epi32(_mm256_sub_epi32(lut_next, lut), frac), round), shift));
+}
+
+static INLINE __m256i load_8x8bit(const uint8_t *src) {
+    return _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i *)src));
+}
+
+static INLINE __m256i load_8x16bit(const uint16_t *src) {
+    return _mm256_cvtepu16_epi32(_mm_loadu_si128((const __m128i *)src));
+}
+
+static INLINE void store_8x8bit(uint8_t *dst, __m256i v) {
+    const __m128i v16 = _mm_packus_epi32(_mm256_castsi256_si128(v),
+        _mm256_extracti128_si256(v, 1));
+    _mm_storel_epi64((__m128i *)dst, _mm_packus_epi16(v16, v16));
+}
+
+static INLINE void store_8x16bit(uint16_t *dst, __m256i v) {
+    _mm_storeu_si128((__m128i *)dst, _mm_packus_epi32(_mm256_castsi256_si128(v),
+        _mm256_extracti128_si256(v, 1)));
+}
+
+// Scaling function index of the chroma samples, from the blend of the
+// chroma and the (horizontally averaged) luma
+static INLINE __m256i chroma_index(__m256i average_luma, __m256i chroma,
+    __m256i luma_mult, __m256i mult, __m256i offset, __m256i max_index) {
+    const __m256i blend = _mm256_add_epi32(_mm256_mullo_epi32(average_luma, luma_mult),
+        _mm256_mullo_epi32(mult, chroma));
+    return clamp_epi32(_mm256_add_epi32(_mm256_srai_epi32(blend, 6), offset),
+        _mm256_setzero_si256(), max_index);
+}
+
+void av1_add_noise_to_luma_row_avx2(uint8_t *luma, const int32_t *grain,
+    const int32_t *scaling_lut, int32_t width, int32_t scaling_shift,
+    int32_t min_luma, int32_t max_luma) {
+    const __m256i rounding_offset = _mm256_set1_epi32(1 << (scaling_shift - 1));
+    const __m128i shift = _mm_cvtsi32_si128(scaling_shift);
+    const __m256i min = _mm256_set1_epi32(min_luma);
+    const __m256i max = _mm256_set1_epi32(max_luma);
+    int32_t j;
+
+    for (j = 0; j + 8 <= width; j += 8) {
+        const __m256i y = load_8x8bit(luma + j);
+        const __m256i noise = scale_grain(_mm256_i32gather_epi32(scaling_lut, y, 4),
+            grain + j, rounding_offset, shift);
+        store_8x8bit(luma + j, clamp_epi32(_mm256_add_epi32(y, noise), min, max));
+    }
+    if (j < width) {
+        av1_add_noise_to_luma_row_c(luma + j, grain + j, scaling_lut, width - j,
+            scaling_shift, min_luma, max_luma);
+    }
+}
+
+void av1_add_noise_to_luma_row_hbd_avx2(uint16_t *luma, const int32_t *grain,
+    const int32_t *scaling_lut, int32_t width, int32_t bit_depth,
+    int32_t scaling_shift, int32_t min_luma, int32_t max_luma) {
+    const __m256i rounding_offset = _mm256_set1_epi32(1 << (scaling_shift - 1));
+    const __m128i shift = _mm_cvtsi32_si128(scaling_shift);
+    const __m256i min = _mm256_set1_epi32(min_luma);
+    const __m256i max = _mm256_set1_epi32(max_luma);
+    int32_t j;
+
+    for (j = 0; j + 8 <= width; j += 8) {
+        const __m256i y = load_8x16bit(luma + j);
+        const __m256i noise = scale_grain(scale_lut_hbd(scaling_lut, y, bit_depth),
+            grain + j, rounding_offset, shift);
+        store_8x16bit(luma + j, clamp_epi32(_mm256_add_epi32(y, noise), min, max));
+    }
+    if (j < width) {
+        av1_add_noise_to_luma_row_hbd_c(luma + j, grain + j, scaling_lut, width - j,
+            bit_depth, scaling_shift, min_luma, max_luma);
+    }
+}
+
+void av1_add_noise_to_chroma_row_avx2(uint8_t *chroma, const uint8_t *luma,
+    const int32_t *grain, const int32_t *scaling_lut, int32_t width,
+    int32_t chroma_subsamp_x, int32_t luma_mult, int32_t mult, int32_t offset,
+    int32_t scaling_shift, int32_t min_chroma, int32_t max_chroma) {
+    const __m256i rounding_offset = _mm256_set1_epi32(1 << (scaling_shift - 1));
+    const __m128i shift = _mm_cvtsi32_si128(scaling_shift);
+    const __m256i min = _mm256_set1_epi32(min_chroma);
+    const __m256i max = _mm256_set1_epi32(max_chroma);
+    const __m256i luma_mult_v = _mm256_set1_epi32(luma_mult);
+    const __m256i mult_v = _mm256_set1_epi32(mult);
+    const __m256i offset_v = _mm256_set1_epi32(offset);
+    const __m256i max_index = _mm256_set1_epi32(255);
+    const __m256i ones = _mm256_set1_epi16(1);
+    int32_t j;
+
+    for (j = 0; j + 8 <= width; j += 8) {
+        __m256i average_luma;
+        if (chroma_subsamp_x) {
+            // Sums of the 8 luma pairs
+            average_luma = _mm256_madd_epi16(_mm256_cvtepu8_epi16(
+                _mm_loadu_si128((const __m128i *)(luma + (j << 1)))), ones);
+            average_luma = _mm256_srai_epi32(_mm256_add_epi32(average_luma,
+                _mm256_set1_epi32(1)), 1);
+        }
+        else
+            average_luma = load_8x8bit(luma + j);
+
+        const __m256i c = load_8x8bit(chroma + j);
+        const __m256i index = chroma_index(average_luma, c, luma_mult_v, mult_v,
+            offset_v, max_index);
+        const __m256i noise = scale_grain(_mm256_i32gather_epi32(scaling_lut, index, 4),
+            grain + j, rounding_offset, shift);
+        store_8x8bit(chroma + j, clamp_epi32(_mm256_add_epi32(c, noise), min, max));
+    }
+    if (j < width) {
+        av1_add_noise_to_chroma_row_c(chroma + j, luma + (j << chroma_subsamp_x),
+            grain + j, scaling_lut, width - j, chroma_subsamp_x, luma_mult, mult,
+            offset, scaling_shift, min_chroma, max_chroma);
+    }
+}
+
+void av1_add_noise_to_chroma_row_hbd_avx2(uint16_t *chroma, const uint16_t *luma,
+    const int32_t *grain, const int32_t *scaling_lut, int32_t width,
+    int32_t chroma_subsamp_x, int32_t luma_mult, int32_t mult, int32_t offset,
+    int32_t bit_depth, int32_t scaling_shift, int32_t min_chroma, int32_t max_chroma) {
+    const __m256i rounding_offset = _mm256_set1_epi32(1 << (scaling_shift - 1));
+    const __m128i shift = _mm_cvtsi32_si128(scaling_shift);
+    const __m256i min = _mm256_set1_epi32(min_chroma);
+    const __m256i max = _mm256_set1_epi32(max_chroma);
+    const __m256i luma_mult_v = _mm256_set1_epi32(luma_mult);
+    const __m256i mult_v = _mm256_set1_epi32(mult);
+    const __m256i offset_v = _mm256_set1_epi32(offset);
+    const __m256i max_index = _mm256_set1_epi32((256 << (bit_depth - 8)) - 1);
+    const __m256i ones = _mm256_set1_epi16(1);
+    int32_t j;
+
+    for (j = 0; j + 8 <= width; j += 8) {
+        __m256i average_luma;
+        if (chroma_subsamp_x) {
+            // Sums of the 8 luma pairs, the samples fit in signed 16 bits
+            average_luma = _mm256_madd_epi16(
+                _mm256_loadu_si256((const __m256i *)(luma + (j << 1))), ones);
+            average_luma = _mm256_srai_epi32(_mm256_add_epi32(average_luma,
+                _mm256_set1_epi32(1)), 1);
+        }
+        else
+            average_luma = load_8x16bit(luma + j);
+
+        const __m256i c = load_8x16bit(chroma + j);
+        const __m256i index = chroma_index(average_luma, c, luma_mult_v, mult_v,
+            offset_v, max_index);
+        const __m256i noise = scale_grain(scale_lut_hbd(scaling_lut, index, bit_depth),
+            grain + j, rounding_offset, shift);
+        store_8x16bit(chroma + j, clamp_epi32(_mm256_add_epi32(c, noise), min, max));
+    }
+    if (j < width) {
+        av1_add_noise_to_chroma_row_hbd_c(chroma + j, luma + (j << chroma_subsamp_x),
+            grain + j, scaling_lut, width - j, chroma_subsamp_x, luma_mult, mult,
+            offset, bit_depth, scaling_shift, min_chroma, max_chroma);
+    }
+}
@@ -0,0 +1,178 @@
+/*
+* Copyright(c) 2019 Intel Corporation
+* SPDX - License - Identifier: BSD - 2 - Clause - Patent
+*/
+
+#include <immintrin.h>
+
+#include "EbDefinitions.h"
+#include "aom_dsp_rtcd.h"
+
+/*
+ * Film grain estimation kernels. Each output sample is computed with the
+ * operations of the C version, in the same order, so that the estimated grain
+ * does not depend on the instruction set. This file is built without the
+ * contraction of multiplies and adds into FMAs, which would round differently.
+ */
+
+void aom_noise_tx_filter_block_avx2(float *tx_block, const float *psd,
+    int32_t block_size) {
+    const int32_t n = block_size * block_size;
+    const float kBeta = 1.1f;
+    const float kEps = 1e-6f;
+    const float kAttenuation = (kBeta - 1.0f) / kBeta;
+    const __m256i psd_dup = _mm256_setr_epi32(0, 0, 1, 1, 2, 2, 3, 3);
+    // No float lies between 1e-6f and 1e-6, so p > 1e-6 in double is p > 1e-6f
+    const __m256 threshold = _mm256_set1_ps(1e-6f);
+    int32_t i;
+
+    for (i = 0; i + 4 <= n; i += 4) {
+        // 4 complex coefficients, p in both lanes of each
+        const __m256 c = _mm256_loadu_ps(tx_block + 2 * i);
+        const __m256 sq = _mm256_mul_ps(c, c);
+        const __m256 p = _mm256_add_ps(sq, _mm256_permute_ps(sq, 0xB1));
+        const __m256 psd_i = _mm256_permutevar8x32_ps(
+            _mm256_castps128_ps256(_mm_loadu_ps(psd + i)), psd_dup);
+        const __m256 filter = _mm256_and_ps(
+            _mm256_cmp_ps(p, _mm256_mul_ps(_mm256_set1_ps(kBeta), psd_i), _CMP_GT_OQ),
+            _mm256_cmp_ps(p, threshold, _CMP_GT_OQ));
+        const __m256 gain = _mm256_div_ps(_mm256_sub_ps(p, psd_i),
+            _mm256_max_ps(p, _mm256_set1_ps(kEps)));
+        const __m256 scale = _mm256_blendv_ps(_mm256_set1_ps(kAttenuation), gain, filter);
+        _mm256_storeu_ps(tx_block + 2 * i, _mm256_mul_ps(c, scale));
+    }
+    for (; i < n; ++i) {
+        float *c = tx_block + 2 * i;
+        const float p = c[0] * c[0] + c[1] * c[1];
+        if (p > kBeta * psd[i] && p > 1e-6) {
+            c[0] *= (p - psd[i]) / AOMMAX(p, kEps);
+            c[1] *= (p - psd[i]) / AOMMAX(p, kEps);
+        }
+        else {
+            c[0] *= kAttenuation;
+            c[1] *= kAttenuation;
+        }
+    }
+}
+
+void aom_flat_block_load_avx2(const uint8_t *data, int32_t stride,
+    int32_t use_highbd, int32_t block_size, double normalization, double *block) {
+    const __m256d norm = _mm256_set1_pd(normalization);
+    const uint16_t *const data16 = (const uint16_t *)data;
+    int32_t xi, yi;
+
+    for (yi = 0; yi < block_size; ++yi) {
+        for (xi = 0; xi + 4 <= block_size; xi += 4) {
+            const __m128i pixels = use_highbd ?
+                _mm_cvtepu16_epi32(_mm_loadl_epi64((const __m128i *)(data16 + yi * stride + xi))) :
+                _mm_cvtepu8_epi32(_mm_cvtsi32_si128(*(const int32_t *)(data + yi * stride + xi)));
+            _mm256_storeu_pd(block + yi * block_size + xi,
+                _mm256_div_pd(_mm256_cvtepi32_pd(pixels), norm));
+        }
+        for (; xi < block_size; ++xi) {
+            block[yi * block_size + xi] = (use_highbd ?
+                (double)data16[yi * stride + xi] : (double)data[yi * stride + xi]) / normalization;
+        }
+    }
+}
+
+void aom_flat_block_remove_plane_avx2(const double *A, const double *AtA_inv,
+    int32_t n, double *plane, double *block) {
+    const __m256i row_mask = _mm256_setr_epi64x(-1, -1, -1, 0);
+    const __m128i column = _mm_setr_epi32(0, 3, 6, 9);
+    DECLARE_ALIGNED(32, double, AtA_inv_b[4]);
+    double plane_coords[3];
+    __m256d sum = _mm256_setzero_pd();
+    int32_t i, k;
+
+    // A' * block, the 3 sums in the lanes of sum
+    for (i = 0; i < n; ++i) {
+        sum = _mm256_add_pd(sum, _mm256_mul_pd(_mm256_set1_pd(block[i]),
+            _mm256_maskload_pd(A + 3 * i, row_mask)));
+    }
+    _mm256_store_pd(AtA_inv_b, sum);
+
+    for (i = 0; i < 3; ++i) {
+        double coord = 0;
+        for (k = 0; k < 3; ++k)
+            coord += AtA_inv[i * 3 + k] * AtA_inv_b[k];
+        plane_coords[i] = coord;
+    }
+
+    for (i = 0; i + 4 <= n; i += 4) {
+        __m256d p = _mm256_setzero_pd();
+        for (k = 0; k < 3; ++k) {
+            p = _mm256_add_pd(p, _mm256_mul_pd(_mm256_i32gather_pd(A + 3 * i + k, column, 8),
+                _mm256_set1_pd(plane_coords[k])));
+        }
+        _mm256_storeu_pd(plane + i, p);
+        _mm256_storeu_pd(block + i, _mm256_sub_pd(_mm256_loadu_pd(block + i), p));
+    }
+    for (; i < n; ++i) {
+        double p = 0;
+        for (k = 0; k < 3; ++k)
+            p += A[3 * i + k] * plane_coords[k];
+        plane[i] = p;
+        block[i] -= p;
+    }
+}
+
+static INLINE __m256 cvt_8pd_ps(const double *d) {
+    return _mm256_insertf128_ps(_mm256_castps128_ps256(_mm256_cvtpd_ps(_mm256_loadu_pd(d))),
+        _mm256_cvtpd_ps(_mm256_loadu_pd(d + 4)), 1);
+}
+
+void aom_wiener_window_block_avx2(const double *block_d, const double *plane_d,
+    const float *window, int32_t n, float *block, float *plane) {
+    int32_t i;
+
+    for (i = 0; i + 8 <= n; i += 8) {
+        const __m256 w = _mm256_loadu_ps(window + i);
+        _mm256_storeu_ps(block + i, _mm256_mul_ps(cvt_8pd_ps(block_d + i), w));
+        _mm256_storeu_ps(plane + i, _mm256_mul_ps(cvt_8pd_ps(plane_d + i), w));
+    }
+    for (; i < n; ++i) {
+        block[i] = (float)block_d[i] * window[i];
+        plane[i] = (float)plane_d[i] * window[i];
+    }
+}
+
+void aom_wiener_accumulate_block_avx2(const float *block, const float *plane,
+    const float *window, int32_t block_w, int32_t y_start, int32_t y_end,
+    float *result, int32_t result_stride) {
+    for (int32_t y = y_start; y < y_end; ++y) {
+        const float *b = block + y * block_w;
+        const float *p = plane + y * block_w;
+        const float *w = window + y * block_w;
+        float *r = result + y * result_stride;
+        int32_t x;
+
+        for (x = 0; x + 8 <= block_w; x += 8) {
+            const __m256 sum = _mm256_add_ps(_mm256_loadu_ps(b + x), _mm256_loadu_ps(p + x));
+            _mm256_storeu_ps(r + x, _mm256_add_ps(_mm256_loadu_ps(r + x),
+                _mm256_mul_ps(sum, _mm256_loadu_ps(w + x))));
+        }
+        for (; x < block_w; ++x)
+            r[x] += (b[x] + p[x]) * w[x];
+    }
+}
+
+void aom_noise_add_observation_avx2(const double *buffer, double val,
+    double normalization, int32_t n, double *A, double *b) {
+    const double normalization2 = normalization * normalization;
+    const __m256d norm2 = _mm256_set1_pd(normalization2);
+
+    for (int32_t i = 0; i < n; ++i) {
+        const __m256d buffer_i = _mm256_set1_pd(buffer[i]);
+        double *A_i = A + i * n;
+        int32_t j;
+
+        for (j = 0; j + 4 <= n; j += 4) {
+            _mm256_storeu_pd(A_i + j, _mm256_add_pd(_mm256_loadu_pd(A_i + j),
+                _mm256_div_pd(_mm256_mul_pd(buffer_i, _mm256_loadu_pd(buffer + j)), norm2)));
+        }
+        for (; j < n; ++j)
+            A_i[j] += (buffer[i] * buffer[j]) / normalization2;
+        b[i] += (buffer[i] * val) / normalization2;
+    }
+}
@@ -0,0 +1,337 @@
+/*
+* Copyright(c) 2019 Intel Corporation
+* SPDX - License - Identifier: BSD - 2 - Clause - Patent
+*/
+
+/*
+* Copyright (c) 2016, Alliance for Open Media. All rights reserved
+*
+* This source code is subject to the terms of the BSD 2 Clause License and
+* the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+* was not distributed with this source code in the LICENSE file, you can
+* obtain it at www.aomedia.org/license/software. If the Alliance for Open
+* Media Patent License 1.0 was not distributed with this source code in the
+* PATENTS file, you can obtain it at www.aomedia.org/license/patent.
+*/
+
+#include <assert.h>
+#include <string.h>
+#include <immintrin.h>
+
+#include "EbDefinitions.h"
+#include "aom_dsp_rtcd.h"
+#include "EbWarpedMotion.h"
+
+/* Note: For an explanation of the warp algorithm, and some notes on bit widths
+    for hardware implementations, see the comments above av1_warp_affine_c.
+
+    Same data layout as the SSE4.1 kernels: the horizontal filter processes
+    two rows per pass, one in each 128-bit lane, and the vertical filter
+    computes the 8 outputs of a row in one 256-bit accumulator.
+*/
+
+static INLINE __m128i warp_filter_coeffs_avx2(int32_t sx) {
+    const int32_t offs = ROUND_POWER_OF_TWO(sx, WARPEDDIFF_PREC_BITS) +
+        WARPEDPIXEL_PREC_SHIFTS;
+    assert(offs >= 0 && offs <= WARPEDPIXEL_PREC_SHIFTS * 3);
+    return _mm_loadu_si128((const __m128i *)warped_filter[offs]);
+}
+
+// The filters of phase s0 in the low lane and s1 in the high lane
+static INLINE __m256i warp_filter_coeffs_x2_avx2(int32_t s0, int32_t s1) {
+    return _mm256_inserti128_si256(
+        _mm256_castsi128_si256(warp_filter_coeffs_avx2(s0)),
+        warp_filter_coeffs_avx2(s1),
+        1);
+}
+
+// Loads the samples ix4 - 7 .. ix4 + 8 of a reference row as 16-bit values,
+// clamped to the left and right frame edges like the C reference
+static INLINE void warp_load_row_avx2(const uint8_t *ref8,
+    const uint16_t *ref16, int32_t width, int32_t ix4,
+    __m128i *src_lo, __m128i *src_hi) {
+    if (ix4 - 7 >= 0 && ix4 + 9 <= width) {
+        if (ref16) {
+            *src_lo = _mm_loadu_si128((const __m128i *)(ref16 + ix4 - 7));
+            *src_hi = _mm_loadu_si128((const __m128i *)(ref16 + ix4 + 1));
+        }
+        else {
+            const __m128i src = _mm_loadu_si128((const __m128i *)(ref8 + ix4 - 7));
+            *src_lo = _mm_cvtepu8_epi16(src);
+            *src_hi = _mm_unpackhi_epi8(src, _mm_setzero_si128());
+        }
+    }
+    else {
+        DECLARE_ALIGNED(16, uint16_t, row[16]);
+        for (int32_t m = 0; m < 16; ++m) {
+            const int32_t sample_x = clamp(ix4 - 7 + m, 0, width - 1);
+            row[m] = ref16 ? ref16[sample_x] : ref8[sample_x];
+        }
+        *src_lo = _mm_load_si128((const __m128i *)row);
+        *src_hi = _mm_load_si128((const __m128i *)(row + 8));
+    }
+}
+
+// Filters two rows of 8 outputs, the row of phase sx in the low lane and the
+// row of phase sx + beta in the high lane
+static INLINE __m256i warp_horizontal_filter_avx2(const __m256i src_lo,
+    const __m256i src_hi, int32_t sx, int32_t alpha, int32_t beta,
+    const __m256i round_const, const __m128i round_shift) {
+    const int32_t sy = sx + beta;
+    const __m256i m0 = _mm256_madd_epi16(src_lo, warp_filter_coeffs_x2_avx2(sx, sy));
+    const __m256i m1 = _mm256_madd_epi16(_mm256_alignr_epi8(src_hi, src_lo, 2), warp_filter_coeffs_x2_avx2(sx + alpha, sy + alpha));
+    const __m256i m2 = _mm256_madd_epi16(_mm256_alignr_epi8(src_hi, src_lo, 4), warp_filter_coeffs_x2_avx2(sx + 2 * alpha, sy + 2 * alpha));
+    const __m256i m3 = _mm256_madd_epi16(_mm256_alignr_epi8(src_hi, src_lo, 6), warp_filter_coeffs_x2_avx2(sx + 3 * alpha, sy + 3 * alpha));
+    const __m256i m4 = _mm256_madd_epi16(_mm256_alignr_epi8(src_hi, src_lo, 8), warp_filter_coeffs_x2_avx2(sx + 4 * alpha, sy + 4 * alpha));
+    const __m256i m5 = _mm256_madd_epi16(_mm256_alignr_epi8(src_hi, src_lo, 10), warp_filter_coeffs_x2_avx2(sx + 5 * alpha, sy + 5 * alpha));
+    const __m256i m6 = _mm256_madd_epi16(_mm256_alignr_epi8(src_hi, src_lo, 12), warp_filter_coeffs_x2_avx2(sx + 6 * alpha, sy + 6 * alpha));
+    const __m256i m7 = _mm256_madd_epi16(_mm256_alignr_epi8(src_hi, src_lo, 14), warp_filter_coeffs_x2_avx2(sx + 7 * alpha, sy + 7 * alpha));
+
+    __m256i sum_0123 = _mm256_hadd_epi32(_mm256_hadd_epi32(m0, m1), _mm256_hadd_epi32(m2, m3));
+    __m256i sum_4567 = _mm256_hadd_epi32(_mm256_hadd_epi32(m4, m5), _mm256_hadd_epi32(m6, m7));
+
+    sum_0123 = _mm256_sra_epi32(_mm256_add_epi32(sum_0123, round_const), round_shift);
+    sum_4567 = _mm256_sra_epi32(_mm256_add_epi32(sum_4567, round_const), round_shift);
+
+    return _mm256_packs_epi32(sum_0123, sum_4567);
+}
+
+// Gathers the filters of the 8 outputs of a row, coeffs[p] holding tap pair
+// p of outputs 0..3 in the low lane and of outputs 4..7 in the high lane
+static INLINE void warp_vertical_coeffs_avx2(int32_t sy, int32_t gamma,
+    __m256i *coeffs) {
+    const __m256i c0 = warp_filter_coeffs_x2_avx2(sy, sy + 4 * gamma);
+    const __m256i c1 = warp_filter_coeffs_x2_avx2(sy + gamma, sy + 5 * gamma);
+    const __m256i c2 = warp_filter_coeffs_x2_avx2(sy + 2 * gamma, sy + 6 * gamma);
+    const __m256i c3 = warp_filter_coeffs_x2_avx2(sy + 3 * gamma, sy + 7 * gamma);
+
+    const __m256i t0 = _mm256_unpacklo_epi32(c0, c1);
+    const __m256i t1 = _mm256_unpacklo_epi32(c2, c3);
+    const __m256i t2 = _mm256_unpackhi_epi32(c0, c1);
+    const __m256i t3 = _mm256_unpackhi_epi32(c2, c3);
+
+    coeffs[0] = _mm256_unpacklo_epi64(t0, t1);
+    coeffs[1] = _mm256_unpackhi_epi64(t0, t1);
+    coeffs[2] = _mm256_unpacklo_epi64(t2, t3);
+    coeffs[3] = _mm256_unpackhi_epi64(t2, t3);
+}
+
+static INLINE void warp_store_avx2(uint8_t *pred8, uint16_t *pred16,
+    int32_t bd, int32_t count, __m256i res) {
+    const __m128i res_lo = _mm256_castsi256_si128(res);
+    const __m128i res_hi = _mm256_extracti128_si256(res, 1);
+    __m128i out;
+
+    if (pred16) {
+        out = _mm_packus_epi32(res_lo, res_hi);
+        out = _mm_min_epu16(out, _mm_set1_epi16((int16_t)((1 << bd) - 1)));
+        if (count == 8)
+            _mm_storeu_si128((__m128i *)pred16, out);
+        else {
+            DECLARE_ALIGNED(16, uint16_t, row[8]);
+            _mm_store_si128((__m128i *)row, out);
+            memcpy(pred16, row, count * sizeof(*pred16));
+        }
+    }
+    else {
+        out = _mm_packs_epi32(res_lo, res_hi);
+        out = _mm_packus_epi16(out, out);
+        if (count == 8)
+            _mm_storel_epi64((__m128i *)pred8, out);
+        else {
+            DECLARE_ALIGNED(16, uint8_t, row[16]);
+            _mm_store_si128((__m128i *)row, out);
+            memcpy(pred8, row, count);
+        }
+    }
+}
+
+static INLINE void warp_affine_avx2(const int32_t *mat, const uint8_t *ref8,
+    const uint16_t *ref16, int32_t width, int32_t height, int32_t stride,
+    uint8_t *pred8, uint16_t *pred16, int32_t p_col, int32_t p_row,
+    int32_t p_width, int32_t p_height, int32_t p_stride, int32_t subsampling_x,
+    int32_t subsampling_y, int32_t bd, int32_t reduce_bits_horiz,
+    ConvolveParams *conv_params, int16_t alpha, int16_t beta, int16_t gamma,
+    int16_t delta) {
+    __m128i tmp[16];
+    __m256i coeffs[4];
+    const int32_t reduce_bits_vert = conv_params->is_compound
+        ? conv_params->round_1
+        : 2 * FILTER_BITS - reduce_bits_horiz;
+    const int32_t offset_bits_horiz = bd + FILTER_BITS - 1;
+    const int32_t offset_bits_vert = bd + 2 * FILTER_BITS - reduce_bits_horiz;
+    const int32_t round_bits =
+        2 * FILTER_BITS - conv_params->round_0 - conv_params->round_1;
+    const int32_t offset_bits = bd + 2 * FILTER_BITS - conv_params->round_0;
+
+    const __m256i round_const_horiz = _mm256_set1_epi32(
+        (1 << offset_bits_horiz) + ((1 << reduce_bits_horiz) >> 1));
+    const __m128i round_shift_horiz = _mm_cvtsi32_si128(reduce_bits_horiz);
+    const __m256i round_const_vert = _mm256_set1_epi32(
+        (1 << offset_bits_vert) + ((1 << reduce_bits_vert) >> 1));
+    const __m128i round_shift_vert = _mm_cvtsi32_si128(reduce_bits_vert);
+    const __m256i res_sub_const = _mm256_set1_epi32(conv_params->is_compound
+        ? (1 << (offset_bits - conv_params->round_1)) + (1 << (offset_bits - conv_params->round_1 - 1))
+        : (1 << (bd - 1)) + (1 << bd));
+    const __m256i round_const_bits = _mm256_set1_epi32((1 << round_bits) >> 1);
+    const __m128i round_shift_bits = _mm_cvtsi32_si128(round_bits);
+    const __m256i fwd_offset = _mm256_set1_epi32(conv_params->fwd_offset);
+    const __m256i bck_offset = _mm256_set1_epi32(conv_params->bck_offset);
+
+    assert(IMPLIES(conv_params->is_compound, conv_params->dst != NULL));
+    assert(IMPLIES(conv_params->do_average, conv_params->is_compound));
+
+    for (int32_t i = p_row; i < p_row + p_height; i += 8) {
+        for (int32_t j = p_col; j < p_col + p_width; j += 8) {
+            // Calculate the center of this 8x8 block,
+            // project to luma coordinates (if in a subsampled chroma plane),
+            // apply the affine transformation,
+            // then convert back to the original coordinates (if necessary)
+            const int32_t src_x = (j + 4) << subsampling_x;
+            const int32_t src_y = (i + 4) << subsampling_y;
+            const int32_t dst_x = mat[2] * src_x + mat[3] * src_y + mat[0];
+            const int32_t dst_y = mat[4] * src_x + mat[5] * src_y + mat[1];
+            const int32_t x4 = dst_x >> subsampling_x;
+            const int32_t y4 = dst_y >> subsampling_y;
+
+            const int32_t ix4 = x4 >> WARPEDMODEL_PREC_BITS;
+            int32_t sx4 = x4 & ((1 << WARPEDMODEL_PREC_BITS) - 1);
+            const int32_t iy4 = y4 >> WARPEDMODEL_PREC_BITS;
+            int32_t sy4 = y4 & ((1 << WARPEDMODEL_PREC_BITS) - 1);
+
+            const int32_t out_rows = AOMMIN(8, p_row + p_height - i);
+            const int32_t out_cols = AOMMIN(8, p_col + p_width - j);
+
+            sx4 += alpha * (-4) + beta * (-4);
+            sy4 += gamma * (-4) + delta * (-4);
+
+            sx4 &= ~((1 << WARP_PARAM_REDUCE_BITS) - 1);
+            sy4 &= ~((1 << WARP_PARAM_REDUCE_BITS) - 1);
+
+            // Horizontal filter, two of the rows the outputs need per pass
+            for (int32_t k = 0; k < out_rows + 7; k += 2) {
+                // Clamp to top/bottom edge of the frame
+                const int32_t iy0 = clamp(iy4 + k - 7, 0, height - 1);
+                const int32_t iy1 = clamp(iy4 + k - 6, 0, height - 1);
+                __m128i src_lo0, src_hi0, src_lo1, src_hi1;
+
+                warp_load_row_avx2(
+                    ref16 ? NULL : ref8 + iy0 * stride,
+                    ref16 ? ref16 + iy0 * stride : NULL,
+                    width,
+                    ix4,
+                    &src_lo0,
+                    &src_hi0);
+                warp_load_row_avx2(
+                    ref16 ? NULL : ref8 + iy1 * stride,
+                    ref16 ? ref16 + iy1 * stride : NULL,
+                    width,
+                    ix4,
+                    &src_lo1,
+                    &src_hi1);
+
+                const __m256i res = warp_horizontal_filter_avx2(
+                    _mm256_inserti128_si256(_mm256_castsi128_si256(src_lo0), src_lo1, 1),
+                    _mm256_inserti128_si256(_mm256_castsi128_si256(src_hi0), src_hi1, 1),
+                    sx4 + beta * (k - 3),
+                    alpha,
+                    beta,
+                    round_const_horiz,
+                    round_shift_horiz);
+
+                tmp[k] = _mm256_castsi256_si128(res);
+                tmp[k + 1] = _mm256_extracti128_si256(res, 1);
+            }
+
+            // Vertical filter
+            for (int32_t k = 0; k < out_rows; ++k) {
+                __m256i sum = round_const_vert;
+
+                warp_vertical_coeffs_avx2(sy4 + delta * k, gamma, coeffs);
+
+                for (int32_t m = 0; m < 8; m += 2) {
+                    const __m128i src_lo = _mm_unpacklo_epi16(tmp[k + m], tmp[k + m + 1]);
+                    const __m128i src_hi = _mm_unpackhi_epi16(tmp[k + m], tmp[k + m + 1]);
+                    const __m256i src = _mm256_inserti128_si256(_mm256_castsi128_si256(src_lo), src_hi, 1);
+                    sum = _mm256_add_epi32(sum, _mm256_madd_epi16(src, coeffs[m >> 1]));
+                }
+
+                sum = _mm256_sra_epi32(sum, round_shift_vert);
+
+                const int32_t out_offset = (i - p_row + k) * p_stride + (j - p_col);
+
+                if (conv_params->is_compound) {
+                    CONV_BUF_TYPE *p = &conv_params->dst[(i - p_row + k) * conv_params->dst_stride + (j - p_col)];
+
+                    if (conv_params->do_average) {
+                        __m256i res = _mm256_cvtepu16_epi32(out_cols == 8
+                            ? _mm_loadu_si128((const __m128i *)p)
+                            : _mm_loadl_epi64((const __m128i *)p));
+
+                        if (conv_params->use_jnt_comp_avg) {
+                            res = _mm256_add_epi32(_mm256_mullo_epi32(res, fwd_offset), _mm256_mullo_epi32(sum, bck_offset));
+                            res = _mm256_srai_epi32(res, DIST_PRECISION_BITS);
+                        }
+                        else
+                            res = _mm256_srai_epi32(_mm256_add_epi32(res, sum), 1);
+
+                        res = _mm256_sub_epi32(res, res_sub_const);
+                        res = _mm256_sra_epi32(_mm256_add_epi32(res, round_const_bits), round_shift_bits);
+
+                        warp_store_avx2(
+                            pred16 ? NULL : pred8 + out_offset,
+                            pred16 ? pred16 + out_offset : NULL,
+                            bd,
+                            out_cols,
+                            res);
+                    }
+                    else {
+                        const __m128i res = _mm_packus_epi32(
+                            _mm256_castsi256_si128(sum),
+                            _mm256_extracti128_si256(sum, 1));
+                        if (out_cols == 8)
+                            _mm_storeu_si128((__m128i *)p, res);
+                        else
+                            _mm_storel_epi64((__m128i *)p, res);
+                    }
+                }
+                else {
+                    warp_store_avx2(
+                        pred16 ? NULL : pred8 + out_offset,
+                        pred16 ? pred16 + out_offset : NULL,
+                        bd,
+                        out_cols,
+                        _mm256_sub_epi32(sum, res_sub_const));
+                }
+            }
+        }
+    }
+}
+
+void av1_warp_affine_avx2(const int32_t *mat, const uint8_t *ref, int width,
+    int height, int stride, uint8_t *pred, int p_col,
+    int p_row, int p_width, int p_height, int p_stride,
+    int subsampling_x, int subsampling_y,
+    ConvolveParams *conv_params, int16_t alpha, int16_t beta,
+    int16_t gamma, int16_t delta) {
+    warp_affine_avx2(mat, ref, NULL, width, height, stride, pred, NULL,
+        p_col, p_row, p_width, p_height, p_stride, subsampling_x,
+        subsampling_y, 8, conv_params->round_0, conv_params, alpha, beta,
+        gamma, delta);
+}
+
+void av1_highbd_warp_affine_avx2(const int32_t *mat, const uint16_t *ref,
+    int width, int height, int stride, uint16_t *pred,
+    int p_col, int p_row, int p_width, int p_height,
+    int p_stride, int subsampling_x,
+    int subsampling_y, int bd,
+    ConvolveParams *conv_params, int16_t alpha,
+    int16_t beta, int16_t gamma, int16_t delta) {
+    const int32_t reduce_bits_horiz = conv_params->round_0 +
+        AOMMAX(bd + FILTER_BITS - conv_params->round_0 - 14, 0);
+
+    warp_affine_avx2(mat, NULL, ref, width, height, stride, NULL, pred,
+        p_col, p_row, p_width, p_height, p_stride, subsampling_x,
+        subsampling_y, bd, reduce_bits_horiz, conv_params, alpha, beta,
+        gamma, delta);
+}
@@ -0,0 +1,163 @@
+/*
+* Copyright(c) 2019 Intel Corporation
+* SPDX - License - Identifier: BSD - 2 - Clause - Patent
+*/
+
+#include "EbComputeSAD_AVX512.h"
+#include "EbComputeSAD_AVX2.h"
+#include "EbDefinitions.h"
+#include "immintrin.h"
+
+/*******************************************************************************
+* Loads one 64-byte vector of a block: 2 rows of a 32-wide block or 1 row of
+* a 48/64-wide block.
+*******************************************************************************/
+static INLINE __m512i sad_loop_load_rows_avx512(
+    const uint8_t *p,
+    uint32_t       stride,
+    uint32_t       width)
+{
+    __m512i v;
+
+    if (width == 32) {
+        v = _mm512_castsi256_si512(_mm256_loadu_si256((const __m256i*)p));
+        v = _mm512_inserti64x4(v, _mm256_loadu_si256((const __m256i*)(p + stride)), 1);
+    }
+    else if (width == 48)
+        v = _mm512_maskz_loadu_epi8(0x0000FFFFFFFFFFFFULL, p);
+    else
+        v = _mm512_loadu_si512((const __m512i*)p);
+    return v;
+}
+
+/*******************************************************************************
+* Computes the SAD of 8 horizontally adjacent search positions.
+* VDBPSADBW compares one source quadruplet of each 128-bit lane against 8
+* consecutive reference offsets, so 4 of them (one per quadruplet of the lane)
+* cover 16 source pixels x 8 positions per lane. Each accumulator word gains
+* at most 4 * 255 per vector, which allows 64 vectors before overflowing.
+*******************************************************************************/
+static INLINE void sad_loop_kernel_8_positions_avx512(
+    const __m512i *src,
+    const uint8_t *ref,
+    uint32_t       ref_stride,
+    uint32_t       width,
+    uint32_t       vec_count,
+    __mmask32      mask,
+    uint32_t      *sad)
+{
+    const uint32_t rows_per_vec = width == 32 ? 2 : 1;
+    __m512i r0, r8, sum0, sum1, sum2, sum3;
+    __m256i sum;
+    uint32_t k;
+
+    sum0 = sum1 = sum2 = sum3 = _mm512_setzero_si512();
+    for (k = 0; k < vec_count; k++) {
+        r0 = sad_loop_load_rows_avx512(ref, ref_stride, width);
+        r8 = sad_loop_load_rows_avx512(ref + 8, ref_stride, width);
+        // 0x94 selects reference dwords (0, 1, 1, 2) and 0xE9 dwords (1, 2, 2, 3)
+        sum0 = _mm512_add_epi16(sum0, _mm512_maskz_dbsad_epu8(mask, src[0], r0, 0x94));
+        sum1 = _mm512_add_epi16(sum1, _mm512_maskz_dbsad_epu8(mask, src[1], r0, 0xE9));
+        sum2 = _mm512_add_epi16(sum2, _mm512_maskz_dbsad_epu8(mask, src[2], r8, 0x94));
+        sum3 = _mm512_add_epi16(sum3, _mm512_maskz_dbsad_epu8(mask, src[3], r8, 0xE9));
+        src += 4;
+        ref += rows_per_vec * ref_stride;
+    }
+
+    sum0 = _mm512_add_epi32(
+        _mm512_add_epi32(
+            _mm512_cvtepu16_epi32(_mm512_castsi512_si256(sum0)),
+            _mm512_cvtepu16_epi32(_mm512_extracti64x4_epi64(sum0, 1))),
+        _mm512_add_epi32(
+            _mm512_cvtepu16_epi32(_mm512_castsi512_si256(sum1)),
+            _mm512_cvtepu16_epi32(_mm512_extracti64x4_epi64(sum1, 1))));
+    sum2 = _mm512_add_epi32(
+        _mm512_add_epi32(
+            _mm512_cvtepu16_epi32(_mm512_castsi512_si256(sum2)),
+            _mm512_cvtepu16_epi32(_mm512_extracti64x4_epi64(sum2, 1))),
+        _mm512_add_epi32(
+            _mm512_cvtepu16_epi32(_mm512_castsi512_si256(sum3)),
+            _mm512_cvtepu16_epi32(_mm512_extracti64x4_epi64(sum3, 1))));
+    sum0 = _mm512_add_epi32(sum0, sum2);
+    sum = _mm256_add_epi32(_mm512_castsi512_si256(sum0), _mm512_extracti64x4_epi64(sum0, 1));
+    _mm256_storeu_si256((__m256i*)sad, sum);
+}
+
+/*******************************************************************************
+* Requirement: width  = 32, 48 or 64
+* Requirement: height even for width 32, height <= 64
+* Other block sizes are left to the AVX2 MPSADBW kernel, which is as fast for
+* blocks narrower than 32 pixels.
+* Unlike the saturating 16-bit sums of the AVX2 kernel, the SADs are exact so
+* the best position always matches the C kernel.
+*******************************************************************************/
+void sad_loop_kernel_avx512_intrin(
+    uint8_t  *src,                            // input parameter, source samples Ptr
+    uint32_t  src_stride,                      // input parameter, source stride
+    uint8_t  *ref,                            // input parameter, reference samples Ptr
+    uint32_t  ref_stride,                      // input parameter, reference stride
+    uint32_t  height,                         // input parameter, block height (M)
+    uint32_t  width,                          // input parameter, block width (N)
+    uint64_t *best_sad,
+    int16_t *x_search_center,
+    int16_t *y_search_center,
+    uint32_t  src_stride_raw,                   // input parameter, source stride (no line skipping)
+    int16_t search_area_width,
+    int16_t search_area_height)
+{
+    __m512i src_vec[4 * 64];
+    __m512i s;
+    int16_t xBest = *x_search_center, yBest = *y_search_center;
+    uint32_t lowSum = 0xffffff;
+    uint32_t sad[8];
+    const uint32_t rows_per_vec = width == 32 ? 2 : 1;
+    const uint32_t vec_count = height / rows_per_vec;
+    const __mmask32 mask = width == 48 ? 0x00FFFFFF : 0xFFFFFFFF;
+    uint32_t k;
+    int16_t i, j, l, leftover;
+
+    if ((width != 32 && width != 48 && width != 64) || height % rows_per_vec || height > 64) {
+        sad_loop_kernel_avx2_intrin(
+            src,
+            src_stride,
+            ref,
+            ref_stride,
+            height,
+            width,
+            best_sad,
+            x_search_center,
+            y_search_center,
+            src_stride_raw,
+            search_area_width,
+            search_area_height);
+        return;
+    }
+
+    // Broadcast each source quadruplet across its 128-bit lane once for all positions
+    for (k = 0; k < vec_count; k++) {
+        s = sad_loop_load_rows_avx512(src + k * rows_per_vec * src_stride, src_stride, width);
+        src_vec[4 * k + 0] = _mm512_shuffle_epi32(s, (_MM_PERM_ENUM)0x00);
+        src_vec[4 * k + 1] = _mm512_shuffle_epi32(s, (_MM_PERM_ENUM)0x55);
+        src_vec[4 * k + 2] = _mm512_shuffle_epi32(s, (_MM_PERM_ENUM)0xAA);
+        src_vec[4 * k + 3] = _mm512_shuffle_epi32(s, (_MM_PERM_ENUM)0xFF);
+    }
+
+    for (i = 0; i < search_area_height; i++) {
+        for (j = 0; j < search_area_width; j += 8) {
+            sad_loop_kernel_8_positions_avx512(src_vec, ref + j, ref_stride, width, vec_count, mask, sad);
+            leftover = (search_area_width - j) < 8 ? (search_area_width - j) : 8;
+            for (l = 0; l < leftover; l++) {
+                if (sad[l] < lowSum) {
+                    lowSum = sad[l];
+                    xBest = j + l;
+                    yBest = i;
+                }
+            }
+        }
+        ref += src_stride_raw;
+    }
+
+    *best_sad = lowSum;
+    *x_search_center = xBest;
+    *y_search_center = yBest;
+}
@@ -0,0 +1,196 @@
+/*
+ * Copyright (c) 2017, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at www.aomedia.org/license/software. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at www.aomedia.org/license/patent.
+ */
+
+#include <assert.h>
+#include "EbDefinitions.h"
+#include <immintrin.h>
+#include "convolve.h"
+#include "aom_dsp_rtcd.h"
+#include "convolve_avx2.h"
+
+static INLINE __m512i convolve_lowbd_x_avx512(const __m512i data,
+    const __m512i *const coeffs,
+    const __m512i *const filt) {
+    const __m512i res_01 = _mm512_maddubs_epi16(_mm512_shuffle_epi8(data, filt[0]), coeffs[0]);
+    const __m512i res_23 = _mm512_maddubs_epi16(_mm512_shuffle_epi8(data, filt[1]), coeffs[1]);
+    const __m512i res_45 = _mm512_maddubs_epi16(_mm512_shuffle_epi8(data, filt[2]), coeffs[2]);
+    const __m512i res_67 = _mm512_maddubs_epi16(_mm512_shuffle_epi8(data, filt[3]), coeffs[3]);
+
+    return _mm512_add_epi16(_mm512_add_epi16(res_01, res_45),
+        _mm512_add_epi16(res_23, res_67));
+}
+
+static INLINE __m512i convolve_avx512(const __m512i *const s,
+    const __m512i *const coeffs) {
+    const __m512i res_0 = _mm512_madd_epi16(s[0], coeffs[0]);
+    const __m512i res_1 = _mm512_madd_epi16(s[1], coeffs[1]);
+    const __m512i res_2 = _mm512_madd_epi16(s[2], coeffs[2]);
+    const __m512i res_3 = _mm512_madd_epi16(s[3], coeffs[3]);
+
+    return _mm512_add_epi32(_mm512_add_epi32(res_0, res_1),
+        _mm512_add_epi32(res_2, res_3));
+}
+
+// Loads the 23 source pixels of 16 outputs of rows 0 and 1 so that each
+// 128-bit lane holds the pixels of 8 outputs: [r0 0-15 | r0 8-23 | r1 0-15 | r1 8-23]
+static INLINE __m512i load_src_16x2_avx512(const uint8_t *src, int32_t stride,
+    int32_t second_row) {
+    const __m512i idx = _mm512_setr_epi64(0, 1, 1, 2, 4, 5, 5, 6);
+    __m512i data = _mm512_castsi256_si512(_mm256_maskz_loadu_epi8(0x007FFFFF, src));
+
+    if (second_row)
+        data = _mm512_inserti64x4(data, _mm256_maskz_loadu_epi8(0x007FFFFF, src + stride), 1);
+    return _mm512_permutexvar_epi64(idx, data);
+}
+
+// Same arithmetic as av1_convolve_2d_sr_avx2(), 16 columns at a time instead of 8.
+// Each zmm holds 2 rows of 16 columns in both passes.
+void av1_convolve_2d_sr_avx512(const uint8_t *src, int32_t src_stride, uint8_t *dst,
+    int32_t dst_stride, int32_t w, int32_t h,
+    InterpFilterParams *filter_params_x,
+    InterpFilterParams *filter_params_y,
+    const int32_t subpel_x_q4, const int32_t subpel_y_q4,
+    ConvolveParams *conv_params) {
+    const int32_t bd = 8;
+
+    DECLARE_ALIGNED(64, int16_t, im_block[(MAX_SB_SIZE + MAX_FILTER_TAP) * 16]);
+    int32_t im_h = h + filter_params_y->taps - 1;
+    int32_t im_stride = 16;
+    int32_t i, j, k;
+    const int32_t fo_vert = filter_params_y->taps / 2 - 1;
+    const int32_t fo_horiz = filter_params_x->taps / 2 - 1;
+    const uint8_t *const src_ptr = src - fo_vert * src_stride - fo_horiz;
+
+    const int32_t bits =
+        FILTER_BITS * 2 - conv_params->round_0 - conv_params->round_1;
+    const int32_t offset_bits = bd + 2 * FILTER_BITS - conv_params->round_0;
+
+    __m256i coeffs_h_256[4], coeffs_v_256[4];
+    __m512i filt[4], coeffs_h[4], coeffs_v[4];
+
+    // Narrow blocks do not fill a zmm register
+    if (w & 15) {
+        av1_convolve_2d_sr_avx2(src, src_stride, dst, dst_stride, w, h,
+            filter_params_x, filter_params_y, subpel_x_q4, subpel_y_q4,
+            conv_params);
+        return;
+    }
+
+    assert(conv_params->round_0 > 0);
+
+    filt[0] = _mm512_broadcast_i64x4(_mm256_load_si256((__m256i const *)filt1_global_avx2));
+    filt[1] = _mm512_broadcast_i64x4(_mm256_load_si256((__m256i const *)filt2_global_avx2));
+    filt[2] = _mm512_broadcast_i64x4(_mm256_load_si256((__m256i const *)filt3_global_avx2));
+    filt[3] = _mm512_broadcast_i64x4(_mm256_load_si256((__m256i const *)filt4_global_avx2));
+
+    prepare_coeffs_lowbd(filter_params_x, subpel_x_q4, coeffs_h_256);
+    prepare_coeffs(filter_params_y, subpel_y_q4, coeffs_v_256);
+    for (k = 0; k < 4; k++) {
+        coeffs_h[k] = _mm512_broadcast_i64x4(coeffs_h_256[k]);
+        coeffs_v[k] = _mm512_broadcast_i64x4(coeffs_v_256[k]);
+    }
+
+    const __m512i round_const_h = _mm512_set1_epi16(
+        ((1 << (conv_params->round_0 - 1)) >> 1) + (1 << (bd + FILTER_BITS - 2)));
+    const __m128i round_shift_h = _mm_cvtsi32_si128(conv_params->round_0 - 1);
+
+    const __m512i sum_round_v = _mm512_set1_epi32(
+        (1 << offset_bits) + ((1 << conv_params->round_1) >> 1));
+    const __m128i sum_shift_v = _mm_cvtsi32_si128(conv_params->round_1);
+
+    const __m512i round_const_v = _mm512_set1_epi32(
+        ((1 << bits) >> 1) - (1 << (offset_bits - conv_params->round_1)) -
+        ((1 << (offset_bits - conv_params->round_1)) >> 1));
+    const __m128i round_shift_v = _mm_cvtsi32_si128(bits);
+
+    // Gathers the low 8 bytes of each lane: [r0 0-7 | r0 8-15 | r1 0-7 | r1 8-15]
+    const __m512i store_idx = _mm512_setr_epi64(0, 2, 4, 6, 1, 3, 5, 7);
+
+    for (j = 0; j < w; j += 16) {
+        for (i = 0; i < im_h; i += 2) {
+            const __m512i data = load_src_16x2_avx512(
+                &src_ptr[(i * src_stride) + j], src_stride, i + 1 < im_h);
+
+            __m512i res = convolve_lowbd_x_avx512(data, coeffs_h, filt);
+
+            res =
+                _mm512_sra_epi16(_mm512_add_epi16(res, round_const_h), round_shift_h);
+
+            _mm512_store_si512((__m512i *)&im_block[i * im_stride], res);
+        }
+
+        /* Vertical filter */
+        {
+            __m512i src_0 = _mm512_loadu_si512((__m512i *)(im_block + 0 * im_stride));
+            __m512i src_1 = _mm512_loadu_si512((__m512i *)(im_block + 1 * im_stride));
+            __m512i src_2 = _mm512_loadu_si512((__m512i *)(im_block + 2 * im_stride));
+            __m512i src_3 = _mm512_loadu_si512((__m512i *)(im_block + 3 * im_stride));
+            __m512i src_4 = _mm512_loadu_si512((__m512i *)(im_block + 4 * im_stride));
+            __m512i src_5 = _mm512_loadu_si512((__m512i *)(im_block + 5 * im_stride));
+
+            __m512i s[8];
+            s[0] = _mm512_unpacklo_epi16(src_0, src_1);
+            s[1] = _mm512_unpacklo_epi16(src_2, src_3);
+            s[2] = _mm512_unpacklo_epi16(src_4, src_5);
+
+            s[4] = _mm512_unpackhi_epi16(src_0, src_1);
+            s[5] = _mm512_unpackhi_epi16(src_2, src_3);
+            s[6] = _mm512_unpackhi_epi16(src_4, src_5);
+
+            for (i = 0; i < h; i += 2) {
+                const int16_t *data = &im_block[i * im_stride];
+
+                const __m512i s6 =
+                    _mm512_loadu_si512((__m512i *)(data + 6 * im_stride));
+                const __m512i s7 =
+                    _mm512_loadu_si512((__m512i *)(data + 7 * im_stride));
+
+                s[3] = _mm512_unpacklo_epi16(s6, s7);
+                s[7] = _mm512_unpackhi_epi16(s6, s7);
+
+                __m512i res_a = convolve_avx512(s, coeffs_v);
+                __m512i res_b = convolve_avx512(s + 4, coeffs_v);
+
+                // Combine V round and 2F-H-V round into a single rounding
+                res_a =
+                    _mm512_sra_epi32(_mm512_add_epi32(res_a, sum_round_v), sum_shift_v);
+                res_b =
+                    _mm512_sra_epi32(_mm512_add_epi32(res_b, sum_round_v), sum_shift_v);
+
+                const __m512i res_a_round = _mm512_sra_epi32(
+                    _mm512_add_epi32(res_a, round_const_v), round_shift_v);
+                const __m512i res_b_round = _mm512_sra_epi32(
+                    _mm512_add_epi32(res_b, round_const_v), round_shift_v);
+
+                /* rounding code */
+                // 16 bit conversion
+                const __m512i res_16bit = _mm512_packs_epi32(res_a_round, res_b_round);
+                // 8 bit conversion and saturation to uint8
+                const __m512i res_8b = _mm512_permutexvar_epi64(store_idx,
+                    _mm512_packus_epi16(res_16bit, res_16bit));
+
+                // Store values into the destination buffer
+                _mm_storeu_si128((__m128i *)&dst[i * dst_stride + j],
+                    _mm512_castsi512_si128(res_8b));
+                _mm_storeu_si128((__m128i *)&dst[i * dst_stride + j + dst_stride],
+                    _mm512_extracti32x4_epi32(res_8b, 1));
+
+                s[0] = s[1];
+                s[1] = s[2];
+                s[2] = s[3];
+
+                s[4] = s[5];
+                s[5] = s[6];
+                s[6] = s[7];
+            }
+        }
+    }
+}
@@ -0,0 +1,570 @@
+/*
+ * Copyright (c) 2016, Alliance for Open Media. All rights reserved
+ *
+ * This source code is subject to the terms of the BSD 2 Clause License and
+ * the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+ * was not distributed with this source code in the LICENSE file, you can
+ * obtain it at www.aomedia.org/license/software. If the Alliance for Open
+ * Media Patent License 1.0 was not distributed with this source code in the
+ * PATENTS file, you can obtain it at www.aomedia.org/license/patent.
+ */
+#include <assert.h>
+#include <immintrin.h>
+#include "EbDefinitions.h"
+#include "aom_dsp_rtcd.h"
+#include "EbTransforms.h"
+
+const int32_t *cospi_arr(int32_t n);
+extern const int8_t *inv_txfm_shift_ls[];
+
+// idct32_avx512() is idct32_avx2() widened to 16 lanes: a 32x32 block is held
+// in 64 zmm registers, 2 per row.
+
+static INLINE __m512i half_btf_avx512(const __m512i *w0, const __m512i *n0,
+    const __m512i *w1, const __m512i *n1,
+    const __m512i *rounding, int32_t bit) {
+    __m512i x, y;
+
+    x = _mm512_mullo_epi32(*w0, *n0);
+    y = _mm512_mullo_epi32(*w1, *n1);
+    x = _mm512_add_epi32(x, y);
+    x = _mm512_add_epi32(x, *rounding);
+    x = _mm512_srai_epi32(x, bit);
+    return x;
+}
+
+
+static void idct32_avx512(__m512i *in, __m512i *out, int32_t bit) {
+    const int32_t *cospi = cospi_arr(bit);
+    const __m512i cospi62 = _mm512_set1_epi32(cospi[62]);
+    const __m512i cospi30 = _mm512_set1_epi32(cospi[30]);
+    const __m512i cospi46 = _mm512_set1_epi32(cospi[46]);
+    const __m512i cospi14 = _mm512_set1_epi32(cospi[14]);
+    const __m512i cospi54 = _mm512_set1_epi32(cospi[54]);
+    const __m512i cospi22 = _mm512_set1_epi32(cospi[22]);
+    const __m512i cospi38 = _mm512_set1_epi32(cospi[38]);
+    const __m512i cospi6 = _mm512_set1_epi32(cospi[6]);
+    const __m512i cospi58 = _mm512_set1_epi32(cospi[58]);
+    const __m512i cospi26 = _mm512_set1_epi32(cospi[26]);
+    const __m512i cospi42 = _mm512_set1_epi32(cospi[42]);
+    const __m512i cospi10 = _mm512_set1_epi32(cospi[10]);
+    const __m512i cospi50 = _mm512_set1_epi32(cospi[50]);
+    const __m512i cospi18 = _mm512_set1_epi32(cospi[18]);
+    const __m512i cospi34 = _mm512_set1_epi32(cospi[34]);
+    const __m512i cospi2 = _mm512_set1_epi32(cospi[2]);
+    const __m512i cospim58 = _mm512_set1_epi32(-cospi[58]);
+    const __m512i cospim26 = _mm512_set1_epi32(-cospi[26]);
+    const __m512i cospim42 = _mm512_set1_epi32(-cospi[42]);
+    const __m512i cospim10 = _mm512_set1_epi32(-cospi[10]);
+    const __m512i cospim50 = _mm512_set1_epi32(-cospi[50]);
+    const __m512i cospim18 = _mm512_set1_epi32(-cospi[18]);
+    const __m512i cospim34 = _mm512_set1_epi32(-cospi[34]);
+    const __m512i cospim2 = _mm512_set1_epi32(-cospi[2]);
+    const __m512i cospi60 = _mm512_set1_epi32(cospi[60]);
+    const __m512i cospi28 = _mm512_set1_epi32(cospi[28]);
+    const __m512i cospi44 = _mm512_set1_epi32(cospi[44]);
+    const __m512i cospi12 = _mm512_set1_epi32(cospi[12]);
+    const __m512i cospi52 = _mm512_set1_epi32(cospi[52]);
+    const __m512i cospi20 = _mm512_set1_epi32(cospi[20]);
+    const __m512i cospi36 = _mm512_set1_epi32(cospi[36]);
+    const __m512i cospi4 = _mm512_set1_epi32(cospi[4]);
+    const __m512i cospim52 = _mm512_set1_epi32(-cospi[52]);
+    const __m512i cospim20 = _mm512_set1_epi32(-cospi[20]);
+    const __m512i cospim36 = _mm512_set1_epi32(-cospi[36]);
+    const __m512i cospim4 = _mm512_set1_epi32(-cospi[4]);
+    const __m512i cospi56 = _mm512_set1_epi32(cospi[56]);
+    const __m512i cospi24 = _mm512_set1_epi32(cospi[24]);
+    const __m512i cospi40 = _mm512_set1_epi32(cospi[40]);
+    const __m512i cospi8 = _mm512_set1_epi32(cospi[8]);
+    const __m512i cospim40 = _mm512_set1_epi32(-cospi[40]);
+    const __m512i cospim8 = _mm512_set1_epi32(-cospi[8]);
+    const __m512i cospim56 = _mm512_set1_epi32(-cospi[56]);
+    const __m512i cospim24 = _mm512_set1_epi32(-cospi[24]);
+    const __m512i cospi32 = _mm512_set1_epi32(cospi[32]);
+    const __m512i cospim32 = _mm512_set1_epi32(-cospi[32]);
+    const __m512i cospi48 = _mm512_set1_epi32(cospi[48]);
+    const __m512i cospim48 = _mm512_set1_epi32(-cospi[48]);
+    const __m512i cospi16 = _mm512_set1_epi32(cospi[16]);
+    const __m512i cospim16 = _mm512_set1_epi32(-cospi[16]);
+    const __m512i rounding = _mm512_set1_epi32(1 << (bit - 1));
+    __m512i bf1[32], bf0[32];
+    int32_t col;
+
+    for (col = 0; col < 2; ++col) {
+        // stage 0
+        // stage 1
+        bf1[0] = in[0 * 2 + col];
+        bf1[1] = in[16 * 2 + col];
+        bf1[2] = in[8 * 2 + col];
+        bf1[3] = in[24 * 2 + col];
+        bf1[4] = in[4 * 2 + col];
+        bf1[5] = in[20 * 2 + col];
+        bf1[6] = in[12 * 2 + col];
+        bf1[7] = in[28 * 2 + col];
+        bf1[8] = in[2 * 2 + col];
+        bf1[9] = in[18 * 2 + col];
+        bf1[10] = in[10 * 2 + col];
+        bf1[11] = in[26 * 2 + col];
+        bf1[12] = in[6 * 2 + col];
+        bf1[13] = in[22 * 2 + col];
+        bf1[14] = in[14 * 2 + col];
+        bf1[15] = in[30 * 2 + col];
+        bf1[16] = in[1 * 2 + col];
+        bf1[17] = in[17 * 2 + col];
+        bf1[18] = in[9 * 2 + col];
+        bf1[19] = in[25 * 2 + col];
+        bf1[20] = in[5 * 2 + col];
+        bf1[21] = in[21 * 2 + col];
+        bf1[22] = in[13 * 2 + col];
+        bf1[23] = in[29 * 2 + col];
+        bf1[24] = in[3 * 2 + col];
+        bf1[25] = in[19 * 2 + col];
+        bf1[26] = in[11 * 2 + col];
+        bf1[27] = in[27 * 2 + col];
+        bf1[28] = in[7 * 2 + col];
+        bf1[29] = in[23 * 2 + col];
+        bf1[30] = in[15 * 2 + col];
+        bf1[31] = in[31 * 2 + col];
+
+        // stage 2
+        bf0[0] = bf1[0];
+        bf0[1] = bf1[1];
+        bf0[2] = bf1[2];
+        bf0[3] = bf1[3];
+        bf0[4] = bf1[4];
+        bf0[5] = bf1[5];
+        bf0[6] = bf1[6];
+        bf0[7] = bf1[7];
+        bf0[8] = bf1[8];
+        bf0[9] = bf1[9];
+        bf0[10] = bf1[10];
+        bf0[11] = bf1[11];
+        bf0[12] = bf1[12];
+        bf0[13] = bf1[13];
+        bf0[14] = bf1[14];
+        bf0[15] = bf1[15];
+        bf0[16] =
+            half_btf_avx512(&cospi62, &bf1[16], &cospim2, &bf1[31], &rounding, bit);
+        bf0[17] =
+            half_btf_avx512(&cospi30, &bf1[17], &cospim34, &bf1[30], &rounding, bit);
+        bf0[18] =
+            half_btf_avx512(&cospi46, &bf1[18], &cospim18, &bf1[29], &rounding, bit);
+        bf0[19] =
+            half_btf_avx512(&cospi14, &bf1[19], &cospim50, &bf1[28], &rounding, bit);
+        bf0[20] =
+            half_btf_avx512(&cospi54, &bf1[20], &cospim10, &bf1[27], &rounding, bit);
+        bf0[21] =
+            half_btf_avx512(&cospi22, &bf1[21], &cospim42, &bf1[26], &rounding, bit);
+        bf0[22] =
+            half_btf_avx512(&cospi38, &bf1[22], &cospim26, &bf1[25], &rounding, bit);
+        bf0[23] =
+            half_btf_avx512(&cospi6, &bf1[23], &cospim58, &bf1[24], &rounding, bit);
+        bf0[24] =
+            half_btf_avx512(&cospi58, &bf1[23], &cospi6, &bf1[24], &rounding, bit);
+        bf0[25] =
+            half_btf_avx512(&cospi26, &bf1[22], &cospi38, &bf1[25], &rounding, bit);
+        bf0[26] =
+            half_btf_avx512(&cospi42, &bf1[21], &cospi22, &bf1[26], &rounding, bit);
+        bf0[27] =
+            half_btf_avx512(&cospi10, &bf1[20], &cospi54, &bf1[27], &rounding, bit);
+        bf0[28] =
+            half_btf_avx512(&cospi50, &bf1[19], &cospi14, &bf1[28], &rounding, bit);
+        bf0[29] =
+            half_btf_avx512(&cospi18, &bf1[18], &cospi46, &bf1[29], &rounding, bit);
+        bf0[30] =
+            half_btf_avx512(&cospi34, &bf1[17], &cospi30, &bf1[30], &rounding, bit);
+        bf0[31] =
+            half_btf_avx512(&cospi2, &bf1[16], &cospi62, &bf1[31], &rounding, bit);
+
+        // stage 3
+        bf1[0] = bf0[0];
+        bf1[1] = bf0[1];
+        bf1[2] = bf0[2];
+        bf1[3] = bf0[3];
+        bf1[4] = bf0[4];
+        bf1[5] = bf0[5];
+        bf1[6] = bf0[6];
+        bf1[7] = bf0[7];
+        bf1[8] =
+            half_btf_avx512(&cospi60, &bf0[8], &cospim4, &bf0[15], &rounding, bit);
+        bf1[9] =
+            half_btf_avx512(&cospi28, &bf0[9], &cospim36, &bf0[14], &rounding, bit);
+        bf1[10] =
+            half_btf_avx512(&cospi44, &bf0[10], &cospim20, &bf0[13], &rounding, bit);
+        bf1[11] =
+            half_btf_avx512(&cospi12, &bf0[11], &cospim52, &bf0[12], &rounding, bit);
+        bf1[12] =
+            half_btf_avx512(&cospi52, &bf0[11], &cospi12, &bf0[12], &rounding, bit);
+        bf1[13] =
+            half_btf_avx512(&cospi20, &bf0[10], &cospi44, &bf0[13], &rounding, bit);
+        bf1[14] =
+            half_btf_avx512(&cospi36, &bf0[9], &cospi28, &bf0[14], &rounding, bit);
+        bf1[15] =
+            half_btf_avx512(&cospi4, &bf0[8], &cospi60, &bf0[15], &rounding, bit);
+        bf1[16] = _mm512_add_epi32(bf0[16], bf0[17]);
+        bf1[17] = _mm512_sub_epi32(bf0[16], bf0[17]);
+        bf1[18] = _mm512_sub_epi32(bf0[19], bf0[18]);
+        bf1[19] = _mm512_add_epi32(bf0[18], bf0[19]);
+        bf1[20] = _mm512_add_epi32(bf0[20], bf0[21]);
+        bf1[21] = _mm512_sub_epi32(bf0[20], bf0[21]);
+        bf1[22] = _mm512_sub_epi32(bf0[23], bf0[22]);
+        bf1[23] = _mm512_add_epi32(bf0[22], bf0[23]);
+        bf1[24] = _mm512_add_epi32(bf0[24], bf0[25]);
+        bf1[25] = _mm512_sub_epi32(bf0[24], bf0[25]);
+        bf1[26] = _mm512_sub_epi32(bf0[27], bf0[26]);
+        bf1[27] = _mm512_add_epi32(bf0[26], bf0[27]);
+        bf1[28] = _mm512_add_epi32(bf0[28], bf0[29]);
+        bf1[29] = _mm512_sub_epi32(bf0[28], bf0[29]);
+        bf1[30] = _mm512_sub_epi32(bf0[31], bf0[30]);
+        bf1[31] = _mm512_add_epi32(bf0[30], bf0[31]);
+
+        // stage 4
+        bf0[0] = bf1[0];
+        bf0[1] = bf1[1];
+        bf0[2] = bf1[2];
+        bf0[3] = bf1[3];
+        bf0[4] =
+            half_btf_avx512(&cospi56, &bf1[4], &cospim8, &bf1[7], &rounding, bit);
+        bf0[5] =
+            half_btf_avx512(&cospi24, &bf1[5], &cospim40, &bf1[6], &rounding, bit);
+        bf0[6] =
+            half_btf_avx512(&cospi40, &bf1[5], &cospi24, &bf1[6], &rounding, bit);
+        bf0[7] = half_btf_avx512(&cospi8, &bf1[4], &cospi56, &bf1[7], &rounding, bit);
+        bf0[8] = _mm512_add_epi32(bf1[8], bf1[9]);
+        bf0[9] = _mm512_sub_epi32(bf1[8], bf1[9]);
+        bf0[10] = _mm512_sub_epi32(bf1[11], bf1[10]);
+        bf0[11] = _mm512_add_epi32(bf1[10], bf1[11]);
+        bf0[12] = _mm512_add_epi32(bf1[12], bf1[13]);
+        bf0[13] = _mm512_sub_epi32(bf1[12], bf1[13]);
+        bf0[14] = _mm512_sub_epi32(bf1[15], bf1[14]);
+        bf0[15] = _mm512_add_epi32(bf1[14], bf1[15]);
+        bf0[16] = bf1[16];
+        bf0[17] =
+            half_btf_avx512(&cospim8, &bf1[17], &cospi56, &bf1[30], &rounding, bit);
+        bf0[18] =
+            half_btf_avx512(&cospim56, &bf1[18], &cospim8, &bf1[29], &rounding, bit);
+        bf0[19] = bf1[19];
+        bf0[20] = bf1[20];
+        bf0[21] =
+            half_btf_avx512(&cospim40, &bf1[21], &cospi24, &bf1[26], &rounding, bit);
+        bf0[22] =
+            half_btf_avx512(&cospim24, &bf1[22], &cospim40, &bf1[25], &rounding, bit);
+        bf0[23] = bf1[23];
+        bf0[24] = bf1[24];
+        bf0[25] =
+            half_btf_avx512(&cospim40, &bf1[22], &cospi24, &bf1[25], &rounding, bit);
+        bf0[26] =
+            half_btf_avx512(&cospi24, &bf1[21], &cospi40, &bf1[26], &rounding, bit);
+        bf0[27] = bf1[27];
+        bf0[28] = bf1[28];
+        bf0[29] =
+            half_btf_avx512(&cospim8, &bf1[18], &cospi56, &bf1[29], &rounding, bit);
+        bf0[30] =
+            half_btf_avx512(&cospi56, &bf1[17], &cospi8, &bf1[30], &rounding, bit);
+        bf0[31] = bf1[31];
+
+        // stage 5
+        bf1[0] =
+            half_btf_avx512(&cospi32, &bf0[0], &cospi32, &bf0[1], &rounding, bit);
+        bf1[1] =
+            half_btf_avx512(&cospi32, &bf0[0], &cospim32, &bf0[1], &rounding, bit);
+        bf1[2] =
+            half_btf_avx512(&cospi48, &bf0[2], &cospim16, &bf0[3], &rounding, bit);
+        bf1[3] =
+            half_btf_avx512(&cospi16, &bf0[2], &cospi48, &bf0[3], &rounding, bit);
+        bf1[4] = _mm512_add_epi32(bf0[4], bf0[5]);
+        bf1[5] = _mm512_sub_epi32(bf0[4], bf0[5]);
+        bf1[6] = _mm512_sub_epi32(bf0[7], bf0[6]);
+        bf1[7] = _mm512_add_epi32(bf0[6], bf0[7]);
+        bf1[8] = bf0[8];
+        bf1[9] =
+            half_btf_avx512(&cospim16, &bf0[9], &cospi48, &bf0[14], &rounding, bit);
+        bf1[10] =
+            half_btf_avx512(&cospim48, &bf0[10], &cospim16, &bf0[13], &rounding, bit);
+        bf1[11] = bf0[11];
+        bf1[12] = bf0[12];
+        bf1[13] =
+            half_btf_avx512(&cospim16, &bf0[10], &cospi48, &bf0[13], &rounding, bit);
+        bf1[14] =
+            half_btf_avx512(&cospi48, &bf0[9], &cospi16, &bf0[14], &rounding, bit);
+        bf1[15] = bf0[15];
+        bf1[16] = _mm512_add_epi32(bf0[16], bf0[19]);
+        bf1[17] = _mm512_add_epi32(bf0[17], bf0[18]);
+        bf1[18] = _mm512_sub_epi32(bf0[17], bf0[18]);
+        bf1[19] = _mm512_sub_epi32(bf0[16], bf0[19]);
+        bf1[20] = _mm512_sub_epi32(bf0[23], bf0[20]);
+        bf1[21] = _mm512_sub_epi32(bf0[22], bf0[21]);
+        bf1[22] = _mm512_add_epi32(bf0[21], bf0[22]);
+        bf1[23] = _mm512_add_epi32(bf0[20], bf0[23]);
+        bf1[24] = _mm512_add_epi32(bf0[24], bf0[27]);
+        bf1[25] = _mm512_add_epi32(bf0[25], bf0[26]);
+        bf1[26] = _mm512_sub_epi32(bf0[25], bf0[26]);
+        bf1[27] = _mm512_sub_epi32(bf0[24], bf0[27]);
+        bf1[28] = _mm512_sub_epi32(bf0[31], bf0[28]);
+        bf1[29] = _mm512_sub_epi32(bf0[30], bf0[29]);
+        bf1[30] = _mm512_add_epi32(bf0[29], bf0[30]);
+        bf1[31] = _mm512_add_epi32(bf0[28], bf0[31]);
+
+        // stage 6
+        bf0[0] = _mm512_add_epi32(bf1[0], bf1[3]);
+        bf0[1] = _mm512_add_epi32(bf1[1], bf1[2]);
+        bf0[2] = _mm512_sub_epi32(bf1[1], bf1[2]);
+        bf0[3] = _mm512_sub_epi32(bf1[0], bf1[3]);
+        bf0[4] = bf1[4];
+        bf0[5] =
+            half_btf_avx512(&cospim32, &bf1[5], &cospi32, &bf1[6], &rounding, bit);
+        bf0[6] =
+            half_btf_avx512(&cospi32, &bf1[5], &cospi32, &bf1[6], &rounding, bit);
+        bf0[7] = bf1[7];
+        bf0[8] = _mm512_add_epi32(bf1[8], bf1[11]);
+        bf0[9] = _mm512_add_epi32(bf1[9], bf1[10]);
+        bf0[10] = _mm512_sub_epi32(bf1[9], bf1[10]);
+        bf0[11] = _mm512_sub_epi32(bf1[8], bf1[11]);
+        bf0[12] = _mm512_sub_epi32(bf1[15], bf1[12]);
+        bf0[13] = _mm512_sub_epi32(bf1[14], bf1[13]);
+        bf0[14] = _mm512_add_epi32(bf1[13], bf1[14]);
+        bf0[15] = _mm512_add_epi32(bf1[12], bf1[15]);
+        bf0[16] = bf1[16];
+        bf0[17] = bf1[17];
+        bf0[18] =
+            half_btf_avx512(&cospim16, &bf1[18], &cospi48, &bf1[29], &rounding, bit);
+        bf0[19] =
+            half_btf_avx512(&cospim16, &bf1[19], &cospi48, &bf1[28], &rounding, bit);
+        bf0[20] =
+            half_btf_avx512(&cospim48, &bf1[20], &cospim16, &bf1[27], &rounding, bit);
+        bf0[21] =
+            half_btf_avx512(&cospim48, &bf1[21], &cospim16, &bf1[26], &rounding, bit);
+        bf0[22] = bf1[22];
+        bf0[23] = bf1[23];
+        bf0[24] = bf1[24];
+        bf0[25] = bf1[25];
+        bf0[26] =
+            half_btf_avx512(&cospim16, &bf1[21], &cospi48, &bf1[26], &rounding, bit);
+        bf0[27] =
+            half_btf_avx512(&cospim16, &bf1[20], &cospi48, &bf1[27], &rounding, bit);
+        bf0[28] =
+            half_btf_avx512(&cospi48, &bf1[19], &cospi16, &bf1[28], &rounding, bit);
+        bf0[29] =
+            half_btf_avx512(&cospi48, &bf1[18], &cospi16, &bf1[29], &rounding, bit);
+        bf0[30] = bf1[30];
+        bf0[31] = bf1[31];
+
+        // stage 7
+        bf1[0] = _mm512_add_epi32(bf0[0], bf0[7]);
+        bf1[1] = _mm512_add_epi32(bf0[1], bf0[6]);
+        bf1[2] = _mm512_add_epi32(bf0[2], bf0[5]);
+        bf1[3] = _mm512_add_epi32(bf0[3], bf0[4]);
+        bf1[4] = _mm512_sub_epi32(bf0[3], bf0[4]);
+        bf1[5] = _mm512_sub_epi32(bf0[2], bf0[5]);
+        bf1[6] = _mm512_sub_epi32(bf0[1], bf0[6]);
+        bf1[7] = _mm512_sub_epi32(bf0[0], bf0[7]);
+        bf1[8] = bf0[8];
+        bf1[9] = bf0[9];
+        bf1[10] =
+            half_btf_avx512(&cospim32, &bf0[10], &cospi32, &bf0[13], &rounding, bit);
+        bf1[11] =
+            half_btf_avx512(&cospim32, &bf0[11], &cospi32, &bf0[12], &rounding, bit);
+        bf1[12] =
+            half_btf_avx512(&cospi32, &bf0[11], &cospi32, &bf0[12], &rounding, bit);
+        bf1[13] =
+            half_btf_avx512(&cospi32, &bf0[10], &cospi32, &bf0[13], &rounding, bit);
+        bf1[14] = bf0[14];
+        bf1[15] = bf0[15];
+        bf1[16] = _mm512_add_epi32(bf0[16], bf0[23]);
+        bf1[17] = _mm512_add_epi32(bf0[17], bf0[22]);
+        bf1[18] = _mm512_add_epi32(bf0[18], bf0[21]);
+        bf1[19] = _mm512_add_epi32(bf0[19], bf0[20]);
+        bf1[20] = _mm512_sub_epi32(bf0[19], bf0[20]);
+        bf1[21] = _mm512_sub_epi32(bf0[18], bf0[21]);
+        bf1[22] = _mm512_sub_epi32(bf0[17], bf0[22]);
+        bf1[23] = _mm512_sub_epi32(bf0[16], bf0[23]);
+        bf1[24] = _mm512_sub_epi32(bf0[31], bf0[24]);
+        bf1[25] = _mm512_sub_epi32(bf0[30], bf0[25]);
+        bf1[26] = _mm512_sub_epi32(bf0[29], bf0[26]);
+        bf1[27] = _mm512_sub_epi32(bf0[28], bf0[27]);
+        bf1[28] = _mm512_add_epi32(bf0[27], bf0[28]);
+        bf1[29] = _mm512_add_epi32(bf0[26], bf0[29]);
+        bf1[30] = _mm512_add_epi32(bf0[25], bf0[30]);
+        bf1[31] = _mm512_add_epi32(bf0[24], bf0[31]);
+
+        // stage 8
+        bf0[0] = _mm512_add_epi32(bf1[0], bf1[15]);
+        bf0[1] = _mm512_add_epi32(bf1[1], bf1[14]);
+        bf0[2] = _mm512_add_epi32(bf1[2], bf1[13]);
+        bf0[3] = _mm512_add_epi32(bf1[3], bf1[12]);
+        bf0[4] = _mm512_add_epi32(bf1[4], bf1[11]);
+        bf0[5] = _mm512_add_epi32(bf1[5], bf1[10]);
+        bf0[6] = _mm512_add_epi32(bf1[6], bf1[9]);
+        bf0[7] = _mm512_add_epi32(bf1[7], bf1[8]);
+        bf0[8] = _mm512_sub_epi32(bf1[7], bf1[8]);
+        bf0[9] = _mm512_sub_epi32(bf1[6], bf1[9]);
+        bf0[10] = _mm512_sub_epi32(bf1[5], bf1[10]);
+        bf0[11] = _mm512_sub_epi32(bf1[4], bf1[11]);
+        bf0[12] = _mm512_sub_epi32(bf1[3], bf1[12]);
+        bf0[13] = _mm512_sub_epi32(bf1[2], bf1[13]);
+        bf0[14] = _mm512_sub_epi32(bf1[1], bf1[14]);
+        bf0[15] = _mm512_sub_epi32(bf1[0], bf1[15]);
+        bf0[16] = bf1[16];
+        bf0[17] = bf1[17];
+        bf0[18] = bf1[18];
+        bf0[19] = bf1[19];
+        bf0[20] =
+            half_btf_avx512(&cospim32, &bf1[20], &cospi32, &bf1[27], &rounding, bit);
+        bf0[21] =
+            half_btf_avx512(&cospim32, &bf1[21], &cospi32, &bf1[26], &rounding, bit);
+        bf0[22] =
+            half_btf_avx512(&cospim32, &bf1[22], &cospi32, &bf1[25], &rounding, bit);
+        bf0[23] =
+            half_btf_avx512(&cospim32, &bf1[23], &cospi32, &bf1[24], &rounding, bit);
+        bf0[24] =
+            half_btf_avx512(&cospi32, &bf1[23], &cospi32, &bf1[24], &rounding, bit);
+        bf0[25] =
+            half_btf_avx512(&cospi32, &bf1[22], &cospi32, &bf1[25], &rounding, bit);
+        bf0[26] =
+            half_btf_avx512(&cospi32, &bf1[21], &cospi32, &bf1[26], &rounding, bit);
+        bf0[27] =
+            half_btf_avx512(&cospi32, &bf1[20], &cospi32, &bf1[27], &rounding, bit);
+        bf0[28] = bf1[28];
+        bf0[29] = bf1[29];
+        bf0[30] = bf1[30];
+        bf0[31] = bf1[31];
+
+        // stage 9
+        out[0 * 2 + col] = _mm512_add_epi32(bf0[0], bf0[31]);
+        out[1 * 2 + col] = _mm512_add_epi32(bf0[1], bf0[30]);
+        out[2 * 2 + col] = _mm512_add_epi32(bf0[2], bf0[29]);
+        out[3 * 2 + col] = _mm512_add_epi32(bf0[3], bf0[28]);
+        out[4 * 2 + col] = _mm512_add_epi32(bf0[4], bf0[27]);
+        out[5 * 2 + col] = _mm512_add_epi32(bf0[5], bf0[26]);
+        out[6 * 2 + col] = _mm512_add_epi32(bf0[6], bf0[25]);
+        out[7 * 2 + col] = _mm512_add_epi32(bf0[7], bf0[24]);
+        out[8 * 2 + col] = _mm512_add_epi32(bf0[8], bf0[23]);
+        out[9 * 2 + col] = _mm512_add_epi32(bf0[9], bf0[22]);
+        out[10 * 2 + col] = _mm512_add_epi32(bf0[10], bf0[21]);
+        out[11 * 2 + col] = _mm512_add_epi32(bf0[11], bf0[20]);
+        out[12 * 2 + col] = _mm512_add_epi32(bf0[12], bf0[19]);
+        out[13 * 2 + col] = _mm512_add_epi32(bf0[13], bf0[18]);
+        out[14 * 2 + col] = _mm512_add_epi32(bf0[14], bf0[17]);
+        out[15 * 2 + col] = _mm512_add_epi32(bf0[15], bf0[16]);
+        out[16 * 2 + col] = _mm512_sub_epi32(bf0[15], bf0[16]);
+        out[17 * 2 + col] = _mm512_sub_epi32(bf0[14], bf0[17]);
+        out[18 * 2 + col] = _mm512_sub_epi32(bf0[13], bf0[18]);
+        out[19 * 2 + col] = _mm512_sub_epi32(bf0[12], bf0[19]);
+        out[20 * 2 + col] = _mm512_sub_epi32(bf0[11], bf0[20]);
+        out[21 * 2 + col] = _mm512_sub_epi32(bf0[10], bf0[21]);
+        out[22 * 2 + col] = _mm512_sub_epi32(bf0[9], bf0[22]);
+        out[23 * 2 + col] = _mm512_sub_epi32(bf0[8], bf0[23]);
+        out[24 * 2 + col] = _mm512_sub_epi32(bf0[7], bf0[24]);
+        out[25 * 2 + col] = _mm512_sub_epi32(bf0[6], bf0[25]);
+        out[26 * 2 + col] = _mm512_sub_epi32(bf0[5], bf0[26]);
+        out[27 * 2 + col] = _mm512_sub_epi32(bf0[4], bf0[27]);
+        out[28 * 2 + col] = _mm512_sub_epi32(bf0[3], bf0[28]);
+        out[29 * 2 + col] = _mm512_sub_epi32(bf0[2], bf0[29]);
+        out[30 * 2 + col] = _mm512_sub_epi32(bf0[1], bf0[30]);
+        out[31 * 2 + col] = _mm512_sub_epi32(bf0[0], bf0[31]);
+    }
+}
+
+static void transpose_16x16_avx512(const __m512i *in, __m512i *out) {
+    __m512i t[16], u[16], x0, x1, y0, y1;
+    int32_t i;
+
+    for (i = 0; i < 8; i++) {
+        t[2 * i + 0] = _mm512_unpacklo_epi32(in[(2 * i + 0) * 2], in[(2 * i + 1) * 2]);
+        t[2 * i + 1] = _mm512_unpackhi_epi32(in[(2 * i + 0) * 2], in[(2 * i + 1) * 2]);
+    }
+    for (i = 0; i < 4; i++) {
+        u[4 * i + 0] = _mm512_unpacklo_epi64(t[4 * i + 0], t[4 * i + 2]);
+        u[4 * i + 1] = _mm512_unpackhi_epi64(t[4 * i + 0], t[4 * i + 2]);
+        u[4 * i + 2] = _mm512_unpacklo_epi64(t[4 * i + 1], t[4 * i + 3]);
+        u[4 * i + 3] = _mm512_unpackhi_epi64(t[4 * i + 1], t[4 * i + 3]);
+    }
+    for (i = 0; i < 4; i++) {
+        x0 = _mm512_shuffle_i32x4(u[i], u[4 + i], 0x88);
+        x1 = _mm512_shuffle_i32x4(u[i], u[4 + i], 0xDD);
+        y0 = _mm512_shuffle_i32x4(u[8 + i], u[12 + i], 0x88);
+        y1 = _mm512_shuffle_i32x4(u[8 + i], u[12 + i], 0xDD);
+        out[(i + 0) * 2] = _mm512_shuffle_i32x4(x0, y0, 0x88);
+        out[(i + 4) * 2] = _mm512_shuffle_i32x4(x1, y1, 0x88);
+        out[(i + 8) * 2] = _mm512_shuffle_i32x4(x0, y0, 0xDD);
+        out[(i + 12) * 2] = _mm512_shuffle_i32x4(x1, y1, 0xDD);
+    }
+}
+
+static void transpose_32x32_avx512(const __m512i *in, __m512i *out) {
+    transpose_16x16_avx512(&in[0], &out[0]);
+    transpose_16x16_avx512(&in[1], &out[32]);
+    transpose_16x16_avx512(&in[32], &out[1]);
+    transpose_16x16_avx512(&in[33], &out[33]);
+}
+
+static void load_buffer_32x32_avx512(const int32_t *coeff, __m512i *in) {
+    int32_t i;
+    for (i = 0; i < 64; ++i) {
+        in[i] = _mm512_loadu_si512((const __m512i *)coeff);
+        coeff += 16;
+    }
+}
+
+static INLINE void round_shift_32x32_avx512(__m512i *in, int32_t shift) {
+    __m512i rnding = _mm512_set1_epi32(1 << (shift - 1));
+    int32_t i = 0;
+
+    while (i < 64) {
+        in[i] = _mm512_add_epi32(in[i], rnding);
+        in[i] = _mm512_srai_epi32(in[i], shift);
+        i++;
+    }
+}
+
+static void write_buffer_32x32_avx512(__m512i *in, uint16_t *output, int32_t stride,
+    int32_t bd) {
+    const __m512i zero = _mm512_setzero_si512();
+    const __m512i max = _mm512_set1_epi32((1 << bd) - 1);
+    __m512i v0, v1;
+    int32_t i = 0;
+
+    while (i < 64) {
+        v0 = _mm512_cvtepu16_epi32(_mm256_loadu_si256((const __m256i *)output));
+        v1 = _mm512_cvtepu16_epi32(_mm256_loadu_si256((const __m256i *)(output + 16)));
+
+        v0 = _mm512_add_epi32(v0, in[i]);
+        v1 = _mm512_add_epi32(v1, in[i + 1]);
+
+        v0 = _mm512_max_epi32(_mm512_min_epi32(v0, max), zero);
+        v1 = _mm512_max_epi32(_mm512_min_epi32(v1, max), zero);
+
+        _mm256_storeu_si256((__m256i *)output, _mm512_cvtepi32_epi16(v0));
+        _mm256_storeu_si256((__m256i *)(output + 16), _mm512_cvtepi32_epi16(v1));
+        output += stride;
+        i += 2;
+    }
+}
+
+void av1_inv_txfm2d_add_32x32_avx512(const int32_t *coeff, uint16_t *output,
+    int32_t stride, TxType tx_type, int32_t bd) {
+    __m512i in[64], out[64];
+    const int8_t *shift = inv_txfm_shift_ls[TX_32X32];
+    const int32_t txw_idx = get_txw_idx(TX_32X32);
+    const int32_t txh_idx = get_txh_idx(TX_32X32);
+
+    switch (tx_type) {
+    case DCT_DCT:
+        load_buffer_32x32_avx512(coeff, in);
+        transpose_32x32_avx512(in, out);
+        idct32_avx512(out, in, inv_cos_bit_row[txw_idx][txh_idx]);
+        round_shift_32x32_avx512(in, -shift[0]);
+        transpose_32x32_avx512(in, out);
+        idct32_avx512(out, in, inv_cos_bit_col[txw_idx][txh_idx]);
+        round_shift_32x32_avx512(in, -shift[1]);
+        write_buffer_32x32_avx512(in, output, stride, bd);
+        break;
+    case IDTX:
+        load_buffer_32x32_avx512(coeff, in);
+        // Same joined identity shifts as av1_inv_txfm2d_add_32x32_avx2()
+        round_shift_32x32_avx512(in, -shift[0] - shift[1] - 4);
+        write_buffer_32x32_avx512(in, output, stride, bd);
+        break;
+    default: assert(0);
+    }
+}
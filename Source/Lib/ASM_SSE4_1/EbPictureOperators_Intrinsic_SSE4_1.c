@@ -515,8 +515,7 @@ uint64_t SpatialFullDistortionKernel4x4_SSSE3_INTRIN(
         y0 = _mm_setr_epi32(*((uint32_t *)recon), 0, 0, 0);
         input += input_stride;
         recon += recon_stride;
-        x0 = _mm_sub_epi8(x0, y0);
-        x0 = _mm_sign_epi8(x0, x0);
+        x0 = _mm_or_si128(_mm_subs_epu8(x0, y0), _mm_subs_epu8(y0, x0));
         x0 = _mm_unpacklo_epi8(x0, _mm_setzero_si128());
         x0 = _mm_madd_epi16(x0, x0);
         sum = _mm_add_epi32(sum, x0);
@@ -552,8 +551,7 @@ uint64_t SpatialFullDistortionKernel8x8_SSSE3_INTRIN(
         y0 = _mm_loadl_epi64((__m128i *)(recon + 0x00));
         input += input_stride;
         recon += recon_stride;
-        x0 = _mm_sub_epi8(x0, y0);
-        x0 = _mm_sign_epi8(x0, x0);
+        x0 = _mm_or_si128(_mm_subs_epu8(x0, y0), _mm_subs_epu8(y0, x0));
         x0 = _mm_unpacklo_epi8(x0, _mm_setzero_si128());
         x0 = _mm_madd_epi16(x0, x0);
         sum = _mm_add_epi32(sum, x0);
@@ -596,8 +594,7 @@ uint64_t SpatialFullDistortionKernel16MxN_SSSE3_INTRIN(
             y0 = _mm_loadu_si128((__m128i *)(reconCoeffTemp + 0x00));
             coeffTemp += input_stride;
             reconCoeffTemp += recon_stride;
-            x0 = _mm_sub_epi8(x0, y0);
-            x0 = _mm_sign_epi8(x0, x0);
+            x0 = _mm_or_si128(_mm_subs_epu8(x0, y0), _mm_subs_epu8(y0, x0));
 
             x0_L = _mm_unpacklo_epi8(x0, _mm_setzero_si128());
             x0_H = _mm_unpackhi_epi8(x0, _mm_setzero_si128());
@@ -2496,7 +2496,11 @@ static INLINE void av1_round_shift_rect_array_32_sse4_1(__m128i *input,
 
 static void iidentity4_sse4_1(__m128i *in, __m128i *out, int32_t bit, int32_t do_cols,
     int32_t bd, int32_t out_shift) {
+    // Like idct4x4_sse4_1() and iadst4x4_sse4_1(), the row outputs are
+    // clamped by the caller once they are shifted
     (void)bit;
+    (void)do_cols;
+    (void)bd;
     (void)out_shift;
     __m128i v[4];
     __m128i fact = _mm_set1_epi32(NewSqrt2);
@@ -2517,14 +2521,6 @@ static void iidentity4_sse4_1(__m128i *in, __m128i *out, int32_t bit, int32_t do
     out[2] = _mm_srai_epi32(a0, NewSqrt2Bits);
     out[3] = _mm_srai_epi32(a1, NewSqrt2Bits);
 
-    if (!do_cols) {
-        const int32_t log_range = AOMMAX(16, bd + 6);
-        const __m128i clamp_lo = _mm_set1_epi32(-(1 << (log_range - 1)));
-        const __m128i clamp_hi = _mm_set1_epi32((1 << (log_range - 1)) - 1);
-
-        highbd_clamp_epi32_sse4_1(out, out, &clamp_lo, &clamp_hi, 4);
-    }
-
     // Transpose for 4x4
     v[0] = _mm_unpacklo_epi32(out[0], out[1]);
     v[1] = _mm_unpackhi_epi32(out[0], out[1]);
@@ -4396,6 +4392,16 @@ highbd_txfm_all_1d_zeros_w8_arr[TX_SIZES][ITX_TYPES_1D][4] = {
     { NULL, NULL, NULL, NULL } }
 };
 
+// Clamps the shifted row outputs to the column input range, as the C path
+static INLINE void highbd_clamp_row_output_sse4_1(__m128i *buf, int32_t size,
+    int32_t bd) {
+    const int32_t log_range = AOMMAX(16, bd + 6);
+    const __m128i clamp_lo = _mm_set1_epi32(-(1 << (log_range - 1)));
+    const __m128i clamp_hi = _mm_set1_epi32((1 << (log_range - 1)) - 1);
+
+    highbd_clamp_epi32_sse4_1(buf, buf, &clamp_lo, &clamp_hi, size);
+}
+
 void av1_inv_txfm2d_add_4x8_sse4_1(const int32_t *input,
     uint16_t *output, int32_t stride,
     TxType tx_type, TxSize tx_size, int32_t bd) {
@@ -4426,6 +4432,7 @@ void av1_inv_txfm2d_add_4x8_sse4_1(const int32_t *input,
     row_txfm(buf0, buf0, inv_cos_bit_row[txw_idx][txh_idx], 0, bd, -shift[0]);
     row_txfm(buf0 + 4, buf0 + 4, inv_cos_bit_row[txw_idx][txh_idx], 0, bd,
         -shift[0]);
+    highbd_clamp_row_output_sse4_1(buf0, txfm_size_row, bd);
 
     if (lr_flip) {
         TRANSPOSE_4X4(buf0[3], buf0[2], buf0[1], buf0[0], buf1[0], buf1[1], buf1[2],
@@ -4570,6 +4577,7 @@ void av1_inv_txfm2d_add_4x16_sse4_1(const int32_t *input,
     }
 
     av1_round_shift_array_32_sse4_1(buf0, buf0, txfm_size_row, -shift[0]);
+    highbd_clamp_row_output_sse4_1(buf0, txfm_size_row, bd);
 
     if (lr_flip) {
         for (int32_t j = 0; j < buf_size_h_div8; ++j) {
@@ -0,0 +1,333 @@
+/*
+* Copyright(c) 2019 Intel Corporation
+* SPDX - License - Identifier: BSD - 2 - Clause - Patent
+*/
+
+/*
+* Copyright (c) 2016, Alliance for Open Media. All rights reserved
+*
+* This source code is subject to the terms of the BSD 2 Clause License and
+* the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+* was not distributed with this source code in the LICENSE file, you can
+* obtain it at www.aomedia.org/license/software. If the Alliance for Open
+* Media Patent License 1.0 was not distributed with this source code in the
+* PATENTS file, you can obtain it at www.aomedia.org/license/patent.
+*/
+
+#include <assert.h>
+#include <string.h>
+#include <smmintrin.h> /* SSE4.1 */
+
+#include "EbDefinitions.h"
+#include "aom_dsp_rtcd.h"
+#include "EbWarpedMotion.h"
+
+/* Note: For an explanation of the warp algorithm, and some notes on bit widths
+    for hardware implementations, see the comments above av1_warp_affine_c.
+
+    The 8-bit and the high bit depth kernels share the code below: the
+    reference samples are widened to 16 bits and the intermediate 15x8 block
+    holds 16-bit values, as the horizontal filter output fits in
+    bd + FILTER_BITS + 1 - reduce_bits_horiz <= 15 bits.
+*/
+
+static INLINE __m128i warp_filter_coeffs_sse4_1(int32_t sx) {
+    const int32_t offs = ROUND_POWER_OF_TWO(sx, WARPEDDIFF_PREC_BITS) +
+        WARPEDPIXEL_PREC_SHIFTS;
+    assert(offs >= 0 && offs <= WARPEDPIXEL_PREC_SHIFTS * 3);
+    return _mm_loadu_si128((const __m128i *)warped_filter[offs]);
+}
+
+// Loads the samples ix4 - 7 .. ix4 + 8 of a reference row as 16-bit values,
+// clamped to the left and right frame edges like the C reference
+static INLINE void warp_load_row_sse4_1(const uint8_t *ref8,
+    const uint16_t *ref16, int32_t width, int32_t ix4,
+    __m128i *src_lo, __m128i *src_hi) {
+    if (ix4 - 7 >= 0 && ix4 + 9 <= width) {
+        if (ref16) {
+            *src_lo = _mm_loadu_si128((const __m128i *)(ref16 + ix4 - 7));
+            *src_hi = _mm_loadu_si128((const __m128i *)(ref16 + ix4 + 1));
+        }
+        else {
+            const __m128i src = _mm_loadu_si128((const __m128i *)(ref8 + ix4 - 7));
+            *src_lo = _mm_cvtepu8_epi16(src);
+            *src_hi = _mm_unpackhi_epi8(src, _mm_setzero_si128());
+        }
+    }
+    else {
+        DECLARE_ALIGNED(16, uint16_t, row[16]);
+        for (int32_t m = 0; m < 16; ++m) {
+            const int32_t sample_x = clamp(ix4 - 7 + m, 0, width - 1);
+            row[m] = ref16 ? ref16[sample_x] : ref8[sample_x];
+        }
+        *src_lo = _mm_load_si128((const __m128i *)row);
+        *src_hi = _mm_load_si128((const __m128i *)(row + 8));
+    }
+}
+
+// Filters one row of 8 outputs, output l using the filter phase sx + alpha * l
+static INLINE __m128i warp_horizontal_filter_sse4_1(const __m128i src_lo,
+    const __m128i src_hi, int32_t sx, int32_t alpha, const __m128i round_const,
+    const __m128i round_shift) {
+    const __m128i m0 = _mm_madd_epi16(src_lo, warp_filter_coeffs_sse4_1(sx));
+    const __m128i m1 = _mm_madd_epi16(_mm_alignr_epi8(src_hi, src_lo, 2), warp_filter_coeffs_sse4_1(sx + alpha));
+    const __m128i m2 = _mm_madd_epi16(_mm_alignr_epi8(src_hi, src_lo, 4), warp_filter_coeffs_sse4_1(sx + 2 * alpha));
+    const __m128i m3 = _mm_madd_epi16(_mm_alignr_epi8(src_hi, src_lo, 6), warp_filter_coeffs_sse4_1(sx + 3 * alpha));
+    const __m128i m4 = _mm_madd_epi16(_mm_alignr_epi8(src_hi, src_lo, 8), warp_filter_coeffs_sse4_1(sx + 4 * alpha));
+    const __m128i m5 = _mm_madd_epi16(_mm_alignr_epi8(src_hi, src_lo, 10), warp_filter_coeffs_sse4_1(sx + 5 * alpha));
+    const __m128i m6 = _mm_madd_epi16(_mm_alignr_epi8(src_hi, src_lo, 12), warp_filter_coeffs_sse4_1(sx + 6 * alpha));
+    const __m128i m7 = _mm_madd_epi16(_mm_alignr_epi8(src_hi, src_lo, 14), warp_filter_coeffs_sse4_1(sx + 7 * alpha));
+
+    __m128i sum_0123 = _mm_hadd_epi32(_mm_hadd_epi32(m0, m1), _mm_hadd_epi32(m2, m3));
+    __m128i sum_4567 = _mm_hadd_epi32(_mm_hadd_epi32(m4, m5), _mm_hadd_epi32(m6, m7));
+
+    sum_0123 = _mm_sra_epi32(_mm_add_epi32(sum_0123, round_const), round_shift);
+    sum_4567 = _mm_sra_epi32(_mm_add_epi32(sum_4567, round_const), round_shift);
+
+    return _mm_packs_epi32(sum_0123, sum_4567);
+}
+
+// Gathers the filters of the 8 outputs of a row, tap pair p of outputs
+// 0..3 in coeffs[2 * p] and of outputs 4..7 in coeffs[2 * p + 1]
+static INLINE void warp_vertical_coeffs_sse4_1(int32_t sy, int32_t gamma,
+    __m128i *coeffs) {
+    for (int32_t half = 0; half < 2; ++half) {
+        const int32_t s = sy + 4 * half * gamma;
+        const __m128i c0 = warp_filter_coeffs_sse4_1(s);
+        const __m128i c1 = warp_filter_coeffs_sse4_1(s + gamma);
+        const __m128i c2 = warp_filter_coeffs_sse4_1(s + 2 * gamma);
+        const __m128i c3 = warp_filter_coeffs_sse4_1(s + 3 * gamma);
+
+        const __m128i t0 = _mm_unpacklo_epi32(c0, c1);
+        const __m128i t1 = _mm_unpacklo_epi32(c2, c3);
+        const __m128i t2 = _mm_unpackhi_epi32(c0, c1);
+        const __m128i t3 = _mm_unpackhi_epi32(c2, c3);
+
+        coeffs[0 + half] = _mm_unpacklo_epi64(t0, t1);
+        coeffs[2 + half] = _mm_unpackhi_epi64(t0, t1);
+        coeffs[4 + half] = _mm_unpacklo_epi64(t2, t3);
+        coeffs[6 + half] = _mm_unpackhi_epi64(t2, t3);
+    }
+}
+
+static INLINE void warp_store_sse4_1(uint8_t *pred8, uint16_t *pred16,
+    int32_t bd, int32_t count, __m128i res_lo, __m128i res_hi) {
+    __m128i res;
+
+    if (pred16) {
+        res = _mm_packus_epi32(res_lo, res_hi);
+        res = _mm_min_epu16(res, _mm_set1_epi16((int16_t)((1 << bd) - 1)));
+        if (count == 8)
+            _mm_storeu_si128((__m128i *)pred16, res);
+        else {
+            DECLARE_ALIGNED(16, uint16_t, row[8]);
+            _mm_store_si128((__m128i *)row, res);
+            memcpy(pred16, row, count * sizeof(*pred16));
+        }
+    }
+    else {
+        res = _mm_packs_epi32(res_lo, res_hi);
+        res = _mm_packus_epi16(res, res);
+        if (count == 8)
+            _mm_storel_epi64((__m128i *)pred8, res);
+        else {
+            DECLARE_ALIGNED(16, uint8_t, row[16]);
+            _mm_store_si128((__m128i *)row, res);
+            memcpy(pred8, row, count);
+        }
+    }
+}
+
+static INLINE void warp_affine_sse4_1(const int32_t *mat, const uint8_t *ref8,
+    const uint16_t *ref16, int32_t width, int32_t height, int32_t stride,
+    uint8_t *pred8, uint16_t *pred16, int32_t p_col, int32_t p_row,
+    int32_t p_width, int32_t p_height, int32_t p_stride, int32_t subsampling_x,
+    int32_t subsampling_y, int32_t bd, int32_t reduce_bits_horiz,
+    ConvolveParams *conv_params, int16_t alpha, int16_t beta, int16_t gamma,
+    int16_t delta) {
+    __m128i tmp[15];
+    __m128i coeffs[8];
+    const int32_t reduce_bits_vert = conv_params->is_compound
+        ? conv_params->round_1
+        : 2 * FILTER_BITS - reduce_bits_horiz;
+    const int32_t offset_bits_horiz = bd + FILTER_BITS - 1;
+    const int32_t offset_bits_vert = bd + 2 * FILTER_BITS - reduce_bits_horiz;
+    const int32_t round_bits =
+        2 * FILTER_BITS - conv_params->round_0 - conv_params->round_1;
+    const int32_t offset_bits = bd + 2 * FILTER_BITS - conv_params->round_0;
+
+    const __m128i round_const_horiz = _mm_set1_epi32(
+        (1 << offset_bits_horiz) + ((1 << reduce_bits_horiz) >> 1));
+    const __m128i round_shift_horiz = _mm_cvtsi32_si128(reduce_bits_horiz);
+    const __m128i round_const_vert = _mm_set1_epi32(
+        (1 << offset_bits_vert) + ((1 << reduce_bits_vert) >> 1));
+    const __m128i round_shift_vert = _mm_cvtsi32_si128(reduce_bits_vert);
+    const __m128i res_sub_const = _mm_set1_epi32(conv_params->is_compound
+        ? (1 << (offset_bits - conv_params->round_1)) + (1 << (offset_bits - conv_params->round_1 - 1))
+        : (1 << (bd - 1)) + (1 << bd));
+    const __m128i round_const_bits = _mm_set1_epi32((1 << round_bits) >> 1);
+    const __m128i round_shift_bits = _mm_cvtsi32_si128(round_bits);
+    const __m128i fwd_offset = _mm_set1_epi32(conv_params->fwd_offset);
+    const __m128i bck_offset = _mm_set1_epi32(conv_params->bck_offset);
+
+    assert(IMPLIES(conv_params->is_compound, conv_params->dst != NULL));
+    assert(IMPLIES(conv_params->do_average, conv_params->is_compound));
+
+    for (int32_t i = p_row; i < p_row + p_height; i += 8) {
+        for (int32_t j = p_col; j < p_col + p_width; j += 8) {
+            // Calculate the center of this 8x8 block,
+            // project to luma coordinates (if in a subsampled chroma plane),
+            // apply the affine transformation,
+            // then convert back to the original coordinates (if necessary)
+            const int32_t src_x = (j + 4) << subsampling_x;
+            const int32_t src_y = (i + 4) << subsampling_y;
+            const int32_t dst_x = mat[2] * src_x + mat[3] * src_y + mat[0];
+            const int32_t dst_y = mat[4] * src_x + mat[5] * src_y + mat[1];
+            const int32_t x4 = dst_x >> subsampling_x;
+            const int32_t y4 = dst_y >> subsampling_y;
+
+            const int32_t ix4 = x4 >> WARPEDMODEL_PREC_BITS;
+            int32_t sx4 = x4 & ((1 << WARPEDMODEL_PREC_BITS) - 1);
+            const int32_t iy4 = y4 >> WARPEDMODEL_PREC_BITS;
+            int32_t sy4 = y4 & ((1 << WARPEDMODEL_PREC_BITS) - 1);
+
+            const int32_t out_rows = AOMMIN(8, p_row + p_height - i);
+            const int32_t out_cols = AOMMIN(8, p_col + p_width - j);
+
+            sx4 += alpha * (-4) + beta * (-4);
+            sy4 += gamma * (-4) + delta * (-4);
+
+            sx4 &= ~((1 << WARP_PARAM_REDUCE_BITS) - 1);
+            sy4 &= ~((1 << WARP_PARAM_REDUCE_BITS) - 1);
+
+            // Horizontal filter, only the rows the outputs need
+            for (int32_t k = 0; k < out_rows + 7; ++k) {
+                // Clamp to top/bottom edge of the frame
+                const int32_t iy = clamp(iy4 + k - 7, 0, height - 1);
+                __m128i src_lo, src_hi;
+
+                warp_load_row_sse4_1(
+                    ref16 ? NULL : ref8 + iy * stride,
+                    ref16 ? ref16 + iy * stride : NULL,
+                    width,
+                    ix4,
+                    &src_lo,
+                    &src_hi);
+
+                tmp[k] = warp_horizontal_filter_sse4_1(
+                    src_lo,
+                    src_hi,
+                    sx4 + beta * (k - 3),
+                    alpha,
+                    round_const_horiz,
+                    round_shift_horiz);
+            }
+
+            // Vertical filter
+            for (int32_t k = 0; k < out_rows; ++k) {
+                __m128i sum_lo = round_const_vert;
+                __m128i sum_hi = round_const_vert;
+
+                warp_vertical_coeffs_sse4_1(sy4 + delta * k, gamma, coeffs);
+
+                for (int32_t m = 0; m < 8; m += 2) {
+                    const __m128i src_lo = _mm_unpacklo_epi16(tmp[k + m], tmp[k + m + 1]);
+                    const __m128i src_hi = _mm_unpackhi_epi16(tmp[k + m], tmp[k + m + 1]);
+                    sum_lo = _mm_add_epi32(sum_lo, _mm_madd_epi16(src_lo, coeffs[m]));
+                    sum_hi = _mm_add_epi32(sum_hi, _mm_madd_epi16(src_hi, coeffs[m + 1]));
+                }
+
+                sum_lo = _mm_sra_epi32(sum_lo, round_shift_vert);
+                sum_hi = _mm_sra_epi32(sum_hi, round_shift_vert);
+
+                const int32_t out_offset = (i - p_row + k) * p_stride + (j - p_col);
+
+                if (conv_params->is_compound) {
+                    CONV_BUF_TYPE *p = &conv_params->dst[(i - p_row + k) * conv_params->dst_stride + (j - p_col)];
+
+                    if (conv_params->do_average) {
+                        __m128i res_lo, res_hi;
+
+                        if (out_cols == 8) {
+                            const __m128i dst = _mm_loadu_si128((const __m128i *)p);
+                            res_lo = _mm_cvtepu16_epi32(dst);
+                            res_hi = _mm_unpackhi_epi16(dst, _mm_setzero_si128());
+                        }
+                        else {
+                            res_lo = _mm_cvtepu16_epi32(_mm_loadl_epi64((const __m128i *)p));
+                            res_hi = res_lo;
+                        }
+
+                        if (conv_params->use_jnt_comp_avg) {
+                            res_lo = _mm_add_epi32(_mm_mullo_epi32(res_lo, fwd_offset), _mm_mullo_epi32(sum_lo, bck_offset));
+                            res_hi = _mm_add_epi32(_mm_mullo_epi32(res_hi, fwd_offset), _mm_mullo_epi32(sum_hi, bck_offset));
+                            res_lo = _mm_srai_epi32(res_lo, DIST_PRECISION_BITS);
+                            res_hi = _mm_srai_epi32(res_hi, DIST_PRECISION_BITS);
+                        }
+                        else {
+                            res_lo = _mm_srai_epi32(_mm_add_epi32(res_lo, sum_lo), 1);
+                            res_hi = _mm_srai_epi32(_mm_add_epi32(res_hi, sum_hi), 1);
+                        }
+
+                        res_lo = _mm_sub_epi32(res_lo, res_sub_const);
+                        res_hi = _mm_sub_epi32(res_hi, res_sub_const);
+                        res_lo = _mm_sra_epi32(_mm_add_epi32(res_lo, round_const_bits), round_shift_bits);
+                        res_hi = _mm_sra_epi32(_mm_add_epi32(res_hi, round_const_bits), round_shift_bits);
+
+                        warp_store_sse4_1(
+                            pred16 ? NULL : pred8 + out_offset,
+                            pred16 ? pred16 + out_offset : NULL,
+                            bd,
+                            out_cols,
+                            res_lo,
+                            res_hi);
+                    }
+                    else {
+                        const __m128i res = _mm_packus_epi32(sum_lo, sum_hi);
+                        if (out_cols == 8)
+                            _mm_storeu_si128((__m128i *)p, res);
+                        else
+                            _mm_storel_epi64((__m128i *)p, res);
+                    }
+                }
+                else {
+                    warp_store_sse4_1(
+                        pred16 ? NULL : pred8 + out_offset,
+                        pred16 ? pred16 + out_offset : NULL,
+                        bd,
+                        out_cols,
+                        _mm_sub_epi32(sum_lo, res_sub_const),
+                        _mm_sub_epi32(sum_hi, res_sub_const));
+                }
+            }
+        }
+    }
+}
+
+void av1_warp_affine_sse4_1(const int32_t *mat, const uint8_t *ref, int width,
+    int height, int stride, uint8_t *pred, int p_col,
+    int p_row, int p_width, int p_height, int p_stride,
+    int subsampling_x, int subsampling_y,
+    ConvolveParams *conv_params, int16_t alpha, int16_t beta,
+    int16_t gamma, int16_t delta) {
+    warp_affine_sse4_1(mat, ref, NULL, width, height, stride, pred, NULL,
+        p_col, p_row, p_width, p_height, p_stride, subsampling_x,
+        subsampling_y, 8, conv_params->round_0, conv_params, alpha, beta,
+        gamma, delta);
+}
+
+void av1_highbd_warp_affine_sse4_1(const int32_t *mat, const uint16_t *ref,
+    int width, int height, int stride, uint16_t *pred,
+    int p_col, int p_row, int p_width, int p_height,
+    int p_stride, int subsampling_x,
+    int subsampling_y, int bd,
+    ConvolveParams *conv_params, int16_t alpha,
+    int16_t beta, int16_t gamma, int16_t delta) {
+    const int32_t reduce_bits_horiz = conv_params->round_0 +
+        AOMMAX(bd + FILTER_BITS - conv_params->round_0 - 14, 0);
+
+    warp_affine_sse4_1(mat, NULL, ref, width, height, stride, NULL, pred,
+        p_col, p_row, p_width, p_height, p_stride, subsampling_x,
+        subsampling_y, bd, reduce_bits_horiz, conv_params, alpha, beta,
+        gamma, delta);
+}
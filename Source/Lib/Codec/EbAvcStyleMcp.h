@@ -265,6 +265,25 @@ extern "C" {
             avc_style_luma_interpolation_filter_posq_ssse3,             //q
             avc_style_luma_interpolation_filter_posr_ssse3,             //r
         },
+        // AVX512
+        {
+            avc_style_copy_sse2,                                    //A
+            avc_style_luma_interpolation_filter_horizontal_ssse3_intrin,       //a
+            avc_style_luma_interpolation_filter_horizontal_ssse3_intrin,       //b
+            avc_style_luma_interpolation_filter_horizontal_ssse3_intrin,       //c
+            avc_style_luma_interpolation_filter_vertical_ssse3_intrin,         //d
+            avc_style_luma_interpolation_filter_pose_ssse3,             //e
+            avc_style_luma_interpolation_filter_posf_ssse3,             //f
+            avc_style_luma_interpolation_filter_posg_ssse3,             //g
+            avc_style_luma_interpolation_filter_vertical_ssse3_intrin,         //h
+            avc_style_luma_interpolation_filter_posi_ssse3,             //i
+            avc_style_luma_interpolation_filter_posj_ssse3,             //j
+            avc_style_luma_interpolation_filter_posk_ssse3,             //k
+            avc_style_luma_interpolation_filter_vertical_ssse3_intrin,         //n
+            avc_style_luma_interpolation_filter_posp_ssse3,             //p
+            avc_style_luma_interpolation_filter_posq_ssse3,             //q
+            avc_style_luma_interpolation_filter_posr_ssse3,             //r
+        },
     };
 
     static const PictureAverage FUNC_TABLE picture_average_array[ASM_TYPE_TOTAL] = {
@@ -272,6 +291,8 @@ extern "C" {
         picture_average_kernel_sse2_intrin,
         // AVX2
         picture_average_kernel_sse2_intrin,
+        // AVX512
+        picture_average_kernel_sse2_intrin,
     };
 
     typedef void(*PictureAverage1Line)(
@@ -285,6 +306,8 @@ extern "C" {
         picture_average_kernel1_line_sse2_intrin,
         // AVX2
         picture_average_kernel1_line_sse2_intrin,
+        // AVX512
+        picture_average_kernel1_line_sse2_intrin,
     };
 
 #ifdef __cplusplus
@@ -108,8 +108,9 @@ EbErrorType output_bitstream_rbsp_to_payload(
 /********************************************************************************************************************************/
 /********************************************************************************************************************************/
 // daalaboolwriter.c
-void aom_daala_start_encode(daala_writer *br, uint8_t *source) {
+void aom_daala_start_encode(daala_writer *br, uint8_t *source, uint32_t source_size) {
     br->buffer = source;
+    br->buffer_size = source_size;
     br->pos = 0;
     od_ec_enc_init(&br->ec, 62025);
 }
@@ -120,6 +121,12 @@ int32_t aom_daala_stop_encode(daala_writer *br) {
     uint8_t *daala_data;
     daala_data = od_ec_enc_done(&br->ec, &daala_bytes);
     nb_bits = od_ec_enc_tell(&br->ec);
+    // Nothing is written when the data does not fit in the buffer
+    if (daala_data == NULL || daala_bytes > br->buffer_size) {
+        br->pos = 0;
+        od_ec_enc_clear(&br->ec);
+        return -1;
+    }
     memcpy(br->buffer, daala_data, daala_bytes);
     br->pos = daala_bytes;
     od_ec_enc_clear(&br->ec);
@@ -245,13 +245,14 @@ on a larger type, you can speed up the decoder by using it here.*/
     struct daala_writer {
         uint32_t pos;
         uint8_t *buffer;
+        uint32_t buffer_size;
         od_ec_enc ec;
         uint8_t allow_update_cdf;
     };
 
     typedef struct daala_writer daala_writer;
 
-    void aom_daala_start_encode(daala_writer *w, uint8_t *buffer);
+    void aom_daala_start_encode(daala_writer *w, uint8_t *buffer, uint32_t buffer_size);
     int32_t aom_daala_stop_encode(daala_writer *w);
 
     static INLINE void aom_daala_write(daala_writer *w, int32_t bit, int32_t prob) {
@@ -312,8 +313,8 @@ on a larger type, you can speed up the decoder by using it here.*/
         token_stats->cost = 0;
     }
 
-    static INLINE void aom_start_encode(aom_writer *bc, uint8_t *buffer) {
-        aom_daala_start_encode(bc, buffer);
+    static INLINE void aom_start_encode(aom_writer *bc, uint8_t *buffer, uint32_t buffer_size) {
+        aom_daala_start_encode(bc, buffer, buffer_size);
     }
 
     static INLINE int32_t aom_stop_encode(aom_writer *bc) {
@@ -444,9 +444,12 @@ void cdef_seg_search16bit(
 #endif
 
 /******************************************************
- * CDEF Kernel
+ * CDEF Kernel Task
+ *   Processes one DLF Results object
  ******************************************************/
-void* cdef_kernel(void *input_ptr)
+void cdef_kernel_task(
+    EbPtr                                    input_ptr,
+    EbObjectWrapper_t                       *dlf_results_wrapper_ptr)
 {
     // Context & SCS & PCS
     CdefContext_t                            *context_ptr = (CdefContext_t*)input_ptr;
@@ -454,7 +457,6 @@ void* cdef_kernel(void *input_ptr)
     SequenceControlSet_t                    *sequence_control_set_ptr;
 
     //// Input
-    EbObjectWrapper_t                       *dlf_results_wrapper_ptr;
     DlfResults_t                            *dlf_results_ptr;
 
     //// Output
@@ -463,214 +465,225 @@ void* cdef_kernel(void *input_ptr)
 
     // SB Loop variables
 
+    dlf_results_ptr = (DlfResults_t*)dlf_results_wrapper_ptr->object_ptr;
+    picture_control_set_ptr = (PictureControlSet_t*)dlf_results_ptr->picture_control_set_wrapper_ptr->object_ptr;
+    sequence_control_set_ptr = (SequenceControlSet_t*)picture_control_set_ptr->sequence_control_set_wrapper_ptr->object_ptr;
 
-    for (;;) {
-
-        // Get DLF Results
-        eb_get_full_object(
-            context_ptr->cdef_input_fifo_ptr,
-            &dlf_results_wrapper_ptr);
-
-        dlf_results_ptr = (DlfResults_t*)dlf_results_wrapper_ptr->object_ptr;
-        picture_control_set_ptr = (PictureControlSet_t*)dlf_results_ptr->picture_control_set_wrapper_ptr->object_ptr;
-        sequence_control_set_ptr = (SequenceControlSet_t*)picture_control_set_ptr->sequence_control_set_wrapper_ptr->object_ptr;
-
-        EbBool  is16bit = (EbBool)(sequence_control_set_ptr->static_config.encoder_bit_depth > EB_8BIT);
-        Av1Common* cm = picture_control_set_ptr->parent_pcs_ptr->av1_cm;
+    EbBool  is16bit = (EbBool)(sequence_control_set_ptr->static_config.encoder_bit_depth > EB_8BIT);
+    Av1Common* cm = picture_control_set_ptr->parent_pcs_ptr->av1_cm;
 
 #if FAST_CDEF
-        int32_t selected_strength_cnt[64] = { 0 };
+    int32_t selected_strength_cnt[64] = { 0 };
 #endif
 
 #if CDEF_M
 #if CDEF_M
-        if (sequence_control_set_ptr->enable_cdef && picture_control_set_ptr->parent_pcs_ptr->cdef_filter_mode)
-        {
+    if (sequence_control_set_ptr->enable_cdef && picture_control_set_ptr->parent_pcs_ptr->cdef_filter_mode)
+    {
 #endif
-            if (is16bit)
-                cdef_seg_search16bit(
-                    picture_control_set_ptr,
-                    sequence_control_set_ptr,
-                    dlf_results_ptr->segment_index);
-            else
-                cdef_seg_search(
-                    picture_control_set_ptr,
-                    sequence_control_set_ptr,
-                    dlf_results_ptr->segment_index);
+        if (is16bit)
+            cdef_seg_search16bit(
+                picture_control_set_ptr,
+                sequence_control_set_ptr,
+                dlf_results_ptr->segment_index);
+        else
+            cdef_seg_search(
+                picture_control_set_ptr,
+                sequence_control_set_ptr,
+                dlf_results_ptr->segment_index);
 #if CDEF_M
-        }
+    }
 #endif
 
-        //all seg based search is done. update total processed segments. if all done, finish the search and perfrom application.
-        eb_block_on_mutex(picture_control_set_ptr->cdef_search_mutex);
+    //all seg based search is done. update total processed segments. if all done, finish the search and perfrom application.
+    eb_block_on_mutex(picture_control_set_ptr->cdef_search_mutex);
 
-        picture_control_set_ptr->tot_seg_searched_cdef++;
-        if (picture_control_set_ptr->tot_seg_searched_cdef == picture_control_set_ptr->cdef_segments_total_count)
-        {
+    picture_control_set_ptr->tot_seg_searched_cdef++;
+    if (picture_control_set_ptr->tot_seg_searched_cdef == picture_control_set_ptr->cdef_segments_total_count)
+    {
 #endif
 
-           // printf("    CDEF all seg here  %i\n", picture_control_set_ptr->picture_number);
+       // printf("    CDEF all seg here  %i\n", picture_control_set_ptr->picture_number);
 
 #if ! CDEF_M
-        EbPictureBufferDesc_t  * recon_picture_ptr;
-        if (is16bit) {
-            if (picture_control_set_ptr->parent_pcs_ptr->is_used_as_reference_flag == EB_TRUE)
-                recon_picture_ptr = ((EbReferenceObject_t*)picture_control_set_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr->object_ptr)->referencePicture16bit;
-            else
-                recon_picture_ptr = picture_control_set_ptr->recon_picture16bit_ptr;
-        }
-        else {
-            if (picture_control_set_ptr->parent_pcs_ptr->is_used_as_reference_flag == EB_TRUE)
-                recon_picture_ptr = ((EbReferenceObject_t*)picture_control_set_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr->object_ptr)->referencePicture;
-            else
-                recon_picture_ptr = picture_control_set_ptr->recon_picture_ptr;
-        }
+    EbPictureBufferDesc_t  * recon_picture_ptr;
+    if (is16bit) {
+        if (picture_control_set_ptr->parent_pcs_ptr->is_used_as_reference_flag == EB_TRUE)
+            recon_picture_ptr = ((EbReferenceObject_t*)picture_control_set_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr->object_ptr)->referencePicture16bit;
+        else
+            recon_picture_ptr = picture_control_set_ptr->recon_picture16bit_ptr;
+    }
+    else {
+        if (picture_control_set_ptr->parent_pcs_ptr->is_used_as_reference_flag == EB_TRUE)
+            recon_picture_ptr = ((EbReferenceObject_t*)picture_control_set_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr->object_ptr)->referencePicture;
+        else
+            recon_picture_ptr = picture_control_set_ptr->recon_picture_ptr;
+    }
 
-        LinkEbToAomBufferDesc(
-            recon_picture_ptr,
-            cm->frame_to_show);
+    LinkEbToAomBufferDesc(
+        recon_picture_ptr,
+        cm->frame_to_show);
 
-        if (sequence_control_set_ptr->enable_restoration) {
-            av1_loop_restoration_save_boundary_lines(cm->frame_to_show, cm, 0);
-        }
+    if (sequence_control_set_ptr->enable_restoration) {
+        av1_loop_restoration_save_boundary_lines(cm->frame_to_show, cm, 0);
+    }
 #endif
 
 
 #if CDEF_REF_ONLY
-        if (sequence_control_set_ptr->enable_cdef && picture_control_set_ptr->parent_pcs_ptr->is_used_as_reference_flag) {
+    if (sequence_control_set_ptr->enable_cdef && picture_control_set_ptr->parent_pcs_ptr->is_used_as_reference_flag) {
 #else
-        if (sequence_control_set_ptr->enable_cdef && picture_control_set_ptr->parent_pcs_ptr->cdef_filter_mode) {
+    if (sequence_control_set_ptr->enable_cdef && picture_control_set_ptr->parent_pcs_ptr->cdef_filter_mode) {
 #endif
 #if CDEF_M
-                finish_cdef_search(
-                    0,
-                    sequence_control_set_ptr,
-                    picture_control_set_ptr
+            finish_cdef_search(
+                0,
+                sequence_control_set_ptr,
+                picture_control_set_ptr
 #if FAST_CDEF
-                    ,selected_strength_cnt
+                ,selected_strength_cnt
 #endif
-                );
-
-                if (is16bit)
-                    av1_cdef_frame16bit(
-                        0,
-                        sequence_control_set_ptr,
-                        picture_control_set_ptr);
-                else
-                    av1_cdef_frame(
-                        0,
-                        sequence_control_set_ptr,
-                        picture_control_set_ptr);
-#else
-
-            if (is16bit) {
-                av1_cdef_search16bit(
-                    0,//context_ptr,
-                    sequence_control_set_ptr,
-                    picture_control_set_ptr
-                );
+            );
 
+            if (is16bit)
                 av1_cdef_frame16bit(
-                    0,//context_ptr,
-                    sequence_control_set_ptr,
-                    picture_control_set_ptr
-                );
-            }
-            else {
-                av1_cdef_search(
-                    0,//context_ptr,
+                    0,
                     sequence_control_set_ptr,
-                    picture_control_set_ptr
-                );
-
+                    picture_control_set_ptr);
+            else
                 av1_cdef_frame(
-                    0,//context_ptr,
+                    0,
                     sequence_control_set_ptr,
-                    picture_control_set_ptr
-                );
-            }
-#endif
+                    picture_control_set_ptr);
+#else
+
+        if (is16bit) {
+            av1_cdef_search16bit(
+                0,//context_ptr,
+                sequence_control_set_ptr,
+                picture_control_set_ptr
+            );
+
+            av1_cdef_frame16bit(
+                0,//context_ptr,
+                sequence_control_set_ptr,
+                picture_control_set_ptr
+            );
         }
         else {
+            av1_cdef_search(
+                0,//context_ptr,
+                sequence_control_set_ptr,
+                picture_control_set_ptr
+            );
+
+            av1_cdef_frame(
+                0,//context_ptr,
+                sequence_control_set_ptr,
+                picture_control_set_ptr
+            );
+        }
+#endif
+    }
+    else {
 
 #if CDEF_REF_ONLY
-            picture_control_set_ptr->parent_pcs_ptr->cdef_bits = 0;
-            picture_control_set_ptr->parent_pcs_ptr->cdef_strengths[0] = 0;
-            picture_control_set_ptr->parent_pcs_ptr->nb_cdef_strengths = 1;
-            picture_control_set_ptr->parent_pcs_ptr->cdef_uv_strengths[0] = 0;
+        picture_control_set_ptr->parent_pcs_ptr->cdef_bits = 0;
+        picture_control_set_ptr->parent_pcs_ptr->cdef_strengths[0] = 0;
+        picture_control_set_ptr->parent_pcs_ptr->nb_cdef_strengths = 1;
+        picture_control_set_ptr->parent_pcs_ptr->cdef_uv_strengths[0] = 0;
 #else
-            picture_control_set_ptr->parent_pcs_ptr->cdef_bits = 0;
+        picture_control_set_ptr->parent_pcs_ptr->cdef_bits = 0;
 
-            picture_control_set_ptr->parent_pcs_ptr->nb_cdef_strengths = 0;
+        picture_control_set_ptr->parent_pcs_ptr->nb_cdef_strengths = 0;
 #endif
 
 
-        }
+    }
 
 #if REST_M
 
-        //restoration prep
+    //restoration prep
 
-        if (sequence_control_set_ptr->enable_restoration)
-        {
-            av1_loop_restoration_save_boundary_lines(
-                cm->frame_to_show,
-                cm,
-                1);
+    if (sequence_control_set_ptr->enable_restoration)
+    {
+        av1_loop_restoration_save_boundary_lines(
+            cm->frame_to_show,
+            cm,
+            1);
 
-            //are these still needed here?/!!!
-            extend_frame(cm->frame_to_show->buffers[0], cm->frame_to_show->crop_widths[0], cm->frame_to_show->crop_heights[0],
-                cm->frame_to_show->strides[0], RESTORATION_BORDER, RESTORATION_BORDER, is16bit);
-            extend_frame(cm->frame_to_show->buffers[1], cm->frame_to_show->crop_widths[1], cm->frame_to_show->crop_heights[1],
-                cm->frame_to_show->strides[1], RESTORATION_BORDER, RESTORATION_BORDER, is16bit);
-            extend_frame(cm->frame_to_show->buffers[2], cm->frame_to_show->crop_widths[1], cm->frame_to_show->crop_heights[1],
-                cm->frame_to_show->strides[1], RESTORATION_BORDER, RESTORATION_BORDER, is16bit);
-
-        }
+        //are these still needed here?/!!!
+        extend_frame(cm->frame_to_show->buffers[0], cm->frame_to_show->crop_widths[0], cm->frame_to_show->crop_heights[0],
+            cm->frame_to_show->strides[0], RESTORATION_BORDER, RESTORATION_BORDER, is16bit);
+        extend_frame(cm->frame_to_show->buffers[1], cm->frame_to_show->crop_widths[1], cm->frame_to_show->crop_heights[1],
+            cm->frame_to_show->strides[1], RESTORATION_BORDER, RESTORATION_BORDER, is16bit);
+        extend_frame(cm->frame_to_show->buffers[2], cm->frame_to_show->crop_widths[1], cm->frame_to_show->crop_heights[1],
+            cm->frame_to_show->strides[1], RESTORATION_BORDER, RESTORATION_BORDER, is16bit);
 
+    }
 
 
-        picture_control_set_ptr->rest_segments_column_count = sequence_control_set_ptr->rest_segment_column_count;
-        picture_control_set_ptr->rest_segments_row_count =   sequence_control_set_ptr->rest_segment_row_count;
-        picture_control_set_ptr->rest_segments_total_count = (uint16_t)(picture_control_set_ptr->rest_segments_column_count  * picture_control_set_ptr->rest_segments_row_count);
-        picture_control_set_ptr->tot_seg_searched_rest = 0;
-        uint32_t segment_index;
-        for (segment_index = 0; segment_index < picture_control_set_ptr->rest_segments_total_count; ++segment_index)
-        {
-            // Get Empty Cdef Results to Rest
-            eb_get_empty_object(
-                context_ptr->cdef_output_fifo_ptr,
-                &cdef_results_wrapper_ptr);
-            cdef_results_ptr = (struct CdefResults_s*)cdef_results_wrapper_ptr->object_ptr;
-            cdef_results_ptr->picture_control_set_wrapper_ptr = dlf_results_ptr->picture_control_set_wrapper_ptr;
-            cdef_results_ptr->segment_index = segment_index;
-            // Post Cdef Results
-            eb_post_full_object(cdef_results_wrapper_ptr);
-
-        }
-#else
-
 
+    picture_control_set_ptr->rest_segments_column_count = sequence_control_set_ptr->rest_segment_column_count;
+    picture_control_set_ptr->rest_segments_row_count =   sequence_control_set_ptr->rest_segment_row_count;
+    picture_control_set_ptr->rest_segments_total_count = (uint16_t)(picture_control_set_ptr->rest_segments_column_count  * picture_control_set_ptr->rest_segments_row_count);
+    picture_control_set_ptr->tot_seg_searched_rest = 0;
+    uint32_t segment_index;
+    for (segment_index = 0; segment_index < picture_control_set_ptr->rest_segments_total_count; ++segment_index)
+    {
         // Get Empty Cdef Results to Rest
         eb_get_empty_object(
             context_ptr->cdef_output_fifo_ptr,
-            &cdefResultsWrapperPtr);
-        cdef_results_ptr = (struct CdefResults_s*)cdefResultsWrapperPtr->object_ptr;
-        cdef_results_ptr->pictureControlSetWrapperPtr = dlf_results_ptr->pictureControlSetWrapperPtr;
-        cdef_results_ptr->completedLcuRowIndexStart = 0;
-        cdef_results_ptr->completedLcuRowCount =  ((sequence_control_set_ptr->luma_height + sequence_control_set_ptr->sb_size_pix - 1) >> lcuSizeLog2);
+            &cdef_results_wrapper_ptr);
+        cdef_results_ptr = (struct CdefResults_s*)cdef_results_wrapper_ptr->object_ptr;
+        cdef_results_ptr->picture_control_set_wrapper_ptr = dlf_results_ptr->picture_control_set_wrapper_ptr;
+        cdef_results_ptr->segment_index = segment_index;
         // Post Cdef Results
-        eb_post_full_object(cdefResultsWrapperPtr);
+        eb_post_full_object(cdef_results_wrapper_ptr);
+
+    }
+#else
+
+
+    // Get Empty Cdef Results to Rest
+    eb_get_empty_object(
+        context_ptr->cdef_output_fifo_ptr,
+        &cdefResultsWrapperPtr);
+    cdef_results_ptr = (struct CdefResults_s*)cdefResultsWrapperPtr->object_ptr;
+    cdef_results_ptr->pictureControlSetWrapperPtr = dlf_results_ptr->pictureControlSetWrapperPtr;
+    cdef_results_ptr->completedLcuRowIndexStart = 0;
+    cdef_results_ptr->completedLcuRowCount =  ((sequence_control_set_ptr->luma_height + sequence_control_set_ptr->sb_size_pix - 1) >> lcuSizeLog2);
+    // Post Cdef Results
+    eb_post_full_object(cdefResultsWrapperPtr);
 #endif
 
 #if CDEF_M
-        }
-        eb_release_mutex(picture_control_set_ptr->cdef_search_mutex);
+    }
+    eb_release_mutex(picture_control_set_ptr->cdef_search_mutex);
 #endif
 
-        // Release Dlf Results
-        eb_release_object(dlf_results_wrapper_ptr);
+    // Release Dlf Results
+    eb_release_object(dlf_results_wrapper_ptr);
+}
+
+/******************************************************
+ * CDEF Kernel
+ ******************************************************/
+void* cdef_kernel(void *input_ptr)
+{
+    CdefContext_t *context_ptr = (CdefContext_t*)input_ptr;
+    EbObjectWrapper_t *dlf_results_wrapper_ptr;
+
+    for (;;) {
+
+        // Get DLF Results
+        eb_get_full_object(
+            context_ptr->cdef_input_fifo_ptr,
+            &dlf_results_wrapper_ptr);
 
+        cdef_kernel_task(
+            context_ptr,
+            dlf_results_wrapper_ptr);
     }
 
     return EB_NULL;
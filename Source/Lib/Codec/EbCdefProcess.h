@@ -38,4 +38,8 @@ extern EbErrorType cdef_context_ctor(
 
 extern void* cdef_kernel(void *input_ptr);
 
+extern void cdef_kernel_task(
+    EbPtr                                    input_ptr,
+    EbObjectWrapper_t                       *dlf_results_wrapper_ptr);
+
 #endif
\ No newline at end of file
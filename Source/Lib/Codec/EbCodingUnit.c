@@ -18,8 +18,34 @@ Tasks & Questions
     -Need a ReconPicture for each candidate.
     -I don't see a way around doing the copies in temp memory and then copying it in...
 */
+/*
+Allocates the storage of sb_count SBs, one block per array instead of one
+per SB and per coding unit.
+*/
+EbErrorType largest_coding_unit_arena_ctor(
+    LargestCodingUnitArena_t    *arena_ptr,
+    uint8_t                        sb_size_pix,
+    uint32_t                       sb_count)
+{
+#if MEM_RED4
+    arena_ptr->cu_count_per_sb = sb_size_pix == 128 ? 1024 : 256;
+#else
+    arena_ptr->cu_count_per_sb = 1024;
+#endif
+    arena_ptr->block_count_per_sb = sb_size_pix == 128 ? BLOCK_MAX_COUNT_SB_128 : BLOCK_MAX_COUNT_SB_64;
+    arena_ptr->sb_count = sb_count;
+
+    EB_MALLOC(LargestCodingUnit_t*, arena_ptr->sb_array, sizeof(LargestCodingUnit_t) * sb_count, EB_N_PTR);
+    EB_MALLOC(CodingUnit_t*, arena_ptr->cu_array, sizeof(CodingUnit_t) * arena_ptr->cu_count_per_sb * sb_count, EB_N_PTR);
+    EB_MALLOC(MacroBlockD*, arena_ptr->av1xd_array, sizeof(MacroBlockD) * arena_ptr->cu_count_per_sb * sb_count, EB_N_PTR);
+    EB_MALLOC(PartitionType*, arena_ptr->partition_array, sizeof(PartitionType) * arena_ptr->block_count_per_sb * sb_count, EB_N_PTR);
+
+    return EB_ErrorNone;
+}
+
 EbErrorType largest_coding_unit_ctor(
     LargestCodingUnit_t        **larget_coding_unit_dbl_ptr,
+    LargestCodingUnitArena_t    *arena_ptr,
     uint8_t                        sb_size_pix,
     uint16_t                       sb_origin_x,
     uint16_t                       sb_origin_y,
@@ -31,8 +57,8 @@ EbErrorType largest_coding_unit_ctor(
     uint32_t tu_index;
     EbPictureBufferDescInitData_t coeffInitData;
 
-    LargestCodingUnit_t *largestCodingUnitPtr;
-    EB_MALLOC(LargestCodingUnit_t*, largestCodingUnitPtr, sizeof(LargestCodingUnit_t), EB_N_PTR);
+    LargestCodingUnit_t *largestCodingUnitPtr = &arena_ptr->sb_array[sb_index];
+    (void)sb_size_pix;
 
     *larget_coding_unit_dbl_ptr = largestCodingUnitPtr;
 
@@ -48,13 +74,10 @@ EbErrorType largest_coding_unit_ctor(
     largestCodingUnitPtr->index = sb_index;
 
     uint32_t cu_i;
-#if MEM_RED4
-    uint32_t  tot_cu_num = sb_size_pix == 128 ? 1024 : 256;
-#else
-    uint32_t  tot_cu_num = 1024;
-#endif
+    uint32_t  tot_cu_num = arena_ptr->cu_count_per_sb;
+    MacroBlockD *av1xd_array = &arena_ptr->av1xd_array[sb_index * tot_cu_num];
 
-    EB_MALLOC(CodingUnit_t*, largestCodingUnitPtr->final_cu_arr, sizeof(CodingUnit_t) * tot_cu_num, EB_N_PTR);
+    largestCodingUnitPtr->final_cu_arr = &arena_ptr->cu_array[sb_index * tot_cu_num];
 
     for (cu_i = 0; cu_i < tot_cu_num; ++cu_i) {
 
@@ -64,12 +87,10 @@ EbErrorType largest_coding_unit_ctor(
 
         largestCodingUnitPtr->final_cu_arr[cu_i].leaf_index = cu_i;
 
-        EB_MALLOC(MacroBlockD*, largestCodingUnitPtr->final_cu_arr[cu_i].av1xd, sizeof(MacroBlockD), EB_N_PTR);
+        largestCodingUnitPtr->final_cu_arr[cu_i].av1xd = &av1xd_array[cu_i];
     }
 
-    uint32_t  max_block_count = sb_size_pix == 128 ? BLOCK_MAX_COUNT_SB_128 : BLOCK_MAX_COUNT_SB_64; 
-
-    EB_MALLOC(PartitionType*, largestCodingUnitPtr->cu_partition_array, sizeof(PartitionType) * max_block_count, EB_N_PTR);
+    largestCodingUnitPtr->cu_partition_array = &arena_ptr->partition_array[sb_index * arena_ptr->block_count_per_sb];
 
     coeffInitData.bufferEnableMask = PICTURE_BUFFER_DESC_FULL_MASK;
     coeffInitData.maxWidth = SB_STRIDE_Y;
@@ -376,8 +376,32 @@ extern "C" {
 
     } LargestCodingUnit_t;
 
+    /**************************************
+     * SB Arena
+     *   Storage of the SBs of a picture control set. Each array is one
+     *   allocation shared by all the SBs, which take consecutive slices
+     *   of it in sb_index order. The MacroBlockD of the coding units are
+     *   kept in their own array rather than inside CodingUnit_t so the
+     *   coding units of a SB stay densely packed.
+     **************************************/
+    typedef struct LargestCodingUnitArena_s {
+        LargestCodingUnit_t           *sb_array;
+        CodingUnit_t                  *cu_array;
+        MacroBlockD                   *av1xd_array;
+        PartitionType                 *partition_array;
+        uint32_t                       sb_count;
+        uint32_t                       cu_count_per_sb;
+        uint32_t                       block_count_per_sb;
+    } LargestCodingUnitArena_t;
+
+    extern EbErrorType largest_coding_unit_arena_ctor(
+        LargestCodingUnitArena_t      *arena_ptr,
+        uint8_t                        sb_sz,
+        uint32_t                       sb_count);
+
     extern EbErrorType largest_coding_unit_ctor(
         LargestCodingUnit_t          **larget_coding_unit_dbl_ptr,
+        LargestCodingUnitArena_t      *arena_ptr,
         uint8_t                        sb_sz,
         uint16_t                       sb_origin_x,
         uint16_t                       sb_origin_y,
@@ -26,12 +26,16 @@ extern "C" {
             // NON_AVX2
             compute_mean8x8_sse2_intrin,
             // AVX2
+            compute_mean8x8_avx2_intrin,
+            // AVX512
             compute_mean8x8_avx2_intrin
         },
         {
             // NON_AVX2
             compute_mean_of_squared_values8x8_sse2_intrin,
             // AVX2
+            compute_mean_of_squared_values8x8_sse2_intrin,
+            // AVX512
             compute_mean_of_squared_values8x8_sse2_intrin
         }
     };
@@ -13,6 +13,7 @@
 #include "EbComputeSAD_SSE2.h"
 #include "EbComputeSAD_SSE4_1.h"
 #include "EbComputeSAD_AVX2.h"
+#include "EbComputeSAD_AVX512.h"
 #if M0_SSD_HALF_QUARTER_PEL_BIPRED_SEARCH
 #include "EbUtility.h"
 #endif
@@ -32,7 +33,22 @@ extern "C" {
         uint32_t  height,
         uint32_t  width);
 
-    static void NxMSadKernelVoidFunc() {}
+    // Sizes not supported in asm, typed as the table they fill
+    static uint32_t NxMSadKernelVoidFunc(
+        uint8_t  *src,
+        uint32_t  src_stride,
+        uint8_t  *ref,
+        uint32_t  ref_stride,
+        uint32_t  height,
+        uint32_t  width) {
+        (void)src;
+        (void)src_stride;
+        (void)ref;
+        (void)ref_stride;
+        (void)height;
+        (void)width;
+        return 0;
+    }
 
     typedef void(*EB_SADLOOPKERNELNxM_TYPE)(
         uint8_t  *src,                            // input parameter, source samples Ptr
@@ -58,6 +74,26 @@ extern "C" {
         uint32_t  height,
         uint32_t  width);
 
+    static uint32_t NxMSadAveragingKernelVoidFunc(
+        uint8_t  *src,
+        uint32_t  src_stride,
+        uint8_t  *ref1,
+        uint32_t  ref1_stride,
+        uint8_t  *ref2,
+        uint32_t  ref2_stride,
+        uint32_t  height,
+        uint32_t  width) {
+        (void)src;
+        (void)src_stride;
+        (void)ref1;
+        (void)ref1_stride;
+        (void)ref2;
+        (void)ref2_stride;
+        (void)height;
+        (void)width;
+        return 0;
+    }
+
     typedef uint32_t(*EB_COMPUTE8X4SAD_TYPE)(
         uint8_t  *src,                            // input parameter, source samples Ptr
         uint32_t  src_stride,                      // input parameter, source stride
@@ -132,6 +168,19 @@ extern "C" {
             /*8 64xM */ compute64x_m_sad_avx2_intrin,
             0,0,0,0,0,0,0,fast_loop_nx_m_sad_kernel
         },
+        // AVX512
+        {
+            /*0 4xM  */ Compute4xMSadSub_AVX2_INTRIN,
+            /*1 8xM  */ compute8x_m_sad_avx2_intrin,
+            /*2 16xM */ compute16x_m_sad_avx2_intrin,
+            /*3 24xM */ fast_loop_nx_m_sad_kernel,
+            /*4 32xM */ compute32x_m_sad_avx2_intrin,
+            /*5      */ 0,
+            /*6 48xM */ fast_loop_nx_m_sad_kernel,
+            /*7      */ 0,
+            /*8 64xM */ compute64x_m_sad_avx2_intrin,
+            0,0,0,0,0,0,0,fast_loop_nx_m_sad_kernel
+        },
     };
     static EB_SADKERNELNxM_TYPE FUNC_TABLE NxMSadKernel_funcPtrArray[ASM_TYPE_TOTAL][9] =   // [ASMTYPE][SAD - block height]
     {
@@ -154,9 +203,21 @@ extern "C" {
             /*2 16xM */ compute16x_m_sad_avx2_intrin,//compute16x_m_sad_avx2_intrin is slower than the SSE2 version
             /*3 24xM */ compute24x_m_sad_avx2_intrin,
             /*4 32xM */ compute32x_m_sad_avx2_intrin,
-            /*5      */ (EB_SADKERNELNxM_TYPE)NxMSadKernelVoidFunc,
+            /*5      */ NxMSadKernelVoidFunc,
+            /*6 48xM */ compute48x_m_sad_avx2_intrin,
+            /*7      */ NxMSadKernelVoidFunc,
+            /*8 64xM */ compute64x_m_sad_avx2_intrin,
+        },
+        // AVX512
+        {
+            /*0 4xM  */ compute4x_m_sad_avx2_intrin,
+            /*1 8xM  */ compute8x_m_sad_avx2_intrin,
+            /*2 16xM */ compute16x_m_sad_avx2_intrin,//compute16x_m_sad_avx2_intrin is slower than the SSE2 version
+            /*3 24xM */ compute24x_m_sad_avx2_intrin,
+            /*4 32xM */ compute32x_m_sad_avx2_intrin,
+            /*5      */ NxMSadKernelVoidFunc,
             /*6 48xM */ compute48x_m_sad_avx2_intrin,
-            /*7      */ (EB_SADKERNELNxM_TYPE)NxMSadKernelVoidFunc,
+            /*7      */ NxMSadKernelVoidFunc,
             /*8 64xM */ compute64x_m_sad_avx2_intrin,
         },
     };
@@ -170,9 +231,9 @@ extern "C" {
             /*2 16xM */     combined_averaging_sad,
             /*3 24xM */     combined_averaging_sad,
             /*4 32xM */     combined_averaging_sad,
-            /*5      */     (EB_SADAVGKERNELNxM_TYPE)NxMSadKernelVoidFunc,
+            /*5      */     NxMSadAveragingKernelVoidFunc,
             /*6 48xM */     combined_averaging_sad,
-            /*7      */     (EB_SADAVGKERNELNxM_TYPE)NxMSadKernelVoidFunc,
+            /*7      */     NxMSadAveragingKernelVoidFunc,
             /*8 64xM */     combined_averaging_sad
         },
         // AVX2
@@ -182,9 +243,21 @@ extern "C" {
             /*2 16xM */     combined_averaging16x_msad_avx2_intrin,
             /*3 24xM */     combined_averaging24x_msad_avx2_intrin,
             /*4 32xM */     combined_averaging32x_msad_avx2_intrin,
-            /*5      */     (EB_SADAVGKERNELNxM_TYPE)NxMSadKernelVoidFunc,
+            /*5      */     NxMSadAveragingKernelVoidFunc,
             /*6 48xM */     combined_averaging48x_msad_avx2_intrin,
-            /*7      */     (EB_SADAVGKERNELNxM_TYPE)NxMSadKernelVoidFunc,
+            /*7      */     NxMSadAveragingKernelVoidFunc,
+            /*8 64xM */     combined_averaging64x_msad_avx2_intrin
+        },
+        // AVX512
+        {
+            /*0 4xM  */     CombinedAveraging4xMSAD_SSE2_INTRIN,
+            /*1 8xM  */     combined_averaging8x_msad_avx2_intrin,
+            /*2 16xM */     combined_averaging16x_msad_avx2_intrin,
+            /*3 24xM */     combined_averaging24x_msad_avx2_intrin,
+            /*4 32xM */     combined_averaging32x_msad_avx2_intrin,
+            /*5      */     NxMSadAveragingKernelVoidFunc,
+            /*6 48xM */     combined_averaging48x_msad_avx2_intrin,
+            /*7      */     NxMSadAveragingKernelVoidFunc,
             /*8 64xM */     combined_averaging64x_msad_avx2_intrin
         },
     };
@@ -195,6 +268,8 @@ extern "C" {
         sad_loop_kernel_sparse_sse4_1_intrin,
         // AVX2
         sad_loop_kernel_sparse_avx2_intrin,
+        // AVX512
+        sad_loop_kernel_sparse_avx2_intrin,
     };
 
 
@@ -204,6 +279,8 @@ extern "C" {
         sad_loop_kernel_sse4_1_intrin,
         // AVX2
         sad_loop_kernel_avx2_intrin,
+        // AVX512
+        sad_loop_kernel_avx512_intrin,
     };
 
     static EB_GETEIGHTSAD8x8 FUNC_TABLE GetEightHorizontalSearchPointResults_8x8_16x16_funcPtrArray[ASM_TYPE_TOTAL] =
@@ -212,6 +289,8 @@ extern "C" {
         get_eight_horizontal_search_point_results_8x8_16x16_pu_sse41_intrin,
         // AVX2
         get_eight_horizontal_search_point_results_8x8_16x16_pu_avx2_intrin,
+        // AVX512
+        get_eight_horizontal_search_point_results_8x8_16x16_pu_avx2_intrin,
     };
 
     static EB_GETEIGHTSAD32x32 FUNC_TABLE GetEightHorizontalSearchPointResults_32x32_64x64_funcPtrArray[ASM_TYPE_TOTAL] =
@@ -220,6 +299,8 @@ extern "C" {
         get_eight_horizontal_search_point_results_32x32_64x64_pu_sse41_intrin,
         // AVX2
         get_eight_horizontal_search_point_results_32x32_64x64_pu_avx2_intrin,
+        // AVX512
+        get_eight_horizontal_search_point_results_32x32_64x64_pu_avx2_intrin,
     };
 
     uint32_t combined_averaging_ssd_c(
@@ -238,6 +319,8 @@ extern "C" {
         combined_averaging_ssd_c,
         // AVX2
         combined_averaging_ssd_avx2,
+        // AVX512
+        combined_averaging_ssd_avx2,
     };
 
 #ifdef __cplusplus
@@ -23,6 +23,7 @@
 #include "EbSequenceControlSet.h"
 #include "EbReferenceObject.h"
 #include "EbDeblockingFilter.h"
+#include "EbThreads.h"
 
 #define   convertToChromaQp(iQpY)  ( ((iQpY) < 0) ? (iQpY) : (((iQpY) > 57) ? ((iQpY)-6) : (int32_t)(map_chroma_qp((uint32_t)iQpY))) )
 
@@ -1348,14 +1349,72 @@ void loop_filter_sb(
     }
 }
 
-void av1_loop_filter_frame(
+// Count of SBs the row above must be ahead by: the horizontal edges of an SB
+// row modify the bottom of the row above, which must not be filtered anymore
+#define LPF_SB_ROW_SYNC_LAG 2
+
+/*************************************************
+ * Wait for the filtering of an SB row to reach
+ *   required SBs. A task blocked on a row is recorded
+ *   with its semaphore, posted by the task of the row
+ *   once it is far enough.
+ *************************************************/
+static void LpfWaitSbRow(
+    PictureControlSet_t   *picture_control_set_ptr,
+    uint32_t               sb_row,
+    int32_t                required,
+    EbHandle               row_semaphore) {
+
+    EbBool blocked = EB_FALSE;
+
+    if (EB_ATOMIC_LOAD(&picture_control_set_ptr->dlf_sb_row_progress[sb_row]) >= required)
+        return;
+
+    eb_block_on_mutex(picture_control_set_ptr->dlf_mutex);
+    if (picture_control_set_ptr->dlf_sb_row_progress[sb_row] < required) {
+        picture_control_set_ptr->dlf_sb_row_wait_count[sb_row] = required;
+        picture_control_set_ptr->dlf_sb_row_waiter[sb_row] = row_semaphore;
+        blocked = EB_TRUE;
+    }
+    eb_release_mutex(picture_control_set_ptr->dlf_mutex);
+
+    if (blocked)
+        eb_block_on_semaphore(row_semaphore);
+}
+
+/*************************************************
+ * Publish the progress of an SB row, waking up the
+ *   task blocked on it when it is far enough
+ *************************************************/
+static void LpfPostSbRow(
+    PictureControlSet_t   *picture_control_set_ptr,
+    uint32_t               sb_row,
+    int32_t                progress) {
+
+    EbHandle waiter = (EbHandle)EB_NULL;
+
+    eb_block_on_mutex(picture_control_set_ptr->dlf_mutex);
+    EB_ATOMIC_STORE(&picture_control_set_ptr->dlf_sb_row_progress[sb_row], progress);
+    if (picture_control_set_ptr->dlf_sb_row_waiter[sb_row] && progress >= picture_control_set_ptr->dlf_sb_row_wait_count[sb_row]) {
+        waiter = picture_control_set_ptr->dlf_sb_row_waiter[sb_row];
+        picture_control_set_ptr->dlf_sb_row_waiter[sb_row] = (EbHandle)EB_NULL;
+    }
+    eb_release_mutex(picture_control_set_ptr->dlf_mutex);
+
+    if (waiter)
+        eb_post_semaphore(waiter);
+}
+
+void av1_loop_filter_sb_rows(
     EbPictureBufferDesc_t *frame_buffer,
-    PictureControlSet_t *picture_control_set_ptr,
-    int32_t plane_start, int32_t plane_end) {
+    PictureControlSet_t   *picture_control_set_ptr,
+    int32_t                plane_start,
+    int32_t                plane_end,
+    uint32_t               sb_row_start,
+    uint32_t               sb_row_end,
+    EbHandle               row_semaphore) {
 
     SequenceControlSet_t *scsPtr = (SequenceControlSet_t*)picture_control_set_ptr->parent_pcs_ptr->sequence_control_set_wrapper_ptr->object_ptr;
-    //LargestCodingUnit_t                     *sb_ptr;
-    //uint16_t                                   sb_index;
     uint8_t                                   sb_size_Log2 = (uint8_t)Log2f(scsPtr->sb_size_pix);
     uint32_t                                   xLcuIndex;
     uint32_t                                   yLcuIndex;
@@ -1364,17 +1423,20 @@ void av1_loop_filter_frame(
     EbBool                                  endOfRowFlag;
 
     uint32_t picture_width_in_sb = (scsPtr->luma_width + scsPtr->sb_size_pix - 1) / scsPtr->sb_size_pix;
-    uint32_t picture_height_in_sb = (scsPtr->luma_height + scsPtr->sb_size_pix - 1) / scsPtr->sb_size_pix;
-    av1_loop_filter_frame_init(picture_control_set_ptr, plane_start, plane_end);
 
-    for (yLcuIndex = 0; yLcuIndex < picture_height_in_sb; ++yLcuIndex) {
+    for (yLcuIndex = sb_row_start; yLcuIndex < sb_row_end; ++yLcuIndex) {
         for (xLcuIndex = 0; xLcuIndex < picture_width_in_sb; ++xLcuIndex) {
-            //sb_index        = (uint16_t)(yLcuIndex * picture_width_in_sb + xLcuIndex);
-            //sb_ptr          = picture_control_set_ptr->sb_ptr_array[sb_index];
             sb_origin_x = xLcuIndex << sb_size_Log2;
             sb_origin_y = yLcuIndex << sb_size_Log2;
             endOfRowFlag = (xLcuIndex == picture_width_in_sb - 1) ? EB_TRUE : EB_FALSE;
 
+            if (row_semaphore && yLcuIndex > 0)
+                LpfWaitSbRow(
+                    picture_control_set_ptr,
+                    yLcuIndex - 1,
+                    (int32_t)MIN(xLcuIndex + 1 + LPF_SB_ROW_SYNC_LAG, picture_width_in_sb),
+                    row_semaphore);
+
             loop_filter_sb(
                 frame_buffer,
                 picture_control_set_ptr,
@@ -1384,12 +1446,77 @@ void av1_loop_filter_frame(
                 plane_start,
                 plane_end,
                 endOfRowFlag);
+
+            if (row_semaphore)
+                LpfPostSbRow(
+                    picture_control_set_ptr,
+                    yLcuIndex,
+                    (int32_t)(xLcuIndex + 1));
         }
     }
+}
 
+void av1_loop_filter_frame(
+    EbPictureBufferDesc_t *frame_buffer,
+    PictureControlSet_t *picture_control_set_ptr,
+    int32_t plane_start, int32_t plane_end) {
+
+    SequenceControlSet_t *scsPtr = (SequenceControlSet_t*)picture_control_set_ptr->parent_pcs_ptr->sequence_control_set_wrapper_ptr->object_ptr;
+    uint32_t picture_height_in_sb = (scsPtr->luma_height + scsPtr->sb_size_pix - 1) / scsPtr->sb_size_pix;
+
+    av1_loop_filter_frame_init(picture_control_set_ptr, plane_start, plane_end);
+
+    av1_loop_filter_sb_rows(
+        frame_buffer,
+        picture_control_set_ptr,
+        plane_start,
+        plane_end,
+        0,
+        picture_height_in_sb,
+        NULL);
 }
 extern int16_t av1_ac_quant_Q3(int32_t qindex, int32_t delta, aom_bit_depth_t bit_depth);
 
+/*************************************************
+ * Filter level search rows
+ *   The level search filters one SB row every
+ *   LPF_SEARCH_SB_ROW_STEP rows instead of the whole
+ *   picture. Along with a sampled row, the
+ *   LPF_SEARCH_MARGIN rows above it are saved and
+ *   restored, since its top horizontal edge
+ *   modifies them.
+ *************************************************/
+#define LPF_SEARCH_SB_ROW_STEP  4
+#define LPF_SEARCH_MARGIN       8
+
+static INLINE EbBool lpf_search_sb_row(
+    uint32_t sb_row,
+    uint32_t picture_height_in_sb) {
+    return (picture_height_in_sb <= LPF_SEARCH_SB_ROW_STEP || sb_row % LPF_SEARCH_SB_ROW_STEP == LPF_SEARCH_SB_ROW_STEP / 2) ? EB_TRUE : EB_FALSE;
+}
+
+// row and sb_size in samples of the plane
+static INLINE EbBool lpf_search_row(
+    uint32_t row,
+    uint32_t sb_size,
+    uint32_t picture_height_in_sb) {
+    return lpf_search_sb_row(row / sb_size, picture_height_in_sb);
+}
+
+static INLINE EbBool lpf_search_saved_row(
+    uint32_t row,
+    uint32_t height,
+    uint32_t sb_size,
+    uint32_t picture_height_in_sb) {
+    return (lpf_search_row(row, sb_size, picture_height_in_sb) ||
+        (row + LPF_SEARCH_MARGIN < height && lpf_search_row(row + LPF_SEARCH_MARGIN, sb_size, picture_height_in_sb))) ? EB_TRUE : EB_FALSE;
+}
+
+/*************************************************
+ * EbCopyBuffer
+ *   Copies the rows of a plane the filter level
+ *   search modifies, see lpf_search_saved_row.
+ *************************************************/
 void EbCopyBuffer(
     EbPictureBufferDesc_t  *srcBuffer,
     EbPictureBufferDesc_t  *dstBuffer,
@@ -1412,6 +1539,8 @@ void EbCopyBuffer(
     uint16_t   luma_width = (uint16_t)(srcBuffer->width - pcsPtr->parent_pcs_ptr->sequence_control_set_ptr->pad_right) << is16bit;
     uint16_t   luma_height = (uint16_t)(srcBuffer->height - pcsPtr->parent_pcs_ptr->sequence_control_set_ptr->pad_bottom);
     uint16_t   chroma_width = (luma_width >> 1);
+    uint32_t   sb_size = pcsPtr->parent_pcs_ptr->sequence_control_set_ptr->sb_size_pix;
+    uint32_t   picture_height_in_sb = (luma_height + sb_size - 1) / sb_size;
     if (plane == 0) {
 #if LF_10BIT_FIX
         uint16_t stride_y = srcBuffer->stride_y << is16bit;
@@ -1420,6 +1549,8 @@ void EbCopyBuffer(
         dstBuffer->strideBitIncY = srcBuffer->strideBitIncY;
 
         for (int32_t inputRowIndex = 0; inputRowIndex < luma_height; inputRowIndex++) {
+            if (!lpf_search_saved_row(inputRowIndex, luma_height, sb_size, picture_height_in_sb))
+                continue;
 #if LF_10BIT_FIX
             EB_MEMCPY((dstBuffer->buffer_y + lumaBufferOffset + stride_y * inputRowIndex),
                 (srcBuffer->buffer_y + lumaBufferOffset + stride_y * inputRowIndex),
@@ -1442,6 +1573,8 @@ void EbCopyBuffer(
         uint32_t   chromaBufferOffset = (srcBuffer->origin_x / 2 + srcBuffer->origin_y / 2 * srcBuffer->strideCb) << is16bit;
 
         for (int32_t inputRowIndex = 0; inputRowIndex < luma_height >> 1; inputRowIndex++) {
+            if (!lpf_search_saved_row(inputRowIndex, luma_height >> 1, sb_size >> 1, picture_height_in_sb))
+                continue;
 #if LF_10BIT_FIX
             EB_MEMCPY((dstBuffer->bufferCb + chromaBufferOffset + strideCb * inputRowIndex),
                 (srcBuffer->bufferCb + chromaBufferOffset + strideCb * inputRowIndex),
@@ -1463,6 +1596,8 @@ void EbCopyBuffer(
         uint32_t   chromaBufferOffset = (srcBuffer->origin_x / 2 + srcBuffer->origin_y / 2 * srcBuffer->strideCr) << is16bit;
 
         for (int32_t inputRowIndex = 0; inputRowIndex < luma_height >> 1; inputRowIndex++) {
+            if (!lpf_search_saved_row(inputRowIndex, luma_height >> 1, sb_size >> 1, picture_height_in_sb))
+                continue;
 #if LF_10BIT_FIX
             EB_MEMCPY((dstBuffer->bufferCr + chromaBufferOffset + strideCr * inputRowIndex),
                 (srcBuffer->bufferCr + chromaBufferOffset + strideCr * inputRowIndex),
@@ -1494,6 +1629,11 @@ void EbCopyBuffer(
 //    }
 //}
 
+/*************************************************
+ * PictureSseCalculations
+ *   SSE of a plane over the SB rows the filter level
+ *   search filters, see lpf_search_sb_row.
+ *************************************************/
 uint64_t PictureSseCalculations(
     PictureControlSet_t    *picture_control_set_ptr,
     EbPictureBufferDesc_t *recon_ptr,
@@ -1502,6 +1642,8 @@ uint64_t PictureSseCalculations(
 {
     SequenceControlSet_t   *sequence_control_set_ptr = picture_control_set_ptr->parent_pcs_ptr->sequence_control_set_ptr;
     EbBool is16bit = (sequence_control_set_ptr->static_config.encoder_bit_depth > EB_8BIT);
+    uint32_t sb_size = sequence_control_set_ptr->sb_size_pix;
+    uint32_t picture_height_in_sb = (sequence_control_set_ptr->luma_height + sb_size - 1) / sb_size;
 
     if (!is16bit) {
 
@@ -1520,7 +1662,7 @@ uint64_t PictureSseCalculations(
 
             while (row_index < sequence_control_set_ptr->luma_height) {
 
-                columnIndex = 0;
+                columnIndex = lpf_search_row(row_index, sb_size, picture_height_in_sb) ? 0 : sequence_control_set_ptr->luma_width;
                 while (columnIndex < sequence_control_set_ptr->luma_width) {
                     residualDistortion += (int64_t)SQR((int64_t)(inputBuffer[columnIndex]) - (reconCoeffBuffer[columnIndex]));
                     ++columnIndex;
@@ -1542,7 +1684,7 @@ uint64_t PictureSseCalculations(
             row_index = 0;
             while (row_index < sequence_control_set_ptr->chroma_height) {
 
-                columnIndex = 0;
+                columnIndex = lpf_search_row(row_index, sb_size >> 1, picture_height_in_sb) ? 0 : sequence_control_set_ptr->chroma_width;
                 while (columnIndex < sequence_control_set_ptr->chroma_width) {
                     residualDistortion += (int64_t)SQR((int64_t)(inputBuffer[columnIndex]) - (reconCoeffBuffer[columnIndex]));
                     ++columnIndex;
@@ -1563,7 +1705,7 @@ uint64_t PictureSseCalculations(
 
             while (row_index < sequence_control_set_ptr->chroma_height) {
 
-                columnIndex = 0;
+                columnIndex = lpf_search_row(row_index, sb_size >> 1, picture_height_in_sb) ? 0 : sequence_control_set_ptr->chroma_width;
                 while (columnIndex < sequence_control_set_ptr->chroma_width) {
                     residualDistortion += (int64_t)SQR((int64_t)(inputBuffer[columnIndex]) - (reconCoeffBuffer[columnIndex]));
                     ++columnIndex;
@@ -1595,7 +1737,7 @@ uint64_t PictureSseCalculations(
 
             while (row_index < sequence_control_set_ptr->luma_height) {
 
-                columnIndex = 0;
+                columnIndex = lpf_search_row(row_index, sb_size, picture_height_in_sb) ? 0 : sequence_control_set_ptr->luma_width;
                 while (columnIndex < sequence_control_set_ptr->luma_width) {
                     residualDistortion += (int64_t)SQR(((int64_t)inputBuffer[columnIndex]) - (int64_t)(reconCoeffBuffer[columnIndex]));
                     ++columnIndex;
@@ -1618,7 +1760,7 @@ uint64_t PictureSseCalculations(
             row_index = 0;
             while (row_index < sequence_control_set_ptr->chroma_height) {
 
-                columnIndex = 0;
+                columnIndex = lpf_search_row(row_index, sb_size >> 1, picture_height_in_sb) ? 0 : sequence_control_set_ptr->chroma_width;
                 while (columnIndex < sequence_control_set_ptr->chroma_width) {
                     residualDistortion += (int64_t)SQR(((int64_t)inputBuffer[columnIndex]) - (int64_t)(reconCoeffBuffer[columnIndex]));
                     ++columnIndex;
@@ -1639,7 +1781,7 @@ uint64_t PictureSseCalculations(
 
             while (row_index < sequence_control_set_ptr->chroma_height) {
 
-                columnIndex = 0;
+                columnIndex = lpf_search_row(row_index, sb_size >> 1, picture_height_in_sb) ? 0 : sequence_control_set_ptr->chroma_width;
                 while (columnIndex < sequence_control_set_ptr->chroma_width) {
                     residualDistortion += (int64_t)SQR(((int64_t)inputBuffer[columnIndex]) - (int64_t)(reconCoeffBuffer[columnIndex]));
                     ++columnIndex;
@@ -1703,7 +1845,17 @@ static int64_t try_filter_frame(
     case 2: pcsPtr->parent_pcs_ptr->lf.filter_level_v = filter_level[0]; break;
     }
 
-    av1_loop_filter_frame(recon_buffer, pcsPtr, plane, plane + 1);
+    {
+        SequenceControlSet_t *scsPtr = pcsPtr->parent_pcs_ptr->sequence_control_set_ptr;
+        uint32_t picture_height_in_sb = (scsPtr->luma_height + scsPtr->sb_size_pix - 1) / scsPtr->sb_size_pix;
+        uint32_t sb_row;
+
+        av1_loop_filter_frame_init(pcsPtr, plane, plane + 1);
+        for (sb_row = 0; sb_row < picture_height_in_sb; ++sb_row) {
+            if (lpf_search_sb_row(sb_row, picture_height_in_sb))
+                av1_loop_filter_sb_rows(recon_buffer, pcsPtr, plane, plane + 1, sb_row, sb_row + 1, NULL);
+        }
+    }
 
     filt_err = PictureSseCalculations(pcsPtr, recon_buffer, plane);
 
@@ -106,6 +106,27 @@ extern "C" {
         /*MacroBlockD *xd,*/ int32_t plane_start, int32_t plane_end/*,
         int32_t partial_frame*/);
 
+    /*************************************************
+     * av1_loop_filter_sb_rows
+     *   Filters the SB rows [sb_row_start, sb_row_end)
+     *   of a picture whose filter levels were set up by
+     *   av1_loop_filter_frame_init. With row_semaphore
+     *   set, SB rows are filtered concurrently: the count
+     *   of filtered SBs of each row is published in the
+     *   dlf_sb_row_progress of the picture and each SB
+     *   blocks on row_semaphore, the semaphore of the
+     *   calling task, until the row above is far enough
+     *   ahead.
+     *************************************************/
+    void av1_loop_filter_sb_rows(
+        EbPictureBufferDesc_t *frame_buffer,
+        PictureControlSet_t   *pcsPtr,
+        int32_t                plane_start,
+        int32_t                plane_end,
+        uint32_t               sb_row_start,
+        uint32_t               sb_row_end,
+        EbHandle               row_semaphore);
+
     void av1_pick_filter_level(
 #if FILT_PROC
         DlfContext_t            *context_ptr,
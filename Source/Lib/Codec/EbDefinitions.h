@@ -2100,6 +2100,7 @@ static const uint8_t QP_OFFSET_WEIGHT[3][4] = { // [Slice Type][QP Offset Weight
 typedef enum EbAsm {
     ASM_NON_AVX2,
     ASM_AVX2,
+    ASM_AVX512,
     ASM_TYPE_TOTAL,
     ASM_TYPE_INVALID = ~0
 } EbAsm;
@@ -2202,14 +2203,28 @@ extern    EbMemoryMapEntry        *appMemoryMap;            // App Memory table
 extern    uint32_t                  *appMemoryMapIndex;       // App Memory index
 extern    uint64_t                  *totalAppMemory;          // App Memory malloc'd
 
-extern    EbMemoryMapEntry        *memory_map;               // library Memory table
-extern    uint32_t                  *memory_map_index;          // library memory index
-extern    uint64_t                  *total_lib_memory;          // library Memory malloc'd
+#ifdef _MSC_VER
+#define EB_THREAD_LOCAL __declspec(thread)
+#else
+#define EB_THREAD_LOCAL __thread
+#endif
 
-extern    uint32_t                   libMallocCount;
-extern    uint32_t                   lib_thread_count;
-extern    uint32_t                   libSemaphoreCount;
-extern    uint32_t                   libMutexCount;
+// Library Memory table, owned by one encoder handle
+typedef struct EbMemoryMap
+{
+    EbMemoryMapEntry         *entries;                  // library Memory table
+    uint32_t                  index;                    // library memory index
+    uint32_t                  capacity;                 // entries slots, checked before each entry is written
+    uint64_t                  total_lib_memory;         // library Memory malloc'd
+    uint32_t                  malloc_count;
+    uint32_t                  thread_count;
+    uint32_t                  semaphore_count;
+    uint32_t                  mutex_count;
+} EbMemoryMap;
+
+// Memory map of the encoder handle the calling thread is working for.
+// Bound by the API entry points and inherited by the library threads.
+extern    EB_THREAD_LOCAL EbMemoryMap *memory_map;
 
 extern    uint32_t                   appMallocCount;
 
@@ -2262,134 +2277,153 @@ appMallocCount++;
 
 #ifdef _MSC_VER
 #define EB_ALLIGN_MALLOC(type, pointer, n_elements, pointer_class) \
+if (memory_map->index >= memory_map->capacity) { \
+    return EB_ErrorInsufficientResources; \
+} \
 pointer = (type) _aligned_malloc(n_elements,ALVALUE); \
 if (pointer == (type)EB_NULL) { \
     return EB_ErrorInsufficientResources; \
     } \
     else { \
-    memory_map[*(memory_map_index)].ptrType = pointer_class; \
-    memory_map[(*(memory_map_index))++].ptr = pointer; \
+    memory_map->entries[memory_map->index].ptrType = pointer_class; \
+    memory_map->entries[memory_map->index++].ptr = pointer; \
     if (n_elements % 8 == 0) { \
-        *total_lib_memory += (n_elements); \
+        memory_map->total_lib_memory += (n_elements); \
     } \
     else { \
-        *total_lib_memory += ((n_elements) + (8 - ((n_elements) % 8))); \
+        memory_map->total_lib_memory += ((n_elements) + (8 - ((n_elements) % 8))); \
     } \
 } \
-if (*(memory_map_index) >= MAX_NUM_PTR) { \
-    return EB_ErrorInsufficientResources; \
-} \
-libMallocCount++;
+memory_map->malloc_count++;
 
 #else
 #define EB_ALLIGN_MALLOC(type, pointer, n_elements, pointer_class) \
+if (memory_map->index >= memory_map->capacity) { \
+    return EB_ErrorInsufficientResources; \
+} \
 if (posix_memalign((void**)(&(pointer)), ALVALUE, n_elements) != 0) { \
     return EB_ErrorInsufficientResources; \
         } \
             else { \
     pointer = (type) pointer;  \
-    memory_map[*(memory_map_index)].ptrType = pointer_class; \
-    memory_map[(*(memory_map_index))++].ptr = pointer; \
+    memory_map->entries[memory_map->index].ptrType = pointer_class; \
+    memory_map->entries[memory_map->index++].ptr = pointer; \
     if (n_elements % 8 == 0) { \
-        *total_lib_memory += (n_elements); \
+        memory_map->total_lib_memory += (n_elements); \
             } \
             else { \
-        *total_lib_memory += ((n_elements) + (8 - ((n_elements) % 8))); \
+        memory_map->total_lib_memory += ((n_elements) + (8 - ((n_elements) % 8))); \
     } \
 } \
-if (*(memory_map_index) >= MAX_NUM_PTR) { \
-    return EB_ErrorInsufficientResources; \
-    } \
-libMallocCount++;
+memory_map->malloc_count++;
 #endif
 
 
 #define EB_MALLOC(type, pointer, n_elements, pointer_class) \
+if (memory_map->index >= memory_map->capacity) { \
+    return EB_ErrorInsufficientResources; \
+} \
 pointer = (type) malloc(n_elements); \
 if (pointer == (type)EB_NULL) { \
     return EB_ErrorInsufficientResources; \
     } \
     else { \
-    memory_map[*(memory_map_index)].ptrType = pointer_class; \
-    memory_map[(*(memory_map_index))++].ptr = pointer; \
+    memory_map->entries[memory_map->index].ptrType = pointer_class; \
+    memory_map->entries[memory_map->index++].ptr = pointer; \
     if (n_elements % 8 == 0) { \
-        *total_lib_memory += (n_elements); \
+        memory_map->total_lib_memory += (n_elements); \
     } \
     else { \
-        *total_lib_memory += ((n_elements) + (8 - ((n_elements) % 8))); \
+        memory_map->total_lib_memory += ((n_elements) + (8 - ((n_elements) % 8))); \
     } \
 } \
-if (*(memory_map_index) >= MAX_NUM_PTR) { \
-    return EB_ErrorInsufficientResources; \
-} \
-libMallocCount++;
+memory_map->malloc_count++;
 
 #define EB_CALLOC(type, pointer, count, size, pointer_class) \
+if (memory_map->index >= memory_map->capacity) { \
+    return EB_ErrorInsufficientResources; \
+} \
 pointer = (type) calloc(count, size); \
 if (pointer == (type)EB_NULL) { \
     return EB_ErrorInsufficientResources; \
 } \
 else { \
-    memory_map[*(memory_map_index)].ptrType = pointer_class; \
-    memory_map[(*(memory_map_index))++].ptr = pointer; \
+    memory_map->entries[memory_map->index].ptrType = pointer_class; \
+    memory_map->entries[memory_map->index++].ptr = pointer; \
     if (count % 8 == 0) { \
-        *total_lib_memory += (count); \
+        memory_map->total_lib_memory += (count); \
     } \
     else { \
-        *total_lib_memory += ((count) + (8 - ((count) % 8))); \
+        memory_map->total_lib_memory += ((count) + (8 - ((count) % 8))); \
     } \
 } \
-if (*(memory_map_index) >= MAX_NUM_PTR) { \
+memory_map->malloc_count++;
+
+// Zeroed ALVALUE aligned buffer. Unlike EB_ALLIGN_MALLOC + memset, the large
+// buffers come from fresh zero pages which are only faulted in on first use.
+// The map records the calloc base pointer.
+#define EB_CALLOC_ALIGNED(type, pointer, n_elements) \
+if (memory_map->index >= memory_map->capacity) { \
+    return EB_ErrorInsufficientResources; \
+} \
+pointer = (type) calloc(1, (n_elements) + ALVALUE); \
+if (pointer == (type)EB_NULL) { \
     return EB_ErrorInsufficientResources; \
 } \
-libMallocCount++;
+else { \
+    memory_map->entries[memory_map->index].ptrType = EB_N_PTR; \
+    memory_map->entries[memory_map->index++].ptr = pointer; \
+    memory_map->total_lib_memory += ((n_elements) + ALVALUE + 7) & ~7ull; \
+    pointer = (type)(((size_t)(pointer) + ALVALUE - 1) & ~(size_t)(ALVALUE - 1)); \
+} \
+memory_map->malloc_count++;
 
 #define EB_CREATESEMAPHORE(type, pointer, n_elements, pointer_class, initial_count, max_count) \
+if (memory_map->index >= memory_map->capacity) { \
+    return EB_ErrorInsufficientResources; \
+} \
 pointer = eb_create_semaphore(initial_count, max_count); \
 if (pointer == (type)EB_NULL) { \
     return EB_ErrorInsufficientResources; \
 } \
 else { \
-    memory_map[*(memory_map_index)].ptrType = pointer_class; \
-    memory_map[(*(memory_map_index))++].ptr = pointer; \
+    memory_map->entries[memory_map->index].ptrType = pointer_class; \
+    memory_map->entries[memory_map->index++].ptr = pointer; \
     if (n_elements % 8 == 0) { \
-        *total_lib_memory += (n_elements); \
+        memory_map->total_lib_memory += (n_elements); \
     } \
     else { \
-        *total_lib_memory += ((n_elements) + (8 - ((n_elements) % 8))); \
+        memory_map->total_lib_memory += ((n_elements) + (8 - ((n_elements) % 8))); \
     } \
 } \
-if (*(memory_map_index) >= MAX_NUM_PTR) { \
-    return EB_ErrorInsufficientResources; \
-} \
-libSemaphoreCount++;
+memory_map->semaphore_count++;
 
 #define EB_CREATEMUTEX(type, pointer, n_elements, pointer_class) \
+if (memory_map->index >= memory_map->capacity) { \
+    return EB_ErrorInsufficientResources; \
+} \
 pointer = eb_create_mutex(); \
 if (pointer == (type)EB_NULL){ \
     return EB_ErrorInsufficientResources; \
 } \
 else { \
-    memory_map[*(memory_map_index)].ptrType = pointer_class; \
-    memory_map[(*(memory_map_index))++].ptr = pointer; \
+    memory_map->entries[memory_map->index].ptrType = pointer_class; \
+    memory_map->entries[memory_map->index++].ptr = pointer; \
     if (n_elements % 8 == 0) { \
-        *total_lib_memory += (n_elements); \
+        memory_map->total_lib_memory += (n_elements); \
     } \
     else { \
-        *total_lib_memory += ((n_elements) + (8 - ((n_elements) % 8))); \
+        memory_map->total_lib_memory += ((n_elements) + (8 - ((n_elements) % 8))); \
     } \
 } \
-if (*(memory_map_index) >= MAX_NUM_PTR) { \
-    return EB_ErrorInsufficientResources; \
-} \
-libMutexCount++;
+memory_map->mutex_count++;
 
 #define EB_MEMORY() \
-printf("Total Number of Mallocs in Library: %d\n", libMallocCount); \
-printf("Total Number of Threads in Library: %d\n", lib_thread_count); \
-printf("Total Number of Semaphore in Library: %d\n", libSemaphoreCount); \
-printf("Total Number of Mutex in Library: %d\n", libMutexCount); \
-printf("Total Library Memory: %.2lf KB\n\n",*total_lib_memory/(double)1024);
+printf("Total Number of Mallocs in Library: %d\n", memory_map->malloc_count); \
+printf("Total Number of Threads in Library: %d\n", memory_map->thread_count); \
+printf("Total Number of Semaphore in Library: %d\n", memory_map->semaphore_count); \
+printf("Total Number of Mutex in Library: %d\n", memory_map->mutex_count); \
+printf("Total Library Memory: %.2lf KB\n\n",memory_map->total_lib_memory/(double)1024);
 
 
 #define EB_APP_MEMORY() \
@@ -2826,6 +2860,10 @@ void(*ErrorHandler)(
 
 #define UNCOVERED_AREA_ZZ_TH 4 * 4 * 14
 
+// Static SB: full resolution 64x64 SAD to the collocated list 0 reference
+// block below which the SB is coded as unchanged (1/16 per sample)
+#define STATIC_SB_SAD_TH    (64 * 64 >> 4)
+
 #define BEA_CLASS_0_ZZ_COST     0
 #define BEA_CLASS_0_1_ZZ_COST     3
 
@@ -24,6 +24,7 @@
 #include "EbReferenceObject.h"
 
 #include "EbDeblockingFilter.h"
+#include "EbMcp.h"
 
 void av1_loop_restoration_save_boundary_lines(const Yv12BufferConfig *frame, Av1Common *cm, int32_t after_cdef);
 
@@ -48,6 +49,7 @@ EbErrorType dlf_context_ctor(
     context_ptr->dlf_input_fifo_ptr = dlf_input_fifo_ptr;
     context_ptr->dlf_output_fifo_ptr = dlf_output_fifo_ptr;
 
+    EB_CREATESEMAPHORE(EbHandle, context_ptr->row_semaphore, sizeof(EbHandle), EB_SEMAPHORE, 0, 1);
 
 
     context_ptr->temp_lf_recon_picture16bit_ptr = (EbPictureBufferDesc_t *)EB_NULL;
@@ -82,9 +84,219 @@ EbErrorType dlf_context_ctor(
 }
 
 /******************************************************
- * Dlf Kernel
+ * Claim Reference Rows (frame_row_overlap)
+ *   Takes the reference rows that the deblocking will
+ *   not change anymore and that no task took yet, to
+ *   be padded out of the dlf_mutex. Called with the
+ *   dlf_mutex held.
  ******************************************************/
-void* dlf_kernel(void *input_ptr)
+static EbBool ClaimReferenceRows(
+    SequenceControlSet_t                    *sequence_control_set_ptr,
+    PictureControlSet_t                     *picture_control_set_ptr,
+    uint32_t                                 picture_height_in_sb,
+    uint32_t                                *sb_row_start,
+    uint32_t                                *sb_row_end)
+{
+    const uint32_t picture_width_in_sb = (sequence_control_set_ptr->luma_width + sequence_control_set_ptr->sb_size_pix - 1) / sequence_control_set_ptr->sb_size_pix;
+    uint32_t filteredRowCount = picture_control_set_ptr->dlf_rows_claimed_count;
+    uint32_t finalRowCount;
+
+    while (filteredRowCount < picture_height_in_sb && EB_ATOMIC_LOAD(&picture_control_set_ptr->dlf_sb_row_progress[filteredRowCount]) >= (int32_t)picture_width_in_sb)
+        ++filteredRowCount;
+
+    // The filtering of a row changes the bottom lines of the row above it
+    finalRowCount = (filteredRowCount == picture_height_in_sb) ? filteredRowCount : (filteredRowCount ? filteredRowCount - 1 : 0);
+    if (finalRowCount <= picture_control_set_ptr->dlf_rows_claimed_count)
+        return EB_FALSE;
+
+    *sb_row_start = picture_control_set_ptr->dlf_rows_claimed_count;
+    *sb_row_end = finalRowCount;
+    picture_control_set_ptr->dlf_rows_claimed_count = finalRowCount;
+
+    return EB_TRUE;
+}
+
+/******************************************************
+ * Pad Reference Rows (frame_row_overlap)
+ *   Pads the claimed reference rows and copies their
+ *   source rows to the denoised source of the
+ *   reference. The ranges claimed by the tasks of a
+ *   picture do not overlap, so this runs unlocked.
+ ******************************************************/
+static void PadReferenceRows(
+    SequenceControlSet_t                    *sequence_control_set_ptr,
+    PictureControlSet_t                     *picture_control_set_ptr,
+    uint32_t                                 sb_row_start,
+    uint32_t                                 sb_row_end)
+{
+    EbReferenceObject_t   *referenceObject = (EbReferenceObject_t*)picture_control_set_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr->object_ptr;
+    EbPictureBufferDesc_t *refPicPtr = (sequence_control_set_ptr->static_config.encoder_bit_depth > EB_8BIT) ? referenceObject->referencePicture16bit : referenceObject->referencePicture;
+    EbPictureBufferDesc_t *input_picture_ptr = (EbPictureBufferDesc_t*)picture_control_set_ptr->parent_pcs_ptr->enhanced_picture_ptr;
+    EbPictureBufferDesc_t *refDenPic = referenceObject->refDenSrcPicture;
+    const uint32_t rowStart = sb_row_start * sequence_control_set_ptr->sb_size_pix;
+    const uint32_t rowEnd = MIN(sb_row_end * sequence_control_set_ptr->sb_size_pix, refPicPtr->height);
+    uint32_t verticalIdx;
+
+    if (sequence_control_set_ptr->static_config.encoder_bit_depth > EB_8BIT) {
+        generate_padding16_bit_rows(
+            refPicPtr->buffer_y,
+            refPicPtr->stride_y << 1,
+            refPicPtr->width << 1,
+            refPicPtr->height,
+            refPicPtr->origin_x << 1,
+            refPicPtr->origin_y,
+            rowStart,
+            rowEnd);
+        generate_padding16_bit_rows(
+            refPicPtr->bufferCb,
+            refPicPtr->strideCb << 1,
+            refPicPtr->width,
+            refPicPtr->height >> 1,
+            refPicPtr->origin_x,
+            refPicPtr->origin_y >> 1,
+            rowStart >> 1,
+            rowEnd >> 1);
+        generate_padding16_bit_rows(
+            refPicPtr->bufferCr,
+            refPicPtr->strideCr << 1,
+            refPicPtr->width,
+            refPicPtr->height >> 1,
+            refPicPtr->origin_x,
+            refPicPtr->origin_y >> 1,
+            rowStart >> 1,
+            rowEnd >> 1);
+    }
+    else {
+        generate_padding_rows(
+            refPicPtr->buffer_y,
+            refPicPtr->stride_y,
+            refPicPtr->width,
+            refPicPtr->height,
+            refPicPtr->origin_x,
+            refPicPtr->origin_y,
+            rowStart,
+            rowEnd);
+        generate_padding_rows(
+            refPicPtr->bufferCb,
+            refPicPtr->strideCb,
+            refPicPtr->width >> 1,
+            refPicPtr->height >> 1,
+            refPicPtr->origin_x >> 1,
+            refPicPtr->origin_y >> 1,
+            rowStart >> 1,
+            rowEnd >> 1);
+        generate_padding_rows(
+            refPicPtr->bufferCr,
+            refPicPtr->strideCr,
+            refPicPtr->width >> 1,
+            refPicPtr->height >> 1,
+            refPicPtr->origin_x >> 1,
+            refPicPtr->origin_y >> 1,
+            rowStart >> 1,
+            rowEnd >> 1);
+    }
+
+    // Denoised source of the reference, as copied by the Rest process otherwise
+    for (verticalIdx = rowStart; verticalIdx < rowEnd; ++verticalIdx) {
+        EB_MEMCPY(refDenPic->buffer_y + refDenPic->origin_x + (refDenPic->origin_y + verticalIdx) * refDenPic->stride_y,
+            input_picture_ptr->buffer_y + input_picture_ptr->origin_x + (input_picture_ptr->origin_y + verticalIdx) * input_picture_ptr->stride_y,
+            input_picture_ptr->width);
+    }
+    for (verticalIdx = rowStart >> 1; verticalIdx < (rowEnd >> 1); ++verticalIdx) {
+        EB_MEMCPY(refDenPic->bufferCb + (refDenPic->origin_x >> 1) + ((refDenPic->origin_y >> 1) + verticalIdx) * refDenPic->strideCb,
+            input_picture_ptr->bufferCb + (input_picture_ptr->origin_x >> 1) + ((input_picture_ptr->origin_y >> 1) + verticalIdx) * input_picture_ptr->strideCb,
+            input_picture_ptr->width >> 1);
+        EB_MEMCPY(refDenPic->bufferCr + (refDenPic->origin_x >> 1) + ((refDenPic->origin_y >> 1) + verticalIdx) * refDenPic->strideCr,
+            input_picture_ptr->bufferCr + (input_picture_ptr->origin_x >> 1) + ((input_picture_ptr->origin_y >> 1) + verticalIdx) * input_picture_ptr->strideCr,
+            input_picture_ptr->width >> 1);
+    }
+    generate_padding_rows(
+        refDenPic->buffer_y,
+        refDenPic->stride_y,
+        refDenPic->width,
+        refDenPic->height,
+        refDenPic->origin_x,
+        refDenPic->origin_y,
+        rowStart,
+        rowEnd);
+    generate_padding_rows(
+        refDenPic->bufferCb,
+        refDenPic->strideCb,
+        refDenPic->width >> 1,
+        refDenPic->height >> 1,
+        refDenPic->origin_x >> 1,
+        refDenPic->origin_y >> 1,
+        rowStart >> 1,
+        rowEnd >> 1);
+    generate_padding_rows(
+        refDenPic->bufferCr,
+        refDenPic->strideCr,
+        refDenPic->width >> 1,
+        refDenPic->height >> 1,
+        refDenPic->origin_x >> 1,
+        refDenPic->origin_y >> 1,
+        rowStart >> 1,
+        rowEnd >> 1);
+
+}
+
+/******************************************************
+ * Publish Reference Rows (frame_row_overlap)
+ *   Records the padded rows and makes the rows padded
+ *   down from the top visible to the pictures
+ *   referencing the picture. Returns the EncDec tasks
+ *   waiting on these rows, linked through nextPtr, to
+ *   be posted once the mutex is released. Called with
+ *   the dlf_mutex held.
+ ******************************************************/
+static EbObjectWrapper_t* PublishReferenceRows(
+    PictureControlSet_t                     *picture_control_set_ptr,
+    uint32_t                                 sb_row_start,
+    uint32_t                                 sb_row_end,
+    uint32_t                                 picture_height_in_sb)
+{
+    EbReferenceObject_t *referenceObject = (EbReferenceObject_t*)picture_control_set_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr->object_ptr;
+    EbObjectWrapper_t   *readyTaskList = (EbObjectWrapper_t*)EB_NULL;
+    EbObjectWrapper_t  **waitTaskLink;
+    uint32_t             publishedRowCount = picture_control_set_ptr->dlf_rows_published_count;
+
+    // The ranges are claimed in order but may be padded out of order
+    picture_control_set_ptr->dlf_rows_padded_end[sb_row_start] = sb_row_end;
+    while (publishedRowCount < picture_height_in_sb && picture_control_set_ptr->dlf_rows_padded_end[publishedRowCount])
+        publishedRowCount = picture_control_set_ptr->dlf_rows_padded_end[publishedRowCount];
+    if (publishedRowCount == picture_control_set_ptr->dlf_rows_published_count)
+        return readyTaskList;
+    picture_control_set_ptr->dlf_rows_published_count = publishedRowCount;
+
+    // The count is stored under the wait mutex: a task is either parked before it, or sees it
+    eb_block_on_mutex(referenceObject->ref_wait_mutex);
+    EB_ATOMIC_STORE(&referenceObject->ready_sb_row_count, (int32_t)publishedRowCount);
+    waitTaskLink = &referenceObject->ref_wait_list;
+    while (*waitTaskLink) {
+        EbObjectWrapper_t *waitTaskWrapperPtr = *waitTaskLink;
+
+        if (((EncDecTasks_t*)waitTaskWrapperPtr->object_ptr)->ref_wait_row_count <= (int32_t)publishedRowCount) {
+            *waitTaskLink = waitTaskWrapperPtr->nextPtr;
+            waitTaskWrapperPtr->nextPtr = readyTaskList;
+            readyTaskList = waitTaskWrapperPtr;
+        }
+        else
+            waitTaskLink = &waitTaskWrapperPtr->nextPtr;
+    }
+    eb_release_mutex(referenceObject->ref_wait_mutex);
+
+    return readyTaskList;
+}
+
+/******************************************************
+ * Dlf Kernel Task
+ *   Processes one EncDec Results object, i.e. filters
+ *   one SB row. The task completing the last row of
+ *   the picture prepares and posts the CDEF segments.
+ ******************************************************/
+void dlf_kernel_task(
+    EbPtr                                    input_ptr,
+    EbObjectWrapper_t                       *enc_dec_results_wrapper_ptr)
 {
     // Context & SCS & PCS
     DlfContext_t                            *context_ptr = (DlfContext_t*)input_ptr;
@@ -92,7 +304,6 @@ void* dlf_kernel(void *input_ptr)
     SequenceControlSet_t                    *sequence_control_set_ptr;
 
     //// Input
-    EbObjectWrapper_t                       *enc_dec_results_wrapper_ptr;
     EncDecResults_t                         *enc_dec_results_ptr;
 
     //// Output
@@ -101,44 +312,61 @@ void* dlf_kernel(void *input_ptr)
 
     // SB Loop variables
 
+    enc_dec_results_ptr = (EncDecResults_t*)enc_dec_results_wrapper_ptr->object_ptr;
+    picture_control_set_ptr = (PictureControlSet_t*)enc_dec_results_ptr->pictureControlSetWrapperPtr->object_ptr;
+    sequence_control_set_ptr = (SequenceControlSet_t*)picture_control_set_ptr->sequence_control_set_wrapper_ptr->object_ptr;
 
-    for (;;) {
-
-        // Get EncDec Results
-        eb_get_full_object(
-            context_ptr->dlf_input_fifo_ptr,
-            &enc_dec_results_wrapper_ptr);
+    EbBool  is16bit = (EbBool)(sequence_control_set_ptr->static_config.encoder_bit_depth > EB_8BIT);
+    EbBool dlfEnableFlag = (EbBool)(picture_control_set_ptr->parent_pcs_ptr->loop_filter_mode &&
+        (picture_control_set_ptr->parent_pcs_ptr->is_used_as_reference_flag ||
+            sequence_control_set_ptr->static_config.recon_enabled ||
+            sequence_control_set_ptr->static_config.stat_report));
 
-        enc_dec_results_ptr = (EncDecResults_t*)enc_dec_results_wrapper_ptr->object_ptr;
-        picture_control_set_ptr = (PictureControlSet_t*)enc_dec_results_ptr->pictureControlSetWrapperPtr->object_ptr;
-        sequence_control_set_ptr = (SequenceControlSet_t*)picture_control_set_ptr->sequence_control_set_wrapper_ptr->object_ptr;
+    EbPictureBufferDesc_t  *recon_buffer = is16bit ? picture_control_set_ptr->recon_picture16bit_ptr : picture_control_set_ptr->recon_picture_ptr;
+    if (picture_control_set_ptr->parent_pcs_ptr->is_used_as_reference_flag == EB_TRUE) {
 
-        EbBool  is16bit = (EbBool)(sequence_control_set_ptr->static_config.encoder_bit_depth > EB_8BIT);
-        EbBool dlfEnableFlag = (EbBool)(picture_control_set_ptr->parent_pcs_ptr->loop_filter_mode &&
-            (picture_control_set_ptr->parent_pcs_ptr->is_used_as_reference_flag ||
-                sequence_control_set_ptr->static_config.recon_enabled ||
-                sequence_control_set_ptr->static_config.stat_report));
+        //get the 16bit form of the input LCU
+        if (is16bit) {
+            recon_buffer = ((EbReferenceObject_t*)picture_control_set_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr->object_ptr)->referencePicture16bit;
+        }
+        else {
+            recon_buffer = ((EbReferenceObject_t*)picture_control_set_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr->object_ptr)->referencePicture;
+        }
+    }
+    else { // non ref pictures
+        recon_buffer = is16bit ? picture_control_set_ptr->recon_picture16bit_ptr : picture_control_set_ptr->recon_picture_ptr;
+    }
 
-        if (dlfEnableFlag && picture_control_set_ptr->parent_pcs_ptr->loop_filter_mode >= 2) {
+    uint32_t picture_height_in_sb = (sequence_control_set_ptr->luma_height + sequence_control_set_ptr->sb_size_pix - 1) / sequence_control_set_ptr->sb_size_pix;
+    uint32_t sb_row_start;
+    uint32_t sb_row_end;
+    EbBool   level_search_flag = EB_FALSE;
+    EbBool   last_rows_flag;
+
+    // The first task of the picture claims the filter level search along with the
+    // first row. Rows are claimed in order rather than taken from the results: the
+    // row a task waits on then always belongs to a task that is already running,
+    // and the tasks of the next rows wait for the search through the first row
+    eb_block_on_mutex(picture_control_set_ptr->dlf_mutex);
+    if (picture_control_set_ptr->dlf_level_searched == EB_FALSE) {
+        for (uint32_t sb_row = 0; sb_row < picture_height_in_sb; ++sb_row)
+            picture_control_set_ptr->dlf_sb_row_progress[sb_row] = 0;
+        picture_control_set_ptr->dlf_level_searched = EB_TRUE;
+        level_search_flag = EB_TRUE;
+    }
+    sb_row_start = MIN(picture_control_set_ptr->dlf_next_sb_row, picture_height_in_sb);
+    sb_row_end = MIN(sb_row_start + enc_dec_results_ptr->completedLcuRowCount, picture_height_in_sb);
+    picture_control_set_ptr->dlf_next_sb_row = sb_row_end;
+    eb_release_mutex(picture_control_set_ptr->dlf_mutex);
 
-            EbPictureBufferDesc_t  *recon_buffer = is16bit ? picture_control_set_ptr->recon_picture16bit_ptr : picture_control_set_ptr->recon_picture_ptr;
-            if (picture_control_set_ptr->parent_pcs_ptr->is_used_as_reference_flag == EB_TRUE) {
+    // The search runs out of the mutex, the progress of the rows is published under it
+    if (level_search_flag) {
 
-                //get the 16bit form of the input LCU
-                if (is16bit) {
-                    recon_buffer = ((EbReferenceObject_t*)picture_control_set_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr->object_ptr)->referencePicture16bit;
-                }
-                else {
-                    recon_buffer = ((EbReferenceObject_t*)picture_control_set_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr->object_ptr)->referencePicture;
-                }
-            }
-            else { // non ref pictures
-                recon_buffer = is16bit ? picture_control_set_ptr->recon_picture16bit_ptr : picture_control_set_ptr->recon_picture_ptr;
-            }
+        if (dlfEnableFlag && picture_control_set_ptr->parent_pcs_ptr->loop_filter_mode >= 2) {
 
             av1_loop_filter_init(picture_control_set_ptr);
 
-            if (picture_control_set_ptr->parent_pcs_ptr->loop_filter_mode == 2) {
+            if (picture_control_set_ptr->parent_pcs_ptr->loop_filter_mode == 2 || sequence_control_set_ptr->static_config.frame_row_overlap) {
 
                 av1_pick_filter_level(
                     context_ptr,
@@ -148,11 +376,14 @@ void* dlf_kernel(void *input_ptr)
 
             }
 
-            av1_pick_filter_level(
-                context_ptr,
-                (EbPictureBufferDesc_t*)picture_control_set_ptr->parent_pcs_ptr->enhanced_picture_ptr,
-                picture_control_set_ptr,
-                LPF_PICK_FROM_FULL_IMAGE);
+            // The search filters the whole picture, whose last rows are not coded
+            // yet when the first ones are filtered with frame_row_overlap
+            if (!sequence_control_set_ptr->static_config.frame_row_overlap)
+                av1_pick_filter_level(
+                    context_ptr,
+                    (EbPictureBufferDesc_t*)picture_control_set_ptr->parent_pcs_ptr->enhanced_picture_ptr,
+                    picture_control_set_ptr,
+                    LPF_PICK_FROM_FULL_IMAGE);
 
 #if NO_ENCDEC
             //NO DLF
@@ -161,129 +392,212 @@ void* dlf_kernel(void *input_ptr)
             picture_control_set_ptr->parent_pcs_ptr->lf.filter_level_u = 0;
             picture_control_set_ptr->parent_pcs_ptr->lf.filter_level_v = 0;
 #endif
-                av1_loop_filter_frame(
-                    recon_buffer,
-                    picture_control_set_ptr,
-                    0,
-                    3);
-            }
+            av1_loop_filter_frame_init(picture_control_set_ptr, 0, 3);
+        }
+    }
+
+    // Filter the rows, each SB waits for the SBs of the row above it touches
+    if (dlfEnableFlag && picture_control_set_ptr->parent_pcs_ptr->loop_filter_mode >= 2) {
+        av1_loop_filter_sb_rows(
+            recon_buffer,
+            picture_control_set_ptr,
+            0,
+            3,
+            sb_row_start,
+            sb_row_end,
+            context_ptr->row_semaphore);
+    }
+    else if (sequence_control_set_ptr->static_config.frame_row_overlap) {
+        for (uint32_t sb_row = sb_row_start; sb_row < sb_row_end; ++sb_row)
+            EB_ATOMIC_STORE(&picture_control_set_ptr->dlf_sb_row_progress[sb_row], (int32_t)((sequence_control_set_ptr->luma_width + sequence_control_set_ptr->sb_size_pix - 1) / sequence_control_set_ptr->sb_size_pix));
+    }
+
+    // The final reference rows are padded out of the mutex, only their
+    // publication is under it. The rows of a task are done once published,
+    // the last task then finds the whole reference padded.
+    EbBool             publish_flag = EB_FALSE;
+    uint32_t           publish_sb_row_start = 0;
+    uint32_t           publish_sb_row_end = 0;
+    EbObjectWrapper_t *ready_task_list = (EbObjectWrapper_t*)EB_NULL;
+
+    if (sequence_control_set_ptr->static_config.frame_row_overlap && picture_control_set_ptr->parent_pcs_ptr->is_used_as_reference_flag) {
+        eb_block_on_mutex(picture_control_set_ptr->dlf_mutex);
+        publish_flag = ClaimReferenceRows(
+            sequence_control_set_ptr,
+            picture_control_set_ptr,
+            picture_height_in_sb,
+            &publish_sb_row_start,
+            &publish_sb_row_end);
+        eb_release_mutex(picture_control_set_ptr->dlf_mutex);
+
+        if (publish_flag)
+            PadReferenceRows(
+                sequence_control_set_ptr,
+                picture_control_set_ptr,
+                publish_sb_row_start,
+                publish_sb_row_end);
+    }
 
+    eb_block_on_mutex(picture_control_set_ptr->dlf_mutex);
+    if (publish_flag)
+        ready_task_list = PublishReferenceRows(
+            picture_control_set_ptr,
+            publish_sb_row_start,
+            publish_sb_row_end,
+            picture_height_in_sb);
+    picture_control_set_ptr->dlf_rows_done_count += sb_row_end - sb_row_start;
+    last_rows_flag = (picture_control_set_ptr->dlf_rows_done_count == picture_height_in_sb) ? EB_TRUE : EB_FALSE;
+    eb_release_mutex(picture_control_set_ptr->dlf_mutex);
+
+    // Post the EncDec tasks the published rows let start
+    while (ready_task_list) {
+        EbObjectWrapper_t *ready_task_wrapper_ptr = ready_task_list;
+
+        ready_task_list = ready_task_list->nextPtr;
+        ready_task_wrapper_ptr->nextPtr = (EbObjectWrapper_t*)EB_NULL;
+        eb_post_full_object(ready_task_wrapper_ptr);
+    }
+
+    if (last_rows_flag == EB_FALSE) {
+        // Release EncDec Results
+        eb_release_object(enc_dec_results_wrapper_ptr);
+        return;
+    }
 
 #if CDEF_M
 
-        //pre-cdef prep
-        {
-            Av1Common* cm = picture_control_set_ptr->parent_pcs_ptr->av1_cm;
-            EbPictureBufferDesc_t  * recon_picture_ptr;
-            if (is16bit) {
-                if (picture_control_set_ptr->parent_pcs_ptr->is_used_as_reference_flag == EB_TRUE)
-                    recon_picture_ptr = ((EbReferenceObject_t*)picture_control_set_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr->object_ptr)->referencePicture16bit;
-                else
-                    recon_picture_ptr = picture_control_set_ptr->recon_picture16bit_ptr;
-            }
-            else {
-                if (picture_control_set_ptr->parent_pcs_ptr->is_used_as_reference_flag == EB_TRUE)
-                    recon_picture_ptr = ((EbReferenceObject_t*)picture_control_set_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr->object_ptr)->referencePicture;
-                else
-                    recon_picture_ptr = picture_control_set_ptr->recon_picture_ptr;
-            }
+    //pre-cdef prep
+    {
+        Av1Common* cm = picture_control_set_ptr->parent_pcs_ptr->av1_cm;
+        EbPictureBufferDesc_t  * recon_picture_ptr;
+        if (is16bit) {
+            if (picture_control_set_ptr->parent_pcs_ptr->is_used_as_reference_flag == EB_TRUE)
+                recon_picture_ptr = ((EbReferenceObject_t*)picture_control_set_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr->object_ptr)->referencePicture16bit;
+            else
+                recon_picture_ptr = picture_control_set_ptr->recon_picture16bit_ptr;
+        }
+        else {
+            if (picture_control_set_ptr->parent_pcs_ptr->is_used_as_reference_flag == EB_TRUE)
+                recon_picture_ptr = ((EbReferenceObject_t*)picture_control_set_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr->object_ptr)->referencePicture;
+            else
+                recon_picture_ptr = picture_control_set_ptr->recon_picture_ptr;
+        }
 
-            LinkEbToAomBufferDesc(
-                recon_picture_ptr,
-                cm->frame_to_show);
+        LinkEbToAomBufferDesc(
+            recon_picture_ptr,
+            cm->frame_to_show);
 
-            if (sequence_control_set_ptr->enable_restoration) {
-                av1_loop_restoration_save_boundary_lines(cm->frame_to_show, cm, 0);
-            }
+        if (sequence_control_set_ptr->enable_restoration) {
+            av1_loop_restoration_save_boundary_lines(cm->frame_to_show, cm, 0);
+        }
 
 #if CDEF_M
-            if (sequence_control_set_ptr->enable_cdef && picture_control_set_ptr->parent_pcs_ptr->cdef_filter_mode)
-            {
+        if (sequence_control_set_ptr->enable_cdef && picture_control_set_ptr->parent_pcs_ptr->cdef_filter_mode)
+        {
 #endif
-                if (is16bit)
-                {
-                    picture_control_set_ptr->src[0] = (uint16_t*)recon_picture_ptr->buffer_y + (recon_picture_ptr->origin_x + recon_picture_ptr->origin_y     * recon_picture_ptr->stride_y);
-                    picture_control_set_ptr->src[1] = (uint16_t*)recon_picture_ptr->bufferCb + (recon_picture_ptr->origin_x / 2 + recon_picture_ptr->origin_y / 2 * recon_picture_ptr->strideCb);
-                    picture_control_set_ptr->src[2] = (uint16_t*)recon_picture_ptr->bufferCr + (recon_picture_ptr->origin_x / 2 + recon_picture_ptr->origin_y / 2 * recon_picture_ptr->strideCr);
+            if (is16bit)
+            {
+                picture_control_set_ptr->src[0] = (uint16_t*)recon_picture_ptr->buffer_y + (recon_picture_ptr->origin_x + recon_picture_ptr->origin_y     * recon_picture_ptr->stride_y);
+                picture_control_set_ptr->src[1] = (uint16_t*)recon_picture_ptr->bufferCb + (recon_picture_ptr->origin_x / 2 + recon_picture_ptr->origin_y / 2 * recon_picture_ptr->strideCb);
+                picture_control_set_ptr->src[2] = (uint16_t*)recon_picture_ptr->bufferCr + (recon_picture_ptr->origin_x / 2 + recon_picture_ptr->origin_y / 2 * recon_picture_ptr->strideCr);
 
-                    EbPictureBufferDesc_t *input_picture_ptr = picture_control_set_ptr->input_frame16bit;
-                    picture_control_set_ptr->ref_coeff[0] = (uint16_t*)input_picture_ptr->buffer_y + (input_picture_ptr->origin_x + input_picture_ptr->origin_y * input_picture_ptr->stride_y);
-                    picture_control_set_ptr->ref_coeff[1] = (uint16_t*)input_picture_ptr->bufferCb + (input_picture_ptr->origin_x / 2 + input_picture_ptr->origin_y / 2 * input_picture_ptr->strideCb);
-                    picture_control_set_ptr->ref_coeff[2] = (uint16_t*)input_picture_ptr->bufferCr + (input_picture_ptr->origin_x / 2 + input_picture_ptr->origin_y / 2 * input_picture_ptr->strideCr);
+                EbPictureBufferDesc_t *input_picture_ptr = picture_control_set_ptr->input_frame16bit;
+                picture_control_set_ptr->ref_coeff[0] = (uint16_t*)input_picture_ptr->buffer_y + (input_picture_ptr->origin_x + input_picture_ptr->origin_y * input_picture_ptr->stride_y);
+                picture_control_set_ptr->ref_coeff[1] = (uint16_t*)input_picture_ptr->bufferCb + (input_picture_ptr->origin_x / 2 + input_picture_ptr->origin_y / 2 * input_picture_ptr->strideCb);
+                picture_control_set_ptr->ref_coeff[2] = (uint16_t*)input_picture_ptr->bufferCr + (input_picture_ptr->origin_x / 2 + input_picture_ptr->origin_y / 2 * input_picture_ptr->strideCr);
 
-                }
-                else
-                {
-                    //these copies should go!
-                EbByte  rec_ptr = &((recon_picture_ptr->buffer_y)[recon_picture_ptr->origin_x + recon_picture_ptr->origin_y * recon_picture_ptr->stride_y]);
-                    EbByte  rec_ptr_cb = &((recon_picture_ptr->bufferCb)[recon_picture_ptr->origin_x / 2 + recon_picture_ptr->origin_y / 2 * recon_picture_ptr->strideCb]);
-                    EbByte  rec_ptr_cr = &((recon_picture_ptr->bufferCr)[recon_picture_ptr->origin_x / 2 + recon_picture_ptr->origin_y / 2 * recon_picture_ptr->strideCr]);
-
-                    EbPictureBufferDesc_t *input_picture_ptr = (EbPictureBufferDesc_t*)picture_control_set_ptr->parent_pcs_ptr->enhanced_picture_ptr;
-                    EbByte  enh_ptr = &((input_picture_ptr->buffer_y)[input_picture_ptr->origin_x + input_picture_ptr->origin_y * input_picture_ptr->stride_y]);
-                    EbByte  enh_ptr_cb = &((input_picture_ptr->bufferCb)[input_picture_ptr->origin_x / 2 + input_picture_ptr->origin_y / 2 * input_picture_ptr->strideCb]);
-                    EbByte  enh_ptr_cr = &((input_picture_ptr->bufferCr)[input_picture_ptr->origin_x / 2 + input_picture_ptr->origin_y / 2 * input_picture_ptr->strideCr]);
-
-                    for (int r = 0; r < sequence_control_set_ptr->luma_height; ++r) {
-                        for (int c = 0; c < sequence_control_set_ptr->luma_width; ++c) {
-                        picture_control_set_ptr->src[0]      [r * sequence_control_set_ptr->luma_width + c] = rec_ptr[r * recon_picture_ptr->stride_y + c];
-                        picture_control_set_ptr->ref_coeff[0][r * sequence_control_set_ptr->luma_width + c] = enh_ptr[r * input_picture_ptr->stride_y + c];
-                        }
+            }
+            else
+            {
+                //these copies should go!
+            EbByte  rec_ptr = &((recon_picture_ptr->buffer_y)[recon_picture_ptr->origin_x + recon_picture_ptr->origin_y * recon_picture_ptr->stride_y]);
+                EbByte  rec_ptr_cb = &((recon_picture_ptr->bufferCb)[recon_picture_ptr->origin_x / 2 + recon_picture_ptr->origin_y / 2 * recon_picture_ptr->strideCb]);
+                EbByte  rec_ptr_cr = &((recon_picture_ptr->bufferCr)[recon_picture_ptr->origin_x / 2 + recon_picture_ptr->origin_y / 2 * recon_picture_ptr->strideCr]);
+
+                EbPictureBufferDesc_t *input_picture_ptr = (EbPictureBufferDesc_t*)picture_control_set_ptr->parent_pcs_ptr->enhanced_picture_ptr;
+                EbByte  enh_ptr = &((input_picture_ptr->buffer_y)[input_picture_ptr->origin_x + input_picture_ptr->origin_y * input_picture_ptr->stride_y]);
+                EbByte  enh_ptr_cb = &((input_picture_ptr->bufferCb)[input_picture_ptr->origin_x / 2 + input_picture_ptr->origin_y / 2 * input_picture_ptr->strideCb]);
+                EbByte  enh_ptr_cr = &((input_picture_ptr->bufferCr)[input_picture_ptr->origin_x / 2 + input_picture_ptr->origin_y / 2 * input_picture_ptr->strideCr]);
+
+                for (int r = 0; r < sequence_control_set_ptr->luma_height; ++r) {
+                    for (int c = 0; c < sequence_control_set_ptr->luma_width; ++c) {
+                    picture_control_set_ptr->src[0]      [r * sequence_control_set_ptr->luma_width + c] = rec_ptr[r * recon_picture_ptr->stride_y + c];
+                    picture_control_set_ptr->ref_coeff[0][r * sequence_control_set_ptr->luma_width + c] = enh_ptr[r * input_picture_ptr->stride_y + c];
                     }
+                }
 
-                for (int r = 0; r < sequence_control_set_ptr->luma_height/2; ++r) {
-                    for (int c = 0; c < sequence_control_set_ptr->luma_width/2; ++c) {
-                        picture_control_set_ptr->src[1][r * sequence_control_set_ptr->luma_width/2 + c] = rec_ptr_cb[r * recon_picture_ptr->strideCb + c];
-                        picture_control_set_ptr->ref_coeff[1][r * sequence_control_set_ptr->luma_width/2 + c] = enh_ptr_cb[r * input_picture_ptr->strideCb + c];
-                            picture_control_set_ptr->src[2][r * sequence_control_set_ptr->luma_width / 2 + c] = rec_ptr_cr[r * recon_picture_ptr->strideCr + c];
-                            picture_control_set_ptr->ref_coeff[2][r * sequence_control_set_ptr->luma_width / 2 + c] = enh_ptr_cr[r * input_picture_ptr->strideCr + c];
-                        }
+            for (int r = 0; r < sequence_control_set_ptr->luma_height/2; ++r) {
+                for (int c = 0; c < sequence_control_set_ptr->luma_width/2; ++c) {
+                    picture_control_set_ptr->src[1][r * sequence_control_set_ptr->luma_width/2 + c] = rec_ptr_cb[r * recon_picture_ptr->strideCb + c];
+                    picture_control_set_ptr->ref_coeff[1][r * sequence_control_set_ptr->luma_width/2 + c] = enh_ptr_cb[r * input_picture_ptr->strideCb + c];
+                        picture_control_set_ptr->src[2][r * sequence_control_set_ptr->luma_width / 2 + c] = rec_ptr_cr[r * recon_picture_ptr->strideCr + c];
+                        picture_control_set_ptr->ref_coeff[2][r * sequence_control_set_ptr->luma_width / 2 + c] = enh_ptr_cr[r * input_picture_ptr->strideCr + c];
                     }
-
                 }
-#if CDEF_M
-            }
-#endif
 
+            }
+#if CDEF_M
         }
+#endif
 
-        picture_control_set_ptr->cdef_segments_column_count =  sequence_control_set_ptr->cdef_segment_column_count;
-        picture_control_set_ptr->cdef_segments_row_count = sequence_control_set_ptr->cdef_segment_row_count;
-        picture_control_set_ptr->cdef_segments_total_count  = (uint16_t)(picture_control_set_ptr->cdef_segments_column_count  * picture_control_set_ptr->cdef_segments_row_count);
-        picture_control_set_ptr->tot_seg_searched_cdef = 0;
-        uint32_t segment_index;
+    }
 
-        for (segment_index = 0; segment_index < picture_control_set_ptr->cdef_segments_total_count; ++segment_index)
-        {
-            // Get Empty DLF Results to Cdef
-            eb_get_empty_object(
-                context_ptr->dlf_output_fifo_ptr,
-                &dlf_results_wrapper_ptr);
-            dlf_results_ptr = (struct DlfResults_s*)dlf_results_wrapper_ptr->object_ptr;
-            dlf_results_ptr->picture_control_set_wrapper_ptr = enc_dec_results_ptr->pictureControlSetWrapperPtr;
-
-            dlf_results_ptr->segment_index = segment_index;
-            // Post DLF Results
-            eb_post_full_object(dlf_results_wrapper_ptr);
-        }
+    picture_control_set_ptr->cdef_segments_column_count =  sequence_control_set_ptr->cdef_segment_column_count;
+    picture_control_set_ptr->cdef_segments_row_count = sequence_control_set_ptr->cdef_segment_row_count;
+    picture_control_set_ptr->cdef_segments_total_count  = (uint16_t)(picture_control_set_ptr->cdef_segments_column_count  * picture_control_set_ptr->cdef_segments_row_count);
+    picture_control_set_ptr->tot_seg_searched_cdef = 0;
+    uint32_t segment_index;
+
+    for (segment_index = 0; segment_index < picture_control_set_ptr->cdef_segments_total_count; ++segment_index)
+    {
+        // Get Empty DLF Results to Cdef
+        eb_get_empty_object(
+            context_ptr->dlf_output_fifo_ptr,
+            &dlf_results_wrapper_ptr);
+        dlf_results_ptr = (struct DlfResults_s*)dlf_results_wrapper_ptr->object_ptr;
+        dlf_results_ptr->picture_control_set_wrapper_ptr = enc_dec_results_ptr->pictureControlSetWrapperPtr;
+
+        dlf_results_ptr->segment_index = segment_index;
+        // Post DLF Results
+        eb_post_full_object(dlf_results_wrapper_ptr);
+    }
 #else
 
-            // Get Empty DLF Results to Cdef
-            eb_get_empty_object(
-                context_ptr->dlf_output_fifo_ptr,
-                &dlf_results_wrapper_ptr);
-            dlf_results_ptr = (struct DlfResults_s*)dlf_results_wrapper_ptr->object_ptr;
-            dlf_results_ptr->pictureControlSetWrapperPtr = enc_dec_results_ptr->pictureControlSetWrapperPtr;
-            dlf_results_ptr->completedLcuRowIndexStart = 0;
-            dlf_results_ptr->completedLcuRowCount = ((sequence_control_set_ptr->luma_height + sequence_control_set_ptr->sb_size_pix - 1) >> lcuSizeLog2);
-            // Post DLF Results
-            eb_post_full_object(dlf_results_wrapper_ptr);
+        // Get Empty DLF Results to Cdef
+        eb_get_empty_object(
+            context_ptr->dlf_output_fifo_ptr,
+            &dlf_results_wrapper_ptr);
+        dlf_results_ptr = (struct DlfResults_s*)dlf_results_wrapper_ptr->object_ptr;
+        dlf_results_ptr->pictureControlSetWrapperPtr = enc_dec_results_ptr->pictureControlSetWrapperPtr;
+        dlf_results_ptr->completedLcuRowIndexStart = 0;
+        dlf_results_ptr->completedLcuRowCount = ((sequence_control_set_ptr->luma_height + sequence_control_set_ptr->sb_size_pix - 1) >> lcuSizeLog2);
+        // Post DLF Results
+        eb_post_full_object(dlf_results_wrapper_ptr);
 #endif
 
-            // Release EncDec Results
-            eb_release_object(enc_dec_results_wrapper_ptr);
+        // Release EncDec Results
+        eb_release_object(enc_dec_results_wrapper_ptr);
+}
 
-        }
+/******************************************************
+ * Dlf Kernel
+ ******************************************************/
+void* dlf_kernel(void *input_ptr)
+{
+    DlfContext_t *context_ptr = (DlfContext_t*)input_ptr;
+    EbObjectWrapper_t *enc_dec_results_wrapper_ptr;
+
+    for (;;) {
+
+        // Get EncDec Results
+        eb_get_full_object(
+            context_ptr->dlf_input_fifo_ptr,
+            &enc_dec_results_wrapper_ptr);
+
+        dlf_kernel_task(
+            context_ptr,
+            enc_dec_results_wrapper_ptr);
+    }
 
     return EB_NULL;
 }
@@ -27,6 +27,7 @@ typedef struct DlfContext_s
     EbPictureBufferDesc_t                 *temp_lf_recon_picture_ptr;
     EbPictureBufferDesc_t                 *temp_lf_recon_picture16bit_ptr;
 
+    EbHandle                               row_semaphore;          // blocked on until the SB row above is far enough ahead
 
 } DlfContext_t;
 
@@ -44,4 +45,8 @@ extern EbErrorType dlf_context_ctor(
 
 extern void* dlf_kernel(void *input_ptr);
 
+extern void dlf_kernel_task(
+    EbPtr                                    input_ptr,
+    EbObjectWrapper_t                       *enc_dec_results_wrapper_ptr);
+
 #endif // EbEntropyCodingProcess_h
\ No newline at end of file
@@ -550,6 +550,15 @@ EbBool AssignEncDecSegments(
 
         break;
 
+    case ENCDEC_TASKS_REF_WAIT:
+
+        // The segment was already assigned, its dependencies are cleared
+        *segmentInOutIndex = taskPtr->enc_dec_segment_index;
+        taskPtr->inputType = ENCDEC_TASKS_CONTINUE;
+        continueProcessingFlag = EB_TRUE;
+
+        break;
+
     case ENCDEC_TASKS_CONTINUE:
 
         // Update the Dependency List for Right and Bottom Neighbors
@@ -770,7 +779,14 @@ static void ReconOutput(
     }
 
     // Post the Recon object
-    eb_post_full_object(outputReconWrapperPtr);
+    if (sequence_control_set_ptr->static_config.output_recon_callback) {
+        outputReconPtr->wrapper_ptr = outputReconWrapperPtr;
+        sequence_control_set_ptr->static_config.output_recon_callback(
+            sequence_control_set_ptr->static_config.output_callback_context,
+            outputReconPtr);
+    }
+    else
+        eb_post_full_object(outputReconWrapperPtr);
     eb_release_mutex(encode_context_ptr->total_number_of_recon_frame_mutex);
 }
 
@@ -1379,9 +1395,150 @@ void move_cu_data(
     CodingUnit_t *dst_cu);
 
 /******************************************************
- * EncDec Kernel
+ * Reference Rows Lacking (frame_row_overlap)
+ *   Checks that the reference SB rows a segment may
+ *   read, down to ref_row_reach below its last SB row,
+ *   are deblocked and padded. Returns the first
+ *   reference lacking some, NULL when none does.
  ******************************************************/
-void* EncDecKernel(void *input_ptr)
+static EbReferenceObject_t* RefRowsLacking(
+    SequenceControlSet_t    *sequence_control_set_ptr,
+    PictureControlSet_t     *picture_control_set_ptr,
+    uint32_t                 lastSbRow,
+    int32_t                 *requiredRowCount)
+{
+    const uint32_t sb_size = sequence_control_set_ptr->sb_size_pix;
+    const uint32_t pictureHeightInSb = (sequence_control_set_ptr->luma_height + sb_size - 1) / sb_size;
+    EbReferenceObject_t *refObjL0 = (EbReferenceObject_t*)picture_control_set_ptr->ref_pic_ptr_array[REF_LIST_0]->object_ptr;
+
+    *requiredRowCount = (int32_t)MIN(pictureHeightInSb, ((lastSbRow + 1) * sb_size + picture_control_set_ptr->ref_row_reach + sb_size - 1) / sb_size);
+
+    if (EB_ATOMIC_LOAD(&refObjL0->ready_sb_row_count) < *requiredRowCount)
+        return refObjL0;
+
+    if (picture_control_set_ptr->slice_type == B_SLICE) {
+        EbReferenceObject_t *refObjL1 = (EbReferenceObject_t*)picture_control_set_ptr->ref_pic_ptr_array[REF_LIST_1]->object_ptr;
+        if (EB_ATOMIC_LOAD(&refObjL1->ready_sb_row_count) < *requiredRowCount)
+            return refObjL1;
+    }
+
+    return (EbReferenceObject_t*)EB_NULL;
+}
+
+/******************************************************
+ * Park On Reference Rows (frame_row_overlap)
+ *   Parks the task on the reference until the DLF
+ *   publishes the rows it waits for, then the DLF
+ *   posts it back. Returns EB_FALSE, the task not
+ *   parked, if the rows were published meanwhile.
+ ******************************************************/
+static EbBool ParkOnRefRows(
+    EbReferenceObject_t     *referenceObject,
+    EbObjectWrapper_t       *taskWrapperPtr)
+{
+    EbBool parked = EB_FALSE;
+
+    eb_block_on_mutex(referenceObject->ref_wait_mutex);
+    if (EB_ATOMIC_LOAD(&referenceObject->ready_sb_row_count) < ((EncDecTasks_t*)taskWrapperPtr->object_ptr)->ref_wait_row_count) {
+        taskWrapperPtr->nextPtr = referenceObject->ref_wait_list;
+        referenceObject->ref_wait_list = taskWrapperPtr;
+        parked = EB_TRUE;
+    }
+    eb_release_mutex(referenceObject->ref_wait_mutex);
+
+    return parked;
+}
+
+#if FILT_PROC
+/******************************************************
+ * DLF Rows Posted Early
+ *   The DLF tasks of a picture are posted as its rows
+ *   are coded unless its filter levels are searched on
+ *   the whole coded picture (LPF_PICK_FROM_FULL_IMAGE,
+ *   skipped with frame_row_overlap).
+ ******************************************************/
+static EbBool DlfRowsPostedEarly(
+    SequenceControlSet_t    *sequence_control_set_ptr,
+    PictureControlSet_t     *picture_control_set_ptr)
+{
+    EbBool dlfEnableFlag = (EbBool)(picture_control_set_ptr->parent_pcs_ptr->loop_filter_mode &&
+        (picture_control_set_ptr->parent_pcs_ptr->is_used_as_reference_flag ||
+            sequence_control_set_ptr->static_config.recon_enabled ||
+            sequence_control_set_ptr->static_config.stat_report));
+
+    return (EbBool)(sequence_control_set_ptr->static_config.frame_row_overlap ||
+        !dlfEnableFlag || picture_control_set_ptr->parent_pcs_ptr->loop_filter_mode < 2);
+}
+
+/******************************************************
+ * EncDec SB Done
+ *   Counts the coded SBs of each row. The DLF task of
+ *   a row is posted once the row below it is coded,
+ *   the one of the last row with the picture.
+ ******************************************************/
+static void EncDecSbDone(
+    EncDecContext_t         *context_ptr,
+    SequenceControlSet_t    *sequence_control_set_ptr,
+    PictureControlSet_t     *picture_control_set_ptr,
+    EbObjectWrapper_t       *picture_control_set_wrapper_ptr,
+    uint32_t                 yLcuIndex,
+    uint32_t                 picture_width_in_sb)
+{
+    const uint32_t pictureHeightInSb = (sequence_control_set_ptr->luma_height + sequence_control_set_ptr->sb_size_pix - 1) / sequence_control_set_ptr->sb_size_pix;
+    EbObjectWrapper_t *encDecResultsWrapperPtr;
+    EncDecResults_t   *encDecResultsPtr;
+    uint32_t rowsDoneCount;
+    uint32_t dlfRowStart;
+    uint32_t dlfRowEnd;
+    uint32_t sbRowIndex;
+
+    if (EB_ATOMIC_ADD(&picture_control_set_ptr->enc_dec_sb_row_progress[yLcuIndex], 1) + 1 < (int32_t)picture_width_in_sb)
+        return;
+
+    // The rows may complete out of order, only the leading coded rows are released
+    eb_block_on_mutex(picture_control_set_ptr->dlf_mutex);
+    rowsDoneCount = picture_control_set_ptr->enc_dec_rows_done_count;
+    dlfRowStart = (rowsDoneCount == pictureHeightInSb) ? rowsDoneCount : (rowsDoneCount ? rowsDoneCount - 1 : 0);
+    while (rowsDoneCount < pictureHeightInSb && EB_ATOMIC_LOAD(&picture_control_set_ptr->enc_dec_sb_row_progress[rowsDoneCount]) == (int32_t)picture_width_in_sb)
+        ++rowsDoneCount;
+    dlfRowEnd = (rowsDoneCount == pictureHeightInSb) ? rowsDoneCount : (rowsDoneCount ? rowsDoneCount - 1 : 0);
+    picture_control_set_ptr->enc_dec_rows_done_count = rowsDoneCount;
+    eb_release_mutex(picture_control_set_ptr->dlf_mutex);
+
+    // Copied before the last row leaves, the reference object may be released once it is filtered
+    // (done at dispatch with frame_row_overlap, the object is already read)
+    if (dlfRowEnd == pictureHeightInSb && dlfRowStart < dlfRowEnd &&
+        sequence_control_set_ptr->film_grain_params_present && !sequence_control_set_ptr->static_config.frame_row_overlap &&
+        picture_control_set_ptr->parent_pcs_ptr->is_used_as_reference_flag == EB_TRUE && picture_control_set_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr) {
+
+        ((EbReferenceObject_t*)picture_control_set_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr->object_ptr)->film_grain_params
+            = picture_control_set_ptr->parent_pcs_ptr->film_grain_params;
+    }
+
+    // Posted outside of the mutex, the DLF tasks take it
+    for (sbRowIndex = dlfRowStart; sbRowIndex < dlfRowEnd; ++sbRowIndex) {
+
+        // Get Empty EncDec Results
+        eb_get_empty_object(
+            context_ptr->enc_dec_output_fifo_ptr,
+            &encDecResultsWrapperPtr);
+        encDecResultsPtr = (EncDecResults_t*)encDecResultsWrapperPtr->object_ptr;
+        encDecResultsPtr->pictureControlSetWrapperPtr = picture_control_set_wrapper_ptr;
+        encDecResultsPtr->completedLcuRowIndexStart = sbRowIndex;
+        encDecResultsPtr->completedLcuRowCount = 1;
+        // Post EncDec Results
+        eb_post_full_object(encDecResultsWrapperPtr);
+    }
+}
+#endif
+
+/******************************************************
+ * EncDec Kernel Task
+ *   Processes one EncDec Tasks object
+ ******************************************************/
+void EncDecKernelTask(
+    EbPtr                                    input_ptr,
+    EbObjectWrapper_t                       *encDecTasksWrapperPtr)
 {
     // Context & SCS & PCS
     EncDecContext_t                         *context_ptr = (EncDecContext_t*)input_ptr;
@@ -1389,7 +1546,6 @@ void* EncDecKernel(void *input_ptr)
     SequenceControlSet_t                    *sequence_control_set_ptr;
 
     // Input
-    EbObjectWrapper_t                       *encDecTasksWrapperPtr;
     EncDecTasks_t                           *encDecTasksPtr;
 
     // Output
@@ -1430,554 +1586,596 @@ void* EncDecKernel(void *input_ptr)
     uint32_t                                 segmentBandIndex;
     uint32_t                                 segmentBandSize;
     EncDecSegments_t                        *segmentsPtr;
+    EbReferenceObject_t                     *refWaitObjPtr = (EbReferenceObject_t*)EB_NULL;
+    int32_t                                  refWaitRowCount = 0;
 #if ! FILT_PROC
     EbBool                                   enableEcRows = EB_FALSE;//for CDEF.
+#else
+    EbBool                                   dlfRowsPostedEarly;
 #endif
-    for (;;) {
-
-        // Get Mode Decision Results
-        eb_get_full_object(
-            context_ptr->mode_decision_input_fifo_ptr,
-            &encDecTasksWrapperPtr);
 
-        encDecTasksPtr = (EncDecTasks_t*)encDecTasksWrapperPtr->object_ptr;
-        picture_control_set_ptr = (PictureControlSet_t*)encDecTasksPtr->pictureControlSetWrapperPtr->object_ptr;
-        sequence_control_set_ptr = (SequenceControlSet_t*)picture_control_set_ptr->sequence_control_set_wrapper_ptr->object_ptr;
-        segmentsPtr = picture_control_set_ptr->enc_dec_segment_ctrl;
-        lastLcuFlag = EB_FALSE;
-        is16bit = (EbBool)(sequence_control_set_ptr->static_config.encoder_bit_depth > EB_8BIT);
+    encDecTasksPtr = (EncDecTasks_t*)encDecTasksWrapperPtr->object_ptr;
+    picture_control_set_ptr = (PictureControlSet_t*)encDecTasksPtr->pictureControlSetWrapperPtr->object_ptr;
+    sequence_control_set_ptr = (SequenceControlSet_t*)picture_control_set_ptr->sequence_control_set_wrapper_ptr->object_ptr;
+    segmentsPtr = picture_control_set_ptr->enc_dec_segment_ctrl;
+    lastLcuFlag = EB_FALSE;
+    is16bit = (EbBool)(sequence_control_set_ptr->static_config.encoder_bit_depth > EB_8BIT);
 #if FILT_PROC
-        (void)is16bit;
-        (void)endOfRowFlag;
+    (void)is16bit;
+    (void)endOfRowFlag;
+    dlfRowsPostedEarly = DlfRowsPostedEarly(
+        sequence_control_set_ptr,
+        picture_control_set_ptr);
 #endif
-        // EncDec Kernel Signal(s) derivation
+    // EncDec Kernel Signal(s) derivation
 
-        signal_derivation_enc_dec_kernel_oq(
+    signal_derivation_enc_dec_kernel_oq(
 #if CHROMA_BLIND
-            sequence_control_set_ptr,
+        sequence_control_set_ptr,
 #endif
-            picture_control_set_ptr,
-            context_ptr->md_context);
-
-        // SB Constants
-        sb_sz = (uint8_t)sequence_control_set_ptr->sb_size_pix;
-        lcuSizeLog2 = (uint8_t)Log2f(sb_sz);
-        context_ptr->sb_sz = sb_sz;
-        picture_width_in_sb = (sequence_control_set_ptr->luma_width + sb_sz - 1) >> lcuSizeLog2;
-        endOfRowFlag = EB_FALSE;
-        lcuRowIndexStart = lcuRowIndexCount = 0;
-        context_ptr->tot_intra_coded_area = 0;
-
-        // Segment-loop
-        while (AssignEncDecSegments(segmentsPtr, &segment_index, encDecTasksPtr, context_ptr->enc_dec_feedback_fifo_ptr) == EB_TRUE)
-        {
-            xLcuStartIndex = segmentsPtr->xStartArray[segment_index];
-            yLcuStartIndex = segmentsPtr->yStartArray[segment_index];
-            lcuStartIndex = yLcuStartIndex * picture_width_in_sb + xLcuStartIndex;
-            lcuSegmentCount = segmentsPtr->validLcuCountArray[segment_index];
-
-            segmentRowIndex = segment_index / segmentsPtr->segmentBandCount;
-            segmentBandIndex = segment_index - segmentRowIndex * segmentsPtr->segmentBandCount;
-            segmentBandSize = (segmentsPtr->lcuBandCount * (segmentBandIndex + 1) + segmentsPtr->segmentBandCount - 1) / segmentsPtr->segmentBandCount;
-
-            // Reset Coding Loop State
-            reset_mode_decision( // HT done
-                context_ptr->md_context,
-                picture_control_set_ptr,
+        picture_control_set_ptr,
+        context_ptr->md_context);
+
+    // SB Constants
+    sb_sz = (uint8_t)sequence_control_set_ptr->sb_size_pix;
+    lcuSizeLog2 = (uint8_t)Log2f(sb_sz);
+    context_ptr->sb_sz = sb_sz;
+    picture_width_in_sb = (sequence_control_set_ptr->luma_width + sb_sz - 1) >> lcuSizeLog2;
+    endOfRowFlag = EB_FALSE;
+    lcuRowIndexStart = lcuRowIndexCount = 0;
+    context_ptr->tot_intra_coded_area = 0;
+
+    // Segment-loop
+    while (AssignEncDecSegments(segmentsPtr, &segment_index, encDecTasksPtr, context_ptr->enc_dec_feedback_fifo_ptr) == EB_TRUE)
+    {
+        xLcuStartIndex = segmentsPtr->xStartArray[segment_index];
+        yLcuStartIndex = segmentsPtr->yStartArray[segment_index];
+        lcuStartIndex = yLcuStartIndex * picture_width_in_sb + xLcuStartIndex;
+        lcuSegmentCount = segmentsPtr->validLcuCountArray[segment_index];
+
+        segmentRowIndex = segment_index / segmentsPtr->segmentBandCount;
+        segmentBandIndex = segment_index - segmentRowIndex * segmentsPtr->segmentBandCount;
+        segmentBandSize = (segmentsPtr->lcuBandCount * (segmentBandIndex + 1) + segmentsPtr->segmentBandCount - 1) / segmentsPtr->segmentBandCount;
+
+        // With frame_row_overlap, the task stops at a segment whose reference rows
+        // are not ready and is parked on the reference until the DLF publishes them:
+        // the thread does not block on them, the reference segments coded by the
+        // same threads are then never starved
+        if (sequence_control_set_ptr->static_config.frame_row_overlap && picture_control_set_ptr->slice_type != I_SLICE) {
+            refWaitObjPtr = RefRowsLacking(
                 sequence_control_set_ptr,
-                segment_index);
-
-            // Reset EncDec Coding State
-            ResetEncDec(    // HT done
-                context_ptr,
                 picture_control_set_ptr,
-                sequence_control_set_ptr,
-                segment_index);
+                ((segmentRowIndex + 1) * segmentsPtr->lcuRowCount + segmentsPtr->segmentRowCount - 1) / segmentsPtr->segmentRowCount - 1,
+                &refWaitRowCount);
+            if (refWaitObjPtr)
+                break;
+        }
 
-            if (sequence_control_set_ptr->static_config.improve_sharpness) {
-                QpmDeriveWeightsMinAndMax(
-                    picture_control_set_ptr,
-                    context_ptr);
-            }
-            for (yLcuIndex = yLcuStartIndex, lcuSegmentIndex = lcuStartIndex; lcuSegmentIndex < lcuStartIndex + lcuSegmentCount; ++yLcuIndex) {
-                for (xLcuIndex = xLcuStartIndex; xLcuIndex < picture_width_in_sb && (xLcuIndex + yLcuIndex < segmentBandSize) && lcuSegmentIndex < lcuStartIndex + lcuSegmentCount; ++xLcuIndex, ++lcuSegmentIndex) {
-
-                    sb_index = (uint16_t)(yLcuIndex * picture_width_in_sb + xLcuIndex);
-                    sb_ptr = picture_control_set_ptr->sb_ptr_array[sb_index];
-                    sb_origin_x = xLcuIndex << lcuSizeLog2;
-                    sb_origin_y = yLcuIndex << lcuSizeLog2;
-                    lastLcuFlag = (sb_index == sequence_control_set_ptr->sb_tot_cnt - 1) ? EB_TRUE : EB_FALSE;
-                    endOfRowFlag = (xLcuIndex == picture_width_in_sb - 1) ? EB_TRUE : EB_FALSE;
-                    lcuRowIndexStart = (xLcuIndex == picture_width_in_sb - 1 && lcuRowIndexCount == 0) ? yLcuIndex : lcuRowIndexStart;
-                    lcuRowIndexCount = (xLcuIndex == picture_width_in_sb - 1) ? lcuRowIndexCount + 1 : lcuRowIndexCount;
-                    mdcPtr = &picture_control_set_ptr->mdc_sb_array[sb_index];
-                    context_ptr->sb_index = sb_index;
-                    context_ptr->md_context->cu_use_ref_src_flag = (picture_control_set_ptr->parent_pcs_ptr->use_src_ref) && (picture_control_set_ptr->parent_pcs_ptr->edge_results_ptr[sb_index].edge_block_num == EB_FALSE || picture_control_set_ptr->parent_pcs_ptr->sb_flat_noise_array[sb_index]) ? EB_TRUE : EB_FALSE;
-
-                    // Configure the LCU
-                    ModeDecisionConfigureLcu(
-                        context_ptr->md_context,
-                        sb_ptr,
-                        picture_control_set_ptr,
-                        sequence_control_set_ptr,
-                        (uint8_t)context_ptr->qp,
-                        (uint8_t)sb_ptr->qp);
+        // Reset Coding Loop State
+        reset_mode_decision( // HT done
+            context_ptr->md_context,
+            picture_control_set_ptr,
+            sequence_control_set_ptr,
+            segment_index);
 
-                    uint32_t lcuRow;
-                    if (picture_control_set_ptr->parent_pcs_ptr->enable_in_loop_motion_estimation_flag) {
+        // Reset EncDec Coding State
+        ResetEncDec(    // HT done
+            context_ptr,
+            picture_control_set_ptr,
+            sequence_control_set_ptr,
+            segment_index);
 
-                        EbPictureBufferDesc_t       *input_picture_ptr;
+        if (sequence_control_set_ptr->static_config.improve_sharpness) {
+            QpmDeriveWeightsMinAndMax(
+                picture_control_set_ptr,
+                context_ptr);
+        }
+        for (yLcuIndex = yLcuStartIndex, lcuSegmentIndex = lcuStartIndex; lcuSegmentIndex < lcuStartIndex + lcuSegmentCount; ++yLcuIndex) {
+            for (xLcuIndex = xLcuStartIndex; xLcuIndex < picture_width_in_sb && (xLcuIndex + yLcuIndex < segmentBandSize) && lcuSegmentIndex < lcuStartIndex + lcuSegmentCount; ++xLcuIndex, ++lcuSegmentIndex) {
+
+                sb_index = (uint16_t)(yLcuIndex * picture_width_in_sb + xLcuIndex);
+                sb_ptr = picture_control_set_ptr->sb_ptr_array[sb_index];
+                sb_origin_x = xLcuIndex << lcuSizeLog2;
+                sb_origin_y = yLcuIndex << lcuSizeLog2;
+                lastLcuFlag = (sb_index == sequence_control_set_ptr->sb_tot_cnt - 1) ? EB_TRUE : EB_FALSE;
+                endOfRowFlag = (xLcuIndex == picture_width_in_sb - 1) ? EB_TRUE : EB_FALSE;
+                lcuRowIndexStart = (xLcuIndex == picture_width_in_sb - 1 && lcuRowIndexCount == 0) ? yLcuIndex : lcuRowIndexStart;
+                lcuRowIndexCount = (xLcuIndex == picture_width_in_sb - 1) ? lcuRowIndexCount + 1 : lcuRowIndexCount;
+                mdcPtr = &picture_control_set_ptr->mdc_sb_array[sb_index];
+                context_ptr->sb_index = sb_index;
+                context_ptr->md_context->cu_use_ref_src_flag = (picture_control_set_ptr->parent_pcs_ptr->use_src_ref) && (picture_control_set_ptr->parent_pcs_ptr->edge_results_ptr[sb_index].edge_block_num == EB_FALSE || picture_control_set_ptr->parent_pcs_ptr->sb_flat_noise_array[sb_index]) ? EB_TRUE : EB_FALSE;
+
+                // Configure the LCU
+                ModeDecisionConfigureLcu(
+                    context_ptr->md_context,
+                    sb_ptr,
+                    picture_control_set_ptr,
+                    sequence_control_set_ptr,
+                    (uint8_t)context_ptr->qp,
+                    (uint8_t)sb_ptr->qp);
 
-                        input_picture_ptr = picture_control_set_ptr->parent_pcs_ptr->enhanced_picture_ptr;
+                uint32_t lcuRow;
+                if (picture_control_set_ptr->parent_pcs_ptr->enable_in_loop_motion_estimation_flag && !picture_control_set_ptr->parent_pcs_ptr->static_sb_array[sb_index]) {
 
-                        // Load the SB from the input to the intermediate SB buffer
-                        uint32_t bufferIndex = (input_picture_ptr->origin_y + sb_origin_y) * input_picture_ptr->stride_y + input_picture_ptr->origin_x + sb_origin_x;
+                    EbPictureBufferDesc_t       *input_picture_ptr;
 
-                        // Copy the source superblock to the me local buffer
-                        uint32_t sb_height = (sequence_control_set_ptr->luma_height - sb_origin_y) < MAX_SB_SIZE ? sequence_control_set_ptr->luma_height - sb_origin_y : MAX_SB_SIZE;
-                        uint32_t sb_width = (sequence_control_set_ptr->luma_width - sb_origin_x) < MAX_SB_SIZE ? sequence_control_set_ptr->luma_width - sb_origin_x : MAX_SB_SIZE;
-                        uint32_t is_complete_sb = sequence_control_set_ptr->sb_geom[sb_index].is_complete_sb;
+                    input_picture_ptr = picture_control_set_ptr->parent_pcs_ptr->enhanced_picture_ptr;
 
-                        if (!is_complete_sb) {
-                            memset(context_ptr->ss_mecontext->sb_buffer, 0, MAX_SB_SIZE*MAX_SB_SIZE);
-                        }
-                        for (lcuRow = 0; lcuRow < sb_height; lcuRow++) {
-                            EB_MEMCPY((&(context_ptr->ss_mecontext->sb_buffer[lcuRow * MAX_SB_SIZE])), (&(input_picture_ptr->buffer_y[bufferIndex + lcuRow * input_picture_ptr->stride_y])), sb_width * sizeof(uint8_t));
-                        }
+                    // Load the SB from the input to the intermediate SB buffer
+                    uint32_t bufferIndex = (input_picture_ptr->origin_y + sb_origin_y) * input_picture_ptr->stride_y + input_picture_ptr->origin_x + sb_origin_x;
 
-                        context_ptr->ss_mecontext->sb_src_ptr = &(context_ptr->ss_mecontext->sb_buffer[0]);
-                        context_ptr->ss_mecontext->sb_src_stride = context_ptr->ss_mecontext->sb_buffer_stride;
-                        // Set in-loop ME Search Area
-                        int16_t mv_l0_x;
-                        int16_t mv_l0_y;
-                        int16_t mv_l1_x;
-                        int16_t mv_l1_y;
-                        uint32_t me_sb_addr;
-
-                        if (sequence_control_set_ptr->sb_size == BLOCK_128X128) {
-
-                            uint32_t me_sb_size = sequence_control_set_ptr->sb_sz;
-                            uint32_t me_pic_width_in_sb = (sequence_control_set_ptr->luma_width + me_sb_size - 1) / me_sb_size;
-                            uint32_t me_pic_height_in_sb = (sequence_control_set_ptr->luma_height + me_sb_size - 1) / me_sb_size;
-                            uint32_t me_sb_x = (sb_origin_x / me_sb_size);
-                            uint32_t me_sb_y = (sb_origin_y / me_sb_size);
-                            uint32_t me_sb_addr_0 = me_sb_x + me_sb_y * me_pic_width_in_sb;
-                            uint32_t me_sb_addr_1 = (me_sb_x + 1) < me_pic_width_in_sb ? (me_sb_x + 1) + ((me_sb_y + 0) * me_pic_width_in_sb) : me_sb_addr_0;
-                            uint32_t me_sb_addr_2 = (me_sb_y + 1) < me_pic_height_in_sb ? (me_sb_x + 0) + ((me_sb_y + 1) * me_pic_width_in_sb) : me_sb_addr_0;
-                            uint32_t me_sb_addr_3 = ((me_sb_x + 1) < me_pic_width_in_sb) && ((me_sb_y + 1) < me_pic_height_in_sb) ? (me_sb_x + 1) + ((me_sb_y + 1) * me_pic_width_in_sb) : me_sb_addr_0;
-
-                            MeCuResults_t * me_block_results_0 = &picture_control_set_ptr->parent_pcs_ptr->me_results[me_sb_addr_0][0];
-                            MeCuResults_t * me_block_results_1 = &picture_control_set_ptr->parent_pcs_ptr->me_results[me_sb_addr_1][0];
-                            MeCuResults_t * me_block_results_2 = &picture_control_set_ptr->parent_pcs_ptr->me_results[me_sb_addr_2][0];
-                            MeCuResults_t * me_block_results_3 = &picture_control_set_ptr->parent_pcs_ptr->me_results[me_sb_addr_3][0];
-
-                            // Compute average open_loop 64x64 MVs
-                            mv_l0_x = ((me_block_results_0->xMvL0 + me_block_results_1->xMvL0 + me_block_results_2->xMvL0 + me_block_results_3->xMvL0) >> 2) >> 2;
-                            mv_l0_y = ((me_block_results_0->yMvL0 + me_block_results_1->yMvL0 + me_block_results_2->yMvL0 + me_block_results_3->yMvL0) >> 2) >> 2;
-                            mv_l1_x = ((me_block_results_0->xMvL1 + me_block_results_1->xMvL1 + me_block_results_2->xMvL1 + me_block_results_3->xMvL1) >> 2) >> 2;
-                            mv_l1_y = ((me_block_results_0->yMvL1 + me_block_results_1->yMvL1 + me_block_results_2->yMvL1 + me_block_results_3->yMvL1) >> 2) >> 2;
+                    // Copy the source superblock to the me local buffer
+                    uint32_t sb_height = (sequence_control_set_ptr->luma_height - sb_origin_y) < MAX_SB_SIZE ? sequence_control_set_ptr->luma_height - sb_origin_y : MAX_SB_SIZE;
+                    uint32_t sb_width = (sequence_control_set_ptr->luma_width - sb_origin_x) < MAX_SB_SIZE ? sequence_control_set_ptr->luma_width - sb_origin_x : MAX_SB_SIZE;
+                    uint32_t is_complete_sb = sequence_control_set_ptr->sb_geom[sb_index].is_complete_sb;
 
-                        }
-                        else {
-                            me_sb_addr = sb_index;
-                            MeCuResults_t * mePuResult = &picture_control_set_ptr->parent_pcs_ptr->me_results[me_sb_addr][0];
-
-                            mv_l0_x = mePuResult->xMvL0 >> 2;
-                            mv_l0_y = mePuResult->yMvL0 >> 2;
-                            mv_l1_x = mePuResult->xMvL1 >> 2;
-                            mv_l1_y = mePuResult->yMvL1 >> 2;
-                        }
+                    if (!is_complete_sb) {
+                        memset(context_ptr->ss_mecontext->sb_buffer, 0, MAX_SB_SIZE*MAX_SB_SIZE);
+                    }
+                    for (lcuRow = 0; lcuRow < sb_height; lcuRow++) {
+                        EB_MEMCPY((&(context_ptr->ss_mecontext->sb_buffer[lcuRow * MAX_SB_SIZE])), (&(input_picture_ptr->buffer_y[bufferIndex + lcuRow * input_picture_ptr->stride_y])), sb_width * sizeof(uint8_t));
+                    }
 
+                    context_ptr->ss_mecontext->sb_src_ptr = &(context_ptr->ss_mecontext->sb_buffer[0]);
+                    context_ptr->ss_mecontext->sb_src_stride = context_ptr->ss_mecontext->sb_buffer_stride;
+                    // Set in-loop ME Search Area
+                    int16_t mv_l0_x;
+                    int16_t mv_l0_y;
+                    int16_t mv_l1_x;
+                    int16_t mv_l1_y;
+                    uint32_t me_sb_addr;
+
+                    if (sequence_control_set_ptr->sb_size == BLOCK_128X128) {
+
+                        uint32_t me_sb_size = sequence_control_set_ptr->sb_sz;
+                        uint32_t me_pic_width_in_sb = (sequence_control_set_ptr->luma_width + me_sb_size - 1) / me_sb_size;
+                        uint32_t me_pic_height_in_sb = (sequence_control_set_ptr->luma_height + me_sb_size - 1) / me_sb_size;
+                        uint32_t me_sb_x = (sb_origin_x / me_sb_size);
+                        uint32_t me_sb_y = (sb_origin_y / me_sb_size);
+                        uint32_t me_sb_addr_0 = me_sb_x + me_sb_y * me_pic_width_in_sb;
+                        uint32_t me_sb_addr_1 = (me_sb_x + 1) < me_pic_width_in_sb ? (me_sb_x + 1) + ((me_sb_y + 0) * me_pic_width_in_sb) : me_sb_addr_0;
+                        uint32_t me_sb_addr_2 = (me_sb_y + 1) < me_pic_height_in_sb ? (me_sb_x + 0) + ((me_sb_y + 1) * me_pic_width_in_sb) : me_sb_addr_0;
+                        uint32_t me_sb_addr_3 = ((me_sb_x + 1) < me_pic_width_in_sb) && ((me_sb_y + 1) < me_pic_height_in_sb) ? (me_sb_x + 1) + ((me_sb_y + 1) * me_pic_width_in_sb) : me_sb_addr_0;
+
+                        MeCuResults_t * me_block_results_0 = &picture_control_set_ptr->parent_pcs_ptr->me_results[me_sb_addr_0][0];
+                        MeCuResults_t * me_block_results_1 = &picture_control_set_ptr->parent_pcs_ptr->me_results[me_sb_addr_1][0];
+                        MeCuResults_t * me_block_results_2 = &picture_control_set_ptr->parent_pcs_ptr->me_results[me_sb_addr_2][0];
+                        MeCuResults_t * me_block_results_3 = &picture_control_set_ptr->parent_pcs_ptr->me_results[me_sb_addr_3][0];
+
+                        // Compute average open_loop 64x64 MVs
+                        mv_l0_x = ((me_block_results_0->xMvL0 + me_block_results_1->xMvL0 + me_block_results_2->xMvL0 + me_block_results_3->xMvL0) >> 2) >> 2;
+                        mv_l0_y = ((me_block_results_0->yMvL0 + me_block_results_1->yMvL0 + me_block_results_2->yMvL0 + me_block_results_3->yMvL0) >> 2) >> 2;
+                        mv_l1_x = ((me_block_results_0->xMvL1 + me_block_results_1->xMvL1 + me_block_results_2->xMvL1 + me_block_results_3->xMvL1) >> 2) >> 2;
+                        mv_l1_y = ((me_block_results_0->yMvL1 + me_block_results_1->yMvL1 + me_block_results_2->yMvL1 + me_block_results_3->yMvL1) >> 2) >> 2;
 
-                        context_ptr->ss_mecontext->search_area_width = 64;
-                        context_ptr->ss_mecontext->search_area_height = 64;
+                    }
+                    else {
+                        me_sb_addr = sb_index;
+                        MeCuResults_t * mePuResult = &picture_control_set_ptr->parent_pcs_ptr->me_results[me_sb_addr][0];
 
-                        // perform in-loop ME
-                        in_loop_motion_estimation_sblock(
-                            picture_control_set_ptr,
-                            sb_origin_x,
-                            sb_origin_y,
-                            mv_l0_x,
-                            mv_l0_y,
-                            mv_l1_x,
-                            mv_l1_y,
-                            context_ptr->ss_mecontext);
+                        mv_l0_x = mePuResult->xMvL0 >> 2;
+                        mv_l0_y = mePuResult->yMvL0 >> 2;
+                        mv_l1_x = mePuResult->xMvL1 >> 2;
+                        mv_l1_y = mePuResult->yMvL1 >> 2;
                     }
 
-                    mode_decision_sb(
-                        sequence_control_set_ptr,
+
+                    context_ptr->ss_mecontext->search_area_width = 64;
+                    context_ptr->ss_mecontext->search_area_height = 64;
+
+                    // perform in-loop ME
+                    in_loop_motion_estimation_sblock(
                         picture_control_set_ptr,
-                        mdcPtr,
-                        sb_ptr,
                         sb_origin_x,
                         sb_origin_y,
-                        sb_index,
-                        context_ptr->ss_mecontext,
-                        context_ptr->md_context);
+                        mv_l0_x,
+                        mv_l0_y,
+                        mv_l1_x,
+                        mv_l1_y,
+                        context_ptr->ss_mecontext);
+                }
 
+                mode_decision_sb(
+                    sequence_control_set_ptr,
+                    picture_control_set_ptr,
+                    mdcPtr,
+                    sb_ptr,
+                    sb_origin_x,
+                    sb_origin_y,
+                    sb_index,
+                    context_ptr->ss_mecontext,
+                    context_ptr->md_context);
 
-                    // Configure the LCU
-                    EncDecConfigureLcu(
-                        context_ptr,
-                        sb_ptr,
-                        picture_control_set_ptr,
-                        sequence_control_set_ptr,
-                        (uint8_t)context_ptr->qp,
-                        (uint8_t)sb_ptr->qp);
+
+                // Configure the LCU
+                EncDecConfigureLcu(
+                    context_ptr,
+                    sb_ptr,
+                    picture_control_set_ptr,
+                    sequence_control_set_ptr,
+                    (uint8_t)context_ptr->qp,
+                    (uint8_t)sb_ptr->qp);
 
 #if NO_ENCDEC
-                    no_enc_dec_pass(
-                        sequence_control_set_ptr,
-                        picture_control_set_ptr,
-                        sb_ptr,
-                        sb_index,
-                        sb_origin_x,
-                        sb_origin_y,
-                        sb_ptr->qp,
-                        context_ptr);
+                no_enc_dec_pass(
+                    sequence_control_set_ptr,
+                    picture_control_set_ptr,
+                    sb_ptr,
+                    sb_index,
+                    sb_origin_x,
+                    sb_origin_y,
+                    sb_ptr->qp,
+                    context_ptr);
 #else
-                    // Encode Pass
-                    AV1EncodePass(
+                // Encode Pass
+                AV1EncodePass(
+                    sequence_control_set_ptr,
+                    picture_control_set_ptr,
+                    sb_ptr,
+                    sb_index,
+                    sb_origin_x,
+                    sb_origin_y,
+                    sb_ptr->qp,
+                    context_ptr);
+#endif
+
+                if (picture_control_set_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr != NULL) {
+                    ((EbReferenceObject_t*)picture_control_set_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr->object_ptr)->intra_coded_area_sb[sb_index] = (uint8_t)((100 * context_ptr->intra_coded_area_sb[sb_index]) / (64 * 64));
+                }
+#if FILT_PROC
+                if (dlfRowsPostedEarly) {
+                    // Counted before the rows leave, the statistics are copied once they are filtered
+                    eb_block_on_mutex(picture_control_set_ptr->intra_mutex);
+                    picture_control_set_ptr->intra_coded_area += (uint32_t)context_ptr->tot_intra_coded_area;
+                    eb_release_mutex(picture_control_set_ptr->intra_mutex);
+                    context_ptr->tot_intra_coded_area = 0;
+
+                    EncDecSbDone(
+                        context_ptr,
                         sequence_control_set_ptr,
                         picture_control_set_ptr,
-                        sb_ptr,
-                        sb_index,
-                        sb_origin_x,
-                        sb_origin_y,
-                        sb_ptr->qp,
-                        context_ptr);
+                        encDecTasksPtr->pictureControlSetWrapperPtr,
+                        yLcuIndex,
+                        picture_width_in_sb);
+                }
 #endif
 
-                    if (picture_control_set_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr != NULL) {
-                        ((EbReferenceObject_t*)picture_control_set_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr->object_ptr)->intra_coded_area_sb[sb_index] = (uint8_t)((100 * context_ptr->intra_coded_area_sb[sb_index]) / (64 * 64));
-                    }
-
-                }
-                xLcuStartIndex = (xLcuStartIndex > 0) ? xLcuStartIndex - 1 : 0;
             }
+            xLcuStartIndex = (xLcuStartIndex > 0) ? xLcuStartIndex - 1 : 0;
         }
+    }
 
-        eb_block_on_mutex(picture_control_set_ptr->intra_mutex);
-        picture_control_set_ptr->intra_coded_area += (uint32_t)context_ptr->tot_intra_coded_area;
-        eb_release_mutex(picture_control_set_ptr->intra_mutex);
+    eb_block_on_mutex(picture_control_set_ptr->intra_mutex);
+    picture_control_set_ptr->intra_coded_area += (uint32_t)context_ptr->tot_intra_coded_area;
+    eb_release_mutex(picture_control_set_ptr->intra_mutex);
 
-        if (lastLcuFlag) {
+    if (lastLcuFlag) {
 
-            // Copy film grain data from parent picture set to the reference object for further reference
-            if (sequence_control_set_ptr->film_grain_params_present)
-            {
+        // Copy film grain data from parent picture set to the reference object for further reference
+        // (done with the last row when the rows are posted early)
+#if FILT_PROC
+        if (sequence_control_set_ptr->film_grain_params_present && !dlfRowsPostedEarly)
+#else
+        if (sequence_control_set_ptr->film_grain_params_present && !sequence_control_set_ptr->static_config.frame_row_overlap)
+#endif
+        {
 
-                if (picture_control_set_ptr->parent_pcs_ptr->is_used_as_reference_flag == EB_TRUE && picture_control_set_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr) {
+            if (picture_control_set_ptr->parent_pcs_ptr->is_used_as_reference_flag == EB_TRUE && picture_control_set_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr) {
 
-                    ((EbReferenceObject_t*)picture_control_set_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr->object_ptr)->film_grain_params
-                        = picture_control_set_ptr->parent_pcs_ptr->film_grain_params;
-                }
+                ((EbReferenceObject_t*)picture_control_set_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr->object_ptr)->film_grain_params
+                    = picture_control_set_ptr->parent_pcs_ptr->film_grain_params;
             }
+        }
 #if !FILT_PROC
 #if AV1_LF
-            EbBool dlfEnableFlag = (EbBool)(picture_control_set_ptr->parent_pcs_ptr->loop_filter_mode &&
-                (picture_control_set_ptr->parent_pcs_ptr->is_used_as_reference_flag ||
-                    sequence_control_set_ptr->static_config.recon_enabled ||
-                    sequence_control_set_ptr->static_config.stat_report));
-
-            if (dlfEnableFlag && picture_control_set_ptr->parent_pcs_ptr->loop_filter_mode == 2) {
-                EbPictureBufferDesc_t  *recon_buffer = is16bit ? picture_control_set_ptr->recon_picture16bit_ptr : picture_control_set_ptr->recon_picture_ptr;
-                if (picture_control_set_ptr->parent_pcs_ptr->is_used_as_reference_flag == EB_TRUE && picture_control_set_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr) {
-
-                    //get the 16bit form of the input LCU
-                    if (is16bit) {
-                        recon_buffer = ((EbReferenceObject_t*)picture_control_set_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr->object_ptr)->referencePicture16bit;
-                    }
-                    else {
-                        recon_buffer = ((EbReferenceObject_t*)picture_control_set_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr->object_ptr)->referencePicture;
-                    }
+        EbBool dlfEnableFlag = (EbBool)(picture_control_set_ptr->parent_pcs_ptr->loop_filter_mode &&
+            (picture_control_set_ptr->parent_pcs_ptr->is_used_as_reference_flag ||
+                sequence_control_set_ptr->static_config.recon_enabled ||
+                sequence_control_set_ptr->static_config.stat_report));
+
+        if (dlfEnableFlag && picture_control_set_ptr->parent_pcs_ptr->loop_filter_mode == 2) {
+            EbPictureBufferDesc_t  *recon_buffer = is16bit ? picture_control_set_ptr->recon_picture16bit_ptr : picture_control_set_ptr->recon_picture_ptr;
+            if (picture_control_set_ptr->parent_pcs_ptr->is_used_as_reference_flag == EB_TRUE && picture_control_set_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr) {
+
+                //get the 16bit form of the input LCU
+                if (is16bit) {
+                    recon_buffer = ((EbReferenceObject_t*)picture_control_set_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr->object_ptr)->referencePicture16bit;
                 }
-                else { // non ref pictures
-                    recon_buffer = is16bit ? picture_control_set_ptr->recon_picture16bit_ptr : picture_control_set_ptr->recon_picture_ptr;
+                else {
+                    recon_buffer = ((EbReferenceObject_t*)picture_control_set_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr->object_ptr)->referencePicture;
                 }
+            }
+            else { // non ref pictures
+                recon_buffer = is16bit ? picture_control_set_ptr->recon_picture16bit_ptr : picture_control_set_ptr->recon_picture_ptr;
+            }
 
-                av1_loop_filter_init(picture_control_set_ptr);
+            av1_loop_filter_init(picture_control_set_ptr);
 
 
-                av1_pick_filter_level(
-                    context_ptr,
-                    (EbPictureBufferDesc_t*)picture_control_set_ptr->parent_pcs_ptr->enhanced_picture_ptr,
-                    picture_control_set_ptr,
-                    LPF_PICK_FROM_FULL_IMAGE);
+            av1_pick_filter_level(
+                context_ptr,
+                (EbPictureBufferDesc_t*)picture_control_set_ptr->parent_pcs_ptr->enhanced_picture_ptr,
+                picture_control_set_ptr,
+                LPF_PICK_FROM_FULL_IMAGE);
 
 #if NO_ENCDEC
-                //NO DLF
-                picture_control_set_ptr->parent_pcs_ptr->lf.filter_level[0] = 0;
-                picture_control_set_ptr->parent_pcs_ptr->lf.filter_level[1] = 0;
-                picture_control_set_ptr->parent_pcs_ptr->lf.filter_level_u = 0;
-                picture_control_set_ptr->parent_pcs_ptr->lf.filter_level_v = 0;
+            //NO DLF
+            picture_control_set_ptr->parent_pcs_ptr->lf.filter_level[0] = 0;
+            picture_control_set_ptr->parent_pcs_ptr->lf.filter_level[1] = 0;
+            picture_control_set_ptr->parent_pcs_ptr->lf.filter_level_u = 0;
+            picture_control_set_ptr->parent_pcs_ptr->lf.filter_level_v = 0;
 #endif
-                av1_loop_filter_frame(
-                    recon_buffer,
-                    picture_control_set_ptr,
-                    0,
-                    3);
-            }
+            av1_loop_filter_frame(
+                recon_buffer,
+                picture_control_set_ptr,
+                0,
+                3);
+        }
 #endif
 
 #endif
 
 #if !FILT_PROC
-            Av1Common* cm = picture_control_set_ptr->parent_pcs_ptr->av1_cm;
+        Av1Common* cm = picture_control_set_ptr->parent_pcs_ptr->av1_cm;
 
-            EbPictureBufferDesc_t  * recon_picture_ptr;
+        EbPictureBufferDesc_t  * recon_picture_ptr;
 
-            if (is16bit) {
-                if ((picture_control_set_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr != NULL) && (picture_control_set_ptr->parent_pcs_ptr->is_used_as_reference_flag == EB_TRUE))
-                    recon_picture_ptr = ((EbReferenceObject_t*)picture_control_set_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr->object_ptr)->referencePicture16bit;
-                else
-                    recon_picture_ptr = picture_control_set_ptr->recon_picture16bit_ptr;
-            }
-            else {
-                if ((picture_control_set_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr != NULL) && (picture_control_set_ptr->parent_pcs_ptr->is_used_as_reference_flag == EB_TRUE))
-                    recon_picture_ptr = ((EbReferenceObject_t*)picture_control_set_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr->object_ptr)->referencePicture;
-                else
-                    recon_picture_ptr = picture_control_set_ptr->recon_picture_ptr;
-            }
+        if (is16bit) {
+            if ((picture_control_set_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr != NULL) && (picture_control_set_ptr->parent_pcs_ptr->is_used_as_reference_flag == EB_TRUE))
+                recon_picture_ptr = ((EbReferenceObject_t*)picture_control_set_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr->object_ptr)->referencePicture16bit;
+            else
+                recon_picture_ptr = picture_control_set_ptr->recon_picture16bit_ptr;
+        }
+        else {
+            if ((picture_control_set_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr != NULL) && (picture_control_set_ptr->parent_pcs_ptr->is_used_as_reference_flag == EB_TRUE))
+                recon_picture_ptr = ((EbReferenceObject_t*)picture_control_set_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr->object_ptr)->referencePicture;
+            else
+                recon_picture_ptr = picture_control_set_ptr->recon_picture_ptr;
+        }
 
-            LinkEbToAomBufferDesc(
-                recon_picture_ptr,
-                cm->frame_to_show);
+        LinkEbToAomBufferDesc(
+            recon_picture_ptr,
+            cm->frame_to_show);
 
-            if (sequence_control_set_ptr->enable_restoration) {
-                av1_loop_restoration_save_boundary_lines(cm->frame_to_show, cm, 0);
-            }
+        if (sequence_control_set_ptr->enable_restoration) {
+            av1_loop_restoration_save_boundary_lines(cm->frame_to_show, cm, 0);
+        }
 
 
 #if CDEF_REF_ONLY
-            if (sequence_control_set_ptr->enable_cdef && picture_control_set_ptr->parent_pcs_ptr->is_used_as_reference_flag) {
+        if (sequence_control_set_ptr->enable_cdef && picture_control_set_ptr->parent_pcs_ptr->is_used_as_reference_flag) {
 #else
-            if (sequence_control_set_ptr->enable_cdef) {
+        if (sequence_control_set_ptr->enable_cdef) {
 #endif
-                if (is16bit) {
-                    av1_cdef_search16bit(
-                        context_ptr,
-                        sequence_control_set_ptr,
-                        picture_control_set_ptr
-                    );
-
-                    av1_cdef_frame16bit(
-                        context_ptr,
-                        sequence_control_set_ptr,
-                        picture_control_set_ptr
-                    );
-                }
-                else {
-                    av1_cdef_search(
-                        context_ptr,
-                        sequence_control_set_ptr,
-                        picture_control_set_ptr
-                    );
+            if (is16bit) {
+                av1_cdef_search16bit(
+                    context_ptr,
+                    sequence_control_set_ptr,
+                    picture_control_set_ptr
+                );
 
-                    av1_cdef_frame(
-                        context_ptr,
-                        sequence_control_set_ptr,
-                        picture_control_set_ptr
-                    );
-                }
+                av1_cdef_frame16bit(
+                    context_ptr,
+                    sequence_control_set_ptr,
+                    picture_control_set_ptr
+                );
             }
             else {
+                av1_cdef_search(
+                    context_ptr,
+                    sequence_control_set_ptr,
+                    picture_control_set_ptr
+                );
+
+                av1_cdef_frame(
+                    context_ptr,
+                    sequence_control_set_ptr,
+                    picture_control_set_ptr
+                );
+            }
+        }
+        else {
 
 #if CDEF_REF_ONLY
-                picture_control_set_ptr->parent_pcs_ptr->cdef_bits = 0;
-                picture_control_set_ptr->parent_pcs_ptr->cdef_strengths[0] = 0;
-                picture_control_set_ptr->parent_pcs_ptr->nb_cdef_strengths = 1;
-                picture_control_set_ptr->parent_pcs_ptr->cdef_uv_strengths[0] = 0;
+            picture_control_set_ptr->parent_pcs_ptr->cdef_bits = 0;
+            picture_control_set_ptr->parent_pcs_ptr->cdef_strengths[0] = 0;
+            picture_control_set_ptr->parent_pcs_ptr->nb_cdef_strengths = 1;
+            picture_control_set_ptr->parent_pcs_ptr->cdef_uv_strengths[0] = 0;
 #else
-                picture_control_set_ptr->parent_pcs_ptr->cdef_bits = 0;
+            picture_control_set_ptr->parent_pcs_ptr->cdef_bits = 0;
 
-                picture_control_set_ptr->parent_pcs_ptr->nb_cdef_strengths = 0;
+            picture_control_set_ptr->parent_pcs_ptr->nb_cdef_strengths = 0;
 #endif
 
 
-            }
+        }
 
 #endif
 
 
 
 #if FILT_PROC
-            EB_MEMCPY(picture_control_set_ptr->parent_pcs_ptr->av1x->sgrproj_restore_cost, context_ptr->md_rate_estimation_ptr->sgrprojRestoreFacBits, 2 * sizeof(int32_t));
-            EB_MEMCPY(picture_control_set_ptr->parent_pcs_ptr->av1x->switchable_restore_cost, context_ptr->md_rate_estimation_ptr->switchableRestoreFacBits, 3 * sizeof(int32_t));
-            EB_MEMCPY(picture_control_set_ptr->parent_pcs_ptr->av1x->wiener_restore_cost, context_ptr->md_rate_estimation_ptr->wienerRestoreFacBits, 2 * sizeof(int32_t));
-            picture_control_set_ptr->parent_pcs_ptr->av1x->rdmult = context_ptr->full_lambda;
+        EB_MEMCPY(picture_control_set_ptr->parent_pcs_ptr->av1x->sgrproj_restore_cost, context_ptr->md_rate_estimation_ptr->sgrprojRestoreFacBits, 2 * sizeof(int32_t));
+        EB_MEMCPY(picture_control_set_ptr->parent_pcs_ptr->av1x->switchable_restore_cost, context_ptr->md_rate_estimation_ptr->switchableRestoreFacBits, 3 * sizeof(int32_t));
+        EB_MEMCPY(picture_control_set_ptr->parent_pcs_ptr->av1x->wiener_restore_cost, context_ptr->md_rate_estimation_ptr->wienerRestoreFacBits, 2 * sizeof(int32_t));
+        picture_control_set_ptr->parent_pcs_ptr->av1x->rdmult = context_ptr->full_lambda;
 
 #else
 
 #if REST_REF_ONLY
-            if (sequence_control_set_ptr->enable_restoration && picture_control_set_ptr->parent_pcs_ptr->is_used_as_reference_flag) {
+        if (sequence_control_set_ptr->enable_restoration && picture_control_set_ptr->parent_pcs_ptr->is_used_as_reference_flag) {
 #else
-            if (sequence_control_set_ptr->enable_restoration) {
+        if (sequence_control_set_ptr->enable_restoration) {
 #endif
-                av1_loop_restoration_save_boundary_lines(
+            av1_loop_restoration_save_boundary_lines(
+                cm->frame_to_show,
+                cm,
+                1);
+
+            Yv12BufferConfig cpi_source;
+            LinkEbToAomBufferDesc(
+                is16bit ? picture_control_set_ptr->input_frame16bit : picture_control_set_ptr->parent_pcs_ptr->enhanced_picture_ptr,
+                &cpi_source);
+
+            Yv12BufferConfig trial_frame_rst;
+            LinkEbToAomBufferDesc(
+                context_ptr->trial_frame_rst,
+                &trial_frame_rst);
+
+            memcpy(&picture_control_set_ptr->parent_pcs_ptr->av1x->sgrproj_restore_cost, &context_ptr->md_rate_estimation_ptr->sgrprojRestoreFacBits, 2 * sizeof(int32_t));
+            memcpy(&picture_control_set_ptr->parent_pcs_ptr->av1x->switchable_restore_cost, &context_ptr->md_rate_estimation_ptr->switchableRestoreFacBits, 3 * sizeof(int32_t));
+            memcpy(&picture_control_set_ptr->parent_pcs_ptr->av1x->wiener_restore_cost, &context_ptr->md_rate_estimation_ptr->wienerRestoreFacBits, 2 * sizeof(int32_t));
+            picture_control_set_ptr->parent_pcs_ptr->av1x->rdmult = context_ptr->full_lambda;
+
+            av1_pick_filter_restoration(
+                &cpi_source,
+                &trial_frame_rst,
+                picture_control_set_ptr->parent_pcs_ptr->av1x,
+                picture_control_set_ptr->parent_pcs_ptr->av1_cm);
+
+            if (cm->rst_info[0].frame_restoration_type != RESTORE_NONE ||
+                cm->rst_info[1].frame_restoration_type != RESTORE_NONE ||
+                cm->rst_info[2].frame_restoration_type != RESTORE_NONE)
+            {
+                av1_loop_restoration_filter_frame(
                     cm->frame_to_show,
                     cm,
-                    1);
-
-                Yv12BufferConfig cpi_source;
-                LinkEbToAomBufferDesc(
-                    is16bit ? picture_control_set_ptr->input_frame16bit : picture_control_set_ptr->parent_pcs_ptr->enhanced_picture_ptr,
-                    &cpi_source);
-
-                Yv12BufferConfig trial_frame_rst;
-                LinkEbToAomBufferDesc(
-                    context_ptr->trial_frame_rst,
-                    &trial_frame_rst);
-
-                memcpy(&picture_control_set_ptr->parent_pcs_ptr->av1x->sgrproj_restore_cost, &context_ptr->md_rate_estimation_ptr->sgrprojRestoreFacBits, 2 * sizeof(int32_t));
-                memcpy(&picture_control_set_ptr->parent_pcs_ptr->av1x->switchable_restore_cost, &context_ptr->md_rate_estimation_ptr->switchableRestoreFacBits, 3 * sizeof(int32_t));
-                memcpy(&picture_control_set_ptr->parent_pcs_ptr->av1x->wiener_restore_cost, &context_ptr->md_rate_estimation_ptr->wienerRestoreFacBits, 2 * sizeof(int32_t));
-                picture_control_set_ptr->parent_pcs_ptr->av1x->rdmult = context_ptr->full_lambda;
-
-                av1_pick_filter_restoration(
-                    &cpi_source,
-                    &trial_frame_rst,
-                    picture_control_set_ptr->parent_pcs_ptr->av1x,
-                    picture_control_set_ptr->parent_pcs_ptr->av1_cm);
-
-                if (cm->rst_info[0].frame_restoration_type != RESTORE_NONE ||
-                    cm->rst_info[1].frame_restoration_type != RESTORE_NONE ||
-                    cm->rst_info[2].frame_restoration_type != RESTORE_NONE)
-                {
-                    av1_loop_restoration_filter_frame(
-                        cm->frame_to_show,
-                        cm,
-                        0);
-                }
-            }
-            else {
-                cm->rst_info[0].frame_restoration_type = RESTORE_NONE;
-                cm->rst_info[1].frame_restoration_type = RESTORE_NONE;
-                cm->rst_info[2].frame_restoration_type = RESTORE_NONE;
+                    0);
             }
+        }
+        else {
+            cm->rst_info[0].frame_restoration_type = RESTORE_NONE;
+            cm->rst_info[1].frame_restoration_type = RESTORE_NONE;
+            cm->rst_info[2].frame_restoration_type = RESTORE_NONE;
+        }
 #endif
 #if !FILT_PROC
 #if FAST_SG
-            uint8_t best_ep_cnt = 0;
-            uint8_t best_ep = 0;
-            for (uint8_t i = 0; i < SGRPROJ_PARAMS; i++) {
-                if (cm->sg_frame_ep_cnt[i] > best_ep_cnt) {
-                    best_ep = i;
-                    best_ep_cnt = picture_control_set_ptr->parent_pcs_ptr->sg_frame_ep_cnt[i];
-                }
+        uint8_t best_ep_cnt = 0;
+        uint8_t best_ep = 0;
+        for (uint8_t i = 0; i < SGRPROJ_PARAMS; i++) {
+            if (cm->sg_frame_ep_cnt[i] > best_ep_cnt) {
+                best_ep = i;
+                best_ep_cnt = picture_control_set_ptr->parent_pcs_ptr->sg_frame_ep_cnt[i];
             }
-            cm->sg_frame_ep = best_ep;
+        }
+        cm->sg_frame_ep = best_ep;
 #endif
-            if (picture_control_set_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr != NULL) {
-                // copy stat to ref object (intra_coded_area, Luminance, Scene change detection flags)
-                CopyStatisticsToRefObject(
-                    picture_control_set_ptr,
-                    sequence_control_set_ptr);
-            }
-            //printf("%3i\t%i\n", picture_control_set_ptr->picture_number, context_ptr->tot_intra_coded_area);
-
-            // PSNR Calculation
-            if (sequence_control_set_ptr->static_config.stat_report) {
-                PsnrCalculations(
-                    picture_control_set_ptr,
-                    sequence_control_set_ptr);
-            }
+        if (picture_control_set_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr != NULL) {
+            // copy stat to ref object (intra_coded_area, Luminance, Scene change detection flags)
+            CopyStatisticsToRefObject(
+                picture_control_set_ptr,
+                sequence_control_set_ptr);
+        }
+        //printf("%3i\t%i\n", picture_control_set_ptr->picture_number, context_ptr->tot_intra_coded_area);
 
-            // Pad the reference picture and set up TMVP flag and ref POC
-            if (picture_control_set_ptr->parent_pcs_ptr->is_used_as_reference_flag == EB_TRUE)
-                PadRefAndSetFlags(
-                    picture_control_set_ptr,
-                    sequence_control_set_ptr);
+        // PSNR Calculation
+        if (sequence_control_set_ptr->static_config.stat_report) {
+            PsnrCalculations(
+                picture_control_set_ptr,
+                sequence_control_set_ptr);
+        }
 
-            if (picture_control_set_ptr->parent_pcs_ptr->is_used_as_reference_flag == EB_TRUE && picture_control_set_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr)
-            {
-                EbPictureBufferDesc_t *input_picture_ptr = (EbPictureBufferDesc_t*)picture_control_set_ptr->parent_pcs_ptr->enhanced_picture_ptr;
-                const uint32_t  SrclumaOffSet = input_picture_ptr->origin_x + input_picture_ptr->origin_y    *input_picture_ptr->stride_y;
-                const uint32_t  SrccbOffset = (input_picture_ptr->origin_x >> 1) + (input_picture_ptr->origin_y >> 1)*input_picture_ptr->strideCb;
-                const uint32_t  SrccrOffset = (input_picture_ptr->origin_x >> 1) + (input_picture_ptr->origin_y >> 1)*input_picture_ptr->strideCr;
+        // Pad the reference picture and set up TMVP flag and ref POC
+        if (picture_control_set_ptr->parent_pcs_ptr->is_used_as_reference_flag == EB_TRUE)
+            PadRefAndSetFlags(
+                picture_control_set_ptr,
+                sequence_control_set_ptr);
 
-                EbReferenceObject_t   *referenceObject = (EbReferenceObject_t*)picture_control_set_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr->object_ptr;
-                EbPictureBufferDesc_t *refDenPic = referenceObject->refDenSrcPicture;
-                const uint32_t           ReflumaOffSet = refDenPic->origin_x + refDenPic->origin_y    *refDenPic->stride_y;
-                const uint32_t           RefcbOffset = (refDenPic->origin_x >> 1) + (refDenPic->origin_y >> 1)*refDenPic->strideCb;
-                const uint32_t           RefcrOffset = (refDenPic->origin_x >> 1) + (refDenPic->origin_y >> 1)*refDenPic->strideCr;
+        if (picture_control_set_ptr->parent_pcs_ptr->is_used_as_reference_flag == EB_TRUE && picture_control_set_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr)
+        {
+            EbPictureBufferDesc_t *input_picture_ptr = (EbPictureBufferDesc_t*)picture_control_set_ptr->parent_pcs_ptr->enhanced_picture_ptr;
+            const uint32_t  SrclumaOffSet = input_picture_ptr->origin_x + input_picture_ptr->origin_y    *input_picture_ptr->stride_y;
+            const uint32_t  SrccbOffset = (input_picture_ptr->origin_x >> 1) + (input_picture_ptr->origin_y >> 1)*input_picture_ptr->strideCb;
+            const uint32_t  SrccrOffset = (input_picture_ptr->origin_x >> 1) + (input_picture_ptr->origin_y >> 1)*input_picture_ptr->strideCr;
 
-                uint16_t  verticalIdx;
+            EbReferenceObject_t   *referenceObject = (EbReferenceObject_t*)picture_control_set_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr->object_ptr;
+            EbPictureBufferDesc_t *refDenPic = referenceObject->refDenSrcPicture;
+            const uint32_t           ReflumaOffSet = refDenPic->origin_x + refDenPic->origin_y    *refDenPic->stride_y;
+            const uint32_t           RefcbOffset = (refDenPic->origin_x >> 1) + (refDenPic->origin_y >> 1)*refDenPic->strideCb;
+            const uint32_t           RefcrOffset = (refDenPic->origin_x >> 1) + (refDenPic->origin_y >> 1)*refDenPic->strideCr;
 
-                for (verticalIdx = 0; verticalIdx < refDenPic->height; ++verticalIdx)
-                {
-                    EB_MEMCPY(refDenPic->buffer_y + ReflumaOffSet + verticalIdx * refDenPic->stride_y,
-                        input_picture_ptr->buffer_y + SrclumaOffSet + verticalIdx * input_picture_ptr->stride_y,
-                        input_picture_ptr->width);
-                }
+            uint16_t  verticalIdx;
 
-                for (verticalIdx = 0; verticalIdx < input_picture_ptr->height / 2; ++verticalIdx)
-                {
-                    EB_MEMCPY(refDenPic->bufferCb + RefcbOffset + verticalIdx * refDenPic->strideCb,
-                        input_picture_ptr->bufferCb + SrccbOffset + verticalIdx * input_picture_ptr->strideCb,
-                        input_picture_ptr->width / 2);
+            for (verticalIdx = 0; verticalIdx < refDenPic->height; ++verticalIdx)
+            {
+                EB_MEMCPY(refDenPic->buffer_y + ReflumaOffSet + verticalIdx * refDenPic->stride_y,
+                    input_picture_ptr->buffer_y + SrclumaOffSet + verticalIdx * input_picture_ptr->stride_y,
+                    input_picture_ptr->width);
+            }
 
-                    EB_MEMCPY(refDenPic->bufferCr + RefcrOffset + verticalIdx * refDenPic->strideCr,
-                        input_picture_ptr->bufferCr + SrccrOffset + verticalIdx * input_picture_ptr->strideCr,
-                        input_picture_ptr->width / 2);
-                }
+            for (verticalIdx = 0; verticalIdx < input_picture_ptr->height / 2; ++verticalIdx)
+            {
+                EB_MEMCPY(refDenPic->bufferCb + RefcbOffset + verticalIdx * refDenPic->strideCb,
+                    input_picture_ptr->bufferCb + SrccbOffset + verticalIdx * input_picture_ptr->strideCb,
+                    input_picture_ptr->width / 2);
 
-                generate_padding(
-                    refDenPic->buffer_y,
-                    refDenPic->stride_y,
-                    refDenPic->width,
-                    refDenPic->height,
-                    refDenPic->origin_x,
-                    refDenPic->origin_y);
-
-                generate_padding(
-                    refDenPic->bufferCb,
-                    refDenPic->strideCb,
-                    refDenPic->width >> 1,
-                    refDenPic->height >> 1,
-                    refDenPic->origin_x >> 1,
-                    refDenPic->origin_y >> 1);
-
-                generate_padding(
-                    refDenPic->bufferCr,
-                    refDenPic->strideCr,
-                    refDenPic->width >> 1,
-                    refDenPic->height >> 1,
-                    refDenPic->origin_x >> 1,
-                    refDenPic->origin_y >> 1);
-            }
-            if (sequence_control_set_ptr->static_config.recon_enabled) {
-                ReconOutput(
-                    picture_control_set_ptr,
-                    sequence_control_set_ptr);
+                EB_MEMCPY(refDenPic->bufferCr + RefcrOffset + verticalIdx * refDenPic->strideCr,
+                    input_picture_ptr->bufferCr + SrccrOffset + verticalIdx * input_picture_ptr->strideCr,
+                    input_picture_ptr->width / 2);
             }
+
+            generate_padding(
+                refDenPic->buffer_y,
+                refDenPic->stride_y,
+                refDenPic->width,
+                refDenPic->height,
+                refDenPic->origin_x,
+                refDenPic->origin_y);
+
+            generate_padding(
+                refDenPic->bufferCb,
+                refDenPic->strideCb,
+                refDenPic->width >> 1,
+                refDenPic->height >> 1,
+                refDenPic->origin_x >> 1,
+                refDenPic->origin_y >> 1);
+
+            generate_padding(
+                refDenPic->bufferCr,
+                refDenPic->strideCr,
+                refDenPic->width >> 1,
+                refDenPic->height >> 1,
+                refDenPic->origin_x >> 1,
+                refDenPic->origin_y >> 1);
+        }
+        if (sequence_control_set_ptr->static_config.recon_enabled) {
+            ReconOutput(
+                picture_control_set_ptr,
+                sequence_control_set_ptr);
+        }
 #endif
 #if !FILT_PROC
-            if (picture_control_set_ptr->parent_pcs_ptr->is_used_as_reference_flag) {
+        if (picture_control_set_ptr->parent_pcs_ptr->is_used_as_reference_flag) {
 
-                // Get Empty EntropyCoding Results
-                eb_get_empty_object(
-                    context_ptr->picture_demux_output_fifo_ptr,
-                    &pictureDemuxResultsWrapperPtr);
+            // Get Empty EntropyCoding Results
+            eb_get_empty_object(
+                context_ptr->picture_demux_output_fifo_ptr,
+                &pictureDemuxResultsWrapperPtr);
 
-                pictureDemuxResultsPtr = (PictureDemuxResults_t*)pictureDemuxResultsWrapperPtr->object_ptr;
-                pictureDemuxResultsPtr->reference_picture_wrapper_ptr = picture_control_set_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr;
-                pictureDemuxResultsPtr->sequence_control_set_wrapper_ptr = picture_control_set_ptr->sequence_control_set_wrapper_ptr;
-                pictureDemuxResultsPtr->picture_number = picture_control_set_ptr->picture_number;
-                pictureDemuxResultsPtr->pictureType = EB_PIC_REFERENCE;
+            pictureDemuxResultsPtr = (PictureDemuxResults_t*)pictureDemuxResultsWrapperPtr->object_ptr;
+            pictureDemuxResultsPtr->reference_picture_wrapper_ptr = picture_control_set_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr;
+            pictureDemuxResultsPtr->sequence_control_set_wrapper_ptr = picture_control_set_ptr->sequence_control_set_wrapper_ptr;
+            pictureDemuxResultsPtr->picture_number = picture_control_set_ptr->picture_number;
+            pictureDemuxResultsPtr->pictureType = EB_PIC_REFERENCE;
 
-                // Post Reference Picture
-                eb_post_full_object(pictureDemuxResultsWrapperPtr);
-            }
+            // Post Reference Picture
+            eb_post_full_object(pictureDemuxResultsWrapperPtr);
+        }
 #endif
 
-        }
+    }
 
 
 
 #if FILT_PROC
-        if (lastLcuFlag)
-        {
+    if (lastLcuFlag && !dlfRowsPostedEarly)
+    {
+        // One DLF task per SB row, the filter levels are searched on the whole picture
+        uint32_t sbRowIndex;
+        uint32_t sbRowCount = ((sequence_control_set_ptr->luma_height + sequence_control_set_ptr->sb_size_pix - 1) >> lcuSizeLog2);
+
+        for (sbRowIndex = 0; sbRowIndex < sbRowCount; ++sbRowIndex) {
 
             // Get Empty EncDec Results
             eb_get_empty_object(
@@ -1985,34 +2183,18 @@ void* EncDecKernel(void *input_ptr)
                 &encDecResultsWrapperPtr);
             encDecResultsPtr = (EncDecResults_t*)encDecResultsWrapperPtr->object_ptr;
             encDecResultsPtr->pictureControlSetWrapperPtr = encDecTasksPtr->pictureControlSetWrapperPtr;
-            //CHKN these are not needed for DLF
-            encDecResultsPtr->completedLcuRowIndexStart = 0;
-            encDecResultsPtr->completedLcuRowCount = ((sequence_control_set_ptr->luma_height + sequence_control_set_ptr->sb_size_pix - 1) >> lcuSizeLog2);
+            encDecResultsPtr->completedLcuRowIndexStart = sbRowIndex;
+            encDecResultsPtr->completedLcuRowCount = 1;
             // Post EncDec Results
             eb_post_full_object(encDecResultsWrapperPtr);
-
         }
+
+    }
 #else
-        // Send the Entropy Coder incremental updates as each SB row becomes available
-        if (enableEcRows)
-        {
-            if (endOfRowFlag == EB_TRUE) {
-
-                // Get Empty EncDec Results
-                eb_get_empty_object(
-                    context_ptr->enc_dec_output_fifo_ptr,
-                    &encDecResultsWrapperPtr);
-                encDecResultsPtr = (EncDecResults_t*)encDecResultsWrapperPtr->object_ptr;
-                encDecResultsPtr->pictureControlSetWrapperPtr = encDecTasksPtr->pictureControlSetWrapperPtr;
-                encDecResultsPtr->completedLcuRowIndexStart = lcuRowIndexStart;
-                encDecResultsPtr->completedLcuRowCount = lcuRowIndexCount;
-
-                // Post EncDec Results
-                eb_post_full_object(encDecResultsWrapperPtr);
-            }
-        }
-        else if (lastLcuFlag)
-        {
+    // Send the Entropy Coder incremental updates as each SB row becomes available
+    if (enableEcRows)
+    {
+        if (endOfRowFlag == EB_TRUE) {
 
             // Get Empty EncDec Results
             eb_get_empty_object(
@@ -2020,17 +2202,64 @@ void* EncDecKernel(void *input_ptr)
                 &encDecResultsWrapperPtr);
             encDecResultsPtr = (EncDecResults_t*)encDecResultsWrapperPtr->object_ptr;
             encDecResultsPtr->pictureControlSetWrapperPtr = encDecTasksPtr->pictureControlSetWrapperPtr;
-            encDecResultsPtr->completedLcuRowIndexStart = 0;
-            encDecResultsPtr->completedLcuRowCount = ((sequence_control_set_ptr->luma_height + sequence_control_set_ptr->sb_size_pix - 1) >> lcuSizeLog2);
+            encDecResultsPtr->completedLcuRowIndexStart = lcuRowIndexStart;
+            encDecResultsPtr->completedLcuRowCount = lcuRowIndexCount;
+
             // Post EncDec Results
             eb_post_full_object(encDecResultsWrapperPtr);
-
         }
+    }
+    else if (lastLcuFlag)
+    {
+
+        // Get Empty EncDec Results
+        eb_get_empty_object(
+            context_ptr->enc_dec_output_fifo_ptr,
+            &encDecResultsWrapperPtr);
+        encDecResultsPtr = (EncDecResults_t*)encDecResultsWrapperPtr->object_ptr;
+        encDecResultsPtr->pictureControlSetWrapperPtr = encDecTasksPtr->pictureControlSetWrapperPtr;
+        encDecResultsPtr->completedLcuRowIndexStart = 0;
+        encDecResultsPtr->completedLcuRowCount = ((sequence_control_set_ptr->luma_height + sequence_control_set_ptr->sb_size_pix - 1) >> lcuSizeLog2);
+        // Post EncDec Results
+        eb_post_full_object(encDecResultsWrapperPtr);
+
+    }
 #endif
-        // Release Mode Decision Results
-        eb_release_object(encDecTasksWrapperPtr);
+    // The task waiting on reference rows is reused to resume its segment: parked,
+    //   or posted back right away if the rows were published in the meantime
+    if (refWaitObjPtr) {
+        encDecTasksPtr->inputType = ENCDEC_TASKS_REF_WAIT;
+        encDecTasksPtr->enc_dec_segment_index = segment_index;
+        encDecTasksPtr->ref_wait_row_count = refWaitRowCount;
+        if (ParkOnRefRows(refWaitObjPtr, encDecTasksWrapperPtr) == EB_FALSE)
+            eb_post_full_object(encDecTasksWrapperPtr);
+        return;
+    }
 
+    // Release Mode Decision Results
+    eb_release_object(encDecTasksWrapperPtr);
+}
+
+/******************************************************
+ * EncDec Kernel
+ ******************************************************/
+void* EncDecKernel(void *input_ptr)
+{
+    EncDecContext_t *context_ptr = (EncDecContext_t*)input_ptr;
+    EbObjectWrapper_t *encDecTasksWrapperPtr;
+
+    for (;;) {
+
+        // Get Mode Decision Results
+        eb_get_full_object(
+            context_ptr->mode_decision_input_fifo_ptr,
+            &encDecTasksWrapperPtr);
+
+        EncDecKernelTask(
+            context_ptr,
+            encDecTasksWrapperPtr);
     }
+
     return EB_NULL;
 }
 
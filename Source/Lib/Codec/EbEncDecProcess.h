@@ -158,6 +158,10 @@ extern "C" {
 
     extern void* EncDecKernel(void *input_ptr);
 
+    extern void EncDecKernelTask(
+        EbPtr                                    input_ptr,
+        EbObjectWrapper_t                       *encDecTasksWrapperPtr);
+
 #ifdef __cplusplus
 }
 #endif
@@ -19,6 +19,9 @@ extern "C" {
         EbObjectWrapper_t      *pictureControlSetWrapperPtr;
         uint32_t                  completedLcuRowIndexStart;
         uint32_t                  completedLcuRowCount;
+#if TILES
+        uint32_t                  tile_index;                   // entropy coding tile, see RestResults_t
+#endif
 
     } EncDecResults_t;
 
@@ -46,6 +49,9 @@ extern "C" {
         EbObjectWrapper_t      *picture_control_set_wrapper_ptr;
         uint32_t                  completed_lcu_row_index_start;
         uint32_t                  completed_lcu_row_count;
+#if TILES
+        uint32_t                  tile_index;                   // tile to entropy code when the picture tiles are coded in parallel
+#endif
 
     } RestResults_t;
 #endif
@@ -14,6 +14,7 @@ extern "C" {
 #define ENCDEC_TASKS_MDC_INPUT      0
 #define ENCDEC_TASKS_ENCDEC_INPUT   1
 #define ENCDEC_TASKS_CONTINUE       2
+#define ENCDEC_TASKS_REF_WAIT       3   // segment put back until its reference rows are ready (frame_row_overlap)
 
     /**************************************
      * Process Results
@@ -23,6 +24,8 @@ extern "C" {
         EbObjectWrapper_t            *pictureControlSetWrapperPtr;
         uint32_t                        inputType;
         int16_t                        enc_dec_segment_row;
+        uint16_t                       enc_dec_segment_index;  // ENCDEC_TASKS_REF_WAIT only
+        int32_t                        ref_wait_row_count;     // ENCDEC_TASKS_REF_WAIT only, reference rows the segment waits for
 
     } EncDecTasks_t;
 
@@ -83,6 +83,8 @@
 #include "EbEncDecProcess.h"
 #include "EbEntropyCodingProcess.h"
 #include "EbPacketizationProcess.h"
+#include "EbThreadPool.h"
+#include "EbPipelineProfiler.h"
 #include "EbResourceCoordinationResults.h"
 #include "EbPictureAnalysisResults.h"
 #include "EbPictureDecisionResults.h"
@@ -152,21 +154,16 @@
  * Globals
  **************************************/
 
-EbMemoryMapEntry                 *memory_map;
-uint32_t                         *memory_map_index;
-uint64_t                         *total_lib_memory;
-
-uint32_t                         libMallocCount = 0;
-uint32_t                         lib_thread_count = 0;
-uint32_t                         libSemaphoreCount = 0;
-uint32_t                         libMutexCount = 0;
+EB_THREAD_LOCAL EbMemoryMap     *memory_map;
 
 uint8_t                          num_groups = 0;
 #ifdef _WIN32
-GROUP_AFFINITY                   group_affinity;
-EbBool                           alternate_groups = 0;
+EB_THREAD_LOCAL GROUP_AFFINITY   group_affinity;
+EB_THREAD_LOCAL EbBool           alternate_groups = 0;
+static INIT_ONCE                 processor_groups_once = INIT_ONCE_STATIC_INIT;
 #else
-cpu_set_t                        group_affinity;
+EB_THREAD_LOCAL cpu_set_t        group_affinity;
+static pthread_once_t            processor_groups_once = PTHREAD_ONCE_INIT;
 typedef struct logicalProcessorGroup {
     uint32_t num;
     uint32_t group[1024];
@@ -209,6 +206,17 @@ int32_t CheckXcr0Ymm()
 #endif
     return ((xcr0 & 6) == 6); /* checking if xmm and ymm state are enabled in XCR0 */
 }
+int32_t CheckXcr0Zmm()
+{
+    uint32_t xcr0;
+    uint32_t zmm_ymm_xmm = (7 << 5) | (1 << 2) | (1 << 1);
+#if defined(_MSC_VER)
+    xcr0 = (uint32_t)_xgetbv(0);  /* min VS2010 SP1 compiler is required */
+#else
+    __asm__("xgetbv" : "=a" (xcr0) : "c" (0) : "%edx");
+#endif
+    return ((xcr0 & zmm_ymm_xmm) == zmm_ymm_xmm); /* checking if opmask, zmm, ymm and xmm state are enabled in XCR0 */
+}
 int32_t Check4thGenIntelCoreFeatures()
 {
     int32_t abcd[4];
@@ -245,11 +253,42 @@ static int32_t CanUseIntelCore4thGenFeatures()
         the_4th_gen_features_available = Check4thGenIntelCoreFeatures();
     return the_4th_gen_features_available;
 }
+int32_t CheckAvx512Features()
+{
+    int32_t abcd[4];
+    int32_t avx512_f_dq_cd_bw_vl_mask = (1 << 16) | (1 << 17) | (1 << 28) | (1 << 30) | (1 << 31);
+
+    if (!Check4thGenIntelCoreFeatures())
+        return 0;
+
+    if (!CheckXcr0Zmm())
+        return 0;
+
+    /*  CPUID.(EAX=07H, ECX=0H):EBX.AVX512F[bit 16]==1  &&
+        CPUID.(EAX=07H, ECX=0H):EBX.AVX512DQ[bit 17]==1 &&
+        CPUID.(EAX=07H, ECX=0H):EBX.AVX512CD[bit 28]==1 &&
+        CPUID.(EAX=07H, ECX=0H):EBX.AVX512BW[bit 30]==1 &&
+        CPUID.(EAX=07H, ECX=0H):EBX.AVX512VL[bit 31]==1 */
+    RunCpuid(7, 0, abcd);
+    if ((abcd[1] & avx512_f_dq_cd_bw_vl_mask) != avx512_f_dq_cd_bw_vl_mask)
+        return 0;
+    return 1;
+}
+static int32_t CanUseAvx512Features()
+{
+    static int32_t the_avx512_features_available = -1;
+    /* test is performed once */
+    if (the_avx512_features_available < 0)
+        the_avx512_features_available = CheckAvx512Features();
+    return the_avx512_features_available;
+}
 EbAsm GetCpuAsmType()
 {
     EbAsm asm_type = ASM_NON_AVX2;
 
-    if (CanUseIntelCore4thGenFeatures() == 1)
+    if (CanUseAvx512Features() == 1)
+        asm_type = ASM_AVX512;
+    else if (CanUseIntelCore4thGenFeatures() == 1)
         asm_type = ASM_AVX2;
     else
         // Need to change to support lower CPU Technologies
@@ -257,6 +296,11 @@ EbAsm GetCpuAsmType()
     return asm_type;
 }
 
+void setup_rtcd_flags(int32_t flags)
+{
+    setup_rtcd_flags_internal(flags);
+}
+
 //Get Number of logical processors
 uint32_t GetNumProcessors() {
 #ifdef _WIN32
@@ -268,12 +312,16 @@ uint32_t GetNumProcessors() {
 #endif
 }
 
-void InitThreadManagmentParams() {
 #ifdef _WIN32
-    // Initialize group_affinity structure with Current thread info
-    GetThreadGroupAffinity(GetCurrentThread(), &group_affinity);
+static BOOL CALLBACK InitProcessorGroups(PINIT_ONCE init_once, PVOID parameter, PVOID *context) {
+    UNUSED(init_once);
+    UNUSED(parameter);
+    UNUSED(context);
     num_groups = (uint8_t)GetActiveProcessorGroupCount();
+    return TRUE;
+}
 #else
+static void InitProcessorGroups() {
     const char* PROCESSORID = "processor";
     const char* PHYSICALID = "physical id";
     int processor_id_len = strnlen_ss(PROCESSORID, 128);
@@ -316,6 +364,15 @@ void InitThreadManagmentParams() {
         }
         close(fd);
     }
+}
+#endif
+
+// The processor topology is shared by all the encoder handles: parse it once
+void InitThreadManagmentParams() {
+#ifdef _WIN32
+    InitOnceExecuteOnce(&processor_groups_once, InitProcessorGroups, NULL, NULL);
+#else
+    pthread_once(&processor_groups_once, InitProcessorGroups);
 #endif
 }
 
@@ -328,9 +385,176 @@ uint64_t GetAffinityMask(uint32_t lpnum) {
 }
 #endif
 
+/**********************************
+* Explicit Processor Binding
+*   cpu_mask or numa_node pin the encoder to a set of logical processors
+**********************************/
+static EbBool CpuMaskIsSet(const EbSvtAv1EncConfiguration *config_ptr)
+{
+    uint32_t wordIndex;
+
+    for (wordIndex = 0; wordIndex < EB_CPU_MASK_WORD_COUNT; ++wordIndex) {
+        if (config_ptr->cpu_mask[wordIndex])
+            return EB_TRUE;
+    }
+    return EB_FALSE;
+}
+
+static EbBool ExplicitAffinityIsSet(const EbSvtAv1EncConfiguration *config_ptr)
+{
+    return (CpuMaskIsSet(config_ptr) || config_ptr->numa_node != -1) ? EB_TRUE : EB_FALSE;
+}
+
+#ifdef _WIN32
+// An affinity covers a single processor group: the group of the first processor
+// of cpu_mask is used. The processors of cpu_mask are numbered across the active
+// processors of the groups, a group holding up to 64 of them
+static EbErrorType GetExplicitAffinity(
+    const EbSvtAv1EncConfiguration *config_ptr,
+    GROUP_AFFINITY                 *affinity_ptr)
+{
+    SYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX *infoPtr;
+    DWORD    infoLength = 0;
+    uint32_t cpuIndex = 0;
+    EbBool   groupFound = EB_FALSE;
+    WORD     groupIndex;
+    uint32_t bitIndex;
+
+    memset(affinity_ptr, 0, sizeof(GROUP_AFFINITY));
+
+    if (CpuMaskIsSet(config_ptr)) {
+        GetLogicalProcessorInformationEx(RelationGroup, NULL, &infoLength);
+        if (GetLastError() != ERROR_INSUFFICIENT_BUFFER)
+            return EB_ErrorBadParameter;
+        infoPtr = (SYSTEM_LOGICAL_PROCESSOR_INFORMATION_EX*)malloc(infoLength);
+        if (infoPtr == NULL)
+            return EB_ErrorInsufficientResources;
+        if (!GetLogicalProcessorInformationEx(RelationGroup, infoPtr, &infoLength)) {
+            free(infoPtr);
+            return EB_ErrorBadParameter;
+        }
+
+        // RelationGroup returns a single entry listing every group
+        for (groupIndex = 0; groupIndex < infoPtr->Group.ActiveGroupCount; ++groupIndex) {
+            const KAFFINITY activeMask = infoPtr->Group.GroupInfo[groupIndex].ActiveProcessorMask;
+
+            for (bitIndex = 0; bitIndex < sizeof(KAFFINITY) * 8 && cpuIndex < EB_CPU_MASK_WORD_COUNT * 64; ++bitIndex) {
+                if (((activeMask >> bitIndex) & 1) == 0)
+                    continue;
+                if ((config_ptr->cpu_mask[cpuIndex >> 6] >> (cpuIndex & 63)) & 1) {
+                    if (groupFound == EB_FALSE) {
+                        affinity_ptr->Group = groupIndex;
+                        groupFound = EB_TRUE;
+                    }
+                    if (affinity_ptr->Group == groupIndex)
+                        affinity_ptr->Mask |= (KAFFINITY)1 << bitIndex;
+                }
+                cpuIndex++;
+            }
+        }
+        free(infoPtr);
+
+        return affinity_ptr->Mask ? EB_ErrorNone : EB_ErrorBadParameter;
+    }
+
+    return GetNumaNodeProcessorMaskEx((USHORT)config_ptr->numa_node, affinity_ptr) && affinity_ptr->Mask ?
+        EB_ErrorNone : EB_ErrorBadParameter;
+}
+
+static uint32_t AffinityProcessorCount(const GROUP_AFFINITY *affinity_ptr)
+{
+    uint32_t count = 0;
+    KAFFINITY mask;
+
+    for (mask = affinity_ptr->Mask; mask; mask &= mask - 1)
+        count++;
+    return count;
+}
+#else
+// The processors of a node are listed in sysfs as ranges, e.g. "0-15,32-47"
+static EbErrorType GetExplicitAffinity(
+    const EbSvtAv1EncConfiguration *config_ptr,
+    cpu_set_t                      *affinity_ptr)
+{
+    char  path[64];
+    char  cpuList[4096];
+    char *p;
+    FILE *fp;
+    uint32_t cpuIndex;
+
+    CPU_ZERO(affinity_ptr);
+
+    if (CpuMaskIsSet(config_ptr)) {
+        for (cpuIndex = 0; cpuIndex < EB_CPU_MASK_WORD_COUNT * 64 && cpuIndex < CPU_SETSIZE; ++cpuIndex) {
+            if ((config_ptr->cpu_mask[cpuIndex >> 6] >> (cpuIndex & 63)) & 1)
+                CPU_SET(cpuIndex, affinity_ptr);
+        }
+        return EB_ErrorNone;
+    }
+
+    if (config_ptr->numa_node < 0)
+        return EB_ErrorBadParameter;
+
+    snprintf(path, sizeof(path), "/sys/devices/system/node/node%d/cpulist", config_ptr->numa_node);
+    fp = fopen(path, "r");
+    if (fp == NULL)
+        return EB_ErrorBadParameter;
+    p = fgets(cpuList, sizeof(cpuList), fp);
+    fclose(fp);
+    if (p == NULL)
+        return EB_ErrorBadParameter;
+
+    while (*p >= '0' && *p <= '9') {
+        uint32_t first = (uint32_t)strtoul(p, &p, 10);
+        uint32_t last = first;
+
+        if (*p == '-')
+            last = (uint32_t)strtoul(p + 1, &p, 10);
+        for (cpuIndex = first; cpuIndex <= last && cpuIndex < CPU_SETSIZE; ++cpuIndex)
+            CPU_SET(cpuIndex, affinity_ptr);
+        if (*p == ',')
+            p++;
+    }
+
+    return CPU_COUNT(affinity_ptr) ? EB_ErrorNone : EB_ErrorBadParameter;
+}
+
+static uint32_t AffinityProcessorCount(const cpu_set_t *affinity_ptr)
+{
+    return (uint32_t)CPU_COUNT(affinity_ptr);
+}
+#endif
+
+// Number of processors of the explicit binding, 0 when there is none
+static uint32_t ExplicitAffinityProcessorCount(const EbSvtAv1EncConfiguration *config_ptr)
+{
+#ifdef _WIN32
+    GROUP_AFFINITY affinity;
+#else
+    cpu_set_t      affinity;
+#endif
+
+    if (ExplicitAffinityIsSet(config_ptr) == EB_FALSE ||
+        GetExplicitAffinity(config_ptr, &affinity) != EB_ErrorNone)
+        return 0;
+
+    return AffinityProcessorCount(&affinity);
+}
+
 EbErrorType EbSetThreadManagementParameters(EbSvtAv1EncConfiguration   *config_ptr) {
     uint32_t num_logical_processors = GetNumProcessors();
+
+    if (ExplicitAffinityIsSet(config_ptr)) {
+#ifdef _WIN32
+        alternate_groups = 0;
+#endif
+        return GetExplicitAffinity(config_ptr, &group_affinity);
+    }
 #ifdef _WIN32
+    // Initialize group_affinity structure with Current thread info
+    GetThreadGroupAffinity(GetCurrentThread(), &group_affinity);
+    alternate_groups = 0;
+
     // For system with a single processor group(no more than 64 logic processors all together)
     // Affinity of the thread can be set to one or more logical processors
     if (num_groups == 1) {
@@ -442,6 +666,13 @@ int32_t set_parent_pcs(EbSvtAv1EncConfiguration*   config) {
         return -1;
     }
 }
+static uint32_t StageThreadCount(
+    uint32_t configured_count,
+    uint32_t derived_count)
+{
+    return configured_count ? configured_count : derived_count;
+}
+
 EbErrorType LoadDefaultBufferConfigurationSettings(
     SequenceControlSet_t       *sequence_control_set_ptr){
 
@@ -462,6 +693,7 @@ EbErrorType LoadDefaultBufferConfigurationSettings(
 
     unsigned int lpCount = GetNumProcessors();
     unsigned int coreCount = lpCount;
+    unsigned int boundCount = ExplicitAffinityProcessorCount(&sequence_control_set_ptr->static_config);
     if (sequence_control_set_ptr->static_config.target_socket != -1)
         coreCount /= num_groups;
     if (sequence_control_set_ptr->static_config.logical_processors != 0)
@@ -482,6 +714,10 @@ EbErrorType LoadDefaultBufferConfigurationSettings(
         coreCount = lpCount;
 #endif
 
+    // An explicit processor set replaces the socket and -lp selection
+    if (boundCount)
+        coreCount = boundCount;
+
     sequence_control_set_ptr->input_buffer_fifo_init_count         = 
         inputPic + SCD_LAD + sequence_control_set_ptr->static_config.look_ahead_distance ;
     sequence_control_set_ptr->output_stream_buffer_fifo_init_count = 
@@ -502,6 +738,9 @@ EbErrorType LoadDefaultBufferConfigurationSettings(
     sequence_control_set_ptr->me_segment_column_count_array[4] = meSegW;
     sequence_control_set_ptr->me_segment_column_count_array[5] = meSegW;
 
+    // PA segments, rows of SBs analysed in parallel
+    sequence_control_set_ptr->pa_segment_row_count = MAX(MIN((sequence_control_set_ptr->max_input_luma_height + BLOCK_SIZE_64 - 1) / BLOCK_SIZE_64, coreCount), 1);
+
     // EncDec segments     
     sequence_control_set_ptr->enc_dec_segment_row_count_array[0] = encDecSegH;
     sequence_control_set_ptr->enc_dec_segment_row_count_array[1] = encDecSegH;
@@ -541,6 +780,21 @@ EbErrorType LoadDefaultBufferConfigurationSettings(
                                                                           sequence_control_set_ptr->static_config.look_ahead_distance + SCD_LAD;
     sequence_control_set_ptr->output_recon_buffer_fifo_init_count       = sequence_control_set_ptr->reference_picture_buffer_init_count;
 
+    // With a memory budget, the pools start with what a mini-GOP and the look-ahead need
+    sequence_control_set_ptr->picture_control_set_pool_min_count        = (2 << sequence_control_set_ptr->static_config.hierarchical_levels) + 1;
+    sequence_control_set_ptr->reference_picture_buffer_min_count        = (1 << sequence_control_set_ptr->static_config.hierarchical_levels) + 2 +
+                                                                          sequence_control_set_ptr->static_config.look_ahead_distance + SCD_LAD;
+    sequence_control_set_ptr->pa_reference_picture_buffer_min_count     = sequence_control_set_ptr->reference_picture_buffer_min_count;
+    sequence_control_set_ptr->input_buffer_fifo_min_count               = sequence_control_set_ptr->picture_control_set_pool_min_count + SCD_LAD +
+                                                                          sequence_control_set_ptr->static_config.look_ahead_distance;
+
+    // Zero-copy input headers own no picture memory and are also held by the PA references
+    if (sequence_control_set_ptr->static_config.zero_copy_input)
+        sequence_control_set_ptr->input_buffer_fifo_init_count += sequence_control_set_ptr->pa_reference_picture_buffer_init_count;
+
+    // The picture pools are constructed on the processors the encoder runs on
+    sequence_control_set_ptr->buffer_ctor_thread_count                  = coreCount;
+
     //#====================== Inter process Fifos ======================
     sequence_control_set_ptr->resource_coordination_fifo_init_count       = 300;
     sequence_control_set_ptr->picture_analysis_fifo_init_count            = 300;
@@ -569,18 +823,19 @@ EbErrorType LoadDefaultBufferConfigurationSettings(
     sequence_control_set_ptr->total_process_init_count += sequence_control_set_ptr->enc_dec_process_init_count = 1;//MAX(40, coreCount);
     sequence_control_set_ptr->total_process_init_count += sequence_control_set_ptr->entropy_coding_process_init_count = 1;//MAX(3, coreCount / 12);
 #else
-    sequence_control_set_ptr->total_process_init_count += (sequence_control_set_ptr->picture_analysis_process_init_count             = MAX(MIN(15, coreCount), coreCount / 6));
-    sequence_control_set_ptr->total_process_init_count += (sequence_control_set_ptr->motion_estimation_process_init_count            = MAX(MIN(20, coreCount), coreCount / 3));
-    sequence_control_set_ptr->total_process_init_count += (sequence_control_set_ptr->source_based_operations_process_init_count      = MAX(MIN(3, coreCount), coreCount / 12));
-    sequence_control_set_ptr->total_process_init_count += (sequence_control_set_ptr->mode_decision_configuration_process_init_count  = MAX(MIN(3, coreCount), coreCount / 12));
-    sequence_control_set_ptr->total_process_init_count += (sequence_control_set_ptr->enc_dec_process_init_count                      = MAX(MIN(40, coreCount), coreCount)    );
-    sequence_control_set_ptr->total_process_init_count += (sequence_control_set_ptr->entropy_coding_process_init_count               = MAX(MIN(3, coreCount), coreCount / 12));
+    // A thread count set in the configuration replaces the derived one
+    sequence_control_set_ptr->total_process_init_count += (sequence_control_set_ptr->picture_analysis_process_init_count             = StageThreadCount(sequence_control_set_ptr->static_config.picture_analysis_thread_count,            MAX(MIN(15, coreCount), coreCount / 6)));
+    sequence_control_set_ptr->total_process_init_count += (sequence_control_set_ptr->motion_estimation_process_init_count            = StageThreadCount(sequence_control_set_ptr->static_config.motion_estimation_thread_count,           MAX(MIN(20, coreCount), coreCount / 3)));
+    sequence_control_set_ptr->total_process_init_count += (sequence_control_set_ptr->source_based_operations_process_init_count      = StageThreadCount(sequence_control_set_ptr->static_config.source_based_operations_thread_count,     MAX(MIN(3, coreCount), coreCount / 12)));
+    sequence_control_set_ptr->total_process_init_count += (sequence_control_set_ptr->mode_decision_configuration_process_init_count  = StageThreadCount(sequence_control_set_ptr->static_config.mode_decision_configuration_thread_count, MAX(MIN(3, coreCount), coreCount / 12)));
+    sequence_control_set_ptr->total_process_init_count += (sequence_control_set_ptr->enc_dec_process_init_count                      = StageThreadCount(sequence_control_set_ptr->static_config.enc_dec_thread_count,                     MAX(MIN(40, coreCount), coreCount)    ));
+    sequence_control_set_ptr->total_process_init_count += (sequence_control_set_ptr->entropy_coding_process_init_count               = StageThreadCount(sequence_control_set_ptr->static_config.entropy_coding_thread_count,              MAX(MIN(3, coreCount), coreCount / 12)));
 #endif
 
 #if FILT_PROC
-    sequence_control_set_ptr->total_process_init_count +=(sequence_control_set_ptr->dlf_process_init_count                           = MAX(MIN(40, coreCount), coreCount));
-    sequence_control_set_ptr->total_process_init_count +=(sequence_control_set_ptr->cdef_process_init_count                          = MAX(MIN(40, coreCount), coreCount));
-    sequence_control_set_ptr->total_process_init_count +=(sequence_control_set_ptr->rest_process_init_count                          = MAX(MIN(40, coreCount), coreCount));
+    sequence_control_set_ptr->total_process_init_count +=(sequence_control_set_ptr->dlf_process_init_count                           = StageThreadCount(sequence_control_set_ptr->static_config.dlf_thread_count,  MAX(MIN(40, coreCount), coreCount)));
+    sequence_control_set_ptr->total_process_init_count +=(sequence_control_set_ptr->cdef_process_init_count                          = StageThreadCount(sequence_control_set_ptr->static_config.cdef_thread_count, MAX(MIN(40, coreCount), coreCount)));
+    sequence_control_set_ptr->total_process_init_count +=(sequence_control_set_ptr->rest_process_init_count                          = StageThreadCount(sequence_control_set_ptr->static_config.rest_thread_count, MAX(MIN(40, coreCount), coreCount)));
 #endif
 
     sequence_control_set_ptr->total_process_init_count += 6; // single processes count
@@ -683,25 +938,26 @@ static EbErrorType eb_enc_handle_ctor(
     if (encHandlePtr == (EbEncHandle_t*)EB_NULL) {
         return EB_ErrorInsufficientResources;
     }
-    encHandlePtr->memory_map = (EbMemoryMapEntry*)malloc(sizeof(EbMemoryMapEntry) * MAX_NUM_PTR);
-    encHandlePtr->memory_map_index = 0;
-    encHandlePtr->total_lib_memory = sizeof(EbEncHandle_t) + sizeof(EbMemoryMapEntry) * MAX_NUM_PTR;
+    memset(&encHandlePtr->memory_map, 0, sizeof(EbMemoryMap));
+    encHandlePtr->memory_map.entries = (EbMemoryMapEntry*)malloc(sizeof(EbMemoryMapEntry) * MAX_NUM_PTR);
+    encHandlePtr->memory_map.capacity = encHandlePtr->memory_map.entries ? MAX_NUM_PTR : 0;
+    encHandlePtr->memory_map.total_lib_memory = sizeof(EbEncHandle_t) + sizeof(EbMemoryMapEntry) * MAX_NUM_PTR;
 
-    // Save Memory Map Pointers 
-    total_lib_memory = &encHandlePtr->total_lib_memory;
-    memory_map = encHandlePtr->memory_map;
-    memory_map_index = &encHandlePtr->memory_map_index;
-    libMallocCount = 0;
-    lib_thread_count = 0;
-    libMutexCount = 0;
-    libSemaphoreCount = 0;
+    // Bind the handle Memory Map to the calling thread
+    memory_map = &encHandlePtr->memory_map;
 
-    if (memory_map == (EbMemoryMapEntry*)EB_NULL) {
+    if (memory_map->entries == (EbMemoryMapEntry*)EB_NULL) {
         return EB_ErrorInsufficientResources;
     }
 
     InitThreadManagmentParams();
 
+    encHandlePtr->thread_pool_ptr = (struct EbThreadPool*)EB_NULL;
+    encHandlePtr->pipeline_profiler_ptr = (struct EbPipelineProfiler_s*)EB_NULL;
+    encHandlePtr->memory_budget_ptr = (EbMemoryBudget_t*)EB_NULL;
+    encHandlePtr->startup_step_count = 0;
+    encHandlePtr->startup_time = 0;
+
     encHandlePtr->encodeInstanceTotalCount = EB_EncodeInstancesTotalCount;
 
     EB_MALLOC(uint32_t*, encHandlePtr->compute_segments_total_count_array, sizeof(uint32_t) * encHandlePtr->encodeInstanceTotalCount, EB_N_PTR);
@@ -765,6 +1021,9 @@ static EbErrorType eb_enc_handle_ctor(
     // System Resource Managers
     encHandlePtr->input_buffer_resource_ptr = (EbSystemResource_t*)EB_NULL;
     encHandlePtr->output_stream_buffer_resource_ptr_array = (EbSystemResource_t**)EB_NULL;
+#if TILES
+    encHandlePtr->tile_output_buffer_resource_ptr_array = (EbSystemResource_t**)EB_NULL;
+#endif
     encHandlePtr->resourceCoordinationResultsResourcePtr = (EbSystemResource_t*)EB_NULL;
     encHandlePtr->pictureAnalysisResultsResourcePtr = (EbSystemResource_t*)EB_NULL;
     encHandlePtr->pictureDecisionResultsResourcePtr = (EbSystemResource_t*)EB_NULL;
@@ -780,6 +1039,9 @@ static EbErrorType eb_enc_handle_ctor(
     // Inter-Process Producer Fifos
     encHandlePtr->input_buffer_producer_fifo_ptr_array = (EbFifo_t**)EB_NULL;
     encHandlePtr->output_stream_buffer_producer_fifo_ptr_dbl_array = (EbFifo_t***)EB_NULL;
+#if TILES
+    encHandlePtr->tile_output_buffer_producer_fifo_ptr_dbl_array = (EbFifo_t***)EB_NULL;
+#endif
     encHandlePtr->resourceCoordinationResultsProducerFifoPtrArray = (EbFifo_t**)EB_NULL;
     encHandlePtr->pictureDemuxResultsProducerFifoPtrArray = (EbFifo_t**)EB_NULL;
     encHandlePtr->pictureManagerResultsProducerFifoPtrArray = (EbFifo_t**)EB_NULL;
@@ -886,15 +1148,260 @@ EbErrorType RestResultsCtor(
 }
 #endif
 /**********************************
-* Initialize Encoder Library
+* Attach a pipeline stage to the shared thread pool:
+* one pool slot per process context
 **********************************/
-#if defined(__linux__) || defined(__APPLE__)
-__attribute__((visibility("default")))
+static EbErrorType AttachStageToThreadPool(
+    EbEncHandle_t     *encHandlePtr,
+    EbPtr             *context_ptr_array,
+    EbFifo_t         **input_fifo_ptr_array,
+    uint32_t           process_count,
+    EbThreadPoolTask   task,
+    uint32_t           priority)
+{
+    EbErrorType return_error = EB_ErrorNone;
+    uint32_t    processIndex;
+
+    for (processIndex = 0; processIndex < process_count; ++processIndex) {
+        return_error = eb_thread_pool_add_slot(
+            encHandlePtr->thread_pool_ptr,
+            encHandlePtr,
+            input_fifo_ptr_array[processIndex],
+            task,
+            context_ptr_array[processIndex],
+            priority);
+        if (return_error != EB_ErrorNone) {
+            return return_error;
+        }
+    }
+
+    return return_error;
+}
+
+/**********************************
+* Pipeline Profiler Object Ids
+*   Picture number of the objects of each stage input queue
+**********************************/
+static uint64_t ParentPictureNumber(EbObjectWrapper_t *wrapper_ptr)
+{
+    return ((PictureParentControlSet_t*)wrapper_ptr->object_ptr)->picture_number;
+}
+
+static uint64_t ChildPictureNumber(EbObjectWrapper_t *wrapper_ptr)
+{
+    return ((PictureControlSet_t*)wrapper_ptr->object_ptr)->picture_number;
+}
+
+static uint64_t ResourceCoordinationResultsId(EbPtr object_ptr)
+{
+    return ParentPictureNumber(((ResourceCoordinationResults_t*)object_ptr)->pictureControlSetWrapperPtr);
+}
+
+static uint64_t PictureAnalysisResultsId(EbPtr object_ptr)
+{
+    return ParentPictureNumber(((PictureAnalysisResults_t*)object_ptr)->pictureControlSetWrapperPtr);
+}
+
+static uint64_t PictureDecisionResultsId(EbPtr object_ptr)
+{
+    return ParentPictureNumber(((PictureDecisionResults_t*)object_ptr)->pictureControlSetWrapperPtr);
+}
+
+static uint64_t MotionEstimationResultsId(EbPtr object_ptr)
+{
+    return ParentPictureNumber(((MotionEstimationResults_t*)object_ptr)->pictureControlSetWrapperPtr);
+}
+
+static uint64_t InitialRateControlResultsId(EbPtr object_ptr)
+{
+    return ParentPictureNumber(((InitialRateControlResults_t*)object_ptr)->pictureControlSetWrapperPtr);
+}
+
+static uint64_t PictureDemuxResultsId(EbPtr object_ptr)
+{
+    PictureDemuxResults_t *resultsPtr = (PictureDemuxResults_t*)object_ptr;
+
+    return (resultsPtr->pictureType == EB_PIC_INPUT) ?
+        ParentPictureNumber(resultsPtr->pictureControlSetWrapperPtr) :
+        resultsPtr->picture_number;
+}
+
+static uint64_t RateControlTasksId(EbPtr object_ptr)
+{
+    RateControlTasks_t *tasksPtr = (RateControlTasks_t*)object_ptr;
+
+    switch (tasksPtr->taskType) {
+    case RC_PICTURE_MANAGER_RESULT:
+        return ChildPictureNumber(tasksPtr->pictureControlSetWrapperPtr);
+    case RC_PACKETIZATION_FEEDBACK_RESULT:
+        return ParentPictureNumber(tasksPtr->pictureControlSetWrapperPtr);
+    default:
+        return tasksPtr->picture_number;
+    }
+}
+
+static uint64_t RateControlResultsId(EbPtr object_ptr)
+{
+    return ChildPictureNumber(((RateControlResults_t*)object_ptr)->pictureControlSetWrapperPtr);
+}
+
+static uint64_t EncDecTasksId(EbPtr object_ptr)
+{
+    return ChildPictureNumber(((EncDecTasks_t*)object_ptr)->pictureControlSetWrapperPtr);
+}
+
+static uint64_t EncDecResultsId(EbPtr object_ptr)
+{
+    return ChildPictureNumber(((EncDecResults_t*)object_ptr)->pictureControlSetWrapperPtr);
+}
+
+#if FILT_PROC
+static uint64_t DlfResultsId(EbPtr object_ptr)
+{
+    return ChildPictureNumber(((DlfResults_t*)object_ptr)->picture_control_set_wrapper_ptr);
+}
+
+static uint64_t CdefResultsId(EbPtr object_ptr)
+{
+    return ChildPictureNumber(((CdefResults_t*)object_ptr)->picture_control_set_wrapper_ptr);
+}
+
+static uint64_t RestResultsId(EbPtr object_ptr)
+{
+    return ChildPictureNumber(((RestResults_t*)object_ptr)->picture_control_set_wrapper_ptr);
+}
 #endif
-EB_API EbErrorType eb_init_encoder(EbComponentType *svt_enc_component)
+
+static uint64_t EntropyCodingResultsId(EbPtr object_ptr)
+{
+    return ChildPictureNumber(((EntropyCodingResults_t*)object_ptr)->pictureControlSetWrapperPtr);
+}
+
+/**********************************
+* Pipeline Profiler Stages
+*   Each stage is named after the process consuming the queue
+**********************************/
+static EbErrorType ProfilePipelineStages(
+    EbEncHandle_t *encHandlePtr)
+{
+    EbPipelineProfiler_t *profilerPtr;
+    SequenceControlSet_t *sequence_control_set_ptr = encHandlePtr->sequence_control_set_instance_array[0]->sequence_control_set_ptr;
+    EbErrorType return_error;
+
+    return_error = eb_pipeline_profiler_ctor(
+        &profilerPtr,
+        EB_PIPELINE_PROFILER_EVENT_COUNT);
+    if (return_error != EB_ErrorNone)
+        return return_error;
+    encHandlePtr->pipeline_profiler_ptr = profilerPtr;
+
+    eb_pipeline_profiler_add_stage(profilerPtr, encHandlePtr->input_buffer_resource_ptr, "ResourceCoordination", EB_ResourceCoordinationProcessInitCount, (EbPipelineObjectId)EB_NULL);
+    eb_pipeline_profiler_add_stage(profilerPtr, encHandlePtr->resourceCoordinationResultsResourcePtr, "PictureAnalysis", sequence_control_set_ptr->picture_analysis_process_init_count, ResourceCoordinationResultsId);
+    eb_pipeline_profiler_add_stage(profilerPtr, encHandlePtr->pictureAnalysisResultsResourcePtr, "PictureDecision", EB_PictureDecisionProcessInitCount, PictureAnalysisResultsId);
+    eb_pipeline_profiler_add_stage(profilerPtr, encHandlePtr->pictureDecisionResultsResourcePtr, "MotionEstimation", sequence_control_set_ptr->motion_estimation_process_init_count, PictureDecisionResultsId);
+    eb_pipeline_profiler_add_stage(profilerPtr, encHandlePtr->motionEstimationResultsResourcePtr, "InitialRateControl", EB_InitialRateControlProcessInitCount, MotionEstimationResultsId);
+    eb_pipeline_profiler_add_stage(profilerPtr, encHandlePtr->initialRateControlResultsResourcePtr, "SourceBasedOperations", sequence_control_set_ptr->source_based_operations_process_init_count, InitialRateControlResultsId);
+    eb_pipeline_profiler_add_stage(profilerPtr, encHandlePtr->pictureDemuxResultsResourcePtr, "PictureManager", EB_PictureManagerProcessInitCount, PictureDemuxResultsId);
+    eb_pipeline_profiler_add_stage(profilerPtr, encHandlePtr->rateControlTasksResourcePtr, "RateControl", EB_RateControlProcessInitCount, RateControlTasksId);
+    eb_pipeline_profiler_add_stage(profilerPtr, encHandlePtr->rateControlResultsResourcePtr, "ModeDecisionConfiguration", sequence_control_set_ptr->mode_decision_configuration_process_init_count, RateControlResultsId);
+    eb_pipeline_profiler_add_stage(profilerPtr, encHandlePtr->encDecTasksResourcePtr, "EncDec", sequence_control_set_ptr->enc_dec_process_init_count, EncDecTasksId);
+#if FILT_PROC
+    eb_pipeline_profiler_add_stage(profilerPtr, encHandlePtr->encDecResultsResourcePtr, "Dlf", sequence_control_set_ptr->dlf_process_init_count, EncDecResultsId);
+    eb_pipeline_profiler_add_stage(profilerPtr, encHandlePtr->dlfResultsResourcePtr, "Cdef", sequence_control_set_ptr->cdef_process_init_count, DlfResultsId);
+    eb_pipeline_profiler_add_stage(profilerPtr, encHandlePtr->cdefResultsResourcePtr, "Rest", sequence_control_set_ptr->rest_process_init_count, CdefResultsId);
+    eb_pipeline_profiler_add_stage(profilerPtr, encHandlePtr->restResultsResourcePtr, "EntropyCoding", sequence_control_set_ptr->entropy_coding_process_init_count, RestResultsId);
+#else
+    eb_pipeline_profiler_add_stage(profilerPtr, encHandlePtr->encDecResultsResourcePtr, "EntropyCoding", sequence_control_set_ptr->entropy_coding_process_init_count, EncDecResultsId);
+#endif
+    eb_pipeline_profiler_add_stage(profilerPtr, encHandlePtr->entropyCodingResultsResourcePtr, "Packetization", EB_PacketizationProcessInitCount, EntropyCodingResultsId);
+
+    return EB_ErrorNone;
+}
+
+/**********************************
+* Zero-copy Input Release
+**********************************/
+// The PA reference reads the luma plane of its input picture, so with
+//   zero-copy input it holds the input until the reference is reused
+static void ReleasePaReferenceInput(
+    void *object_ptr,
+    void *callback_ctx)
+{
+    EbPaReferenceObject_t *paReferenceObject = (EbPaReferenceObject_t*)object_ptr;
+
+    (void)callback_ctx;
+
+    if (paReferenceObject->inputPictureWrapperPtr != EB_NULL) {
+        eb_release_object(paReferenceObject->inputPictureWrapperPtr);
+        paReferenceObject->inputPictureWrapperPtr = (EbObjectWrapper_t*)EB_NULL;
+    }
+}
+
+// Hands the frame buffer back to the application once the input picture is
+//   no longer referenced by the pipeline
+static void ReleaseZeroCopyInput(
+    void *object_ptr,
+    void *callback_ctx)
+{
+    SequenceControlSet_t        *sequence_control_set_ptr = (SequenceControlSet_t*)callback_ctx;
+    EbSvtAv1EncConfiguration    *config = &sequence_control_set_ptr->static_config;
+    EbBufferHeaderType          *inputBuffer = (EbBufferHeaderType*)object_ptr;
+    EbPictureBufferDesc_t       *input_picture_ptr = (EbPictureBufferDesc_t*)inputBuffer->p_buffer;
+    EbBufferHeaderType           header;
+    EbSvtEncInput                input;
+
+    // Headers sent without a picture (e.g. EOS) have nothing to return
+    if (input_picture_ptr->buffer_y == EB_NULL)
+        return;
+
+    EB_MEMSET(&input, 0, sizeof(EbSvtEncInput));
+    input.luma = input_picture_ptr->buffer_y + input_picture_ptr->stride_y * sequence_control_set_ptr->top_padding + sequence_control_set_ptr->left_padding;
+    input.cb = input_picture_ptr->bufferCb + input_picture_ptr->strideCb * (sequence_control_set_ptr->top_padding >> 1) + (sequence_control_set_ptr->left_padding >> 1);
+    input.cr = input_picture_ptr->bufferCr + input_picture_ptr->strideCr * (sequence_control_set_ptr->top_padding >> 1) + (sequence_control_set_ptr->left_padding >> 1);
+    input.yStride = input_picture_ptr->stride_y;
+    input.cbStride = input_picture_ptr->strideCb;
+    input.crStride = input_picture_ptr->strideCr;
+
+    header = *inputBuffer;
+    header.p_buffer = (uint8_t*)&input;
+
+    input_picture_ptr->buffer_y = (EbByte)EB_NULL;
+    input_picture_ptr->bufferCb = (EbByte)EB_NULL;
+    input_picture_ptr->bufferCr = (EbByte)EB_NULL;
+
+    config->input_release_callback(
+        config->input_release_context,
+        &header);
+}
+
+/**********************************
+* Build the Encoder Pipeline
+**********************************/
+/**************************************
+ * StartupStep
+ *   Records the time and memory taken by the eb_init_encoder step
+ *   ending now
+ **************************************/
+static void StartupStep(
+    EbEncHandle_t  *encHandlePtr,
+    const char     *name)
+{
+    const uint64_t now = eb_time_us();
+
+    if (encHandlePtr->startup_step_count < EB_STARTUP_STEP_MAX_COUNT) {
+        EbStartupStep *step_ptr = &encHandlePtr->startup_step_array[encHandlePtr->startup_step_count++];
+
+        step_ptr->name = name;
+        step_ptr->time = now - encHandlePtr->startup_step_time;
+        step_ptr->memory = encHandlePtr->memory_map.total_lib_memory - encHandlePtr->startup_step_memory;
+    }
+
+    encHandlePtr->startup_step_time = now;
+    encHandlePtr->startup_step_memory = encHandlePtr->memory_map.total_lib_memory;
+}
+
+static EbErrorType InitEncoderPipeline(EbComponentType *svt_enc_component)
 {
-    if(svt_enc_component == NULL)
-        return EB_ErrorBadParameter;
     EbEncHandle_t *encHandlePtr = (EbEncHandle_t*)svt_enc_component->pComponentPrivate;
     EbErrorType return_error = EB_ErrorNone;
     uint32_t instanceIndex;
@@ -904,6 +1411,21 @@ EB_API EbErrorType eb_init_encoder(EbComponentType *svt_enc_component)
 
     EbBool is16bit = (EbBool)(encHandlePtr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->static_config.encoder_bit_depth > EB_8BIT);
 
+    // Bind the handle Memory Map to the calling thread
+    memory_map = &encHandlePtr->memory_map;
+    eb_system_resource_set_ctor_thread_count(1);
+    eb_system_resource_set_lock_free((EbBool)encHandlePtr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->static_config.lock_free_queues);
+
+    // Memory budget of the elastic pools
+    if (encHandlePtr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->static_config.memory_budget) {
+        return_error = eb_memory_budget_ctor(
+            &encHandlePtr->memory_budget_ptr,
+            (uint64_t)encHandlePtr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->static_config.memory_budget << 20);
+        if (return_error != EB_ErrorNone) {
+            return return_error;
+        }
+    }
+
     /************************************
     * Plateform detection
     ************************************/
@@ -932,6 +1454,7 @@ EB_API EbErrorType eb_init_encoder(EbComponentType *svt_enc_component)
 
     build_blk_geom(scs_init.sb_size == 128);
 
+    StartupStep(encHandlePtr, "Platform detection");
 
     /************************************
     * Sequence Control Set
@@ -951,6 +1474,11 @@ EB_API EbErrorType eb_init_encoder(EbComponentType *svt_enc_component)
     if (return_error == EB_ErrorInsufficientResources) {
         return EB_ErrorInsufficientResources;
     }
+    StartupStep(encHandlePtr, "Sequence control sets");
+
+    // The objects of the picture pools are constructed in parallel
+    eb_system_resource_set_ctor_thread_count(encHandlePtr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->buffer_ctor_thread_count);
+
     /************************************
     * Picture Control Set: Parent
     ************************************/
@@ -989,6 +1517,7 @@ EB_API EbErrorType eb_init_encoder(EbComponentType *svt_enc_component)
         inputData.ten_bit_format = encHandlePtr->sequence_control_set_instance_array[instanceIndex]->sequence_control_set_ptr->static_config.ten_bit_format;
         inputData.compressed_ten_bit_format = encHandlePtr->sequence_control_set_instance_array[instanceIndex]->sequence_control_set_ptr->static_config.compressed_ten_bit_format;
         encHandlePtr->sequence_control_set_instance_array[instanceIndex]->sequence_control_set_ptr->picture_control_set_pool_init_count += maxLookAheadDistance;
+        encHandlePtr->sequence_control_set_instance_array[instanceIndex]->sequence_control_set_ptr->picture_control_set_pool_min_count += maxLookAheadDistance;
         inputData.enc_mode = encHandlePtr->sequence_control_set_instance_array[instanceIndex]->sequence_control_set_ptr->static_config.enc_mode;
         inputData.speed_control = (uint8_t)encHandlePtr->sequence_control_set_instance_array[instanceIndex]->sequence_control_set_ptr->static_config.speed_control_flag;
         inputData.film_grain_noise_level = encHandlePtr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->static_config.film_grain_denoise_strength;
@@ -998,16 +1527,19 @@ EB_API EbErrorType eb_init_encoder(EbComponentType *svt_enc_component)
 
         inputData.in_loop_me_flag = (uint8_t)encHandlePtr->sequence_control_set_instance_array[instanceIndex]->sequence_control_set_ptr->static_config.in_loop_me_flag;
 
-        return_error = eb_system_resource_ctor(
+        return_error = eb_system_resource_elastic_ctor(
             &(encHandlePtr->pictureParentControlSetPoolPtrArray[instanceIndex]),
             encHandlePtr->sequence_control_set_instance_array[instanceIndex]->sequence_control_set_ptr->picture_control_set_pool_init_count,//encHandlePtr->pictureControlSetPoolTotalCount,
+            encHandlePtr->sequence_control_set_instance_array[instanceIndex]->sequence_control_set_ptr->picture_control_set_pool_min_count,
             1,
             0,
             &encHandlePtr->pictureParentControlSetPoolProducerFifoPtrDblArray[instanceIndex],
             (EbFifo_t ***)EB_NULL,
             EB_FALSE,
             picture_parent_control_set_ctor,
-            &inputData);
+            &inputData,
+            sizeof(inputData),
+            encHandlePtr->memory_budget_ptr);
         if (return_error == EB_ErrorInsufficientResources) {
             return EB_ErrorInsufficientResources;
         }
@@ -1048,6 +1580,26 @@ EB_API EbErrorType eb_init_encoder(EbComponentType *svt_enc_component)
         inputData.sb_size_pix = scs_init.sb_size;
         inputData.max_depth = encHandlePtr->sequence_control_set_instance_array[instanceIndex]->sequence_control_set_ptr->max_sb_depth;
         inputData.is16bit = is16bit;
+#if TILES
+        {
+            // One entropy coding tile per tile of the configured layout, tiles are at least one SB
+            SequenceControlSet_t *sequence_control_set_ptr = encHandlePtr->sequence_control_set_instance_array[instanceIndex]->sequence_control_set_ptr;
+            uint32_t tileColumnCount = MIN((uint32_t)1 << sequence_control_set_ptr->static_config.tile_columns, (uint32_t)((inputData.picture_width + scs_init.sb_size - 1) / scs_init.sb_size));
+            uint32_t tileRowCount = MIN((uint32_t)1 << sequence_control_set_ptr->static_config.tile_rows, (uint32_t)((inputData.picture_height + scs_init.sb_size - 1) / scs_init.sb_size));
+            inputData.tile_count = (uint16_t)(tileColumnCount * tileRowCount);
+            inputData.tile_column_count = (uint16_t)tileColumnCount;
+            inputData.tile_row_count = (uint16_t)tileRowCount;
+
+            // Low latency tile output: every picture in entropy coding takes ahead a packet
+            //   for each of its tile groups but the last
+            sequence_control_set_ptr->tile_output_buffer_fifo_init_count = (inputData.tile_count - 1) *
+                sequence_control_set_ptr->picture_control_set_pool_init_count_child;
+        }
+#else
+        inputData.tile_count = 1;
+        inputData.tile_column_count = 1;
+        inputData.tile_row_count = 1;
+#endif
         return_error = eb_system_resource_ctor(
             &(encHandlePtr->pictureControlSetPoolPtrArray[instanceIndex]),
             encHandlePtr->sequence_control_set_instance_array[instanceIndex]->sequence_control_set_ptr->picture_control_set_pool_init_count_child, //EB_PictureControlSetPoolInitCountChild,
@@ -1063,6 +1615,8 @@ EB_API EbErrorType eb_init_encoder(EbComponentType *svt_enc_component)
         }
     }
 
+    StartupStep(encHandlePtr, "Picture control sets");
+
     /************************************
     * Picture Buffers
     ************************************/
@@ -1112,16 +1666,19 @@ EB_API EbErrorType eb_init_encoder(EbComponentType *svt_enc_component)
         EbReferenceObjectDescInitDataStructure.referencePictureDescInitData = referencePictureBufferDescInitData;
 
         // Reference Picture Buffers
-        return_error = eb_system_resource_ctor(
+        return_error = eb_system_resource_elastic_ctor(
             &encHandlePtr->referencePicturePoolPtrArray[instanceIndex],
             encHandlePtr->sequence_control_set_instance_array[instanceIndex]->sequence_control_set_ptr->reference_picture_buffer_init_count,//encHandlePtr->referencePicturePoolTotalCount,
+            encHandlePtr->sequence_control_set_instance_array[instanceIndex]->sequence_control_set_ptr->reference_picture_buffer_min_count,
             EB_PictureManagerProcessInitCount,
             0,
             &encHandlePtr->referencePicturePoolProducerFifoPtrDblArray[instanceIndex],
             (EbFifo_t ***)EB_NULL,
             EB_FALSE,
             eb_reference_object_ctor,
-            &(EbReferenceObjectDescInitDataStructure));
+            &(EbReferenceObjectDescInitDataStructure),
+            sizeof(EbReferenceObjectDescInitDataStructure),
+            encHandlePtr->memory_budget_ptr);
 
         if (return_error == EB_ErrorInsufficientResources) {
             return EB_ErrorInsufficientResources;
@@ -1166,44 +1723,71 @@ EB_API EbErrorType eb_init_encoder(EbComponentType *svt_enc_component)
         EbPaReferenceObjectDescInitDataStructure.sixteenthPictureDescInitData = sixteenthDecimPictureBufferDescInitData;
 
         // Reference Picture Buffers
-        return_error = eb_system_resource_ctor(
+        return_error = eb_system_resource_elastic_ctor(
             &encHandlePtr->paReferencePicturePoolPtrArray[instanceIndex],
             encHandlePtr->sequence_control_set_instance_array[instanceIndex]->sequence_control_set_ptr->pa_reference_picture_buffer_init_count,
+            encHandlePtr->sequence_control_set_instance_array[instanceIndex]->sequence_control_set_ptr->pa_reference_picture_buffer_min_count,
             EB_PictureDecisionProcessInitCount,
             0,
             &encHandlePtr->paReferencePicturePoolProducerFifoPtrDblArray[instanceIndex],
             (EbFifo_t ***)EB_NULL,
             EB_FALSE,
             eb_pa_reference_object_ctor,
-            &(EbPaReferenceObjectDescInitDataStructure));
+            &(EbPaReferenceObjectDescInitDataStructure),
+            sizeof(EbPaReferenceObjectDescInitDataStructure),
+            encHandlePtr->memory_budget_ptr);
         if (return_error == EB_ErrorInsufficientResources) {
             return EB_ErrorInsufficientResources;
         }
 
+        if (encHandlePtr->sequence_control_set_instance_array[instanceIndex]->sequence_control_set_ptr->static_config.zero_copy_input) {
+            eb_system_resource_set_release_callback(
+                encHandlePtr->paReferencePicturePoolPtrArray[instanceIndex],
+                ReleasePaReferenceInput,
+                EB_NULL);
+        }
+
         // Set the SequenceControlSet Picture Pool Fifo Ptrs
         encHandlePtr->sequence_control_set_instance_array[instanceIndex]->encode_context_ptr->reference_picture_pool_fifo_ptr = (encHandlePtr->referencePicturePoolProducerFifoPtrDblArray[instanceIndex])[0];
         encHandlePtr->sequence_control_set_instance_array[instanceIndex]->encode_context_ptr->pa_reference_picture_pool_fifo_ptr = (encHandlePtr->paReferencePicturePoolProducerFifoPtrDblArray[instanceIndex])[0];
     }
 
+    StartupStep(encHandlePtr, "Picture buffers");
+
     /************************************
     * System Resource Managers & Fifos
     ************************************/
 
-    // EbBufferHeaderType Input
-    return_error = eb_system_resource_ctor(
+    // EbBufferHeaderType Input, zero-copy headers own no picture memory
+    return_error = eb_system_resource_elastic_ctor(
         &encHandlePtr->input_buffer_resource_ptr,
         encHandlePtr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->input_buffer_fifo_init_count,
+        encHandlePtr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->static_config.zero_copy_input ?
+            encHandlePtr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->input_buffer_fifo_init_count :
+            encHandlePtr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->input_buffer_fifo_min_count,
         1,
         EB_ResourceCoordinationProcessInitCount,
         &encHandlePtr->input_buffer_producer_fifo_ptr_array,
         &encHandlePtr->input_buffer_consumer_fifo_ptr_array,
         EB_TRUE,
         EbInputBufferHeaderCtor,
-        encHandlePtr->sequence_control_set_instance_array[0]->sequence_control_set_ptr);
+        encHandlePtr->sequence_control_set_instance_array[0]->sequence_control_set_ptr,
+        0,
+        encHandlePtr->memory_budget_ptr);
 
     if (return_error == EB_ErrorInsufficientResources) {
         return EB_ErrorInsufficientResources;
     }
+
+    eb_system_resource_set_ctor_thread_count(1);
+
+    if (encHandlePtr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->static_config.zero_copy_input) {
+        eb_system_resource_set_release_callback(
+            encHandlePtr->input_buffer_resource_ptr,
+            ReleaseZeroCopyInput,
+            encHandlePtr->sequence_control_set_instance_array[0]->sequence_control_set_ptr);
+    }
+
     // EbBufferHeaderType Output Stream
     EB_MALLOC(EbSystemResource_t**, encHandlePtr->output_stream_buffer_resource_ptr_array, sizeof(EbSystemResource_t*) * encHandlePtr->encodeInstanceTotalCount, EB_N_PTR);
     EB_MALLOC(EbFifo_t***, encHandlePtr->output_stream_buffer_producer_fifo_ptr_dbl_array, sizeof(EbFifo_t**)          * encHandlePtr->encodeInstanceTotalCount, EB_N_PTR);
@@ -1246,6 +1830,29 @@ EB_API EbErrorType eb_init_encoder(EbComponentType *svt_enc_component)
             }
         }
     }
+#if TILES
+    if (encHandlePtr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->static_config.low_latency_tile_output) {
+        // EbBufferHeaderType Output Tile Groups, handed to the output callback only
+        EB_MALLOC(EbSystemResource_t**, encHandlePtr->tile_output_buffer_resource_ptr_array, sizeof(EbSystemResource_t*) * encHandlePtr->encodeInstanceTotalCount, EB_N_PTR);
+        EB_MALLOC(EbFifo_t***, encHandlePtr->tile_output_buffer_producer_fifo_ptr_dbl_array, sizeof(EbFifo_t**)          * encHandlePtr->encodeInstanceTotalCount, EB_N_PTR);
+
+        for (instanceIndex = 0; instanceIndex < encHandlePtr->encodeInstanceTotalCount; ++instanceIndex) {
+            return_error = eb_system_resource_ctor(
+                &encHandlePtr->tile_output_buffer_resource_ptr_array[instanceIndex],
+                MAX(encHandlePtr->sequence_control_set_instance_array[instanceIndex]->sequence_control_set_ptr->tile_output_buffer_fifo_init_count, 1),
+                1,
+                0,
+                &encHandlePtr->tile_output_buffer_producer_fifo_ptr_dbl_array[instanceIndex],
+                (EbFifo_t ***)EB_NULL,
+                EB_FALSE,
+                EbOutputBufferHeaderCtor,
+                &encHandlePtr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->static_config);
+            if (return_error == EB_ErrorInsufficientResources) {
+                return EB_ErrorInsufficientResources;
+            }
+        }
+    }
+#endif
 
     // Resource Coordination Results
     {
@@ -1533,6 +2140,16 @@ EB_API EbErrorType eb_init_encoder(EbComponentType *svt_enc_component)
         }
     }
 
+    // Pipeline Profiler, set up before the process threads start
+    if (encHandlePtr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->static_config.pipeline_profiling) {
+        return_error = ProfilePipelineStages(encHandlePtr);
+        if (return_error != EB_ErrorNone) {
+            return return_error;
+        }
+    }
+
+    StartupStep(encHandlePtr, "Queues");
+
     /************************************
     * App Callbacks
     ************************************/
@@ -1545,6 +2162,10 @@ EB_API EbErrorType eb_init_encoder(EbComponentType *svt_enc_component)
         encHandlePtr->sequence_control_set_instance_array[instanceIndex]->encode_context_ptr->stream_output_fifo_ptr     = (encHandlePtr->output_stream_buffer_producer_fifo_ptr_dbl_array[instanceIndex])[0];
         if (encHandlePtr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->static_config.recon_enabled)
             encHandlePtr->sequence_control_set_instance_array[instanceIndex]->encode_context_ptr->recon_output_fifo_ptr      = (encHandlePtr->output_recon_buffer_producer_fifo_ptr_dbl_array[instanceIndex])[0];
+#if TILES
+        if (encHandlePtr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->static_config.low_latency_tile_output)
+            encHandlePtr->sequence_control_set_instance_array[instanceIndex]->encode_context_ptr->tile_output_fifo_ptr       = (encHandlePtr->tile_output_buffer_producer_fifo_ptr_dbl_array[instanceIndex])[0];
+#endif
     }
 
     /************************************
@@ -1806,15 +2427,12 @@ EB_API EbErrorType eb_init_encoder(EbComponentType *svt_enc_component)
     if (return_error == EB_ErrorInsufficientResources) {
         return EB_ErrorInsufficientResources;
     }
+    StartupStep(encHandlePtr, "Contexts");
+
     /************************************
     * Thread Handles
     ************************************/
-    EbSvtAv1EncConfiguration   *config_ptr = &encHandlePtr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->static_config;
-
-    return_error = EbSetThreadManagementParameters(config_ptr);
-    if (return_error == EB_ErrorInsufficientResources) {
-        return EB_ErrorInsufficientResources;
-    }
+    // The thread affinity was set up by eb_init_encoder
 
     // Resource Coordination
     EB_CREATETHREAD(EbHandle, encHandlePtr->resourceCoordinationThreadHandle, sizeof(EbHandle), EB_THREAD, resource_coordination_kernel, encHandlePtr->resourceCoordinationContextPtr);
@@ -1860,33 +2478,89 @@ EB_API EbErrorType eb_init_encoder(EbComponentType *svt_enc_component)
     }
 
     // EncDec Process
-    EB_MALLOC(EbHandle*, encHandlePtr->encDecThreadHandleArray, sizeof(EbHandle) * encHandlePtr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->enc_dec_process_init_count, EB_N_PTR);
+    if (encHandlePtr->thread_pool_ptr) {
+        return_error = AttachStageToThreadPool(
+            encHandlePtr,
+            encHandlePtr->encDecContextPtrArray,
+            encHandlePtr->encDecTasksConsumerFifoPtrArray,
+            encHandlePtr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->enc_dec_process_init_count,
+            EncDecKernelTask,
+            EB_THREAD_POOL_PRIORITY_ENC_DEC);
+        if (return_error != EB_ErrorNone) {
+            return return_error;
+        }
+    }
+    else {
+        EB_MALLOC(EbHandle*, encHandlePtr->encDecThreadHandleArray, sizeof(EbHandle) * encHandlePtr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->enc_dec_process_init_count, EB_N_PTR);
 
-    for (processIndex = 0; processIndex < encHandlePtr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->enc_dec_process_init_count; ++processIndex) {
-        EB_CREATETHREAD(EbHandle, encHandlePtr->encDecThreadHandleArray[processIndex], sizeof(EbHandle), EB_THREAD, EncDecKernel, encHandlePtr->encDecContextPtrArray[processIndex]);
+        for (processIndex = 0; processIndex < encHandlePtr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->enc_dec_process_init_count; ++processIndex) {
+            EB_CREATETHREAD(EbHandle, encHandlePtr->encDecThreadHandleArray[processIndex], sizeof(EbHandle), EB_THREAD, EncDecKernel, encHandlePtr->encDecContextPtrArray[processIndex]);
+        }
     }
 
 #if FILT_PROC
     // Dlf Process
-    EB_MALLOC(EbHandle*, encHandlePtr->dlfThreadHandleArray, sizeof(EbHandle) * encHandlePtr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->dlf_process_init_count, EB_N_PTR);
+    if (encHandlePtr->thread_pool_ptr) {
+        return_error = AttachStageToThreadPool(
+            encHandlePtr,
+            encHandlePtr->dlfContextPtrArray,
+            encHandlePtr->encDecResultsConsumerFifoPtrArray,
+            encHandlePtr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->dlf_process_init_count,
+            dlf_kernel_task,
+            EB_THREAD_POOL_PRIORITY_DLF);
+        if (return_error != EB_ErrorNone) {
+            return return_error;
+        }
+    }
+    else {
+        EB_MALLOC(EbHandle*, encHandlePtr->dlfThreadHandleArray, sizeof(EbHandle) * encHandlePtr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->dlf_process_init_count, EB_N_PTR);
 
-    for (processIndex = 0; processIndex < encHandlePtr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->dlf_process_init_count; ++processIndex) {
-        EB_CREATETHREAD(EbHandle, encHandlePtr->dlfThreadHandleArray[processIndex], sizeof(EbHandle), EB_THREAD, dlf_kernel, encHandlePtr->dlfContextPtrArray[processIndex]);
+        for (processIndex = 0; processIndex < encHandlePtr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->dlf_process_init_count; ++processIndex) {
+            EB_CREATETHREAD(EbHandle, encHandlePtr->dlfThreadHandleArray[processIndex], sizeof(EbHandle), EB_THREAD, dlf_kernel, encHandlePtr->dlfContextPtrArray[processIndex]);
+        }
     }
 
 
     // Cdef Process
-    EB_MALLOC(EbHandle*, encHandlePtr->cdefThreadHandleArray, sizeof(EbHandle) * encHandlePtr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->cdef_process_init_count, EB_N_PTR);
+    if (encHandlePtr->thread_pool_ptr) {
+        return_error = AttachStageToThreadPool(
+            encHandlePtr,
+            encHandlePtr->cdefContextPtrArray,
+            encHandlePtr->dlfResultsConsumerFifoPtrArray,
+            encHandlePtr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->cdef_process_init_count,
+            cdef_kernel_task,
+            EB_THREAD_POOL_PRIORITY_CDEF);
+        if (return_error != EB_ErrorNone) {
+            return return_error;
+        }
+    }
+    else {
+        EB_MALLOC(EbHandle*, encHandlePtr->cdefThreadHandleArray, sizeof(EbHandle) * encHandlePtr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->cdef_process_init_count, EB_N_PTR);
 
-    for (processIndex = 0; processIndex < encHandlePtr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->cdef_process_init_count; ++processIndex) {
-        EB_CREATETHREAD(EbHandle, encHandlePtr->cdefThreadHandleArray[processIndex], sizeof(EbHandle), EB_THREAD, cdef_kernel, encHandlePtr->cdefContextPtrArray[processIndex]);
+        for (processIndex = 0; processIndex < encHandlePtr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->cdef_process_init_count; ++processIndex) {
+            EB_CREATETHREAD(EbHandle, encHandlePtr->cdefThreadHandleArray[processIndex], sizeof(EbHandle), EB_THREAD, cdef_kernel, encHandlePtr->cdefContextPtrArray[processIndex]);
+        }
     }
 
     // Rest Process
-    EB_MALLOC(EbHandle*, encHandlePtr->restThreadHandleArray, sizeof(EbHandle) * encHandlePtr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->rest_process_init_count, EB_N_PTR);
+    if (encHandlePtr->thread_pool_ptr) {
+        return_error = AttachStageToThreadPool(
+            encHandlePtr,
+            encHandlePtr->restContextPtrArray,
+            encHandlePtr->cdefResultsConsumerFifoPtrArray,
+            encHandlePtr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->rest_process_init_count,
+            rest_kernel_task,
+            EB_THREAD_POOL_PRIORITY_REST);
+        if (return_error != EB_ErrorNone) {
+            return return_error;
+        }
+    }
+    else {
+        EB_MALLOC(EbHandle*, encHandlePtr->restThreadHandleArray, sizeof(EbHandle) * encHandlePtr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->rest_process_init_count, EB_N_PTR);
 
-    for (processIndex = 0; processIndex < encHandlePtr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->rest_process_init_count; ++processIndex) {
-        EB_CREATETHREAD(EbHandle, encHandlePtr->restThreadHandleArray[processIndex], sizeof(EbHandle), EB_THREAD, rest_kernel, encHandlePtr->restContextPtrArray[processIndex]);
+        for (processIndex = 0; processIndex < encHandlePtr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->rest_process_init_count; ++processIndex) {
+            EB_CREATETHREAD(EbHandle, encHandlePtr->restThreadHandleArray[processIndex], sizeof(EbHandle), EB_THREAD, rest_kernel, encHandlePtr->restContextPtrArray[processIndex]);
+        }
     }
 #endif
     // Entropy Coding Process
@@ -1899,13 +2573,82 @@ EB_API EbErrorType eb_init_encoder(EbComponentType *svt_enc_component)
     // Packetization
     EB_CREATETHREAD(EbHandle, encHandlePtr->packetizationThreadHandle, sizeof(EbHandle), EB_THREAD, PacketizationKernel, encHandlePtr->packetizationContextPtr);
 
-    
+    StartupStep(encHandlePtr, "Threads");
+
+    // The pools grow on demand from here
+    if (encHandlePtr->memory_budget_ptr) {
+        eb_memory_budget_set_base(
+            encHandlePtr->memory_budget_ptr,
+            encHandlePtr->memory_map.total_lib_memory);
+
+        if (encHandlePtr->memory_map.total_lib_memory > encHandlePtr->memory_budget_ptr->budget)
+            SVT_LOG("SVT [WARNING]: the encoder needs %llu MB, above the memory budget\n", (unsigned long long)(encHandlePtr->memory_map.total_lib_memory >> 20));
+    }
+
 #if DISPLAY_MEMORY
     EB_MEMORY();
 #endif
     return return_error;
 }
 
+/**********************************
+* Initialize Encoder Library
+**********************************/
+#if defined(__linux__) || defined(__APPLE__)
+__attribute__((visibility("default")))
+#endif
+EB_API EbErrorType eb_init_encoder(EbComponentType *svt_enc_component)
+{
+    if(svt_enc_component == NULL)
+        return EB_ErrorBadParameter;
+    EbEncHandle_t *encHandlePtr = (EbEncHandle_t*)svt_enc_component->pComponentPrivate;
+    EbSvtAv1EncConfiguration *config_ptr = &encHandlePtr->sequence_control_set_instance_array[0]->sequence_control_set_ptr->static_config;
+    EbBool bindCaller = ExplicitAffinityIsSet(config_ptr);
+    EbErrorType return_error;
+#ifdef _WIN32
+    GROUP_AFFINITY callerAffinity;
+#else
+    cpu_set_t      callerAffinity;
+#endif
+
+    encHandlePtr->startup_step_count = 0;
+    encHandlePtr->startup_start_time = eb_time_us();
+    encHandlePtr->startup_step_time = encHandlePtr->startup_start_time;
+    encHandlePtr->startup_step_memory = encHandlePtr->memory_map.total_lib_memory;
+
+    return_error = EbSetThreadManagementParameters(config_ptr);
+    if (return_error != EB_ErrorNone) {
+        if (return_error == EB_ErrorBadParameter)
+            SVT_LOG("SVT [ERROR]: the cpu_mask / numa_node processors are not available\n");
+        return return_error;
+    }
+
+    // With an explicit binding the pools are constructed, hence first
+    //   touched, on the processors of the encoder threads
+    if (bindCaller) {
+#ifdef _WIN32
+        SetThreadGroupAffinity(GetCurrentThread(), &group_affinity, &callerAffinity);
+#else
+        pthread_getaffinity_np(pthread_self(), sizeof(cpu_set_t), &callerAffinity);
+        pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &group_affinity);
+#endif
+    }
+
+    return_error = InitEncoderPipeline(svt_enc_component);
+
+    if (bindCaller) {
+#ifdef _WIN32
+        SetThreadGroupAffinity(GetCurrentThread(), &callerAffinity, NULL);
+#else
+        pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &callerAffinity);
+#endif
+    }
+
+    encHandlePtr->startup_time = eb_time_us() - encHandlePtr->startup_start_time;
+
+    return return_error;
+}
+
 /**********************************
 * DeInitialize Encoder Library
 **********************************/
@@ -1918,44 +2661,32 @@ EB_API EbErrorType eb_deinit_encoder(EbComponentType *svt_enc_component)
         return EB_ErrorBadParameter;
     EbEncHandle_t *encHandlePtr = (EbEncHandle_t*)svt_enc_component->pComponentPrivate;
     EbErrorType return_error = EB_ErrorNone;
-    int32_t              ptrIndex = 0;
-    EbMemoryMapEntry*   memoryEntry = (EbMemoryMapEntry*)EB_NULL;
 
     if (encHandlePtr) {
-        if (encHandlePtr->memory_map_index) {
-            // Loop through the ptr table and free all malloc'd pointers per channel
-            for (ptrIndex = (encHandlePtr->memory_map_index) - 1; ptrIndex >= 0; --ptrIndex) {
-                memoryEntry = &encHandlePtr->memory_map[ptrIndex];
-                switch (memoryEntry->ptrType) {
-                case EB_N_PTR:
-                    free(memoryEntry->ptr);
-                    break;
-                case EB_A_PTR:
-#ifdef _WIN32
-                    _aligned_free(memoryEntry->ptr);
-#else
-                    free(memoryEntry->ptr);
-#endif
-                    break;
-                case EB_SEMAPHORE:
-                    eb_destroy_semaphore(memoryEntry->ptr);
-                    break;
-                case EB_THREAD:
-                    eb_destroy_thread(memoryEntry->ptr);
-                    break;
-                case EB_MUTEX:
-                    eb_destroy_mutex(memoryEntry->ptr);
-                    break;
-                default:
-                    return_error = EB_ErrorMax;
-                    break;
-                }
-            }
-            if (encHandlePtr->memory_map != (EbMemoryMapEntry*)NULL) {
-                free(encHandlePtr->memory_map);
+        // Pooled stages must stop running before their contexts are freed
+        if (encHandlePtr->thread_pool_ptr) {
+            eb_thread_pool_remove_owner(
+                encHandlePtr->thread_pool_ptr,
+                encHandlePtr);
+        }
+
+        if (encHandlePtr->memory_map.index) {
+            // Free all malloc'd pointers per channel
+            return_error = eb_memory_map_release(&encHandlePtr->memory_map);
+
+            if (encHandlePtr->memory_map.entries != (EbMemoryMapEntry*)NULL) {
+                free(encHandlePtr->memory_map.entries);
+                encHandlePtr->memory_map.entries = (EbMemoryMapEntry*)NULL;
             }
+            encHandlePtr->memory_map.index = 0;
 
         }
+
+        // Objects of the elastic pools still alive, once the threads are gone
+        if (encHandlePtr->memory_budget_ptr) {
+            eb_memory_budget_dtor(encHandlePtr->memory_budget_ptr);
+            encHandlePtr->memory_budget_ptr = (EbMemoryBudget_t*)EB_NULL;
+        }
     }
     return return_error;
 }
@@ -2266,6 +2997,8 @@ void CopyApiFromApp(
     sequence_control_set_ptr->static_config.enable_hme_level2_flag = ((EbSvtAv1EncConfiguration*)pComponentParameterStructure)->enable_hme_level2_flag;
     sequence_control_set_ptr->static_config.search_area_width = ((EbSvtAv1EncConfiguration*)pComponentParameterStructure)->search_area_width;
     sequence_control_set_ptr->static_config.search_area_height = ((EbSvtAv1EncConfiguration*)pComponentParameterStructure)->search_area_height;
+    sequence_control_set_ptr->static_config.adaptive_me_search_range = ((EbSvtAv1EncConfiguration*)pComponentParameterStructure)->adaptive_me_search_range;
+    sequence_control_set_ptr->static_config.static_sb_fast_path = ((EbSvtAv1EncConfiguration*)pComponentParameterStructure)->static_sb_fast_path;
     sequence_control_set_ptr->static_config.number_hme_search_region_in_width = ((EbSvtAv1EncConfiguration*)pComponentParameterStructure)->number_hme_search_region_in_width;
     sequence_control_set_ptr->static_config.number_hme_search_region_in_height = ((EbSvtAv1EncConfiguration*)pComponentParameterStructure)->number_hme_search_region_in_height;
     sequence_control_set_ptr->static_config.hme_level0_total_search_area_width = ((EbSvtAv1EncConfiguration*)pComponentParameterStructure)->hme_level0_total_search_area_width;
@@ -2299,6 +3032,7 @@ void CopyApiFromApp(
 #if TILES
     sequence_control_set_ptr->static_config.tile_rows = ((EbSvtAv1EncConfiguration*)pComponentParameterStructure)->tile_rows;
     sequence_control_set_ptr->static_config.tile_columns = ((EbSvtAv1EncConfiguration*)pComponentParameterStructure)->tile_columns;
+    sequence_control_set_ptr->static_config.low_latency_tile_output = ((EbSvtAv1EncConfiguration*)pComponentParameterStructure)->low_latency_tile_output;
 #endif
 
     // Rate Control
@@ -2352,8 +3086,33 @@ void CopyApiFromApp(
     sequence_control_set_ptr->static_config.active_channel_count = ((EbSvtAv1EncConfiguration*)pComponentParameterStructure)->active_channel_count;
     sequence_control_set_ptr->static_config.logical_processors = ((EbSvtAv1EncConfiguration*)pComponentParameterStructure)->logical_processors;
     sequence_control_set_ptr->static_config.target_socket = ((EbSvtAv1EncConfiguration*)pComponentParameterStructure)->target_socket;
+    sequence_control_set_ptr->static_config.numa_node = ((EbSvtAv1EncConfiguration*)pComponentParameterStructure)->numa_node;
+    EB_MEMCPY(sequence_control_set_ptr->static_config.cpu_mask, ((EbSvtAv1EncConfiguration*)pComponentParameterStructure)->cpu_mask, sizeof(sequence_control_set_ptr->static_config.cpu_mask));
+    sequence_control_set_ptr->static_config.picture_analysis_thread_count = ((EbSvtAv1EncConfiguration*)pComponentParameterStructure)->picture_analysis_thread_count;
+    sequence_control_set_ptr->static_config.motion_estimation_thread_count = ((EbSvtAv1EncConfiguration*)pComponentParameterStructure)->motion_estimation_thread_count;
+    sequence_control_set_ptr->static_config.source_based_operations_thread_count = ((EbSvtAv1EncConfiguration*)pComponentParameterStructure)->source_based_operations_thread_count;
+    sequence_control_set_ptr->static_config.mode_decision_configuration_thread_count = ((EbSvtAv1EncConfiguration*)pComponentParameterStructure)->mode_decision_configuration_thread_count;
+    sequence_control_set_ptr->static_config.enc_dec_thread_count = ((EbSvtAv1EncConfiguration*)pComponentParameterStructure)->enc_dec_thread_count;
+    sequence_control_set_ptr->static_config.dlf_thread_count = ((EbSvtAv1EncConfiguration*)pComponentParameterStructure)->dlf_thread_count;
+    sequence_control_set_ptr->static_config.cdef_thread_count = ((EbSvtAv1EncConfiguration*)pComponentParameterStructure)->cdef_thread_count;
+    sequence_control_set_ptr->static_config.rest_thread_count = ((EbSvtAv1EncConfiguration*)pComponentParameterStructure)->rest_thread_count;
+    sequence_control_set_ptr->static_config.entropy_coding_thread_count = ((EbSvtAv1EncConfiguration*)pComponentParameterStructure)->entropy_coding_thread_count;
+    sequence_control_set_ptr->static_config.memory_budget = ((EbSvtAv1EncConfiguration*)pComponentParameterStructure)->memory_budget;
+    sequence_control_set_ptr->static_config.lock_free_queues = ((EbSvtAv1EncConfiguration*)pComponentParameterStructure)->lock_free_queues;
+    sequence_control_set_ptr->static_config.frame_row_overlap = ((EbSvtAv1EncConfiguration*)pComponentParameterStructure)->frame_row_overlap;
     sequence_control_set_ptr->qp = ((EbSvtAv1EncConfiguration*)pComponentParameterStructure)->qp;
     sequence_control_set_ptr->static_config.recon_enabled = ((EbSvtAv1EncConfiguration*)pComponentParameterStructure)->recon_enabled;
+    sequence_control_set_ptr->static_config.pipeline_profiling = ((EbSvtAv1EncConfiguration*)pComponentParameterStructure)->pipeline_profiling;
+
+    // Zero-copy input
+    sequence_control_set_ptr->static_config.zero_copy_input = ((EbSvtAv1EncConfiguration*)pComponentParameterStructure)->zero_copy_input;
+    sequence_control_set_ptr->static_config.input_release_callback = ((EbSvtAv1EncConfiguration*)pComponentParameterStructure)->input_release_callback;
+    sequence_control_set_ptr->static_config.input_release_context = ((EbSvtAv1EncConfiguration*)pComponentParameterStructure)->input_release_context;
+
+    // Output callbacks
+    sequence_control_set_ptr->static_config.output_packet_callback = ((EbSvtAv1EncConfiguration*)pComponentParameterStructure)->output_packet_callback;
+    sequence_control_set_ptr->static_config.output_recon_callback = ((EbSvtAv1EncConfiguration*)pComponentParameterStructure)->output_recon_callback;
+    sequence_control_set_ptr->static_config.output_callback_context = ((EbSvtAv1EncConfiguration*)pComponentParameterStructure)->output_callback_context;
 
     // Extract frame rate from Numerator and Denominator if not 0
     if (sequence_control_set_ptr->static_config.frame_rate_numerator != 0 && sequence_control_set_ptr->static_config.frame_rate_denominator != 0) {
@@ -2550,6 +3309,16 @@ static EbErrorType VerifySettings(
         return_error = EB_ErrorBadParameter;
     }
 
+    if (config->adaptive_me_search_range > 1) {
+        SVT_LOG("Error Instance %u: Invalid AdaptiveSearchArea. AdaptiveSearchArea must be [0 - 1]\n", channelNumber + 1);
+        return_error = EB_ErrorBadParameter;
+    }
+
+    if (config->static_sb_fast_path > 1) {
+        SVT_LOG("Error Instance %u: Invalid StaticSbFastPath. StaticSbFastPath must be [0 - 1]\n", channelNumber + 1);
+        return_error = EB_ErrorBadParameter;
+    }
+
     if (config->enable_hme_flag) {
 
         if ((config->number_hme_search_region_in_width > (uint32_t)EB_HME_SEARCH_AREA_COLUMN_MAX_COUNT) || (config->number_hme_search_region_in_width == 0)) {
@@ -2629,7 +3398,37 @@ static EbErrorType VerifySettings(
         SVT_LOG("Error Instance %u: Log2Tile rows/cols must be [0 - 6] \n", channelNumber + 1);
         return_error = EB_ErrorBadParameter;
     }
+
+    if (config->low_latency_tile_output > 1) {
+        SVT_LOG("Error Instance %u: Invalid low latency tile output flag [0 - 1] \n", channelNumber + 1);
+        return_error = EB_ErrorBadParameter;
+    }
+
+    if (config->low_latency_tile_output && config->tile_rows == 0 && config->tile_columns == 0) {
+        SVT_LOG("Error Instance %u: Low latency tile output requires tiles \n", channelNumber + 1);
+        return_error = EB_ErrorBadParameter;
+    }
+
+    if (config->low_latency_tile_output && config->output_packet_callback == NULL) {
+        SVT_LOG("Error Instance %u: Low latency tile output requires an output packet callback \n", channelNumber + 1);
+        return_error = EB_ErrorBadParameter;
+    }
 #endif
+    if (config->lock_free_queues > 1) {
+        SVT_LOG("Error Instance %u: Invalid lock free queues flag [0 - 1] \n", channelNumber + 1);
+        return_error = EB_ErrorBadParameter;
+    }
+
+    if (config->memory_budget && config->lock_free_queues == 0) {
+        SVT_LOG("Error Instance %u: Memory budget requires lock free queues \n", channelNumber + 1);
+        return_error = EB_ErrorBadParameter;
+    }
+
+    if (config->frame_row_overlap > 1) {
+        SVT_LOG("Error Instance %u: Invalid frame row overlap flag [0 - 1] \n", channelNumber + 1);
+        return_error = EB_ErrorBadParameter;
+    }
+
     if (config->scene_change_detection > 1) {
         SVT_LOG("Error Instance %u: The scene change detection must be [0 - 1] \n", channelNumber + 1);
         return_error = EB_ErrorBadParameter;
@@ -2725,6 +3524,44 @@ static EbErrorType VerifySettings(
         return_error = EB_ErrorBadParameter;
     }
 
+    if (config->numa_node < -1) {
+        SVT_LOG("Error instance %u: Invalid NumaNode. NumaNode must be -1 or a node index \n", channelNumber + 1);
+        return_error = EB_ErrorBadParameter;
+    }
+
+    if (config->picture_analysis_thread_count > EB_MAX_STAGE_THREAD_COUNT ||
+        config->motion_estimation_thread_count > EB_MAX_STAGE_THREAD_COUNT ||
+        config->source_based_operations_thread_count > EB_MAX_STAGE_THREAD_COUNT ||
+        config->mode_decision_configuration_thread_count > EB_MAX_STAGE_THREAD_COUNT ||
+        config->enc_dec_thread_count > EB_MAX_STAGE_THREAD_COUNT ||
+        config->dlf_thread_count > EB_MAX_STAGE_THREAD_COUNT ||
+        config->cdef_thread_count > EB_MAX_STAGE_THREAD_COUNT ||
+        config->rest_thread_count > EB_MAX_STAGE_THREAD_COUNT ||
+        config->entropy_coding_thread_count > EB_MAX_STAGE_THREAD_COUNT) {
+        SVT_LOG("Error instance %u: Invalid stage thread count. The thread count of a stage must be [0 - %d] \n", channelNumber + 1, EB_MAX_STAGE_THREAD_COUNT);
+        return_error = EB_ErrorBadParameter;
+    }
+
+    if (ExplicitAffinityIsSet(config) && ExplicitAffinityProcessorCount(config) == 0) {
+        SVT_LOG("Error instance %u: None of the processors selected by CpuList / NumaNode is available \n", channelNumber + 1);
+        return_error = EB_ErrorBadParameter;
+    }
+
+    if (config->zero_copy_input > 1) {
+        SVT_LOG("Error instance %u: Invalid zero copy input flag [0 - 1] \n", channelNumber + 1);
+        return_error = EB_ErrorBadParameter;
+    }
+
+    if (config->zero_copy_input && config->encoder_bit_depth != 8) {
+        SVT_LOG("Error instance %u: Zero copy input requires 8-bit input \n", channelNumber + 1);
+        return_error = EB_ErrorBadParameter;
+    }
+
+    if (config->zero_copy_input && config->input_release_callback == NULL) {
+        SVT_LOG("Error instance %u: Zero copy input requires an input release callback \n", channelNumber + 1);
+        return_error = EB_ErrorBadParameter;
+    }
+
     return return_error;
 }
 
@@ -2754,6 +3591,7 @@ EbErrorType eb_svt_enc_init_parameter(
 #if TILES
     config_ptr->tile_rows = 0;
     config_ptr->tile_columns = 0;
+    config_ptr->low_latency_tile_output = 0;
 #endif
     config_ptr->qp = 50;
     config_ptr->use_qp_file = EB_FALSE;
@@ -2784,6 +3622,8 @@ EbErrorType eb_svt_enc_init_parameter(
     config_ptr->enable_hme_level2_flag = EB_FALSE;
     config_ptr->search_area_width = 16;
     config_ptr->search_area_height = 7;
+    config_ptr->adaptive_me_search_range = 0;
+    config_ptr->static_sb_fast_path = 0;
     config_ptr->number_hme_search_region_in_width = 2;
     config_ptr->number_hme_search_region_in_height = 2;
     config_ptr->hme_level0_total_search_area_width = 64;
@@ -2841,11 +3681,36 @@ EbErrorType eb_svt_enc_init_parameter(
     // Channel info
     config_ptr->logical_processors = 0;
     config_ptr->target_socket = -1;
+    config_ptr->numa_node = -1;
+    memset(config_ptr->cpu_mask, 0, sizeof(config_ptr->cpu_mask));
+    config_ptr->picture_analysis_thread_count = 0;
+    config_ptr->motion_estimation_thread_count = 0;
+    config_ptr->source_based_operations_thread_count = 0;
+    config_ptr->mode_decision_configuration_thread_count = 0;
+    config_ptr->enc_dec_thread_count = 0;
+    config_ptr->dlf_thread_count = 0;
+    config_ptr->cdef_thread_count = 0;
+    config_ptr->rest_thread_count = 0;
+    config_ptr->entropy_coding_thread_count = 0;
+    config_ptr->memory_budget = 0;
+    config_ptr->lock_free_queues = 0;
+    config_ptr->frame_row_overlap = 0;
     config_ptr->channel_id = 0;
     config_ptr->active_channel_count = 1;
 
     // Debug info
     config_ptr->recon_enabled = 0;
+    config_ptr->pipeline_profiling = 0;
+
+    // Input buffers
+    config_ptr->zero_copy_input = 0;
+    config_ptr->input_release_callback = NULL;
+    config_ptr->input_release_context = NULL;
+
+    // Output buffers
+    config_ptr->output_packet_callback = NULL;
+    config_ptr->output_recon_callback = NULL;
+    config_ptr->output_callback_context = NULL;
 
     return return_error;
 }
@@ -2902,6 +3767,8 @@ static void PrintLibParams(
         scs->me_segment_row_count_array[1],
         scs->me_segment_row_count_array[2],
         scs->me_segment_row_count_array[3]);
+    SVT_LOG("\nSVT [config]: PA_SEG_H \t\t\t\t\t\t\t\t: %d ",
+        scs->pa_segment_row_count);
     SVT_LOG("\nSVT [config]: ME_SEG_W0 / ME_SEG_W1 / ME_SEG_W2 / ME_SEG_W3 \t\t\t: %d / %d / %d / %d ",
         scs->enc_dec_segment_col_count_array[0],
         scs->enc_dec_segment_col_count_array[1],
@@ -2947,6 +3814,9 @@ EB_API EbErrorType eb_svt_enc_set_parameter(
     EbEncHandle_t        *pEncCompData  = (EbEncHandle_t*)svt_enc_component->pComponentPrivate;
     uint32_t              instanceIndex = 0;
 
+    // Bind the handle Memory Map to the calling thread
+    memory_map = &pEncCompData->memory_map;
+
     // Acquire Config Mutex
     eb_block_on_mutex(pEncCompData->sequence_control_set_instance_array[instanceIndex]->config_mutex);
 
@@ -2994,6 +3864,65 @@ EB_API EbErrorType eb_svt_enc_set_parameter(
 
     return return_error;
 }
+/**********************************
+* Shared Thread Pool
+**********************************/
+#if defined(__linux__) || defined(__APPLE__)
+__attribute__((visibility("default")))
+#endif
+EB_API EbErrorType eb_svt_create_thread_pool(
+    EbThreadPool             **thread_pool_dbl_ptr,
+    uint32_t                   thread_count)
+{
+    if (thread_pool_dbl_ptr == NULL)
+        return EB_ErrorBadParameter;
+
+    if (thread_count == 0)
+        thread_count = GetNumProcessors();
+
+    return eb_thread_pool_ctor(
+        thread_pool_dbl_ptr,
+        thread_count);
+}
+
+#if defined(__linux__) || defined(__APPLE__)
+__attribute__((visibility("default")))
+#endif
+EB_API EbErrorType eb_svt_enc_attach_thread_pool(
+    EbComponentType           *svt_enc_component,
+    EbThreadPool              *thread_pool_ptr)
+{
+    if (svt_enc_component == NULL || thread_pool_ptr == NULL)
+        return EB_ErrorBadParameter;
+
+    EbEncHandle_t *encHandlePtr = (EbEncHandle_t*)svt_enc_component->pComponentPrivate;
+
+    // The stage threads are created by eb_init_encoder: too late to share them
+    if (encHandlePtr->resourceCoordinationThreadHandle)
+        return EB_ErrorBadParameter;
+
+    encHandlePtr->thread_pool_ptr = thread_pool_ptr;
+
+    return EB_ErrorNone;
+}
+
+#if defined(__linux__) || defined(__APPLE__)
+__attribute__((visibility("default")))
+#endif
+EB_API EbErrorType eb_svt_destroy_thread_pool(
+    EbThreadPool              *thread_pool_ptr)
+{
+    if (thread_pool_ptr == NULL)
+        return EB_ErrorBadParameter;
+
+    if (eb_thread_pool_slot_count(thread_pool_ptr))
+        return EB_ErrorUndefined;
+
+    eb_thread_pool_dtor(thread_pool_ptr);
+
+    return EB_ErrorNone;
+}
+
 #if defined(__linux__) || defined(__APPLE__)
 __attribute__((visibility("default")))
 #endif
@@ -3188,6 +4117,31 @@ static EbErrorType CopyFrameBuffer(
     }
     return return_error;
 }
+
+/***********************************************
+**** Point the library picture at the
+**** application buffer (zero-copy input)
+************************************************/
+static void AssignFrameBuffer(
+    SequenceControlSet_t            *sequence_control_set_ptr,
+    uint8_t                          *dst,
+    uint8_t                          *src)
+{
+    EbPictureBufferDesc_t           *input_picture_ptr = (EbPictureBufferDesc_t*)dst;
+    EbSvtEncInput                   *inputPtr = (EbSvtEncInput*)src;
+
+    if (inputPtr == NULL) {
+        input_picture_ptr->buffer_y = (EbByte)EB_NULL;
+        input_picture_ptr->bufferCb = (EbByte)EB_NULL;
+        input_picture_ptr->bufferCr = (EbByte)EB_NULL;
+        return;
+    }
+
+    input_picture_ptr->buffer_y = inputPtr->luma - (input_picture_ptr->stride_y*sequence_control_set_ptr->top_padding + sequence_control_set_ptr->left_padding);
+    input_picture_ptr->bufferCb = inputPtr->cb - (input_picture_ptr->strideCb*(sequence_control_set_ptr->top_padding >> 1) + (sequence_control_set_ptr->left_padding >> 1));
+    input_picture_ptr->bufferCr = inputPtr->cr - (input_picture_ptr->strideCr*(sequence_control_set_ptr->top_padding >> 1) + (sequence_control_set_ptr->left_padding >> 1));
+}
+
 static void CopyInputBuffer(
     SequenceControlSet_t*    sequenceControlSet,
     EbBufferHeaderType*     dst,
@@ -3205,7 +4159,12 @@ static void CopyInputBuffer(
     dst->pic_type = src->pic_type;
 
     // Copy the picture buffer
-    if (src->p_buffer != NULL)
+    if (sequenceControlSet->static_config.zero_copy_input) {
+        // Kept so the application can identify the buffer when it is released
+        dst->p_app_private = src->p_app_private;
+        AssignFrameBuffer(sequenceControlSet, dst->p_buffer, src->p_buffer);
+    }
+    else if (src->p_buffer != NULL)
         CopyFrameBuffer(sequenceControlSet, dst->p_buffer, src->p_buffer);
 }
 
@@ -3220,8 +4179,18 @@ EB_API EbErrorType eb_svt_enc_send_picture(
     EbBufferHeaderType   *p_buffer)
 {
     EbEncHandle_t          *encHandlePtr = (EbEncHandle_t*)svt_enc_component->pComponentPrivate;
+    SequenceControlSet_t   *sequence_control_set_ptr = encHandlePtr->sequence_control_set_instance_array[0]->sequence_control_set_ptr;
     EbObjectWrapper_t      *ebWrapperPtr;
 
+    // Zero-copy buffers are used in place, so they must have the library layout
+    if (sequence_control_set_ptr->static_config.zero_copy_input && p_buffer != NULL && p_buffer->p_buffer != NULL) {
+        EbSvtEncInput *inputPtr = (EbSvtEncInput*)p_buffer->p_buffer;
+        uint32_t lumaStride = sequence_control_set_ptr->max_input_luma_width + sequence_control_set_ptr->left_padding + sequence_control_set_ptr->right_padding;
+
+        if (inputPtr->yStride != lumaStride || inputPtr->cbStride != (lumaStride >> 1) || inputPtr->crStride != (lumaStride >> 1))
+            return EB_ErrorBadParameter;
+    }
+
     // Take the buffer and put it into our internal queue structure
     eb_get_empty_object(
         encHandlePtr->input_buffer_producer_fifo_ptr_array[0],
@@ -3229,7 +4198,7 @@ EB_API EbErrorType eb_svt_enc_send_picture(
 
     if (p_buffer != NULL) {
         CopyInputBuffer(
-            encHandlePtr->sequence_control_set_instance_array[0]->sequence_control_set_ptr,
+            sequence_control_set_ptr,
             (EbBufferHeaderType*)ebWrapperPtr->object_ptr,
             p_buffer);
     }
@@ -3238,6 +4207,92 @@ EB_API EbErrorType eb_svt_enc_send_picture(
 
     return EB_ErrorNone;
 }
+
+/**********************************
+* Zero-copy Input Layout
+**********************************/
+#if defined(__linux__) || defined(__APPLE__)
+__attribute__((visibility("default")))
+#endif
+EB_API EbErrorType eb_svt_enc_get_input_layout(
+    EbComponentType      *svt_enc_component,
+    EbSvtInputLayout     *layout_ptr)
+{
+    EbEncHandle_t          *encHandlePtr;
+    SequenceControlSet_t   *sequence_control_set_ptr;
+    uint32_t                lumaStride;
+
+    if (svt_enc_component == NULL || layout_ptr == NULL)
+        return EB_ErrorBadParameter;
+
+    encHandlePtr = (EbEncHandle_t*)svt_enc_component->pComponentPrivate;
+    sequence_control_set_ptr = encHandlePtr->sequence_control_set_instance_array[0]->sequence_control_set_ptr;
+
+    // Same layout as the input pictures allocated by allocate_frame_buffer()
+    lumaStride = sequence_control_set_ptr->max_input_luma_width + sequence_control_set_ptr->left_padding + sequence_control_set_ptr->right_padding;
+
+    layout_ptr->yStride = lumaStride;
+    layout_ptr->cbStride = lumaStride >> 1;
+    layout_ptr->crStride = lumaStride >> 1;
+    layout_ptr->lumaOffset = lumaStride * sequence_control_set_ptr->top_padding + sequence_control_set_ptr->left_padding;
+    layout_ptr->chromaOffset = (lumaStride >> 1) * (sequence_control_set_ptr->top_padding >> 1) + (sequence_control_set_ptr->left_padding >> 1);
+    layout_ptr->lumaSize = lumaStride * (sequence_control_set_ptr->max_input_luma_height + sequence_control_set_ptr->top_padding + sequence_control_set_ptr->bot_padding);
+    layout_ptr->chromaSize = layout_ptr->lumaSize >> 2;
+
+    return EB_ErrorNone;
+}
+
+/**********************************
+* Pipeline Profile
+**********************************/
+#if defined(__linux__) || defined(__APPLE__)
+__attribute__((visibility("default")))
+#endif
+EB_API EbErrorType eb_svt_enc_get_pipeline_profile(
+    EbComponentType      *svt_enc_component,
+    EbPipelineProfile    *profile_ptr)
+{
+    EbEncHandle_t *encHandlePtr;
+
+    if (svt_enc_component == NULL || profile_ptr == NULL)
+        return EB_ErrorBadParameter;
+
+    encHandlePtr = (EbEncHandle_t*)svt_enc_component->pComponentPrivate;
+
+    if (encHandlePtr->pipeline_profiler_ptr == (struct EbPipelineProfiler_s*)EB_NULL)
+        return EB_ErrorBadParameter;
+
+    eb_pipeline_profiler_get_profile(
+        encHandlePtr->pipeline_profiler_ptr,
+        profile_ptr);
+
+    return EB_ErrorNone;
+}
+
+/**********************************
+* Startup Profile
+**********************************/
+#if defined(__linux__) || defined(__APPLE__)
+__attribute__((visibility("default")))
+#endif
+EB_API EbErrorType eb_svt_enc_get_startup_profile(
+    EbComponentType      *svt_enc_component,
+    EbStartupProfile     *profile_ptr)
+{
+    EbEncHandle_t *encHandlePtr;
+
+    if (svt_enc_component == NULL || profile_ptr == NULL)
+        return EB_ErrorBadParameter;
+
+    encHandlePtr = (EbEncHandle_t*)svt_enc_component->pComponentPrivate;
+
+    profile_ptr->step_count = encHandlePtr->startup_step_count;
+    profile_ptr->step_array = encHandlePtr->startup_step_array;
+    profile_ptr->total_time = encHandlePtr->startup_time;
+    profile_ptr->total_memory = encHandlePtr->memory_map.total_lib_memory;
+
+    return EB_ErrorNone;
+}
 static void CopyOutputReconBuffer(
     EbBufferHeaderType   *dst,
     EbBufferHeaderType   *src
@@ -3388,7 +4443,9 @@ void lib_svt_encoder_send_error_exit(
     outputPacket->flags    = errorCode;
     outputPacket->p_buffer   = NULL;
 
-    eb_post_full_object(ebWrapperPtr);
+    eb_output_packet(
+        &pEncCompData->sequence_control_set_instance_array[0]->sequence_control_set_ptr->static_config,
+        ebWrapperPtr);
 }
 /**********************************
 * Encoder Handle Initialization
@@ -3454,6 +4511,10 @@ static EbErrorType allocate_frame_buffer(
 
     input_picture_buffer_desc_init_data.bufferEnableMask = PICTURE_BUFFER_DESC_FULL_MASK;
 
+    // Zero-copy input pictures point to the application buffers
+    if (config->zero_copy_input)
+        input_picture_buffer_desc_init_data.bufferEnableMask = 0;
+
     if (is16bit && config->compressed_ten_bit_format == 1) {
         input_picture_buffer_desc_init_data.splitMode = EB_FALSE;  //do special allocation for 2bit data down below.        
     }
@@ -16,6 +16,8 @@
 #include "EbPictureDemuxResults.h"
 #include "EbRateControlResults.h"
 
+#define EB_STARTUP_STEP_MAX_COUNT   16
+
 /**************************************
  * Component Private Data
  **************************************/
@@ -102,6 +104,9 @@ typedef struct EbEncHandle_s
     EbSystemResource_t                     *input_buffer_resource_ptr;
     EbSystemResource_t                    **output_stream_buffer_resource_ptr_array;
     EbSystemResource_t                    **output_recon_buffer_resource_ptr_array;
+#if TILES
+    EbSystemResource_t                    **tile_output_buffer_resource_ptr_array;
+#endif
     EbSystemResource_t                    **output_statistics_buffer_resource_ptr_array;
     EbSystemResource_t                     *resourceCoordinationResultsResourcePtr;
     EbSystemResource_t                     *pictureAnalysisResultsResourcePtr;
@@ -124,6 +129,9 @@ typedef struct EbEncHandle_s
     EbFifo_t                              **input_buffer_producer_fifo_ptr_array;
     EbFifo_t                             ***output_stream_buffer_producer_fifo_ptr_dbl_array;
     EbFifo_t                             ***output_recon_buffer_producer_fifo_ptr_dbl_array;
+#if TILES
+    EbFifo_t                             ***tile_output_buffer_producer_fifo_ptr_dbl_array;
+#endif
     EbFifo_t                             ***output_statistics_buffer_producer_fifo_ptr_dbl_array;
     EbFifo_t                              **resourceCoordinationResultsProducerFifoPtrArray;
     EbFifo_t                              **pictureAnalysisResultsProducerFifoPtrArray;
@@ -167,10 +175,25 @@ typedef struct EbEncHandle_s
     // Callbacks
     EbCallback_t                          **app_callback_ptr_array;
 
+    // Shared worker threads running the EncDec, DLF, CDEF and Rest stages (optional)
+    struct EbThreadPool                    *thread_pool_ptr;
+
+    // Queue and stage timings, NULL unless pipeline_profiling is set
+    struct EbPipelineProfiler_s            *pipeline_profiler_ptr;
+
+    // Memory of the elastic pools, NULL unless memory_budget is set
+    EbMemoryBudget_t                       *memory_budget_ptr;
+
+    // eb_init_encoder steps, see eb_svt_enc_get_startup_profile
+    EbStartupStep                           startup_step_array[EB_STARTUP_STEP_MAX_COUNT];
+    uint32_t                                startup_step_count;
+    uint64_t                                startup_start_time;
+    uint64_t                                startup_step_time;          // start of the current step
+    uint64_t                                startup_step_memory;
+    uint64_t                                startup_time;
+
     // Memory Map
-    EbMemoryMapEntry                       *memory_map;
-    uint32_t                                memory_map_index;
-    uint64_t                                total_lib_memory;
+    EbMemoryMap                             memory_map;
 
 } EbEncHandle_t;
 
@@ -183,6 +183,14 @@ EbErrorType encode_context_ctor(
     // Signalling the need for a td structure to be written in the bitstream - on when the sequence starts
     encode_context_ptr->td_needed = EB_TRUE;
 
+#if TILES
+    // Low Latency Tile Output
+    EB_CREATEMUTEX(EbHandle, encode_context_ptr->tile_output_mutex, sizeof(EbHandle), EB_MUTEX);
+    encode_context_ptr->tile_output_decode_order = 0;
+    encode_context_ptr->tile_output_fifo_ptr = (EbFifo_t*)EB_NULL;
+    encode_context_ptr->tile_output_spare_ptr = (EbObjectWrapper_t*)EB_NULL;
+#endif
+
     // Prediction Structure Group
     encode_context_ptr->prediction_structure_group_ptr = (PredictionStructureGroup_t*)EB_NULL;
 
@@ -221,15 +229,7 @@ EbErrorType encode_context_ctor(
     encode_context_ptr->max_coded_poc = 0;
     encode_context_ptr->max_coded_poc_selected_ref_qp = 32;
 
-    encode_context_ptr->shared_reference_mutex = eb_create_mutex();
-    if (encode_context_ptr->shared_reference_mutex == (EbHandle)EB_NULL) {
-        return EB_ErrorInsufficientResources;
-    }
-    else {
-        memory_map[*(memory_map_index)].ptrType = EB_MUTEX;
-        memory_map[(*(memory_map_index))++].ptr = encode_context_ptr->shared_reference_mutex;
-        *total_lib_memory += (sizeof(EbHandle));
-    }
+    EB_CREATEMUTEX(EbHandle, encode_context_ptr->shared_reference_mutex, sizeof(EbHandle), EB_MUTEX);
 
 
     return EB_ErrorNone;
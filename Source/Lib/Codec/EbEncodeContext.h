@@ -53,6 +53,15 @@ typedef struct EncodeContext_s
     EbFifo_t                                        *stream_output_fifo_ptr;
     EbFifo_t                                        *recon_output_fifo_ptr;
     EbFifo_t                                        *statistics_output_fifo_ptr;
+#if TILES
+    EbFifo_t                                        *tile_output_fifo_ptr;
+
+    // Low latency tile output: decode order of the picture whose tile groups go out next,
+    //   and the empty packets taken ahead for the tile groups coded but not out yet
+    EbHandle                                         tile_output_mutex;
+    uint64_t                                         tile_output_decode_order;
+    EbObjectWrapper_t                               *tile_output_spare_ptr;
+#endif
 
     // Picture Buffer Fifos
     EbFifo_t                                        *reference_picture_pool_fifo_ptr;
@@ -115,7 +124,8 @@ typedef struct EncodeContext_s
     uint64_t                                         terminating_picture_number;
     EbBool                                           terminating_sequence_flag_received;
 
-    // Signalling the need for a td structure to be written in the bitstream - only used in the PK process so no need for a mutex
+    // Signalling the need for a td structure to be written in the bitstream - only used in the PK process, or
+    //   by the tile output of the picture next in decode order, so no need for a mutex
     EbBool                                           td_needed;
 
     // Prediction Structure
@@ -1423,7 +1423,8 @@ EbErrorType EncodeSliceFinish(
 {
     EbErrorType return_error = EB_ErrorNone;
 
-    aom_stop_encode(&entropy_coder_ptr->ecWriter);
+    if (aom_stop_encode(&entropy_coder_ptr->ecWriter) < 0)
+        return_error = EB_ErrorInsufficientResources;
 
     return return_error;
 }
@@ -4563,16 +4564,71 @@ EbErrorType WriteFrameHeaderAv1(
     return return_error;
 }
 
+#if TILES
 /**************************************************
-* EncodeSPSAv1
+* encode_frame_header_obu_av1
+*   Frame header OBU of a picture whose tiles go to
+*   tile group OBUs of their own. Returns its size.
 **************************************************/
-EbErrorType EncodeSPSAv1(
-    Bitstream_t *bitstreamPtr,
+uint32_t encode_frame_header_obu_av1(
+    uint8_t              *data,
+    SequenceControlSet_t *scsPtr,
+    PictureControlSet_t  *pcsPtr)
+{
+    const uint32_t obuHeaderSize = WriteObuHeader(OBU_FRAME_HEADER, 0, data);
+    const uint32_t obuPayloadSize = WriteFrameHeaderObu(scsPtr, pcsPtr->parent_pcs_ptr, data + obuHeaderSize, 0, 1);
+    const size_t lengthFieldSize = ObuMemMove(obuHeaderSize, obuPayloadSize, data);
+
+    if (WriteUlebObuSize(obuHeaderSize, obuPayloadSize, data) != AOM_CODEC_OK)
+        assert(0);
+
+    return obuHeaderSize + obuPayloadSize + (uint32_t)lengthFieldSize;
+}
+
+/**************************************************
+* encode_tile_group_obu_av1
+*   Tile group OBU holding the coded tile tile_idx
+*   alone. Returns its size, data may be NULL to
+*   only get the size.
+**************************************************/
+uint32_t encode_tile_group_obu_av1(
+    uint8_t              *data,
+    PictureControlSet_t  *pcsPtr,
+    uint32_t              tile_idx)
+{
+    const Av1Common *const cm = pcsPtr->parent_pcs_ptr->av1_cm;
+    const int n_log2_tiles = cm->log2_tile_rows + cm->log2_tile_cols;
+    EntropyCoder_t *entropy_coder_ptr = pcsPtr->ec_tile_ptr_array[tile_idx]->entropy_coder_ptr;
+    const uint32_t tileSize = entropy_coder_ptr->ecWriter.pos;
+    // tile_start_and_end_present_flag, tg_start and tg_end
+    const uint32_t tileGroupHeaderSize = (1 + 2 * n_log2_tiles + 7) >> 3;
+    const uint32_t obuPayloadSize = tileGroupHeaderSize + tileSize;
+    const uint32_t lengthFieldSize = (uint32_t)aom_uleb_size_in_bytes(obuPayloadSize);
+    uint32_t obuHeaderSize;
+
+    if (data == NULL)
+        return 1 + lengthFieldSize + obuPayloadSize;
+
+    obuHeaderSize = WriteObuHeader(OBU_TILE_GROUP, 0, data);
+    if (WriteUlebObuSize(obuHeaderSize, obuPayloadSize, data) != AOM_CODEC_OK)
+        assert(0);
+    data += obuHeaderSize + lengthFieldSize;
+
+    data += write_tile_group_header(data, tile_idx, tile_idx, n_log2_tiles, 1);
+    memcpy(data, ((OutputBitstreamUnit_t*)entropy_coder_ptr->ecOutputBitstreamPtr)->bufferAv1, tileSize);
+
+    return obuHeaderSize + lengthFieldSize + obuPayloadSize;
+}
+#endif
+
+/**************************************************
+* encode_sps_obu_av1
+*   Sequence header OBU. Returns its size.
+**************************************************/
+uint32_t encode_sps_obu_av1(
+    uint8_t              *data,
     SequenceControlSet_t *scsPtr)
 {
-    EbErrorType            return_error = EB_ErrorNone;
-    OutputBitstreamUnit_t  *outputBitstreamPtr = (OutputBitstreamUnit_t*)bitstreamPtr->outputBitstreamPtr;
-    uint8_t                *data = outputBitstreamPtr->bufferAv1;
     uint32_t                obuHeaderSize = 0;
     uint32_t                obuPayloadSize = 0;
     const uint8_t enhancementLayersCnt = 0;// cm->enhancementLayersCnt;
@@ -4589,8 +4645,20 @@ EbErrorType EncodeSPSAv1(
         // return AOM_CODEC_ERROR;
     }
 
-    data += obuHeaderSize + obuPayloadSize + lengthFieldSize;
-    outputBitstreamPtr->bufferAv1 = data;
+    return obuHeaderSize + obuPayloadSize + (uint32_t)lengthFieldSize;
+}
+
+/**************************************************
+* EncodeSPSAv1
+**************************************************/
+EbErrorType EncodeSPSAv1(
+    Bitstream_t *bitstreamPtr,
+    SequenceControlSet_t *scsPtr)
+{
+    EbErrorType            return_error = EB_ErrorNone;
+    OutputBitstreamUnit_t  *outputBitstreamPtr = (OutputBitstreamUnit_t*)bitstreamPtr->outputBitstreamPtr;
+
+    outputBitstreamPtr->bufferAv1 += encode_sps_obu_av1(outputBitstreamPtr->bufferAv1, scsPtr);
     return return_error;
 }
 /**************************************************
@@ -4654,6 +4722,7 @@ static void Av1writeDeltaQindex(
 static void write_cdef(
     SequenceControlSet_t     *seqCSetPtr,
     PictureControlSet_t     *p_pcs_ptr,
+    int32_t                 *cdef_preset,
     //Av1Common *cm,
     MacroBlockD *const xd,
     aom_writer *w,
@@ -4681,8 +4750,8 @@ static void write_cdef(
 // Initialise when at top left part of the superblock
     if (!(mi_row & (seqCSetPtr->mib_size - 1)) &&
         !(mi_col & (seqCSetPtr->mib_size - 1))) {  // Top left?
-        p_pcs_ptr->cdef_preset[0] = p_pcs_ptr->cdef_preset[1] = p_pcs_ptr->cdef_preset[2] =
-            p_pcs_ptr->cdef_preset[3] = -1;
+        cdef_preset[0] = cdef_preset[1] = cdef_preset[2] =
+            cdef_preset[3] = -1;
     }
 
     // Emit CDEF param at first non-skip coding block
@@ -4691,9 +4760,9 @@ static void write_cdef(
         ? !!(mi_col & mask) + 2 * !!(mi_row & mask)
         : 0;
 
-    if (p_pcs_ptr->cdef_preset[index] == -1 && !skip) {
+    if (cdef_preset[index] == -1 && !skip) {
         aom_write_literal(w, mi->mbmi.cdef_strength, p_pcs_ptr->parent_pcs_ptr->cdef_bits);
-        p_pcs_ptr->cdef_preset[index] = mi->mbmi.cdef_strength;
+        cdef_preset[index] = mi->mbmi.cdef_strength;
 
 
     }
@@ -4701,10 +4770,10 @@ static void write_cdef(
 }
 
 
-void av1_reset_loop_restoration(PictureControlSet_t     *piCSetPtr) {
+void av1_reset_loop_restoration(EntropyCodingTile_t *ec_tile_ptr) {
     for (int32_t p = 0; p < 3; ++p) {
-        set_default_wiener(piCSetPtr->wiener_info + p);
-        set_default_sgrproj(piCSetPtr->sgrproj_info + p);
+        set_default_wiener(ec_tile_ptr->wiener_info + p);
+        set_default_sgrproj(ec_tile_ptr->sgrproj_info + p);
     }
 }
 static void write_wiener_filter(int32_t wiener_win, const WienerInfo *wiener_info,
@@ -4782,7 +4851,7 @@ static void write_sgrproj_filter(const SgrprojInfo *sgrproj_info,
 
     memcpy(ref_sgrproj_info, sgrproj_info, sizeof(*sgrproj_info));
 }
-static void loop_restoration_write_sb_coeffs(PictureControlSet_t     *piCSetPtr, FRAME_CONTEXT           *frameContext, const Av1Common *const cm,
+static void loop_restoration_write_sb_coeffs(EntropyCodingTile_t *ec_tile_ptr, FRAME_CONTEXT           *frameContext, const Av1Common *const cm,
     //MacroBlockD *xd,
     const RestorationUnitInfo *rui,
     aom_writer *const w, int32_t plane/*,
@@ -4796,8 +4865,8 @@ static void loop_restoration_write_sb_coeffs(PictureControlSet_t     *piCSetPtr,
 //    assert(!cm->all_lossless);
 
     const int32_t wiener_win = (plane > 0) ? WIENER_WIN_CHROMA : WIENER_WIN;
-    WienerInfo *wiener_info = piCSetPtr->wiener_info + plane;
-    SgrprojInfo *sgrproj_info = piCSetPtr->sgrproj_info + plane;
+    WienerInfo *wiener_info = ec_tile_ptr->wiener_info + plane;
+    SgrprojInfo *sgrproj_info = ec_tile_ptr->sgrproj_info + plane;
     RestorationType unit_rtype = rui->restoration_type;
 
 
@@ -4858,18 +4927,19 @@ EbErrorType ec_update_neighbors(
     block_size                bsize,
     EbPictureBufferDesc_t   *coeffPtr)
 {
+    UNUSED(picture_control_set_ptr);
     UNUSED(coeffPtr);
     EbErrorType return_error = EB_ErrorNone;
-    NeighborArrayUnit_t     *mode_type_neighbor_array = picture_control_set_ptr->mode_type_neighbor_array;
-    NeighborArrayUnit_t     *partition_context_neighbor_array = picture_control_set_ptr->partition_context_neighbor_array;
-    NeighborArrayUnit_t     *skip_flag_neighbor_array = picture_control_set_ptr->skip_flag_neighbor_array;
-    NeighborArrayUnit_t     *skip_coeff_neighbor_array = picture_control_set_ptr->skip_coeff_neighbor_array;
-    NeighborArrayUnit_t     *luma_dc_sign_level_coeff_neighbor_array = picture_control_set_ptr->luma_dc_sign_level_coeff_neighbor_array;
-    NeighborArrayUnit_t     *cr_dc_sign_level_coeff_neighbor_array = picture_control_set_ptr->cr_dc_sign_level_coeff_neighbor_array;
-    NeighborArrayUnit_t     *cb_dc_sign_level_coeff_neighbor_array = picture_control_set_ptr->cb_dc_sign_level_coeff_neighbor_array;
-    NeighborArrayUnit_t     *inter_pred_dir_neighbor_array = picture_control_set_ptr->inter_pred_dir_neighbor_array;
-    NeighborArrayUnit_t     *ref_frame_type_neighbor_array = picture_control_set_ptr->ref_frame_type_neighbor_array;
-    NeighborArrayUnit32_t   *interpolation_type_neighbor_array = picture_control_set_ptr->interpolation_type_neighbor_array;
+    NeighborArrayUnit_t     *mode_type_neighbor_array = context_ptr->ec_tile_ptr->mode_type_neighbor_array;
+    NeighborArrayUnit_t     *partition_context_neighbor_array = context_ptr->ec_tile_ptr->partition_context_neighbor_array;
+    NeighborArrayUnit_t     *skip_flag_neighbor_array = context_ptr->ec_tile_ptr->skip_flag_neighbor_array;
+    NeighborArrayUnit_t     *skip_coeff_neighbor_array = context_ptr->ec_tile_ptr->skip_coeff_neighbor_array;
+    NeighborArrayUnit_t     *luma_dc_sign_level_coeff_neighbor_array = context_ptr->ec_tile_ptr->luma_dc_sign_level_coeff_neighbor_array;
+    NeighborArrayUnit_t     *cr_dc_sign_level_coeff_neighbor_array = context_ptr->ec_tile_ptr->cr_dc_sign_level_coeff_neighbor_array;
+    NeighborArrayUnit_t     *cb_dc_sign_level_coeff_neighbor_array = context_ptr->ec_tile_ptr->cb_dc_sign_level_coeff_neighbor_array;
+    NeighborArrayUnit_t     *inter_pred_dir_neighbor_array = context_ptr->ec_tile_ptr->inter_pred_dir_neighbor_array;
+    NeighborArrayUnit_t     *ref_frame_type_neighbor_array = context_ptr->ec_tile_ptr->ref_frame_type_neighbor_array;
+    NeighborArrayUnit32_t   *interpolation_type_neighbor_array = context_ptr->ec_tile_ptr->interpolation_type_neighbor_array;
     const BlockGeom         *blk_geom = get_blk_geom_mds(cu_ptr->mds_idx);
     EbBool                   skipCoeff = EB_FALSE;
     PartitionContext         partition;
@@ -5024,16 +5094,16 @@ EbErrorType write_modes_b(
     aom_writer              *ecWriter = &entropy_coder_ptr->ecWriter;
     SequenceControlSet_t     *sequence_control_set_ptr = (SequenceControlSet_t*)picture_control_set_ptr->sequence_control_set_wrapper_ptr->object_ptr;
 
-    NeighborArrayUnit_t     *mode_type_neighbor_array = picture_control_set_ptr->mode_type_neighbor_array;
-    NeighborArrayUnit_t     *intra_luma_mode_neighbor_array = picture_control_set_ptr->intra_luma_mode_neighbor_array;
-    NeighborArrayUnit_t     *skip_flag_neighbor_array = picture_control_set_ptr->skip_flag_neighbor_array;
-    NeighborArrayUnit_t     *skip_coeff_neighbor_array = picture_control_set_ptr->skip_coeff_neighbor_array;
-    NeighborArrayUnit_t     *luma_dc_sign_level_coeff_neighbor_array = picture_control_set_ptr->luma_dc_sign_level_coeff_neighbor_array;
-    NeighborArrayUnit_t     *cr_dc_sign_level_coeff_neighbor_array = picture_control_set_ptr->cr_dc_sign_level_coeff_neighbor_array;
-    NeighborArrayUnit_t     *cb_dc_sign_level_coeff_neighbor_array = picture_control_set_ptr->cb_dc_sign_level_coeff_neighbor_array;
-    NeighborArrayUnit_t     *inter_pred_dir_neighbor_array = picture_control_set_ptr->inter_pred_dir_neighbor_array;
-    NeighborArrayUnit_t     *ref_frame_type_neighbor_array = picture_control_set_ptr->ref_frame_type_neighbor_array;
-    NeighborArrayUnit32_t   *interpolation_type_neighbor_array = picture_control_set_ptr->interpolation_type_neighbor_array;
+    NeighborArrayUnit_t     *mode_type_neighbor_array = context_ptr->ec_tile_ptr->mode_type_neighbor_array;
+    NeighborArrayUnit_t     *intra_luma_mode_neighbor_array = context_ptr->ec_tile_ptr->intra_luma_mode_neighbor_array;
+    NeighborArrayUnit_t     *skip_flag_neighbor_array = context_ptr->ec_tile_ptr->skip_flag_neighbor_array;
+    NeighborArrayUnit_t     *skip_coeff_neighbor_array = context_ptr->ec_tile_ptr->skip_coeff_neighbor_array;
+    NeighborArrayUnit_t     *luma_dc_sign_level_coeff_neighbor_array = context_ptr->ec_tile_ptr->luma_dc_sign_level_coeff_neighbor_array;
+    NeighborArrayUnit_t     *cr_dc_sign_level_coeff_neighbor_array = context_ptr->ec_tile_ptr->cr_dc_sign_level_coeff_neighbor_array;
+    NeighborArrayUnit_t     *cb_dc_sign_level_coeff_neighbor_array = context_ptr->ec_tile_ptr->cb_dc_sign_level_coeff_neighbor_array;
+    NeighborArrayUnit_t     *inter_pred_dir_neighbor_array = context_ptr->ec_tile_ptr->inter_pred_dir_neighbor_array;
+    NeighborArrayUnit_t     *ref_frame_type_neighbor_array = context_ptr->ec_tile_ptr->ref_frame_type_neighbor_array;
+    NeighborArrayUnit32_t   *interpolation_type_neighbor_array = context_ptr->ec_tile_ptr->interpolation_type_neighbor_array;
 
     const BlockGeom          *blk_geom = get_blk_geom_mds(cu_ptr->mds_idx);
     uint32_t blkOriginX = context_ptr->sb_origin_x + blk_geom->origin_x;
@@ -5055,6 +5125,7 @@ EbErrorType write_modes_b(
         write_cdef(
             sequence_control_set_ptr,
             picture_control_set_ptr,
+            context_ptr->ec_tile_ptr->cdef_preset,
             cu_ptr->av1xd,
             ecWriter,
             skipCoeff,
@@ -5175,6 +5246,7 @@ EbErrorType write_modes_b(
         write_cdef(
             sequence_control_set_ptr,
             picture_control_set_ptr, /*cm,*/
+            context_ptr->ec_tile_ptr->cdef_preset,
             cu_ptr->av1xd,
             ecWriter,
             cu_ptr->skip_flag ? 1 : skipCoeff,
@@ -5454,7 +5526,7 @@ EB_EXTERN EbErrorType write_sb(
     FRAME_CONTEXT           *frameContext = entropy_coder_ptr->fc;
     aom_writer              *ecWriter = &entropy_coder_ptr->ecWriter;
     SequenceControlSet_t     *sequence_control_set_ptr = (SequenceControlSet_t*)picture_control_set_ptr->sequence_control_set_wrapper_ptr->object_ptr;
-    NeighborArrayUnit_t     *partition_context_neighbor_array = picture_control_set_ptr->partition_context_neighbor_array;
+    NeighborArrayUnit_t     *partition_context_neighbor_array = context_ptr->ec_tile_ptr->partition_context_neighbor_array;
 
     // CU Varaiables
     const BlockGeom          *blk_geom;
@@ -5476,7 +5548,7 @@ EB_EXTERN EbErrorType write_sb(
 #if !TILES 
     if (context_ptr->sb_origin_x == 0 && context_ptr->sb_origin_y == 0)
 
-        av1_reset_loop_restoration(picture_control_set_ptr);
+        av1_reset_loop_restoration(context_ptr->ec_tile_ptr);
 #endif
     if (!(sb_geom->is_complete_sb)) {
 
@@ -5524,7 +5596,7 @@ EB_EXTERN EbErrorType write_sb(
                                 const int32_t runit_idx = tile_tl_idx + rcol + rrow * rstride;
                                 const RestorationUnitInfo *rui =
                                     &cm->rst_info[plane].unit_info[runit_idx];
-                                loop_restoration_write_sb_coeffs(picture_control_set_ptr, frameContext, cm, /*xd,*/ rui, ecWriter, plane);
+                                loop_restoration_write_sb_coeffs(context_ptr->ec_tile_ptr, frameContext, cm, /*xd,*/ rui, ecWriter, plane);
                             }
                         }
                     }
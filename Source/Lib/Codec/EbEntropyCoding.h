@@ -304,6 +304,19 @@ extern "C" {
     extern EbErrorType EncodeSPSAv1(
         Bitstream_t *bitstreamPtr,
         SequenceControlSet_t *scsPtr);
+    extern uint32_t encode_sps_obu_av1(
+        uint8_t *data,
+        SequenceControlSet_t *scsPtr);
+#if TILES
+    extern uint32_t encode_frame_header_obu_av1(
+        uint8_t *data,
+        SequenceControlSet_t *scsPtr,
+        PictureControlSet_t *pcsPtr);
+    extern uint32_t encode_tile_group_obu_av1(
+        uint8_t *data,
+        PictureControlSet_t *pcsPtr,
+        uint32_t tile_idx);
+#endif
 
     //*******************************************************************************************//
 
@@ -20,12 +20,11 @@
 #include "EbEncDecResults.h"
 #include "EbEntropyCodingResults.h"
 #include "EbRateControlTasks.h"
+#include "EbPacketizationProcess.h"
+#include "EbErrorCodes.h"
 
 #if TILES
-#define  AV1_MIN_TILE_SIZE_BYTES 1
-void av1_reset_loop_restoration(PictureControlSet_t     *piCSetPtr);
-void av1_tile_set_col(TileInfo *tile, PictureParentControlSet_t * pcsPtr, int col);
-void av1_tile_set_row(TileInfo *tile, PictureParentControlSet_t * pcsPtr, int row);
+void av1_reset_loop_restoration(EntropyCodingTile_t *ec_tile_ptr);
 #endif
 
 /******************************************************
@@ -55,23 +54,23 @@ EbErrorType entropy_coding_context_ctor(
 /***********************************************
  * Entropy Coding Reset Neighbor Arrays
  ***********************************************/
-static void EntropyCodingResetNeighborArrays(PictureControlSet_t *picture_control_set_ptr)
+static void EntropyCodingResetNeighborArrays(EntropyCodingTile_t *ec_tile_ptr)
 {
-    neighbor_array_unit_reset(picture_control_set_ptr->mode_type_neighbor_array);
+    neighbor_array_unit_reset(ec_tile_ptr->mode_type_neighbor_array);
 
-    neighbor_array_unit_reset(picture_control_set_ptr->partition_context_neighbor_array);
+    neighbor_array_unit_reset(ec_tile_ptr->partition_context_neighbor_array);
 
-    neighbor_array_unit_reset(picture_control_set_ptr->skip_flag_neighbor_array);
+    neighbor_array_unit_reset(ec_tile_ptr->skip_flag_neighbor_array);
 
-    neighbor_array_unit_reset(picture_control_set_ptr->skip_coeff_neighbor_array);
-    neighbor_array_unit_reset(picture_control_set_ptr->luma_dc_sign_level_coeff_neighbor_array);
-    neighbor_array_unit_reset(picture_control_set_ptr->cb_dc_sign_level_coeff_neighbor_array);
-    neighbor_array_unit_reset(picture_control_set_ptr->cr_dc_sign_level_coeff_neighbor_array);
-    neighbor_array_unit_reset(picture_control_set_ptr->inter_pred_dir_neighbor_array);
-    neighbor_array_unit_reset(picture_control_set_ptr->ref_frame_type_neighbor_array);
+    neighbor_array_unit_reset(ec_tile_ptr->skip_coeff_neighbor_array);
+    neighbor_array_unit_reset(ec_tile_ptr->luma_dc_sign_level_coeff_neighbor_array);
+    neighbor_array_unit_reset(ec_tile_ptr->cb_dc_sign_level_coeff_neighbor_array);
+    neighbor_array_unit_reset(ec_tile_ptr->cr_dc_sign_level_coeff_neighbor_array);
+    neighbor_array_unit_reset(ec_tile_ptr->inter_pred_dir_neighbor_array);
+    neighbor_array_unit_reset(ec_tile_ptr->ref_frame_type_neighbor_array);
 
-    neighbor_array_unit_reset(picture_control_set_ptr->intra_luma_mode_neighbor_array);
-    neighbor_array_unit_reset32(picture_control_set_ptr->interpolation_type_neighbor_array);
+    neighbor_array_unit_reset(ec_tile_ptr->intra_luma_mode_neighbor_array);
+    neighbor_array_unit_reset32(ec_tile_ptr->interpolation_type_neighbor_array);
     return;
 }
 
@@ -233,7 +232,7 @@ static void ResetEntropyCodingPicture(
     picture_control_set_ptr->entropy_coder_ptr->ecWriter.allow_update_cdf = !picture_control_set_ptr->parent_pcs_ptr->large_scale_tile;
     picture_control_set_ptr->entropy_coder_ptr->ecWriter.allow_update_cdf =
         picture_control_set_ptr->entropy_coder_ptr->ecWriter.allow_update_cdf && !picture_control_set_ptr->parent_pcs_ptr->disable_cdf_update;
-    aom_start_encode(&picture_control_set_ptr->entropy_coder_ptr->ecWriter, data);
+    aom_start_encode(&picture_control_set_ptr->entropy_coder_ptr->ecWriter, data, outputBitstreamPtr->size - (uint32_t)(data - outputBitstreamPtr->bufferBeginAv1));
 
     // ADD Reset here
 
@@ -243,7 +242,7 @@ static void ResetEntropyCodingPicture(
         entropyCodingQp,
         picture_control_set_ptr->slice_type);
 
-    EntropyCodingResetNeighborArrays(picture_control_set_ptr);
+    EntropyCodingResetNeighborArrays(context_ptr->ec_tile_ptr);
 
 
     return;
@@ -252,13 +251,13 @@ static void ResetEntropyCodingPicture(
 
 #if TILES
 static void reset_ec_tile(
-    uint32_t  total_size,
-    uint32_t  is_last_tile_in_tg,
+    uint32_t  buffer_offset,
     EntropyCodingContext_t  *context_ptr,
     PictureControlSet_t     *picture_control_set_ptr,
     SequenceControlSet_t    *sequence_control_set_ptr)
 {
-    ResetBitstream(EntropyCoderGetBitstreamPtr(picture_control_set_ptr->entropy_coder_ptr));
+    EntropyCoder_t *entropy_coder_ptr = context_ptr->ec_tile_ptr->entropy_coder_ptr;
+    ResetBitstream(EntropyCoderGetBitstreamPtr(entropy_coder_ptr));
 
     uint32_t                       entropy_coding_qp;
 
@@ -304,29 +303,25 @@ static void reset_ec_tile(
 #endif
 
     // pass the ent
-    OutputBitstreamUnit_t *outputBitstreamPtr = (OutputBitstreamUnit_t*)(picture_control_set_ptr->entropy_coder_ptr->ecOutputBitstreamPtr);
+    OutputBitstreamUnit_t *outputBitstreamPtr = (OutputBitstreamUnit_t*)(entropy_coder_ptr->ecOutputBitstreamPtr);
     //****************************************************************//
 
-    uint8_t *data = outputBitstreamPtr->bufferAv1 + total_size;
-    picture_control_set_ptr->entropy_coder_ptr->ecWriter.allow_update_cdf = !picture_control_set_ptr->parent_pcs_ptr->large_scale_tile;
-    picture_control_set_ptr->entropy_coder_ptr->ecWriter.allow_update_cdf =
-        picture_control_set_ptr->entropy_coder_ptr->ecWriter.allow_update_cdf && !picture_control_set_ptr->parent_pcs_ptr->disable_cdf_update;
-
+    uint8_t *data = outputBitstreamPtr->bufferAv1 + buffer_offset;
+    const uint32_t buffer_size = outputBitstreamPtr->size - (uint32_t)(outputBitstreamPtr->bufferAv1 - outputBitstreamPtr->bufferBeginAv1);
+    entropy_coder_ptr->ecWriter.allow_update_cdf = !picture_control_set_ptr->parent_pcs_ptr->large_scale_tile;
+    entropy_coder_ptr->ecWriter.allow_update_cdf =
+        entropy_coder_ptr->ecWriter.allow_update_cdf && !picture_control_set_ptr->parent_pcs_ptr->disable_cdf_update;
 
-    //if not last tile, advance buffer by 4B to leave space for tile Size
-    if (is_last_tile_in_tg == 0)
-        data += 4;
-
-    aom_start_encode(&picture_control_set_ptr->entropy_coder_ptr->ecWriter, data);
+    aom_start_encode(&entropy_coder_ptr->ecWriter, data, buffer_offset < buffer_size ? buffer_size - buffer_offset : 0);
 
     //reset probabilities
     ResetEntropyCoder(
         sequence_control_set_ptr->encode_context_ptr,
-        picture_control_set_ptr->entropy_coder_ptr,
+        entropy_coder_ptr,
         entropy_coding_qp,
         picture_control_set_ptr->slice_type);
 
-    EntropyCodingResetNeighborArrays(picture_control_set_ptr);
+    EntropyCodingResetNeighborArrays(context_ptr->ec_tile_ptr);
 
 
     return;
@@ -385,7 +380,7 @@ static void EntropyCodingLcu(
     // + 32  - bits remaining in interval Low value
     // + number of buffered byte * 8
     // This should be only for coeffs not any flag
-    writtenBitsBeforeQuantizedCoeff = ((OutputBitstreamUnit_t*)EntropyCoderGetBitstreamPtr(picture_control_set_ptr->entropy_coder_ptr))->writtenBitsCount;
+    writtenBitsBeforeQuantizedCoeff = ((OutputBitstreamUnit_t*)EntropyCoderGetBitstreamPtr(context_ptr->ec_tile_ptr->entropy_coder_ptr))->writtenBitsCount;
 
     (void)pictureOriginX;
     (void)pictureOriginY;
@@ -394,7 +389,7 @@ static void EntropyCodingLcu(
         context_ptr,
         sb_ptr,
         picture_control_set_ptr,
-        picture_control_set_ptr->entropy_coder_ptr,
+        context_ptr->ec_tile_ptr->entropy_coder_ptr,
         coeffPicturePtr);
 
     //store the number of written bits after coding quantized coeffs (flush is not called yet):
@@ -402,11 +397,11 @@ static void EntropyCodingLcu(
     // number of written bits
     // + 32  - bits remaining in interval Low value
     // + number of buffered byte * 8
-    writtenBitsAfterQuantizedCoeff = ((OutputBitstreamUnit_t*)EntropyCoderGetBitstreamPtr(picture_control_set_ptr->entropy_coder_ptr))->writtenBitsCount;
+    writtenBitsAfterQuantizedCoeff = ((OutputBitstreamUnit_t*)EntropyCoderGetBitstreamPtr(context_ptr->ec_tile_ptr->entropy_coder_ptr))->writtenBitsCount;
 
     sb_ptr->total_bits = writtenBitsAfterQuantizedCoeff - writtenBitsBeforeQuantizedCoeff;
 
-    picture_control_set_ptr->parent_pcs_ptr->quantized_coeff_num_bits += sb_ptr->quantized_coeffs_bits;
+    context_ptr->ec_tile_ptr->quantized_coeff_num_bits += sb_ptr->quantized_coeffs_bits;
 
     return;
 }
@@ -501,6 +496,120 @@ static EbBool UpdateEntropyCodingRows(
     return processNextRow;
 }
 
+/******************************************************
+ * Entropy Coding Picture Done
+ *   Releases the reference pictures and hands the
+ *   picture over to packetization.
+ ******************************************************/
+static void EntropyCodingPictureDone(
+    EntropyCodingContext_t  *context_ptr,
+    PictureControlSet_t     *picture_control_set_ptr,
+    EbObjectWrapper_t       *picture_control_set_wrapper_ptr)
+{
+    EbObjectWrapper_t       *entropyCodingResultsWrapperPtr;
+    EntropyCodingResults_t  *entropyCodingResultsPtr;
+    uint32_t                 refIdx;
+
+    // Release the List 0 Reference Pictures
+    for (refIdx = 0; refIdx < picture_control_set_ptr->parent_pcs_ptr->ref_list0_count; ++refIdx) {
+        if (picture_control_set_ptr->ref_pic_ptr_array[0] != EB_NULL) {
+
+            eb_release_object(picture_control_set_ptr->ref_pic_ptr_array[0]);
+        }
+    }
+
+    // Release the List 1 Reference Pictures
+    for (refIdx = 0; refIdx < picture_control_set_ptr->parent_pcs_ptr->ref_list1_count; ++refIdx) {
+        if (picture_control_set_ptr->ref_pic_ptr_array[1] != EB_NULL) {
+
+            eb_release_object(picture_control_set_ptr->ref_pic_ptr_array[1]);
+        }
+    }
+
+    // Get Empty Entropy Coding Results
+    eb_get_empty_object(
+        context_ptr->entropy_coding_output_fifo_ptr,
+        &entropyCodingResultsWrapperPtr);
+    entropyCodingResultsPtr = (EntropyCodingResults_t*)entropyCodingResultsWrapperPtr->object_ptr;
+    entropyCodingResultsPtr->pictureControlSetWrapperPtr = picture_control_set_wrapper_ptr;
+
+    // Post EntropyCoding Results
+    eb_post_full_object(entropyCodingResultsWrapperPtr);
+}
+
+#if TILES
+/******************************************************
+ * Entropy Code Tile
+ *   Codes the SBs of one tile with the writer of
+ *   context_ptr->ec_tile_ptr, starting buffer_offset
+ *   bytes into its bitstream buffer. Returns the size
+ *   of the coded tile in bytes.
+ ******************************************************/
+static uint32_t EntropyCodeTile(
+    EntropyCodingContext_t  *context_ptr,
+    PictureControlSet_t     *picture_control_set_ptr,
+    SequenceControlSet_t    *sequence_control_set_ptr,
+    uint32_t                 tile_idx,
+    uint32_t                 buffer_offset)
+{
+    Av1Common *const cm = picture_control_set_ptr->parent_pcs_ptr->av1_cm;
+    const int tile_row = tile_idx / cm->tile_cols;
+    const int tile_col = tile_idx % cm->tile_cols;
+    const uint8_t lcuSizeLog2 = (uint8_t)Log2f(context_ptr->sb_sz);
+    const uint32_t picture_width_in_sb = (sequence_control_set_ptr->luma_width + context_ptr->sb_sz - 1) >> lcuSizeLog2;
+    uint32_t xLcuIndex, yLcuIndex;
+
+    reset_ec_tile(
+        buffer_offset,
+        context_ptr,
+        picture_control_set_ptr,
+        sequence_control_set_ptr);
+
+    av1_reset_loop_restoration(context_ptr->ec_tile_ptr);
+
+    for (yLcuIndex = cm->tile_row_start_sb[tile_row]; yLcuIndex < (uint32_t)cm->tile_row_start_sb[tile_row + 1]; ++yLcuIndex)
+    {
+        for (xLcuIndex = cm->tile_col_start_sb[tile_col]; xLcuIndex < (uint32_t)cm->tile_col_start_sb[tile_col + 1]; ++xLcuIndex)
+        {
+            uint16_t sb_index = (uint16_t)(xLcuIndex + yLcuIndex * picture_width_in_sb);
+            LargestCodingUnit_t *sb_ptr = picture_control_set_ptr->sb_ptr_array[sb_index];
+            uint32_t sb_origin_x = xLcuIndex << lcuSizeLog2;
+            uint32_t sb_origin_y = yLcuIndex << lcuSizeLog2;
+            EbBool lastLcuFlag = (sb_index == sequence_control_set_ptr->sb_tot_cnt - 1) ? EB_TRUE : EB_FALSE;
+            context_ptr->sb_origin_x = sb_origin_x;
+            context_ptr->sb_origin_y = sb_origin_y;
+
+            // Configure the LCU
+            EntropyCodingConfigureLcu(
+                context_ptr,
+                sb_ptr,
+                picture_control_set_ptr);
+
+            // Entropy Coding
+            EntropyCodingLcu(
+                context_ptr,
+                sb_ptr,
+                picture_control_set_ptr,
+                sequence_control_set_ptr,
+                sb_origin_x,
+                sb_origin_y,
+                lastLcuFlag,
+                0,
+                0);
+        }
+    }
+
+    CHECK_REPORT_ERROR(
+        EncodeSliceFinish(context_ptr->ec_tile_ptr->entropy_coder_ptr) == EB_ErrorNone,
+        sequence_control_set_ptr->encode_context_ptr->app_callback_ptr,
+        EB_ENC_EC_ERROR17);
+
+    assert(context_ptr->ec_tile_ptr->entropy_coder_ptr->ecWriter.pos >= AV1_MIN_TILE_SIZE_BYTES);
+
+    return context_ptr->ec_tile_ptr->entropy_coder_ptr->ecWriter.pos;
+}
+#endif
+
 /******************************************************
  * Entropy Coding Kernel
  ******************************************************/
@@ -515,10 +624,6 @@ void* EntropyCodingKernel(void *input_ptr)
     EbObjectWrapper_t                       *encDecResultsWrapperPtr;
     EncDecResults_t                         *encDecResultsPtr;
 
-    // Output
-    EbObjectWrapper_t                       *entropyCodingResultsWrapperPtr;
-    EntropyCodingResults_t                  *entropyCodingResultsPtr;
-
     // SB Loop variables
     LargestCodingUnit_t                     *sb_ptr;
     uint16_t                                   sb_index;
@@ -550,6 +655,7 @@ void* EntropyCodingKernel(void *input_ptr)
         lcuSizeLog2 = (uint8_t)Log2f(sb_sz);
         context_ptr->sb_sz = sb_sz;
         picture_width_in_sb = (sequence_control_set_ptr->luma_width + sb_sz - 1) >> lcuSizeLog2;
+        context_ptr->ec_tile_ptr = picture_control_set_ptr->ec_tile_ptr_array[0];
 #if TILES
         if(picture_control_set_ptr->parent_pcs_ptr->av1_cm->tile_cols * picture_control_set_ptr->parent_pcs_ptr->av1_cm->tile_rows == 1)
 #endif
@@ -585,7 +691,7 @@ void* EntropyCodingKernel(void *input_ptr)
 
 #if TILES 
                     if (sb_index == 0)
-                        av1_reset_loop_restoration(picture_control_set_ptr);
+                        av1_reset_loop_restoration(context_ptr->ec_tile_ptr);
 #endif
                     // Configure the LCU
                     EntropyCodingConfigureLcu(
@@ -636,37 +742,20 @@ void* EntropyCodingKernel(void *input_ptr)
                     // If the picture is complete, terminate the slice
                     if (picture_control_set_ptr->entropy_coding_current_row == picture_control_set_ptr->entropy_coding_row_count)
                     {
-                        uint32_t refIdx;
-
                         picture_control_set_ptr->entropy_coding_pic_done = EB_TRUE;
 
-                        EncodeSliceFinish(picture_control_set_ptr->entropy_coder_ptr);
-
-                        // Release the List 0 Reference Pictures
-                        for (refIdx = 0; refIdx < picture_control_set_ptr->parent_pcs_ptr->ref_list0_count; ++refIdx) {
-                            if (picture_control_set_ptr->ref_pic_ptr_array[0] != EB_NULL) {
-
-                                eb_release_object(picture_control_set_ptr->ref_pic_ptr_array[0]);
-                            }
-                        }
-
-                        // Release the List 1 Reference Pictures
-                        for (refIdx = 0; refIdx < picture_control_set_ptr->parent_pcs_ptr->ref_list1_count; ++refIdx) {
-                            if (picture_control_set_ptr->ref_pic_ptr_array[1] != EB_NULL) {
-
-                                eb_release_object(picture_control_set_ptr->ref_pic_ptr_array[1]);
-                            }
-                        }
+                        CHECK_REPORT_ERROR(
+                            EncodeSliceFinish(picture_control_set_ptr->entropy_coder_ptr) == EB_ErrorNone,
+                            sequence_control_set_ptr->encode_context_ptr->app_callback_ptr,
+                            EB_ENC_EC_ERROR17);
 
-                        // Get Empty Entropy Coding Results
-                        eb_get_empty_object(
-                            context_ptr->entropy_coding_output_fifo_ptr,
-                            &entropyCodingResultsWrapperPtr);
-                        entropyCodingResultsPtr = (EntropyCodingResults_t*)entropyCodingResultsWrapperPtr->object_ptr;
-                        entropyCodingResultsPtr->pictureControlSetWrapperPtr = encDecResultsPtr->pictureControlSetWrapperPtr;
+                        picture_control_set_ptr->parent_pcs_ptr->quantized_coeff_num_bits += context_ptr->ec_tile_ptr->quantized_coeff_num_bits;
+                        context_ptr->ec_tile_ptr->quantized_coeff_num_bits = 0;
 
-                        // Post EntropyCoding Results
-                        eb_post_full_object(entropyCodingResultsWrapperPtr);
+                        EntropyCodingPictureDone(
+                            context_ptr,
+                            picture_control_set_ptr,
+                            encDecResultsPtr->pictureControlSetWrapperPtr);
 
                     } // End if(PictureCompleteFlag)
                 }
@@ -677,131 +766,77 @@ void* EntropyCodingKernel(void *input_ptr)
 
         }
 #if TILES
+        else if (picture_control_set_ptr->entropy_coding_tile_task_count > 1)
+        {
+            // One tile per task, in the bitstream of the tile. Tile 0 is coded in place
+            // in the picture bitstream after its size field, packetization joins the others.
+            // With the low latency tile output each tile is a tile group of its own instead.
+            EbBool pictureDone;
+
+            context_ptr->ec_tile_ptr = picture_control_set_ptr->ec_tile_ptr_array[encDecResultsPtr->tile_index];
+
+            EntropyCodeTile(
+                context_ptr,
+                picture_control_set_ptr,
+                sequence_control_set_ptr,
+                encDecResultsPtr->tile_index,
+                (encDecResultsPtr->tile_index == 0 && !picture_control_set_ptr->tile_output) ? 4 : 0);
+
+            // Before the tile is counted done, the picture is released once all are
+            if (picture_control_set_ptr->tile_output)
+                eb_output_tile_group(
+                    picture_control_set_ptr,
+                    encDecResultsPtr->tile_index);
+
+            eb_block_on_mutex(picture_control_set_ptr->entropy_coding_mutex);
+            picture_control_set_ptr->parent_pcs_ptr->quantized_coeff_num_bits += context_ptr->ec_tile_ptr->quantized_coeff_num_bits;
+            context_ptr->ec_tile_ptr->quantized_coeff_num_bits = 0;
+            pictureDone = (++picture_control_set_ptr->entropy_coding_tile_done_count == picture_control_set_ptr->entropy_coding_tile_task_count) ? EB_TRUE : EB_FALSE;
+            eb_release_mutex(picture_control_set_ptr->entropy_coding_mutex);
+
+            if (pictureDone) {
+                EntropyCodingPictureDone(
+                    context_ptr,
+                    picture_control_set_ptr,
+                    encDecResultsPtr->pictureControlSetWrapperPtr);
+            }
+        }
         else
         {
+            // All tiles in the picture bitstream, each but the last preceded by its size
+            uint32_t total_size = 0;
+            uint32_t tile_idx;
+            const uint32_t tile_count = picture_control_set_ptr->parent_pcs_ptr->av1_cm->tile_cols * picture_control_set_ptr->parent_pcs_ptr->av1_cm->tile_rows;
+            OutputBitstreamUnit_t *outputBitstreamPtr = (OutputBitstreamUnit_t*)(picture_control_set_ptr->entropy_coder_ptr->ecOutputBitstreamPtr);
+
+            //Entropy Tile Loop
+            for (tile_idx = 0; tile_idx < tile_count; tile_idx++)
+            {
+                const EbBool is_last_tile_in_tg = (tile_idx == tile_count - 1) ? EB_TRUE : EB_FALSE;
+                uint32_t tile_size = EntropyCodeTile(
+                    context_ptr,
+                    picture_control_set_ptr,
+                    sequence_control_set_ptr,
+                    tile_idx,
+                    is_last_tile_in_tg ? total_size : total_size + 4);
+
+                if (!is_last_tile_in_tg) {
+                    mem_put_le32(outputBitstreamPtr->bufferAv1 + total_size, tile_size - AV1_MIN_TILE_SIZE_BYTES);
+                    total_size += 4;
+                }
+
+                total_size += tile_size;
+            }
 
-             struct PictureParentControlSet_s     *ppcs_ptr = picture_control_set_ptr->parent_pcs_ptr;
-             Av1Common *const cm = ppcs_ptr->av1_cm;           
-             uint32_t total_size = 0;
-             int tile_row, tile_col;
-             const int tile_cols = ppcs_ptr->av1_cm->tile_cols;
-             const int tile_rows = ppcs_ptr->av1_cm->tile_rows;
-
-             //Entropy Tile Loop
-             for (tile_row = 0; tile_row < tile_rows; tile_row++)
-             {
-                 
-                 TileInfo tile_info;
-                 av1_tile_set_row(&tile_info, ppcs_ptr, tile_row);
-
-                 for (tile_col = 0; tile_col < tile_cols; tile_col++)
-                 { 
-                     const int tile_idx = tile_row * tile_cols + tile_col;
-                     uint32_t is_last_tile_in_tg = 0;
-
-                     if ( tile_idx == (tile_cols * tile_rows - 1)) {
-                         is_last_tile_in_tg = 1;                       
-                     }
-                     else {
-                         is_last_tile_in_tg = 0;                        
-                     }
-
-                     reset_ec_tile(
-                         total_size,
-                         is_last_tile_in_tg,
-                         context_ptr,
-                         picture_control_set_ptr,
-                         sequence_control_set_ptr);
-
-                     av1_tile_set_col(&tile_info, ppcs_ptr, tile_col);
-   
-                     av1_reset_loop_restoration(picture_control_set_ptr);
-                   
-                     for (yLcuIndex = cm->tile_row_start_sb[tile_row]; yLcuIndex < (uint32_t)cm->tile_row_start_sb[tile_row + 1]; ++yLcuIndex)
-                     {
-                         for (xLcuIndex = cm->tile_col_start_sb[tile_col]; xLcuIndex < (uint32_t)cm->tile_col_start_sb[tile_col + 1]; ++xLcuIndex)
-                         {
-                             
-                             int sb_index = (uint16_t)(xLcuIndex + yLcuIndex * picture_width_in_sb);
-                             sb_ptr = picture_control_set_ptr->sb_ptr_array[sb_index];
-                             sb_origin_x = xLcuIndex << lcuSizeLog2;
-                             sb_origin_y = yLcuIndex << lcuSizeLog2;
-                             context_ptr->sb_origin_x = sb_origin_x;
-                             context_ptr->sb_origin_y = sb_origin_y;
-                             lastLcuFlag = (sb_index == sequence_control_set_ptr->sb_tot_cnt - 1) ? EB_TRUE : EB_FALSE;
-                            
-                             // Configure the LCU
-                             EntropyCodingConfigureLcu(
-                                 context_ptr,
-                                 sb_ptr,
-                                 picture_control_set_ptr);                           
-
-                             // Entropy Coding
-                             EntropyCodingLcu(
-                                 context_ptr,
-                                 sb_ptr,
-                                 picture_control_set_ptr,
-                                 sequence_control_set_ptr,
-                                 sb_origin_x,
-                                 sb_origin_y,
-                                 lastLcuFlag,
-                                 0,
-                                 0);
-                         }
-                     }
-                                         
-                     EncodeSliceFinish(picture_control_set_ptr->entropy_coder_ptr);
-                    
-                     int tile_size = picture_control_set_ptr->entropy_coder_ptr->ecWriter.pos;
-                     assert(tile_size >= AV1_MIN_TILE_SIZE_BYTES);
-                    
-                     if (!is_last_tile_in_tg) {
-                         
-                         OutputBitstreamUnit_t *outputBitstreamPtr = (OutputBitstreamUnit_t*)(picture_control_set_ptr->entropy_coder_ptr->ecOutputBitstreamPtr);
-                         uint8_t *buf_data = outputBitstreamPtr->bufferAv1 + total_size;
-                         mem_put_le32(buf_data, tile_size - AV1_MIN_TILE_SIZE_BYTES);
-                     }                   
-
-                     if (is_last_tile_in_tg==0)                     
-                         total_size += 4;                     
-
-                     total_size += tile_size;
-
-                 }
-
-             }
-
-             //the picture is complete, terminate the slice            
-             {
-                 uint32_t refIdx;         
-                 picture_control_set_ptr->entropy_coder_ptr->ec_frame_size = total_size;
-
-                 // Release the List 0 Reference Pictures
-                 for (refIdx = 0; refIdx < picture_control_set_ptr->parent_pcs_ptr->ref_list0_count; ++refIdx) {
-                     if (picture_control_set_ptr->ref_pic_ptr_array[0] != EB_NULL) {
-                         eb_release_object(picture_control_set_ptr->ref_pic_ptr_array[0]);
-                     }
-                 }
-
-                 // Release the List 1 Reference Pictures
-                 for (refIdx = 0; refIdx < picture_control_set_ptr->parent_pcs_ptr->ref_list1_count; ++refIdx) {
-                     if (picture_control_set_ptr->ref_pic_ptr_array[1] != EB_NULL) {
-                         eb_release_object(picture_control_set_ptr->ref_pic_ptr_array[1]);
-                     }
-                 }
-
-                 // Get Empty Entropy Coding Results
-                 eb_get_empty_object(
-                     context_ptr->entropy_coding_output_fifo_ptr,
-                     &entropyCodingResultsWrapperPtr);
-                 entropyCodingResultsPtr = (EntropyCodingResults_t*)entropyCodingResultsWrapperPtr->object_ptr;
-                 entropyCodingResultsPtr->pictureControlSetWrapperPtr = encDecResultsPtr->pictureControlSetWrapperPtr;
-
-                 // Post EntropyCoding Results
-                 eb_post_full_object(entropyCodingResultsWrapperPtr);
-
-             } 
+            //the picture is complete, terminate the slice
+            picture_control_set_ptr->entropy_coder_ptr->ec_frame_size = total_size;
+            picture_control_set_ptr->parent_pcs_ptr->quantized_coeff_num_bits += context_ptr->ec_tile_ptr->quantized_coeff_num_bits;
+            context_ptr->ec_tile_ptr->quantized_coeff_num_bits = 0;
 
+            EntropyCodingPictureDone(
+                context_ptr,
+                picture_control_set_ptr,
+                encDecResultsPtr->pictureControlSetWrapperPtr);
         }
 #endif
         // Release Mode Decision Results
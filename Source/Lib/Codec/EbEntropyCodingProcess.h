@@ -19,6 +19,10 @@
 #include "EbNeighborArrays.h"
 #include "EbCodingUnit.h"
 
+#if TILES
+#define AV1_MIN_TILE_SIZE_BYTES 1
+#endif
+
 /**************************************
  * Enc Dec Context
  **************************************/
@@ -28,6 +32,8 @@ typedef struct EntropyCodingContext_s
     EbFifo_t                       *entropy_coding_output_fifo_ptr;  // to packetization
     EbFifo_t                       *rate_control_output_fifo_ptr; // feedback to rate control
 
+    EntropyCodingTile_t            *ec_tile_ptr;                  // tile being coded
+
     uint32_t                        sb_total_count;
     // Lambda
 #if ADD_DELTA_QP_SUPPORT
@@ -1696,6 +1696,9 @@ void* InitialRateControlKernel(void *input_ptr)
             ReleasePaReferenceObjects(
                 picture_control_set_ptr);
 
+            // Release the previous PCS held for the ZZ SADs computation
+            eb_release_object(picture_control_set_ptr->previous_picture_control_set_wrapper_ptr);
+
             //****************************************************
             // Input Motion Analysis Results into Reordering Queue
             //****************************************************
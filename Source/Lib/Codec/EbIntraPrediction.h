@@ -543,6 +543,8 @@ extern "C" {
         intra_mode_vertical_luma_sse2_intrin,
         // AVX2
         intra_mode_vertical_luma_avx2_intrin,
+        // AVX512
+        intra_mode_vertical_luma_avx2_intrin,
 
     };
 
@@ -552,6 +554,8 @@ extern "C" {
         intra_mode_vertical_chroma_sse2_intrin,
         // AVX2
         intra_mode_vertical_chroma_sse2_intrin,
+        // AVX512
+        intra_mode_vertical_chroma_sse2_intrin,
     };
 
 
@@ -560,6 +564,8 @@ extern "C" {
         intra_mode_horizontal_luma_sse2_intrin,
         // AVX2
         intra_mode_horizontal_luma_sse2_intrin,
+        // AVX512
+        intra_mode_horizontal_luma_sse2_intrin,
     };
 
 
@@ -568,6 +574,8 @@ extern "C" {
         intra_mode_horizontal_chroma_sse2_intrin,
         // AVX2
         intra_mode_horizontal_chroma_sse2_intrin,
+        // AVX512
+        intra_mode_horizontal_chroma_sse2_intrin,
     };
 
 #if !QT_10BIT_SUPPORT
@@ -579,6 +587,8 @@ extern "C" {
             highbd_dc_predictor,
             // AVX2
             intra_mode_dc_4x4_av1_sse2_intrin,
+            // AVX512
+            intra_mode_dc_4x4_av1_sse2_intrin,
         },
         // 8x8
         {
@@ -586,6 +596,8 @@ extern "C" {
             highbd_dc_predictor,
             // AVX2
             intra_mode_dc_8x8_av1_sse2_intrin,
+            // AVX512
+            intra_mode_dc_8x8_av1_sse2_intrin,
         },
         // 16x16
         {
@@ -593,6 +605,8 @@ extern "C" {
             highbd_dc_predictor,
             // AVX2
             intra_mode_dc_16x16_av1_sse2_intrin,
+            // AVX512
+            intra_mode_dc_16x16_av1_sse2_intrin,
 
         },
         // NxN
@@ -601,6 +615,8 @@ extern "C" {
             highbd_dc_predictor,
             // AVX2
             highbd_dc_predictor,
+            // AVX512
+            highbd_dc_predictor,
 
         },
         // 32x32
@@ -609,6 +625,8 @@ extern "C" {
             highbd_dc_predictor,
             // AVX2
             intra_mode_dc_32x32_av1_avx2_intrin,
+            // AVX512
+            intra_mode_dc_32x32_av1_avx2_intrin,
 
         } ,
         // NxN
@@ -617,6 +635,8 @@ extern "C" {
             highbd_dc_predictor,
             // AVX2
             highbd_dc_predictor,
+            // AVX512
+            highbd_dc_predictor,
 
         },
         // NxN
@@ -625,6 +645,8 @@ extern "C" {
             highbd_dc_predictor,
             // AVX2
             highbd_dc_predictor,
+            // AVX512
+            highbd_dc_predictor,
 
         },
         // NxN
@@ -633,6 +655,8 @@ extern "C" {
             highbd_dc_predictor,
             // AVX2
             highbd_dc_predictor,
+            // AVX512
+            highbd_dc_predictor,
 
         },
         // 64x64
@@ -642,6 +666,9 @@ extern "C" {
             // AVX2
 
             intra_mode_dc_64x64_av1_avx2_intrin,
+            // AVX512
+
+            intra_mode_dc_64x64_av1_avx2_intrin,
 
         }
 
@@ -652,6 +679,8 @@ extern "C" {
         intra_mode_dc_luma_sse2_intrin,
         // AVX2
         intra_mode_dc_luma_avx2_intrin,
+        // AVX512
+        intra_mode_dc_luma_avx2_intrin,
 
     };
 
@@ -668,6 +697,8 @@ extern "C" {
         intra_mode_dc_luma16bit_sse4_1_intrin,
         // AVX2
         intra_mode_dc_luma16bit_sse4_1_intrin,
+        // AVX512
+        intra_mode_dc_luma16bit_sse4_1_intrin,
     };
 
     static EB_INTRA_NOANG_TYPE FUNC_TABLE IntraDCChroma_funcPtrArray[ASM_TYPE_TOTAL] = {
@@ -675,6 +706,8 @@ extern "C" {
         intra_mode_dc_chroma_sse2_intrin,
         // AVX2
         intra_mode_dc_chroma_sse2_intrin,
+        // AVX512
+        intra_mode_dc_chroma_sse2_intrin,
     };
 
 
@@ -683,6 +716,8 @@ extern "C" {
         intra_mode_planar_sse2_intrin,
         // AVX2
         intra_mode_planar_avx2_intrin,
+        // AVX512
+        intra_mode_planar_avx2_intrin,
     };
 
     void smooth_v_predictor_c(uint8_t *dst, ptrdiff_t stride, int32_t bw,
@@ -694,6 +729,8 @@ extern "C" {
         IntraModePlanar,
         // AVX2
         intra_mode_planar_av1_avx2_intrin,
+        // AVX512
+        intra_mode_planar_av1_avx2_intrin,
     };
 #if !QT_10BIT_SUPPORT
     static EB_INTRA_NOANG_16bit_TYPE FUNC_TABLE IntraSmoothV_16bit_Av1_funcPtrArray[ASM_TYPE_TOTAL] = {
@@ -701,6 +738,8 @@ extern "C" {
         highbd_smooth_v_predictor,
         // AVX2
         highbd_smooth_v_predictor,
+        // AVX512
+        highbd_smooth_v_predictor,
     };
 #endif
     static EB_INTRA_NOANG_TYPE FUNC_TABLE IntraSmoothH_Av1_funcPtrArray[ASM_TYPE_TOTAL] = {
@@ -708,6 +747,8 @@ extern "C" {
         ebav1_smooth_h_predictor,
         // AVX2
         ebav1_smooth_h_predictor,
+        // AVX512
+        ebav1_smooth_h_predictor,
     };
 #if !QT_10BIT_SUPPORT
     static EB_INTRA_NOANG_16bit_TYPE FUNC_TABLE IntraSmoothH_16bit_Av1_funcPtrArray[ASM_TYPE_TOTAL] = {
@@ -715,6 +756,8 @@ extern "C" {
         highbd_smooth_h_predictor,
         // AVX2
         highbd_smooth_h_predictor,
+        // AVX512
+        highbd_smooth_h_predictor,
     };
 #endif
     static EB_INTRA_NOANG_TYPE FUNC_TABLE IntraSmoothV_Av1_funcPtrArray[ASM_TYPE_TOTAL] = {
@@ -722,6 +765,8 @@ extern "C" {
         ebav1_smooth_v_predictor,
         // AVX2
         ebav1_smooth_v_predictor,
+        // AVX512
+        ebav1_smooth_v_predictor,
     };
 
     static EB_INTRA_NOANG_16bit_TYPE FUNC_TABLE IntraPlanar_16bit_funcPtrArray[ASM_TYPE_TOTAL] = {
@@ -729,6 +774,8 @@ extern "C" {
         intra_mode_planar16bit_sse2_intrin,
         // AVX2
         intra_mode_planar16bit_sse2_intrin,
+        // AVX512
+        intra_mode_planar16bit_sse2_intrin,
     };
 
     static EB_INTRA_NOANG_TYPE FUNC_TABLE IntraAng34_funcPtrArray[ASM_TYPE_TOTAL] = {
@@ -736,6 +783,8 @@ extern "C" {
         intra_mode_angular_34_sse2_intrin,
         // AVX2
         intra_mode_angular_34_avx2_intrin,
+        // AVX512
+        intra_mode_angular_34_avx2_intrin,
     };
 
 
@@ -744,6 +793,8 @@ extern "C" {
         intra_mode_angular_18_sse2_intrin,
         // AVX2
         intra_mode_angular_18_avx2_intrin,
+        // AVX512
+        intra_mode_angular_18_avx2_intrin,
 
     };
 
@@ -753,6 +804,8 @@ extern "C" {
         intra_mode_angular_2_sse2_intrin,
         // AVX2
         intra_mode_angular_2_avx2_intrin,
+        // AVX512
+        intra_mode_angular_2_avx2_intrin,
     };
 
 
@@ -761,6 +814,8 @@ extern "C" {
         intra_mode_angular_vertical_kernel_ssse3_intrin,
         // AVX2
         intra_mode_angular_vertical_kernel_avx2_intrin,
+        // AVX512
+        intra_mode_angular_vertical_kernel_avx2_intrin,
     };
 
 
@@ -769,6 +824,8 @@ extern "C" {
         intra_mode_angular_horizontal_kernel_ssse3_intrin,
         // AVX2
         intra_mode_angular_horizontal_kernel_avx2_intrin,
+        // AVX512
+        intra_mode_angular_horizontal_kernel_avx2_intrin,
     };
 
 
@@ -779,6 +836,8 @@ extern "C" {
             IntraModeAngular_AV1_Z1_16bit,
             // AVX2
             intra_mode_angular_av1_z1_16bit_4x4_avx2,
+            // AVX512
+            intra_mode_angular_av1_z1_16bit_4x4_avx2,
         },
         // 8x8
         {
@@ -786,6 +845,8 @@ extern "C" {
             IntraModeAngular_AV1_Z1_16bit,
             // AVX2
             intra_mode_angular_av1_z1_16bit_8x8_avx2,
+            // AVX512
+            intra_mode_angular_av1_z1_16bit_8x8_avx2,
         },
         // 16x16
         {
@@ -793,6 +854,8 @@ extern "C" {
             IntraModeAngular_AV1_Z1_16bit,
             // AVX2
             intra_mode_angular_av1_z1_16bit_16x16_avx2,
+            // AVX512
+            intra_mode_angular_av1_z1_16bit_16x16_avx2,
         },
         // NxN
         {
@@ -800,6 +863,8 @@ extern "C" {
             IntraModeAngular_AV1_Z1_16bit,
             // AVX2
             IntraModeAngular_AV1_Z1_16bit,
+            // AVX512
+            IntraModeAngular_AV1_Z1_16bit,
         },
         // 32x32
         {
@@ -807,6 +872,8 @@ extern "C" {
             IntraModeAngular_AV1_Z1_16bit,
             // AVX2
             intra_mode_angular_av1_z1_16bit_32x32_avx2,
+            // AVX512
+            intra_mode_angular_av1_z1_16bit_32x32_avx2,
         },
         // NxN
         {
@@ -814,6 +881,8 @@ extern "C" {
             IntraModeAngular_AV1_Z1_16bit,
             // AVX2
             IntraModeAngular_AV1_Z1_16bit,
+            // AVX512
+            IntraModeAngular_AV1_Z1_16bit,
         },
         // NxN
         {
@@ -821,6 +890,8 @@ extern "C" {
             IntraModeAngular_AV1_Z1_16bit,
             // AVX2
             IntraModeAngular_AV1_Z1_16bit,
+            // AVX512
+            IntraModeAngular_AV1_Z1_16bit,
         },
         // NxN
         {
@@ -828,6 +899,8 @@ extern "C" {
             IntraModeAngular_AV1_Z1_16bit,
             // AVX2
             IntraModeAngular_AV1_Z1_16bit,
+            // AVX512
+            IntraModeAngular_AV1_Z1_16bit,
         },
         // 64x64
         {
@@ -835,6 +908,8 @@ extern "C" {
             IntraModeAngular_AV1_Z1_16bit,
             // AVX2
             intra_mode_angular_av1_z1_16bit_64x64_avx2,
+            // AVX512
+            intra_mode_angular_av1_z1_16bit_64x64_avx2,
         }
     };
     static EB_INTRA_ANG_Z1_Z2_Z3_16bit_TYPE FUNC_TABLE IntraModeAngular_AV1_Z2_16bit_funcPtrArray[9][ASM_TYPE_TOTAL] = {
@@ -844,6 +919,8 @@ extern "C" {
             IntraModeAngular_AV1_Z2_16bit,
             // AVX2
             intra_mode_angular_av1_z2_16bit_4x4_avx2,
+            // AVX512
+            intra_mode_angular_av1_z2_16bit_4x4_avx2,
         },
         // 8x8
         {
@@ -851,6 +928,8 @@ extern "C" {
             IntraModeAngular_AV1_Z2_16bit,
             // AVX2
             intra_mode_angular_av1_z2_16bit_8x8_avx2,
+            // AVX512
+            intra_mode_angular_av1_z2_16bit_8x8_avx2,
         },
         // 16x16
         {
@@ -858,6 +937,8 @@ extern "C" {
             IntraModeAngular_AV1_Z2_16bit,
             // AVX2
             intra_mode_angular_av1_z2_16bit_16x16_avx2,
+            // AVX512
+            intra_mode_angular_av1_z2_16bit_16x16_avx2,
         },
         // NxN
         {
@@ -865,6 +946,8 @@ extern "C" {
             IntraModeAngular_AV1_Z2_16bit,
             // AVX2
             IntraModeAngular_AV1_Z2_16bit,
+            // AVX512
+            IntraModeAngular_AV1_Z2_16bit,
         },
         // 32x32
         {
@@ -872,6 +955,8 @@ extern "C" {
             IntraModeAngular_AV1_Z2_16bit,
             // AVX2
             intra_mode_angular_av1_z2_16bit_32x32_avx2,
+            // AVX512
+            intra_mode_angular_av1_z2_16bit_32x32_avx2,
         },
         // NxN
         {
@@ -879,6 +964,8 @@ extern "C" {
             IntraModeAngular_AV1_Z2_16bit,
             // AVX2
             IntraModeAngular_AV1_Z2_16bit,
+            // AVX512
+            IntraModeAngular_AV1_Z2_16bit,
         },
         // NxN
         {
@@ -886,6 +973,8 @@ extern "C" {
             IntraModeAngular_AV1_Z2_16bit,
             // AVX2
             IntraModeAngular_AV1_Z2_16bit,
+            // AVX512
+            IntraModeAngular_AV1_Z2_16bit,
         },
         // NxN
         {
@@ -893,6 +982,8 @@ extern "C" {
             IntraModeAngular_AV1_Z2_16bit,
             // AVX2
             IntraModeAngular_AV1_Z2_16bit,
+            // AVX512
+            IntraModeAngular_AV1_Z2_16bit,
         },
         // 64x64
         {
@@ -900,6 +991,8 @@ extern "C" {
             IntraModeAngular_AV1_Z2_16bit,
             // AVX2
             intra_mode_angular_av1_z2_16bit_64x64_avx2,
+            // AVX512
+            intra_mode_angular_av1_z2_16bit_64x64_avx2,
         }
     };
     static EB_INTRA_ANG_Z1_Z2_Z3_16bit_TYPE FUNC_TABLE IntraModeAngular_AV1_Z3_16bit_funcPtrArray[9][ASM_TYPE_TOTAL] = {
@@ -909,6 +1002,8 @@ extern "C" {
             IntraModeAngular_AV1_Z3_16bit,
             // AVX2
             intra_mode_angular_av1_z3_16bit_4x4_avx2,
+            // AVX512
+            intra_mode_angular_av1_z3_16bit_4x4_avx2,
         },
         // 8x8
         {
@@ -916,6 +1011,8 @@ extern "C" {
             IntraModeAngular_AV1_Z3_16bit,
             // AVX2
             intra_mode_angular_av1_z3_16bit_8x8_avx2,
+            // AVX512
+            intra_mode_angular_av1_z3_16bit_8x8_avx2,
         },
         // 16x16
         {
@@ -923,6 +1020,8 @@ extern "C" {
             IntraModeAngular_AV1_Z3_16bit,
             // AVX2
             intra_mode_angular_av1_z3_16bit_16x16_avx2,
+            // AVX512
+            intra_mode_angular_av1_z3_16bit_16x16_avx2,
         },
         // NxN
         {
@@ -930,6 +1029,8 @@ extern "C" {
             IntraModeAngular_AV1_Z3_16bit,
             // AVX2
             IntraModeAngular_AV1_Z3_16bit,
+            // AVX512
+            IntraModeAngular_AV1_Z3_16bit,
         },
         // 32x32
         {
@@ -937,6 +1038,8 @@ extern "C" {
             IntraModeAngular_AV1_Z3_16bit,
             // AVX2
             intra_mode_angular_av1_z3_16bit_32x32_avx2,
+            // AVX512
+            intra_mode_angular_av1_z3_16bit_32x32_avx2,
         },
         // NxN
         {
@@ -944,6 +1047,8 @@ extern "C" {
             IntraModeAngular_AV1_Z3_16bit,
             // AVX2
             IntraModeAngular_AV1_Z3_16bit,
+            // AVX512
+            IntraModeAngular_AV1_Z3_16bit,
         },
         // NxN
         {
@@ -951,6 +1056,8 @@ extern "C" {
             IntraModeAngular_AV1_Z3_16bit,
             // AVX2
             IntraModeAngular_AV1_Z3_16bit,
+            // AVX512
+            IntraModeAngular_AV1_Z3_16bit,
         },
         // NxN
         {
@@ -958,6 +1065,8 @@ extern "C" {
             IntraModeAngular_AV1_Z3_16bit,
             // AVX2
             IntraModeAngular_AV1_Z3_16bit,
+            // AVX512
+            IntraModeAngular_AV1_Z3_16bit,
         },
         // 64x64
         {
@@ -965,6 +1074,8 @@ extern "C" {
             IntraModeAngular_AV1_Z3_16bit,
             // AVX2
             intra_mode_angular_av1_z3_16bit_64x64_avx2,
+            // AVX512
+            intra_mode_angular_av1_z3_16bit_64x64_avx2,
         }
     };
 
@@ -263,6 +263,108 @@ void generate_padding16_bit(
     return;
 }
 
+/** generate_padding_rows()
+        pads the rows [row_start, row_end) of the target picture, for pictures completed a few rows at a time.
+        The top padding is generated with the first row and the bottom padding with the last one.
+ */
+void generate_padding_rows(
+    EbByte  src_pic,                    //output paramter, pointer to the source picture to be padded.
+    uint32_t   src_stride,                 //input paramter, the stride of the source picture to be padded.
+    uint32_t   original_src_width,          //input paramter, the width of the source picture which excludes the padding.
+    uint32_t   original_src_height,         //input paramter, the height of the source picture which excludes the padding.
+    uint32_t   padding_width,              //input paramter, the padding width.
+    uint32_t   padding_height,             //input paramter, the padding height.
+    uint32_t   row_start,                  //input paramter, the first row to pad.
+    uint32_t   row_end)                    //input paramter, the row after the last one to pad.
+{
+    uint32_t   verticalIdx = row_end - row_start;
+    EbByte  tempSrcPic0;
+    EbByte  tempSrcPic1;
+
+    tempSrcPic0 = src_pic + padding_width + (padding_height + row_start) * src_stride;
+    while (verticalIdx)
+    {
+        // horizontal padding
+        EB_MEMSET(tempSrcPic0 - padding_width, *tempSrcPic0, padding_width);
+        EB_MEMSET(tempSrcPic0 + original_src_width, *(tempSrcPic0 + original_src_width - 1), padding_width);
+
+        tempSrcPic0 += src_stride;
+        --verticalIdx;
+    }
+
+    // top part data copy
+    if (row_start == 0) {
+        tempSrcPic0 = src_pic + padding_height * src_stride;
+        tempSrcPic1 = tempSrcPic0;
+        for (verticalIdx = padding_height; verticalIdx; --verticalIdx) {
+            tempSrcPic1 -= src_stride;
+            EB_MEMCPY(tempSrcPic1, tempSrcPic0, sizeof(uint8_t)*src_stride);
+        }
+    }
+
+    // bottom part data copy
+    if (row_end == original_src_height) {
+        tempSrcPic0 = src_pic + (padding_height + original_src_height - 1)*src_stride;
+        tempSrcPic1 = tempSrcPic0;
+        for (verticalIdx = padding_height; verticalIdx; --verticalIdx) {
+            tempSrcPic1 += src_stride;
+            EB_MEMCPY(tempSrcPic1, tempSrcPic0, sizeof(uint8_t)*src_stride);
+        }
+    }
+
+    return;
+}
+/** generate_padding16_bit_rows()
+        is the 16bit version of generate_padding_rows(), the widths and stride are in bytes as in generate_padding16_bit().
+ */
+void generate_padding16_bit_rows(
+    EbByte  src_pic,                    //output paramter, pointer to the source picture to be padded.
+    uint32_t   src_stride,                 //input paramter, the stride of the source picture to be padded.
+    uint32_t   original_src_width,          //input paramter, the width of the source picture which excludes the padding.
+    uint32_t   original_src_height,         //input paramter, the height of the source picture which excludes the padding.
+    uint32_t   padding_width,              //input paramter, the padding width.
+    uint32_t   padding_height,             //input paramter, the padding height.
+    uint32_t   row_start,                  //input paramter, the first row to pad.
+    uint32_t   row_end)                    //input paramter, the row after the last one to pad.
+{
+    uint32_t   verticalIdx = row_end - row_start;
+    EbByte  tempSrcPic0;
+    EbByte  tempSrcPic1;
+
+    tempSrcPic0 = src_pic + padding_width + (padding_height + row_start) * src_stride;
+    while (verticalIdx)
+    {
+        // horizontal padding
+        memset16bit((uint16_t*)(tempSrcPic0 - padding_width), ((uint16_t*)(tempSrcPic0))[0], padding_width >> 1);
+        memset16bit((uint16_t*)(tempSrcPic0 + original_src_width), ((uint16_t*)(tempSrcPic0 + original_src_width - 2))[0], padding_width >> 1);
+
+        tempSrcPic0 += src_stride;
+        --verticalIdx;
+    }
+
+    // top part data copy
+    if (row_start == 0) {
+        tempSrcPic0 = src_pic + padding_height * src_stride;
+        tempSrcPic1 = tempSrcPic0;
+        for (verticalIdx = padding_height; verticalIdx; --verticalIdx) {
+            tempSrcPic1 -= src_stride;
+            EB_MEMCPY(tempSrcPic1, tempSrcPic0, sizeof(uint8_t)*src_stride);
+        }
+    }
+
+    // bottom part data copy
+    if (row_end == original_src_height) {
+        tempSrcPic0 = src_pic + (padding_height + original_src_height - 1)*src_stride;
+        tempSrcPic1 = tempSrcPic0;
+        for (verticalIdx = padding_height; verticalIdx; --verticalIdx) {
+            tempSrcPic1 += src_stride;
+            EB_MEMCPY(tempSrcPic1, tempSrcPic0, sizeof(uint8_t)*src_stride);
+        }
+    }
+
+    return;
+}
+
 
 /** pad_input_picture()
 is used to pad the input picture in order to get . The horizontal padding happens first and then the vertical padding.
@@ -151,6 +151,8 @@ extern "C" {
         // NON_AVX2
         initialize_buffer_32bits_sse2_intrin,
         // AVX2
+        initialize_buffer_32bits_sse2_intrin,
+        // AVX512
         initialize_buffer_32bits_sse2_intrin
     };
 
@@ -2515,6 +2515,140 @@ void ProductInitMdCandInjection(
 
     return;
 }
+/***************************************
+* inject_static_sb_candidate
+*   Injects the zero motion GLOBALMV
+*   LAST_FRAME candidate alone, for the SBs
+*   that ME found unchanged
+***************************************/
+static void inject_static_sb_candidate(
+    PictureControlSet_t            *picture_control_set_ptr,
+    ModeDecisionContext_t          *context_ptr,
+    LargestCodingUnit_t            *sb_ptr,
+    uint32_t                       *candidateTotalCnt)
+{
+    uint32_t                   canTotalCnt = *candidateTotalCnt;
+    ModeDecisionCandidate_t    *candidateArray = context_ptr->fast_candidate_array;
+    static MvReferenceFrame refFrames[] = { LAST_FRAME, BWDREF_FRAME, LAST_BWD_FRAME };
+
+    // The rate estimation needs the reference MV stack and contexts of the block
+    generate_av1_mvp_table(
+#if TILES
+        &sb_ptr->tile_info,
+#endif
+        context_ptr,
+        context_ptr->cu_ptr,
+        context_ptr->blk_geom,
+        context_ptr->cu_origin_x,
+        context_ptr->cu_origin_y,
+        refFrames,
+        (picture_control_set_ptr->parent_pcs_ptr->reference_mode == SINGLE_REFERENCE) ? 1 : 3,
+        picture_control_set_ptr);
+
+    av1_count_overlappable_neighbors(
+        picture_control_set_ptr,
+        context_ptr->cu_ptr,
+        context_ptr->blk_geom->bsize,
+        context_ptr->cu_origin_y >> MI_SIZE_LOG2,
+        context_ptr->cu_origin_x >> MI_SIZE_LOG2);
+
+    candidateArray[canTotalCnt].type = INTER_MODE;
+#if TWO_FAST_LOOP
+    candidateArray[canTotalCnt].enable_two_fast_loops = 0;
+#else
+    candidateArray[canTotalCnt].distortion_ready = 0;
+#endif
+    candidateArray[canTotalCnt].merge_flag = EB_FALSE;
+    candidateArray[canTotalCnt].merge_index = 0;
+    candidateArray[canTotalCnt].mpm_flag = EB_FALSE;
+    candidateArray[canTotalCnt].prediction_direction[0] = (EbPredDirection)0;
+    candidateArray[canTotalCnt].is_skip_mode_flag = 0;
+    candidateArray[canTotalCnt].inter_mode = GLOBALMV;
+    candidateArray[canTotalCnt].pred_mode = GLOBALMV;
+    candidateArray[canTotalCnt].motion_mode = SIMPLE_TRANSLATION;
+    candidateArray[canTotalCnt].is_compound = 0;
+    candidateArray[canTotalCnt].is_new_mv = 0;
+    candidateArray[canTotalCnt].is_zero_mv = 0;
+    candidateArray[canTotalCnt].drl_index = 0;
+    candidateArray[canTotalCnt].ref_mv_index = 0;
+    candidateArray[canTotalCnt].pred_mv_weight = 0;
+    candidateArray[canTotalCnt].ref_frame_type = LAST_FRAME;
+    candidateArray[canTotalCnt].transform_type[PLANE_TYPE_Y] = DCT_DCT;
+    candidateArray[canTotalCnt].transform_type[PLANE_TYPE_UV] = DCT_DCT;
+    candidateArray[canTotalCnt].motionVector_x_L0 = 0;
+    candidateArray[canTotalCnt].motionVector_y_L0 = 0;
+    ++canTotalCnt;
+
+    *candidateTotalCnt = canTotalCnt;
+}
+
+/***************************************
+* Drop Candidates Past Ref Row Reach
+*   With frame_row_overlap, the segments of an
+*   SB row start once the reference rows down to
+*   ref_row_reach below it are ready: the inter
+*   candidates reading further are dropped. The
+*   zero vector candidates stay within the reach.
+***************************************/
+#define REF_ROW_FILTER_MARGIN 8 // luma rows read below a predicted block by the 8-tap luma/chroma filters
+
+static int32_t candidate_ref_row_end(
+    ModeDecisionContext_t          *context_ptr,
+    ModeDecisionCandidate_t        *candidate_ptr)
+{
+    const int32_t block_top = context_ptr->cu_origin_y;
+    const int32_t block_bottom = block_top + context_ptr->blk_geom->bheight;
+    int32_t ref_row_end = block_bottom;
+
+    if (candidate_ptr->motion_mode == WARPED_CAUSAL) {
+        // Bottom corners of the block through the affine model
+        const int32_t *mat = candidate_ptr->wm_params.wmmat;
+        const int64_t x0 = context_ptr->cu_origin_x;
+        const int64_t x1 = x0 + context_ptr->blk_geom->bwidth - 1;
+        const int64_t y1 = block_bottom - 1;
+        const int64_t corner0 = (int64_t)mat[4] * x0 + (int64_t)mat[5] * y1 + mat[1];
+        const int64_t corner1 = (int64_t)mat[4] * x1 + (int64_t)mat[5] * y1 + mat[1];
+
+        ref_row_end = (int32_t)((MAX(corner0, corner1) >> WARPEDMODEL_PREC_BITS) + 1);
+    }
+    else {
+        // Vectors in 1/8 pel
+        const EbBool use_l0 = candidate_ptr->is_compound || candidate_ptr->prediction_direction[0] != UNI_PRED_LIST_1;
+        const EbBool use_l1 = candidate_ptr->is_compound || candidate_ptr->prediction_direction[0] != UNI_PRED_LIST_0;
+
+        if (use_l0)
+            ref_row_end = MAX(ref_row_end, block_bottom + ((candidate_ptr->motionVector_y_L0 + 7) >> 3));
+        if (use_l1)
+            ref_row_end = MAX(ref_row_end, block_bottom + ((candidate_ptr->motionVector_y_L1 + 7) >> 3));
+    }
+
+    return ref_row_end + REF_ROW_FILTER_MARGIN;
+}
+
+static void drop_candidates_past_ref_row_reach(
+    PictureControlSet_t            *picture_control_set_ptr,
+    ModeDecisionContext_t          *context_ptr,
+    LargestCodingUnit_t            *sb_ptr,
+    uint32_t                        sb_size,
+    uint32_t                       *candidateTotalCnt)
+{
+    ModeDecisionCandidate_t *candidateArray = context_ptr->fast_candidate_array;
+    const int32_t ref_row_limit = (int32_t)(sb_ptr->origin_y + sb_size + picture_control_set_ptr->ref_row_reach);
+    uint32_t canTotalCnt = 0;
+    uint32_t canIdx;
+
+    for (canIdx = 0; canIdx < *candidateTotalCnt; ++canIdx) {
+        if (candidateArray[canIdx].type == INTER_MODE &&
+            candidate_ref_row_end(context_ptr, &candidateArray[canIdx]) > ref_row_limit)
+            continue;
+        if (canIdx != canTotalCnt)
+            candidateArray[canTotalCnt] = candidateArray[canIdx];
+        ++canTotalCnt;
+    }
+
+    *candidateTotalCnt = canTotalCnt;
+}
+
 /***************************************
 * ProductGenerateMdCandidatesCu
 *   Creates list of initial modes to
@@ -2552,8 +2686,14 @@ EbErrorType ProductGenerateMdCandidatesCu(
     uint8_t sq_index = LOG2F(context_ptr->blk_geom->sq_size) - 2;
     uint8_t inject_intra_candidate = 1;
     uint8_t inject_inter_candidate = 1;
+    // Static SB: set by MDC for the inter pictures only
+    uint8_t inject_static_candidate = picture_control_set_ptr->parent_pcs_ptr->static_sb_array[sb_ptr->index];
 
-    if (slice_type != I_SLICE) {
+    if (inject_static_candidate) {
+        inject_intra_candidate = 0;
+        inject_inter_candidate = 0;
+    }
+    else if (slice_type != I_SLICE) {
         if (picture_control_set_ptr->parent_pcs_ptr->nsq_search_level == NSQ_SEARCH_BASE_ON_SQ_TYPE) {
             inject_intra_candidate = context_ptr->blk_geom->shape == PART_N ? 1 :
                 context_ptr->parent_sq_type[sq_index] == INTRA_MODE ? inject_intra_candidate : 0;
@@ -2590,6 +2730,19 @@ EbErrorType ProductGenerateMdCandidatesCu(
                 sb_ptr,
                 &canTotalCnt,
                 leaf_index);
+        if (inject_static_candidate)
+            inject_static_sb_candidate(
+                picture_control_set_ptr,
+                context_ptr,
+                sb_ptr,
+                &canTotalCnt);
+        if (sequence_control_set_ptr->static_config.frame_row_overlap)
+            drop_candidates_past_ref_row_reach(
+                picture_control_set_ptr,
+                context_ptr,
+                sb_ptr,
+                sequence_control_set_ptr->sb_size_pix,
+                &canTotalCnt);
     }
 
     // Set BufferTotalCount: determines the number of candidates to fully reconstruct
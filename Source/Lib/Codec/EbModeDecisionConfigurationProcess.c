@@ -2979,6 +2979,74 @@ void forward_all_c_blocks_to_md(
 
     picture_control_set_ptr->parent_pcs_ptr->average_qp = (uint8_t)picture_control_set_ptr->parent_pcs_ptr->picture_qp;
 }
+
+/******************************************************
+ * Forward the static SBs to MD
+ *   The SBs that ME found unchanged from the list 0
+ *   reference are sent to MD as a single 64x64 block,
+ *   where the zero motion LAST_FRAME candidate is the
+ *   only one evaluated. The fast path is kept to 64x64
+ *   SBs and to pictures without global motion, where
+ *   GLOBALMV is the zero vector.
+ ******************************************************/
+static void ForwardStaticSbsToMd(
+    SequenceControlSet_t                   *sequence_control_set_ptr,
+    PictureControlSet_t                    *picture_control_set_ptr)
+{
+    PictureParentControlSet_t *parentPcsPtr = picture_control_set_ptr->parent_pcs_ptr;
+    MdcLcuData_t *resultsPtr;
+    uint32_t sb_index;
+
+    if (picture_control_set_ptr->slice_type == I_SLICE ||
+        sequence_control_set_ptr->sb_size != BLOCK_64X64 ||
+        parentPcsPtr->global_motion[LAST_FRAME].wmtype != IDENTITY) {
+        EB_MEMSET(parentPcsPtr->static_sb_array, EB_FALSE, sizeof(EbBool) * parentPcsPtr->sb_total_count);
+        return;
+    }
+
+    for (sb_index = 0; sb_index < picture_control_set_ptr->sb_total_count; ++sb_index) {
+        if (parentPcsPtr->static_sb_array[sb_index]) {
+            resultsPtr = &picture_control_set_ptr->mdc_sb_array[sb_index];
+            resultsPtr->leaf_count = 1;
+            resultsPtr->leaf_data_array[0].mds_idx = 0;
+            resultsPtr->leaf_data_array[0].tot_d1_blocks = 1;
+            resultsPtr->leaf_data_array[0].leaf_index = 0;
+            resultsPtr->leaf_data_array[0].split_flag = EB_FALSE;
+        }
+    }
+}
+
+/******************************************************
+ * Derive the reference row reach (frame_row_overlap)
+ *   The luma rows the segments wait for below an SB: the
+ *   largest vertical ME vector plus REF_ROW_SYNC_MARGIN.
+ *   MD drops the inter candidates reading further, so the
+ *   margin only sizes how many refined and neighbour
+ *   vectors stay available.
+ ******************************************************/
+#define REF_ROW_SYNC_MARGIN 128 // room for the MD refinements and the neighbour vectors
+
+static void DeriveRefRowReach(
+    PictureControlSet_t                    *picture_control_set_ptr)
+{
+    PictureParentControlSet_t *parentPcsPtr = picture_control_set_ptr->parent_pcs_ptr;
+    uint32_t maxMvY = 0;
+    uint32_t sb_index;
+    uint32_t puIndex;
+
+    for (sb_index = 0; sb_index < parentPcsPtr->sb_total_count; ++sb_index) {
+        for (puIndex = 0; puIndex < parentPcsPtr->max_number_of_pus_per_sb; ++puIndex) {
+            const MeCuResults_t *mePuResult = &parentPcsPtr->me_results[sb_index][puIndex];
+            maxMvY = MAX(maxMvY, (uint32_t)ABS(mePuResult->yMvL0));
+            if (picture_control_set_ptr->slice_type == B_SLICE)
+                maxMvY = MAX(maxMvY, (uint32_t)ABS(mePuResult->yMvL1));
+        }
+    }
+
+    // ME vectors are in quarter pel
+    picture_control_set_ptr->ref_row_reach = ((maxMvY + 3) >> 2) + REF_ROW_SYNC_MARGIN;
+}
+
 /******************************************************
  * Mode Decision Configuration Kernel
  ******************************************************/
@@ -3275,11 +3343,19 @@ void* ModeDecisionConfigurationKernel(void *input_ptr)
         }
 
 
+        ForwardStaticSbsToMd(
+            sequence_control_set_ptr,
+            picture_control_set_ptr);
+
         // Derive MD parameters
         SetMdSettings( // HT Done
             sequence_control_set_ptr,
             picture_control_set_ptr);
 
+        if (sequence_control_set_ptr->static_config.frame_row_overlap && picture_control_set_ptr->slice_type != I_SLICE)
+            DeriveRefRowReach(
+                picture_control_set_ptr);
+
         // Post the results to the MD processes
         eb_get_empty_object(
             context_ptr->modeDecisionConfigurationOutputFifoPtr,
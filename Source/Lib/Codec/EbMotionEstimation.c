@@ -122,6 +122,8 @@ static EB_COMPUTE8X4SAD_TYPE FUNC_TABLE compute8x4SAD_funcPtrArray[ASM_TYPE_TOTA
     Compute8x4SAD_Kernel,
     // SSE2
     Compute8x4SAD_Kernel,
+    // AVX512
+    Compute8x4SAD_Kernel,
 };
 /***************************************
 * Function Tables
@@ -130,12 +132,16 @@ static EB_EXTSADCALCULATION8X8AND16X16_TYPE ExtSadCalculation_8x8_16x16_funcPtrA
     // NON_AVX2
     ext_sad_calculation_8x8_16x16,
     // AVX2
+    ext_sad_calculation_8x8_16x16_avx2_intrin,
+    // AVX512
     ext_sad_calculation_8x8_16x16_avx2_intrin
 };
 static EB_EXTSADCALCULATION32X32AND64X64_TYPE ExtSadCalculation_32x32_64x64_funcPtrArray[ASM_TYPE_TOTAL] = {
     // NON_AVX2
     ext_sad_calculation_32x32_64x64,
     // AVX2
+    ext_sad_calculation_32x32_64x64_sse4_intrin,
+    // AVX512
     ext_sad_calculation_32x32_64x64_sse4_intrin
 };
 static EB_SADCALCULATION8X8AND16X16_TYPE SadCalculation_8x8_16x16_funcPtrArray[ASM_TYPE_TOTAL] = {
@@ -143,12 +149,16 @@ static EB_SADCALCULATION8X8AND16X16_TYPE SadCalculation_8x8_16x16_funcPtrArray[A
     sad_calculation_8x8_16x16_sse2_intrin,
     // AVX2
     sad_calculation_8x8_16x16_sse2_intrin,
+    // AVX512
+    sad_calculation_8x8_16x16_sse2_intrin,
 };
 static EB_SADCALCULATION32X32AND64X64_TYPE SadCalculation_32x32_64x64_funcPtrArray[ASM_TYPE_TOTAL] = {
     // NON_AVX2
     sad_calculation_32x32_64x64_sse2_intrin,
     // AVX2
     sad_calculation_32x32_64x64_sse2_intrin,
+    // AVX512
+    sad_calculation_32x32_64x64_sse2_intrin,
 };
 
 /*******************************************
@@ -1056,6 +1066,8 @@ static EB_EXTSADCALCULATION_TYPE ExtSadCalculation_funcPtrArray[ASM_TYPE_TOTAL]
     // C_DEFAULT
     ExtSadCalculation,
     // Assembly
+    ExtSadCalculation,
+    // AVX512
     ExtSadCalculation
 };
 
@@ -4223,7 +4235,7 @@ void HmeOneQuadrantLevel0(
             search_area_width = (int16_t)(floor((double)((search_area_width >> 4) << 4)));
         }
 
-        if (((search_area_width & 15) == 0) && (asm_type == ASM_AVX2))
+        if (((search_area_width & 15) == 0) && (asm_type >= ASM_AVX2))
         {
             sad_loop_kernel_avx2_hme_l0_intrin(
                 &context_ptr->sixteenth_sb_buffer[0],
@@ -4388,7 +4400,7 @@ void HmeLevel0(
 
     if (((sb_width & 7) == 0) || (sb_width == 4))
     {
-        if (((search_area_width & 15) == 0) && (asm_type == ASM_AVX2))
+        if (((search_area_width & 15) == 0) && (asm_type >= ASM_AVX2))
         {
             sad_loop_kernel_avx2_hme_l0_intrin(
                 &context_ptr->sixteenth_sb_buffer[0],
@@ -6106,6 +6118,55 @@ static void hme_mv_center_check(
     *ysc = search_center_y;
 }
 
+/*******************************************
+* AdaptSearchArea
+*   Motion adaptive search area (adaptive_me_search_range). Each HME search
+*   region of the SB leads to its own center. Where the centers agree, HME
+*   has located the motion to the precision of its last level, and the
+*   full-pel search only refines it. Where they spread further apart than
+*   the configured area covers, the area grows to span them, up to twice
+*   its size.
+*******************************************/
+static const int16_t AdaptiveSearchAreaMin[3] = { 32, 24, 16 }; // by last HME level
+
+static void AdaptSearchArea(
+    MeContext_t             *context_ptr,
+    int16_t                  xHmeSearchCenter[EB_HME_SEARCH_AREA_COLUMN_MAX_COUNT][EB_HME_SEARCH_AREA_ROW_MAX_COUNT],
+    int16_t                  yHmeSearchCenter[EB_HME_SEARCH_AREA_COLUMN_MAX_COUNT][EB_HME_SEARCH_AREA_ROW_MAX_COUNT],
+    uint8_t                  hmeLevel,
+    int16_t                 *search_area_width,
+    int16_t                 *search_area_height)
+{
+    int16_t xMin = xHmeSearchCenter[0][0];
+    int16_t xMax = xMin;
+    int16_t yMin = yHmeSearchCenter[0][0];
+    int16_t yMax = yMin;
+    int16_t xSpread;
+    int16_t ySpread;
+    uint32_t searchRegionNumberInWidth;
+    uint32_t searchRegionNumberInHeight;
+
+    for (searchRegionNumberInHeight = 0; searchRegionNumberInHeight < context_ptr->number_hme_search_region_in_height; ++searchRegionNumberInHeight) {
+        for (searchRegionNumberInWidth = 0; searchRegionNumberInWidth < context_ptr->number_hme_search_region_in_width; ++searchRegionNumberInWidth) {
+            xMin = MIN(xMin, xHmeSearchCenter[searchRegionNumberInWidth][searchRegionNumberInHeight]);
+            xMax = MAX(xMax, xHmeSearchCenter[searchRegionNumberInWidth][searchRegionNumberInHeight]);
+            yMin = MIN(yMin, yHmeSearchCenter[searchRegionNumberInWidth][searchRegionNumberInHeight]);
+            yMax = MAX(yMax, yHmeSearchCenter[searchRegionNumberInWidth][searchRegionNumberInHeight]);
+        }
+    }
+
+    // The best center may lie at either end of the spread
+    xSpread = (xMax - xMin) << 1;
+    ySpread = (yMax - yMin) << 1;
+
+    *search_area_width = xSpread > *search_area_width ?
+        (int16_t)MIN(xSpread + AdaptiveSearchAreaMin[hmeLevel], MIN(*search_area_width << 1, 127)) :
+        (int16_t)MIN(xSpread + AdaptiveSearchAreaMin[hmeLevel], *search_area_width);
+    *search_area_height = ySpread > *search_area_height ?
+        (int16_t)MIN(ySpread + AdaptiveSearchAreaMin[hmeLevel], MIN(*search_area_height << 1, 127)) :
+        (int16_t)MIN(ySpread + AdaptiveSearchAreaMin[hmeLevel], *search_area_height);
+}
+
 /*******************************************
 * MotionEstimateLcu
 *   performs ME (LCU)
@@ -6205,6 +6266,10 @@ EbErrorType MotionEstimateLcu(
     EbBool                    enableHalfPel8x8 = EB_FALSE;
     EbBool                    enableQuarterPel = EB_FALSE;
     EbBool                 oneQuadrantHME =  EB_FALSE;
+    // Static SB: only the collocated full-pel position of the list 0 reference is evaluated
+    EbBool                 static_sb = picture_control_set_ptr->static_sb_array[sb_index];
+    EbBool                 static_list;
+    EbBool                 hme_done;
 
 #if M0_SAD_HALF_QUARTER_PEL_BIPRED_SEARCH || M0_SSD_HALF_QUARTER_PEL_BIPRED_SEARCH
 #if M0_SSD_HALF_QUARTER_PEL_BIPRED_SEARCH
@@ -6242,11 +6307,14 @@ EbErrorType MotionEstimateLcu(
             refPicPtr = (EbPictureBufferDesc_t*)referenceObject->inputPaddedPicturePtr;
             quarterRefPicPtr = (EbPictureBufferDesc_t*)referenceObject->quarterDecimatedPicturePtr;
             sixteenthRefPicPtr = (EbPictureBufferDesc_t*)referenceObject->sixteenthDecimatedPicturePtr;
+            hme_done = EB_FALSE;
+            // The static SB detection is against the list 0 reference: list 1 is searched as usual
+            static_list = (static_sb && listIndex == REF_LIST_0) ? EB_TRUE : EB_FALSE;
 
             if (picture_control_set_ptr->temporal_layer_index > 0 || listIndex == 0) {
                 // A - The MV center for Tier0 search could be either (0,0), or HME
                 // A - Set HME MV Center
-                if (context_ptr->update_hme_search_center_flag)
+                if (context_ptr->update_hme_search_center_flag && !static_list)
                     hme_mv_center_check(
                         refPicPtr,
                         context_ptr,
@@ -6265,7 +6333,8 @@ EbErrorType MotionEstimateLcu(
                 // B - NO HME in boundaries
                 // C - Skip HME
 
-                if (picture_control_set_ptr->enable_hme_flag && /*B*/sb_height == BLOCK_SIZE_64) {//(searchCenterSad > sequence_control_set_ptr->static_config.skipTier0HmeTh)) {
+                if (picture_control_set_ptr->enable_hme_flag && !static_list && /*B*/sb_height == BLOCK_SIZE_64) {//(searchCenterSad > sequence_control_set_ptr->static_config.skipTier0HmeTh)) {
+                    hme_done = EB_TRUE;
                     while (searchRegionNumberInHeight < context_ptr->number_hme_search_region_in_height) {
                         while (searchRegionNumberInWidth < context_ptr->number_hme_search_region_in_width) {
 
@@ -6540,6 +6609,15 @@ EbErrorType MotionEstimateLcu(
             }
             search_area_width = (int16_t)MIN(context_ptr->search_area_width, 127);
             search_area_height = (int16_t)MIN(context_ptr->search_area_height, 127);
+
+            if (sequence_control_set_ptr->static_config.adaptive_me_search_range && hme_done) {
+                if (enable_hme_level2_flag)
+                    AdaptSearchArea(context_ptr, xHmeLevel2SearchCenter, yHmeLevel2SearchCenter, 2, &search_area_width, &search_area_height);
+                else if (enable_hme_level1_flag)
+                    AdaptSearchArea(context_ptr, xHmeLevel1SearchCenter, yHmeLevel1SearchCenter, 1, &search_area_width, &search_area_height);
+                else
+                    AdaptSearchArea(context_ptr, xHmeLevel0SearchCenter, yHmeLevel0SearchCenter, 0, &search_area_width, &search_area_height);
+            }
     
             if ((x_search_center != 0 || y_search_center != 0) && (picture_control_set_ptr->is_used_as_reference_flag == EB_TRUE)) {
                 CheckZeroZeroCenter(
@@ -6574,6 +6652,13 @@ EbErrorType MotionEstimateLcu(
                 }
             }
 
+            if (static_list) {
+                search_area_width = 1;
+                search_area_height = 1;
+                x_search_area_origin = 0;
+                y_search_area_origin = 0;
+            }
+
 
             // Correct the left edge of the Search Area if it is not on the reference Picture
             x_search_area_origin = ((origin_x + x_search_area_origin) < -padWidth) ?
@@ -6739,7 +6824,7 @@ EbErrorType MotionEstimateLcu(
 #if M0_ME_QUARTER_PEL_SEARCH
                 enableQuarterPel = EB_TRUE;
 #endif
-                if (picture_control_set_ptr->use_subpel_flag == 1) {
+                if (picture_control_set_ptr->use_subpel_flag == 1 && !static_list) {
 #if M0_ME_QUARTER_PEL_SEARCH
                     enableQuarterPel = EB_TRUE; // AMIR enable in M1
 #else
@@ -7092,7 +7177,7 @@ uint64_t SixteenthDecimatedSearch(
     yTopLeftSearchRegion = ((int16_t)sixteenthRefPicPtr->origin_y + origin_y) + y_search_area_origin;
     searchRegionIndex = xTopLeftSearchRegion + yTopLeftSearchRegion * sixteenthRefPicPtr->stride_y;
 
-    if (((search_area_width & 15) == 0) && (asm_type == ASM_AVX2))
+    if (((search_area_width & 15) == 0) && (asm_type >= ASM_AVX2))
     {
         sad_loop_kernel_avx2_hme_l0_intrin(
             &context_ptr->sixteenth_sb_buffer[0],
@@ -7764,7 +7849,7 @@ EbErrorType OpenLoopIntraDC(
 
     if ((cu_size == 32) || (cu_size == 16) || (cu_size == 8))
     {
-        if (asm_type == ASM_AVX2)
+        if (asm_type >= ASM_AVX2)
         {
             OisCuPtr[0].distortion = (uint32_t)update_neighbor_dc_intra_pred_avx2_intrin(
                 context_ptr->intra_ref_ptr->y_intra_reference_array_reverse,
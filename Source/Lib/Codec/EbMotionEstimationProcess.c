@@ -349,6 +349,45 @@ EbErrorType ComputeDecimatedZzSad(
 
 
 
+/***************************************************************************************************
+* Static SB Detection
+*   Full resolution ZZ SAD of a complete 64x64 SB against the list 0 reference; the SBs
+*   below STATIC_SB_SAD_TH skip the list 0 search in ME and are coded as zero motion in MD.
+*   Only when static_sb_fast_path is set.
+***************************************************************************************************/
+static EbBool IsStaticSb(
+    SequenceControlSet_t        *sequence_control_set_ptr,
+    PictureParentControlSet_t   *picture_control_set_ptr,
+    EbPictureBufferDesc_t       *inputPaddedPicturePtr,
+    uint32_t                     sb_index,
+    uint32_t                     sb_origin_x,
+    uint32_t                     sb_origin_y) {
+
+    EbAsm asm_type = sequence_control_set_ptr->encode_context_ptr->asm_type;
+    EbPaReferenceObject_t *referenceObject;
+    EbPictureBufferDesc_t *refPicPtr;
+    uint32_t inputIndex;
+    uint32_t refIndex;
+
+    if (!sequence_control_set_ptr->static_config.static_sb_fast_path ||
+        sequence_control_set_ptr->sb_size != BLOCK_64X64 || !sequence_control_set_ptr->sb_params_array[sb_index].is_complete_sb)
+        return EB_FALSE;
+
+    referenceObject = (EbPaReferenceObject_t*)picture_control_set_ptr->ref_pa_pic_ptr_array[REF_LIST_0]->object_ptr;
+    refPicPtr = (EbPictureBufferDesc_t*)referenceObject->inputPaddedPicturePtr;
+
+    inputIndex = (inputPaddedPicturePtr->origin_y + sb_origin_y) * inputPaddedPicturePtr->stride_y + inputPaddedPicturePtr->origin_x + sb_origin_x;
+    refIndex = (refPicPtr->origin_y + sb_origin_y) * refPicPtr->stride_y + refPicPtr->origin_x + sb_origin_x;
+
+    return NxMSadKernel_funcPtrArray[asm_type][BLOCK_SIZE_64 >> 3](
+        &inputPaddedPicturePtr->buffer_y[inputIndex],
+        inputPaddedPicturePtr->stride_y,
+        &refPicPtr->buffer_y[refIndex],
+        refPicPtr->stride_y,
+        BLOCK_SIZE_64,
+        BLOCK_SIZE_64) < STATIC_SB_SAD_TH ? EB_TRUE : EB_FALSE;
+}
+
 /************************************************
  * Motion Analysis Kernel
  * The Motion Analysis performs  Motion Estimation
@@ -541,6 +580,14 @@ void* MotionEstimationKernel(void *input_ptr)
                         }
                     }
 
+                    picture_control_set_ptr->static_sb_array[sb_index] = IsStaticSb(
+                        sequence_control_set_ptr,
+                        picture_control_set_ptr,
+                        inputPaddedPicturePtr,
+                        sb_index,
+                        sb_origin_x,
+                        sb_origin_y);
+
                     MotionEstimateLcu(
                         picture_control_set_ptr,
                         sb_index,
@@ -31,11 +31,15 @@ extern "C" {
             eb_enc_msb_pack2_d,
             // AVX2
             eb_enc_msb_pack2_d,
+            // AVX512
+            eb_enc_msb_pack2_d,
         },
         {
             // NON_AVX2
             eb_enc_msb_pack2d_sse2_intrin,
             // AVX2
+            eb_enc_msb_pack2d_avx2_intrin_al,
+            // AVX512
             eb_enc_msb_pack2d_avx2_intrin_al,//EB_ENC_msbPack2D_AVX2
         }
     };
@@ -47,6 +51,8 @@ extern "C" {
         compressed_packmsb,
         // AVX2
         compressed_packmsb_avx2_intrin,
+        // AVX512
+        compressed_packmsb_avx2_intrin,
 
     };
 
@@ -65,6 +71,8 @@ extern "C" {
         c_pack_c,
         // AVX2
         c_pack_avx2_intrin,
+        // AVX512
+        c_pack_avx2_intrin,
 
     };
 
@@ -85,12 +93,16 @@ extern "C" {
             eb_enc_msb_un_pack2_d,
             // AVX2
             eb_enc_msb_un_pack2_d,
+            // AVX512
+            eb_enc_msb_un_pack2_d,
         },
         {
             // NON_AVX2
             eb_enc_msb_un_pack2d_sse2_intrin,
             // AVX2
             eb_enc_msb_un_pack2d_sse2_intrin,
+            // AVX512
+            eb_enc_msb_un_pack2d_sse2_intrin,
         }
     };
 
@@ -109,6 +121,8 @@ extern "C" {
         // NON_AVX2
         unpack_avg,
         // AVX2
+        unpack_avg_avx2_intrin,
+        // AVX512
         unpack_avg_avx2_intrin,//unpack_avg_sse2_intrin,
 
     };
@@ -129,6 +143,8 @@ extern "C" {
         // NON_AVX2
         unpack_avg_safe_sub,
         // AVX2  SafeSub
+        unpack_avg_safe_sub_avx2_intrin,
+        // AVX512  SafeSub
         unpack_avg_safe_sub_avx2_intrin,//unpack_avg_sse2_intrin,
 
     };
@@ -146,12 +162,16 @@ extern "C" {
         {
            un_pack8_bit_data,
            un_pack8_bit_data,
+           // AVX512
+           un_pack8_bit_data,
         },
         {
             // NON_AVX2
             un_pack8_bit_data,
             // AVX2
             eb_enc_un_pack8_bit_data_avx2_intrin,
+            // AVX512
+            eb_enc_un_pack8_bit_data_avx2_intrin,
         }
     };
 
@@ -169,6 +189,8 @@ extern "C" {
         un_pack8_bit_data,
         // AVX2
         eb_enc_un_pack8_bit_data_avx2_intrin,
+        // AVX512
+        eb_enc_un_pack8_bit_data_avx2_intrin,
 
     };
 
@@ -14,6 +14,7 @@
 #include "EbEntropyCoding.h"
 #include "EbRateControlTasks.h"
 #include "EbTime.h"
+#include "EbErrorCodes.h"
 
 static EbBool IsPassthroughData(EbLinkedListNode* dataNode)
 {
@@ -31,6 +32,50 @@ static EbLinkedListNode* ExtractPassthroughData(EbLinkedListNode** llPtrPtr)
 }
 
 
+#if TILES
+/******************************************************
+ * Join Entropy Coding Tiles
+ *   Tiles coded in parallel are in the bitstream of
+ *   their own tile, except the first one which is
+ *   already in place in the picture bitstream after
+ *   its size field. The others are appended, each but
+ *   the last preceded by its size. Reports an error
+ *   when they do not fit in the picture bitstream.
+ ******************************************************/
+static void JoinEntropyCodingTiles(
+    PictureControlSet_t *picture_control_set_ptr,
+    EncodeContext_t     *encode_context_ptr)
+{
+    EntropyCoder_t        *picture_entropy_coder_ptr = picture_control_set_ptr->entropy_coder_ptr;
+    OutputBitstreamUnit_t *picture_bitstream_ptr = (OutputBitstreamUnit_t*)picture_entropy_coder_ptr->ecOutputBitstreamPtr;
+    uint8_t               *data = picture_bitstream_ptr->bufferAv1;
+    const uint32_t         buffer_size = picture_bitstream_ptr->size - (uint32_t)(data - picture_bitstream_ptr->bufferBeginAv1);
+    const uint32_t         tile_count = picture_control_set_ptr->entropy_coding_tile_task_count;
+    uint32_t               total_size = 0;
+    uint32_t               tile_idx;
+
+    for (tile_idx = 0; tile_idx < tile_count; ++tile_idx) {
+        EntropyCoder_t *entropy_coder_ptr = picture_control_set_ptr->ec_tile_ptr_array[tile_idx]->entropy_coder_ptr;
+        const uint32_t  tile_size = entropy_coder_ptr->ecWriter.pos;
+
+        CHECK_REPORT_ERROR(
+            (uint64_t)total_size + (tile_idx < tile_count - 1 ? 4 : 0) + tile_size <= buffer_size,
+            encode_context_ptr->app_callback_ptr,
+            EB_ENC_EC_ERROR18);
+
+        if (tile_idx < tile_count - 1) {
+            mem_put_le32(data + total_size, tile_size - AV1_MIN_TILE_SIZE_BYTES);
+            total_size += 4;
+        }
+        if (tile_idx > 0)
+            EB_MEMCPY(data + total_size, ((OutputBitstreamUnit_t*)entropy_coder_ptr->ecOutputBitstreamPtr)->bufferAv1, tile_size);
+        total_size += tile_size;
+    }
+
+    picture_entropy_coder_ptr->ec_frame_size = total_size;
+}
+#endif
+
 EbErrorType packetization_context_ctor(
     PacketizationContext_t **context_dbl_ptr,
     EbFifo_t                *entropy_coding_input_fifo_ptr,
@@ -82,6 +127,136 @@ static void write_td (
     }
 }
 
+// Picture info carried by each packet of the picture
+static void SetPacketPictureInfo(
+    EbBufferHeaderType        *output_stream_ptr,
+    PictureControlSet_t       *picture_control_set_ptr,
+    SequenceControlSet_t      *sequence_control_set_ptr)
+{
+    output_stream_ptr->pts = picture_control_set_ptr->parent_pcs_ptr->input_ptr->pts;
+#if NEW_PRED_STRUCT
+    output_stream_ptr->dts = picture_control_set_ptr->parent_pcs_ptr->decode_order - (uint64_t)(1 << picture_control_set_ptr->parent_pcs_ptr->hierarchical_levels) + 1;
+    UNUSED(sequence_control_set_ptr);
+#else
+    output_stream_ptr->dts = picture_control_set_ptr->parent_pcs_ptr->decode_order - (uint64_t)(1 << sequence_control_set_ptr->static_config.hierarchical_levels) + 1;
+#endif
+    output_stream_ptr->pic_type = picture_control_set_ptr->parent_pcs_ptr->is_used_as_reference_flag ?
+        picture_control_set_ptr->parent_pcs_ptr->idr_flag ? EB_IDR_PICTURE :
+        picture_control_set_ptr->slice_type : EB_NON_REF_PICTURE;
+}
+
+#if TILES
+/******************************************************
+ * Output Tile Groups
+ *   Low latency tile output. Hands out, as partial
+ *   packets of one tile group OBU, the coded tiles of
+ *   the picture from the next one to go up to tile_end
+ *   (excluded), when the picture is the next one in
+ *   decode order. The first packet of the picture also
+ *   holds the temporal delimiter when needed and the
+ *   headers. The last tile group goes to the packet of
+ *   the picture. Called with tile_output_mutex held, the
+ *   packets come from tile_output_spare_ptr: one was
+ *   taken ahead for each coded tile group.
+ ******************************************************/
+static void OutputTileGroups(
+    PictureControlSet_t       *picture_control_set_ptr,
+    SequenceControlSet_t      *sequence_control_set_ptr,
+    uint32_t                   tile_end)
+{
+    EncodeContext_t *encode_context_ptr = sequence_control_set_ptr->encode_context_ptr;
+
+    if (encode_context_ptr->tile_output_decode_order != picture_control_set_ptr->parent_pcs_ptr->decode_order)
+        return;
+
+    while (picture_control_set_ptr->tile_output_count < tile_end &&
+        picture_control_set_ptr->ec_tile_ptr_array[picture_control_set_ptr->tile_output_count]->tile_coded)
+    {
+        const uint32_t      tile_idx = picture_control_set_ptr->tile_output_count++;
+        EbObjectWrapper_t  *output_stream_wrapper_ptr;
+        EbBufferHeaderType *output_stream_ptr;
+        uint32_t            size = 0;
+
+        output_stream_wrapper_ptr = encode_context_ptr->tile_output_spare_ptr;
+        encode_context_ptr->tile_output_spare_ptr = output_stream_wrapper_ptr->nextPtr;
+        output_stream_ptr = (EbBufferHeaderType*)output_stream_wrapper_ptr->object_ptr;
+        output_stream_ptr->flags = EB_BUFFERFLAG_PARTIAL;
+
+        if (tile_idx == 0) {
+            if (encode_context_ptr->td_needed == EB_TRUE) {
+                encode_td_av1(output_stream_ptr->p_buffer);
+                output_stream_ptr->flags |= (uint32_t)EB_BUFFERFLAG_HAS_TD;
+                encode_context_ptr->td_needed = EB_FALSE;
+                size += TD_SIZE;
+            }
+            if (picture_control_set_ptr->parent_pcs_ptr->av1FrameType == KEY_FRAME)
+                size += encode_sps_obu_av1(output_stream_ptr->p_buffer + size, sequence_control_set_ptr);
+            size += encode_frame_header_obu_av1(output_stream_ptr->p_buffer + size, sequence_control_set_ptr, picture_control_set_ptr);
+        }
+        size += encode_tile_group_obu_av1(output_stream_ptr->p_buffer + size, picture_control_set_ptr, tile_idx);
+
+        output_stream_ptr->n_filled_len = size;
+        output_stream_ptr->n_tick_count = 0;
+        output_stream_ptr->p_app_private = NULL;
+        SetPacketPictureInfo(
+            output_stream_ptr,
+            picture_control_set_ptr,
+            sequence_control_set_ptr);
+
+        eb_output_packet(
+            &sequence_control_set_ptr->static_config,
+            output_stream_wrapper_ptr);
+    }
+}
+
+void eb_output_tile_group(
+    PictureControlSet_t *picture_control_set_ptr,
+    uint32_t             tile_idx)
+{
+    SequenceControlSet_t *sequence_control_set_ptr = (SequenceControlSet_t*)picture_control_set_ptr->sequence_control_set_wrapper_ptr->object_ptr;
+    EncodeContext_t      *encode_context_ptr = sequence_control_set_ptr->encode_context_ptr;
+    EbObjectWrapper_t    *output_stream_wrapper_ptr = (EbObjectWrapper_t*)EB_NULL;
+
+    // The packet is taken before the mutex: the application may hold the
+    //   partial packets until the packet of the picture is out
+    if (tile_idx < picture_control_set_ptr->entropy_coding_tile_task_count - 1)
+        eb_get_empty_object(
+            encode_context_ptr->tile_output_fifo_ptr,
+            &output_stream_wrapper_ptr);
+
+    eb_block_on_mutex(encode_context_ptr->tile_output_mutex);
+
+    if (output_stream_wrapper_ptr) {
+        output_stream_wrapper_ptr->nextPtr = encode_context_ptr->tile_output_spare_ptr;
+        encode_context_ptr->tile_output_spare_ptr = output_stream_wrapper_ptr;
+    }
+    picture_control_set_ptr->ec_tile_ptr_array[tile_idx]->tile_coded = EB_TRUE;
+    OutputTileGroups(
+        picture_control_set_ptr,
+        sequence_control_set_ptr,
+        picture_control_set_ptr->entropy_coding_tile_task_count - 1);
+
+    eb_release_mutex(encode_context_ptr->tile_output_mutex);
+}
+#endif
+
+void eb_output_packet(
+    EbSvtAv1EncConfiguration *config,
+    EbObjectWrapper_t        *output_stream_wrapper_ptr)
+{
+    EbBufferHeaderType *output_stream_ptr = (EbBufferHeaderType*)output_stream_wrapper_ptr->object_ptr;
+
+    if (config->output_packet_callback) {
+        // Released by the application with eb_svt_release_out_buffer
+        output_stream_ptr->wrapper_ptr = output_stream_wrapper_ptr;
+        config->output_packet_callback(
+            config->output_callback_context,
+            output_stream_ptr);
+    }
+    else
+        eb_post_full_object(output_stream_wrapper_ptr);
+}
+
 void* PacketizationKernel(void *input_ptr)
 {
     // Context
@@ -104,6 +279,7 @@ void* PacketizationKernel(void *input_ptr)
     EbBufferHeaderType             *output_stream_ptr;
     EbObjectWrapper_t              *rateControlTasksWrapperPtr;
     RateControlTasks_t             *rateControlTasksPtr;
+    uint32_t                        tile_output_size;
     
     // Queue variables
     int32_t                         queueEntryIndex;
@@ -139,17 +315,13 @@ void* PacketizationKernel(void *input_ptr)
         output_stream_wrapper_ptr = picture_control_set_ptr->parent_pcs_ptr->output_stream_wrapper_ptr;
         output_stream_ptr = (EbBufferHeaderType*)output_stream_wrapper_ptr->object_ptr;
         output_stream_ptr->flags = 0;
+        tile_output_size = 0;
         output_stream_ptr->flags |= (encode_context_ptr->terminating_sequence_flag_received == EB_TRUE && picture_control_set_ptr->parent_pcs_ptr->decode_order == encode_context_ptr->terminating_picture_number) ? EB_BUFFERFLAG_EOS : 0;
         output_stream_ptr->n_filled_len = 0;
-        output_stream_ptr->pts = picture_control_set_ptr->parent_pcs_ptr->input_ptr->pts;
-#if NEW_PRED_STRUCT
-        output_stream_ptr->dts = picture_control_set_ptr->parent_pcs_ptr->decode_order - (uint64_t)(1 << picture_control_set_ptr->parent_pcs_ptr->hierarchical_levels) + 1;
-#else
-        output_stream_ptr->dts = picture_control_set_ptr->parent_pcs_ptr->decode_order - (uint64_t)(1 << sequence_control_set_ptr->static_config.hierarchical_levels) + 1;
-#endif     
-        output_stream_ptr->pic_type = picture_control_set_ptr->parent_pcs_ptr->is_used_as_reference_flag ?
-            picture_control_set_ptr->parent_pcs_ptr->idr_flag ? EB_IDR_PICTURE :
-            picture_control_set_ptr->slice_type : EB_NON_REF_PICTURE;
+        SetPacketPictureInfo(
+            output_stream_ptr,
+            picture_control_set_ptr,
+            sequence_control_set_ptr);
         output_stream_ptr->p_app_private = picture_control_set_ptr->parent_pcs_ptr->input_ptr->p_app_private;
 
         // Get Empty Rate Control Input Tasks
@@ -160,31 +332,87 @@ void* PacketizationKernel(void *input_ptr)
         rateControlTasksPtr->pictureControlSetWrapperPtr = picture_control_set_ptr->picture_parent_control_set_wrapper_ptr;
         rateControlTasksPtr->taskType = RC_PACKETIZATION_FEEDBACK_RESULT;
 
-        // slice_type = picture_control_set_ptr->slice_type;
-         // Reset the bitstream before writing to it
-        ResetBitstream(
-            picture_control_set_ptr->bitstreamPtr->outputBitstreamPtr);
+#if TILES
+        if (picture_control_set_ptr->tile_output) {
+            const uint32_t tile_count = picture_control_set_ptr->entropy_coding_tile_task_count;
+            uint8_t *scratch = ((OutputBitstreamUnit_t*)picture_control_set_ptr->bitstreamPtr->outputBitstreamPtr)->bufferBeginAv1;
+            uint32_t tile_idx;
+
+            // Not along with the tile output writing the same frame header
+            eb_block_on_mutex(encode_context_ptr->tile_output_mutex);
+            if (encode_context_ptr->tile_output_decode_order == picture_control_set_ptr->parent_pcs_ptr->decode_order) {
+                // The other tile groups go out on their own, the ones not out yet now:
+                //   their size and the headers' are counted for rate control
+                OutputTileGroups(
+                    picture_control_set_ptr,
+                    sequence_control_set_ptr,
+                    tile_count - 1);
+                tile_output_size = (picture_control_set_ptr->parent_pcs_ptr->av1FrameType == KEY_FRAME) ?
+                    encode_sps_obu_av1(scratch, sequence_control_set_ptr) : 0;
+                tile_output_size += encode_frame_header_obu_av1(scratch, sequence_control_set_ptr, picture_control_set_ptr);
+                for (tile_idx = 0; tile_idx < tile_count - 1; ++tile_idx)
+                    tile_output_size += encode_tile_group_obu_av1(NULL, picture_control_set_ptr, tile_idx);
+
+                output_stream_ptr->n_filled_len = encode_tile_group_obu_av1(
+                    output_stream_ptr->p_buffer,
+                    picture_control_set_ptr,
+                    tile_count - 1);
+            }
+            else {
+                // Coded ahead of a picture before it in decode order: its tile groups
+                //   could not go out before it anyway and all go to its packet, which
+                //   frees its picture control sets. The packets taken ahead go back.
+                for (tile_idx = 0; tile_idx < tile_count - 1; ++tile_idx) {
+                    EbObjectWrapper_t *spare_wrapper_ptr = encode_context_ptr->tile_output_spare_ptr;
+
+                    encode_context_ptr->tile_output_spare_ptr = spare_wrapper_ptr->nextPtr;
+                    eb_release_object(spare_wrapper_ptr);
+                }
 
-        // Code the SPS
-        if (picture_control_set_ptr->parent_pcs_ptr->av1FrameType == KEY_FRAME) {
-            EncodeSPSAv1(
-                picture_control_set_ptr->bitstreamPtr,
-                sequence_control_set_ptr);
+                output_stream_ptr->n_filled_len = (picture_control_set_ptr->parent_pcs_ptr->av1FrameType == KEY_FRAME) ?
+                    encode_sps_obu_av1(output_stream_ptr->p_buffer, sequence_control_set_ptr) : 0;
+                output_stream_ptr->n_filled_len += encode_frame_header_obu_av1(output_stream_ptr->p_buffer + output_stream_ptr->n_filled_len, sequence_control_set_ptr, picture_control_set_ptr);
+                for (tile_idx = 0; tile_idx < tile_count; ++tile_idx)
+                    output_stream_ptr->n_filled_len += encode_tile_group_obu_av1(output_stream_ptr->p_buffer + output_stream_ptr->n_filled_len, picture_control_set_ptr, tile_idx);
+            }
+            eb_release_mutex(encode_context_ptr->tile_output_mutex);
         }
+        else
+#endif
+        {
+            // slice_type = picture_control_set_ptr->slice_type;
+             // Reset the bitstream before writing to it
+            ResetBitstream(
+                picture_control_set_ptr->bitstreamPtr->outputBitstreamPtr);
 
-        WriteFrameHeaderAv1(
-            picture_control_set_ptr->bitstreamPtr,
-            sequence_control_set_ptr,
-            picture_control_set_ptr,
-            0);
-
-        // Copy Slice Header to the Output Bitstream
-        CopyRbspBitstreamToPayload(
-            picture_control_set_ptr->bitstreamPtr,
-            output_stream_ptr->p_buffer,
-            (uint32_t*) &(output_stream_ptr->n_filled_len),
-            (uint32_t*) &(output_stream_ptr->n_alloc_len),
-            encode_context_ptr);
+            // Code the SPS
+            if (picture_control_set_ptr->parent_pcs_ptr->av1FrameType == KEY_FRAME) {
+                EncodeSPSAv1(
+                    picture_control_set_ptr->bitstreamPtr,
+                    sequence_control_set_ptr);
+            }
+
+#if TILES
+            if (picture_control_set_ptr->entropy_coding_tile_task_count > 1)
+                JoinEntropyCodingTiles(
+                    picture_control_set_ptr,
+                    encode_context_ptr);
+#endif
+
+            WriteFrameHeaderAv1(
+                picture_control_set_ptr->bitstreamPtr,
+                sequence_control_set_ptr,
+                picture_control_set_ptr,
+                0);
+
+            // Copy Slice Header to the Output Bitstream
+            CopyRbspBitstreamToPayload(
+                picture_control_set_ptr->bitstreamPtr,
+                output_stream_ptr->p_buffer,
+                (uint32_t*) &(output_stream_ptr->n_filled_len),
+                (uint32_t*) &(output_stream_ptr->n_alloc_len),
+                encode_context_ptr);
+        }
         if (picture_control_set_ptr->parent_pcs_ptr->hasShowExisting) {
             // Reset the bitstream before writing to it
             ResetBitstream(
@@ -212,7 +440,7 @@ void* PacketizationKernel(void *input_ptr)
         }
 
         // Send the number of bytes per frame to RC
-        picture_control_set_ptr->parent_pcs_ptr->total_num_bits = output_stream_ptr->n_filled_len << 3;
+        picture_control_set_ptr->parent_pcs_ptr->total_num_bits = (output_stream_ptr->n_filled_len + tile_output_size) << 3;
         queueEntryPtr->av1FrameType = picture_control_set_ptr->parent_pcs_ptr->av1FrameType;
         queueEntryPtr->poc = picture_control_set_ptr->picture_number;
         memcpy(&queueEntryPtr->av1RefSignal, &picture_control_set_ptr->parent_pcs_ptr->av1RefSignal, sizeof(Av1RpsNode_t));
@@ -420,9 +648,20 @@ void* PacketizationKernel(void *input_ptr)
 
             output_stream_ptr->n_tick_count = (uint32_t)latency;
             output_stream_ptr->p_app_private = queueEntryPtr->outMetaData;
-            eb_post_full_object(output_stream_wrapper_ptr);
+            eb_output_packet(
+                &sequence_control_set_ptr->static_config,
+                output_stream_wrapper_ptr);
             queueEntryPtr->outMetaData = (EbLinkedListNode *)EB_NULL;
 
+#if TILES
+            // The tile groups of the next picture in decode order can go out
+            if (sequence_control_set_ptr->static_config.low_latency_tile_output) {
+                eb_block_on_mutex(encode_context_ptr->tile_output_mutex);
+                encode_context_ptr->tile_output_decode_order++;
+                eb_release_mutex(encode_context_ptr->tile_output_mutex);
+            }
+#endif
+
             // Reset the Reorder Queue Entry
             queueEntryPtr->picture_number += PACKETIZATION_REORDER_QUEUE_MAX_DEPTH;
             queueEntryPtr->output_stream_wrapper_ptr = (EbObjectWrapper_t *)EB_NULL;
@@ -47,6 +47,21 @@ extern "C" {
 
 
 
+    // Hands a finished packet to the output callback, or queues it for eb_svt_get_packet
+    extern void eb_output_packet(
+        EbSvtAv1EncConfiguration *config,
+        EbObjectWrapper_t        *output_stream_wrapper_ptr);
+
+#if TILES
+    struct PictureControlSet_s;
+
+    // Low latency tile output: called by entropy coding once the tile tile_idx
+    //   of the picture is coded, before the picture is known to be complete
+    extern void eb_output_tile_group(
+        struct PictureControlSet_s *picture_control_set_ptr,
+        uint32_t                    tile_idx);
+#endif
+
     extern void* PacketizationKernel(void *input_ptr);
 #ifdef __cplusplus
 }
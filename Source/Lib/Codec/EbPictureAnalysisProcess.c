@@ -706,7 +706,7 @@ uint64_t ComputeVariance64x64(
 
 
     else {
-        if (asm_type == ASM_AVX2) {
+        if (asm_type >= ASM_AVX2) {
 
             compute_interm_var_four8x8_avx2_intrin(&(inputPaddedPicturePtr->buffer_y[blockIndex]), stride_y, &mean_of8x8_blocks[0], &meanOf8x8SquaredValuesBlocks[0]);
 
@@ -2332,7 +2332,7 @@ EbErrorType ComputeBlockMeanComputeVariance(
     else {
         const uint16_t stride_y = inputPaddedPicturePtr->stride_y;
 
-        if (asm_type == ASM_AVX2) {
+        if (asm_type >= ASM_AVX2) {
 
             compute_interm_var_four8x8_avx2_intrin(&(inputPaddedPicturePtr->buffer_y[blockIndex]), stride_y, &mean_of8x8_blocks[0], &meanOf8x8SquaredValuesBlocks[0]);
 
@@ -3178,8 +3178,12 @@ EbErrorType DenoiseInputPicture(
     return return_error;
 }
 
+/************************************************
+ * Noise detection of the SB rows [sb_row_start, sb_row_end)
+ ** The noise variance is summed in the picture, for
+ ** ClassifyInputPictureNoise() once all the rows are done
+ ************************************************/
 EbErrorType DetectInputPictureNoise(
-    PictureAnalysisContext_t    *context_ptr,
     SequenceControlSet_t        *sequence_control_set_ptr,
     PictureParentControlSet_t   *picture_control_set_ptr,
     uint32_t                       sb_total_count,
@@ -3187,15 +3191,18 @@ EbErrorType DetectInputPictureNoise(
     EbPictureBufferDesc_t       *noise_picture_ptr,
     EbPictureBufferDesc_t       *denoised_picture_ptr,
     uint32_t                     picture_width_in_sb,
+    uint32_t                     sb_row_start,
+    uint32_t                     sb_row_end,
     EbAsm                        asm_type)
 {
 
     EbErrorType                 return_error = EB_ErrorNone;
     uint32_t                    lcuCodingOrder;
+    uint32_t                    lcuEndCodingOrder = MIN(sb_row_end * picture_width_in_sb, sb_total_count);
 
     uint64_t                    picNoiseVariance;
 
-    uint32_t                    totLcuCount, noiseTh;
+    uint32_t                    totLcuCount;
 
     uint32_t                    sb_origin_x;
     uint32_t                    sb_origin_y;
@@ -3206,7 +3213,10 @@ EbErrorType DetectInputPictureNoise(
 
 
     //Variance calc for noise picture
-    for (lcuCodingOrder = 0; lcuCodingOrder < sb_total_count; ++lcuCodingOrder) {
+    for (lcuCodingOrder = sb_row_start * picture_width_in_sb; lcuCodingOrder < lcuEndCodingOrder; ++lcuCodingOrder) {
+
+        //Reset the flat noise flag array to False for both RealTime/HighComplexity Modes
+        picture_control_set_ptr->sb_flat_noise_array[lcuCodingOrder] = 0;
 
         sb_origin_x = (lcuCodingOrder % picture_width_in_sb) * sequence_control_set_ptr->sb_sz;
         sb_origin_y = (lcuCodingOrder / picture_width_in_sb) * sequence_control_set_ptr->sb_sz;
@@ -3271,6 +3281,28 @@ EbErrorType DetectInputPictureNoise(
 
     }
 
+    eb_block_on_mutex(picture_control_set_ptr->pa_segments_mutex);
+    picture_control_set_ptr->pa_noise_variance_sum += picNoiseVariance;
+    picture_control_set_ptr->pa_noise_sb_count += totLcuCount;
+    eb_release_mutex(picture_control_set_ptr->pa_segments_mutex);
+
+    return return_error;
+
+}
+
+/************************************************
+ * Noise class of the picture, from the noise variance
+ * summed by DetectInputPictureNoise()
+ ************************************************/
+void ClassifyInputPictureNoise(
+    PictureAnalysisContext_t    *context_ptr,
+    SequenceControlSet_t        *sequence_control_set_ptr,
+    PictureParentControlSet_t   *picture_control_set_ptr)
+{
+    uint64_t                    picNoiseVariance = picture_control_set_ptr->pa_noise_variance_sum;
+    uint32_t                    totLcuCount = picture_control_set_ptr->pa_noise_sb_count;
+    uint32_t                    noiseTh;
+
     context_ptr->picNoiseVarianceFloat = (double)picNoiseVariance / (double)totLcuCount;
 
     picNoiseVariance = picNoiseVariance / totLcuCount;
@@ -3308,24 +3340,44 @@ EbErrorType DetectInputPictureNoise(
     if (picture_control_set_ptr->pic_noise_class >= PIC_NOISE_CLASS_4)
         picture_control_set_ptr->pic_noise_class = PIC_NOISE_CLASS_3_1;
 
-    return return_error;
+    return;
 
 }
 
-static int32_t apply_denoise_2d(SequenceControlSet_t        *scsPtr,
-    PictureParentControlSet_t   *pcsPtr,
-    EbPictureBufferDesc_t *inputPicturePointer,
-    EbAsm asm_type) {
+/************************************************
+ * Film grain estimation of the SB rows [sb_row_start, sb_row_end):
+ ** flat blocks and denoising filter. The first segment
+ ** started prepares the estimation of the picture
+ ************************************************/
+void denoise_estimate_film_grain_segment(
+    SequenceControlSet_t        *sequence_control_set_ptr,
+    PictureParentControlSet_t   *picture_control_set_ptr,
+    uint32_t                     sb_row_start,
+    uint32_t                     sb_row_end,
+    EbAsm                        asm_type)
+{
+    EbPictureBufferDesc_t    *input_picture_ptr = picture_control_set_ptr->enhanced_picture_ptr;
+    const int32_t             use_highbd = sequence_control_set_ptr->static_config.encoder_bit_depth > EB_8BIT;
 
+    // The other segments wait for the preparation on the mutex
+    eb_block_on_mutex(picture_control_set_ptr->pa_segments_mutex);
+    if (picture_control_set_ptr->pa_segments_started_count++ == 0)
+        aom_denoise_and_model_prepare(picture_control_set_ptr->denoise_and_model, input_picture_ptr, use_highbd, asm_type);
+    eb_release_mutex(picture_control_set_ptr->pa_segments_mutex);
 
-    if (aom_denoise_and_model_run(pcsPtr->denoise_and_model, inputPicturePointer,
-        &pcsPtr->film_grain_params,
-        scsPtr->static_config.encoder_bit_depth > EB_8BIT, asm_type)) {
-    }
-    return 0;
+    aom_denoise_and_model_run_rows(
+        picture_control_set_ptr->denoise_and_model,
+        input_picture_ptr,
+        (int32_t)(sb_row_start * sequence_control_set_ptr->sb_sz),
+        (int32_t)MIN(sb_row_end * sequence_control_set_ptr->sb_sz, input_picture_ptr->height),
+        use_highbd);
 }
 
-
+/************************************************
+ * Film grain estimation of the picture, once all
+ ** the segments are done: noise model, grain
+ ** parameters and denoised input picture
+ ************************************************/
 EbErrorType denoise_estimate_film_grain(
     SequenceControlSet_t        *sequence_control_set_ptr,
     PictureParentControlSet_t   *picture_control_set_ptr,
@@ -3337,8 +3389,9 @@ EbErrorType denoise_estimate_film_grain(
     picture_control_set_ptr->film_grain_params.apply_grain = 0;
 
     if (sequence_control_set_ptr->film_grain_denoise_strength) {
-        if (apply_denoise_2d(sequence_control_set_ptr, picture_control_set_ptr, input_picture_ptr, asm_type) < 0)
-            return 1;
+        aom_denoise_and_model_finish(picture_control_set_ptr->denoise_and_model, input_picture_ptr,
+            &picture_control_set_ptr->film_grain_params,
+            sequence_control_set_ptr->static_config.encoder_bit_depth > EB_8BIT, asm_type);
     }
 
     sequence_control_set_ptr->film_grain_params_present |= picture_control_set_ptr->film_grain_params.apply_grain;
@@ -3354,24 +3407,17 @@ EbErrorType FullSampleDenoise(
     uint32_t                     sb_total_count,
     EbBool                       denoise_flag,
     uint32_t                     picture_width_in_sb,
+    uint32_t                     sb_row_start,
+    uint32_t                     sb_row_end,
     EbAsm                        asm_type){
 
     EbErrorType return_error = EB_ErrorNone;
 
-    uint32_t                     lcuCodingOrder;
     EbPictureBufferDesc_t    *input_picture_ptr = picture_control_set_ptr->enhanced_picture_ptr;
     EbPictureBufferDesc_t    *denoised_picture_ptr = context_ptr->denoised_picture_ptr;
     EbPictureBufferDesc_t    *noise_picture_ptr = context_ptr->noise_picture_ptr;
 
-    //Reset the flat noise flag array to False for both RealTime/HighComplexity Modes
-    for (lcuCodingOrder = 0; lcuCodingOrder < sb_total_count; ++lcuCodingOrder) {
-        picture_control_set_ptr->sb_flat_noise_array[lcuCodingOrder] = 0;
-    }
-
-    picture_control_set_ptr->pic_noise_class = PIC_NOISE_CLASS_INV; //this init is for both REAL-TIME and BEST-QUALITY
-
     DetectInputPictureNoise(
-        context_ptr,
         sequence_control_set_ptr,
         picture_control_set_ptr,
         sb_total_count,
@@ -3379,10 +3425,18 @@ EbErrorType FullSampleDenoise(
         noise_picture_ptr,
         denoised_picture_ptr,
         picture_width_in_sb,
+        sb_row_start,
+        sb_row_end,
         asm_type);
 
+    // A denoised picture is a single segment, classified here rather
+    //  than once all the segments are done
     if (denoise_flag == EB_TRUE)
     {
+        ClassifyInputPictureNoise(
+            context_ptr,
+            sequence_control_set_ptr,
+            picture_control_set_ptr);
 
         DenoiseInputPicture(
             context_ptr,
@@ -4031,20 +4085,16 @@ void PicturePreProcessingOperations(
     EbPictureBufferDesc_t           *sixteenth_decimated_picture_ptr,
     uint32_t                           sb_total_count,
     uint32_t                           picture_width_in_sb,
+    uint32_t                           sb_row_start,
+    uint32_t                           sb_row_end,
     EbAsm                           asm_type) {
 
     UNUSED(quarter_decimated_picture_ptr);
     UNUSED(sixteenth_decimated_picture_ptr);
     UNUSED(input_picture_ptr);
 
-    if (sequence_control_set_ptr->film_grain_denoise_strength) {
-
-        denoise_estimate_film_grain(
-            sequence_control_set_ptr,
-            picture_control_set_ptr,
-            asm_type);
-    }
-    else {
+    // With film grain, the denoising runs ahead of the analysis (see picture_analysis_kernel)
+    if (sequence_control_set_ptr->film_grain_denoise_strength == 0) {
 
         FullSampleDenoise(
             context_ptr,
@@ -4053,6 +4103,8 @@ void PicturePreProcessingOperations(
             sb_total_count,
             sequence_control_set_ptr->static_config.enable_denoise_flag,
             picture_width_in_sb,
+            sb_row_start,
+            sb_row_end,
             asm_type);
     }
     return;
@@ -4543,31 +4595,30 @@ void DetermineHomogeneousRegionInPicture(
     return;
 }
 /************************************************
- * ComputePictureSpatialStatistics
+ * ComputeSegmentSpatialStatistics
  ** Compute Block Variance
- ** Compute Picture Variance
- ** Compute Block Mean for all blocks in the picture
+ ** Compute Block Mean for all blocks in the SB rows
+ ** [sb_row_start, sb_row_end)
  ************************************************/
-void ComputePictureSpatialStatistics(
+void ComputeSegmentSpatialStatistics(
     SequenceControlSet_t            *sequence_control_set_ptr,
     PictureParentControlSet_t       *picture_control_set_ptr,
     EbPictureBufferDesc_t           *input_picture_ptr,
     EbPictureBufferDesc_t           *inputPaddedPicturePtr,
-    uint32_t                           sb_total_count,
+    uint32_t                           picture_width_in_sb,
+    uint32_t                           sb_row_start,
+    uint32_t                           sb_row_end,
     EbAsm                           asm_type)
 {
     uint32_t sb_index;
+    uint32_t sbEndIndex = MIN(sb_row_end * picture_width_in_sb, picture_control_set_ptr->sb_total_count);
     uint32_t sb_origin_x;        // to avoid using child PCS
     uint32_t sb_origin_y;
     uint32_t inputLumaOriginIndex;
     uint32_t inputCbOriginIndex;
     uint32_t inputCrOriginIndex;
-    uint64_t picTotVariance;
 
-    // Variance
-    picTotVariance = 0;
-
-    for (sb_index = 0; sb_index < picture_control_set_ptr->sb_total_count; ++sb_index) {
+    for (sb_index = sb_row_start * picture_width_in_sb; sb_index < sbEndIndex; ++sb_index) {
         SbParams_t   *sb_params = &sequence_control_set_ptr->sb_params_array[sb_index];
 
         sb_origin_x = sb_params->origin_x;
@@ -4602,9 +4653,29 @@ void ComputePictureSpatialStatistics(
                 picture_control_set_ptr,
                 sb_index);
         }
+    }
+
+    return;
+}
+
+/************************************************
+ * ComputePictureSpatialStatistics
+ ** Compute Picture Variance, once the block variances
+ ** of all the segments are computed
+ ************************************************/
+void ComputePictureSpatialStatistics(
+    SequenceControlSet_t            *sequence_control_set_ptr,
+    PictureParentControlSet_t       *picture_control_set_ptr,
+    uint32_t                           sb_total_count)
+{
+    uint32_t sb_index;
+    uint64_t picTotVariance;
 
+    // Variance
+    picTotVariance = 0;
+
+    for (sb_index = 0; sb_index < picture_control_set_ptr->sb_total_count; ++sb_index)
         picTotVariance += (picture_control_set_ptr->variance[sb_index][RASTER_SCAN_CU_INDEX_64x64]);
-    }
 
     picture_control_set_ptr->pic_avg_variance = (uint16_t)(picTotVariance / sb_total_count);
     // Calculate the variance of variance to determine Homogeneous regions. Note: Variance calculation should be on.
@@ -4674,13 +4745,12 @@ void CalculateInputAverageIntensity(
 /************************************************
  * Gathering statistics per picture
  ** Calculating the pixel intensity histogram bins per picture needed for SCD
- ** Computing Picture Variance
+ ** Computing Picture Variance from the block variances of the segments
  ************************************************/
 void GatheringPictureStatistics(
     SequenceControlSet_t            *sequence_control_set_ptr,
     PictureParentControlSet_t       *picture_control_set_ptr,
     EbPictureBufferDesc_t           *input_picture_ptr,
-    EbPictureBufferDesc_t           *inputPaddedPicturePtr,
     EbPictureBufferDesc_t            *sixteenthDecimatedPicturePtr,
     uint32_t                           sb_total_count,
     EbAsm                           asm_type)
@@ -4724,10 +4794,7 @@ void GatheringPictureStatistics(
     ComputePictureSpatialStatistics(
         sequence_control_set_ptr,
         picture_control_set_ptr,
-        input_picture_ptr,
-        inputPaddedPicturePtr,
-        sb_total_count,
-        asm_type);
+        sb_total_count);
 
     return;
 }
@@ -4799,32 +4866,41 @@ void PadPictureToMultipleOfMinCuSizeDimensions(
 /************************************************
  * Pad Picture at the right and bottom sides
  ** To complete border SB smaller than SB size
+ ** The rows [row_start, row_end) are padded, the top and
+ ** bottom borders with the first and last rows
  ************************************************/
 void PadPictureToMultipleOfLcuDimensions(
-    EbPictureBufferDesc_t           *inputPaddedPicturePtr
+    EbPictureBufferDesc_t           *inputPaddedPicturePtr,
+    uint32_t                         row_start,
+    uint32_t                         row_end
 )
 {
 
     // Generate Padding
-    generate_padding(
+    generate_padding_rows(
         &inputPaddedPicturePtr->buffer_y[0],
         inputPaddedPicturePtr->stride_y,
         inputPaddedPicturePtr->width,
         inputPaddedPicturePtr->height,
         inputPaddedPicturePtr->origin_x,
-        inputPaddedPicturePtr->origin_y);
+        inputPaddedPicturePtr->origin_y,
+        row_start,
+        row_end);
 
     return;
 }
 
 /************************************************
-* 1/4 & 1/16 input picture decimation
+* 1/4 & 1/16 input picture decimation of the rows
+* [row_start, row_end), multiples of 4 but for the last one
 ************************************************/
 void DecimateInputPicture(
     PictureParentControlSet_t       *picture_control_set_ptr,
     EbPictureBufferDesc_t           *inputPaddedPicturePtr,
     EbPictureBufferDesc_t           *quarterDecimatedPicturePtr,
-    EbPictureBufferDesc_t           *sixteenthDecimatedPicturePtr) {
+    EbPictureBufferDesc_t           *sixteenthDecimatedPicturePtr,
+    uint32_t                         row_start,
+    uint32_t                         row_end) {
 
 
     // Decimate input picture for HME L0 and L1
@@ -4832,13 +4908,43 @@ void DecimateInputPicture(
 
         if (picture_control_set_ptr->enable_hme_level1_flag) {
             Decimation2D(
-                &inputPaddedPicturePtr->buffer_y[inputPaddedPicturePtr->origin_x + inputPaddedPicturePtr->origin_y * inputPaddedPicturePtr->stride_y],
+                &inputPaddedPicturePtr->buffer_y[inputPaddedPicturePtr->origin_x + (inputPaddedPicturePtr->origin_y + row_start) * inputPaddedPicturePtr->stride_y],
                 inputPaddedPicturePtr->stride_y,
                 inputPaddedPicturePtr->width,
-                inputPaddedPicturePtr->height,
-                &quarterDecimatedPicturePtr->buffer_y[quarterDecimatedPicturePtr->origin_x + quarterDecimatedPicturePtr->origin_x*quarterDecimatedPicturePtr->stride_y],
+                row_end - row_start,
+                &quarterDecimatedPicturePtr->buffer_y[quarterDecimatedPicturePtr->origin_x + (quarterDecimatedPicturePtr->origin_x + (row_start >> 1))*quarterDecimatedPicturePtr->stride_y],
                 quarterDecimatedPicturePtr->stride_y,
                 2);
+        }
+
+        if (picture_control_set_ptr->enable_hme_level0_flag) {
+
+            // Sixteenth Input Picture Decimation
+            Decimation2D(
+                &inputPaddedPicturePtr->buffer_y[inputPaddedPicturePtr->origin_x + (inputPaddedPicturePtr->origin_y + row_start) * inputPaddedPicturePtr->stride_y],
+                inputPaddedPicturePtr->stride_y,
+                inputPaddedPicturePtr->width,
+                row_end - row_start,
+                &sixteenthDecimatedPicturePtr->buffer_y[sixteenthDecimatedPicturePtr->origin_x + (sixteenthDecimatedPicturePtr->origin_x + (row_start >> 2))*sixteenthDecimatedPicturePtr->stride_y],
+                sixteenthDecimatedPicturePtr->stride_y,
+                4);
+        }
+    }
+}
+
+/************************************************
+* 1/4 & 1/16 decimated pictures padding, once all
+* their rows are decimated
+************************************************/
+void PadDecimatedInputPicture(
+    PictureParentControlSet_t       *picture_control_set_ptr,
+    EbPictureBufferDesc_t           *quarterDecimatedPicturePtr,
+    EbPictureBufferDesc_t           *sixteenthDecimatedPicturePtr) {
+
+
+    if (picture_control_set_ptr->enable_hme_flag) {
+
+        if (picture_control_set_ptr->enable_hme_level1_flag) {
             generate_padding(
                 &quarterDecimatedPicturePtr->buffer_y[0],
                 quarterDecimatedPicturePtr->stride_y,
@@ -4851,16 +4957,6 @@ void DecimateInputPicture(
 
         if (picture_control_set_ptr->enable_hme_level0_flag) {
 
-            // Sixteenth Input Picture Decimation
-            Decimation2D(
-                &inputPaddedPicturePtr->buffer_y[inputPaddedPicturePtr->origin_x + inputPaddedPicturePtr->origin_y * inputPaddedPicturePtr->stride_y],
-                inputPaddedPicturePtr->stride_y,
-                inputPaddedPicturePtr->width,
-                inputPaddedPicturePtr->height,
-                &sixteenthDecimatedPicturePtr->buffer_y[sixteenthDecimatedPicturePtr->origin_x + sixteenthDecimatedPicturePtr->origin_x*sixteenthDecimatedPicturePtr->stride_y],
-                sixteenthDecimatedPicturePtr->stride_y,
-                4);
-
             generate_padding(
                 &sixteenthDecimatedPicturePtr->buffer_y[0],
                 sixteenthDecimatedPicturePtr->stride_y,
@@ -4873,6 +4969,73 @@ void DecimateInputPicture(
     }
 }
 
+/************************************************
+ * Picture Analysis Segment
+ ** Analysis of the SB rows [sb_row_start, sb_row_end):
+ ** noise detection, padding, decimation and block
+ ** statistics, which only read the rows of the segment
+ ** (and the row on each side for the noise filter)
+ ************************************************/
+void PictureAnalysisSegment(
+    PictureAnalysisContext_t        *context_ptr,
+    SequenceControlSet_t            *sequence_control_set_ptr,
+    PictureParentControlSet_t       *picture_control_set_ptr,
+    EbPictureBufferDesc_t           *input_picture_ptr,
+    EbPictureBufferDesc_t           *inputPaddedPicturePtr,
+    EbPictureBufferDesc_t           *quarterDecimatedPicturePtr,
+    EbPictureBufferDesc_t           *sixteenthDecimatedPicturePtr,
+    uint32_t                         sb_total_count,
+    uint32_t                         picture_width_in_sb,
+    uint32_t                         sb_row_start,
+    uint32_t                         sb_row_end,
+    EbAsm                            asm_type)
+{
+    const uint32_t rowStart = sb_row_start * sequence_control_set_ptr->sb_sz;
+    const uint32_t rowEnd = MIN(sb_row_end * sequence_control_set_ptr->sb_sz, inputPaddedPicturePtr->height);
+
+    // Pre processing operations performed on the input picture
+    PicturePreProcessingOperations(
+        picture_control_set_ptr,
+        input_picture_ptr,
+        context_ptr,
+        sequence_control_set_ptr,
+        quarterDecimatedPicturePtr,
+        sixteenthDecimatedPicturePtr,
+        sb_total_count,
+        picture_width_in_sb,
+        sb_row_start,
+        sb_row_end,
+        asm_type);
+
+    // Pad input picture to complete border LCUs
+    PadPictureToMultipleOfLcuDimensions(
+        inputPaddedPicturePtr,
+        rowStart,
+        rowEnd);
+
+    // 1/4 & 1/16 input picture decimation
+    DecimateInputPicture(
+        picture_control_set_ptr,
+        inputPaddedPicturePtr,
+        quarterDecimatedPicturePtr,
+        sixteenthDecimatedPicturePtr,
+        rowStart,
+        rowEnd);
+
+    // Variance and mean of the blocks
+    ComputeSegmentSpatialStatistics(
+        sequence_control_set_ptr,
+        picture_control_set_ptr,
+        input_picture_ptr,
+        inputPaddedPicturePtr,
+        picture_width_in_sb,
+        sb_row_start,
+        sb_row_end,
+        asm_type);
+
+    return;
+}
+
 /************************************************
  * Picture Analysis Kernel
  * The Picture Analysis Process pads & decimates the input pictures.
@@ -4881,6 +5044,10 @@ void DecimateInputPicture(
  * which are used to compute variance.
  * The Picture Analysis process is multithreaded, so pictures can be
  * processed out of order as long as all inputs are available.
+ * A picture is split in segments of SB rows, the thread completing
+ * the last segment of a picture gathers the picture statistics and
+ * passes the picture on. With film grain, the segments only run the
+ * grain estimation, and the last one analyses the denoised picture.
  ************************************************/
 void* picture_analysis_kernel(void *input_ptr)
 {
@@ -4893,6 +5060,7 @@ void* picture_analysis_kernel(void *input_ptr)
     EbObjectWrapper_t               *outputResultsWrapperPtr;
     PictureAnalysisResults_t        *outputResultsPtr;
     EbPaReferenceObject_t           *paReferenceObject;
+    EbObjectWrapper_t               *pictureControlSetWrapperPtr;
 
     EbPictureBufferDesc_t           *inputPaddedPicturePtr;
     EbPictureBufferDesc_t           *quarterDecimatedPicturePtr;
@@ -4905,6 +5073,10 @@ void* picture_analysis_kernel(void *input_ptr)
     uint32_t                          sb_total_count;
     EbAsm                          asm_type;
 
+    // Segments
+    uint32_t                          segment_index;
+    EbBool                            lastSegment;
+
     for (;;) {
 
         // Get Input Full Object
@@ -4913,10 +5085,15 @@ void* picture_analysis_kernel(void *input_ptr)
             &inputResultsWrapperPtr);
 
         inputResultsPtr = (ResourceCoordinationResults_t*)inputResultsWrapperPtr->object_ptr;
-        picture_control_set_ptr = (PictureParentControlSet_t*)inputResultsPtr->pictureControlSetWrapperPtr->object_ptr;
+        pictureControlSetWrapperPtr = inputResultsPtr->pictureControlSetWrapperPtr;
+        segment_index = inputResultsPtr->segment_index;
+        picture_control_set_ptr = (PictureParentControlSet_t*)pictureControlSetWrapperPtr->object_ptr;
         sequence_control_set_ptr = (SequenceControlSet_t*)picture_control_set_ptr->sequence_control_set_wrapper_ptr->object_ptr;
         input_picture_ptr = picture_control_set_ptr->enhanced_picture_ptr;
 
+        // Release the Input Results
+        eb_release_object(inputResultsWrapperPtr);
+
         paReferenceObject = (EbPaReferenceObject_t*)picture_control_set_ptr->pa_reference_picture_wrapper_ptr->object_ptr;
         inputPaddedPicturePtr = (EbPictureBufferDesc_t*)paReferenceObject->inputPaddedPicturePtr;
         quarterDecimatedPicturePtr = (EbPictureBufferDesc_t*)paReferenceObject->quarterDecimatedPicturePtr;
@@ -4929,44 +5106,83 @@ void* picture_analysis_kernel(void *input_ptr)
 
         asm_type = sequence_control_set_ptr->encode_context_ptr->asm_type;
 
-        // Set picture parameters to account for subpicture, picture scantype, and set regions by resolutions
-        SetPictureParametersForStatisticsGathering(
-            sequence_control_set_ptr);
+        if (sequence_control_set_ptr->film_grain_denoise_strength) {
+            // The analysis of the picture waits for the denoised picture
+            denoise_estimate_film_grain_segment(
+                sequence_control_set_ptr,
+                picture_control_set_ptr,
+                SEGMENT_START_IDX(segment_index, pictureHeighInLcu, picture_control_set_ptr->pa_segments_total_count),
+                SEGMENT_END_IDX(segment_index, pictureHeighInLcu, picture_control_set_ptr->pa_segments_total_count),
+                asm_type);
+        }
+        else {
+            PictureAnalysisSegment(
+                context_ptr,
+                sequence_control_set_ptr,
+                picture_control_set_ptr,
+                input_picture_ptr,
+                inputPaddedPicturePtr,
+                quarterDecimatedPicturePtr,
+                sixteenthDecimatedPicturePtr,
+                sb_total_count,
+                picture_width_in_sb,
+                SEGMENT_START_IDX(segment_index, pictureHeighInLcu, picture_control_set_ptr->pa_segments_total_count),
+                SEGMENT_END_IDX(segment_index, pictureHeighInLcu, picture_control_set_ptr->pa_segments_total_count),
+                asm_type);
+        }
 
-        // Pad pictures to multiple min cu size
-        PadPictureToMultipleOfMinCuSizeDimensions(
-            sequence_control_set_ptr,
-            input_picture_ptr);
+        eb_block_on_mutex(picture_control_set_ptr->pa_segments_mutex);
+        lastSegment = (++picture_control_set_ptr->pa_segments_completed_count == picture_control_set_ptr->pa_segments_total_count) ? EB_TRUE : EB_FALSE;
+        eb_release_mutex(picture_control_set_ptr->pa_segments_mutex);
 
-        // Pre processing operations performed on the input picture
-        PicturePreProcessingOperations(
-            picture_control_set_ptr,
-            input_picture_ptr,
-            context_ptr,
-            sequence_control_set_ptr,
-            quarterDecimatedPicturePtr,
-            sixteenthDecimatedPicturePtr,
-            sb_total_count,
-            picture_width_in_sb,
-            asm_type);
+        // The other segments of the picture are still in progress
+        if (lastSegment == EB_FALSE)
+            continue;
 
-        // Pad input picture to complete border LCUs
-        PadPictureToMultipleOfLcuDimensions(
-            inputPaddedPicturePtr);
+        if (sequence_control_set_ptr->film_grain_denoise_strength) {
+            // Grain parameters and denoised picture, then the analysis of the whole picture
+            denoise_estimate_film_grain(
+                sequence_control_set_ptr,
+                picture_control_set_ptr,
+                asm_type);
+
+            PictureAnalysisSegment(
+                context_ptr,
+                sequence_control_set_ptr,
+                picture_control_set_ptr,
+                input_picture_ptr,
+                inputPaddedPicturePtr,
+                quarterDecimatedPicturePtr,
+                sixteenthDecimatedPicturePtr,
+                sb_total_count,
+                picture_width_in_sb,
+                0,
+                pictureHeighInLcu,
+                asm_type);
+        }
 
-        // 1/4 & 1/16 input picture decimation
-        DecimateInputPicture(
+        // Noise class, from the noise of all the segments
+        if (sequence_control_set_ptr->film_grain_denoise_strength == 0 && sequence_control_set_ptr->static_config.enable_denoise_flag == EB_FALSE) {
+            ClassifyInputPictureNoise(
+                context_ptr,
+                sequence_control_set_ptr,
+                picture_control_set_ptr);
+        }
+
+        PadDecimatedInputPicture(
             picture_control_set_ptr,
-            inputPaddedPicturePtr,
             quarterDecimatedPicturePtr,
             sixteenthDecimatedPicturePtr);
 
+        // Set picture parameters to account for subpicture, picture scantype, and set regions by resolutions
+        SetPictureParametersForStatisticsGathering(
+            sequence_control_set_ptr);
+
         // Gathering statistics of input picture, including Variance Calculation, Histogram Bins
         GatheringPictureStatistics(
             sequence_control_set_ptr,
             picture_control_set_ptr,
             input_picture_ptr,
-            inputPaddedPicturePtr,
             sixteenthDecimatedPicturePtr,
             sb_total_count,
             asm_type);
@@ -4986,10 +5202,7 @@ void* picture_analysis_kernel(void *input_ptr)
             &outputResultsWrapperPtr);
 
         outputResultsPtr = (PictureAnalysisResults_t*)outputResultsWrapperPtr->object_ptr;
-        outputResultsPtr->pictureControlSetWrapperPtr = inputResultsPtr->pictureControlSetWrapperPtr;
-
-        // Release the Input Results
-        eb_release_object(inputResultsWrapperPtr);
+        outputResultsPtr->pictureControlSetWrapperPtr = pictureControlSetWrapperPtr;
 
         // Post the Full Results Object
         eb_post_full_object(outputResultsWrapperPtr);
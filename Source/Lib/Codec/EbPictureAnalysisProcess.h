@@ -8,6 +8,7 @@
 
 #include "EbDefinitions.h"
 #include "EbSystemResourceManager.h"
+#include "EbSequenceControlSet.h"
 #include "EbNoiseExtractAVX2.h"
 
 /**************************************
@@ -35,6 +36,12 @@ extern EbErrorType picture_analysis_context_ctor(
 
 extern void* picture_analysis_kernel(void *input_ptr);
 
+// Run by Resource Coordination before the picture is split in PA segments,
+//  as the noise filter of a segment reads the rows of its neighbours
+extern void PadPictureToMultipleOfMinCuSizeDimensions(
+    SequenceControlSet_t          *sequence_control_set_ptr,
+    EbPictureBufferDesc_t         *input_picture_ptr);
+
 void noise_extract_luma_weak(
     EbPictureBufferDesc_t *input_picture_ptr,
     EbPictureBufferDesc_t *denoised_picture_ptr,
@@ -55,6 +62,8 @@ static EB_WEAKLUMAFILTER_TYPE FUNC_TABLE weak_luma_filter_func_ptr_array[ASM_TYP
     noise_extract_luma_weak,
     // AVX2
     noise_extract_luma_weak_avx2_intrin,
+    // AVX512
+    noise_extract_luma_weak_avx2_intrin,
 
 };
 
@@ -71,6 +80,8 @@ static EB_WEAKLUMAFILTER_TYPE FUNC_TABLE weak_luma_filter_lcu_func_ptr_array[ASM
     noise_extract_luma_weak_lcu,
     // AVX2
     noise_extract_luma_weak_lcu_avx2_intrin,
+    // AVX512
+    noise_extract_luma_weak_lcu_avx2_intrin,
 
 };
 
@@ -93,6 +104,8 @@ static EB_STRONGLUMAFILTER_TYPE FUNC_TABLE strong_luma_filter_func_ptr_array[ASM
     noise_extract_luma_strong,
     // AVX2
     noise_extract_luma_strong_avx2_intrin,
+    // AVX512
+    noise_extract_luma_strong_avx2_intrin,
 
 };
 void noise_extract_chroma_strong(
@@ -113,6 +126,8 @@ static EB_STRONGCHROMAFILTER_TYPE FUNC_TABLE strong_chroma_filter_func_ptr_array
     noise_extract_chroma_strong,
     // AVX2
     noise_extract_chroma_strong_avx2_intrin,
+    // AVX512
+    noise_extract_chroma_strong_avx2_intrin,
 
 };
 
@@ -134,6 +149,8 @@ static EB_WEAKCHROMAFILTER_TYPE FUNC_TABLE weak_chroma_filter_func_ptr_array[ASM
     noise_extract_chroma_weak,
     // AVX2
     noise_extract_chroma_weak_avx2_intrin,
+    // AVX512
+    noise_extract_chroma_weak_avx2_intrin,
 
 };
 
@@ -71,7 +71,7 @@ EbErrorType eb_picture_buffer_desc_ctor(
 
     // Allocate the Picture Buffers (luma & chroma)
     if (pictureBufferDescInitDataPtr->bufferEnableMask & PICTURE_BUFFER_DESC_Y_FLAG) {
-        EB_ALLIGN_MALLOC(EbByte, pictureBufferDescPtr->buffer_y, pictureBufferDescPtr->lumaSize      * bytesPerPixel * sizeof(uint8_t), EB_A_PTR);
+        EB_CALLOC_ALIGNED(EbByte, pictureBufferDescPtr->buffer_y, pictureBufferDescPtr->lumaSize      * bytesPerPixel * sizeof(uint8_t));
         //pictureBufferDescPtr->buffer_y = (EbByte) EB_aligned_malloc( pictureBufferDescPtr->lumaSize      * bytesPerPixel * sizeof(uint8_t),ALVALUE);
         pictureBufferDescPtr->bufferBitIncY = 0;
         if (pictureBufferDescInitDataPtr->splitMode == EB_TRUE) {
@@ -79,8 +79,6 @@ EbErrorType eb_picture_buffer_desc_ctor(
             //pictureBufferDescPtr->bufferBitIncY = (EbByte) EB_aligned_malloc( pictureBufferDescPtr->lumaSize      * bytesPerPixel * sizeof(uint8_t),ALVALUE);
         }
 
-        memset(pictureBufferDescPtr->buffer_y, 0, pictureBufferDescPtr->lumaSize * bytesPerPixel * sizeof(uint8_t));
-
     }
     else {
         pictureBufferDescPtr->buffer_y = 0;
@@ -88,7 +86,7 @@ EbErrorType eb_picture_buffer_desc_ctor(
     }
 
     if (pictureBufferDescInitDataPtr->bufferEnableMask & PICTURE_BUFFER_DESC_Cb_FLAG) {
-        EB_ALLIGN_MALLOC(EbByte, pictureBufferDescPtr->bufferCb, pictureBufferDescPtr->chromaSize    * bytesPerPixel * sizeof(uint8_t), EB_A_PTR);
+        EB_CALLOC_ALIGNED(EbByte, pictureBufferDescPtr->bufferCb, pictureBufferDescPtr->chromaSize    * bytesPerPixel * sizeof(uint8_t));
         //pictureBufferDescPtr->bufferCb = (EbByte) EB_aligned_malloc(pictureBufferDescPtr->chromaSize    * bytesPerPixel * sizeof(uint8_t),ALVALUE);
         pictureBufferDescPtr->bufferBitIncCb = 0;
         if (pictureBufferDescInitDataPtr->splitMode == EB_TRUE) {
@@ -96,8 +94,6 @@ EbErrorType eb_picture_buffer_desc_ctor(
             //pictureBufferDescPtr->bufferBitIncCb = (EbByte) EB_aligned_malloc(pictureBufferDescPtr->chromaSize    * bytesPerPixel * sizeof(uint8_t),ALVALUE);
         }
 
-        memset(pictureBufferDescPtr->bufferCb, 0, pictureBufferDescPtr->chromaSize * bytesPerPixel * sizeof(uint8_t));
-
     }
     else {
         pictureBufferDescPtr->bufferCb = 0;
@@ -105,7 +101,7 @@ EbErrorType eb_picture_buffer_desc_ctor(
     }
 
     if (pictureBufferDescInitDataPtr->bufferEnableMask & PICTURE_BUFFER_DESC_Cr_FLAG) {
-        EB_ALLIGN_MALLOC(EbByte, pictureBufferDescPtr->bufferCr, pictureBufferDescPtr->chromaSize    * bytesPerPixel * sizeof(uint8_t), EB_A_PTR);
+        EB_CALLOC_ALIGNED(EbByte, pictureBufferDescPtr->bufferCr, pictureBufferDescPtr->chromaSize    * bytesPerPixel * sizeof(uint8_t));
         //pictureBufferDescPtr->bufferCr = (EbByte) EB_aligned_malloc(pictureBufferDescPtr->chromaSize    * bytesPerPixel * sizeof(uint8_t),ALVALUE);
         pictureBufferDescPtr->bufferBitIncCr = 0;
         if (pictureBufferDescInitDataPtr->splitMode == EB_TRUE) {
@@ -113,8 +109,6 @@ EbErrorType eb_picture_buffer_desc_ctor(
             //pictureBufferDescPtr->bufferBitIncCr = (EbByte) EB_aligned_malloc(pictureBufferDescPtr->chromaSize    * bytesPerPixel * sizeof(uint8_t),ALVALUE);
         }
 
-        memset(pictureBufferDescPtr->bufferCr, 0, pictureBufferDescPtr->chromaSize * bytesPerPixel * sizeof(uint8_t));
-
     }
     else {
         pictureBufferDescPtr->bufferCr = 0;
@@ -168,8 +162,7 @@ EbErrorType eb_recon_picture_buffer_desc_ctor(
     // Allocate the Picture Buffers (luma & chroma)
     if (pictureBufferDescInitDataPtr->bufferEnableMask & PICTURE_BUFFER_DESC_Y_FLAG) {
 
-        EB_ALLIGN_MALLOC(EbByte, pictureBufferDescPtr->buffer_y, pictureBufferDescPtr->lumaSize * bytesPerPixel, EB_A_PTR);
-        memset(pictureBufferDescPtr->buffer_y, 0, pictureBufferDescPtr->lumaSize      * bytesPerPixel);
+        EB_CALLOC_ALIGNED(EbByte, pictureBufferDescPtr->buffer_y, pictureBufferDescPtr->lumaSize * bytesPerPixel);
 
     }
     else {
@@ -178,8 +171,7 @@ EbErrorType eb_recon_picture_buffer_desc_ctor(
 
     if (pictureBufferDescInitDataPtr->bufferEnableMask & PICTURE_BUFFER_DESC_Cb_FLAG) {
 
-        EB_ALLIGN_MALLOC(EbByte, pictureBufferDescPtr->bufferCb, pictureBufferDescPtr->chromaSize * bytesPerPixel, EB_A_PTR);
-        memset(pictureBufferDescPtr->bufferCb, 0, pictureBufferDescPtr->chromaSize      * bytesPerPixel);
+        EB_CALLOC_ALIGNED(EbByte, pictureBufferDescPtr->bufferCb, pictureBufferDescPtr->chromaSize * bytesPerPixel);
 
     }
     else {
@@ -188,8 +180,7 @@ EbErrorType eb_recon_picture_buffer_desc_ctor(
 
     if (pictureBufferDescInitDataPtr->bufferEnableMask & PICTURE_BUFFER_DESC_Cr_FLAG) {
 
-        EB_ALLIGN_MALLOC(EbByte, pictureBufferDescPtr->bufferCr, pictureBufferDescPtr->chromaSize * bytesPerPixel, EB_A_PTR);
-        memset(pictureBufferDescPtr->bufferCr, 0, pictureBufferDescPtr->chromaSize      * bytesPerPixel);
+        EB_CALLOC_ALIGNED(EbByte, pictureBufferDescPtr->bufferCr, pictureBufferDescPtr->chromaSize * bytesPerPixel);
 
     }
     else {
@@ -48,6 +48,183 @@ static void set_restoration_unit_size(int32_t width, int32_t height, int32_t sx,
 }
 
 
+/******************************************************
+ * Entropy Coding Tile Constructor
+ *   The neighbor arrays are indexed with picture
+ *   coordinates, so they span the picture whatever the
+ *   tile.
+ ******************************************************/
+static EbErrorType entropy_coding_tile_ctor(
+    EntropyCodingTile_t **tile_dbl_ptr,
+    uint32_t              buffer_size,
+    uint32_t              picture_width,
+    uint32_t              picture_height)
+{
+    EbErrorType          return_error;
+    EntropyCodingTile_t *tile_ptr;
+    EB_MALLOC(EntropyCodingTile_t*, tile_ptr, sizeof(EntropyCodingTile_t), EB_N_PTR);
+    *tile_dbl_ptr = tile_ptr;
+
+    // Entropy Coder
+    return_error = EntropyCoderCtor(
+        &tile_ptr->entropy_coder_ptr,
+        buffer_size);
+
+    if (return_error == EB_ErrorInsufficientResources) {
+        return EB_ErrorInsufficientResources;
+    }
+
+    // Entropy Coding Neighbor Arrays
+    return_error = neighbor_array_unit_ctor(
+        &tile_ptr->mode_type_neighbor_array,
+        picture_width,
+        picture_height,
+        sizeof(uint8_t),
+        PU_NEIGHBOR_ARRAY_GRANULARITY,
+        PU_NEIGHBOR_ARRAY_GRANULARITY,
+        NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK);
+
+    if (return_error == EB_ErrorInsufficientResources) {
+        return EB_ErrorInsufficientResources;
+    }
+
+    return_error = neighbor_array_unit_ctor(
+        &tile_ptr->partition_context_neighbor_array,
+        picture_width,
+        picture_height,
+        sizeof(struct PartitionContext),
+        PU_NEIGHBOR_ARRAY_GRANULARITY,
+        PU_NEIGHBOR_ARRAY_GRANULARITY,
+        NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK);
+
+    if (return_error == EB_ErrorInsufficientResources) {
+        return EB_ErrorInsufficientResources;
+    }
+
+    return_error = neighbor_array_unit_ctor(
+        &tile_ptr->skip_flag_neighbor_array,
+        picture_width,
+        picture_height,
+        sizeof(uint8_t),
+        PU_NEIGHBOR_ARRAY_GRANULARITY,
+        PU_NEIGHBOR_ARRAY_GRANULARITY,
+        NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK);
+
+    if (return_error == EB_ErrorInsufficientResources) {
+        return EB_ErrorInsufficientResources;
+    }
+
+    return_error = neighbor_array_unit_ctor(
+        &tile_ptr->skip_coeff_neighbor_array,
+        picture_width,
+        picture_height,
+        sizeof(uint8_t),
+        PU_NEIGHBOR_ARRAY_GRANULARITY,
+        PU_NEIGHBOR_ARRAY_GRANULARITY,
+        NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK);
+
+    if (return_error == EB_ErrorInsufficientResources) {
+        return EB_ErrorInsufficientResources;
+    }
+    // for each 4x4
+    return_error = neighbor_array_unit_ctor(
+        &tile_ptr->luma_dc_sign_level_coeff_neighbor_array,
+        picture_width,
+        picture_height,
+        sizeof(uint8_t),
+        PU_NEIGHBOR_ARRAY_GRANULARITY,
+        PU_NEIGHBOR_ARRAY_GRANULARITY,
+        NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK);
+
+    if (return_error == EB_ErrorInsufficientResources) {
+        return EB_ErrorInsufficientResources;
+    }
+    // for each 4x4
+    return_error = neighbor_array_unit_ctor(
+        &tile_ptr->cr_dc_sign_level_coeff_neighbor_array,
+        picture_width,
+        picture_height,
+        sizeof(uint8_t),
+        PU_NEIGHBOR_ARRAY_GRANULARITY,
+        PU_NEIGHBOR_ARRAY_GRANULARITY,
+        NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK);
+
+    if (return_error == EB_ErrorInsufficientResources) {
+        return EB_ErrorInsufficientResources;
+    }
+    // for each 4x4
+    return_error = neighbor_array_unit_ctor(
+        &tile_ptr->cb_dc_sign_level_coeff_neighbor_array,
+        picture_width,
+        picture_height,
+        sizeof(uint8_t),
+        PU_NEIGHBOR_ARRAY_GRANULARITY,
+        PU_NEIGHBOR_ARRAY_GRANULARITY,
+        NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK);
+
+    if (return_error == EB_ErrorInsufficientResources) {
+        return EB_ErrorInsufficientResources;
+    }
+
+    return_error = neighbor_array_unit_ctor(
+        &tile_ptr->inter_pred_dir_neighbor_array,
+        picture_width,
+        picture_height,
+        sizeof(uint8_t),
+        PU_NEIGHBOR_ARRAY_GRANULARITY,
+        PU_NEIGHBOR_ARRAY_GRANULARITY,
+        NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK);
+
+    if (return_error == EB_ErrorInsufficientResources) {
+        return EB_ErrorInsufficientResources;
+    }
+
+    return_error = neighbor_array_unit_ctor(
+        &tile_ptr->ref_frame_type_neighbor_array,
+        picture_width,
+        picture_height,
+        sizeof(uint8_t),
+        PU_NEIGHBOR_ARRAY_GRANULARITY,
+        PU_NEIGHBOR_ARRAY_GRANULARITY,
+        NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK);
+
+    if (return_error == EB_ErrorInsufficientResources) {
+        return EB_ErrorInsufficientResources;
+    }
+
+    return_error = neighbor_array_unit_ctor32(
+        &tile_ptr->interpolation_type_neighbor_array,
+        picture_width,
+        picture_height,
+        sizeof(uint32_t),
+        PU_NEIGHBOR_ARRAY_GRANULARITY,
+        PU_NEIGHBOR_ARRAY_GRANULARITY,
+        NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK);
+
+    if (return_error == EB_ErrorInsufficientResources) {
+        return EB_ErrorInsufficientResources;
+    }
+
+
+
+    return_error = neighbor_array_unit_ctor(
+        &tile_ptr->intra_luma_mode_neighbor_array,
+        picture_width,
+        picture_height,
+        sizeof(uint8_t),
+        PU_NEIGHBOR_ARRAY_GRANULARITY,
+        PU_NEIGHBOR_ARRAY_GRANULARITY,
+        NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK);
+    if (return_error == EB_ErrorInsufficientResources) {
+        return EB_ErrorInsufficientResources;
+    }
+
+    tile_ptr->quantized_coeff_num_bits = 0;
+    tile_ptr->tile_coded = EB_FALSE;
+
+    return EB_ErrorNone;
+}
+
 EbErrorType picture_control_set_ctor(
     EbPtr *object_dbl_ptr,
     EbPtr object_init_data_ptr)
@@ -67,6 +244,7 @@ EbErrorType picture_control_set_ctor(
     uint16_t sb_index;
     uint16_t sb_origin_x;
     uint16_t sb_origin_y;
+    uint32_t tileIndex;
     EbErrorType return_error = EB_ErrorNone;
 
     EbBool is16bit = initDataPtr->is16bit;
@@ -170,15 +348,6 @@ EbErrorType picture_control_set_ctor(
     }
 
 
-    // Entropy Coder
-    return_error = EntropyCoderCtor(
-        &object_ptr->entropy_coder_ptr,
-        SEGMENT_ENTROPY_BUFFER_SIZE);
-
-    if (return_error == EB_ErrorInsufficientResources) {
-        return EB_ErrorInsufficientResources;
-    }
-
     // Packetization process Bitstream
     return_error = BitstreamCtor(
         &object_ptr->bitstreamPtr,
@@ -210,10 +379,19 @@ EbErrorType picture_control_set_ctor(
     const uint16_t picture_sb_h   = (uint16_t)((initDataPtr->picture_height + initDataPtr->sb_size_pix - 1) / initDataPtr->sb_size_pix);
     const uint16_t all_sb = picture_sb_w * picture_sb_h;
 
+    return_error = largest_coding_unit_arena_ctor(
+        &object_ptr->sb_arena,
+        (uint8_t)initDataPtr->sb_size_pix,
+        all_sb);
+    if (return_error == EB_ErrorInsufficientResources) {
+        return EB_ErrorInsufficientResources;
+    }
+
     for (sb_index = 0; sb_index < all_sb; ++sb_index) {
 
         return_error = largest_coding_unit_ctor(
             &(object_ptr->sb_ptr_array[sb_index]),
+            &object_ptr->sb_arena,
             (uint8_t)initDataPtr->sb_size_pix,
             (uint16_t)(sb_origin_x * maxCuSize),
             (uint16_t)(sb_origin_y * maxCuSize),
@@ -681,146 +859,34 @@ EbErrorType picture_control_set_ctor(
     if (return_error == EB_ErrorInsufficientResources) {
         return EB_ErrorInsufficientResources;
     }
-    // Entropy Coding Neighbor Arrays
-    return_error = neighbor_array_unit_ctor(
-        &object_ptr->mode_type_neighbor_array,
-        MAX_PICTURE_WIDTH_SIZE,
-        MAX_PICTURE_HEIGHT_SIZE,
-        sizeof(uint8_t),
-        PU_NEIGHBOR_ARRAY_GRANULARITY,
-        PU_NEIGHBOR_ARRAY_GRANULARITY,
-        NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK);
-
-    if (return_error == EB_ErrorInsufficientResources) {
-        return EB_ErrorInsufficientResources;
-    }
-
-    return_error = neighbor_array_unit_ctor(
-        &object_ptr->partition_context_neighbor_array,
-        MAX_PICTURE_WIDTH_SIZE,
-        MAX_PICTURE_HEIGHT_SIZE,
-        sizeof(struct PartitionContext),
-        PU_NEIGHBOR_ARRAY_GRANULARITY,
-        PU_NEIGHBOR_ARRAY_GRANULARITY,
-        NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK);
-
-    if (return_error == EB_ErrorInsufficientResources) {
-        return EB_ErrorInsufficientResources;
-    }
-
-    return_error = neighbor_array_unit_ctor(
-        &object_ptr->skip_flag_neighbor_array,
-        MAX_PICTURE_WIDTH_SIZE,
-        MAX_PICTURE_HEIGHT_SIZE,
-        sizeof(uint8_t),
-        PU_NEIGHBOR_ARRAY_GRANULARITY,
-        PU_NEIGHBOR_ARRAY_GRANULARITY,
-        NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK);
-
-    if (return_error == EB_ErrorInsufficientResources) {
-        return EB_ErrorInsufficientResources;
-    }
-
-    return_error = neighbor_array_unit_ctor(
-        &object_ptr->skip_coeff_neighbor_array,
-        MAX_PICTURE_WIDTH_SIZE,
-        MAX_PICTURE_HEIGHT_SIZE,
-        sizeof(uint8_t),
-        PU_NEIGHBOR_ARRAY_GRANULARITY,
-        PU_NEIGHBOR_ARRAY_GRANULARITY,
-        NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK);
-
-    if (return_error == EB_ErrorInsufficientResources) {
-        return EB_ErrorInsufficientResources;
-    }
-    // for each 4x4
-    return_error = neighbor_array_unit_ctor(
-        &object_ptr->luma_dc_sign_level_coeff_neighbor_array,
-        MAX_PICTURE_WIDTH_SIZE,
-        MAX_PICTURE_HEIGHT_SIZE,
-        sizeof(uint8_t),
-        PU_NEIGHBOR_ARRAY_GRANULARITY,
-        PU_NEIGHBOR_ARRAY_GRANULARITY,
-        NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK);
-
-    if (return_error == EB_ErrorInsufficientResources) {
-        return EB_ErrorInsufficientResources;
-    }
-    // for each 4x4
-    return_error = neighbor_array_unit_ctor(
-        &object_ptr->cr_dc_sign_level_coeff_neighbor_array,
-        MAX_PICTURE_WIDTH_SIZE,
-        MAX_PICTURE_HEIGHT_SIZE,
-        sizeof(uint8_t),
-        PU_NEIGHBOR_ARRAY_GRANULARITY,
-        PU_NEIGHBOR_ARRAY_GRANULARITY,
-        NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK);
-
-    if (return_error == EB_ErrorInsufficientResources) {
-        return EB_ErrorInsufficientResources;
-    }
-    // for each 4x4
-    return_error = neighbor_array_unit_ctor(
-        &object_ptr->cb_dc_sign_level_coeff_neighbor_array,
-        MAX_PICTURE_WIDTH_SIZE,
-        MAX_PICTURE_HEIGHT_SIZE,
-        sizeof(uint8_t),
-        PU_NEIGHBOR_ARRAY_GRANULARITY,
-        PU_NEIGHBOR_ARRAY_GRANULARITY,
-        NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK);
-
-    if (return_error == EB_ErrorInsufficientResources) {
-        return EB_ErrorInsufficientResources;
-    }
-
-    return_error = neighbor_array_unit_ctor(
-        &object_ptr->inter_pred_dir_neighbor_array,
-        MAX_PICTURE_WIDTH_SIZE,
-        MAX_PICTURE_HEIGHT_SIZE,
-        sizeof(uint8_t),
-        PU_NEIGHBOR_ARRAY_GRANULARITY,
-        PU_NEIGHBOR_ARRAY_GRANULARITY,
-        NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK);
-
-    if (return_error == EB_ErrorInsufficientResources) {
-        return EB_ErrorInsufficientResources;
-    }
-
-    return_error = neighbor_array_unit_ctor(
-        &object_ptr->ref_frame_type_neighbor_array,
-        MAX_PICTURE_WIDTH_SIZE,
-        MAX_PICTURE_HEIGHT_SIZE,
-        sizeof(uint8_t),
-        PU_NEIGHBOR_ARRAY_GRANULARITY,
-        PU_NEIGHBOR_ARRAY_GRANULARITY,
-        NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK);
-
-    return_error = neighbor_array_unit_ctor32(
-        &object_ptr->interpolation_type_neighbor_array,
-        MAX_PICTURE_WIDTH_SIZE,
-        MAX_PICTURE_HEIGHT_SIZE,
-        sizeof(uint32_t),
-        PU_NEIGHBOR_ARRAY_GRANULARITY,
-        PU_NEIGHBOR_ARRAY_GRANULARITY,
-        NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK);
-
-    if (return_error == EB_ErrorInsufficientResources) {
-        return EB_ErrorInsufficientResources;
-    }
-
-
-
-    return_error = neighbor_array_unit_ctor(
-        &object_ptr->intra_luma_mode_neighbor_array,
-        MAX_PICTURE_WIDTH_SIZE,
-        MAX_PICTURE_HEIGHT_SIZE,
-        sizeof(uint8_t),
-        PU_NEIGHBOR_ARRAY_GRANULARITY,
-        PU_NEIGHBOR_ARRAY_GRANULARITY,
-        NEIGHBOR_ARRAY_UNIT_TOP_AND_LEFT_ONLY_MASK);
-    if (return_error == EB_ErrorInsufficientResources) {
-        return EB_ErrorInsufficientResources;
+    // Entropy Coding Tiles
+    object_ptr->ec_tile_count = initDataPtr->tile_count;
+    EB_MALLOC(EntropyCodingTile_t**, object_ptr->ec_tile_ptr_array, sizeof(EntropyCodingTile_t*) * object_ptr->ec_tile_count, EB_N_PTR);
+    {
+        // Tiles are made of SBs of sb_size_pix
+        const uint32_t pictureSbWidth = (initDataPtr->picture_width + initDataPtr->sb_size_pix - 1) / initDataPtr->sb_size_pix;
+        const uint32_t pictureSbHeight = (initDataPtr->picture_height + initDataPtr->sb_size_pix - 1) / initDataPtr->sb_size_pix;
+        const uint32_t tileSbWidth = (pictureSbWidth + initDataPtr->tile_column_count - 1) / initDataPtr->tile_column_count;
+        const uint32_t tileSbHeight = (pictureSbHeight + initDataPtr->tile_row_count - 1) / initDataPtr->tile_row_count;
+
+        // The first tile holds the picture bitstream, the others their share
+        //   of it for the largest tile of the layout
+        const uint32_t tileBufferSize = (uint32_t)(((uint64_t)SEGMENT_ENTROPY_BUFFER_SIZE * tileSbWidth * tileSbHeight + pictureSbWidth * pictureSbHeight - 1) /
+            (pictureSbWidth * pictureSbHeight));
+
+        for (tileIndex = 0; tileIndex < object_ptr->ec_tile_count; ++tileIndex) {
+            return_error = entropy_coding_tile_ctor(
+                &object_ptr->ec_tile_ptr_array[tileIndex],
+                tileIndex ? tileBufferSize : SEGMENT_ENTROPY_BUFFER_SIZE,
+                pictureSbWidth * initDataPtr->sb_size_pix,
+                pictureSbHeight * initDataPtr->sb_size_pix);
+            if (return_error == EB_ErrorInsufficientResources) {
+                return EB_ErrorInsufficientResources;
+            }
+        }
     }
+    // The picture bitstream is written by the coder of the first tile
+    object_ptr->entropy_coder_ptr = object_ptr->ec_tile_ptr_array[0]->entropy_coder_ptr;
 
     // Note - non-zero offsets are not supported (to be fixed later in DLF chroma filtering)
     object_ptr->cb_qp_offset = 0;
@@ -850,6 +916,15 @@ EbErrorType picture_control_set_ctor(
 
     EB_CREATEMUTEX(EbHandle, object_ptr->intra_mutex, sizeof(EbHandle), EB_MUTEX);
 
+#if FILT_PROC
+    // Deblocking Filter Rows
+    EB_CREATEMUTEX(EbHandle, object_ptr->dlf_mutex, sizeof(EbHandle), EB_MUTEX);
+    for (uint32_t sb_row = 0; sb_row < MAX_LCU_ROWS; ++sb_row) {
+        object_ptr->dlf_sb_row_wait_count[sb_row] = 0;
+        object_ptr->dlf_sb_row_waiter[sb_row] = (EbHandle)EB_NULL;
+    }
+#endif
+
 #if CDEF_M
     EB_CREATEMUTEX(EbHandle, object_ptr->cdef_search_mutex, sizeof(EbHandle), EB_MUTEX);
 
@@ -1016,6 +1091,9 @@ EbErrorType picture_parent_control_set_ctor(
     // similar Colocated Lcu array
     EB_MALLOC(EbBool*, object_ptr->similar_colocated_sb_array, sizeof(EbBool) * object_ptr->sb_total_count, EB_N_PTR);
 
+    // Static SB array
+    EB_MALLOC(EbBool*, object_ptr->static_sb_array, sizeof(EbBool) * object_ptr->sb_total_count, EB_N_PTR);
+
     // similar Colocated Lcu array
     EB_MALLOC(EbBool*, object_ptr->similar_colocated_sb_array_ii, sizeof(EbBool) * object_ptr->sb_total_count, EB_N_PTR);
 
@@ -1064,6 +1142,7 @@ EbErrorType picture_parent_control_set_ctor(
     EB_MALLOC(EbSbComplexityStatus*, object_ptr->complex_sb_array, sizeof(EbSbComplexityStatus) * object_ptr->sb_total_count, EB_N_PTR);
 
     EB_CREATEMUTEX(EbHandle, object_ptr->rc_distortion_histogram_mutex, sizeof(EbHandle), EB_MUTEX);
+    EB_CREATEMUTEX(EbHandle, object_ptr->pa_segments_mutex, sizeof(EbHandle), EB_MUTEX);
 
 #if ADAPTIVE_DEPTH_PARTITIONING
     EB_MALLOC(EB_SB_DEPTH_MODE*, object_ptr->sb_depth_mode_array, sizeof(EB_SB_DEPTH_MODE) * object_ptr->sb_total_count, EB_N_PTR);
@@ -13669,6 +13669,38 @@ extern "C" {
     struct CodedTreeblock_s;
     struct LargestCodingUnit_s;
 
+    /**************************************
+     * Entropy Coding Tile
+     *   State an entropy coding task owns
+     *   while coding one tile. Tiles of a
+     *   picture are coded concurrently, each
+     *   with its own writer and CDF context.
+     *   Tile 0 also codes untiled pictures.
+     **************************************/
+    typedef struct EntropyCodingTile_s
+    {
+        EntropyCoder_t                       *entropy_coder_ptr;
+
+        // Entropy Coding Neighbor Arrays
+        NeighborArrayUnit_t                  *mode_type_neighbor_array;
+        NeighborArrayUnit_t                  *partition_context_neighbor_array;
+        NeighborArrayUnit_t                  *intra_luma_mode_neighbor_array;
+        NeighborArrayUnit_t                  *skip_flag_neighbor_array;
+        NeighborArrayUnit_t                  *skip_coeff_neighbor_array;
+        NeighborArrayUnit_t                  *luma_dc_sign_level_coeff_neighbor_array; // Stored per 4x4. 8 bit: lower 6 bits (COEFF_CONTEXT_BITS), shows if there is at least one Coef. Top 2 bit store the sign of DC as follow: 0->0,1->-1,2-> 1
+        NeighborArrayUnit_t                  *cr_dc_sign_level_coeff_neighbor_array; // Stored per 4x4. 8 bit: lower 6 bits(COEFF_CONTEXT_BITS), shows if there is at least one Coef. Top 2 bit store the sign of DC as follow: 0->0,1->-1,2-> 1
+        NeighborArrayUnit_t                  *cb_dc_sign_level_coeff_neighbor_array; // Stored per 4x4. 8 bit: lower 6 bits(COEFF_CONTEXT_BITS), shows if there is at least one Coef. Top 2 bit store the sign of DC as follow: 0->0,1->-1,2-> 1
+        NeighborArrayUnit_t                  *inter_pred_dir_neighbor_array;
+        NeighborArrayUnit_t                  *ref_frame_type_neighbor_array;
+        NeighborArrayUnit32_t                *interpolation_type_neighbor_array;
+
+        int32_t                               cdef_preset[4];
+        WienerInfo                            wiener_info[MAX_MB_PLANE];
+        SgrprojInfo                           sgrproj_info[MAX_MB_PLANE];
+        uint64_t                              quantized_coeff_num_bits;
+        EbBool                                tile_coded;                         // low latency tile output: ready to go out
+    } EntropyCodingTile_t;
+
     typedef struct PictureControlSet_s
     {
         EbObjectWrapper_t                    *sequence_control_set_wrapper_ptr;
@@ -13706,8 +13738,37 @@ extern "C" {
         EbHandle                              entropy_coding_mutex;
         EbBool                                entropy_coding_in_progress;
         EbBool                                entropy_coding_pic_done;
+        // Entropy Coding Tiles
+        EntropyCodingTile_t                 **ec_tile_ptr_array;
+        uint32_t                              ec_tile_count;                      // tiles allocated
+#if TILES
+        uint32_t                              entropy_coding_tile_task_count;     // EC tasks of the picture, 1 when its tiles are coded serially
+        uint32_t                              entropy_coding_tile_done_count;
+        EbBool                                tile_output;                        // tiles sent as tile groups of their own, see eb_output_tile_group
+        uint32_t                              tile_output_count;                  // tile groups out so far
+#endif
         EbHandle                              intra_mutex;
         uint32_t                              intra_coded_area;
+#if FILT_PROC
+        // Deblocking Filter Rows
+        EbHandle                              dlf_mutex;
+        EbBool                                dlf_level_searched;                 // filter level search claimed, by the task of the first row
+        uint32_t                              dlf_next_sb_row;                    // next row claimed by a DLF task
+        uint32_t                              dlf_rows_done_count;
+        volatile int32_t                      dlf_sb_row_progress[MAX_LCU_ROWS];  // SBs of each row already filtered
+        int32_t                               dlf_sb_row_wait_count[MAX_LCU_ROWS]; // progress of the row a DLF task is blocked on, under dlf_mutex
+        EbHandle                              dlf_sb_row_waiter[MAX_LCU_ROWS];    // semaphore of that task, NULL when none
+        uint32_t                              dlf_rows_published_count;           // rows final in the reference object, see frame_row_overlap
+        uint32_t                              dlf_rows_claimed_count;             // rows a DLF task took to pad and copy, published once all above are
+        uint32_t                              dlf_rows_padded_end[MAX_LCU_ROWS];  // end of a padded range of rows by its first row, 0 until it is padded
+
+        // EncDec Rows, tracked when the DLF tasks are posted as the rows are coded:
+        // the DLF task of a row is posted once the row below it is coded (the rows
+        // above are not used for intra prediction past that point)
+        volatile int32_t                      enc_dec_sb_row_progress[MAX_LCU_ROWS]; // SBs of each row coded
+        uint32_t                              enc_dec_rows_done_count;            // leading rows coded
+#endif
+        uint32_t                              ref_row_reach;                      // luma rows below an SB its inter prediction may read, see frame_row_overlap
 #if CDEF_M
         uint32_t                              tot_seg_searched_cdef;
         EbHandle                              cdef_search_mutex;
@@ -13748,6 +13809,7 @@ extern "C" {
         uint16_t                              sb_total_count;
         LargestCodingUnit_t                 **sb_ptr_array;
         LargestCodingUnit_t                 **sb_ptr_array_copy;
+        LargestCodingUnitArena_t              sb_arena;
 
         // DLF
         uint8_t                              *qp_array;
@@ -13812,19 +13874,6 @@ extern "C" {
         NeighborArrayUnit_t                  *amvp_mv_merge_mv_neighbor_array;
         NeighborArrayUnit_t                  *amvp_mv_merge_mode_type_neighbor_array;
 
-        // Entropy Coding Neighbor Arrays
-        NeighborArrayUnit_t                  *mode_type_neighbor_array;
-        NeighborArrayUnit_t                  *partition_context_neighbor_array;
-        NeighborArrayUnit_t                  *intra_luma_mode_neighbor_array;
-        NeighborArrayUnit_t                  *skip_flag_neighbor_array;
-        NeighborArrayUnit_t                  *skip_coeff_neighbor_array;
-        NeighborArrayUnit_t                  *luma_dc_sign_level_coeff_neighbor_array; // Stored per 4x4. 8 bit: lower 6 bits (COEFF_CONTEXT_BITS), shows if there is at least one Coef. Top 2 bit store the sign of DC as follow: 0->0,1->-1,2-> 1
-        NeighborArrayUnit_t                  *cr_dc_sign_level_coeff_neighbor_array; // Stored per 4x4. 8 bit: lower 6 bits(COEFF_CONTEXT_BITS), shows if there is at least one Coef. Top 2 bit store the sign of DC as follow: 0->0,1->-1,2-> 1
-        NeighborArrayUnit_t                  *cb_dc_sign_level_coeff_neighbor_array; // Stored per 4x4. 8 bit: lower 6 bits(COEFF_CONTEXT_BITS), shows if there is at least one Coef. Top 2 bit store the sign of DC as follow: 0->0,1->-1,2-> 1
-        NeighborArrayUnit_t                  *inter_pred_dir_neighbor_array;
-        NeighborArrayUnit_t                  *ref_frame_type_neighbor_array;
-        NeighborArrayUnit32_t                *interpolation_type_neighbor_array;
-
         ModeInfo                            **mi_grid_base; //2 SB Rows of mi Data are enough
         ModeInfo                             *mip;
 
@@ -13847,9 +13896,6 @@ extern "C" {
         uint8_t                               high_intra_slection;
         EB_FRAME_CARACTERICTICS               scene_caracteristic_id;
         EbBool                                limit_intra;
-        int32_t                               cdef_preset[4];
-        WienerInfo                            wiener_info[MAX_MB_PLANE];
-        SgrprojInfo                           sgrproj_info[MAX_MB_PLANE];
 
     } PictureControlSet_t;
 
@@ -13999,6 +14045,8 @@ extern "C" {
         uint8_t                              *zz_cost_array;
         // Non moving index array
         uint8_t                              *non_moving_index_array;
+        // SBs unchanged from the list 0 reference (ME), coded as zero motion 64x64 (MDC, MD)
+        EbBool                               *static_sb_array;
 #if NEW_PRED_STRUCT
         int                                   kf_zeromotion_pct; // percent of zero motion blocks
 #endif
@@ -14066,6 +14114,12 @@ extern "C" {
         uint8_t                               me_segments_column_count;
         uint8_t                               me_segments_row_count;
         uint64_t                              me_segments_completion_mask;
+        uint16_t                              pa_segments_total_count;
+        uint16_t                              pa_segments_started_count;     // the first started segment prepares the film grain estimation
+        uint16_t                              pa_segments_completed_count;
+        EbHandle                              pa_segments_mutex;
+        uint64_t                              pa_noise_variance_sum;    // noise picture variance, summed over the segments
+        uint32_t                              pa_noise_sb_count;
 
         // Motion Estimation Results
         uint8_t                               max_number_of_pus_per_sb;
@@ -14307,6 +14361,9 @@ extern "C" {
         uint32_t                           encoder_bit_depth;
         EbBool                             ext_block_flag;
         EbBool                             in_loop_me_flag;
+        uint16_t                           tile_count;            // entropy coding tiles to allocate
+        uint16_t                           tile_column_count;     // tile layout of the entropy coding tiles
+        uint16_t                           tile_row_count;
 
     } PictureControlSetInitData_t;
 
@@ -57,6 +57,65 @@ static void ConfigurePictureEdges(
     return;
 }
 
+/************************************************
+ * Start Overlapped Reference
+ *   With frame_row_overlap, the reference object of a picture is handed
+ *   to the pictures referencing it when the picture is started rather
+ *   than once it is complete. The statistics Rest copies to the reference
+ *   object of a complete picture are set here from what is known before
+ *   its EncDec (the intra coded area is not), its rows are then
+ *   published by the DLF through ready_sb_row_count.
+ ************************************************/
+static void StartOverlappedReference(
+    ReferenceQueueEntry_t *referenceEntryPtr,
+    PictureControlSet_t   *picture_control_set_ptr)
+{
+    PictureParentControlSet_t *parentPcsPtr = picture_control_set_ptr->parent_pcs_ptr;
+    EbReferenceObject_t       *referenceObject = (EbReferenceObject_t*)parentPcsPtr->reference_picture_wrapper_ptr->object_ptr;
+    EbReferenceObject_t       *refObjL0, *refObjL1;
+    uint32_t                   sb_index;
+
+    EB_ATOMIC_STORE(&referenceObject->ready_sb_row_count, 0);
+
+    referenceObject->tmvpEnableFlag = EB_TRUE;
+    referenceObject->refPOC = parentPcsPtr->picture_number;
+#if ADD_DELTA_QP_SUPPORT
+    referenceObject->qp = (uint16_t)parentPcsPtr->base_qindex;
+#else
+    referenceObject->qp = (uint8_t)parentPcsPtr->picture_qp;
+#endif
+    referenceObject->slice_type = parentPcsPtr->slice_type;
+
+    referenceObject->intra_coded_area = 0;
+    for (sb_index = 0; sb_index < picture_control_set_ptr->sb_total_count; ++sb_index)
+        referenceObject->non_moving_index_array[sb_index] = parentPcsPtr->non_moving_index_array[sb_index];
+
+    referenceObject->penalizeSkipflag = EB_FALSE;
+    if (picture_control_set_ptr->slice_type == B_SLICE) {
+        refObjL0 = (EbReferenceObject_t*)picture_control_set_ptr->ref_pic_ptr_array[REF_LIST_0]->object_ptr;
+        refObjL1 = (EbReferenceObject_t*)picture_control_set_ptr->ref_pic_ptr_array[REF_LIST_1]->object_ptr;
+
+        if (picture_control_set_ptr->temporal_layer_index == 0)
+            referenceObject->penalizeSkipflag = (parentPcsPtr->intra_coded_block_probability > 30) ? EB_TRUE : EB_FALSE;
+        else
+            referenceObject->penalizeSkipflag = (refObjL0->penalizeSkipflag || refObjL1->penalizeSkipflag) ? EB_TRUE : EB_FALSE;
+    }
+    referenceObject->tmpLayerIdx = (uint8_t)picture_control_set_ptr->temporal_layer_index;
+    referenceObject->isSceneChange = parentPcsPtr->scene_change_flag;
+
+    // CDEF and loop restoration are disabled
+#if FAST_CDEF
+    referenceObject->cdef_frame_strength = 0;
+#endif
+#if FAST_SG
+    referenceObject->sg_frame_ep = 0;
+#endif
+    referenceObject->film_grain_params = parentPcsPtr->film_grain_params;
+
+    // The entry is not available yet: it is still released once Rest posts the complete reference
+    referenceEntryPtr->referenceObjectPtr = parentPcsPtr->reference_picture_wrapper_ptr;
+}
+
 /************************************************
  * Picture Manager Context Constructor
  ************************************************/
@@ -581,6 +640,7 @@ void* picture_manager_kernel(void *input_ptr)
                             (availabilityFlag == EB_FALSE) ? EB_FALSE :   // Don't update if already False
                             (refPoc > current_input_poc) ? EB_FALSE :   // The Reference has not been received as an Input Picture yet, then its availability is false
                             (referenceEntryPtr->referenceAvailable) ? EB_TRUE :   // The Reference has been completed
+                            (entrySequenceControlSetPtr->static_config.frame_row_overlap && referenceEntryPtr->referenceObjectPtr) ? EB_TRUE :   // The Reference has been started
                             EB_FALSE;     // The Reference has not been completed
                     }
 
@@ -617,6 +677,7 @@ void* picture_manager_kernel(void *input_ptr)
                                     (availabilityFlag == EB_FALSE) ? EB_FALSE :   // Don't update if already False
                                     (refPoc > current_input_poc) ? EB_FALSE :   // The Reference has not been received as an Input Picture yet, then its availability is false
                                     (referenceEntryPtr->referenceAvailable) ? EB_TRUE :   // The Reference has been completed
+                                    (entrySequenceControlSetPtr->static_config.frame_row_overlap && referenceEntryPtr->referenceObjectPtr) ? EB_TRUE :   // The Reference has been started
                                     EB_FALSE;     // The Reference has not been completed
                             }
                         }
@@ -713,6 +774,32 @@ void* picture_manager_kernel(void *input_ptr)
                             }
                         }                       
 
+                        // Entropy Coding Tiles: coded in parallel unless the delta q index is predicted across them
+                        ChildPictureControlSetPtr->entropy_coding_tile_task_count =
+                            (tile_cols * tile_rows > 1 && (uint32_t)(tile_cols * tile_rows) <= ChildPictureControlSetPtr->ec_tile_count && ppcs_ptr->delta_q_present_flag == 0) ?
+                            (uint32_t)(tile_cols * tile_rows) : 1;
+                        ChildPictureControlSetPtr->entropy_coding_tile_done_count = 0;
+
+                        // Low latency tile output, when each tile has its own bitstream
+                        ChildPictureControlSetPtr->tile_output = (EbBool)(entrySequenceControlSetPtr->static_config.low_latency_tile_output &&
+                            ChildPictureControlSetPtr->entropy_coding_tile_task_count > 1);
+                        ChildPictureControlSetPtr->tile_output_count = 0;
+                        for (uint32_t tile_index = 0; tile_index < ChildPictureControlSetPtr->entropy_coding_tile_task_count; ++tile_index)
+                            ChildPictureControlSetPtr->ec_tile_ptr_array[tile_index]->tile_coded = EB_FALSE;
+
+#endif
+#if FILT_PROC
+                        // Deblocking Filter Rows
+                        ChildPictureControlSetPtr->dlf_level_searched = EB_FALSE;
+                        ChildPictureControlSetPtr->dlf_next_sb_row = 0;
+                        ChildPictureControlSetPtr->dlf_rows_done_count = 0;
+                        ChildPictureControlSetPtr->dlf_rows_published_count = 0;
+                        ChildPictureControlSetPtr->dlf_rows_claimed_count = 0;
+                        ChildPictureControlSetPtr->enc_dec_rows_done_count = 0;
+                        for (uint32_t sb_row = 0; sb_row < MAX_LCU_ROWS; ++sb_row) {
+                            ChildPictureControlSetPtr->dlf_rows_padded_end[sb_row] = 0;
+                            ChildPictureControlSetPtr->enc_dec_sb_row_progress[sb_row] = 0;
+                        }
 #endif
 
                         // Picture edges
@@ -815,6 +902,13 @@ void* picture_manager_kernel(void *input_ptr)
                             I_SLICE;
 
 
+                        // Frame row overlap: the pictures referencing this one can start now
+                        if (entrySequenceControlSetPtr->static_config.frame_row_overlap && entryPictureControlSetPtr->is_used_as_reference_flag) {
+                            StartOverlappedReference(
+                                encode_context_ptr->reference_picture_queue[inputEntryPtr->referenceEntryIndex],
+                                ChildPictureControlSetPtr);
+                        }
+
                         // Increment the sequenceControlSet Wrapper's live count by 1 for only the pictures which are used as reference
                         if (ChildPictureControlSetPtr->parent_pcs_ptr->is_used_as_reference_flag) {
                             eb_object_inc_live_count(
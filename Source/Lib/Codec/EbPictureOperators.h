@@ -196,6 +196,8 @@ extern "C" {
         sum_residual,
         // AVX2
         sum_residual8bit_avx2_intrin,
+        // AVX512
+        sum_residual8bit_avx2_intrin,
     };
 
     void memset16bit_block(
@@ -215,6 +217,8 @@ extern "C" {
         memset16bit_block,
         // AVX2
         memset16bit_block_avx2_intrin,
+        // AVX512
+        memset16bit_block_avx2_intrin,
     };
 
     void full_distortion_kernel_cbf_zero32_bits(
@@ -258,6 +262,8 @@ extern "C" {
         full_distortion_kernel_cbf_zero32_bits,
         // AVX2
         full_distortion_kernel_cbf_zero32_bits_avx2,
+        // AVX512
+        full_distortion_kernel_cbf_zero32_bits_avx2,
     };
 
     static EB_FUllDISTORTIONKERNEL32BITS FUNC_TABLE full_distortion_kernel32_bits_func_ptr_array[ASM_TYPE_TOTAL] = {
@@ -265,6 +271,8 @@ extern "C" {
         full_distortion_kernel32_bits,
         // AVX2
         full_distortion_kernel32_bits_avx2,
+        // AVX512
+        full_distortion_kernel32_bits_avx2,
     };
 
     /***************************************
@@ -381,6 +389,18 @@ extern "C" {
             /*7       */    (EB_ADDDKERNEL_TYPE)picture_addition_void_func,
             /*8 64x64 */    picture_addition_kernel64x64_sse2_intrin,
         },
+        // AVX512
+        {
+            /*0 4x4   */    picture_addition_kernel4x4_sse_intrin,
+            /*1 8x8   */    picture_addition_kernel8x8_sse2_intrin,
+            /*2 16x16 */    picture_addition_kernel16x16_sse2_intrin,
+            /*3       */    (EB_ADDDKERNEL_TYPE)picture_addition_void_func,
+            /*4 32x32 */    picture_addition_kernel32x32_sse2_intrin,
+            /*5       */    (EB_ADDDKERNEL_TYPE)picture_addition_void_func,
+            /*6       */    (EB_ADDDKERNEL_TYPE)picture_addition_void_func,
+            /*7       */    (EB_ADDDKERNEL_TYPE)picture_addition_void_func,
+            /*8 64x64 */    picture_addition_kernel64x64_sse2_intrin,
+        },
     };
 
     static EB_ADDDKERNEL_TYPE_16BIT FUNC_TABLE addition_kernel_func_ptr_array16bit[ASM_TYPE_TOTAL] = {
@@ -388,6 +408,8 @@ extern "C" {
         picture_addition_kernel16bit_sse2_intrin,
         // AVX2
         picture_addition_kernel16bit_sse2_intrin,
+        // AVX512
+        picture_addition_kernel16bit_sse2_intrin,
     };
 
     typedef void(*EB_RESDKERNELSUBSAMPLED_TYPE)(
@@ -439,12 +461,22 @@ extern "C" {
             /*3       */     (EB_ZEROCOEFF_TYPE)pic_zero_out_coef_void_func,
             /*4 32x32 */     zero_out_coeff32x32_sse2
         },
+        // AVX512
+        {
+            /*0 4x4   */     zero_out_coeff4x4_sse,
+            /*1 8x8   */     zero_out_coeff8x8_sse2,
+            /*2 16x16 */     zero_out_coeff16x16_sse2,
+            /*3       */     (EB_ZEROCOEFF_TYPE)pic_zero_out_coef_void_func,
+            /*4 32x32 */     zero_out_coeff32x32_sse2
+        },
     };
 
     static EB_SATD_U8_TYPE FUNC_TABLE compute8x8_satd_u8_func_ptr_array[ASM_TYPE_TOTAL] = {
         // NON_AVX2
         Compute8x8Satd_U8_SSE4,
         // ASM_AVX2
+        Compute8x8Satd_U8_SSE4,
+        // ASM_AVX512
         Compute8x8Satd_U8_SSE4
     };
 
@@ -484,6 +516,19 @@ extern "C" {
             // 64x64
             SpatialFullDistortionKernel16MxN_SSSE3_INTRIN
         },
+        // ASM_AVX512
+        {
+            // 4x4
+            SpatialFullDistortionKernel4x4_SSSE3_INTRIN,
+            // 8x8
+            SpatialFullDistortionKernel8x8_SSSE3_INTRIN,
+            // 16x16
+            SpatialFullDistortionKernel16MxN_SSSE3_INTRIN,
+            // 32x32
+            SpatialFullDistortionKernel16MxN_SSSE3_INTRIN,
+            // 64x64
+            SpatialFullDistortionKernel16MxN_SSSE3_INTRIN
+        },
     };
 #endif
 
@@ -0,0 +1,264 @@
+/*
+* Copyright(c) 2019 Intel Corporation
+* SPDX - License - Identifier: BSD - 2 - Clause - Patent
+*/
+
+#include <stdlib.h>
+
+#include "EbPipelineProfiler.h"
+#include "EbThreads.h"
+
+/**************************************
+ * Per thread state
+ *   A thread is busy from the dequeue of an object until it waits on
+ *   a queue again (or ends its thread pool task).
+ **************************************/
+typedef struct PipelineThreadState_s {
+    EbPipelineProfiler_t *profiler_ptr;     // profiler of the open busy span, NULL when idle
+    uint32_t              thread_index;     // 0 until the thread is first seen
+    uint32_t              busy_stage;
+    uint64_t              busy_object_id;
+    uint64_t              busy_start_time;
+    uint64_t              wait_start_time;
+    EbPipelineProfiler_t *wait_profiler_ptr;
+} PipelineThreadState_t;
+
+static EB_THREAD_LOCAL PipelineThreadState_t threadState;
+static volatile uint32_t threadIndexCount = 0;
+
+static uint32_t PipelineThreadIndex(void)
+{
+    if (threadState.thread_index == 0)
+        threadState.thread_index = EB_ATOMIC_ADD(&threadIndexCount, 1) + 1;
+
+    return threadState.thread_index;
+}
+
+static uint64_t PipelineObjectId(
+    EbPipelineProfilerStage_t *stage_ptr,
+    EbObjectWrapper_t         *wrapper_ptr)
+{
+    return stage_ptr->object_id ?
+        stage_ptr->object_id(wrapper_ptr->object_ptr) :
+        EB_PIPELINE_PROFILER_INVALID_ID;
+}
+
+/**************************************
+ * Event recording, called with the lockout_mutex held
+ **************************************/
+static void PipelineProfilerAddEvent(
+    EbPipelineProfiler_t *profiler_ptr,
+    EbPipelineEventType   type,
+    uint32_t              stage,
+    uint64_t              object_id,
+    uint64_t              timestamp,
+    uint64_t              duration)
+{
+    EbPipelineEvent *event_ptr;
+
+    if (profiler_ptr->event_count == profiler_ptr->event_max_count) {
+        profiler_ptr->dropped_event_count++;
+        return;
+    }
+
+    event_ptr = &profiler_ptr->event_array[profiler_ptr->event_count++];
+    event_ptr->timestamp = timestamp - profiler_ptr->start_time;
+    event_ptr->duration = duration;
+    event_ptr->object_id = object_id;
+    event_ptr->stage = stage;
+    event_ptr->thread_index = PipelineThreadIndex();
+    event_ptr->queue_depth = profiler_ptr->stage_array[stage].queue_depth;
+    event_ptr->type = (uint32_t)type;
+}
+
+static void PipelineProfilerSetDepth(
+    EbPipelineProfilerStage_t *stage_ptr,
+    uint32_t                   queue_depth,
+    uint64_t                   now)
+{
+    stage_ptr->depth_time_sum += (uint64_t)stage_ptr->queue_depth * (now - stage_ptr->depth_update_time);
+    stage_ptr->depth_update_time = now;
+    stage_ptr->queue_depth = queue_depth;
+
+    if (queue_depth > stage_ptr->stats.max_queue_depth)
+        stage_ptr->stats.max_queue_depth = queue_depth;
+}
+
+static void PipelineProfilerCloseBusy(uint64_t now)
+{
+    EbPipelineProfiler_t *profiler_ptr = threadState.profiler_ptr;
+
+    if (profiler_ptr == (EbPipelineProfiler_t*)EB_NULL)
+        return;
+
+    eb_block_on_mutex(profiler_ptr->lockout_mutex);
+
+    profiler_ptr->stage_array[threadState.busy_stage].stats.busy_time += now - threadState.busy_start_time;
+    PipelineProfilerAddEvent(
+        profiler_ptr,
+        EB_PIPELINE_EVENT_BUSY,
+        threadState.busy_stage,
+        threadState.busy_object_id,
+        threadState.busy_start_time,
+        now - threadState.busy_start_time);
+
+    eb_release_mutex(profiler_ptr->lockout_mutex);
+
+    threadState.profiler_ptr = (EbPipelineProfiler_t*)EB_NULL;
+}
+
+EbErrorType eb_pipeline_profiler_ctor(
+    EbPipelineProfiler_t **profiler_dbl_ptr,
+    uint32_t               event_max_count)
+{
+    EbPipelineProfiler_t *profiler_ptr;
+
+    EB_MALLOC(EbPipelineProfiler_t*, profiler_ptr, sizeof(EbPipelineProfiler_t), EB_N_PTR);
+    *profiler_dbl_ptr = profiler_ptr;
+
+    EB_MEMSET(profiler_ptr, 0, sizeof(EbPipelineProfiler_t));
+
+    EB_CREATEMUTEX(EbHandle, profiler_ptr->lockout_mutex, sizeof(EbHandle), EB_MUTEX);
+
+    EB_MALLOC(EbPipelineEvent*, profiler_ptr->event_array, sizeof(EbPipelineEvent) * event_max_count, EB_N_PTR);
+    profiler_ptr->event_max_count = event_max_count;
+
+    profiler_ptr->start_time = eb_time_us();
+
+    return EB_ErrorNone;
+}
+
+EbErrorType eb_pipeline_profiler_add_stage(
+    EbPipelineProfiler_t  *profiler_ptr,
+    EbSystemResource_t    *resource_ptr,
+    const char            *name,
+    uint32_t               thread_count,
+    EbPipelineObjectId     object_id)
+{
+    EbPipelineProfilerStage_t *stage_ptr;
+
+    if (profiler_ptr->stage_count == EB_PIPELINE_PROFILER_MAX_STAGE_COUNT || resource_ptr->fullQueue == (EbMuxingQueue_t*)EB_NULL)
+        return EB_ErrorBadParameter;
+
+    stage_ptr = &profiler_ptr->stage_array[profiler_ptr->stage_count];
+    stage_ptr->stats.name = name;
+    stage_ptr->stats.thread_count = thread_count;
+    stage_ptr->object_id = object_id;
+    stage_ptr->depth_update_time = profiler_ptr->start_time;
+
+    resource_ptr->fullQueue->profilerPtr = profiler_ptr;
+    resource_ptr->fullQueue->profilerStage = profiler_ptr->stage_count++;
+
+    return EB_ErrorNone;
+}
+
+void eb_pipeline_profiler_enqueue(
+    EbPipelineProfiler_t  *profiler_ptr,
+    uint32_t               stage,
+    EbObjectWrapper_t     *wrapper_ptr)
+{
+    EbPipelineProfilerStage_t *stage_ptr = &profiler_ptr->stage_array[stage];
+    const uint64_t objectId = PipelineObjectId(stage_ptr, wrapper_ptr);
+    uint64_t now;
+
+    eb_block_on_mutex(profiler_ptr->lockout_mutex);
+
+    now = eb_time_us();
+    PipelineProfilerSetDepth(stage_ptr, stage_ptr->queue_depth + 1, now);
+    PipelineProfilerAddEvent(
+        profiler_ptr,
+        EB_PIPELINE_EVENT_ENQUEUE,
+        stage,
+        objectId,
+        now,
+        0);
+
+    eb_release_mutex(profiler_ptr->lockout_mutex);
+}
+
+void eb_pipeline_profiler_wait(
+    EbPipelineProfiler_t  *profiler_ptr)
+{
+    const uint64_t now = eb_time_us();
+
+    PipelineProfilerCloseBusy(now);
+
+    threadState.wait_profiler_ptr = profiler_ptr;
+    threadState.wait_start_time = now;
+}
+
+void eb_pipeline_profiler_dequeue(
+    EbPipelineProfiler_t  *profiler_ptr,
+    uint32_t               stage,
+    EbObjectWrapper_t     *wrapper_ptr)
+{
+    EbPipelineProfilerStage_t *stage_ptr = &profiler_ptr->stage_array[stage];
+    const uint64_t objectId = PipelineObjectId(stage_ptr, wrapper_ptr);
+    uint64_t now = eb_time_us();
+    uint64_t waitTime;
+
+    // Non-blocking dequeues do not wait
+    if (threadState.wait_profiler_ptr == profiler_ptr)
+        waitTime = now - threadState.wait_start_time;
+    else {
+        PipelineProfilerCloseBusy(now);
+        waitTime = 0;
+    }
+    threadState.wait_profiler_ptr = (EbPipelineProfiler_t*)EB_NULL;
+
+    eb_block_on_mutex(profiler_ptr->lockout_mutex);
+
+    stage_ptr->stats.idle_time += waitTime;
+    stage_ptr->stats.object_count++;
+    PipelineProfilerSetDepth(stage_ptr, stage_ptr->queue_depth ? stage_ptr->queue_depth - 1 : 0, now);
+    PipelineProfilerAddEvent(
+        profiler_ptr,
+        EB_PIPELINE_EVENT_DEQUEUE,
+        stage,
+        objectId,
+        now,
+        waitTime);
+
+    eb_release_mutex(profiler_ptr->lockout_mutex);
+
+    threadState.profiler_ptr = profiler_ptr;
+    threadState.busy_stage = stage;
+    threadState.busy_object_id = objectId;
+    threadState.busy_start_time = now;
+}
+
+void eb_pipeline_profiler_end_busy(void)
+{
+    PipelineProfilerCloseBusy(eb_time_us());
+}
+
+void eb_pipeline_profiler_get_profile(
+    EbPipelineProfiler_t  *profiler_ptr,
+    EbPipelineProfile     *profile_ptr)
+{
+    uint32_t stageIndex;
+    uint64_t now;
+
+    eb_block_on_mutex(profiler_ptr->lockout_mutex);
+
+    now = eb_time_us();
+
+    for (stageIndex = 0; stageIndex < profiler_ptr->stage_count; ++stageIndex) {
+        EbPipelineProfilerStage_t *stage_ptr = &profiler_ptr->stage_array[stageIndex];
+
+        PipelineProfilerSetDepth(stage_ptr, stage_ptr->queue_depth, now);
+
+        profiler_ptr->stats_array[stageIndex] = stage_ptr->stats;
+        profiler_ptr->stats_array[stageIndex].average_queue_depth = (now > profiler_ptr->start_time) ?
+            (double)stage_ptr->depth_time_sum / (double)(now - profiler_ptr->start_time) : 0;
+    }
+
+    profile_ptr->stage_count = profiler_ptr->stage_count;
+    profile_ptr->stage_array = profiler_ptr->stats_array;
+    profile_ptr->event_count = profiler_ptr->event_count;
+    profile_ptr->event_array = profiler_ptr->event_array;
+    profile_ptr->dropped_event_count = profiler_ptr->dropped_event_count;
+    profile_ptr->elapsed_time = now - profiler_ptr->start_time;
+
+    eb_release_mutex(profiler_ptr->lockout_mutex);
+}
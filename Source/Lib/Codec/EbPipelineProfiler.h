@@ -0,0 +1,103 @@
+/*
+* Copyright(c) 2019 Intel Corporation
+* SPDX - License - Identifier: BSD - 2 - Clause - Patent
+*/
+
+#ifndef EbPipelineProfiler_h
+#define EbPipelineProfiler_h
+
+#include "EbDefinitions.h"
+#include "EbSystemResourceManager.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+    /*********************************************************************
+     * Pipeline Profiler
+     *   Optional instrumentation of the full queues feeding the pipeline
+     *   stages. A posted object is recorded as an ENQUEUE event of the
+     *   stage that consumes it. When a stage thread takes an object, the
+     *   time it spent waiting on the queue is accounted as idle time and
+     *   a busy span is opened; the span is closed (BUSY event) by the
+     *   next dequeue of the same thread, whichever stage it belongs to.
+     *
+     *   The queue depth is counted at the same points and integrated
+     *   over time for the average occupancy. Events go to a fixed array
+     *   allocated at init, the ones past its capacity are only counted.
+     *********************************************************************/
+#define EB_PIPELINE_PROFILER_MAX_STAGE_COUNT    32
+#define EB_PIPELINE_PROFILER_EVENT_COUNT        (1 << 18)
+#define EB_PIPELINE_PROFILER_INVALID_ID         (~0ull)
+
+    // Returns the picture number carried by a queued object
+    typedef uint64_t(*EbPipelineObjectId)(
+        EbPtr object_ptr);
+
+    typedef struct EbPipelineProfilerStage_s {
+        EbPipelineStageStats stats;
+        EbPipelineObjectId   object_id;
+        uint32_t             queue_depth;
+        uint64_t             depth_update_time;
+        uint64_t             depth_time_sum;      // queue_depth integrated over time
+    } EbPipelineProfilerStage_t;
+
+    typedef struct EbPipelineProfiler_s {
+        EbHandle                   lockout_mutex;
+        uint64_t                   start_time;
+
+        EbPipelineProfilerStage_t  stage_array[EB_PIPELINE_PROFILER_MAX_STAGE_COUNT];
+        EbPipelineStageStats       stats_array[EB_PIPELINE_PROFILER_MAX_STAGE_COUNT];   // snapshot returned to the application
+        uint32_t                   stage_count;
+
+        EbPipelineEvent           *event_array;
+        uint32_t                   event_count;
+        uint32_t                   event_max_count;
+        uint64_t                   dropped_event_count;
+    } EbPipelineProfiler_t;
+
+    extern EbErrorType eb_pipeline_profiler_ctor(
+        EbPipelineProfiler_t **profiler_dbl_ptr,
+        uint32_t               event_max_count);
+
+    /*********************************************************************
+     * eb_pipeline_profiler_add_stage
+     *   Records the objects posted to the full queue of resource_ptr as
+     *   the input of the stage name, run by thread_count threads.
+     *   object_id may be NULL. Must be called before the stage threads
+     *   are started.
+     *********************************************************************/
+    extern EbErrorType eb_pipeline_profiler_add_stage(
+        EbPipelineProfiler_t  *profiler_ptr,
+        EbSystemResource_t    *resource_ptr,
+        const char            *name,
+        uint32_t               thread_count,
+        EbPipelineObjectId     object_id);
+
+    // Called by the resource manager before an object is pushed to a profiled queue
+    extern void eb_pipeline_profiler_enqueue(
+        EbPipelineProfiler_t  *profiler_ptr,
+        uint32_t               stage,
+        EbObjectWrapper_t     *wrapper_ptr);
+
+    // Called by the resource manager before a thread blocks on a profiled queue
+    extern void eb_pipeline_profiler_wait(
+        EbPipelineProfiler_t  *profiler_ptr);
+
+    // Called by the resource manager once a thread took an object from a profiled queue
+    extern void eb_pipeline_profiler_dequeue(
+        EbPipelineProfiler_t  *profiler_ptr,
+        uint32_t               stage,
+        EbObjectWrapper_t     *wrapper_ptr);
+
+    // Closes the busy span of the calling thread, for threads that do not
+    //   go back to a queue after each object (thread pool workers)
+    extern void eb_pipeline_profiler_end_busy(void);
+
+    extern void eb_pipeline_profiler_get_profile(
+        EbPipelineProfiler_t  *profiler_ptr,
+        EbPipelineProfile     *profile_ptr);
+
+#ifdef __cplusplus
+}
+#endif
+#endif // EbPipelineProfiler_h
@@ -653,7 +653,8 @@ void set_nfl(
     // 1                    10
     // 2                    8
     // 3                    6
-    if (picture_control_set_ptr->parent_pcs_ptr->pic_depth_mode == PIC_SB_SWITCH_DEPTH_MODE && picture_control_set_ptr->parent_pcs_ptr->sb_depth_mode_array[sb_ptr->index] == SB_PRED_OPEN_LOOP_1_NFL_DEPTH_MODE)
+    if ((picture_control_set_ptr->parent_pcs_ptr->pic_depth_mode == PIC_SB_SWITCH_DEPTH_MODE && picture_control_set_ptr->parent_pcs_ptr->sb_depth_mode_array[sb_ptr->index] == SB_PRED_OPEN_LOOP_1_NFL_DEPTH_MODE) ||
+        picture_control_set_ptr->parent_pcs_ptr->static_sb_array[sb_ptr->index])
         context_ptr->full_recon_search_count = 1;
     else
         if (context_ptr->nfl_level == 0)
@@ -3513,9 +3514,13 @@ static EB_SADKERNELNxM_TYPE FUNC_TABLE compute4x4SAD_funcPtrArray[ASM_TYPE_TOTAL
 #if INTRINSIC_OPT_2
     // SSE2
     compute4x_m_sad_avx2_intrin,
+    // AVX512
+    compute4x_m_sad_avx2_intrin,
 #else
     // SSE2
     Compute4x4SAD_Kernel,
+    // AVX512
+    Compute4x4SAD_Kernel,
 #endif
 
 
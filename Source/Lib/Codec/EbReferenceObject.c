@@ -207,6 +207,9 @@ EbErrorType eb_reference_object_ctor(
     }
 
     memset(&referenceObject->film_grain_params, 0, sizeof(referenceObject->film_grain_params));
+    referenceObject->ready_sb_row_count = 0;
+    EB_CREATEMUTEX(EbHandle, referenceObject->ref_wait_mutex, sizeof(EbHandle), EB_MUTEX);
+    referenceObject->ref_wait_list = (EbObjectWrapper_t*)EB_NULL;
 
     return EB_ErrorNone;
 }
@@ -228,6 +231,8 @@ EbErrorType eb_pa_reference_object_ctor(
     EB_MALLOC(EbPaReferenceObject_t*, paReferenceObject, sizeof(EbPaReferenceObject_t), EB_N_PTR);
     *object_dbl_ptr = (EbPtr)paReferenceObject;
 
+    paReferenceObject->inputPictureWrapperPtr = (EbObjectWrapper_t*)EB_NULL;
+
     // Reference picture constructor
     return_error = eb_picture_buffer_desc_ctor(
         (EbPtr*) &(paReferenceObject->inputPaddedPicturePtr),
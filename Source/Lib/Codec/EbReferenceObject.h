@@ -8,6 +8,7 @@
 
 #include "EbDefinitions.h"
 #include "EbDefinitions.h"
+#include "EbSystemResourceManager.h"
 #include "EbAdaptiveMotionVectorPrediction.h"
 
 typedef struct EbReferenceObject_s {
@@ -40,6 +41,15 @@ typedef struct EbReferenceObject_s {
 #if FAST_SG
     int8_t                          sg_frame_ep;
 #endif
+    // SB rows of referencePicture (and refDenSrcPicture) coded, deblocked and
+    // padded. Only maintained with frame_row_overlap, where the pictures
+    // referencing this one start before it is complete.
+    volatile int32_t                ready_sb_row_count;
+    // EncDec tasks parked until ready_sb_row_count reaches their
+    // ref_wait_row_count, linked through nextPtr. Both are updated under
+    // ref_wait_mutex, the DLF posts the tasks back as the rows are published.
+    EbHandle                        ref_wait_mutex;
+    EbObjectWrapper_t              *ref_wait_list;
 } EbReferenceObject_t;
 
 typedef struct EbReferenceObjectDescInitData_s {
@@ -55,6 +65,7 @@ typedef struct EbPaReferenceObject_s {
     EB_SLICE                        slice_type;
     uint32_t                        dependentPicturesCount; //number of pic using this reference frame
     PictureParentControlSet_t      *pPcsPtr;
+    EbObjectWrapper_t              *inputPictureWrapperPtr; // input held for zero-copy input, released with the reference
 
 } EbPaReferenceObject_t;
 
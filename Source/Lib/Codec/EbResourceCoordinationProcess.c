@@ -13,6 +13,7 @@
 #include "EbPictureBufferDesc.h"
 #include "EbResourceCoordinationProcess.h"
 #include "EbResourceCoordinationResults.h"
+#include "EbPictureAnalysisProcess.h"
 #include "EbTransforms.h"
 #include "EbTime.h"
 
@@ -111,6 +112,11 @@ EbErrorType signal_derivation_pre_analysis_oq(
     }
     if (picture_control_set_ptr->enc_mode >= ENC_M7)
         sequence_control_set_ptr->enable_restoration = 0;
+    // Frame row overlap: the reference rows are handed out as they are deblocked
+    if (sequence_control_set_ptr->static_config.frame_row_overlap) {
+        sequence_control_set_ptr->enable_cdef = 0;
+        sequence_control_set_ptr->enable_restoration = 0;
+    }
 
     return return_error;
 }
@@ -552,6 +558,12 @@ void* resource_coordination_kernel(void *input_ptr)
             pictureControlSetWrapperPtr :
             sequence_control_set_ptr->encode_context_ptr->previous_picture_control_set_wrapper_ptr;
 
+        // The previous PCS is written by the ME of this picture: hold it until the Initial Rate Control,
+        // so that an elastic pool cannot destruct it in between
+        eb_object_inc_live_count(
+            picture_control_set_ptr->previous_picture_control_set_wrapper_ptr,
+            1);
+
         sequence_control_set_ptr->encode_context_ptr->previous_picture_control_set_wrapper_ptr = pictureControlSetWrapperPtr;
 
         // Copy data from the svt buffer to the input frame
@@ -573,6 +585,15 @@ void* resource_coordination_kernel(void *input_ptr)
         picture_control_set_ptr->scene_change_flag = EB_FALSE;
         picture_control_set_ptr->qp_on_the_fly = EB_FALSE;
         picture_control_set_ptr->sb_total_count = sequence_control_set_ptr->sb_total_count;
+
+        // PA segments: the denoising filter works on the whole picture
+        picture_control_set_ptr->pa_segments_total_count = (uint16_t)(
+            sequence_control_set_ptr->static_config.enable_denoise_flag ? 1 :
+            MIN((uint32_t)sequence_control_set_ptr->pa_segment_row_count, (uint32_t)((sequence_control_set_ptr->luma_height + sequence_control_set_ptr->sb_sz - 1) / sequence_control_set_ptr->sb_sz)));
+        picture_control_set_ptr->pa_segments_started_count = 0;
+        picture_control_set_ptr->pa_segments_completed_count = 0;
+        picture_control_set_ptr->pa_noise_variance_sum = 0;
+        picture_control_set_ptr->pa_noise_sb_count = 0;
         picture_control_set_ptr->eos_coming = (ebInputPtr->flags & (EB_BUFFERFLAG_EOS << 1)) ? EB_TRUE : EB_FALSE;
 
         if (sequence_control_set_ptr->static_config.speed_control_flag) {
@@ -646,18 +667,39 @@ void* resource_coordination_kernel(void *input_ptr)
             2);
     
         ((EbPaReferenceObject_t*)picture_control_set_ptr->pa_reference_picture_wrapper_ptr->object_ptr)->inputPaddedPicturePtr->buffer_y = picture_control_set_ptr->enhanced_picture_ptr->buffer_y;
+
+        // The PA reference reads the application buffer in zero-copy mode, keep it alive as long as the reference:
+        //   the input is then released by both the Rate Control and the PA reference
+        if (sequence_control_set_ptr->static_config.zero_copy_input) {
+            eb_object_inc_live_count(
+                input_picture_wrapper_ptr,
+                2);
+            ((EbPaReferenceObject_t*)picture_control_set_ptr->pa_reference_picture_wrapper_ptr->object_ptr)->inputPictureWrapperPtr = input_picture_wrapper_ptr;
+        }
         // Get Empty Output Results Object
         if (picture_control_set_ptr->picture_number > 0 && (prevPictureControlSetWrapperPtr != NULL))
         {
-            ((PictureParentControlSet_t       *)prevPictureControlSetWrapperPtr->object_ptr)->end_of_sequence_flag = end_of_sequence_flag;
-            eb_get_empty_object(
-                context_ptr->resource_coordination_results_output_fifo_ptr,
-                &outputWrapperPtr);
-            outputResultsPtr = (ResourceCoordinationResults_t*)outputWrapperPtr->object_ptr;
-            outputResultsPtr->pictureControlSetWrapperPtr = prevPictureControlSetWrapperPtr;
-
-            // Post the finished Results Object
-            eb_post_full_object(outputWrapperPtr);
+            PictureParentControlSet_t *prevPictureControlSetPtr = (PictureParentControlSet_t*)prevPictureControlSetWrapperPtr->object_ptr;
+            uint32_t segment_index;
+
+            prevPictureControlSetPtr->end_of_sequence_flag = end_of_sequence_flag;
+
+            // Pad pictures to multiple min cu size
+            PadPictureToMultipleOfMinCuSizeDimensions(
+                prevPictureControlSetPtr->sequence_control_set_ptr,
+                prevPictureControlSetPtr->enhanced_picture_ptr);
+
+            for (segment_index = 0; segment_index < prevPictureControlSetPtr->pa_segments_total_count; ++segment_index) {
+                eb_get_empty_object(
+                    context_ptr->resource_coordination_results_output_fifo_ptr,
+                    &outputWrapperPtr);
+                outputResultsPtr = (ResourceCoordinationResults_t*)outputWrapperPtr->object_ptr;
+                outputResultsPtr->pictureControlSetWrapperPtr = prevPictureControlSetWrapperPtr;
+                outputResultsPtr->segment_index = segment_index;
+
+                // Post the finished Results Object
+                eb_post_full_object(outputWrapperPtr);
+            }
         }
         prevPictureControlSetWrapperPtr = pictureControlSetWrapperPtr;
     }
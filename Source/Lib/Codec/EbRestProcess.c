@@ -201,9 +201,12 @@ void   get_own_recon(
 #endif
 
 /******************************************************
- * Rest Kernel
+ * Rest Kernel Task
+ *   Processes one Cdef Results object
  ******************************************************/
-void* rest_kernel(void *input_ptr)
+void rest_kernel_task(
+    EbPtr                                    input_ptr,
+    EbObjectWrapper_t                       *cdef_results_wrapper_ptr)
 {
     // Context & SCS & PCS
     RestContext_t                            *context_ptr = (RestContext_t*)input_ptr;
@@ -211,7 +214,6 @@ void* rest_kernel(void *input_ptr)
     SequenceControlSet_t                    *sequence_control_set_ptr;
 
     //// Input
-    EbObjectWrapper_t                       *cdef_results_wrapper_ptr;
     CdefResults_t                         *cdef_results_ptr;
 
     //// Output
@@ -221,232 +223,231 @@ void* rest_kernel(void *input_ptr)
     PictureDemuxResults_t                   *picture_demux_results_rtr;
     // SB Loop variables
 
-
-    for (;;) {
-
-        // Get Cdef Results
-        eb_get_full_object(
-            context_ptr->rest_input_fifo_ptr,
-            &cdef_results_wrapper_ptr);
-
-        cdef_results_ptr = (CdefResults_t*)cdef_results_wrapper_ptr->object_ptr;
-        picture_control_set_ptr = (PictureControlSet_t*)cdef_results_ptr->picture_control_set_wrapper_ptr->object_ptr;
-        sequence_control_set_ptr = (SequenceControlSet_t*)picture_control_set_ptr->sequence_control_set_wrapper_ptr->object_ptr;
-        uint8_t lcuSizeLog2 = (uint8_t)Log2f(sequence_control_set_ptr->sb_size_pix);
-        EbBool  is16bit = (EbBool)(sequence_control_set_ptr->static_config.encoder_bit_depth > EB_8BIT);
-        Av1Common* cm = picture_control_set_ptr->parent_pcs_ptr->av1_cm;
+    cdef_results_ptr = (CdefResults_t*)cdef_results_wrapper_ptr->object_ptr;
+    picture_control_set_ptr = (PictureControlSet_t*)cdef_results_ptr->picture_control_set_wrapper_ptr->object_ptr;
+    sequence_control_set_ptr = (SequenceControlSet_t*)picture_control_set_ptr->sequence_control_set_wrapper_ptr->object_ptr;
+    uint8_t lcuSizeLog2 = (uint8_t)Log2f(sequence_control_set_ptr->sb_size_pix);
+    EbBool  is16bit = (EbBool)(sequence_control_set_ptr->static_config.encoder_bit_depth > EB_8BIT);
+    Av1Common* cm = picture_control_set_ptr->parent_pcs_ptr->av1_cm;
 
 #if  REST_M
 
-        if (sequence_control_set_ptr->enable_restoration)
-        {
-            get_own_recon(sequence_control_set_ptr, picture_control_set_ptr, context_ptr, is16bit);
-
-            Yv12BufferConfig cpi_source;
-            LinkEbToAomBufferDesc(
-                is16bit ? picture_control_set_ptr->input_frame16bit : picture_control_set_ptr->parent_pcs_ptr->enhanced_picture_ptr,
-                &cpi_source);
-
-            Yv12BufferConfig trial_frame_rst;
-            LinkEbToAomBufferDesc(
-                context_ptr->trial_frame_rst,
-                &trial_frame_rst);
-
-            Yv12BufferConfig org_fts;
-            LinkEbToAomBufferDesc(
-                context_ptr->org_rec_frame,
-                &org_fts);
-
-            restoration_seg_search(
-                context_ptr,
-                &org_fts,
-                &cpi_source,
-                &trial_frame_rst,
-                picture_control_set_ptr,
-                cdef_results_ptr->segment_index);
-        }
+    if (sequence_control_set_ptr->enable_restoration)
+    {
+        get_own_recon(sequence_control_set_ptr, picture_control_set_ptr, context_ptr, is16bit);
+
+        Yv12BufferConfig cpi_source;
+        LinkEbToAomBufferDesc(
+            is16bit ? picture_control_set_ptr->input_frame16bit : picture_control_set_ptr->parent_pcs_ptr->enhanced_picture_ptr,
+            &cpi_source);
+
+        Yv12BufferConfig trial_frame_rst;
+        LinkEbToAomBufferDesc(
+            context_ptr->trial_frame_rst,
+            &trial_frame_rst);
+
+        Yv12BufferConfig org_fts;
+        LinkEbToAomBufferDesc(
+            context_ptr->org_rec_frame,
+            &org_fts);
+
+        restoration_seg_search(
+            context_ptr,
+            &org_fts,
+            &cpi_source,
+            &trial_frame_rst,
+            picture_control_set_ptr,
+            cdef_results_ptr->segment_index);
+    }
 
-        //all seg based search is done. update total processed segments. if all done, finish the search and perfrom application.
-        eb_block_on_mutex(picture_control_set_ptr->rest_search_mutex);
+    //all seg based search is done. update total processed segments. if all done, finish the search and perfrom application.
+    eb_block_on_mutex(picture_control_set_ptr->rest_search_mutex);
 
-        picture_control_set_ptr->tot_seg_searched_rest++;
-        if (picture_control_set_ptr->tot_seg_searched_rest == picture_control_set_ptr->rest_segments_total_count)
-        {
+    picture_control_set_ptr->tot_seg_searched_rest++;
+    if (picture_control_set_ptr->tot_seg_searched_rest == picture_control_set_ptr->rest_segments_total_count)
+    {
 
 #endif
 
 
 
 #if REST_REF_ONLY
-            if (sequence_control_set_ptr->enable_restoration && picture_control_set_ptr->parent_pcs_ptr->is_used_as_reference_flag) {
+        if (sequence_control_set_ptr->enable_restoration && picture_control_set_ptr->parent_pcs_ptr->is_used_as_reference_flag) {
 #else
-            if (sequence_control_set_ptr->enable_restoration) {
+        if (sequence_control_set_ptr->enable_restoration) {
 #endif
 
 #if  !REST_M
-                av1_loop_restoration_save_boundary_lines(
-                    cm->frame_to_show,
-                    cm,
-                    1);
+            av1_loop_restoration_save_boundary_lines(
+                cm->frame_to_show,
+                cm,
+                1);
 
-                Yv12BufferConfig cpi_source;
-                LinkEbToAomBufferDesc(
-                    is16bit ? picture_control_set_ptr->input_frame16bit : picture_control_set_ptr->parent_pcs_ptr->enhanced_picture_ptr,
-                    &cpi_source);
+            Yv12BufferConfig cpi_source;
+            LinkEbToAomBufferDesc(
+                is16bit ? picture_control_set_ptr->input_frame16bit : picture_control_set_ptr->parent_pcs_ptr->enhanced_picture_ptr,
+                &cpi_source);
 
-                Yv12BufferConfig trial_frame_rst;
-                LinkEbToAomBufferDesc(
-                    context_ptr->trial_frame_rst,
-                    &trial_frame_rst);
+            Yv12BufferConfig trial_frame_rst;
+            LinkEbToAomBufferDesc(
+                context_ptr->trial_frame_rst,
+                &trial_frame_rst);
 
 
 #endif
 
 
 #if REST_M
-                rest_finish_search(
-                    picture_control_set_ptr->parent_pcs_ptr->av1x,
-                    picture_control_set_ptr->parent_pcs_ptr->av1_cm);
+            rest_finish_search(
+                picture_control_set_ptr->parent_pcs_ptr->av1x,
+                picture_control_set_ptr->parent_pcs_ptr->av1_cm);
 #else
-                av1_pick_filter_restoration(
-                    &cpi_source,
-                    &trial_frame_rst,
-                    picture_control_set_ptr->parent_pcs_ptr->av1x,
-                    picture_control_set_ptr->parent_pcs_ptr->av1_cm);
+            av1_pick_filter_restoration(
+                &cpi_source,
+                &trial_frame_rst,
+                picture_control_set_ptr->parent_pcs_ptr->av1x,
+                picture_control_set_ptr->parent_pcs_ptr->av1_cm);
 #endif
 
-                if (cm->rst_info[0].frame_restoration_type != RESTORE_NONE ||
-                    cm->rst_info[1].frame_restoration_type != RESTORE_NONE ||
-                    cm->rst_info[2].frame_restoration_type != RESTORE_NONE)
-                {
-                    av1_loop_restoration_filter_frame(
-                        cm->frame_to_show,
-                        cm,
-                        0);
-                }
-            }
-            else {
-                cm->rst_info[0].frame_restoration_type = RESTORE_NONE;
-                cm->rst_info[1].frame_restoration_type = RESTORE_NONE;
-                cm->rst_info[2].frame_restoration_type = RESTORE_NONE;
+            if (cm->rst_info[0].frame_restoration_type != RESTORE_NONE ||
+                cm->rst_info[1].frame_restoration_type != RESTORE_NONE ||
+                cm->rst_info[2].frame_restoration_type != RESTORE_NONE)
+            {
+                av1_loop_restoration_filter_frame(
+                    cm->frame_to_show,
+                    cm,
+                    0);
             }
+        }
+        else {
+            cm->rst_info[0].frame_restoration_type = RESTORE_NONE;
+            cm->rst_info[1].frame_restoration_type = RESTORE_NONE;
+            cm->rst_info[2].frame_restoration_type = RESTORE_NONE;
+        }
 
 #if FAST_SG
-            uint8_t best_ep_cnt = 0;
-            uint8_t best_ep = 0;
-            for (uint8_t i = 0; i < SGRPROJ_PARAMS; i++) {
-                if (cm->sg_frame_ep_cnt[i] > best_ep_cnt) {
-                    best_ep = i;
-                    best_ep_cnt = cm->sg_frame_ep_cnt[i];
-                }
+        uint8_t best_ep_cnt = 0;
+        uint8_t best_ep = 0;
+        for (uint8_t i = 0; i < SGRPROJ_PARAMS; i++) {
+            if (cm->sg_frame_ep_cnt[i] > best_ep_cnt) {
+                best_ep = i;
+                best_ep_cnt = cm->sg_frame_ep_cnt[i];
             }
-            cm->sg_frame_ep = best_ep;
+        }
+        cm->sg_frame_ep = best_ep;
 #endif
 
-            if (picture_control_set_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr != NULL) {
-                // copy stat to ref object (intra_coded_area, Luminance, Scene change detection flags)
-                CopyStatisticsToRefObject(
-                    picture_control_set_ptr,
-                    sequence_control_set_ptr);
-            }
+        // With frame_row_overlap, the reference object is set at dispatch and its rows
+        // published by the DLF process
+        if (picture_control_set_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr != NULL && !sequence_control_set_ptr->static_config.frame_row_overlap) {
+            // copy stat to ref object (intra_coded_area, Luminance, Scene change detection flags)
+            CopyStatisticsToRefObject(
+                picture_control_set_ptr,
+                sequence_control_set_ptr);
+        }
 
-            // PSNR Calculation
-            if (sequence_control_set_ptr->static_config.stat_report) {
-                PsnrCalculations(
-                    picture_control_set_ptr,
-                    sequence_control_set_ptr);
-            }
+        // PSNR Calculation
+        if (sequence_control_set_ptr->static_config.stat_report) {
+            PsnrCalculations(
+                picture_control_set_ptr,
+                sequence_control_set_ptr);
+        }
+
+        // Pad the reference picture and set up TMVP flag and ref POC
+        if (picture_control_set_ptr->parent_pcs_ptr->is_used_as_reference_flag == EB_TRUE && !sequence_control_set_ptr->static_config.frame_row_overlap)
+            PadRefAndSetFlags(
+                picture_control_set_ptr,
+                sequence_control_set_ptr);
 
-            // Pad the reference picture and set up TMVP flag and ref POC
-            if (picture_control_set_ptr->parent_pcs_ptr->is_used_as_reference_flag == EB_TRUE)
-                PadRefAndSetFlags(
-                    picture_control_set_ptr,
-                    sequence_control_set_ptr);
+        if (picture_control_set_ptr->parent_pcs_ptr->is_used_as_reference_flag == EB_TRUE && picture_control_set_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr && !sequence_control_set_ptr->static_config.frame_row_overlap)
+        {
+            EbPictureBufferDesc_t *input_picture_ptr = (EbPictureBufferDesc_t*)picture_control_set_ptr->parent_pcs_ptr->enhanced_picture_ptr;
+            const uint32_t  SrclumaOffSet = input_picture_ptr->origin_x + input_picture_ptr->origin_y    *input_picture_ptr->stride_y;
+            const uint32_t  SrccbOffset = (input_picture_ptr->origin_x >> 1) + (input_picture_ptr->origin_y >> 1)*input_picture_ptr->strideCb;
+            const uint32_t  SrccrOffset = (input_picture_ptr->origin_x >> 1) + (input_picture_ptr->origin_y >> 1)*input_picture_ptr->strideCr;
+
+            EbReferenceObject_t   *referenceObject = (EbReferenceObject_t*)picture_control_set_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr->object_ptr;
+            EbPictureBufferDesc_t *refDenPic = referenceObject->refDenSrcPicture;
+            const uint32_t           ReflumaOffSet = refDenPic->origin_x + refDenPic->origin_y    *refDenPic->stride_y;
+            const uint32_t           RefcbOffset = (refDenPic->origin_x >> 1) + (refDenPic->origin_y >> 1)*refDenPic->strideCb;
+            const uint32_t           RefcrOffset = (refDenPic->origin_x >> 1) + (refDenPic->origin_y >> 1)*refDenPic->strideCr;
+
+            uint16_t  verticalIdx;
 
-            if (picture_control_set_ptr->parent_pcs_ptr->is_used_as_reference_flag == EB_TRUE && picture_control_set_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr)
+            for (verticalIdx = 0; verticalIdx < refDenPic->height; ++verticalIdx)
             {
-                EbPictureBufferDesc_t *input_picture_ptr = (EbPictureBufferDesc_t*)picture_control_set_ptr->parent_pcs_ptr->enhanced_picture_ptr;
-                const uint32_t  SrclumaOffSet = input_picture_ptr->origin_x + input_picture_ptr->origin_y    *input_picture_ptr->stride_y;
-                const uint32_t  SrccbOffset = (input_picture_ptr->origin_x >> 1) + (input_picture_ptr->origin_y >> 1)*input_picture_ptr->strideCb;
-                const uint32_t  SrccrOffset = (input_picture_ptr->origin_x >> 1) + (input_picture_ptr->origin_y >> 1)*input_picture_ptr->strideCr;
-
-                EbReferenceObject_t   *referenceObject = (EbReferenceObject_t*)picture_control_set_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr->object_ptr;
-                EbPictureBufferDesc_t *refDenPic = referenceObject->refDenSrcPicture;
-                const uint32_t           ReflumaOffSet = refDenPic->origin_x + refDenPic->origin_y    *refDenPic->stride_y;
-                const uint32_t           RefcbOffset = (refDenPic->origin_x >> 1) + (refDenPic->origin_y >> 1)*refDenPic->strideCb;
-                const uint32_t           RefcrOffset = (refDenPic->origin_x >> 1) + (refDenPic->origin_y >> 1)*refDenPic->strideCr;
-
-                uint16_t  verticalIdx;
-
-                for (verticalIdx = 0; verticalIdx < refDenPic->height; ++verticalIdx)
-                {
-                    EB_MEMCPY(refDenPic->buffer_y + ReflumaOffSet + verticalIdx * refDenPic->stride_y,
-                        input_picture_ptr->buffer_y + SrclumaOffSet + verticalIdx * input_picture_ptr->stride_y,
-                        input_picture_ptr->width);
-                }
-
-                for (verticalIdx = 0; verticalIdx < input_picture_ptr->height / 2; ++verticalIdx)
-                {
-                    EB_MEMCPY(refDenPic->bufferCb + RefcbOffset + verticalIdx * refDenPic->strideCb,
-                        input_picture_ptr->bufferCb + SrccbOffset + verticalIdx * input_picture_ptr->strideCb,
-                        input_picture_ptr->width / 2);
-
-                    EB_MEMCPY(refDenPic->bufferCr + RefcrOffset + verticalIdx * refDenPic->strideCr,
-                        input_picture_ptr->bufferCr + SrccrOffset + verticalIdx * input_picture_ptr->strideCr,
-                        input_picture_ptr->width / 2);
-                }
-
-                generate_padding(
-                    refDenPic->buffer_y,
-                    refDenPic->stride_y,
-                    refDenPic->width,
-                    refDenPic->height,
-                    refDenPic->origin_x,
-                    refDenPic->origin_y);
-
-                generate_padding(
-                    refDenPic->bufferCb,
-                    refDenPic->strideCb,
-                    refDenPic->width >> 1,
-                    refDenPic->height >> 1,
-                    refDenPic->origin_x >> 1,
-                    refDenPic->origin_y >> 1);
-
-                generate_padding(
-                    refDenPic->bufferCr,
-                    refDenPic->strideCr,
-                    refDenPic->width >> 1,
-                    refDenPic->height >> 1,
-                    refDenPic->origin_x >> 1,
-                    refDenPic->origin_y >> 1);
+                EB_MEMCPY(refDenPic->buffer_y + ReflumaOffSet + verticalIdx * refDenPic->stride_y,
+                    input_picture_ptr->buffer_y + SrclumaOffSet + verticalIdx * input_picture_ptr->stride_y,
+                    input_picture_ptr->width);
             }
-            if (sequence_control_set_ptr->static_config.recon_enabled) {
-                ReconOutput(
-                    picture_control_set_ptr,
-                    sequence_control_set_ptr);
+
+            for (verticalIdx = 0; verticalIdx < input_picture_ptr->height / 2; ++verticalIdx)
+            {
+                EB_MEMCPY(refDenPic->bufferCb + RefcbOffset + verticalIdx * refDenPic->strideCb,
+                    input_picture_ptr->bufferCb + SrccbOffset + verticalIdx * input_picture_ptr->strideCb,
+                    input_picture_ptr->width / 2);
+
+                EB_MEMCPY(refDenPic->bufferCr + RefcrOffset + verticalIdx * refDenPic->strideCr,
+                    input_picture_ptr->bufferCr + SrccrOffset + verticalIdx * input_picture_ptr->strideCr,
+                    input_picture_ptr->width / 2);
             }
 
+            generate_padding(
+                refDenPic->buffer_y,
+                refDenPic->stride_y,
+                refDenPic->width,
+                refDenPic->height,
+                refDenPic->origin_x,
+                refDenPic->origin_y);
+
+            generate_padding(
+                refDenPic->bufferCb,
+                refDenPic->strideCb,
+                refDenPic->width >> 1,
+                refDenPic->height >> 1,
+                refDenPic->origin_x >> 1,
+                refDenPic->origin_y >> 1);
+
+            generate_padding(
+                refDenPic->bufferCr,
+                refDenPic->strideCr,
+                refDenPic->width >> 1,
+                refDenPic->height >> 1,
+                refDenPic->origin_x >> 1,
+                refDenPic->origin_y >> 1);
+        }
+        if (sequence_control_set_ptr->static_config.recon_enabled) {
+            ReconOutput(
+                picture_control_set_ptr,
+                sequence_control_set_ptr);
+        }
 
-            if (picture_control_set_ptr->parent_pcs_ptr->is_used_as_reference_flag)
-            {
 
-                // Get Empty PicMgr Results
-                eb_get_empty_object(
-                    context_ptr->picture_demux_fifo_ptr,
-                    &picture_demux_results_wrapper_ptr);
+        if (picture_control_set_ptr->parent_pcs_ptr->is_used_as_reference_flag)
+        {
 
-                picture_demux_results_rtr = (PictureDemuxResults_t*)picture_demux_results_wrapper_ptr->object_ptr;
-                picture_demux_results_rtr->reference_picture_wrapper_ptr = picture_control_set_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr;
-                picture_demux_results_rtr->sequence_control_set_wrapper_ptr = picture_control_set_ptr->sequence_control_set_wrapper_ptr;
-                picture_demux_results_rtr->picture_number = picture_control_set_ptr->picture_number;
-                picture_demux_results_rtr->pictureType = EB_PIC_REFERENCE;
+            // Get Empty PicMgr Results
+            eb_get_empty_object(
+                context_ptr->picture_demux_fifo_ptr,
+                &picture_demux_results_wrapper_ptr);
 
-                // Post Reference Picture
-                eb_post_full_object(picture_demux_results_wrapper_ptr);
-            }
+            picture_demux_results_rtr = (PictureDemuxResults_t*)picture_demux_results_wrapper_ptr->object_ptr;
+            picture_demux_results_rtr->reference_picture_wrapper_ptr = picture_control_set_ptr->parent_pcs_ptr->reference_picture_wrapper_ptr;
+            picture_demux_results_rtr->sequence_control_set_wrapper_ptr = picture_control_set_ptr->sequence_control_set_wrapper_ptr;
+            picture_demux_results_rtr->picture_number = picture_control_set_ptr->picture_number;
+            picture_demux_results_rtr->pictureType = EB_PIC_REFERENCE;
+
+            // Post Reference Picture
+            eb_post_full_object(picture_demux_results_wrapper_ptr);
+        }
 
 
 
+#if TILES
+        // One EC task per tile when the tiles are coded in parallel
+        for (uint32_t tile_index = 0; tile_index < picture_control_set_ptr->entropy_coding_tile_task_count; ++tile_index)
+#endif
+        {
             // Get Empty rest Results to EC
             eb_get_empty_object(
                 context_ptr->rest_output_fifo_ptr,
@@ -455,18 +456,41 @@ void* rest_kernel(void *input_ptr)
             rest_results_ptr->picture_control_set_wrapper_ptr = cdef_results_ptr->picture_control_set_wrapper_ptr;
             rest_results_ptr->completed_lcu_row_index_start = 0;
             rest_results_ptr->completed_lcu_row_count = ((sequence_control_set_ptr->luma_height + sequence_control_set_ptr->sb_size_pix - 1) >> lcuSizeLog2);
+#if TILES
+            rest_results_ptr->tile_index = tile_index;
+#endif
             // Post Rest Results
             eb_post_full_object(rest_results_wrapper_ptr);
+        }
 
 #if REST_M
-        }
-        eb_release_mutex(picture_control_set_ptr->rest_search_mutex);
+    }
+    eb_release_mutex(picture_control_set_ptr->rest_search_mutex);
 #endif
 
 
-        // Release input Results
-        eb_release_object(cdef_results_wrapper_ptr);
+    // Release input Results
+    eb_release_object(cdef_results_wrapper_ptr);
+}
+
+/******************************************************
+ * Rest Kernel
+ ******************************************************/
+void* rest_kernel(void *input_ptr)
+{
+    RestContext_t *context_ptr = (RestContext_t*)input_ptr;
+    EbObjectWrapper_t *cdef_results_wrapper_ptr;
+
+    for (;;) {
+
+        // Get Cdef Results
+        eb_get_full_object(
+            context_ptr->rest_input_fifo_ptr,
+            &cdef_results_wrapper_ptr);
 
+        rest_kernel_task(
+            context_ptr,
+            cdef_results_wrapper_ptr);
     }
 
     return EB_NULL;
@@ -54,4 +54,8 @@ extern EbErrorType rest_context_ctor(
 
 extern void* rest_kernel(void *input_ptr);
 
+extern void rest_kernel_task(
+    EbPtr                                    input_ptr,
+    EbObjectWrapper_t                       *cdef_results_wrapper_ptr);
+
 #endif
\ No newline at end of file
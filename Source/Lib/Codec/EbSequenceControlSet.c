@@ -55,6 +55,7 @@ EbErrorType eb_sequence_control_set_ctor(
         sequence_control_set_ptr->enc_dec_segment_col_count_array[segment_index] = 1;
         sequence_control_set_ptr->enc_dec_segment_row_count_array[segment_index] = 1;
     }
+    sequence_control_set_ptr->pa_segment_row_count = 1;
 
     // Encode Context
     if (scsInitData != EB_NULL) {
@@ -302,6 +303,11 @@ EbErrorType copy_sequence_control_set(
     dst->input_buffer_fifo_init_count = src->input_buffer_fifo_init_count; writeCount += sizeof(int32_t);
     dst->output_stream_buffer_fifo_init_count = src->output_stream_buffer_fifo_init_count; writeCount += sizeof(int32_t);
     dst->output_recon_buffer_fifo_init_count = src->output_recon_buffer_fifo_init_count; writeCount += sizeof(int32_t);
+    dst->picture_control_set_pool_min_count = src->picture_control_set_pool_min_count; writeCount += sizeof(int32_t);
+    dst->pa_reference_picture_buffer_min_count = src->pa_reference_picture_buffer_min_count; writeCount += sizeof(int32_t);
+    dst->reference_picture_buffer_min_count = src->reference_picture_buffer_min_count; writeCount += sizeof(int32_t);
+    dst->input_buffer_fifo_min_count = src->input_buffer_fifo_min_count; writeCount += sizeof(int32_t);
+    dst->buffer_ctor_thread_count = src->buffer_ctor_thread_count; writeCount += sizeof(int32_t);
     dst->resource_coordination_fifo_init_count = src->resource_coordination_fifo_init_count; writeCount += sizeof(int32_t);
     dst->picture_analysis_fifo_init_count = src->picture_analysis_fifo_init_count; writeCount += sizeof(int32_t);
     dst->picture_decision_fifo_init_count = src->picture_decision_fifo_init_count; writeCount += sizeof(int32_t);
@@ -331,6 +337,7 @@ EbErrorType copy_sequence_control_set(
         dst->enc_dec_segment_col_count_array[i] = src->enc_dec_segment_col_count_array[i];
         dst->enc_dec_segment_row_count_array[i] = src->enc_dec_segment_row_count_array[i];
     }
+    dst->pa_segment_row_count = src->pa_segment_row_count;
 
 #if CDEF_M
     dst->cdef_segment_column_count = src->cdef_segment_column_count;
@@ -129,6 +129,7 @@ extern "C" {
         uint32_t                                me_segment_row_count_array[MAX_TEMPORAL_LAYERS];
         uint32_t                                enc_dec_segment_col_count_array[MAX_TEMPORAL_LAYERS];
         uint32_t                                enc_dec_segment_row_count_array[MAX_TEMPORAL_LAYERS];
+        uint32_t                                pa_segment_row_count;
 #if CDEF_M
         uint32_t                                cdef_segment_column_count;
         uint32_t                                cdef_segment_row_count;
@@ -145,6 +146,16 @@ extern "C" {
         uint32_t                                input_buffer_fifo_init_count;
         uint32_t                                output_stream_buffer_fifo_init_count;
         uint32_t                                output_recon_buffer_fifo_init_count;
+#if TILES
+        uint32_t                                tile_output_buffer_fifo_init_count;  // low latency tile output: the tile groups of the pictures in flight
+#endif
+        // Pool sizes allocated at init when a memory budget is set
+        uint32_t                                picture_control_set_pool_min_count;
+        uint32_t                                pa_reference_picture_buffer_min_count;
+        uint32_t                                reference_picture_buffer_min_count;
+        uint32_t                                input_buffer_fifo_min_count;
+        // Threads constructing the picture pools at init
+        uint32_t                                buffer_ctor_thread_count;
         uint32_t                                resource_coordination_fifo_init_count;
         uint32_t                                picture_analysis_fifo_init_count;
         uint32_t                                picture_decision_fifo_init_count;
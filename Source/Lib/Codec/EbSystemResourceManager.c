@@ -4,8 +4,16 @@
 */
 
 #include <stdlib.h>
+#include <string.h>
+#include <emmintrin.h>
 
 #include "EbSystemResourceManager.h"
+#include "EbPipelineProfiler.h"
+
+// Queue implementation of the SystemResources constructed next by this thread
+static EB_THREAD_LOCAL EbBool lock_free_system_resource = EB_FALSE;
+// Threads constructing the objects of the SystemResources constructed next by this thread
+static EB_THREAD_LOCAL uint32_t ctor_thread_count_system_resource = 1;
 
 /**************************************
  * EbFifoCtor
@@ -18,11 +26,18 @@ static EbErrorType EbFifoCtor(
     EbObjectWrapper_t  *lastWrapperPtr,
     EbMuxingQueue_t    *queuePtr)
 {
-    // Create Counting Semaphore
-    EB_CREATESEMAPHORE(EbHandle, fifoPtr->countingSemaphore, sizeof(EbHandle), EB_SEMAPHORE, initial_count, max_count);
+    // Process fifos of a lock-free queue are only handles to the queue
+    if (queuePtr->lockFreeQueue) {
+        fifoPtr->countingSemaphore = (EbHandle)EB_NULL;
+        fifoPtr->lockoutMutex = (EbHandle)EB_NULL;
+    }
+    else {
+        // Create Counting Semaphore
+        EB_CREATESEMAPHORE(EbHandle, fifoPtr->countingSemaphore, sizeof(EbHandle), EB_SEMAPHORE, initial_count, max_count);
 
-    // Create Buffer Pool Mutex
-    EB_CREATEMUTEX(EbHandle, fifoPtr->lockoutMutex, sizeof(EbHandle), EB_MUTEX);
+        // Create Buffer Pool Mutex
+        EB_CREATEMUTEX(EbHandle, fifoPtr->lockoutMutex, sizeof(EbHandle), EB_MUTEX);
+    }
 
     // Initialize Fifo First & Last ptrs
     fifoPtr->firstPtr = firstWrapperPtr;
@@ -31,6 +46,8 @@ static EbErrorType EbFifoCtor(
     // Copy the Muxing Queue ptr this Fifo belongs to
     fifoPtr->queuePtr = queuePtr;
 
+    fifoPtr->notifySemaphore = (EbHandle)EB_NULL;
+
     return EB_ErrorNone;
 }
 
@@ -185,6 +202,153 @@ static EbErrorType EbCircularBufferPushFront(
     return return_error;
 }
 
+/**************************************
+ * LockFreeQueueBackoff
+ *   The thread owning a claimed cell may have
+ *   been preempted: stop spinning after a while.
+ **************************************/
+#define LOCK_FREE_QUEUE_SPIN_COUNT  64
+
+static void LockFreeQueueBackoff(
+    uint32_t *spinIndex)
+{
+    if (++(*spinIndex) < LOCK_FREE_QUEUE_SPIN_COUNT)
+        _mm_pause();
+    else
+        eb_yield_thread();
+}
+
+/**************************************
+ * EbLockFreeQueueCtor
+ **************************************/
+static EbErrorType EbLockFreeQueueCtor(
+    EbLockFreeQueue_t   **queueDblPtr,
+    uint32_t              object_total_count,
+    EbBool                lifo)
+{
+    EbLockFreeQueue_t *queuePtr;
+    uint32_t cellCount = 1;
+    uint32_t cellIndex;
+
+    EB_MALLOC(EbLockFreeQueue_t*, queuePtr, sizeof(EbLockFreeQueue_t), EB_N_PTR);
+    *queueDblPtr = queuePtr;
+
+    // Power of two so that the tickets wrap around with the cell index
+    while (cellCount < object_total_count)
+        cellCount <<= 1;
+    queuePtr->cellMask = cellCount - 1;
+
+    EB_MALLOC(EbLockFreeCell_t*, queuePtr->cellArray, sizeof(EbLockFreeCell_t) * cellCount, EB_N_PTR);
+
+    for (cellIndex = 0; cellIndex < cellCount; ++cellIndex) {
+        queuePtr->cellArray[cellIndex].sequence = cellIndex;
+        queuePtr->cellArray[cellIndex].wrapper_ptr = (EbObjectWrapper_t*)EB_NULL;
+    }
+
+    queuePtr->enqueueIndex = 0;
+    queuePtr->dequeueIndex = 0;
+    queuePtr->lifo = lifo;
+    queuePtr->stackHead = 0;
+
+    return eb_light_semaphore_ctor(
+        &queuePtr->countingSemaphore,
+        0);
+}
+
+/**************************************
+ * EbLockFreeQueuePushBack
+ *   Never full: a queue holds at most the objects of its
+ *   SystemResource.
+ **************************************/
+static void EbLockFreeQueuePushBack(
+    EbLockFreeQueue_t    *queuePtr,
+    EbObjectWrapper_t    *wrapper_ptr)
+{
+    uint32_t ticket;
+    EbLockFreeCell_t *cellPtr;
+    uint32_t spinIndex = 0;
+
+    EB_ATOMIC_ADD(&wrapper_ptr->queuedCount, 1);
+
+    ticket = EB_ATOMIC_ADD(&queuePtr->enqueueIndex, 1);
+    cellPtr = &queuePtr->cellArray[ticket & queuePtr->cellMask];
+
+    // Wait for the consumer of the previous lap to read the cell back
+    while (EB_ATOMIC_LOAD(&cellPtr->sequence) != ticket)
+        LockFreeQueueBackoff(&spinIndex);
+
+    cellPtr->wrapper_ptr = wrapper_ptr;
+    EB_ATOMIC_STORE(&cellPtr->sequence, ticket + 1);
+
+    eb_light_semaphore_post(&queuePtr->countingSemaphore);
+}
+
+/**************************************
+ * EbLockFreeQueuePushFront
+ *   Lifo queues only.
+ **************************************/
+static void EbLockFreeQueuePushFront(
+    EbLockFreeQueue_t    *queuePtr,
+    EbObjectWrapper_t    *wrapper_ptr)
+{
+    EbLockFreeCell_t *cellPtr = &queuePtr->cellArray[wrapper_ptr->poolIndex];
+    uint64_t stackHead;
+
+    EB_ATOMIC_ADD(&wrapper_ptr->queuedCount, 1);
+
+    cellPtr->wrapper_ptr = wrapper_ptr;
+
+    // The tag changes on every push and pop, so that a pop cannot
+    //   succeed with the link of a cell popped and pushed meanwhile
+    do {
+        stackHead = EB_ATOMIC_LOAD64(&queuePtr->stackHead);
+        EB_ATOMIC_STORE(&cellPtr->sequence, (uint32_t)stackHead);
+    } while (!EB_ATOMIC_CAS64(&queuePtr->stackHead, stackHead, (((stackHead >> 32) + 1) << 32) | (wrapper_ptr->poolIndex + 1)));
+
+    eb_light_semaphore_post(&queuePtr->countingSemaphore);
+}
+
+/**************************************
+ * EbLockFreeQueuePopFront
+ *   The caller must own a countingSemaphore token.
+ **************************************/
+static EbObjectWrapper_t *EbLockFreeQueuePopFront(
+    EbLockFreeQueue_t    *queuePtr)
+{
+    uint32_t ticket;
+    EbLockFreeCell_t *cellPtr;
+    EbObjectWrapper_t *wrapper_ptr;
+    uint32_t spinIndex = 0;
+
+    if (queuePtr->lifo) {
+        uint64_t stackHead;
+
+        // The token guarantees a cell on the stack
+        do {
+            stackHead = EB_ATOMIC_LOAD64(&queuePtr->stackHead);
+            cellPtr = &queuePtr->cellArray[(uint32_t)stackHead - 1];
+        } while (!EB_ATOMIC_CAS64(&queuePtr->stackHead, stackHead, (((stackHead >> 32) + 1) << 32) | EB_ATOMIC_LOAD(&cellPtr->sequence)));
+
+        wrapper_ptr = cellPtr->wrapper_ptr;
+        EB_ATOMIC_ADD(&wrapper_ptr->queuedCount, -1);
+
+        return wrapper_ptr;
+    }
+
+    ticket = EB_ATOMIC_ADD(&queuePtr->dequeueIndex, 1);
+    cellPtr = &queuePtr->cellArray[ticket & queuePtr->cellMask];
+
+    // Wait for the producer of this ticket to finish writing the cell
+    while (EB_ATOMIC_LOAD(&cellPtr->sequence) != ticket + 1)
+        LockFreeQueueBackoff(&spinIndex);
+
+    wrapper_ptr = cellPtr->wrapper_ptr;
+    EB_ATOMIC_STORE(&cellPtr->sequence, ticket + queuePtr->cellMask + 1);
+    EB_ATOMIC_ADD(&wrapper_ptr->queuedCount, -1);
+
+    return wrapper_ptr;
+}
+
 /**************************************
  * EbMuxingQueueCtor
  **************************************/
@@ -192,7 +356,8 @@ static EbErrorType EbMuxingQueueCtor(
     EbMuxingQueue_t   **queueDblPtr,
     uint32_t              object_total_count,
     uint32_t              processTotalCount,
-    EbFifo_t         ***processFifoPtrArrayPtr)
+    EbFifo_t         ***processFifoPtrArrayPtr,
+    EbBool                lifo)
 {
     EbMuxingQueue_t *queuePtr;
     uint32_t processIndex;
@@ -202,23 +367,44 @@ static EbErrorType EbMuxingQueueCtor(
     *queueDblPtr = queuePtr;
 
     queuePtr->processTotalCount = processTotalCount;
+    queuePtr->notifySemaphore = (EbHandle)EB_NULL;
+    queuePtr->profilerPtr = (struct EbPipelineProfiler_s*)EB_NULL;
+    queuePtr->profilerStage = 0;
+    queuePtr->elasticResourcePtr = (struct EbSystemResource_s*)EB_NULL;
 
     // Lockout Mutex
     EB_CREATEMUTEX(EbHandle, queuePtr->lockoutMutex, sizeof(EbHandle), EB_MUTEX);
 
-    // Construct Object Circular Buffer
-    return_error = EbCircularBufferCtor(
-        &queuePtr->objectQueue,
-        object_total_count);
-    if (return_error == EB_ErrorInsufficientResources) {
-        return EB_ErrorInsufficientResources;
+    if (lock_free_system_resource) {
+        queuePtr->objectQueue = (EbCircularBuffer_t*)EB_NULL;
+        queuePtr->processQueue = (EbCircularBuffer_t*)EB_NULL;
+
+        // Construct the Lock-free Queue
+        return_error = EbLockFreeQueueCtor(
+            &queuePtr->lockFreeQueue,
+            object_total_count,
+            lifo);
+        if (return_error == EB_ErrorInsufficientResources) {
+            return EB_ErrorInsufficientResources;
+        }
     }
-    // Construct Process Circular Buffer
-    return_error = EbCircularBufferCtor(
-        &queuePtr->processQueue,
-        queuePtr->processTotalCount);
-    if (return_error == EB_ErrorInsufficientResources) {
-        return EB_ErrorInsufficientResources;
+    else {
+        queuePtr->lockFreeQueue = (EbLockFreeQueue_t*)EB_NULL;
+
+        // Construct Object Circular Buffer
+        return_error = EbCircularBufferCtor(
+            &queuePtr->objectQueue,
+            object_total_count);
+        if (return_error == EB_ErrorInsufficientResources) {
+            return EB_ErrorInsufficientResources;
+        }
+        // Construct Process Circular Buffer
+        return_error = EbCircularBufferCtor(
+            &queuePtr->processQueue,
+            queuePtr->processTotalCount);
+        if (return_error == EB_ErrorInsufficientResources) {
+            return EB_ErrorInsufficientResources;
+        }
     }
     // Construct the Process Fifos
     EB_MALLOC(EbFifo_t**, queuePtr->processFifoPtrArray, sizeof(EbFifo_t*) * queuePtr->processTotalCount, EB_N_PTR);
@@ -278,6 +464,9 @@ static EbErrorType EbMuxingQueueAssignation(
 
         // Post the semaphore
         eb_post_semaphore(processFifoPtr->countingSemaphore);
+
+        if (processFifoPtr->notifySemaphore)
+            eb_post_semaphore(processFifoPtr->notifySemaphore);
     }
 
     return return_error;
@@ -292,6 +481,17 @@ static EbErrorType EbMuxingQueueObjectPushBack(
 {
     EbErrorType return_error = EB_ErrorNone;
 
+    if (queuePtr->lockFreeQueue) {
+        EbLockFreeQueuePushBack(
+            queuePtr->lockFreeQueue,
+            object_ptr);
+
+        if (queuePtr->notifySemaphore)
+            eb_post_semaphore(queuePtr->notifySemaphore);
+
+        return return_error;
+    }
+
     EbCircularBufferPushBack(
         queuePtr->objectQueue,
         object_ptr);
@@ -310,6 +510,17 @@ static EbErrorType EbMuxingQueueObjectPushFront(
 {
     EbErrorType return_error = EB_ErrorNone;
 
+    if (queuePtr->lockFreeQueue) {
+        EbLockFreeQueuePushFront(
+            queuePtr->lockFreeQueue,
+            object_ptr);
+
+        if (queuePtr->notifySemaphore)
+            eb_post_semaphore(queuePtr->notifySemaphore);
+
+        return return_error;
+    }
+
     EbCircularBufferPushFront(
         queuePtr->objectQueue,
         object_ptr);
@@ -405,45 +616,211 @@ EbErrorType eb_object_inc_live_count(
 }
 
 /*********************************************************************
- * eb_system_resource_ctor
- *   Constructor for EbSystemResource.  Fully constructs all members
- *   of EbSystemResource including the object with the passed
- *   object_ctor function.
- *
- *   resource_ptr
- *     pointer that will contain the SystemResource to be constructed.
- *
- *   object_total_count
- *     Number of objects to be managed by the SystemResource.
- *
- *   full_fifo_enabled
- *     Bool that describes if the SystemResource is to have an output
- *     fifo.  An outputFifo is not used by certain objects (e.g.
- *     SequenceControlSet).
- *
- *   object_ctor
- *     Function pointer to the constructor of the object managed by
- *     SystemResource referenced by resource_ptr. No object level
- *     construction is performed if object_ctor is NULL.
- *
- *   object_init_data_ptr
+ * eb_system_resource_set_lock_free
+ *********************************************************************/
+void eb_system_resource_set_lock_free(
+    EbBool   lock_free)
+{
+    lock_free_system_resource = lock_free;
+}
 
- *     pointer to data block to be used during the construction of
- *     the object. object_init_data_ptr is passed to object_ctor when
- *     object_ctor is called.
+/*********************************************************************
+ * eb_system_resource_set_ctor_thread_count
  *********************************************************************/
-EbErrorType eb_system_resource_ctor(
+void eb_system_resource_set_ctor_thread_count(
+    uint32_t thread_count)
+{
+    ctor_thread_count_system_resource = thread_count ? thread_count : 1;
+}
+
+/*********************************************************************
+ * eb_system_resource_set_release_callback
+ *********************************************************************/
+void eb_system_resource_set_release_callback(
+    EbSystemResource_t      *resource_ptr,
+    EbObjectReleaseCallback  release_callback,
+    void                    *callback_ctx)
+{
+    resource_ptr->releaseCallback = release_callback;
+    resource_ptr->releaseCallbackCtx = callback_ctx;
+}
+
+/*********************************************************************
+ * SystemResourceConstructObjects
+ *   Constructs the objects of the wrappers [begin_index, end_index)
+ *   into the memory map of the calling thread.
+ *********************************************************************/
+static EbErrorType SystemResourceConstructObjects(
+    EbSystemResource_t *resource_ptr,
+    uint32_t            begin_index,
+    uint32_t            end_index)
+{
+    uint32_t wrapperIndex;
+    EbErrorType return_error = EB_ErrorNone;
+
+    for (wrapperIndex = begin_index; wrapperIndex < end_index; ++wrapperIndex) {
+        return_error = resource_ptr->objectCtor(
+            &resource_ptr->wrapperPtrPool[wrapperIndex]->object_ptr,
+            resource_ptr->objectInitDataPtr);
+        if (return_error == EB_ErrorInsufficientResources)
+            break;
+    }
+
+    return return_error;
+}
+
+/*********************************************************************
+ * SystemResourceCtorWorker
+ *   Share of the objects constructed by one thread. The allocations
+ *   are recorded in a private memory map, merged into the map of the
+ *   SystemResource once the thread is done.
+ *********************************************************************/
+typedef struct SystemResourceCtorWorker_s {
+    EbSystemResource_t *resource_ptr;
+    uint32_t            begin_index;
+    uint32_t            end_index;
+    EbMemoryMap         memoryMap;
+    EbErrorType         return_error;
+    EbHandle            done_semaphore;
+    EbHandle            thread_handle;
+} SystemResourceCtorWorker_t;
+
+static void *SystemResourceCtorKernel(void *input_ptr)
+{
+    SystemResourceCtorWorker_t *worker_ptr = (SystemResourceCtorWorker_t*)input_ptr;
+    EbMemoryMap *callerMemoryMap = memory_map;
+
+    memory_map = &worker_ptr->memoryMap;
+    worker_ptr->return_error = worker_ptr->memoryMap.entries ?
+        SystemResourceConstructObjects(worker_ptr->resource_ptr, worker_ptr->begin_index, worker_ptr->end_index) :
+        EB_ErrorInsufficientResources;
+    memory_map = callerMemoryMap;
+
+    eb_post_semaphore(worker_ptr->done_semaphore);
+
+    return EB_NULL;
+}
+
+/*********************************************************************
+ * SystemResourceParallelConstructObjects
+ *   Splits the objects of the wrappers [begin_index, end_index)
+ *   across ctor_thread_count_system_resource threads, the calling
+ *   thread included. Every object takes the memory map entries
+ *   measured on the first object of the SystemResource.
+ *********************************************************************/
+static EbErrorType SystemResourceParallelConstructObjects(
+    EbSystemResource_t *resource_ptr,
+    uint32_t            begin_index,
+    uint32_t            end_index)
+{
+    SystemResourceCtorWorker_t *workerArray;
+    EbHandle doneSemaphore;
+    uint32_t workerCount = ctor_thread_count_system_resource;
+    uint32_t workerIndex;
+    uint32_t objectIndex = begin_index;
+    EbErrorType return_error = EB_ErrorNone;
+
+    if (workerCount > end_index - begin_index)
+        workerCount = end_index - begin_index;
+    if (workerCount <= 1 || resource_ptr->objectMemoryEntryCount == 0)
+        return SystemResourceConstructObjects(resource_ptr, begin_index, end_index);
+
+    workerArray = (SystemResourceCtorWorker_t*)calloc(workerCount, sizeof(SystemResourceCtorWorker_t));
+    doneSemaphore = eb_create_semaphore(0, workerCount);
+    if (workerArray == (SystemResourceCtorWorker_t*)EB_NULL || doneSemaphore == (EbHandle)EB_NULL) {
+        free(workerArray);
+        if (doneSemaphore)
+            eb_destroy_semaphore(doneSemaphore);
+        return SystemResourceConstructObjects(resource_ptr, begin_index, end_index);
+    }
+
+    for (workerIndex = 0; workerIndex < workerCount; ++workerIndex) {
+        SystemResourceCtorWorker_t *worker_ptr = &workerArray[workerIndex];
+        const uint32_t objectCount = (end_index - objectIndex) / (workerCount - workerIndex);
+
+        worker_ptr->resource_ptr = resource_ptr;
+        worker_ptr->begin_index = objectIndex;
+        worker_ptr->end_index = objectIndex + objectCount;
+        worker_ptr->done_semaphore = doneSemaphore;
+        objectIndex += objectCount;
+    }
+
+    // Worker 0 is the calling thread
+    for (workerIndex = 1; workerIndex < workerCount; ++workerIndex) {
+        SystemResourceCtorWorker_t *worker_ptr = &workerArray[workerIndex];
+
+        worker_ptr->memoryMap.entries = (EbMemoryMapEntry*)malloc(sizeof(EbMemoryMapEntry) *
+            resource_ptr->objectMemoryEntryCount * (worker_ptr->end_index - worker_ptr->begin_index));
+        worker_ptr->memoryMap.capacity = worker_ptr->memoryMap.entries ?
+            resource_ptr->objectMemoryEntryCount * (worker_ptr->end_index - worker_ptr->begin_index) : 0;
+        // Bound like the encoder threads, so that the objects are first
+        //   touched on the processors (NUMA node) that use them
+        worker_ptr->thread_handle = eb_create_thread(SystemResourceCtorKernel, worker_ptr);
+        if (worker_ptr->thread_handle == (EbHandle)EB_NULL)
+            SystemResourceCtorKernel(worker_ptr);
+        else
+            eb_set_thread_affinity(worker_ptr->thread_handle);
+    }
+    workerArray[0].return_error = SystemResourceConstructObjects(resource_ptr, workerArray[0].begin_index, workerArray[0].end_index);
+
+    for (workerIndex = 1; workerIndex < workerCount; ++workerIndex)
+        eb_block_on_semaphore(doneSemaphore);
+    for (workerIndex = 1; workerIndex < workerCount; ++workerIndex) {
+        if (workerArray[workerIndex].thread_handle)
+            eb_destroy_thread(workerArray[workerIndex].thread_handle);
+    }
+    eb_destroy_semaphore(doneSemaphore);
+
+    return_error = workerArray[0].return_error;
+    for (workerIndex = 1; workerIndex < workerCount; ++workerIndex) {
+        EbMemoryMap *workerMemoryMap = &workerArray[workerIndex].memoryMap;
+
+        if (workerArray[workerIndex].return_error != EB_ErrorNone)
+            return_error = workerArray[workerIndex].return_error;
+
+        // The SystemResource owns the objects from now on
+        if (workerMemoryMap->index <= memory_map->capacity - memory_map->index) {
+            memcpy(&memory_map->entries[memory_map->index], workerMemoryMap->entries, sizeof(EbMemoryMapEntry) * workerMemoryMap->index);
+            memory_map->index += workerMemoryMap->index;
+            memory_map->total_lib_memory += workerMemoryMap->total_lib_memory;
+            memory_map->malloc_count += workerMemoryMap->malloc_count;
+            memory_map->semaphore_count += workerMemoryMap->semaphore_count;
+            memory_map->mutex_count += workerMemoryMap->mutex_count;
+        }
+        else {
+            eb_memory_map_release(workerMemoryMap);
+            return_error = EB_ErrorInsufficientResources;
+        }
+        free(workerMemoryMap->entries);
+    }
+    free(workerArray);
+
+    return return_error;
+}
+
+/*********************************************************************
+ * SystemResourceCtor
+ *   Constructs the first object_initial_count objects, the others
+ *   when the SystemResource is elastic (memory_budget_ptr not NULL).
+ *   The objects after the first one are constructed by
+ *   ctor_thread_count_system_resource threads.
+ *********************************************************************/
+static EbErrorType SystemResourceCtor(
     EbSystemResource_t **resource_dbl_ptr,
     uint32_t               object_total_count,
+    uint32_t               object_initial_count,
     uint32_t               producer_process_total_count,
     uint32_t               consumer_process_total_count,
     EbFifo_t          ***producer_fifo_ptr_array_ptr,
     EbFifo_t          ***consumer_fifo_ptr_array_ptr,
     EbBool              full_fifo_enabled,
     EB_CTOR              object_ctor,
-    EbPtr               object_init_data_ptr)
+    EbPtr               object_init_data_ptr,
+    EbMemoryBudget_t   *memory_budget_ptr)
 {
     uint32_t wrapperIndex;
+    uint32_t memoryEntryIndex = 0;
+    uint64_t memorySize = 0;
     EbErrorType return_error = EB_ErrorNone;
     // Allocate the System Resource
     EbSystemResource_t *resource_ptr;
@@ -452,6 +829,20 @@ EbErrorType eb_system_resource_ctor(
     *resource_dbl_ptr = resource_ptr;
 
     resource_ptr->object_total_count = object_total_count;
+    resource_ptr->releaseCallback = (EbObjectReleaseCallback)EB_NULL;
+    resource_ptr->releaseCallbackCtx = EB_NULL;
+
+    resource_ptr->memoryBudgetPtr = memory_budget_ptr;
+    resource_ptr->elasticMutex = (EbHandle)EB_NULL;
+    resource_ptr->objectCtor = object_ctor;
+    resource_ptr->objectInitDataPtr = object_init_data_ptr;
+    resource_ptr->objectInitialCount = object_initial_count;
+    resource_ptr->objectMemoryEntryCount = 0;
+    resource_ptr->objectSize = 0;
+    resource_ptr->spareWrapperPtrArray = (EbObjectWrapper_t**)EB_NULL;
+    resource_ptr->spareWrapperCount = 0;
+    resource_ptr->idleGetCount = 0;
+    resource_ptr->idleMinEmptyCount = ~0u;
 
     // Allocate array for wrapper pointers
     EB_MALLOC(EbObjectWrapper_t**, resource_ptr->wrapperPtrPool, sizeof(EbObjectWrapper_t*) * resource_ptr->object_total_count, EB_N_PTR);
@@ -462,15 +853,33 @@ EbErrorType eb_system_resource_ctor(
         resource_ptr->wrapperPtrPool[wrapperIndex]->liveCount = 0;
         resource_ptr->wrapperPtrPool[wrapperIndex]->releaseEnable = EB_TRUE;
         resource_ptr->wrapperPtrPool[wrapperIndex]->systemResourcePtr = resource_ptr;
+        resource_ptr->wrapperPtrPool[wrapperIndex]->elasticObjectPtr = (EbElasticObject_t*)EB_NULL;
+        resource_ptr->wrapperPtrPool[wrapperIndex]->object_ptr = EB_NULL;
+        resource_ptr->wrapperPtrPool[wrapperIndex]->poolIndex = wrapperIndex;
+        resource_ptr->wrapperPtrPool[wrapperIndex]->queuedCount = 0;
+    }
 
-        // Call the Constructor for each element
-        if (object_ctor) {
-            return_error = object_ctor(
-                &resource_ptr->wrapperPtrPool[wrapperIndex]->object_ptr,
-                object_init_data_ptr);
-            if (return_error == EB_ErrorInsufficientResources) {
-                return EB_ErrorInsufficientResources;
-            }
+    // Call the Constructor for each element, the others are constructed on demand
+    if (object_ctor && object_initial_count) {
+        memoryEntryIndex = memory_map->index;
+        memorySize = memory_map->total_lib_memory;
+
+        return_error = object_ctor(
+            &resource_ptr->wrapperPtrPool[0]->object_ptr,
+            object_init_data_ptr);
+        if (return_error == EB_ErrorInsufficientResources) {
+            return EB_ErrorInsufficientResources;
+        }
+
+        resource_ptr->objectMemoryEntryCount = memory_map->index - memoryEntryIndex;
+        resource_ptr->objectSize = memory_map->total_lib_memory - memorySize;
+
+        return_error = SystemResourceParallelConstructObjects(
+            resource_ptr,
+            1,
+            object_initial_count);
+        if (return_error == EB_ErrorInsufficientResources) {
+            return EB_ErrorInsufficientResources;
         }
     }
 
@@ -479,15 +888,26 @@ EbErrorType eb_system_resource_ctor(
         &resource_ptr->emptyQueue,
         resource_ptr->object_total_count,
         producer_process_total_count,
-        producer_fifo_ptr_array_ptr);
+        producer_fifo_ptr_array_ptr,
+        EB_TRUE);
     if (return_error == EB_ErrorInsufficientResources) {
         return EB_ErrorInsufficientResources;
     }
-    // Fill the Empty Fifo with every ObjectWrapper
-    for (wrapperIndex = 0; wrapperIndex < resource_ptr->object_total_count; ++wrapperIndex) {
-        EbMuxingQueueObjectPushBack(
+    // Fill the Empty Fifo with every constructed ObjectWrapper
+    for (wrapperIndex = object_initial_count; wrapperIndex > 0; --wrapperIndex) {
+        EbMuxingQueueObjectPushFront(
             resource_ptr->emptyQueue,
-            resource_ptr->wrapperPtrPool[wrapperIndex]);
+            resource_ptr->wrapperPtrPool[wrapperIndex - 1]);
+    }
+
+    if (memory_budget_ptr) {
+        EB_CREATEMUTEX(EbHandle, resource_ptr->elasticMutex, sizeof(EbHandle), EB_MUTEX);
+
+        EB_MALLOC(EbObjectWrapper_t**, resource_ptr->spareWrapperPtrArray, sizeof(EbObjectWrapper_t*) * resource_ptr->object_total_count, EB_N_PTR);
+        for (wrapperIndex = object_total_count; wrapperIndex > object_initial_count; --wrapperIndex)
+            resource_ptr->spareWrapperPtrArray[resource_ptr->spareWrapperCount++] = resource_ptr->wrapperPtrPool[wrapperIndex - 1];
+
+        resource_ptr->emptyQueue->elasticResourcePtr = resource_ptr;
     }
 
     // Initialize the Full Queue
@@ -496,7 +916,8 @@ EbErrorType eb_system_resource_ctor(
             &resource_ptr->fullQueue,
             resource_ptr->object_total_count,
             consumer_process_total_count,
-            consumer_fifo_ptr_array_ptr);
+            consumer_fifo_ptr_array_ptr,
+            EB_FALSE);
         if (return_error == EB_ErrorInsufficientResources) {
             return EB_ErrorInsufficientResources;
         }
@@ -509,6 +930,341 @@ EbErrorType eb_system_resource_ctor(
     return return_error;
 }
 
+/*********************************************************************
+ * eb_system_resource_ctor
+ *   Constructor for EbSystemResource.  Fully constructs all members
+ *   of EbSystemResource including the object with the passed
+ *   object_ctor function.
+ *
+ *   resource_ptr
+ *     pointer that will contain the SystemResource to be constructed.
+ *
+ *   object_total_count
+ *     Number of objects to be managed by the SystemResource.
+ *
+ *   full_fifo_enabled
+ *     Bool that describes if the SystemResource is to have an output
+ *     fifo.  An outputFifo is not used by certain objects (e.g.
+ *     SequenceControlSet).
+ *
+ *   object_ctor
+ *     Function pointer to the constructor of the object managed by
+ *     SystemResource referenced by resource_ptr. No object level
+ *     construction is performed if object_ctor is NULL.
+ *
+ *   object_init_data_ptr
+
+ *     pointer to data block to be used during the construction of
+ *     the object. object_init_data_ptr is passed to object_ctor when
+ *     object_ctor is called.
+ *********************************************************************/
+EbErrorType eb_system_resource_ctor(
+    EbSystemResource_t **resource_dbl_ptr,
+    uint32_t               object_total_count,
+    uint32_t               producer_process_total_count,
+    uint32_t               consumer_process_total_count,
+    EbFifo_t          ***producer_fifo_ptr_array_ptr,
+    EbFifo_t          ***consumer_fifo_ptr_array_ptr,
+    EbBool              full_fifo_enabled,
+    EB_CTOR              object_ctor,
+    EbPtr               object_init_data_ptr)
+{
+    return SystemResourceCtor(
+        resource_dbl_ptr,
+        object_total_count,
+        object_total_count,
+        producer_process_total_count,
+        consumer_process_total_count,
+        producer_fifo_ptr_array_ptr,
+        consumer_fifo_ptr_array_ptr,
+        full_fifo_enabled,
+        object_ctor,
+        object_init_data_ptr,
+        (EbMemoryBudget_t*)EB_NULL);
+}
+
+/*********************************************************************
+ * eb_system_resource_elastic_ctor
+ *********************************************************************/
+EbErrorType eb_system_resource_elastic_ctor(
+    EbSystemResource_t **resource_dbl_ptr,
+    uint32_t               object_total_count,
+    uint32_t               object_initial_count,
+    uint32_t               producer_process_total_count,
+    uint32_t               consumer_process_total_count,
+    EbFifo_t          ***producer_fifo_ptr_array_ptr,
+    EbFifo_t          ***consumer_fifo_ptr_array_ptr,
+    EbBool              full_fifo_enabled,
+    EB_CTOR              object_ctor,
+    EbPtr               object_init_data_ptr,
+    uint32_t               object_init_data_size,
+    EbMemoryBudget_t   *memory_budget_ptr)
+{
+    EbPtr initDataCopyPtr = object_init_data_ptr;
+
+    // At least one object is constructed up front to measure it
+    if (object_initial_count == 0)
+        object_initial_count = 1;
+    if (object_initial_count > object_total_count)
+        object_initial_count = object_total_count;
+
+    if (object_ctor == (EB_CTOR)EB_NULL || !lock_free_system_resource || object_initial_count == object_total_count)
+        memory_budget_ptr = (EbMemoryBudget_t*)EB_NULL;
+
+    if (memory_budget_ptr == (EbMemoryBudget_t*)EB_NULL)
+        object_initial_count = object_total_count;
+    else if (object_init_data_size) {
+        // The init data of the caller does not outlive the init
+        EB_MALLOC(EbPtr, initDataCopyPtr, object_init_data_size, EB_N_PTR);
+        memcpy(initDataCopyPtr, object_init_data_ptr, object_init_data_size);
+    }
+
+    return SystemResourceCtor(
+        resource_dbl_ptr,
+        object_total_count,
+        object_initial_count,
+        producer_process_total_count,
+        consumer_process_total_count,
+        producer_fifo_ptr_array_ptr,
+        consumer_fifo_ptr_array_ptr,
+        full_fifo_enabled,
+        object_ctor,
+        initDataCopyPtr,
+        memory_budget_ptr);
+}
+
+/*********************************************************************
+ * eb_memory_budget_ctor
+ *********************************************************************/
+EbErrorType eb_memory_budget_ctor(
+    EbMemoryBudget_t  **budget_dbl_ptr,
+    uint64_t            budget)
+{
+    EbMemoryBudget_t *budget_ptr = (EbMemoryBudget_t*)malloc(sizeof(EbMemoryBudget_t));
+
+    *budget_dbl_ptr = budget_ptr;
+    if (budget_ptr == (EbMemoryBudget_t*)EB_NULL)
+        return EB_ErrorInsufficientResources;
+
+    budget_ptr->lockoutMutex = eb_create_mutex();
+    if (budget_ptr->lockoutMutex == (EbHandle)EB_NULL) {
+        free(budget_ptr);
+        *budget_dbl_ptr = (EbMemoryBudget_t*)EB_NULL;
+        return EB_ErrorInsufficientResources;
+    }
+
+    budget_ptr->budget = budget;
+    budget_ptr->baseSize = 0;
+    budget_ptr->elasticSize = 0;
+    budget_ptr->objectList = (EbElasticObject_t*)EB_NULL;
+
+    return EB_ErrorNone;
+}
+
+/*********************************************************************
+ * eb_memory_budget_set_base
+ *********************************************************************/
+void eb_memory_budget_set_base(
+    EbMemoryBudget_t   *budget_ptr,
+    uint64_t            base_size)
+{
+    eb_block_on_mutex(budget_ptr->lockoutMutex);
+    budget_ptr->baseSize = base_size;
+    eb_release_mutex(budget_ptr->lockoutMutex);
+}
+
+/*********************************************************************
+ * ElasticObjectDtor
+ *********************************************************************/
+static void ElasticObjectDtor(
+    EbElasticObject_t  *object_ptr)
+{
+    eb_memory_map_release(&object_ptr->memoryMap);
+    free(object_ptr->memoryMap.entries);
+    free(object_ptr);
+}
+
+/*********************************************************************
+ * eb_memory_budget_dtor
+ *********************************************************************/
+void eb_memory_budget_dtor(
+    EbMemoryBudget_t   *budget_ptr)
+{
+    while (budget_ptr->objectList) {
+        EbElasticObject_t *object_ptr = budget_ptr->objectList;
+        budget_ptr->objectList = object_ptr->nextPtr;
+        ElasticObjectDtor(object_ptr);
+    }
+
+    eb_destroy_mutex(budget_ptr->lockoutMutex);
+    free(budget_ptr);
+}
+
+/*********************************************************************
+ * EbSystemResourceGrow
+ *   Constructs an object for a spare wrapper of an elastic
+ *   SystemResource. Returns NULL when the SystemResource is at its
+ *   object_total_count, the budget would be exceeded or the object
+ *   cannot be constructed.
+ *********************************************************************/
+static EbObjectWrapper_t *EbSystemResourceGrow(
+    EbSystemResource_t *resource_ptr)
+{
+    EbMemoryBudget_t *budget_ptr = resource_ptr->memoryBudgetPtr;
+    EbObjectWrapper_t *wrapper_ptr = (EbObjectWrapper_t*)EB_NULL;
+    EbElasticObject_t *object_ptr;
+    EbMemoryMap *callerMemoryMap;
+    EbBool reserved;
+    EbErrorType return_error;
+
+    eb_block_on_mutex(resource_ptr->elasticMutex);
+
+    if (resource_ptr->spareWrapperCount == 0) {
+        eb_release_mutex(resource_ptr->elasticMutex);
+        return wrapper_ptr;
+    }
+
+    eb_block_on_mutex(budget_ptr->lockoutMutex);
+    reserved = (budget_ptr->budget == 0 ||
+        budget_ptr->baseSize + budget_ptr->elasticSize + resource_ptr->objectSize <= budget_ptr->budget) ? EB_TRUE : EB_FALSE;
+    if (reserved)
+        budget_ptr->elasticSize += resource_ptr->objectSize;
+    eb_release_mutex(budget_ptr->lockoutMutex);
+
+    object_ptr = reserved ? (EbElasticObject_t*)calloc(1, sizeof(EbElasticObject_t)) : (EbElasticObject_t*)EB_NULL;
+    if (object_ptr) {
+        object_ptr->memoryMap.entries = (EbMemoryMapEntry*)malloc(sizeof(EbMemoryMapEntry) * resource_ptr->objectMemoryEntryCount);
+        object_ptr->memoryMap.capacity = object_ptr->memoryMap.entries ? resource_ptr->objectMemoryEntryCount : 0;
+        wrapper_ptr = resource_ptr->spareWrapperPtrArray[resource_ptr->spareWrapperCount - 1];
+
+        // Record the allocations of the object in its own memory map
+        callerMemoryMap = memory_map;
+        memory_map = &object_ptr->memoryMap;
+        return_error = object_ptr->memoryMap.entries ?
+            resource_ptr->objectCtor(&wrapper_ptr->object_ptr, resource_ptr->objectInitDataPtr) :
+            EB_ErrorInsufficientResources;
+        memory_map = callerMemoryMap;
+
+        if (return_error == EB_ErrorNone) {
+            --resource_ptr->spareWrapperCount;
+            wrapper_ptr->elasticObjectPtr = object_ptr;
+        }
+        else {
+            if (object_ptr->memoryMap.entries) {
+                eb_memory_map_release(&object_ptr->memoryMap);
+                free(object_ptr->memoryMap.entries);
+            }
+            free(object_ptr);
+            object_ptr = (EbElasticObject_t*)EB_NULL;
+            wrapper_ptr = (EbObjectWrapper_t*)EB_NULL;
+        }
+    }
+
+    eb_block_on_mutex(budget_ptr->lockoutMutex);
+    if (object_ptr) {
+        object_ptr->nextPtr = budget_ptr->objectList;
+        if (budget_ptr->objectList)
+            budget_ptr->objectList->prevPtr = object_ptr;
+        budget_ptr->objectList = object_ptr;
+    }
+    else if (reserved)
+        budget_ptr->elasticSize -= resource_ptr->objectSize;
+    eb_release_mutex(budget_ptr->lockoutMutex);
+
+    eb_release_mutex(resource_ptr->elasticMutex);
+
+    return wrapper_ptr;
+}
+
+/*********************************************************************
+ * EbSystemResourceShrink
+ *   Destructs the objects constructed on demand that were not needed:
+ *   as many as the lowest count of empty objects over the last
+ *   ELASTIC_IDLE_GET_COUNT requests. Only the request closing that
+ *   window takes the elasticMutex, the others update the window with
+ *   atomics. An object is destructed only once popped off the
+ *   emptyQueue with no other queue holding it and no picture using it.
+ *********************************************************************/
+#define ELASTIC_IDLE_GET_COUNT  64
+
+static void EbSystemResourceShrink(
+    EbSystemResource_t *resource_ptr)
+{
+    EbMemoryBudget_t *budget_ptr = resource_ptr->memoryBudgetPtr;
+    EbLockFreeQueue_t *queuePtr = resource_ptr->emptyQueue->lockFreeQueue;
+    const int32_t emptyCount = EB_ATOMIC_LOAD(&queuePtr->countingSemaphore.count);
+    const uint32_t idleCount = emptyCount <= 0 ? 0 : (uint32_t)emptyCount;
+    EbObjectWrapper_t *keptWrapperPtr = (EbObjectWrapper_t*)EB_NULL;
+    uint32_t idleMinEmptyCount;
+    uint32_t grownCount;
+    uint32_t popCount;
+
+    do {
+        idleMinEmptyCount = EB_ATOMIC_LOAD(&resource_ptr->idleMinEmptyCount);
+    } while (idleCount < idleMinEmptyCount && !EB_ATOMIC_CAS(&resource_ptr->idleMinEmptyCount, idleMinEmptyCount, idleCount));
+
+    // Exactly one request closes each window
+    if (EB_ATOMIC_ADD(&resource_ptr->idleGetCount, 1) + 1 != ELASTIC_IDLE_GET_COUNT)
+        return;
+
+    eb_block_on_mutex(resource_ptr->elasticMutex);
+
+    idleMinEmptyCount = EB_ATOMIC_LOAD(&resource_ptr->idleMinEmptyCount);
+
+    // Objects constructed on demand and still alive
+    grownCount = resource_ptr->object_total_count - resource_ptr->objectInitialCount - resource_ptr->spareWrapperCount;
+
+    for (popCount = 0; popCount < idleMinEmptyCount && grownCount; ++popCount) {
+        EbObjectWrapper_t *wrapper_ptr;
+        EbElasticObject_t *object_ptr;
+
+        if (!eb_light_semaphore_try_wait(&queuePtr->countingSemaphore))
+            break;
+
+        wrapper_ptr = EbLockFreeQueuePopFront(queuePtr);
+        object_ptr = wrapper_ptr->elasticObjectPtr;
+
+        // Objects constructed up front, or still queued or used elsewhere,
+        //   are queued back once done, not to be popped again from the front
+        if (object_ptr == (EbElasticObject_t*)EB_NULL ||
+            EB_ATOMIC_LOAD(&wrapper_ptr->queuedCount) != 0 ||
+            (wrapper_ptr->liveCount != 0 && wrapper_ptr->liveCount != EB_ObjectWrapperReleasedValue)) {
+            wrapper_ptr->nextPtr = keptWrapperPtr;
+            keptWrapperPtr = wrapper_ptr;
+            continue;
+        }
+
+        eb_block_on_mutex(budget_ptr->lockoutMutex);
+        if (object_ptr->prevPtr)
+            object_ptr->prevPtr->nextPtr = object_ptr->nextPtr;
+        else
+            budget_ptr->objectList = object_ptr->nextPtr;
+        if (object_ptr->nextPtr)
+            object_ptr->nextPtr->prevPtr = object_ptr->prevPtr;
+        budget_ptr->elasticSize -= resource_ptr->objectSize;
+        eb_release_mutex(budget_ptr->lockoutMutex);
+
+        ElasticObjectDtor(object_ptr);
+
+        wrapper_ptr->elasticObjectPtr = (EbElasticObject_t*)EB_NULL;
+        wrapper_ptr->object_ptr = EB_NULL;
+        resource_ptr->spareWrapperPtrArray[resource_ptr->spareWrapperCount++] = wrapper_ptr;
+        --grownCount;
+    }
+
+    while (keptWrapperPtr) {
+        EbObjectWrapper_t *wrapper_ptr = keptWrapperPtr;
+        keptWrapperPtr = wrapper_ptr->nextPtr;
+        EbLockFreeQueuePushFront(queuePtr, wrapper_ptr);
+    }
+
+    // Open the next window
+    EB_ATOMIC_STORE(&resource_ptr->idleMinEmptyCount, ~0u);
+    EB_ATOMIC_STORE(&resource_ptr->idleGetCount, 0);
+
+    eb_release_mutex(resource_ptr->elasticMutex);
+}
+
 
 
 /*********************************************************************
@@ -519,6 +1275,10 @@ static EbErrorType EbReleaseProcess(
 {
     EbErrorType return_error = EB_ErrorNone;
 
+    // Any process can dequeue from a lock-free queue: nothing to assign
+    if (processFifoPtr->queuePtr->lockFreeQueue)
+        return return_error;
+
     eb_block_on_mutex(processFifoPtr->queuePtr->lockoutMutex);
 
     EbCircularBufferPushFront(
@@ -550,6 +1310,20 @@ EbErrorType eb_post_full_object(
     EbObjectWrapper_t   *object_ptr)
 {
     EbErrorType return_error = EB_ErrorNone;
+    EbMuxingQueue_t *fullQueuePtr = object_ptr->systemResourcePtr->fullQueue;
+
+    // Recorded before the push so that the dequeue is never seen first
+    if (fullQueuePtr->profilerPtr)
+        eb_pipeline_profiler_enqueue(
+            fullQueuePtr->profilerPtr,
+            fullQueuePtr->profilerStage,
+            object_ptr);
+
+    if (object_ptr->systemResourcePtr->fullQueue->lockFreeQueue) {
+        return EbMuxingQueueObjectPushBack(
+            object_ptr->systemResourcePtr->fullQueue,
+            object_ptr);
+    }
 
     eb_block_on_mutex(object_ptr->systemResourcePtr->fullQueue->lockoutMutex);
 
@@ -576,8 +1350,11 @@ EbErrorType eb_release_object(
     EbObjectWrapper_t   *object_ptr)
 {
     EbErrorType return_error = EB_ErrorNone;
+    EbSystemResource_t *resource_ptr = object_ptr->systemResourcePtr;
+    EbMuxingQueue_t *emptyQueuePtr = resource_ptr->emptyQueue;
+    EbBool releaseObject = EB_FALSE;
 
-    eb_block_on_mutex(object_ptr->systemResourcePtr->emptyQueue->lockoutMutex);
+    eb_block_on_mutex(emptyQueuePtr->lockoutMutex);
 
     // Decrement liveCount
     object_ptr->liveCount = (object_ptr->liveCount == 0) ? object_ptr->liveCount : object_ptr->liveCount - 1;
@@ -587,13 +1364,40 @@ EbErrorType eb_release_object(
         // Set liveCount to EB_ObjectWrapperReleasedValue
         object_ptr->liveCount = EB_ObjectWrapperReleasedValue;
 
-        EbMuxingQueueObjectPushFront(
-            object_ptr->systemResourcePtr->emptyQueue,
-            object_ptr);
+        releaseObject = EB_TRUE;
 
+        if (emptyQueuePtr->lockFreeQueue == (EbLockFreeQueue_t*)EB_NULL &&
+            resource_ptr->releaseCallback == (EbObjectReleaseCallback)EB_NULL) {
+            EbMuxingQueueObjectPushFront(
+                emptyQueuePtr,
+                object_ptr);
+        }
     }
 
-    eb_release_mutex(object_ptr->systemResourcePtr->emptyQueue->lockoutMutex);
+    eb_release_mutex(emptyQueuePtr->lockoutMutex);
+
+    if (releaseObject && resource_ptr->releaseCallback) {
+
+        // Nobody references the object anymore, so the callback runs unlocked
+        resource_ptr->releaseCallback(
+            object_ptr->object_ptr,
+            resource_ptr->releaseCallbackCtx);
+
+        if (emptyQueuePtr->lockFreeQueue == (EbLockFreeQueue_t*)EB_NULL) {
+            eb_block_on_mutex(emptyQueuePtr->lockoutMutex);
+            EbMuxingQueueObjectPushFront(
+                emptyQueuePtr,
+                object_ptr);
+            eb_release_mutex(emptyQueuePtr->lockoutMutex);
+        }
+    }
+
+    // The lock-free queue does not need the mutex
+    if (releaseObject && emptyQueuePtr->lockFreeQueue) {
+        EbMuxingQueueObjectPushFront(
+            emptyQueuePtr,
+            object_ptr);
+    }
 
     return return_error;
 }
@@ -619,6 +1423,33 @@ EbErrorType eb_get_empty_object(
 {
     EbErrorType return_error = EB_ErrorNone;
 
+    if (empty_fifo_ptr->queuePtr->lockFreeQueue) {
+        EbLockFreeQueue_t *queuePtr = empty_fifo_ptr->queuePtr->lockFreeQueue;
+        EbSystemResource_t *elasticResourcePtr = empty_fifo_ptr->queuePtr->elasticResourcePtr;
+
+        if (elasticResourcePtr == (EbSystemResource_t*)EB_NULL) {
+            eb_light_semaphore_wait(&queuePtr->countingSemaphore);
+            *wrapper_dbl_ptr = EbLockFreeQueuePopFront(queuePtr);
+        }
+        else {
+            // Construct one more object rather than wait, budget permitting,
+            //   otherwise the objects in flight throttle the pipeline
+            if (eb_light_semaphore_try_wait(&queuePtr->countingSemaphore))
+                *wrapper_dbl_ptr = EbLockFreeQueuePopFront(queuePtr);
+            else if ((*wrapper_dbl_ptr = EbSystemResourceGrow(elasticResourcePtr)) == (EbObjectWrapper_t*)EB_NULL) {
+                eb_light_semaphore_wait(&queuePtr->countingSemaphore);
+                *wrapper_dbl_ptr = EbLockFreeQueuePopFront(queuePtr);
+            }
+
+            EbSystemResourceShrink(elasticResourcePtr);
+        }
+
+        (*wrapper_dbl_ptr)->liveCount = 0;
+        (*wrapper_dbl_ptr)->releaseEnable = EB_TRUE;
+
+        return return_error;
+    }
+
     // Queue the Fifo requesting the empty fifo
     EbReleaseProcess(empty_fifo_ptr);
 
@@ -669,18 +1500,61 @@ EbErrorType eb_get_full_object(
     // Queue the Fifo requesting the full fifo
     EbReleaseProcess(full_fifo_ptr);
 
-    // Block on the counting Semaphore until an empty buffer is available
-    eb_block_on_semaphore(full_fifo_ptr->countingSemaphore);
-
-    // Acquire lockout Mutex
-    eb_block_on_mutex(full_fifo_ptr->lockoutMutex);
-
-    EbFifoPopFront(
+    return_error = eb_dequeue_full_object(
         full_fifo_ptr,
         wrapper_dbl_ptr);
 
-    // Release Mutex
-    eb_release_mutex(full_fifo_ptr->lockoutMutex);
+    return return_error;
+}
+
+/*********************************************************************
+ * eb_request_full_object
+ *   No-op for a lock-free queue.
+ *********************************************************************/
+EbErrorType eb_request_full_object(
+    EbFifo_t   *full_fifo_ptr)
+{
+    return EbReleaseProcess(full_fifo_ptr);
+}
+
+/*********************************************************************
+ * eb_dequeue_full_object
+ *********************************************************************/
+EbErrorType eb_dequeue_full_object(
+    EbFifo_t   *full_fifo_ptr,
+    EbObjectWrapper_t **wrapper_dbl_ptr)
+{
+    EbErrorType return_error = EB_ErrorNone;
+    EbMuxingQueue_t *queuePtr = full_fifo_ptr->queuePtr;
+
+    if (queuePtr->profilerPtr)
+        eb_pipeline_profiler_wait(queuePtr->profilerPtr);
+
+    if (queuePtr->lockFreeQueue) {
+        eb_light_semaphore_wait(&queuePtr->lockFreeQueue->countingSemaphore);
+
+        *wrapper_dbl_ptr = EbLockFreeQueuePopFront(queuePtr->lockFreeQueue);
+    }
+    else {
+        // Block on the counting Semaphore until an empty buffer is available
+        eb_block_on_semaphore(full_fifo_ptr->countingSemaphore);
+
+        // Acquire lockout Mutex
+        eb_block_on_mutex(full_fifo_ptr->lockoutMutex);
+
+        EbFifoPopFront(
+            full_fifo_ptr,
+            wrapper_dbl_ptr);
+
+        // Release Mutex
+        eb_release_mutex(full_fifo_ptr->lockoutMutex);
+    }
+
+    if (queuePtr->profilerPtr)
+        eb_pipeline_profiler_dequeue(
+            queuePtr->profilerPtr,
+            queuePtr->profilerStage,
+            *wrapper_dbl_ptr);
 
     return return_error;
 }
@@ -702,12 +1576,65 @@ static EbBool EbFifoPeakFront(
 }
 
 
+/*********************************************************************
+ * eb_full_object_available
+ *   For a lock-free queue, tells whether any process of the queue can
+ *   dequeue an object.
+ *********************************************************************/
+EbBool eb_full_object_available(
+    EbFifo_t   *full_fifo_ptr)
+{
+    EbBool fifoEmpty;
+
+    if (full_fifo_ptr->queuePtr->lockFreeQueue)
+        return EB_ATOMIC_LOAD(&full_fifo_ptr->queuePtr->lockFreeQueue->countingSemaphore.count) > 0 ? EB_TRUE : EB_FALSE;
+
+    eb_block_on_mutex(full_fifo_ptr->lockoutMutex);
+
+    fifoEmpty = EbFifoPeakFront(
+        full_fifo_ptr);
+
+    eb_release_mutex(full_fifo_ptr->lockoutMutex);
+
+    return fifoEmpty == EB_TRUE ? EB_FALSE : EB_TRUE;
+}
+
+/*********************************************************************
+ * eb_set_notify_semaphore
+ *********************************************************************/
+void eb_set_notify_semaphore(
+    EbFifo_t   *full_fifo_ptr,
+    EbHandle    notify_semaphore)
+{
+    full_fifo_ptr->notifySemaphore = notify_semaphore;
+
+    // Objects of a lock-free queue are not delivered to a given fifo
+    if (full_fifo_ptr->queuePtr->lockFreeQueue)
+        full_fifo_ptr->queuePtr->notifySemaphore = notify_semaphore;
+}
+
 EbErrorType eb_get_full_object_non_blocking(
     EbFifo_t   *full_fifo_ptr,
     EbObjectWrapper_t **wrapper_dbl_ptr)
 {
     EbErrorType return_error = EB_ErrorNone;
     EbBool      fifoEmpty;
+
+    if (full_fifo_ptr->queuePtr->lockFreeQueue) {
+        if (eb_light_semaphore_try_wait(&full_fifo_ptr->queuePtr->lockFreeQueue->countingSemaphore)) {
+            *wrapper_dbl_ptr = EbLockFreeQueuePopFront(full_fifo_ptr->queuePtr->lockFreeQueue);
+
+            if (full_fifo_ptr->queuePtr->profilerPtr)
+                eb_pipeline_profiler_dequeue(
+                    full_fifo_ptr->queuePtr->profilerPtr,
+                    full_fifo_ptr->queuePtr->profilerStage,
+                    *wrapper_dbl_ptr);
+        }
+        else
+            *wrapper_dbl_ptr = (EbObjectWrapper_t*)EB_NULL;
+
+        return return_error;
+    }
     // Queue the Fifo requesting the full fifo
     EbReleaseProcess(full_fifo_ptr);
 
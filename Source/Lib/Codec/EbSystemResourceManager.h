@@ -44,6 +44,19 @@ extern "C" {
         //   only in the implemenation of a single-linked Fifo.
         struct EbObjectWrapper_s *nextPtr;
 
+        // elasticObjectPtr - memory of an object constructed on demand
+        //   by an elastic SystemResource, NULL for the objects
+        //   constructed with the SystemResource.
+        struct EbElasticObject_s *elasticObjectPtr;
+
+        // poolIndex - index of the EbObjectWrapper in the wrapperPtrPool
+        //   of its SystemResource.
+        uint32_t                    poolIndex;
+
+        // queuedCount - number of lock-free queues holding the
+        //   EbObjectWrapper, updated atomically.
+        uint32_t                    queuedCount;
+
     } EbObjectWrapper_t;
 
     /*********************************************************************
@@ -74,6 +87,11 @@ extern "C" {
         //   associated with.
         struct EbMuxingQueue_s *queuePtr;
 
+        // notifySemaphore - optional semaphore posted along with the
+        //   countingSemaphore each time an object is delivered. Used by
+        //   consumers serving several fifos (e.g. a shared thread pool).
+        EbHandle notifySemaphore;
+
     } EbFifo_t;
 
     /*********************************************************************
@@ -88,8 +106,55 @@ extern "C" {
 
     } EbCircularBuffer_t;
 
+    /*********************************************************************
+     * LockFreeQueue
+     *   Bounded multi-producer multi-consumer ring of EbObjectWrappers.
+     *   Producers and consumers claim a cell with an atomic ticket; the
+     *   cell sequence number tells when the claimed cell has been
+     *   written (resp. read back). The countingSemaphore counts the
+     *   objects that can be dequeued, so a consumer only claims a ticket
+     *   once an object is guaranteed.
+     *
+     *   A lifo queue is a stack instead: the objects are pushed to and
+     *   popped from the front, so that the object reused first is the
+     *   one released last, still warm in the caches. Its cells are
+     *   indexed by the EbObjectWrapper poolIndex and linked through
+     *   their sequence.
+     *********************************************************************/
+#define EB_CACHE_LINE_SIZE  64
+
+    typedef struct EbLockFreeCell_s {
+        volatile uint32_t   sequence;
+        EbObjectWrapper_t  *wrapper_ptr;
+    } EbLockFreeCell_t;
+
+    typedef struct EbLockFreeQueue_s {
+        EbLockFreeCell_t   *cellArray;
+        uint32_t            cellMask;
+        EbBool              lifo;
+
+        // The tickets are kept on separate cache lines so that producers
+        //   and consumers do not invalidate each other.
+        uint8_t             pad0[EB_CACHE_LINE_SIZE];
+        volatile uint32_t   enqueueIndex;
+        uint8_t             pad1[EB_CACHE_LINE_SIZE - sizeof(uint32_t)];
+        volatile uint32_t   dequeueIndex;
+        uint8_t             pad2[EB_CACHE_LINE_SIZE - sizeof(uint32_t)];
+
+        // stackHead - ABA tag << 32 | (front cell index + 1) of a lifo
+        //   queue, no cell when the index is 0.
+        volatile uint64_t   stackHead;
+        uint8_t             pad3[EB_CACHE_LINE_SIZE - sizeof(uint64_t)];
+
+        EbLightSemaphore    countingSemaphore;
+
+    } EbLockFreeQueue_t;
+
     /*********************************************************************
      * MuxingQueue
+     *   Either hands objects to the requesting process fifos under the
+     *   lockoutMutex, or, when lockFreeQueue is set, lets every process
+     *   of the queue dequeue directly from a shared lock-free ring.
      *********************************************************************/
     typedef struct EbMuxingQueue_s {
         EbHandle           lockoutMutex;
@@ -98,8 +163,48 @@ extern "C" {
         uint32_t              processTotalCount;
         EbFifo_t          **processFifoPtrArray;
 
+        // lockFreeQueue - replaces objectQueue, processQueue and the
+        //   process fifo lists when not NULL.
+        EbLockFreeQueue_t  *lockFreeQueue;
+
+        // notifySemaphore - posted for each object pushed to the
+        //   lockFreeQueue (see EbFifo_t notifySemaphore).
+        EbHandle            notifySemaphore;
+        // profilerPtr - pipeline profiler recording the objects of a
+        //   full queue as the input of stage profilerStage, NULL when
+        //   profiling is disabled.
+        struct EbPipelineProfiler_s *profilerPtr;
+        uint32_t            profilerStage;
+        // elasticResourcePtr - SystemResource growing on demand when
+        //   this is its empty queue, NULL otherwise.
+        struct EbSystemResource_s *elasticResourcePtr;
+
     } EbMuxingQueue_t;
 
+    /*********************************************************************
+     * MemoryBudget
+     *   Library memory an encoder may use, shared by its elastic
+     *   SystemResources. The memory allocated at init is the base, the
+     *   objects constructed on demand are charged on top of it. Each of
+     *   them records its allocations in its own memory map so that it
+     *   can be destructed before the encoder is.
+     *********************************************************************/
+    typedef struct EbElasticObject_s {
+        EbMemoryMap                memoryMap;
+        struct EbElasticObject_s  *prevPtr;
+        struct EbElasticObject_s  *nextPtr;
+    } EbElasticObject_t;
+
+    typedef struct EbMemoryBudget_s {
+        EbHandle            lockoutMutex;
+        // budget - bytes, 0 when unlimited
+        uint64_t            budget;
+        uint64_t            baseSize;
+        uint64_t            elasticSize;
+        // objectList - objects constructed on demand and still alive
+        EbElasticObject_t  *objectList;
+    } EbMemoryBudget_t;
+
     /*********************************************************************
      * SystemResource
      *   Defines a complete solution for managing objects in the encoder
@@ -109,6 +214,10 @@ extern "C" {
      *   fullFifo provides downstream pipeline data flow control.  The
      *   emptyFifo provides upstream pipeline backpressure flow control.
      *********************************************************************/
+    typedef void(*EbObjectReleaseCallback)(
+        void *object_ptr,
+        void *callback_ctx);
+
     typedef struct EbSystemResource_s {
         // object_total_count - A count of the number of objects contained in the
         //   System Resoruce.
@@ -126,6 +235,31 @@ extern "C" {
         //EbFifo_t           *fullFifo;
         EbMuxingQueue_t     *fullQueue;
 
+        // releaseCallback - called with the object of each wrapper whose
+        //   liveCount reaches zero, before the wrapper is returned to the
+        //   emptyQueue. NULL when not used.
+        EbObjectReleaseCallback releaseCallback;
+        void               *releaseCallbackCtx;
+
+        // Elastic SystemResources (see eb_system_resource_elastic_ctor),
+        //   memoryBudgetPtr is NULL for the others.
+        EbMemoryBudget_t   *memoryBudgetPtr;
+        EbHandle            elasticMutex;
+        EB_CTOR             objectCtor;
+        EbPtr               objectInitDataPtr;
+        uint32_t            objectInitialCount;
+        // objectMemoryEntryCount, objectSize - memory map entries and
+        //   bytes of one object, measured on the first one constructed.
+        uint32_t            objectMemoryEntryCount;
+        uint64_t            objectSize;
+        // spareWrapperPtrArray - wrappers without an object
+        EbObjectWrapper_t **spareWrapperPtrArray;
+        uint32_t            spareWrapperCount;
+        // idleMinEmptyCount - lowest count of empty objects seen over
+        //   the last idleGetCount requests, both updated atomically
+        uint32_t            idleGetCount;
+        uint32_t            idleMinEmptyCount;
+
     } EbSystemResource_t;
 
     /*********************************************************************
@@ -183,6 +317,25 @@ extern "C" {
         EbObjectWrapper_t *wrapper_ptr,
         uint32_t           increment_number);
 
+    /*********************************************************************
+     * eb_system_resource_set_lock_free
+     *   Selects the queue implementation of the SystemResources
+     *   constructed next by the calling thread: the mutex and semaphore
+     *   based muxing queues (default) or lock-free rings.
+     *********************************************************************/
+    extern void eb_system_resource_set_lock_free(
+        EbBool              lock_free);
+
+    /*********************************************************************
+     * eb_system_resource_set_ctor_thread_count
+     *   Number of threads, the calling one included, constructing the
+     *   objects of the SystemResources constructed next by the calling
+     *   thread (default 1). The object constructor must then only
+     *   allocate, the same way for every object.
+     *********************************************************************/
+    extern void eb_system_resource_set_ctor_thread_count(
+        uint32_t            thread_count);
+
     /*********************************************************************
      * eb_system_resource_ctor
      *   Constructor for EbSystemResource.  Fully constructs all members
@@ -221,6 +374,81 @@ extern "C" {
         EB_CTOR             object_ctor,
         EbPtr               object_init_data_ptr);
 
+    /*********************************************************************
+     * eb_system_resource_elastic_ctor
+     *   Same as eb_system_resource_ctor, except that only
+     *   object_initial_count objects are constructed up front. When no
+     *   empty object is left, eb_get_empty_object constructs one more as
+     *   long as object_total_count and memory_budget_ptr allow it, and
+     *   waits for an object to be released otherwise. Objects constructed
+     *   that way are destructed again when the SystemResource kept empty
+     *   objects for a while.
+     *
+     *   object_init_data_size
+     *     Size of the block at object_init_data_ptr, which is copied. 0
+     *     when the block outlives the SystemResource.
+     *
+     *   The objects are constructed on demand with lock-free queues only,
+     *   all of them are constructed up front otherwise.
+     *********************************************************************/
+    extern EbErrorType eb_system_resource_elastic_ctor(
+        EbSystemResource_t **resource_dbl_ptr,
+        uint32_t            object_total_count,
+        uint32_t            object_initial_count,
+        uint32_t            producer_process_total_count,
+        uint32_t            consumer_process_total_count,
+        EbFifo_t         ***producer_fifo_ptr_array_ptr,
+        EbFifo_t         ***consumer_fifo_ptr_array_ptr,
+        EbBool              full_fifo_enabled,
+        EB_CTOR             object_ctor,
+        EbPtr               object_init_data_ptr,
+        uint32_t            object_init_data_size,
+        EbMemoryBudget_t   *memory_budget_ptr);
+
+    /*********************************************************************
+     * eb_memory_budget_ctor
+     *   The budget is not recorded in the memory map of the encoder as it
+     *   must outlive its entries (see eb_memory_budget_dtor).
+     *********************************************************************/
+    extern EbErrorType eb_memory_budget_ctor(
+        EbMemoryBudget_t  **budget_dbl_ptr,
+        uint64_t            budget);
+
+    // Sets the memory allocated at init
+    extern void eb_memory_budget_set_base(
+        EbMemoryBudget_t   *budget_ptr,
+        uint64_t            base_size);
+
+    /*********************************************************************
+     * eb_memory_budget_dtor
+     *   Destructs the objects constructed on demand that are still alive
+     *   and frees the budget. Must be called once the threads using the
+     *   elastic SystemResources are gone.
+     *********************************************************************/
+    extern void eb_memory_budget_dtor(
+        EbMemoryBudget_t   *budget_ptr);
+
+    /*********************************************************************
+     * eb_system_resource_set_release_callback
+     *   Registers a function called each time an object of the
+     *   SystemResource is released for reuse. The callback runs without
+     *   the emptyQueue lockoutMutex held, so it may release objects of
+     *   other SystemResources.
+     *
+     *   resource_ptr
+     *     pointer to the SystemResource.
+     *
+     *   release_callback
+     *     function called with the released object and callback_ctx.
+     *
+     *   callback_ctx
+     *     pointer passed back to release_callback.
+     *********************************************************************/
+    extern void eb_system_resource_set_release_callback(
+        EbSystemResource_t      *resource_ptr,
+        EbObjectReleaseCallback  release_callback,
+        void                    *callback_ctx);
+
     /*********************************************************************
      * eb_system_resource_dtor
      *   Destructor for EbSystemResource.  Fully destructs all members
@@ -295,6 +523,42 @@ extern "C" {
         EbFifo_t           *full_fifo_ptr,
         EbObjectWrapper_t **wrapper_dbl_ptr);
 
+    /*********************************************************************
+     * eb_request_full_object
+     *   Queues the process fifo in the SystemResource fullQueue so that
+     *   the next full EbObjectWrapper is delivered to it. Non-blocking
+     *   first half of eb_get_full_object.
+     *********************************************************************/
+    extern EbErrorType eb_request_full_object(
+        EbFifo_t           *full_fifo_ptr);
+
+    /*********************************************************************
+     * eb_full_object_available
+     *   Returns EB_TRUE when an EbObjectWrapper has been delivered to the
+     *   process fifo and can be dequeued without blocking.
+     *********************************************************************/
+    extern EbBool eb_full_object_available(
+        EbFifo_t           *full_fifo_ptr);
+
+    /*********************************************************************
+     * eb_dequeue_full_object
+     *   Dequeues the EbObjectWrapper delivered to the process fifo after
+     *   eb_request_full_object. Blocks until it is delivered. Second half
+     *   of eb_get_full_object.
+     *********************************************************************/
+    extern EbErrorType eb_dequeue_full_object(
+        EbFifo_t           *full_fifo_ptr,
+        EbObjectWrapper_t **wrapper_dbl_ptr);
+
+    /*********************************************************************
+     * eb_set_notify_semaphore
+     *   Sets the semaphore posted each time an EbObjectWrapper becomes
+     *   available to the process fifo.
+     *********************************************************************/
+    extern void eb_set_notify_semaphore(
+        EbFifo_t           *full_fifo_ptr,
+        EbHandle            notify_semaphore);
+
     extern EbErrorType eb_get_full_object_non_blocking(
         EbFifo_t           *full_fifo_ptr,
         EbObjectWrapper_t **wrapper_dbl_ptr);
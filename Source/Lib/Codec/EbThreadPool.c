@@ -0,0 +1,406 @@
+/*
+* Copyright(c) 2019 Intel Corporation
+* SPDX - License - Identifier: BSD - 2 - Clause - Patent
+*/
+
+#include <stdlib.h>
+
+#include "EbThreadPool.h"
+#include "EbPipelineProfiler.h"
+#include "EbThreads.h"
+#include "EbUtility.h"
+
+#define THREAD_POOL_SLOT_INIT_COUNT     64
+
+/**************************************
+ * Admission check
+ *   A task of the given priority may start only if at least one worker
+ *   stays available for each deeper stage.
+ **************************************/
+static EbBool ThreadPoolAdmits(
+    struct EbThreadPool *pool_ptr,
+    uint32_t             priority)
+{
+    uint32_t busyCount = 0;
+    uint32_t priorityIndex;
+
+    for (priorityIndex = 0; priorityIndex <= priority; ++priorityIndex)
+        busyCount += pool_ptr->busy_count[priorityIndex];
+
+    return (busyCount + (EB_THREAD_POOL_PRIORITY_COUNT - 1 - priority) < pool_ptr->thread_count) ? EB_TRUE : EB_FALSE;
+}
+
+/**************************************
+ * Next runnable slot
+ *   Deeper stages are served first as they release the upstream ones.
+ *   Slots of the same stage are scanned round robin so that no handle
+ *   gets precedence. Called with the pool lockout_mutex held.
+ **************************************/
+static EbThreadPoolSlot_t *ThreadPoolNextSlot(
+    struct EbThreadPool *pool_ptr)
+{
+    int32_t  priority;
+    uint32_t scanIndex;
+
+    if (pool_ptr->slot_count == 0)
+        return (EbThreadPoolSlot_t*)EB_NULL;
+
+    for (priority = EB_THREAD_POOL_PRIORITY_COUNT - 1; priority >= 0; --priority) {
+
+        if (ThreadPoolAdmits(pool_ptr, (uint32_t)priority) == EB_FALSE)
+            continue;
+
+        for (scanIndex = 0; scanIndex < pool_ptr->slot_count; ++scanIndex) {
+            EbThreadPoolSlot_t *slot_ptr = pool_ptr->slot_ptr_array[(pool_ptr->scan_index + scanIndex) % pool_ptr->slot_count];
+
+            if (slot_ptr->priority == (uint32_t)priority &&
+                slot_ptr->busy == EB_FALSE &&
+                slot_ptr->detached == EB_FALSE &&
+                eb_full_object_available(slot_ptr->input_fifo_ptr))
+            {
+                pool_ptr->scan_index = (pool_ptr->scan_index + scanIndex + 1) % pool_ptr->slot_count;
+                return slot_ptr;
+            }
+        }
+    }
+
+    return (EbThreadPoolSlot_t*)EB_NULL;
+}
+
+/**************************************
+ * Task end
+ *   Called with the pool lockout_mutex held.
+ **************************************/
+static void ThreadPoolEndTask(
+    EbThreadPoolWorker_t *worker_ptr)
+{
+    struct EbThreadPool *pool_ptr = worker_ptr->pool_ptr;
+    EbThreadPoolSlot_t  *slot_ptr = worker_ptr->slot_ptr;
+
+    slot_ptr->busy = EB_FALSE;
+    slot_ptr->worker_ptr = (EbThreadPoolWorker_t*)EB_NULL;
+    pool_ptr->busy_count[slot_ptr->priority]--;
+    worker_ptr->slot_ptr = (EbThreadPoolSlot_t*)EB_NULL;
+
+    if (slot_ptr->detached == EB_FALSE)
+        eb_request_full_object(slot_ptr->input_fifo_ptr);
+
+    // The freed worker may admit a task held back by the reservation
+    eb_post_semaphore(pool_ptr->work_semaphore);
+}
+
+static void ThreadPoolRunTask(void *context_ptr)
+{
+    EbThreadPoolWorker_t *worker_ptr = (EbThreadPoolWorker_t*)context_ptr;
+
+    worker_ptr->slot_ptr->task(
+        worker_ptr->slot_ptr->context_ptr,
+        worker_ptr->input_wrapper_ptr);
+}
+
+// Cleanup of a task cancelled by eb_thread_pool_remove_owner
+static void ThreadPoolCancelTask(void *context_ptr)
+{
+    EbThreadPoolWorker_t *worker_ptr = (EbThreadPoolWorker_t*)context_ptr;
+
+    eb_block_on_mutex(worker_ptr->pool_ptr->lockout_mutex);
+    ThreadPoolEndTask(worker_ptr);
+    eb_release_mutex(worker_ptr->pool_ptr->lockout_mutex);
+}
+
+/**************************************
+ * Thread Pool Kernel
+ **************************************/
+static void* ThreadPoolKernel(void *input_ptr)
+{
+    EbThreadPoolWorker_t *worker_ptr = (EbThreadPoolWorker_t*)input_ptr;
+    struct EbThreadPool  *pool_ptr = worker_ptr->pool_ptr;
+    EbThreadPoolSlot_t   *slot_ptr;
+    EbBool                cancelled;
+
+    // Only the tasks are cancelled, never the pool bookkeeping
+    eb_disable_thread_cancel();
+
+    for (;;) {
+
+        eb_block_on_semaphore(pool_ptr->work_semaphore);
+
+        eb_block_on_mutex(pool_ptr->lockout_mutex);
+
+        if (pool_ptr->shutdown) {
+            eb_release_mutex(pool_ptr->lockout_mutex);
+            break;
+        }
+
+        slot_ptr = ThreadPoolNextSlot(pool_ptr);
+        if (slot_ptr) {
+            slot_ptr->busy = EB_TRUE;
+            slot_ptr->worker_ptr = worker_ptr;
+            worker_ptr->slot_ptr = slot_ptr;
+            pool_ptr->busy_count[slot_ptr->priority]++;
+
+            // Dequeued under the lock: slots of a stage may share one
+            // lock-free queue, the object must not be promised twice
+            eb_dequeue_full_object(
+                slot_ptr->input_fifo_ptr,
+                &worker_ptr->input_wrapper_ptr);
+
+            // One wake-up can make several slots runnable: pass it on
+            if (ThreadPoolNextSlot(pool_ptr))
+                eb_post_semaphore(pool_ptr->work_semaphore);
+        }
+
+        eb_release_mutex(pool_ptr->lockout_mutex);
+
+        if (slot_ptr == (EbThreadPoolSlot_t*)EB_NULL)
+            continue;
+
+        // Allocations made by the task belong to the slot owner
+        memory_map = slot_ptr->memory_map;
+
+        eb_run_cancellable(
+            ThreadPoolRunTask,
+            ThreadPoolCancelTask,
+            worker_ptr);
+
+        // The worker may next serve another stage
+        eb_pipeline_profiler_end_busy();
+
+        eb_block_on_mutex(pool_ptr->lockout_mutex);
+        ThreadPoolEndTask(worker_ptr);
+        cancelled = worker_ptr->cancel_owner_ptr ? EB_TRUE : EB_FALSE;
+        eb_release_mutex(pool_ptr->lockout_mutex);
+
+        // Returned as it was cancelled: the owner replaces this thread
+        if (cancelled)
+            break;
+    }
+
+    return EB_NULL;
+}
+
+/**************************************
+ * eb_thread_pool_ctor
+ *   The pool is not owned by an encoder handle: its memory is not
+ *   tracked in a handle memory map and is released by the dtor.
+ **************************************/
+EbErrorType eb_thread_pool_ctor(
+    struct EbThreadPool **pool_dbl_ptr,
+    uint32_t              thread_count)
+{
+    struct EbThreadPool *pool_ptr;
+    uint32_t             threadIndex;
+
+    *pool_dbl_ptr = (struct EbThreadPool*)EB_NULL;
+
+    pool_ptr = (struct EbThreadPool*)calloc(1, sizeof(struct EbThreadPool));
+    if (pool_ptr == (struct EbThreadPool*)EB_NULL)
+        return EB_ErrorInsufficientResources;
+
+    // The stage reservation needs at least one worker per priority
+    pool_ptr->thread_count = MAX(thread_count, EB_THREAD_POOL_PRIORITY_COUNT);
+
+    pool_ptr->slot_max_count = THREAD_POOL_SLOT_INIT_COUNT;
+    pool_ptr->slot_ptr_array = (EbThreadPoolSlot_t**)malloc(sizeof(EbThreadPoolSlot_t*) * pool_ptr->slot_max_count);
+    pool_ptr->worker_array = (EbThreadPoolWorker_t*)calloc(pool_ptr->thread_count, sizeof(EbThreadPoolWorker_t));
+    pool_ptr->lockout_mutex = eb_create_mutex();
+    pool_ptr->work_semaphore = eb_create_semaphore(0, 0x7FFFFFFF);
+
+    if (pool_ptr->slot_ptr_array == (EbThreadPoolSlot_t**)EB_NULL ||
+        pool_ptr->worker_array == (EbThreadPoolWorker_t*)EB_NULL ||
+        pool_ptr->lockout_mutex == (EbHandle)EB_NULL ||
+        pool_ptr->work_semaphore == (EbHandle)EB_NULL)
+    {
+        eb_thread_pool_dtor(pool_ptr);
+        return EB_ErrorInsufficientResources;
+    }
+
+    for (threadIndex = 0; threadIndex < pool_ptr->thread_count; ++threadIndex) {
+        EbThreadPoolWorker_t *worker_ptr = &pool_ptr->worker_array[threadIndex];
+
+        worker_ptr->pool_ptr = pool_ptr;
+        worker_ptr->thread_handle = eb_create_thread(ThreadPoolKernel, worker_ptr);
+        if (worker_ptr->thread_handle == (EbHandle)EB_NULL) {
+            eb_thread_pool_dtor(pool_ptr);
+            return EB_ErrorInsufficientResources;
+        }
+    }
+
+    *pool_dbl_ptr = pool_ptr;
+
+    return EB_ErrorNone;
+}
+
+/**************************************
+ * eb_thread_pool_dtor
+ *   Every owner must have been removed.
+ **************************************/
+void eb_thread_pool_dtor(
+    struct EbThreadPool  *pool_ptr)
+{
+    uint32_t threadIndex;
+    uint32_t slotIndex;
+
+    if (pool_ptr == (struct EbThreadPool*)EB_NULL)
+        return;
+
+    if (pool_ptr->worker_array &&
+        pool_ptr->lockout_mutex &&
+        pool_ptr->work_semaphore)
+    {
+        eb_block_on_mutex(pool_ptr->lockout_mutex);
+        pool_ptr->shutdown = EB_TRUE;
+        eb_release_mutex(pool_ptr->lockout_mutex);
+
+        for (threadIndex = 0; threadIndex < pool_ptr->thread_count; ++threadIndex)
+            eb_post_semaphore(pool_ptr->work_semaphore);
+
+        for (threadIndex = 0; threadIndex < pool_ptr->thread_count; ++threadIndex) {
+            if (pool_ptr->worker_array[threadIndex].thread_handle)
+                eb_destroy_thread(pool_ptr->worker_array[threadIndex].thread_handle);
+        }
+    }
+    free(pool_ptr->worker_array);
+
+    if (pool_ptr->slot_ptr_array) {
+        for (slotIndex = 0; slotIndex < pool_ptr->slot_count; ++slotIndex)
+            free(pool_ptr->slot_ptr_array[slotIndex]);
+        free(pool_ptr->slot_ptr_array);
+    }
+
+    if (pool_ptr->work_semaphore)
+        eb_destroy_semaphore(pool_ptr->work_semaphore);
+    if (pool_ptr->lockout_mutex)
+        eb_destroy_mutex(pool_ptr->lockout_mutex);
+
+    free(pool_ptr);
+}
+
+/**************************************
+ * eb_thread_pool_add_slot
+ **************************************/
+EbErrorType eb_thread_pool_add_slot(
+    struct EbThreadPool  *pool_ptr,
+    EbPtr                 owner_ptr,
+    EbFifo_t             *input_fifo_ptr,
+    EbThreadPoolTask      task,
+    EbPtr                 context_ptr,
+    uint32_t              priority)
+{
+    EbThreadPoolSlot_t *slot_ptr;
+
+    if (priority >= EB_THREAD_POOL_PRIORITY_COUNT)
+        return EB_ErrorBadParameter;
+
+    slot_ptr = (EbThreadPoolSlot_t*)calloc(1, sizeof(EbThreadPoolSlot_t));
+    if (slot_ptr == (EbThreadPoolSlot_t*)EB_NULL)
+        return EB_ErrorInsufficientResources;
+
+    slot_ptr->input_fifo_ptr = input_fifo_ptr;
+    slot_ptr->context_ptr = context_ptr;
+    slot_ptr->task = task;
+    slot_ptr->owner_ptr = owner_ptr;
+    slot_ptr->memory_map = memory_map;
+    slot_ptr->priority = priority;
+    slot_ptr->busy = EB_FALSE;
+    slot_ptr->detached = EB_FALSE;
+    slot_ptr->worker_ptr = (EbThreadPoolWorker_t*)EB_NULL;
+
+    eb_block_on_mutex(pool_ptr->lockout_mutex);
+
+    if (pool_ptr->slot_count == pool_ptr->slot_max_count) {
+        EbThreadPoolSlot_t **slot_ptr_array = (EbThreadPoolSlot_t**)realloc(
+            pool_ptr->slot_ptr_array,
+            sizeof(EbThreadPoolSlot_t*) * pool_ptr->slot_max_count * 2);
+        if (slot_ptr_array == (EbThreadPoolSlot_t**)EB_NULL) {
+            eb_release_mutex(pool_ptr->lockout_mutex);
+            free(slot_ptr);
+            return EB_ErrorInsufficientResources;
+        }
+        pool_ptr->slot_ptr_array = slot_ptr_array;
+        pool_ptr->slot_max_count *= 2;
+    }
+    pool_ptr->slot_ptr_array[pool_ptr->slot_count++] = slot_ptr;
+
+    eb_set_notify_semaphore(
+        input_fifo_ptr,
+        pool_ptr->work_semaphore);
+
+    // Request the first input object
+    eb_request_full_object(input_fifo_ptr);
+
+    eb_release_mutex(pool_ptr->lockout_mutex);
+
+    return EB_ErrorNone;
+}
+
+/**************************************
+ * eb_thread_pool_remove_owner
+ **************************************/
+void eb_thread_pool_remove_owner(
+    struct EbThreadPool  *pool_ptr,
+    EbPtr                 owner_ptr)
+{
+    uint32_t threadIndex;
+    uint32_t slotIndex;
+    uint32_t keptCount = 0;
+
+    // No new task of the owner starts; the running ones are cancelled
+    eb_block_on_mutex(pool_ptr->lockout_mutex);
+    for (slotIndex = 0; slotIndex < pool_ptr->slot_count; ++slotIndex) {
+        EbThreadPoolSlot_t *slot_ptr = pool_ptr->slot_ptr_array[slotIndex];
+        if (slot_ptr->owner_ptr == owner_ptr) {
+            slot_ptr->detached = EB_TRUE;
+            if (slot_ptr->busy) {
+                slot_ptr->worker_ptr->cancel_owner_ptr = owner_ptr;
+                eb_cancel_thread(slot_ptr->worker_ptr->thread_handle);
+            }
+        }
+    }
+    eb_release_mutex(pool_ptr->lockout_mutex);
+
+    // Wait for the cancelled workers, out of the lock their cleanup takes
+    for (threadIndex = 0; threadIndex < pool_ptr->thread_count; ++threadIndex) {
+        EbThreadPoolWorker_t *worker_ptr = &pool_ptr->worker_array[threadIndex];
+        if (worker_ptr->cancel_owner_ptr == owner_ptr)
+            eb_destroy_thread(worker_ptr->thread_handle);
+    }
+
+    eb_block_on_mutex(pool_ptr->lockout_mutex);
+    for (threadIndex = 0; threadIndex < pool_ptr->thread_count; ++threadIndex) {
+        EbThreadPoolWorker_t *worker_ptr = &pool_ptr->worker_array[threadIndex];
+        if (worker_ptr->cancel_owner_ptr == owner_ptr) {
+            // Terminated without cleanup (Windows)
+            if (worker_ptr->slot_ptr)
+                ThreadPoolEndTask(worker_ptr);
+            worker_ptr->cancel_owner_ptr = EB_NULL;
+            worker_ptr->thread_handle = eb_create_thread(ThreadPoolKernel, worker_ptr);
+        }
+    }
+
+    for (slotIndex = 0; slotIndex < pool_ptr->slot_count; ++slotIndex) {
+        EbThreadPoolSlot_t *slot_ptr = pool_ptr->slot_ptr_array[slotIndex];
+        if (slot_ptr->owner_ptr == owner_ptr)
+            free(slot_ptr);
+        else
+            pool_ptr->slot_ptr_array[keptCount++] = slot_ptr;
+    }
+    pool_ptr->slot_count = keptCount;
+    pool_ptr->scan_index = 0;
+    eb_release_mutex(pool_ptr->lockout_mutex);
+}
+
+/**************************************
+ * eb_thread_pool_slot_count
+ **************************************/
+uint32_t eb_thread_pool_slot_count(
+    struct EbThreadPool  *pool_ptr)
+{
+    uint32_t slotCount;
+
+    eb_block_on_mutex(pool_ptr->lockout_mutex);
+    slotCount = pool_ptr->slot_count;
+    eb_release_mutex(pool_ptr->lockout_mutex);
+
+    return slotCount;
+}
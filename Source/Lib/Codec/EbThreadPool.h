@@ -0,0 +1,113 @@
+/*
+* Copyright(c) 2019 Intel Corporation
+* SPDX - License - Identifier: BSD - 2 - Clause - Patent
+*/
+
+#ifndef EbThreadPool_h
+#define EbThreadPool_h
+
+#include "EbDefinitions.h"
+#include "EbSystemResourceManager.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+    /*********************************************************************
+     * Thread Pool
+     *   A set of worker threads shared by several encoder handles. A
+     *   pipeline stage attached to the pool registers one slot per
+     *   process context instead of creating a dedicated thread. Each
+     *   slot requests an input object from its process fifo and a worker
+     *   runs the slot task on it once the object is delivered.
+     *
+     *   Stages are ranked by their depth in the pipeline (priority). A
+     *   task of a given priority only starts when enough workers are
+     *   left for every deeper stage, so upstream tasks blocked on
+     *   downstream backpressure can never starve the whole pool.
+     *********************************************************************/
+#define EB_THREAD_POOL_PRIORITY_COUNT       4
+#define EB_THREAD_POOL_PRIORITY_ENC_DEC     0
+#define EB_THREAD_POOL_PRIORITY_DLF         1
+#define EB_THREAD_POOL_PRIORITY_CDEF        2
+#define EB_THREAD_POOL_PRIORITY_REST        3
+
+    typedef void(*EbThreadPoolTask)(
+        EbPtr              context_ptr,
+        EbObjectWrapper_t *input_wrapper_ptr);
+
+    struct EbThreadPoolWorker_s;
+
+    typedef struct EbThreadPoolSlot_s {
+        EbFifo_t          *input_fifo_ptr;
+        EbPtr              context_ptr;
+        EbThreadPoolTask   task;
+        EbPtr              owner_ptr;           // encoder handle the slot belongs to
+        EbMemoryMap       *memory_map;          // memory map of the owner handle
+        uint32_t           priority;
+        EbBool             busy;
+        EbBool             detached;
+        struct EbThreadPoolWorker_s *worker_ptr; // worker running the task, when busy
+    } EbThreadPoolSlot_t;
+
+    typedef struct EbThreadPoolWorker_s {
+        struct EbThreadPool *pool_ptr;
+        EbHandle           thread_handle;
+        EbThreadPoolSlot_t *slot_ptr;           // slot of the running task, NULL when idle
+        EbObjectWrapper_t *input_wrapper_ptr;
+        EbPtr              cancel_owner_ptr;    // owner removing the pool while the task runs
+    } EbThreadPoolWorker_t;
+
+    struct EbThreadPool {
+        EbHandle           lockout_mutex;
+        EbHandle           work_semaphore;      // posted once per event that may make a slot runnable
+        EbThreadPoolWorker_t *worker_array;
+        uint32_t           thread_count;
+        EbBool             shutdown;
+
+        EbThreadPoolSlot_t **slot_ptr_array;
+        uint32_t           slot_count;
+        uint32_t           slot_max_count;
+        uint32_t           scan_index;
+
+        uint32_t           busy_count[EB_THREAD_POOL_PRIORITY_COUNT];
+    };
+
+    extern EbErrorType eb_thread_pool_ctor(
+        struct EbThreadPool **pool_dbl_ptr,
+        uint32_t              thread_count);
+
+    extern void eb_thread_pool_dtor(
+        struct EbThreadPool  *pool_ptr);
+
+    /*********************************************************************
+     * eb_thread_pool_add_slot
+     *   Registers one process context of a pipeline stage. Must be
+     *   called on the thread that owns the memory map of owner_ptr,
+     *   before any object is posted to input_fifo_ptr.
+     *********************************************************************/
+    extern EbErrorType eb_thread_pool_add_slot(
+        struct EbThreadPool  *pool_ptr,
+        EbPtr                 owner_ptr,
+        EbFifo_t             *input_fifo_ptr,
+        EbThreadPoolTask      task,
+        EbPtr                 context_ptr,
+        uint32_t              priority);
+
+    /*********************************************************************
+     * eb_thread_pool_remove_owner
+     *   Removes every slot of owner_ptr from the pool. The tasks of
+     *   owner_ptr currently running are cancelled, as the dedicated stage
+     *   threads are: a task blocked on a stream that was not flushed would
+     *   never return. Their workers are replaced.
+     *********************************************************************/
+    extern void eb_thread_pool_remove_owner(
+        struct EbThreadPool  *pool_ptr,
+        EbPtr                 owner_ptr);
+
+    extern uint32_t eb_thread_pool_slot_count(
+        struct EbThreadPool  *pool_ptr);
+
+#ifdef __cplusplus
+}
+#endif
+#endif // EbThreadPool_h
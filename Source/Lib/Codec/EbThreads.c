@@ -15,6 +15,7 @@
 #include <stdlib.h>
 #include "EbDefinitions.h"
 #include "EbThreads.h"
+#include <emmintrin.h>
  /****************************************
   * Win32 Includes
   ****************************************/
@@ -28,6 +29,10 @@
 #include <semaphore.h>
 #include <time.h>
 #include <unistd.h>
+#ifdef __linux__
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#endif
 #else
 #error OS/Platform not supported.
 #endif // _WIN32
@@ -45,6 +50,36 @@ void printfTime(const char *fmt, ...)
 #endif
 #endif
 
+/****************************************
+ * Thread start context
+ *  carries the memory map of the creating
+ *  encoder handle into the new thread
+ ****************************************/
+typedef struct EbThreadStartContext
+{
+    void        *(*thread_function)(void *);
+    void          *thread_context;
+    EbMemoryMap   *memory_map;
+} EbThreadStartContext;
+
+#ifdef _WIN32
+static DWORD WINAPI eb_thread_start(LPVOID start_context_ptr)
+#else
+static void *eb_thread_start(void *start_context_ptr)
+#endif
+{
+    EbThreadStartContext start_context = *(EbThreadStartContext*)start_context_ptr;
+    free(start_context_ptr);
+
+    memory_map = start_context.memory_map;
+#ifdef _WIN32
+    start_context.thread_function(start_context.thread_context);
+    return 0;
+#else
+    return start_context.thread_function(start_context.thread_context);
+#endif
+}
+
 /****************************************
  * eb_create_thread
  ****************************************/
@@ -53,17 +88,27 @@ EbHandle eb_create_thread(
     void *thread_context)
 {
     EbHandle thread_handle = NULL;
+    EbThreadStartContext *start_context_ptr = (EbThreadStartContext*)malloc(sizeof(EbThreadStartContext));
+
+    if (start_context_ptr == NULL)
+        return NULL;
+    start_context_ptr->thread_function = thread_function;
+    start_context_ptr->thread_context = thread_context;
+    start_context_ptr->memory_map = memory_map;
 
 #ifdef _WIN32
 
     thread_handle = (EbHandle)CreateThread(
         NULL,                           // default security attributes
         0,                              // default stack size
-        (LPTHREAD_START_ROUTINE)thread_function, // function to be tied to the new thread
-        thread_context,                  // context to be tied to the new thread
+        eb_thread_start,                // function to be tied to the new thread
+        start_context_ptr,              // context to be tied to the new thread
         0,                              // thread active when created
         NULL);                          // new thread ID
 
+    if (thread_handle == NULL)
+        free(start_context_ptr);
+
 #elif defined(__linux__) || defined(__APPLE__)
 
     pthread_attr_t attr;
@@ -80,8 +125,8 @@ EbHandle eb_create_thread(
     int32_t ret = pthread_create(
         (pthread_t*)thread_handle,      // Thread handle
         &attr,                       // attributes
-        thread_function,                 // function to be run by new thread
-        thread_context);
+        eb_thread_start,                 // function to be run by new thread
+        start_context_ptr);
 
     if (ret != 0)
         if (ret == EPERM) {
@@ -92,18 +137,45 @@ EbHandle eb_create_thread(
 
             thread_handle = (pthread_t*)malloc(sizeof(pthread_t));
 
-            pthread_create(
+            ret = pthread_create(
                 (pthread_t*)thread_handle,      // Thread handle
                 (const pthread_attr_t*)EB_NULL,                        // attributes
-                thread_function,                 // function to be run by new thread
-                thread_context);
+                eb_thread_start,                 // function to be run by new thread
+                start_context_ptr);
         }
 
+    pthread_attr_destroy(&attr);
+    if (ret != 0) {
+        free(thread_handle);
+        free(start_context_ptr);
+        thread_handle = NULL;
+    }
+
 #endif // _WIN32
 
     return thread_handle;
 }
 
+/****************************************
+ * eb_set_thread_affinity
+ ****************************************/
+void eb_set_thread_affinity(
+    EbHandle thread_handle)
+{
+#ifdef _WIN32
+    if (num_groups == 1)
+        SetThreadAffinityMask(thread_handle, group_affinity.Mask);
+    else if (num_groups == 2 && alternate_groups) {
+        group_affinity.Group = 1 - group_affinity.Group;
+        SetThreadGroupAffinity(thread_handle, &group_affinity, NULL);
+    }
+    else if (num_groups == 2 && !alternate_groups)
+        SetThreadGroupAffinity(thread_handle, &group_affinity, NULL);
+#else
+    pthread_setaffinity_np(*((pthread_t*)thread_handle), sizeof(cpu_set_t), &group_affinity);
+#endif
+}
+
 ///****************************************
 // * eb_start_thread
 // ****************************************/
@@ -169,6 +241,64 @@ EbErrorType eb_destroy_thread(
 
     return error_return;
 }
+/****************************************
+ * eb_disable_thread_cancel
+ *   The calling thread can only be cancelled
+ *   in eb_run_cancellable from now on
+ ****************************************/
+void eb_disable_thread_cancel(void)
+{
+#if defined(__linux__) || defined(__APPLE__)
+    int cancelState;
+    pthread_setcancelstate(PTHREAD_CANCEL_DISABLE, &cancelState);
+#endif
+}
+
+/****************************************
+ * eb_cancel_thread
+ *   Requests the cancellation without
+ *   waiting for it, except on Windows
+ ****************************************/
+EbErrorType eb_cancel_thread(
+    EbHandle thread_handle)
+{
+    EbErrorType error_return = EB_ErrorNone;
+
+#ifdef _WIN32
+    error_return = TerminateThread((HANDLE)thread_handle, 0) ? EB_ErrorNone : EB_ErrorDestroyThreadFailed;
+    WaitForSingleObject((HANDLE)thread_handle, INFINITE);
+#elif defined(__linux__) || defined(__APPLE__)
+    error_return = pthread_cancel(*((pthread_t*)thread_handle)) ? EB_ErrorDestroyThreadFailed : EB_ErrorNone;
+#endif // _WIN32
+
+    return error_return;
+}
+
+/****************************************
+ * eb_run_cancellable
+ *   Runs function(context) with deferred
+ *   cancellation enabled; cleanup(context)
+ *   runs if the thread is cancelled in it
+ ****************************************/
+void eb_run_cancellable(
+    void (*function)(void *),
+    void (*cleanup)(void *),
+    void  *context)
+{
+#ifdef _WIN32
+    (void)cleanup;
+    function(context);
+#elif defined(__linux__) || defined(__APPLE__)
+    int cancelState;
+
+    pthread_cleanup_push(cleanup, context);
+    pthread_setcancelstate(PTHREAD_CANCEL_ENABLE, &cancelState);
+    function(context);
+    pthread_setcancelstate(PTHREAD_CANCEL_DISABLE, &cancelState);
+    pthread_cleanup_pop(0);
+#endif // _WIN32
+}
+
 #if defined(__APPLE__)
 static int32_t semaphore_id(void)
 {
@@ -274,6 +404,138 @@ EbErrorType eb_destroy_semaphore(EbHandle semaphore_handle)
 
     return return_error;
 }
+/***************************************
+ * Light semaphore
+ ***************************************/
+#define LIGHT_SEMAPHORE_SPIN_COUNT  1024
+// Longest futex sleep before a sleeping waiter checks for cancellation
+#define LIGHT_SEMAPHORE_CANCEL_POLL_NS  20000000
+
+/***************************************
+ * Spin count
+ *   Spinning only pays off when the thread
+ *   posting can run at the same time.
+ ***************************************/
+static uint32_t LightSemaphoreSpinCount(void)
+{
+    static volatile int32_t spinCount = -1;
+
+    if (spinCount < 0) {
+#ifdef _WIN32
+        SYSTEM_INFO systemInfo;
+        GetSystemInfo(&systemInfo);
+        spinCount = (systemInfo.dwNumberOfProcessors > 1) ? LIGHT_SEMAPHORE_SPIN_COUNT : 0;
+#else
+        spinCount = (sysconf(_SC_NPROCESSORS_ONLN) > 1) ? LIGHT_SEMAPHORE_SPIN_COUNT : 0;
+#endif
+    }
+
+    return (uint32_t)spinCount;
+}
+
+/***************************************
+ * eb_yield_thread
+ ***************************************/
+void eb_yield_thread(void)
+{
+#ifdef _WIN32
+    SwitchToThread();
+#else
+    sched_yield();
+#endif
+}
+
+/***************************************
+ * eb_light_semaphore_ctor
+ ***************************************/
+EbErrorType eb_light_semaphore_ctor(
+    EbLightSemaphore *semaphore_ptr,
+    uint32_t          initial_count)
+{
+    semaphore_ptr->count = (int32_t)initial_count;
+#ifdef __linux__
+    semaphore_ptr->wake_count = 0;
+#else
+    EB_CREATESEMAPHORE(EbHandle, semaphore_ptr->wake_semaphore, sizeof(EbHandle), EB_SEMAPHORE, 0, 0x7FFFFFFF);
+#endif
+
+    return EB_ErrorNone;
+}
+
+/***************************************
+ * eb_light_semaphore_post
+ ***************************************/
+void eb_light_semaphore_post(
+    EbLightSemaphore *semaphore_ptr)
+{
+    // Only wake the kernel if a waiter went to sleep
+    if (EB_ATOMIC_ADD(&semaphore_ptr->count, 1) < 0) {
+#ifdef __linux__
+        EB_ATOMIC_ADD(&semaphore_ptr->wake_count, 1);
+        syscall(SYS_futex, &semaphore_ptr->wake_count, FUTEX_WAKE_PRIVATE, 1, NULL, NULL, 0);
+#else
+        eb_post_semaphore(semaphore_ptr->wake_semaphore);
+#endif
+    }
+}
+
+/***************************************
+ * eb_light_semaphore_try_wait
+ ***************************************/
+EbBool eb_light_semaphore_try_wait(
+    EbLightSemaphore *semaphore_ptr)
+{
+    int32_t count = EB_ATOMIC_LOAD(&semaphore_ptr->count);
+
+    while (count > 0) {
+        if (EB_ATOMIC_CAS(&semaphore_ptr->count, count, count - 1))
+            return EB_TRUE;
+        count = EB_ATOMIC_LOAD(&semaphore_ptr->count);
+    }
+
+    return EB_FALSE;
+}
+
+/***************************************
+ * eb_light_semaphore_wait
+ ***************************************/
+void eb_light_semaphore_wait(
+    EbLightSemaphore *semaphore_ptr)
+{
+    uint32_t spinCount = LightSemaphoreSpinCount();
+    uint32_t spinIndex;
+
+    for (spinIndex = 0; spinIndex < spinCount; ++spinIndex) {
+        if (eb_light_semaphore_try_wait(semaphore_ptr))
+            return;
+        _mm_pause();
+    }
+
+    if (EB_ATOMIC_ADD(&semaphore_ptr->count, -1) > 0)
+        return;
+
+    // No token left: sleep until a post hands one over
+#ifdef __linux__
+    for (;;) {
+        int32_t wakeCount = EB_ATOMIC_LOAD(&semaphore_ptr->wake_count);
+        if (wakeCount > 0) {
+            if (EB_ATOMIC_CAS(&semaphore_ptr->wake_count, wakeCount, wakeCount - 1))
+                return;
+        }
+        else {
+            struct timespec timeout = { 0, LIGHT_SEMAPHORE_CANCEL_POLL_NS };
+
+            // The futex syscall is no cancellation point: stay cancellable
+            //   while asleep, as in sem_wait, by waking up periodically
+            pthread_testcancel();
+            syscall(SYS_futex, &semaphore_ptr->wake_count, FUTEX_WAIT_PRIVATE, 0, &timeout, NULL, 0);
+        }
+    }
+#else
+    eb_block_on_semaphore(semaphore_ptr->wake_semaphore);
+#endif
+}
+
 /***************************************
  * eb_create_mutex
  ***************************************/
@@ -371,3 +633,62 @@ EbErrorType eb_destroy_mutex(
 
     return return_error;
 }
+
+/***************************************
+ * eb_time_us
+ ***************************************/
+uint64_t eb_time_us(void)
+{
+#ifdef _WIN32
+    LARGE_INTEGER counter, frequency;
+    QueryPerformanceCounter(&counter);
+    QueryPerformanceFrequency(&frequency);
+    return (uint64_t)(counter.QuadPart / frequency.QuadPart) * 1000000 +
+        (uint64_t)(counter.QuadPart % frequency.QuadPart) * 1000000 / frequency.QuadPart;
+#else
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000 + (uint64_t)now.tv_nsec / 1000;
+#endif
+}
+
+/***************************************
+ * eb_memory_map_release
+ ***************************************/
+EbErrorType eb_memory_map_release(
+    EbMemoryMap *memory_map_ptr)
+{
+    EbErrorType return_error = EB_ErrorNone;
+    int32_t ptrIndex;
+
+    for (ptrIndex = (int32_t)memory_map_ptr->index - 1; ptrIndex >= 0; --ptrIndex) {
+        EbMemoryMapEntry *memoryEntry = &memory_map_ptr->entries[ptrIndex];
+        switch (memoryEntry->ptrType) {
+        case EB_N_PTR:
+            free(memoryEntry->ptr);
+            break;
+        case EB_A_PTR:
+#ifdef _WIN32
+            _aligned_free(memoryEntry->ptr);
+#else
+            free(memoryEntry->ptr);
+#endif
+            break;
+        case EB_SEMAPHORE:
+            eb_destroy_semaphore(memoryEntry->ptr);
+            break;
+        case EB_THREAD:
+            eb_destroy_thread(memoryEntry->ptr);
+            break;
+        case EB_MUTEX:
+            eb_destroy_mutex(memoryEntry->ptr);
+            break;
+        default:
+            return_error = EB_ErrorMax;
+            break;
+        }
+    }
+    memory_map_ptr->index = 0;
+
+    return return_error;
+}
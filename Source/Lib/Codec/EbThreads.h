@@ -35,6 +35,29 @@ extern "C" {
     extern EbErrorType eb_destroy_thread(
         EbHandle thread_handle);
 
+    extern void eb_yield_thread(
+        void);
+
+    // Binds a thread to the processors selected for the encoder
+    // threads (cpu_mask / numa_node), alternating the processor
+    // groups when the encoder spans two of them.
+    extern void eb_set_thread_affinity(
+        EbHandle thread_handle);
+
+    // Cancellation of a thread running a task: the thread only stops in
+    // eb_run_cancellable, at its next blocking wait (terminated at once on
+    // Windows). eb_destroy_thread then reclaims it.
+    extern void eb_disable_thread_cancel(
+        void);
+
+    extern EbErrorType eb_cancel_thread(
+        EbHandle thread_handle);
+
+    extern void eb_run_cancellable(
+        void (*function)(void *),
+        void (*cleanup)(void *),
+        void  *context);
+
     /**************************************
      * Semaphores
      **************************************/
@@ -51,6 +74,57 @@ extern "C" {
     extern EbErrorType eb_destroy_semaphore(
         EbHandle semaphore_handle);
 
+    /**************************************
+     * Atomics
+     **************************************/
+#ifdef _WIN32
+#define EB_ATOMIC_ADD(ptr, value)               InterlockedExchangeAdd((volatile LONG*)(ptr), (LONG)(value))
+#define EB_ATOMIC_CAS(ptr, old_value, new_value) (InterlockedCompareExchange((volatile LONG*)(ptr), (LONG)(new_value), (LONG)(old_value)) == (LONG)(old_value))
+#define EB_ATOMIC_LOAD(ptr)                     (*(ptr))
+#define EB_ATOMIC_STORE(ptr, value)             InterlockedExchange((volatile LONG*)(ptr), (LONG)(value))
+#define EB_ATOMIC_CAS64(ptr, old_value, new_value) (InterlockedCompareExchange64((volatile LONG64*)(ptr), (LONG64)(new_value), (LONG64)(old_value)) == (LONG64)(old_value))
+#define EB_ATOMIC_LOAD64(ptr)                   InterlockedCompareExchange64((volatile LONG64*)(ptr), 0, 0)
+#else
+#define EB_ATOMIC_ADD(ptr, value)               __atomic_fetch_add((ptr), (value), __ATOMIC_SEQ_CST)
+#define EB_ATOMIC_CAS(ptr, old_value, new_value) __sync_bool_compare_and_swap((ptr), (old_value), (new_value))
+#define EB_ATOMIC_LOAD(ptr)                     __atomic_load_n((ptr), __ATOMIC_ACQUIRE)
+#define EB_ATOMIC_STORE(ptr, value)             __atomic_store_n((ptr), (value), __ATOMIC_RELEASE)
+#define EB_ATOMIC_CAS64(ptr, old_value, new_value) EB_ATOMIC_CAS(ptr, old_value, new_value)
+#define EB_ATOMIC_LOAD64(ptr)                   EB_ATOMIC_LOAD(ptr)
+#endif
+
+    /**************************************
+     * Light Semaphores
+     *   Counting semaphore living in user space. Waiters spin for a
+     *   short while before sleeping and the kernel is only entered when
+     *   a thread actually sleeps or has to be woken (futex on Linux, OS
+     *   semaphore elsewhere).
+     **************************************/
+    typedef struct EbLightSemaphore {
+        // count - available tokens; when negative, the number of
+        //   waiters that are (about to be) asleep.
+        volatile int32_t  count;
+#ifdef __linux__
+        // wake_count - futex word: wake-ups handed to sleeping waiters
+        volatile int32_t  wake_count;
+#else
+        EbHandle          wake_semaphore;
+#endif
+    } EbLightSemaphore;
+
+    extern EbErrorType eb_light_semaphore_ctor(
+        EbLightSemaphore *semaphore_ptr,
+        uint32_t          initial_count);
+
+    extern void eb_light_semaphore_post(
+        EbLightSemaphore *semaphore_ptr);
+
+    extern void eb_light_semaphore_wait(
+        EbLightSemaphore *semaphore_ptr);
+
+    extern EbBool eb_light_semaphore_try_wait(
+        EbLightSemaphore *semaphore_ptr);
+
     /**************************************
      * Mutex
      **************************************/
@@ -70,70 +144,77 @@ extern "C" {
     extern EbErrorType eb_destroy_mutex(
         EbHandle mutex_handle);
 
-    extern    EbMemoryMapEntry *memory_map;                // library Memory table
-    extern    uint32_t         *memory_map_index;          // library memory index
-    extern    uint64_t         *total_lib_memory;          // library Memory malloc'd
+    /**************************************
+     * Time
+     **************************************/
+    // Monotonic time in microseconds
+    extern uint64_t eb_time_us(
+        void);
+
+    /**************************************
+     * Memory Map
+     **************************************/
+    // Frees the pointers, mutexes, semaphores and threads recorded in
+    //   memory_map_ptr, last recorded first. The entries table itself is
+    //   left to the caller.
+    extern EbErrorType eb_memory_map_release(
+        EbMemoryMap *memory_map_ptr);
 
 #ifdef _WIN32
-    extern    GROUP_AFFINITY    group_affinity;
+    extern    EB_THREAD_LOCAL GROUP_AFFINITY    group_affinity;
     extern    uint8_t           num_groups;
-    extern    EbBool            alternate_groups;
+    extern    EB_THREAD_LOCAL EbBool            alternate_groups;
 
 #define EB_CREATETHREAD(type, pointer, n_elements, pointer_class, thread_function, thread_context) \
+    if (memory_map->index >= memory_map->capacity) { \
+        return EB_ErrorInsufficientResources; \
+    } \
     pointer = eb_create_thread(thread_function, thread_context); \
     if (pointer == (type)EB_NULL) { \
         return EB_ErrorInsufficientResources; \
     } \
     else { \
-        memory_map[*(memory_map_index)].ptrType = pointer_class; \
-        memory_map[(*(memory_map_index))++].ptr = pointer; \
+        memory_map->entries[memory_map->index].ptrType = pointer_class; \
+        memory_map->entries[memory_map->index++].ptr = pointer; \
         if (n_elements % 8 == 0) { \
-            *total_lib_memory += (n_elements); \
+            memory_map->total_lib_memory += (n_elements); \
         } \
         else { \
-            *total_lib_memory += ((n_elements) + (8 - ((n_elements) % 8))); \
-        } \
-        if(num_groups == 1) {\
-            SetThreadAffinityMask(pointer, group_affinity.Mask);\
-        }\
-        else if (num_groups == 2 && alternate_groups){ \
-            group_affinity.Group = 1 - group_affinity.Group; \
-            SetThreadGroupAffinity(pointer,&group_affinity,NULL); \
-        } \
-        else if (num_groups == 2 && !alternate_groups){ \
-            SetThreadGroupAffinity(pointer,&group_affinity,NULL); \
+            memory_map->total_lib_memory += ((n_elements) + (8 - ((n_elements) % 8))); \
         } \
+        eb_set_thread_affinity(pointer); \
     } \
-    if (*(memory_map_index) >= MAX_NUM_PTR) { \
-        return EB_ErrorInsufficientResources; \
-    } \
-    lib_thread_count++;
+    memory_map->thread_count++;
 #else
+#ifndef __USE_GNU
 #define __USE_GNU
+#endif
+#ifndef _GNU_SOURCE
 #define _GNU_SOURCE
+#endif
 #include <sched.h>
 #include <pthread.h>
-extern    cpu_set_t                   group_affinity;
+extern    EB_THREAD_LOCAL cpu_set_t   group_affinity;
 #define EB_CREATETHREAD(type, pointer, n_elements, pointer_class, thread_function, thread_context) \
+    if (memory_map->index >= memory_map->capacity) { \
+        return EB_ErrorInsufficientResources; \
+    } \
     pointer = eb_create_thread(thread_function, thread_context); \
     if (pointer == (type)EB_NULL) { \
         return EB_ErrorInsufficientResources; \
     } \
     else { \
-        pthread_setaffinity_np(*((pthread_t*)pointer),sizeof(cpu_set_t),&group_affinity); \
-        memory_map[*(memory_map_index)].ptrType = pointer_class; \
-        memory_map[(*(memory_map_index))++].ptr = pointer; \
+        eb_set_thread_affinity(pointer); \
+        memory_map->entries[memory_map->index].ptrType = pointer_class; \
+        memory_map->entries[memory_map->index++].ptr = pointer; \
         if (n_elements % 8 == 0) { \
-            *total_lib_memory += (n_elements); \
+            memory_map->total_lib_memory += (n_elements); \
         } \
         else { \
-            *total_lib_memory += ((n_elements) + (8 - ((n_elements) % 8))); \
+            memory_map->total_lib_memory += ((n_elements) + (8 - ((n_elements) % 8))); \
         } \
     } \
-    if (*(memory_map_index) >= MAX_NUM_PTR) { \
-        return EB_ErrorInsufficientResources; \
-    } \
-    lib_thread_count++;
+    memory_map->thread_count++;
 #endif
 
 
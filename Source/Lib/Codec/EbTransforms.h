@@ -4077,6 +4077,14 @@ extern "C" {
 
         },
         // AVX2
+        {
+            pfreq_transform32x32_avx2_intrin,
+            pfreq_transform16x16_sse2,
+            pfreq_transform8x8_sse4_1_intrin,
+            transform4x4_sse2_intrin,
+            dst_transform4x4_sse2_intrin
+        },
+        // AVX512
         {
             pfreq_transform32x32_avx2_intrin,
             pfreq_transform16x16_sse2,
@@ -4095,6 +4103,14 @@ extern "C" {
             dst_transform4x4_sse2_intrin
         },
         // AVX2
+        {
+            pfreq_n4_transform32x32_avx2_intrin,
+            pfreq_n4_transform16x16_sse2,
+            pfreq_n4_transform8x8_sse4_1_intrin,
+            transform4x4_sse2_intrin,
+            dst_transform4x4_sse2_intrin
+        },
+        // AVX512
         {
             pfreq_n4_transform32x32_avx2_intrin,
             pfreq_n4_transform16x16_sse2,
@@ -4120,6 +4136,14 @@ extern "C" {
             transform4x4_sse2_intrin,
             dst_transform4x4_sse2_intrin
         },
+        // AVX512
+        {
+            transform32x32_sse2,
+            transform16x16_sse2,
+            transform8x8_sse4_1_intrin,
+            transform4x4_sse2_intrin,
+            dst_transform4x4_sse2_intrin
+        },
     };
     static const EB_INVTRANSFORM_FUNC inv_transform_function_table_encode[ASM_TYPE_TOTAL][5] = {
         // NON_AVX2
@@ -4138,6 +4162,14 @@ extern "C" {
             inv_transform4x4_sse2_intrin,
             inv_dst_transform4x4_sse2_intrin
         },
+        // AVX512
+        {
+            p_finv_transform32x32_ssse3,
+            p_finv_transform16x16_ssse3,
+            inv_transform8x8_sse2_intrin,
+            inv_transform4x4_sse2_intrin,
+            inv_dst_transform4x4_sse2_intrin
+        },
     };
     void construct_pm_trans_coeff_shaping(SequenceControlSet_t  *sequence_control_set_ptr);
 
@@ -15,6 +15,7 @@
 #include <math.h>
 #include <assert.h>
 #include "EbWarpedMotion.h"
+#include "aom_dsp_rtcd.h"
 
 #define WARP_ERROR_BLOCK 32
 
@@ -529,7 +530,7 @@ static void highbd_warp_plane(EbWarpedMotionParams *wm, const uint8_t *const ref
 
   const uint16_t *const ref = CONVERT_TO_SHORTPTR(ref8);
   uint16_t *pred = CONVERT_TO_SHORTPTR(pred8);
-  av1_highbd_warp_affine_c(mat, ref, width, height, stride, pred, p_col, p_row,
+  av1_highbd_warp_affine(mat, ref, width, height, stride, pred, p_col, p_row,
                          p_width, p_height, p_stride, subsampling_x,
                          subsampling_y, bd, conv_params, alpha, beta, gamma,
                          delta);
@@ -812,7 +813,7 @@ static void warp_plane(EbWarpedMotionParams *wm, const uint8_t *const ref,
   const int16_t beta = wm->beta;
   const int16_t gamma = wm->gamma;
   const int16_t delta = wm->delta;
-  av1_warp_affine_c(mat, ref, width, height, stride, pred, p_col, p_row, p_width,
+  av1_warp_affine(mat, ref, width, height, stride, pred, p_col, p_row, p_width,
                   p_height, p_stride, subsampling_x, subsampling_y, conv_params,
                   alpha, beta, gamma, delta);
 }
@@ -929,7 +930,7 @@ void av1_warp_plane_hbd(
   const int16_t gamma = wm->gamma;
   const int16_t delta = wm->delta;
 
-  av1_highbd_warp_affine_c(
+  av1_highbd_warp_affine(
       mat,
       ref,
       width,
@@ -40,6 +40,7 @@
 #define HAS_AVX 0x40
 #define HAS_AVX2 0x80
 #define HAS_SSE4_2 0x100
+#define HAS_AVX512 0x200
 
 
 #ifdef __cplusplus
@@ -135,6 +136,16 @@ extern "C" {
     void av1_highbd_convolve_x_sr_avx2(const uint16_t *src, int32_t src_stride, uint16_t *dst, int32_t dst_stride, int32_t w, int32_t h, const InterpFilterParams *filter_params_x, const InterpFilterParams *filter_params_y, const int32_t subpel_x_q4, const int32_t subpel_y_q4, ConvolveParams *conv_params, int32_t bd);
     RTCD_EXTERN void(*av1_highbd_convolve_x_sr)(const uint16_t *src, int32_t src_stride, uint16_t *dst, int32_t dst_stride, int32_t w, int32_t h, const InterpFilterParams *filter_params_x, const InterpFilterParams *filter_params_y, const int32_t subpel_x_q4, const int32_t subpel_y_q4, ConvolveParams *conv_params, int32_t bd);
 
+    void av1_warp_affine_c(const int32_t *mat, const uint8_t *ref, int width, int height, int stride, uint8_t *pred, int p_col, int p_row, int p_width, int p_height, int p_stride, int subsampling_x, int subsampling_y, ConvolveParams *conv_params, int16_t alpha, int16_t beta, int16_t gamma, int16_t delta);
+    void av1_warp_affine_sse4_1(const int32_t *mat, const uint8_t *ref, int width, int height, int stride, uint8_t *pred, int p_col, int p_row, int p_width, int p_height, int p_stride, int subsampling_x, int subsampling_y, ConvolveParams *conv_params, int16_t alpha, int16_t beta, int16_t gamma, int16_t delta);
+    void av1_warp_affine_avx2(const int32_t *mat, const uint8_t *ref, int width, int height, int stride, uint8_t *pred, int p_col, int p_row, int p_width, int p_height, int p_stride, int subsampling_x, int subsampling_y, ConvolveParams *conv_params, int16_t alpha, int16_t beta, int16_t gamma, int16_t delta);
+    RTCD_EXTERN void(*av1_warp_affine)(const int32_t *mat, const uint8_t *ref, int width, int height, int stride, uint8_t *pred, int p_col, int p_row, int p_width, int p_height, int p_stride, int subsampling_x, int subsampling_y, ConvolveParams *conv_params, int16_t alpha, int16_t beta, int16_t gamma, int16_t delta);
+
+    void av1_highbd_warp_affine_c(const int32_t *mat, const uint16_t *ref, int width, int height, int stride, uint16_t *pred, int p_col, int p_row, int p_width, int p_height, int p_stride, int subsampling_x, int subsampling_y, int bd, ConvolveParams *conv_params, int16_t alpha, int16_t beta, int16_t gamma, int16_t delta);
+    void av1_highbd_warp_affine_sse4_1(const int32_t *mat, const uint16_t *ref, int width, int height, int stride, uint16_t *pred, int p_col, int p_row, int p_width, int p_height, int p_stride, int subsampling_x, int subsampling_y, int bd, ConvolveParams *conv_params, int16_t alpha, int16_t beta, int16_t gamma, int16_t delta);
+    void av1_highbd_warp_affine_avx2(const int32_t *mat, const uint16_t *ref, int width, int height, int stride, uint16_t *pred, int p_col, int p_row, int p_width, int p_height, int p_stride, int subsampling_x, int subsampling_y, int bd, ConvolveParams *conv_params, int16_t alpha, int16_t beta, int16_t gamma, int16_t delta);
+    RTCD_EXTERN void(*av1_highbd_warp_affine)(const int32_t *mat, const uint16_t *ref, int width, int height, int stride, uint16_t *pred, int p_col, int p_row, int p_width, int p_height, int p_stride, int subsampling_x, int subsampling_y, int bd, ConvolveParams *conv_params, int16_t alpha, int16_t beta, int16_t gamma, int16_t delta);
+
     void subtract_average_c(int16_t *pred_buf_q3, int32_t width, int32_t height, int32_t round_offset, int32_t num_pel_log2);
     void subtract_average_avx2(int16_t *pred_buf_q3, int32_t width, int32_t height, int32_t round_offset, int32_t num_pel_log2);
     RTCD_EXTERN void(*subtract_average)(int16_t *pred_buf_q3, int32_t width, int32_t height, int32_t round_offset, int32_t num_pel_log2);
@@ -236,10 +247,12 @@ extern "C" {
 
     void Av1TransformTwoD_64x64_c(int16_t *input, int32_t *output, uint32_t input_stride, TxType transform_type, uint8_t  bit_depth);
     void av1_fwd_txfm2d_64x64_avx2(int16_t *input, int32_t *output, uint32_t input_stride, TxType transform_type, uint8_t  bit_depth);
+    void av1_fwd_txfm2d_64x64_avx512(int16_t *input, int32_t *output, uint32_t input_stride, TxType transform_type, uint8_t  bit_depth);
     RTCD_EXTERN void(*av1_fwd_txfm2d_64x64)(int16_t *input, int32_t *output, uint32_t input_stride, TxType transform_type, uint8_t  bit_depth);
 
     void Av1TransformTwoD_32x32_c(int16_t *input, int32_t *output, uint32_t input_stride, TxType transform_type, uint8_t  bit_depth);
     void av1_fwd_txfm2d_32x32_avx2(int16_t *input, int32_t *output, uint32_t input_stride, TxType transform_type, uint8_t  bit_depth);
+    void av1_fwd_txfm2d_32x32_avx512(int16_t *input, int32_t *output, uint32_t input_stride, TxType transform_type, uint8_t  bit_depth);
     RTCD_EXTERN void(*av1_fwd_txfm2d_32x32)(int16_t *input, int32_t *output, uint32_t input_stride, TxType transform_type, uint8_t  bit_depth);
 
 
@@ -297,6 +310,7 @@ extern "C" {
 
     void av1_convolve_2d_sr_c(const uint8_t *src, int32_t src_stride, uint8_t *dst, int32_t dst_stride, int32_t w, int32_t h, InterpFilterParams *filter_params_x, InterpFilterParams *filter_params_y, const int32_t subpel_x_q4, const int32_t subpel_y_q4, ConvolveParams *conv_params);
     void av1_convolve_2d_sr_avx2(const uint8_t *src, int32_t src_stride, uint8_t *dst, int32_t dst_stride, int32_t w, int32_t h, InterpFilterParams *filter_params_x, InterpFilterParams *filter_params_y, const int32_t subpel_x_q4, const int32_t subpel_y_q4, ConvolveParams *conv_params);
+    void av1_convolve_2d_sr_avx512(const uint8_t *src, int32_t src_stride, uint8_t *dst, int32_t dst_stride, int32_t w, int32_t h, InterpFilterParams *filter_params_x, InterpFilterParams *filter_params_y, const int32_t subpel_x_q4, const int32_t subpel_y_q4, ConvolveParams *conv_params);
     RTCD_EXTERN void(*av1_convolve_2d_sr)(const uint8_t *src, int32_t src_stride, uint8_t *dst, int32_t dst_stride, int32_t w, int32_t h, InterpFilterParams *filter_params_x, InterpFilterParams *filter_params_y, const int32_t subpel_x_q4, const int32_t subpel_y_q4, ConvolveParams *conv_params);
 
     void av1_jnt_convolve_2d_copy_c(const uint8_t *src, int32_t src_stride, uint8_t *dst, int32_t dst_stride, int32_t w, int32_t h, InterpFilterParams *filter_params_x, InterpFilterParams *filter_params_y, const int32_t subpel_x_q4, const int32_t subpel_y_q4, ConvolveParams *conv_params);
@@ -369,6 +383,7 @@ extern "C" {
 
     void av1_inv_txfm2d_add_32x32_c(const int32_t *input, uint16_t *output, int32_t stride, TxType tx_type, int32_t bd);
     void av1_inv_txfm2d_add_32x32_avx2(const int32_t *input, uint16_t *output, int32_t stride, TxType tx_type, int32_t bd);
+    void av1_inv_txfm2d_add_32x32_avx512(const int32_t *input, uint16_t *output, int32_t stride, TxType tx_type, int32_t bd);
     RTCD_EXTERN void(*av1_inv_txfm2d_add_32x32)(const int32_t *input, uint16_t *output, int32_t stride, TxType tx_type, int32_t bd);
 
     void av1_inv_txfm2d_add_64x64_c(const int32_t *input, uint16_t *output, int32_t stride, TxType tx_type, int32_t bd);
@@ -1371,6 +1386,46 @@ extern "C" {
     void aom_fft8x8_float_avx2(const float *input, float *temp, float *output);
     RTCD_EXTERN void(*aom_fft8x8_float)(const float *input, float *temp, float *output);
 
+    void aom_noise_tx_filter_block_c(float *tx_block, const float *psd, int32_t block_size);
+    void aom_noise_tx_filter_block_avx2(float *tx_block, const float *psd, int32_t block_size);
+    RTCD_EXTERN void(*aom_noise_tx_filter_block)(float *tx_block, const float *psd, int32_t block_size);
+
+    void aom_flat_block_load_c(const uint8_t *data, int32_t stride, int32_t use_highbd, int32_t block_size, double normalization, double *block);
+    void aom_flat_block_load_avx2(const uint8_t *data, int32_t stride, int32_t use_highbd, int32_t block_size, double normalization, double *block);
+    RTCD_EXTERN void(*aom_flat_block_load)(const uint8_t *data, int32_t stride, int32_t use_highbd, int32_t block_size, double normalization, double *block);
+
+    void aom_flat_block_remove_plane_c(const double *A, const double *AtA_inv, int32_t n, double *plane, double *block);
+    void aom_flat_block_remove_plane_avx2(const double *A, const double *AtA_inv, int32_t n, double *plane, double *block);
+    RTCD_EXTERN void(*aom_flat_block_remove_plane)(const double *A, const double *AtA_inv, int32_t n, double *plane, double *block);
+
+    void aom_wiener_window_block_c(const double *block_d, const double *plane_d, const float *window, int32_t n, float *block, float *plane);
+    void aom_wiener_window_block_avx2(const double *block_d, const double *plane_d, const float *window, int32_t n, float *block, float *plane);
+    RTCD_EXTERN void(*aom_wiener_window_block)(const double *block_d, const double *plane_d, const float *window, int32_t n, float *block, float *plane);
+
+    void aom_wiener_accumulate_block_c(const float *block, const float *plane, const float *window, int32_t block_w, int32_t y_start, int32_t y_end, float *result, int32_t result_stride);
+    void aom_wiener_accumulate_block_avx2(const float *block, const float *plane, const float *window, int32_t block_w, int32_t y_start, int32_t y_end, float *result, int32_t result_stride);
+    RTCD_EXTERN void(*aom_wiener_accumulate_block)(const float *block, const float *plane, const float *window, int32_t block_w, int32_t y_start, int32_t y_end, float *result, int32_t result_stride);
+
+    void aom_noise_add_observation_c(const double *buffer, double val, double normalization, int32_t n, double *A, double *b);
+    void aom_noise_add_observation_avx2(const double *buffer, double val, double normalization, int32_t n, double *A, double *b);
+    RTCD_EXTERN void(*aom_noise_add_observation)(const double *buffer, double val, double normalization, int32_t n, double *A, double *b);
+
+    void av1_add_noise_to_luma_row_c(uint8_t *luma, const int32_t *grain, const int32_t *scaling_lut, int32_t width, int32_t scaling_shift, int32_t min_luma, int32_t max_luma);
+    void av1_add_noise_to_luma_row_avx2(uint8_t *luma, const int32_t *grain, const int32_t *scaling_lut, int32_t width, int32_t scaling_shift, int32_t min_luma, int32_t max_luma);
+    RTCD_EXTERN void(*av1_add_noise_to_luma_row)(uint8_t *luma, const int32_t *grain, const int32_t *scaling_lut, int32_t width, int32_t scaling_shift, int32_t min_luma, int32_t max_luma);
+
+    void av1_add_noise_to_luma_row_hbd_c(uint16_t *luma, const int32_t *grain, const int32_t *scaling_lut, int32_t width, int32_t bit_depth, int32_t scaling_shift, int32_t min_luma, int32_t max_luma);
+    void av1_add_noise_to_luma_row_hbd_avx2(uint16_t *luma, const int32_t *grain, const int32_t *scaling_lut, int32_t width, int32_t bit_depth, int32_t scaling_shift, int32_t min_luma, int32_t max_luma);
+    RTCD_EXTERN void(*av1_add_noise_to_luma_row_hbd)(uint16_t *luma, const int32_t *grain, const int32_t *scaling_lut, int32_t width, int32_t bit_depth, int32_t scaling_shift, int32_t min_luma, int32_t max_luma);
+
+    void av1_add_noise_to_chroma_row_c(uint8_t *chroma, const uint8_t *luma, const int32_t *grain, const int32_t *scaling_lut, int32_t width, int32_t chroma_subsamp_x, int32_t luma_mult, int32_t mult, int32_t offset, int32_t scaling_shift, int32_t min_chroma, int32_t max_chroma);
+    void av1_add_noise_to_chroma_row_avx2(uint8_t *chroma, const uint8_t *luma, const int32_t *grain, const int32_t *scaling_lut, int32_t width, int32_t chroma_subsamp_x, int32_t luma_mult, int32_t mult, int32_t offset, int32_t scaling_shift, int32_t min_chroma, int32_t max_chroma);
+    RTCD_EXTERN void(*av1_add_noise_to_chroma_row)(uint8_t *chroma, const uint8_t *luma, const int32_t *grain, const int32_t *scaling_lut, int32_t width, int32_t chroma_subsamp_x, int32_t luma_mult, int32_t mult, int32_t offset, int32_t scaling_shift, int32_t min_chroma, int32_t max_chroma);
+
+    void av1_add_noise_to_chroma_row_hbd_c(uint16_t *chroma, const uint16_t *luma, const int32_t *grain, const int32_t *scaling_lut, int32_t width, int32_t chroma_subsamp_x, int32_t luma_mult, int32_t mult, int32_t offset, int32_t bit_depth, int32_t scaling_shift, int32_t min_chroma, int32_t max_chroma);
+    void av1_add_noise_to_chroma_row_hbd_avx2(uint16_t *chroma, const uint16_t *luma, const int32_t *grain, const int32_t *scaling_lut, int32_t width, int32_t chroma_subsamp_x, int32_t luma_mult, int32_t mult, int32_t offset, int32_t bit_depth, int32_t scaling_shift, int32_t min_chroma, int32_t max_chroma);
+    RTCD_EXTERN void(*av1_add_noise_to_chroma_row_hbd)(uint16_t *chroma, const uint16_t *luma, const int32_t *grain, const int32_t *scaling_lut, int32_t width, int32_t chroma_subsamp_x, int32_t luma_mult, int32_t mult, int32_t offset, int32_t bit_depth, int32_t scaling_shift, int32_t min_chroma, int32_t max_chroma);
+
 #if INTRA_10BIT_SUPPORT
     void aom_highbd_dc_128_predictor_16x16_c(uint16_t *dst, ptrdiff_t y_stride, const uint16_t *above, const uint16_t *left, int32_t bd);
     void aom_highbd_dc_128_predictor_16x16_avx2(uint16_t *dst, ptrdiff_t y_stride, const uint16_t *above, const uint16_t *left, int32_t bd);
@@ -2130,19 +2185,17 @@ extern "C" {
 
     void aom_dsp_rtcd(void);
 
+    // Points the dispatched functions at the versions allowed by flags
+    // (HAS_* bits, 0 selects the C versions); used by the tests and the
+    // benchmarks, which build the encoder sources in.
+    void setup_rtcd_flags(int32_t flags);
+
 
 
 #ifdef RTCD_C
 
-    static void setup_rtcd_internal(EbAsm asm_type)
+    static void setup_rtcd_flags_internal(int32_t flags)
     {
-        int32_t flags = HAS_MMX | HAS_SSE | HAS_SSE2 | HAS_SSE3 | HAS_SSSE3 | HAS_SSE4_1 | HAS_SSE4_2 | HAS_AVX;
-
-        if (asm_type == ASM_AVX2)
-            flags |= HAS_AVX2;
-        //if (asm_type == ASM_NON_AVX2)
-        //    flags = ~HAS_AVX2;
-
         //to use C: flags=0
 
         apply_selfguided_restoration = apply_selfguided_restoration_c;
@@ -2193,6 +2246,12 @@ extern "C" {
         if (flags & HAS_AVX2) av1_highbd_jnt_convolve_y = av1_highbd_jnt_convolve_y_avx2;
         av1_highbd_convolve_x_sr = av1_highbd_convolve_x_sr_c;
         if (flags & HAS_AVX2) av1_highbd_convolve_x_sr = av1_highbd_convolve_x_sr_avx2;
+        av1_warp_affine = av1_warp_affine_c;
+        if (flags & HAS_SSE4_1) av1_warp_affine = av1_warp_affine_sse4_1;
+        if (flags & HAS_AVX2) av1_warp_affine = av1_warp_affine_avx2;
+        av1_highbd_warp_affine = av1_highbd_warp_affine_c;
+        if (flags & HAS_SSE4_1) av1_highbd_warp_affine = av1_highbd_warp_affine_sse4_1;
+        if (flags & HAS_AVX2) av1_highbd_warp_affine = av1_highbd_warp_affine_avx2;
         subtract_average = subtract_average_c;
         if (flags & HAS_AVX2) subtract_average = subtract_average_avx2;
 
@@ -2231,6 +2290,7 @@ extern "C" {
 
         av1_convolve_2d_sr = av1_convolve_2d_sr_c;
         if (flags & HAS_AVX2) av1_convolve_2d_sr = av1_convolve_2d_sr_avx2;
+        if (flags & HAS_AVX512) av1_convolve_2d_sr = av1_convolve_2d_sr_avx512;
 
         av1_jnt_convolve_2d_copy = av1_jnt_convolve_2d_copy_c;
         if (flags & HAS_AVX2) av1_jnt_convolve_2d_copy = av1_jnt_convolve_2d_copy_avx2;
@@ -2264,6 +2324,7 @@ extern "C" {
         if (flags & HAS_AVX2) av1_inv_txfm2d_add_16x16 = av1_inv_txfm2d_add_16x16_avx2;
         av1_inv_txfm2d_add_32x32 = av1_inv_txfm2d_add_32x32_c;
         if (flags & HAS_AVX2) av1_inv_txfm2d_add_32x32 = av1_inv_txfm2d_add_32x32_avx2;
+        if (flags & HAS_AVX512) av1_inv_txfm2d_add_32x32 = av1_inv_txfm2d_add_32x32_avx512;
         av1_inv_txfm2d_add_4x4 = av1_inv_txfm2d_add_4x4_c;
         if (flags & HAS_AVX2) av1_inv_txfm2d_add_4x4 = av1_inv_txfm2d_add_4x4_avx2;
         av1_inv_txfm2d_add_64x64 = av1_inv_txfm2d_add_64x64_c;
@@ -2928,8 +2989,10 @@ extern "C" {
         if (flags & HAS_AVX2) av1_fwd_txfm2d_64x16 = av1_fwd_txfm2d_64x16_avx2;
         av1_fwd_txfm2d_64x64 = Av1TransformTwoD_64x64_c;
         if (flags & HAS_AVX2) av1_fwd_txfm2d_64x64 = av1_fwd_txfm2d_64x64_avx2;
+        if (flags & HAS_AVX512) av1_fwd_txfm2d_64x64 = av1_fwd_txfm2d_64x64_avx512;
         av1_fwd_txfm2d_32x32 = Av1TransformTwoD_32x32_c;
         if (flags & HAS_AVX2) av1_fwd_txfm2d_32x32 = av1_fwd_txfm2d_32x32_avx2;
+        if (flags & HAS_AVX512) av1_fwd_txfm2d_32x32 = av1_fwd_txfm2d_32x32_avx512;
         av1_fwd_txfm2d_16x16 = Av1TransformTwoD_16x16_c;
 #if INTRINSIC_OPT_2
         if (flags & HAS_AVX2) av1_fwd_txfm2d_16x16 = av1_fwd_txfm2d_16x16_avx2;
@@ -3285,6 +3348,39 @@ extern "C" {
         aom_ifft2x2_float = aom_ifft2x2_float_c;
         /*if (flags & HAS_SSE2)*/ aom_ifft4x4_float = aom_ifft4x4_float_sse2;
 
+        aom_noise_tx_filter_block = aom_noise_tx_filter_block_c;
+        if (flags & HAS_AVX2) aom_noise_tx_filter_block = aom_noise_tx_filter_block_avx2;
+        aom_flat_block_load = aom_flat_block_load_c;
+        if (flags & HAS_AVX2) aom_flat_block_load = aom_flat_block_load_avx2;
+        aom_flat_block_remove_plane = aom_flat_block_remove_plane_c;
+        if (flags & HAS_AVX2) aom_flat_block_remove_plane = aom_flat_block_remove_plane_avx2;
+        aom_wiener_window_block = aom_wiener_window_block_c;
+        if (flags & HAS_AVX2) aom_wiener_window_block = aom_wiener_window_block_avx2;
+        aom_wiener_accumulate_block = aom_wiener_accumulate_block_c;
+        if (flags & HAS_AVX2) aom_wiener_accumulate_block = aom_wiener_accumulate_block_avx2;
+        aom_noise_add_observation = aom_noise_add_observation_c;
+        if (flags & HAS_AVX2) aom_noise_add_observation = aom_noise_add_observation_avx2;
+        av1_add_noise_to_luma_row = av1_add_noise_to_luma_row_c;
+        if (flags & HAS_AVX2) av1_add_noise_to_luma_row = av1_add_noise_to_luma_row_avx2;
+        av1_add_noise_to_luma_row_hbd = av1_add_noise_to_luma_row_hbd_c;
+        if (flags & HAS_AVX2) av1_add_noise_to_luma_row_hbd = av1_add_noise_to_luma_row_hbd_avx2;
+        av1_add_noise_to_chroma_row = av1_add_noise_to_chroma_row_c;
+        if (flags & HAS_AVX2) av1_add_noise_to_chroma_row = av1_add_noise_to_chroma_row_avx2;
+        av1_add_noise_to_chroma_row_hbd = av1_add_noise_to_chroma_row_hbd_c;
+        if (flags & HAS_AVX2) av1_add_noise_to_chroma_row_hbd = av1_add_noise_to_chroma_row_hbd_avx2;
+
+    }
+
+    static void setup_rtcd_internal(EbAsm asm_type)
+    {
+        int32_t flags = HAS_MMX | HAS_SSE | HAS_SSE2 | HAS_SSE3 | HAS_SSSE3 | HAS_SSE4_1 | HAS_SSE4_2 | HAS_AVX;
+
+        if (asm_type >= ASM_AVX2)
+            flags |= HAS_AVX2;
+        if (asm_type == ASM_AVX512)
+            flags |= HAS_AVX512;
+
+        setup_rtcd_flags_internal(flags);
     }
 #endif
 
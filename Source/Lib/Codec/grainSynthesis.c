@@ -19,6 +19,7 @@
 #include <stdlib.h>
 #include "EbDefinitions.h"
 #include "grainSynthesis.h"
+#include "aom_dsp_rtcd.h"
 
   // Samples with Gaussian distribution in the range of [-2048, 2047] (12 bits)
   // with zero mean and standard deviation of about 512.
@@ -610,7 +611,7 @@ static void init_scaling_function(int32_t scaling_points[][2], int32_t num_point
 
 // function that extracts samples from a LUT (and interpolates intemediate
 // frames for 10- and 12-bit video)
-static int32_t scale_LUT(int32_t *scaling_lut, int32_t index, int32_t bit_depth) {
+static int32_t scale_LUT(const int32_t *scaling_lut, int32_t index, int32_t bit_depth) {
     int32_t x = index >> (bit_depth - 8);
 
     if (!(bit_depth - 8) || x == 255)
@@ -622,14 +623,79 @@ static int32_t scale_LUT(int32_t *scaling_lut, int32_t index, int32_t bit_depth)
             (bit_depth - 8));
 }
 
+/*
+ * Adds the grain of one row of a block: the grain sample is scaled by the
+ * scaling function of the pixel value (luma) or of the blend of the pixel
+ * and the co-located luma (chroma), then added and clipped.
+ */
+void av1_add_noise_to_luma_row_c(uint8_t *luma, const int32_t *grain,
+    const int32_t *scaling_lut, int32_t width, int32_t scaling_shift,
+    int32_t min_luma, int32_t max_luma) {
+    const int32_t rounding_offset = (1 << (scaling_shift - 1));
+
+    for (int32_t j = 0; j < width; j++) {
+        luma[j] = clamp(luma[j] + ((scale_LUT(scaling_lut, luma[j], 8) * grain[j] +
+            rounding_offset) >> scaling_shift), min_luma, max_luma);
+    }
+}
+
+void av1_add_noise_to_luma_row_hbd_c(uint16_t *luma, const int32_t *grain,
+    const int32_t *scaling_lut, int32_t width, int32_t bit_depth,
+    int32_t scaling_shift, int32_t min_luma, int32_t max_luma) {
+    const int32_t rounding_offset = (1 << (scaling_shift - 1));
+
+    for (int32_t j = 0; j < width; j++) {
+        luma[j] = clamp(luma[j] + ((scale_LUT(scaling_lut, luma[j], bit_depth) * grain[j] +
+            rounding_offset) >> scaling_shift), min_luma, max_luma);
+    }
+}
+
+void av1_add_noise_to_chroma_row_c(uint8_t *chroma, const uint8_t *luma,
+    const int32_t *grain, const int32_t *scaling_lut, int32_t width,
+    int32_t chroma_subsamp_x, int32_t luma_mult, int32_t mult, int32_t offset,
+    int32_t scaling_shift, int32_t min_chroma, int32_t max_chroma) {
+    const int32_t rounding_offset = (1 << (scaling_shift - 1));
+
+    for (int32_t j = 0; j < width; j++) {
+        int32_t average_luma = 0;
+        if (chroma_subsamp_x)
+            average_luma = (luma[j << 1] + luma[(j << 1) + 1] + 1) >> 1;
+        else
+            average_luma = luma[j];
+
+        chroma[j] = clamp(chroma[j] + ((scale_LUT(scaling_lut,
+            clamp(((average_luma * luma_mult + mult * chroma[j]) >> 6) + offset, 0, 255),
+            8) * grain[j] + rounding_offset) >> scaling_shift), min_chroma, max_chroma);
+    }
+}
+
+void av1_add_noise_to_chroma_row_hbd_c(uint16_t *chroma, const uint16_t *luma,
+    const int32_t *grain, const int32_t *scaling_lut, int32_t width,
+    int32_t chroma_subsamp_x, int32_t luma_mult, int32_t mult, int32_t offset,
+    int32_t bit_depth, int32_t scaling_shift, int32_t min_chroma, int32_t max_chroma) {
+    const int32_t rounding_offset = (1 << (scaling_shift - 1));
+
+    for (int32_t j = 0; j < width; j++) {
+        int32_t average_luma = 0;
+        if (chroma_subsamp_x)
+            average_luma = (luma[j << 1] + luma[(j << 1) + 1] + 1) >> 1;
+        else
+            average_luma = luma[j];
+
+        chroma[j] = clamp(chroma[j] + ((scale_LUT(scaling_lut,
+            clamp(((average_luma * luma_mult + mult * chroma[j]) >> 6) + offset,
+                0, (256 << (bit_depth - 8)) - 1),
+            bit_depth) * grain[j] + rounding_offset) >> scaling_shift), min_chroma, max_chroma);
+    }
+}
+
 static void add_noise_to_block(aom_film_grain_t *params, uint8_t *luma,
     uint8_t *cb, uint8_t *cr, int32_t luma_stride,
     int32_t chroma_stride, int32_t *luma_grain,
     int32_t *cb_grain, int32_t *cr_grain,
     int32_t luma_grain_stride, int32_t chroma_grain_stride,
     int32_t half_luma_height, int32_t half_luma_width,
-    int32_t bit_depth, int32_t chroma_subsamp_y,
-    int32_t chroma_subsamp_x) {
+    int32_t chroma_subsamp_y, int32_t chroma_subsamp_x) {
     int32_t cb_mult = params->cb_mult - 128;            // fixed scale
     int32_t cb_luma_mult = params->cb_luma_mult - 128;  // fixed scale
     int32_t cb_offset = params->cb_offset - 256;
@@ -638,8 +704,6 @@ static void add_noise_to_block(aom_film_grain_t *params, uint8_t *luma,
     int32_t cr_luma_mult = params->cr_luma_mult - 128;  // fixed scale
     int32_t cr_offset = params->cr_offset - 256;
 
-    int32_t rounding_offset = (1 << (params->scaling_shift - 1));
-
     int32_t apply_y = params->num_y_points > 0 ? 1 : 0;
     int32_t apply_cb = params->num_cb_points > 0 ? 1 : 0;
     int32_t apply_cr = params->num_cr_points > 0 ? 1 : 0;
@@ -669,65 +733,30 @@ static void add_noise_to_block(aom_film_grain_t *params, uint8_t *luma,
     }
 
     for (int32_t i = 0; i < (half_luma_height << (1 - chroma_subsamp_y)); i++) {
-        for (int32_t j = 0; j < (half_luma_width << (1 - chroma_subsamp_x)); j++) {
-            int32_t average_luma = 0;
-            if (chroma_subsamp_x) {
-                average_luma = (luma[(i << chroma_subsamp_y) * luma_stride +
-                    (j << chroma_subsamp_x)] +
-                    luma[(i << chroma_subsamp_y) * luma_stride +
-                    (j << chroma_subsamp_x) + 1] +
-                    1) >>
-                    1;
-            }
-            else {
-                average_luma = luma[(i << chroma_subsamp_y) * luma_stride + j];
-            }
-
-            if (apply_cb) {
-                cb[i * chroma_stride + j] = clamp(
-                    cb[i * chroma_stride + j] +
-                    ((scale_LUT(scaling_lut_cb,
-                        clamp(((average_luma * cb_luma_mult +
-                            cb_mult * cb[i * chroma_stride + j]) >>
-                            6) +
-                            cb_offset,
-                            0, (256 << (bit_depth - 8)) - 1),
-                        8) *
-                        cb_grain[i * chroma_grain_stride + j] +
-                        rounding_offset) >>
-                        params->scaling_shift),
-                    min_chroma, max_chroma);
-            }
+        if (apply_cb) {
+            av1_add_noise_to_chroma_row(cb + i * chroma_stride,
+                luma + (i << chroma_subsamp_y) * luma_stride,
+                cb_grain + i * chroma_grain_stride, scaling_lut_cb,
+                half_luma_width << (1 - chroma_subsamp_x), chroma_subsamp_x,
+                cb_luma_mult, cb_mult, cb_offset, params->scaling_shift,
+                min_chroma, max_chroma);
+        }
 
-            if (apply_cr) {
-                cr[i * chroma_stride + j] = clamp(
-                    cr[i * chroma_stride + j] +
-                    ((scale_LUT(scaling_lut_cr,
-                        clamp(((average_luma * cr_luma_mult +
-                            cr_mult * cr[i * chroma_stride + j]) >>
-                            6) +
-                            cr_offset,
-                            0, (256 << (bit_depth - 8)) - 1),
-                        8) *
-                        cr_grain[i * chroma_grain_stride + j] +
-                        rounding_offset) >>
-                        params->scaling_shift),
-                    min_chroma, max_chroma);
-            }
+        if (apply_cr) {
+            av1_add_noise_to_chroma_row(cr + i * chroma_stride,
+                luma + (i << chroma_subsamp_y) * luma_stride,
+                cr_grain + i * chroma_grain_stride, scaling_lut_cr,
+                half_luma_width << (1 - chroma_subsamp_x), chroma_subsamp_x,
+                cr_luma_mult, cr_mult, cr_offset, params->scaling_shift,
+                min_chroma, max_chroma);
         }
     }
 
     if (apply_y) {
         for (int32_t i = 0; i < (half_luma_height << 1); i++) {
-            for (int32_t j = 0; j < (half_luma_width << 1); j++) {
-                luma[i * luma_stride + j] =
-                    clamp(luma[i * luma_stride + j] +
-                    ((scale_LUT(scaling_lut_y, luma[i * luma_stride + j], 8) *
-                        luma_grain[i * luma_grain_stride + j] +
-                        rounding_offset) >>
-                        params->scaling_shift),
-                        min_luma, max_luma);
-            }
+            av1_add_noise_to_luma_row(luma + i * luma_stride,
+                luma_grain + i * luma_grain_stride, scaling_lut_y,
+                half_luma_width << 1, params->scaling_shift, min_luma, max_luma);
         }
     }
 }
@@ -748,8 +777,6 @@ static void add_noise_to_block_hbd(
     // offset value depends on the bit depth
     int32_t cr_offset = (params->cr_offset << (bit_depth - 8)) - (1 << bit_depth);
 
-    int32_t rounding_offset = (1 << (params->scaling_shift - 1));
-
     int32_t apply_y = params->num_y_points > 0 ? 1 : 0;
     int32_t apply_cb = params->num_cb_points > 0 ? 1 : 0;
     int32_t apply_cr = params->num_cr_points > 0 ? 1 : 0;
@@ -779,65 +806,31 @@ static void add_noise_to_block_hbd(
     }
 
     for (int32_t i = 0; i < (half_luma_height << (1 - chroma_subsamp_y)); i++) {
-        for (int32_t j = 0; j < (half_luma_width << (1 - chroma_subsamp_x)); j++) {
-            int32_t average_luma = 0;
-            if (chroma_subsamp_x) {
-                average_luma = (luma[(i << chroma_subsamp_y) * luma_stride +
-                    (j << chroma_subsamp_x)] +
-                    luma[(i << chroma_subsamp_y) * luma_stride +
-                    (j << chroma_subsamp_x) + 1] +
-                    1) >>
-                    1;
-            }
-            else {
-                average_luma = luma[(i << chroma_subsamp_y) * luma_stride + j];
-            }
+        if (apply_cb) {
+            av1_add_noise_to_chroma_row_hbd(cb + i * chroma_stride,
+                luma + (i << chroma_subsamp_y) * luma_stride,
+                cb_grain + i * chroma_grain_stride, scaling_lut_cb,
+                half_luma_width << (1 - chroma_subsamp_x), chroma_subsamp_x,
+                cb_luma_mult, cb_mult, cb_offset, bit_depth, params->scaling_shift,
+                min_chroma, max_chroma);
+        }
 
-            if (apply_cb) {
-                cb[i * chroma_stride + j] = clamp(
-                    cb[i * chroma_stride + j] +
-                    ((scale_LUT(scaling_lut_cb,
-                        clamp(((average_luma * cb_luma_mult +
-                            cb_mult * cb[i * chroma_stride + j]) >>
-                            6) +
-                            cb_offset,
-                            0, (256 << (bit_depth - 8)) - 1),
-                        bit_depth) *
-                        cb_grain[i * chroma_grain_stride + j] +
-                        rounding_offset) >>
-                        params->scaling_shift),
-                    min_chroma, max_chroma);
-            }
-            if (apply_cr) {
-                cr[i * chroma_stride + j] = clamp(
-                    cr[i * chroma_stride + j] +
-                    ((scale_LUT(scaling_lut_cr,
-                        clamp(((average_luma * cr_luma_mult +
-                            cr_mult * cr[i * chroma_stride + j]) >>
-                            6) +
-                            cr_offset,
-                            0, (256 << (bit_depth - 8)) - 1),
-                        bit_depth) *
-                        cr_grain[i * chroma_grain_stride + j] +
-                        rounding_offset) >>
-                        params->scaling_shift),
-                    min_chroma, max_chroma);
-            }
+        if (apply_cr) {
+            av1_add_noise_to_chroma_row_hbd(cr + i * chroma_stride,
+                luma + (i << chroma_subsamp_y) * luma_stride,
+                cr_grain + i * chroma_grain_stride, scaling_lut_cr,
+                half_luma_width << (1 - chroma_subsamp_x), chroma_subsamp_x,
+                cr_luma_mult, cr_mult, cr_offset, bit_depth, params->scaling_shift,
+                min_chroma, max_chroma);
         }
     }
 
     if (apply_y) {
         for (int32_t i = 0; i < (half_luma_height << 1); i++) {
-            for (int32_t j = 0; j < (half_luma_width << 1); j++) {
-                luma[i * luma_stride + j] =
-                    clamp(luma[i * luma_stride + j] +
-                    ((scale_LUT(scaling_lut_y, luma[i * luma_stride + j],
-                        bit_depth) *
-                        luma_grain[i * luma_grain_stride + j] +
-                        rounding_offset) >>
-                        params->scaling_shift),
-                        min_luma, max_luma);
-            }
+            av1_add_noise_to_luma_row_hbd(luma + i * luma_stride,
+                luma_grain + i * luma_grain_stride, scaling_lut_y,
+                half_luma_width << 1, bit_depth, params->scaling_shift, min_luma,
+                max_luma);
         }
     }
 }
@@ -1159,7 +1152,7 @@ void av1_add_film_grain_run(aom_film_grain_t *params, uint8_t *luma,
                         cr_col_buf + i * (2 - chroma_subsamp_y) * (2 - chroma_subsamp_x),
                         2, (2 - chroma_subsamp_x),
                         AOMMIN(luma_subblock_size_y >> 1, height / 2 - y) - i, 1,
-                        bit_depth, chroma_subsamp_y, chroma_subsamp_x);
+                        chroma_subsamp_y, chroma_subsamp_x);
                 }
             }
 
@@ -1242,7 +1235,7 @@ void av1_add_film_grain_run(aom_film_grain_t *params, uint8_t *luma,
                         cb_line_buf + (x << (1 - chroma_subsamp_x)),
                         cr_line_buf + (x << (1 - chroma_subsamp_x)), luma_stride,
                         chroma_stride, 1,
-                        AOMMIN(luma_subblock_size_x >> 1, width / 2 - x), bit_depth,
+                        AOMMIN(luma_subblock_size_x >> 1, width / 2 - x),
                         chroma_subsamp_y, chroma_subsamp_x);
                 }
             }
@@ -1296,7 +1289,7 @@ void av1_add_film_grain_run(aom_film_grain_t *params, uint8_t *luma,
                     chroma_offset_x + (j << (1 - chroma_subsamp_x)),
                     luma_grain_stride, chroma_grain_stride,
                     AOMMIN(luma_subblock_size_y >> 1, height / 2 - y) - i,
-                    AOMMIN(luma_subblock_size_x >> 1, width / 2 - x) - j, bit_depth,
+                    AOMMIN(luma_subblock_size_x >> 1, width / 2 - x) - j,
                     chroma_subsamp_y, chroma_subsamp_x);
             }
 
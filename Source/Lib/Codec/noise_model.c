@@ -15,6 +15,7 @@
 #include "noise_model.h"
 #include "noise_util.h"
 #include "mathutils.h"
+#include "aom_dsp_rtcd.h"
 
 #define kLowPolyNumParams 3
 
@@ -519,19 +520,61 @@ void aom_flat_block_finder_free(aom_flat_block_finder_t *block_finder) {
     memset(block_finder, 0, sizeof(*block_finder));
 }
 
+void aom_flat_block_load_c(const uint8_t *data, int32_t stride,
+    int32_t use_highbd, int32_t block_size, double normalization, double *block) {
+    int32_t xi, yi;
+
+    if (use_highbd) {
+        const uint16_t *const data16 = (const uint16_t *const)data;
+        for (yi = 0; yi < block_size; ++yi) {
+            for (xi = 0; xi < block_size; ++xi) {
+                block[yi * block_size + xi] =
+                    ((double)data16[yi * stride + xi]) / normalization;
+            }
+        }
+    }
+    else {
+        for (yi = 0; yi < block_size; ++yi) {
+            for (xi = 0; xi < block_size; ++xi) {
+                block[yi * block_size + xi] =
+                    ((double)data[yi * stride + xi]) / normalization;
+            }
+        }
+    }
+}
+
+void aom_flat_block_remove_plane_c(const double *A, const double *AtA_inv,
+    int32_t n, double *plane, double *block) {
+    double plane_coords[kLowPolyNumParams];
+    double AtA_inv_b[kLowPolyNumParams];
+    int32_t i;
+
+    multiply_mat(block, A, AtA_inv_b, 1, n, kLowPolyNumParams);
+    multiply_mat(AtA_inv, AtA_inv_b, plane_coords, kLowPolyNumParams,
+        kLowPolyNumParams, 1);
+    multiply_mat(A, plane_coords, plane, n, kLowPolyNumParams, 1);
+
+    for (i = 0; i < n; ++i) {
+        block[i] -= plane[i];
+    }
+}
+
 void aom_flat_block_finder_extract_block(
     const aom_flat_block_finder_t *block_finder, const uint8_t *const data,
     int32_t w, int32_t h, int32_t stride, int32_t offsx, int32_t offsy, double *plane,
     double *block) {
     const int32_t block_size = block_finder->block_size;
     const int32_t n = block_size * block_size;
-    const double *A = block_finder->A;
-    const double *AtA_inv = block_finder->AtA_inv;
-    double plane_coords[kLowPolyNumParams];
-    double AtA_inv_b[kLowPolyNumParams];
-    int32_t xi, yi, i;
+    int32_t xi, yi;
 
-    if (block_finder->use_highbd) {
+    if (offsx >= 0 && offsy >= 0 && offsx + block_size <= w && offsy + block_size <= h) {
+        // Inner block, no clamping
+        const int32_t offset = offsy * stride + offsx;
+        aom_flat_block_load(
+            block_finder->use_highbd ? (const uint8_t *)((const uint16_t *)data + offset) : data + offset,
+            stride, block_finder->use_highbd, block_size, block_finder->normalization, block);
+    }
+    else if (block_finder->use_highbd) {
         const uint16_t *const data16 = (const uint16_t *const)data;
         for (yi = 0; yi < block_size; ++yi) {
             const int32_t y = clamp(offsy + yi, 0, h - 1);
@@ -552,14 +595,8 @@ void aom_flat_block_finder_extract_block(
             }
         }
     }
-    multiply_mat(block, A, AtA_inv_b, 1, n, kLowPolyNumParams);
-    multiply_mat(AtA_inv, AtA_inv_b, plane_coords, kLowPolyNumParams,
-        kLowPolyNumParams, 1);
-    multiply_mat(A, plane_coords, plane, n, kLowPolyNumParams, 1);
-
-    for (i = 0; i < n; ++i) {
-        block[i] -= plane[i];
-    }
+    aom_flat_block_remove_plane(block_finder->A, block_finder->AtA_inv, n,
+        plane, block);
 }
 
 typedef struct {
@@ -577,9 +614,13 @@ static int32_t compare_scores(const void *a, const void *b) {
     return 0;
 }
 
-int32_t aom_flat_block_finder_run(const aom_flat_block_finder_t *block_finder,
-    const uint8_t *const data, int32_t w, int32_t h,
-    int32_t stride, uint8_t *flat_blocks) {
+// Scores the blocks of the block rows [by_start, by_end). flat_blocks is set
+// for the blocks passing the thresholds, the final flat blocks also include
+// the top scored blocks of the whole picture (flat_block_finder_select()).
+static int32_t flat_block_finder_score_rows(
+    const aom_flat_block_finder_t *block_finder, const uint8_t *const data,
+    int32_t w, int32_t h, int32_t stride, int32_t by_start, int32_t by_end,
+    uint8_t *flat_blocks, index_and_score_t *scores) {
     // The gradient-based features used in this code are based on:
     //  A. Kokaram, D. Kelly, H. Denman and A. Crawford, "Measuring noise
     //  correlation for improved video denoising," 2012 19th, ICIP.
@@ -592,25 +633,17 @@ int32_t aom_flat_block_finder_run(const aom_flat_block_finder_t *block_finder,
     const double kNormThreshold = 0.08 / (32 * 32);
     const double kVarThreshold = 0.005 / (double)n;
     const int32_t num_blocks_w = (w + block_size - 1) / block_size;
-    const int32_t num_blocks_h = (h + block_size - 1) / block_size;
-    int32_t num_flat = 0;
     int32_t bx = 0, by = 0;
     double *plane = (double *)malloc(n * sizeof(*plane));
     double *block = (double *)malloc(n * sizeof(*block));
-    index_and_score_t *scores = (index_and_score_t *)malloc(
-        num_blocks_w * num_blocks_h * sizeof(*scores));
-    if (plane == NULL || block == NULL || scores == NULL) {
+    if (plane == NULL || block == NULL) {
         fprintf(stderr, "Failed to allocate memory for block of size %d\n", n);
         free(plane);
         free(block);
-        free(scores);
-        return -1;
+        return 0;
     }
 
-#ifdef NOISE_MODEL_LOG_SCORE
-    fprintf(stderr, "score = [");
-#endif
-    for (by = 0; by < num_blocks_h; ++by) {
+    for (by = by_start; by < by_end; ++by) {
         for (bx = 0; bx < num_blocks_w; ++bx) {
             // Compute gradient covariance matrix.
             double Gxx = 0, Gxy = 0, Gyy = 0;
@@ -674,30 +707,64 @@ int32_t aom_flat_block_finder_run(const aom_flat_block_finder_t *block_finder,
                 fprintf(stderr, "%g %g %g %g %g %d ", score, var, ratio, trace, norm,
                     is_flat);
 #endif
-                num_flat += is_flat;
             }
         }
 #ifdef NOISE_MODEL_LOG_SCORE
         fprintf(stderr, "\n");
 #endif
     }
-#ifdef NOISE_MODEL_LOG_SCORE
-    fprintf(stderr, "];\n");
-#endif
-    // Find the top-scored blocks (most likely to be flat) and set the flat blocks
-    // be the union of the thresholded results and the top 10th percentile of the
-    // scored results.
-    qsort(scores, num_blocks_w * num_blocks_h, sizeof(*scores), &compare_scores);
-    const int32_t top_nth_percentile = num_blocks_w * num_blocks_h * 90 / 100;
+    free(block);
+    free(plane);
+    return 1;
+}
+
+// Find the top-scored blocks (most likely to be flat) and set the flat blocks
+// be the union of the thresholded results and the top 10th percentile of the
+// scored results. Returns the number of flat blocks.
+static int32_t flat_block_finder_select(int32_t num_blocks, uint8_t *flat_blocks,
+    index_and_score_t *scores) {
+    int32_t num_flat = 0;
+    for (int32_t i = 0; i < num_blocks; ++i)
+        num_flat += flat_blocks[i] != 0;
+
+    qsort(scores, num_blocks, sizeof(*scores), &compare_scores);
+    const int32_t top_nth_percentile = num_blocks * 90 / 100;
     const float score_threshold = scores[top_nth_percentile].score;
-    for (int32_t i = 0; i < num_blocks_w * num_blocks_h; ++i) {
+    for (int32_t i = 0; i < num_blocks; ++i) {
         if (scores[i].score >= score_threshold) {
             num_flat += flat_blocks[scores[i].index] == 0;
             flat_blocks[scores[i].index] |= 1;
         }
     }
-    free(block);
-    free(plane);
+    return num_flat;
+}
+
+int32_t aom_flat_block_finder_run(const aom_flat_block_finder_t *block_finder,
+    const uint8_t *const data, int32_t w, int32_t h,
+    int32_t stride, uint8_t *flat_blocks) {
+    const int32_t block_size = block_finder->block_size;
+    const int32_t num_blocks_w = (w + block_size - 1) / block_size;
+    const int32_t num_blocks_h = (h + block_size - 1) / block_size;
+    int32_t num_flat = -1;
+    index_and_score_t *scores = (index_and_score_t *)malloc(
+        num_blocks_w * num_blocks_h * sizeof(*scores));
+    if (scores == NULL) {
+        fprintf(stderr, "Failed to allocate memory for %d block scores\n",
+            num_blocks_w * num_blocks_h);
+        return -1;
+    }
+
+#ifdef NOISE_MODEL_LOG_SCORE
+    fprintf(stderr, "score = [");
+#endif
+    if (flat_block_finder_score_rows(block_finder, data, w, h, stride, 0,
+        num_blocks_h, flat_blocks, scores)) {
+#ifdef NOISE_MODEL_LOG_SCORE
+        fprintf(stderr, "];\n");
+#endif
+        num_flat = flat_block_finder_select(num_blocks_w * num_blocks_h,
+            flat_blocks, scores);
+    }
     free(scores);
     return num_flat;
 }
@@ -815,6 +882,17 @@ void aom_noise_model_free(aom_noise_model_t *model) {
 EXTRACT_AR_ROW(uint8_t, lowbd);
 EXTRACT_AR_ROW(uint16_t, highbd);
 
+void aom_noise_add_observation_c(const double *buffer, double val,
+    double normalization, int32_t n, double *A, double *b) {
+    for (int32_t i = 0; i < n; ++i) {
+        for (int32_t j = 0; j < n; ++j) {
+            A[i * n + j] +=
+                (buffer[i] * buffer[j]) / (normalization * normalization);
+        }
+        b[i] += (buffer[i] * val) / (normalization * normalization);
+    }
+}
+
 static int32_t add_block_observations(
     aom_noise_model_t *noise_model, int32_t c, const uint8_t *const data,
     const uint8_t *const denoised, int32_t w, int32_t h, int32_t stride, int32_t sub_log2[2],
@@ -866,13 +944,7 @@ static int32_t add_block_observations(
                             denoised, stride, sub_log2, alt_data,
                             alt_denoised, alt_stride, x + x_o,
                             y + y_o, buffer);
-                    for (int32_t i = 0; i < n; ++i) {
-                        for (int32_t j = 0; j < n; ++j) {
-                            A[i * n + j] +=
-                                (buffer[i] * buffer[j]) / (normalization * normalization);
-                        }
-                        b[i] += (buffer[i] * val) / (normalization * normalization);
-                    }
+                    aom_noise_add_observation(buffer, val, normalization, n, A, b);
                     noise_model->latest_state[c].num_observations++;
                 }
             }
@@ -1305,9 +1377,23 @@ int32_t aom_noise_model_get_grain_parameters(aom_noise_model_t *const noise_mode
     return 1;
 }
 
-static void pointwise_multiply(const float *a, float *b, int32_t n) {
+void aom_wiener_window_block_c(const double *block_d, const double *plane_d,
+    const float *window, int32_t n, float *block, float *plane) {
     for (int32_t i = 0; i < n; ++i) {
-        b[i] *= a[i];
+        block[i] = (float)block_d[i] * window[i];
+        plane[i] = (float)plane_d[i] * window[i];
+    }
+}
+
+void aom_wiener_accumulate_block_c(const float *block, const float *plane,
+    const float *window, int32_t block_w, int32_t y_start, int32_t y_end,
+    float *result, int32_t result_stride) {
+    for (int32_t y = y_start; y < y_end; ++y) {
+        for (int32_t x = 0; x < block_w; ++x) {
+            result[y * result_stride + x] +=
+                (block[y * block_w + x] + plane[y * block_w + x]) *
+                window[y * block_w + x];
+        }
     }
 }
 
@@ -1360,10 +1446,26 @@ static float *get_half_cos_window(int32_t block_size) {
 DITHER_AND_QUANTIZE(uint8_t, lowbd);
 DITHER_AND_QUANTIZE(uint16_t, highbd);
 
-int32_t aom_wiener_denoise_2d(const uint8_t *const data[3], uint8_t *denoised[3],
-    int32_t w, int32_t h, int32_t stride[3], int32_t chroma_sub[2],
-    float *noise_psd[3], int32_t block_size, int32_t bit_depth,
-    int32_t use_highbd) {
+// Size of the buffer holding the overlapped block sums of a plane, with one
+// block of border on each side
+static INLINE int32_t wiener_result_stride(int32_t w, int32_t block_size) {
+    return ((w + block_size - 1) / block_size + 2) * block_size;
+}
+
+static INLINE int32_t wiener_result_height(int32_t h, int32_t block_size,
+    int32_t chroma_sub_h) {
+    return ((h + block_size - 1) / block_size + 2) * (block_size >> chroma_sub_h);
+}
+
+// Filters the blocks overlapping the luma rows [row_start, row_end) (and the
+// matching chroma rows) and sums them in result. Only the result rows of the
+// range are written: a block across two ranges is filtered for each of them,
+// so every result sample sums its blocks in the same order however the
+// picture is split.
+static int32_t wiener_denoise_2d_rows(const uint8_t *const data[3],
+    float *result[3], int32_t w, int32_t h, int32_t stride[3],
+    int32_t chroma_sub[2], float *noise_psd[3], int32_t block_size,
+    int32_t bit_depth, int32_t use_highbd, int32_t row_start, int32_t row_end) {
     float *plane = NULL, *window_full = NULL,
         *window_chroma = NULL;
     DECLARE_ALIGNED(32, float, *block);
@@ -1373,13 +1475,10 @@ int32_t aom_wiener_denoise_2d(const uint8_t *const data[3], uint8_t *denoised[3]
     struct aom_noise_tx_t *tx_chroma = NULL;
     const int32_t num_blocks_w = (w + block_size - 1) / block_size;
     const int32_t num_blocks_h = (h + block_size - 1) / block_size;
-    const int32_t result_stride = (num_blocks_w + 2) * block_size;
-    const int32_t result_height = (num_blocks_h + 2) * block_size;
-    float *result = NULL;
+    const int32_t result_stride = wiener_result_stride(w, block_size);
     int32_t init_success = 1;
     aom_flat_block_finder_t block_finder_full;
     aom_flat_block_finder_t block_finder_chroma;
-    const float kBlockNormalization = (float)((1 << bit_depth) - 1);
     if (chroma_sub[0] != chroma_sub[1]) {
         fprintf(stderr,
             "aom_wiener_denoise_2d doesn't handle different chroma "
@@ -1388,8 +1487,6 @@ int32_t aom_wiener_denoise_2d(const uint8_t *const data[3], uint8_t *denoised[3]
     }
     init_success &= aom_flat_block_finder_init(&block_finder_full, block_size,
         bit_depth, use_highbd);
-    result = (float *)malloc((num_blocks_h + 2) * block_size * result_stride *
-        sizeof(*result));
     plane = (float *)malloc(block_size * block_size * sizeof(*plane));
     block =
         (float *)aom_memalign(32, 2 * block_size * block_size * sizeof(*block));
@@ -1412,76 +1509,58 @@ int32_t aom_wiener_denoise_2d(const uint8_t *const data[3], uint8_t *denoised[3]
 
     init_success &= (int32_t)((tx_full != NULL) && (tx_chroma != NULL) && (plane != NULL) &&
         (plane_d != NULL) && (block != NULL) && (block_d != NULL) &&
-        (window_full != NULL) && (window_chroma != NULL) &&
-        (result != NULL));
+        (window_full != NULL) && (window_chroma != NULL));
     for (int32_t c = init_success ? 0 : 3; c < 3; ++c) {
         float *window_function = c == 0 ? window_full : window_chroma;
         aom_flat_block_finder_t *block_finder = &block_finder_full;
         const int32_t chroma_sub_h = c > 0 ? chroma_sub[1] : 0;
         const int32_t chroma_sub_w = c > 0 ? chroma_sub[0] : 0;
+        const int32_t block_h = block_size >> chroma_sub_h;
+        const int32_t block_w = block_size >> chroma_sub_w;
+        // Result rows of the range, the result starts one block above the plane
+        const int32_t result_start = (row_start >> chroma_sub_h) + block_h;
+        const int32_t result_end = (row_end >> chroma_sub_h) + block_h;
         struct aom_noise_tx_t *tx =
             (c > 0 && chroma_sub[0] > 0) ? tx_chroma : tx_full;
-        if (!data[c] || !denoised[c]) continue;
+        if (!data[c] || !result[c]) continue;
         if (c > 0 && chroma_sub[0] != 0) {
             block_finder = &block_finder_chroma;
         }
-        memset(result, 0, sizeof(*result) * result_stride * result_height);
         // Do overlapped block processing (half overlapped). The block rows can
         // easily be done in parallel
-        for (int32_t offsy = 0; offsy < (block_size >> chroma_sub_h);
-            offsy += (block_size >> chroma_sub_h) / 2) {
-            for (int32_t offsx = 0; offsx < (block_size >> chroma_sub_w);
-                offsx += (block_size >> chroma_sub_w) / 2) {
+        for (int32_t offsy = 0; offsy < block_h; offsy += block_h / 2) {
+            for (int32_t offsx = 0; offsx < block_w; offsx += block_w / 2) {
                 // Pad the boundary when processing each block-set.
                 for (int32_t by = -1; by < num_blocks_h; ++by) {
+                    const int32_t y_result = (by + 1) * block_h + offsy;
+                    const int32_t y_start = AOMMAX(result_start - y_result, 0);
+                    const int32_t y_end = AOMMIN(result_end - y_result, block_h);
+                    if (y_start >= y_end) continue;
                     for (int32_t bx = -1; bx < num_blocks_w; ++bx) {
-                        const int32_t pixels_per_block =
-                            (block_size >> chroma_sub_w) * (block_size >> chroma_sub_h);
+                        const int32_t pixels_per_block = block_w * block_h;
+                        const int32_t x_result = (bx + 1) * block_w + offsx;
                         aom_flat_block_finder_extract_block(
                             block_finder, data[c], w >> chroma_sub_w, h >> chroma_sub_h,
-                            stride[c], bx * (block_size >> chroma_sub_w) + offsx,
-                            by * (block_size >> chroma_sub_h) + offsy, plane_d, block_d);
-                        for (int32_t j = 0; j < pixels_per_block; ++j) {
-                            block[j] = (float)block_d[j];
-                            plane[j] = (float)plane_d[j];
-                        }
-                        pointwise_multiply(window_function, block, pixels_per_block);
+                            stride[c], bx * block_w + offsx,
+                            by * block_h + offsy, plane_d, block_d);
+                        // Apply the window function to the block, and to the plane
+                        // approximation (we will apply it to the sum of plane + block
+                        // when composing the results).
+                        aom_wiener_window_block(block_d, plane_d, window_function,
+                            pixels_per_block, block, plane);
                         aom_noise_tx_forward(tx, block);
                         aom_noise_tx_filter(tx, noise_psd[c]);
                         aom_noise_tx_inverse(tx, block);
 
-                        // Apply window function to the plane approximation (we will apply
-                        // it to the sum of plane + block when composing the results).
-                        pointwise_multiply(window_function, plane, pixels_per_block);
-
-                        for (int32_t y = 0; y < (block_size >> chroma_sub_h); ++y) {
-                            const int32_t y_result =
-                                y + (by + 1) * (block_size >> chroma_sub_h) + offsy;
-                            for (int32_t x = 0; x < (block_size >> chroma_sub_w); ++x) {
-                                const int32_t x_result =
-                                    x + (bx + 1) * (block_size >> chroma_sub_w) + offsx;
-                                result[y_result * result_stride + x_result] +=
-                                    (block[y * (block_size >> chroma_sub_w) + x] +
-                                        plane[y * (block_size >> chroma_sub_w) + x]) *
-                                    window_function[y * (block_size >> chroma_sub_w) + x];
-                            }
-                        }
+                        aom_wiener_accumulate_block(block, plane, window_function,
+                            block_w, y_start, y_end,
+                            result[c] + y_result * result_stride + x_result,
+                            result_stride);
                     }
                 }
             }
         }
-        if (use_highbd) {
-            dither_and_quantize_highbd(result, result_stride, (uint16_t *)denoised[c],
-                w, h, stride[c], chroma_sub_w, chroma_sub_h,
-                block_size, kBlockNormalization);
-        }
-        else {
-            dither_and_quantize_lowbd(result, result_stride, denoised[c], w, h,
-                stride[c], chroma_sub_w, chroma_sub_h,
-                block_size, kBlockNormalization);
-        }
     }
-    free(result);
     free(plane);
     aom_free(block);
     free(plane_d);
@@ -1499,6 +1578,69 @@ int32_t aom_wiener_denoise_2d(const uint8_t *const data[3], uint8_t *denoised[3]
     return init_success;
 }
 
+// Dithers the sums of wiener_denoise_2d_rows() to the denoised planes. The
+// error diffusion runs over whole planes.
+static void wiener_denoise_2d_quantize(float *result[3], uint8_t *denoised[3],
+    int32_t w, int32_t h, int32_t stride[3], int32_t chroma_sub[2],
+    int32_t block_size, int32_t bit_depth, int32_t use_highbd) {
+    const int32_t result_stride = wiener_result_stride(w, block_size);
+    const float kBlockNormalization = (float)((1 << bit_depth) - 1);
+    for (int32_t c = 0; c < 3; ++c) {
+        const int32_t chroma_sub_h = c > 0 ? chroma_sub[1] : 0;
+        const int32_t chroma_sub_w = c > 0 ? chroma_sub[0] : 0;
+        if (!result[c] || !denoised[c]) continue;
+        if (use_highbd) {
+            dither_and_quantize_highbd(result[c], result_stride, (uint16_t *)denoised[c],
+                w, h, stride[c], chroma_sub_w, chroma_sub_h,
+                block_size, kBlockNormalization);
+        }
+        else {
+            dither_and_quantize_lowbd(result[c], result_stride, denoised[c], w, h,
+                stride[c], chroma_sub_w, chroma_sub_h,
+                block_size, kBlockNormalization);
+        }
+    }
+}
+
+// Allocates the zeroed result buffers of the planes of data
+static int32_t wiener_result_alloc(const uint8_t *const data[3], float *result[3],
+    int32_t w, int32_t h, int32_t chroma_sub[2], int32_t block_size) {
+    const int32_t result_stride = wiener_result_stride(w, block_size);
+    int32_t success = 1;
+    for (int32_t c = 0; c < 3; ++c) {
+        const size_t result_size = (size_t)result_stride *
+            wiener_result_height(h, block_size, c > 0 ? chroma_sub[1] : 0);
+        result[c] = data[c] ? (float *)calloc(result_size, sizeof(*result[c])) : NULL;
+        success &= (int32_t)(!data[c] || result[c] != NULL);
+    }
+    return success;
+}
+
+static void wiener_result_free(float *result[3]) {
+    for (int32_t c = 0; c < 3; ++c) {
+        free(result[c]);
+        result[c] = NULL;
+    }
+}
+
+int32_t aom_wiener_denoise_2d(const uint8_t *const data[3], uint8_t *denoised[3],
+    int32_t w, int32_t h, int32_t stride[3], int32_t chroma_sub[2],
+    float *noise_psd[3], int32_t block_size, int32_t bit_depth,
+    int32_t use_highbd) {
+    float *result[3] = { NULL, NULL, NULL };
+    int32_t init_success = wiener_result_alloc(data, result, w, h, chroma_sub,
+        block_size);
+
+    init_success = init_success && wiener_denoise_2d_rows(data, result, w, h, stride,
+        chroma_sub, noise_psd, block_size, bit_depth, use_highbd, 0, h);
+    if (init_success) {
+        wiener_denoise_2d_quantize(result, denoised, w, h, stride, chroma_sub,
+            block_size, bit_depth, use_highbd);
+    }
+    wiener_result_free(result);
+    return init_success;
+}
+
 struct aom_denoise_and_model_t {
     int32_t block_size;
     int32_t bit_depth;
@@ -1522,6 +1664,13 @@ struct aom_denoise_and_model_t {
 
     aom_flat_block_finder_t flat_block_finder;
     aom_noise_model_t noise_model;
+
+    // Picture being denoised, shared by the row segments between
+    // aom_denoise_and_model_prepare() and aom_denoise_and_model_finish()
+    int32_t prepared;
+    const uint8_t *data[3];
+    float *result[3];
+    index_and_score_t *scores;
 };
 
 
@@ -1596,6 +1745,8 @@ EbErrorType denoise_and_model_ctor(EbPtr *object_dbl_ptr,
 
 void aom_denoise_and_model_free(struct aom_denoise_and_model_t *ctx, int32_t use_highbd) {
     free(ctx->flat_blocks);
+    free(ctx->scores);
+    wiener_result_free(ctx->result);
     for (int32_t i = 0; i < 3; ++i) {
         free(ctx->denoised[i]);
         free(ctx->noise_psd[i]);
@@ -1741,83 +1892,153 @@ static void unpack_2d_pic(uint8_t *packed[3],
 
 }
 
-int32_t aom_denoise_and_model_run(struct aom_denoise_and_model_t *ctx,
+int32_t aom_denoise_and_model_prepare(struct aom_denoise_and_model_t *ctx,
     EbPictureBufferDesc_t *sd,
-    aom_film_grain_t *film_grain,
     int32_t use_highbd,
     EbAsm asm_type) {
 
-    const int32_t block_size = ctx->block_size;
-    uint8_t *raw_data[3];
     int32_t chroma_sub_log2[2] = { 1, 1 };  //todo: send chroma subsampling
-    int32_t strides[3] = { sd->stride_y, sd->strideCb, sd->strideCr };
 
+    ctx->prepared = 0;
     if (!denoise_and_model_realloc_if_necessary(ctx, sd, use_highbd)) {
         fprintf(stderr, "Unable to realloc buffers\n");
         return 0;
     }
 
     if (!use_highbd) {  // 8 bits input
-        raw_data[0] = sd->buffer_y + sd->origin_y * sd->stride_y + sd->origin_x;
-        raw_data[1] = sd->bufferCb + sd->strideCb * (sd->origin_y >> chroma_sub_log2[0])
+        ctx->data[0] = sd->buffer_y + sd->origin_y * sd->stride_y + sd->origin_x;
+        ctx->data[1] = sd->bufferCb + sd->strideCb * (sd->origin_y >> chroma_sub_log2[0])
             + (sd->origin_x >> chroma_sub_log2[1]);
-        raw_data[2] = sd->bufferCr + sd->strideCr * (sd->origin_y >> chroma_sub_log2[0])
+        ctx->data[2] = sd->bufferCr + sd->strideCr * (sd->origin_y >> chroma_sub_log2[0])
             + (sd->origin_x >> chroma_sub_log2[1]);
     }
     else {          // 10 bits input
         pack_2d_pic(sd, ctx->packed, asm_type);
 
-        raw_data[0] = (uint8_t *)(ctx->packed[0]);
-        raw_data[1] = (uint8_t *)(ctx->packed[1]);
-        raw_data[2] = (uint8_t *)(ctx->packed[2]);
+        ctx->data[0] = (uint8_t *)(ctx->packed[0]);
+        ctx->data[1] = (uint8_t *)(ctx->packed[1]);
+        ctx->data[2] = (uint8_t *)(ctx->packed[2]);
     }
 
-    const uint8_t *const data[3] = { raw_data[0], raw_data[1], raw_data[2] };
+    ctx->scores = (index_and_score_t *)malloc(
+        ctx->num_blocks_w * ctx->num_blocks_h * sizeof(*ctx->scores));
+    if (ctx->flat_blocks == NULL || ctx->scores == NULL ||
+        !wiener_result_alloc((const uint8_t *const *)ctx->data, ctx->result,
+            sd->width, sd->height, chroma_sub_log2, ctx->block_size)) {
+        fprintf(stderr, "Unable to allocate the denoising buffers\n");
+        return 0;
+    }
+
+    ctx->prepared = 1;
+    return 1;
+}
+
+int32_t aom_denoise_and_model_run_rows(struct aom_denoise_and_model_t *ctx,
+    EbPictureBufferDesc_t *sd,
+    int32_t row_start,
+    int32_t row_end,
+    int32_t use_highbd) {
+
+    const int32_t block_size = ctx->block_size;
+    int32_t chroma_sub_log2[2] = { 1, 1 };  //todo: send chroma subsampling
+    int32_t strides[3] = { sd->stride_y, sd->strideCb, sd->strideCr };
+    const uint8_t *const data[3] = { ctx->data[0], ctx->data[1], ctx->data[2] };
+
+    if (!ctx->prepared)
+        return 0;
 
-    aom_flat_block_finder_run(&ctx->flat_block_finder, data[0], sd->width,
-        sd->height, strides[0], ctx->flat_blocks);
+    // The flat blocks starting in the rows
+    if (!flat_block_finder_score_rows(&ctx->flat_block_finder, data[0], sd->width,
+        sd->height, strides[0], (row_start + block_size - 1) / block_size,
+        (row_end + block_size - 1) / block_size, ctx->flat_blocks, ctx->scores)) {
+        ctx->prepared = 0;
+        return 0;
+    }
 
-    if (!aom_wiener_denoise_2d(data, ctx->denoised, sd->width, sd->height,
+    if (!wiener_denoise_2d_rows(data, ctx->result, sd->width, sd->height,
         strides, chroma_sub_log2, ctx->noise_psd,
-        block_size, ctx->bit_depth, use_highbd)) {
+        block_size, ctx->bit_depth, use_highbd, row_start, row_end)) {
         fprintf(stderr, "Unable to denoise image\n");
+        ctx->prepared = 0;
         return 0;
     }
+    return 1;
+}
 
-    const aom_noise_status_t status = aom_noise_model_update(
-        &ctx->noise_model, data, (const uint8_t *const *)ctx->denoised,
-        sd->width, sd->height, strides, chroma_sub_log2, ctx->flat_blocks,
-        block_size);
+int32_t aom_denoise_and_model_finish(struct aom_denoise_and_model_t *ctx,
+    EbPictureBufferDesc_t *sd,
+    aom_film_grain_t *film_grain,
+    int32_t use_highbd,
+    EbAsm asm_type) {
 
-    int32_t have_noise_estimate = 0;
-    if (status == AOM_NOISE_STATUS_OK || status == AOM_NOISE_STATUS_DIFFERENT_NOISE_TYPE) {
-        aom_noise_model_save_latest(&ctx->noise_model);
-        have_noise_estimate = 1;
-    }
+    const int32_t block_size = ctx->block_size;
+    uint8_t *raw_data[3] = { (uint8_t *)ctx->data[0], (uint8_t *)ctx->data[1], (uint8_t *)ctx->data[2] };
+    int32_t chroma_sub_log2[2] = { 1, 1 };  //todo: send chroma subsampling
+    int32_t strides[3] = { sd->stride_y, sd->strideCb, sd->strideCr };
+    const uint8_t *const data[3] = { raw_data[0], raw_data[1], raw_data[2] };
+    int32_t ret = ctx->prepared;
 
     film_grain->apply_grain = 0;
-    if (have_noise_estimate) {
-        if (!aom_noise_model_get_grain_parameters(&ctx->noise_model, film_grain)) {
-            fprintf(stderr, "Unable to get grain parameters.\n");
-            return 0;
-        }
-        film_grain->apply_grain = 1;
-
-        if (!use_highbd) {
-            memcpy(raw_data[0], ctx->denoised[0],
-                (strides[0] * sd->height) << use_highbd);
-            memcpy(raw_data[1], ctx->denoised[1],
-                (strides[1] * (sd->height >> chroma_sub_log2[0])) << use_highbd);
-            memcpy(raw_data[2], ctx->denoised[2],
-                (strides[2] * (sd->height >> chroma_sub_log2[0])) << use_highbd);
+    if (ctx->prepared) {
+        flat_block_finder_select(ctx->num_blocks_w * ctx->num_blocks_h,
+            ctx->flat_blocks, ctx->scores);
+
+        wiener_denoise_2d_quantize(ctx->result, ctx->denoised, sd->width,
+            sd->height, strides, chroma_sub_log2, block_size, ctx->bit_depth,
+            use_highbd);
+
+        const aom_noise_status_t status = aom_noise_model_update(
+            &ctx->noise_model, data, (const uint8_t *const *)ctx->denoised,
+            sd->width, sd->height, strides, chroma_sub_log2, ctx->flat_blocks,
+            block_size);
+
+        int32_t have_noise_estimate = 0;
+        if (status == AOM_NOISE_STATUS_OK || status == AOM_NOISE_STATUS_DIFFERENT_NOISE_TYPE) {
+            aom_noise_model_save_latest(&ctx->noise_model);
+            have_noise_estimate = 1;
         }
-        else {
-            unpack_2d_pic(ctx->denoised, sd, asm_type);
+
+        if (have_noise_estimate) {
+            if (!aom_noise_model_get_grain_parameters(&ctx->noise_model, film_grain)) {
+                fprintf(stderr, "Unable to get grain parameters.\n");
+                ret = 0;
+            }
+            else {
+                film_grain->apply_grain = 1;
+
+                if (!use_highbd) {
+                    memcpy(raw_data[0], ctx->denoised[0],
+                        (strides[0] * sd->height) << use_highbd);
+                    memcpy(raw_data[1], ctx->denoised[1],
+                        (strides[1] * (sd->height >> chroma_sub_log2[0])) << use_highbd);
+                    memcpy(raw_data[2], ctx->denoised[2],
+                        (strides[2] * (sd->height >> chroma_sub_log2[0])) << use_highbd);
+                }
+                else {
+                    unpack_2d_pic(ctx->denoised, sd, asm_type);
+                }
+            }
         }
     }
+    wiener_result_free(ctx->result);
+    free(ctx->scores);
+    ctx->scores = NULL;
+    ctx->prepared = 0;
     aom_flat_block_finder_free(&ctx->flat_block_finder);
     aom_noise_model_free(&ctx->noise_model);
     free(ctx->flat_blocks);
+    ctx->flat_blocks = NULL;
 
-    return 1;
+    return ret;
+}
+
+int32_t aom_denoise_and_model_run(struct aom_denoise_and_model_t *ctx,
+    EbPictureBufferDesc_t *sd,
+    aom_film_grain_t *film_grain,
+    int32_t use_highbd,
+    EbAsm asm_type) {
+
+    if (aom_denoise_and_model_prepare(ctx, sd, use_highbd, asm_type))
+        aom_denoise_and_model_run_rows(ctx, sd, 0, sd->height, use_highbd);
+    return aom_denoise_and_model_finish(ctx, sd, film_grain, use_highbd, asm_type);
 }
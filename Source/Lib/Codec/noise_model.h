@@ -325,6 +325,34 @@ extern "C" {
         int32_t use_highbd,
         EbAsm asm_type);
 
+    /*!\brief aom_denoise_and_model_run() split in segments of rows.
+     *
+     * aom_denoise_and_model_prepare() runs first, then
+     * aom_denoise_and_model_run_rows() for each segment of rows of the buffer
+     * (concurrently), then aom_denoise_and_model_finish() once all the rows
+     * are done. The grain and denoised buffer are the ones of
+     * aom_denoise_and_model_run(), whatever the segments.
+     *
+     * \param[in]  row_start   First luma row of the segment
+     * \param[in]  row_end     Luma row after the segment
+     */
+    int32_t aom_denoise_and_model_prepare(struct aom_denoise_and_model_t *ctx,
+        EbPictureBufferDesc_t *sd,
+        int32_t use_highbd,
+        EbAsm asm_type);
+
+    int32_t aom_denoise_and_model_run_rows(struct aom_denoise_and_model_t *ctx,
+        EbPictureBufferDesc_t *sd,
+        int32_t row_start,
+        int32_t row_end,
+        int32_t use_highbd);
+
+    int32_t aom_denoise_and_model_finish(struct aom_denoise_and_model_t *ctx,
+        EbPictureBufferDesc_t *sd,
+        aom_film_grain_t *film_grain,
+        int32_t use_highbd,
+        EbAsm asm_type);
+
     /*!\brief Allocates a context that can be used for denoising and noise modeling.
      *
      * \param[in]  bit_depth   Bit depth of buffers this will be run on.
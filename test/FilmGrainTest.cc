@@ -14,9 +14,18 @@
 * PATENTS file, you can obtain it at www.aomedia.org/license/patent.
 */
 
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
 #include "gtest/gtest.h"
 #include "EbDefinitions.h"
 #include "grainSynthesis.h"
+#include "aom_dsp_rtcd.h"
+
+extern "C" {
+    EbAsm GetCpuAsmType();
+}
 
 static aom_film_grain_t film_grain_test_vectors[3] = {
   /* Test 1 */
@@ -184,4 +193,68 @@ TEST(FilmGrain, parameters_equality)
 
 }
 
+// Applies the grain of params to a random frame (with some samples at the
+// extremes) with the rtcd flags given, returning the 3 planes back to back.
+static std::vector<uint16_t> add_film_grain_frame(aom_film_grain_t params,
+    int32_t use_high_bit_depth, int32_t chroma_subsamp, int32_t flags) {
+    const int32_t width = 226;
+    const int32_t height = 138;
+    const int32_t luma_stride = width + 6;
+    const int32_t chroma_stride = (width >> chroma_subsamp) + 6;
+    const int32_t luma_size = luma_stride * height;
+    const int32_t chroma_size = chroma_stride * (height >> chroma_subsamp);
+    const int32_t max_value = (1 << params.bit_depth) - 1;
+    std::vector<uint16_t> frame(luma_size + 2 * chroma_size);
+    std::vector<uint8_t> frame8(frame.size());
+
+    srand(params.random_seed);
+    for (size_t i = 0; i < frame.size(); ++i) {
+        frame[i] = (uint16_t)(i % 53 == 0 ? (rand() & 1) * max_value : rand() % (max_value + 1));
+        frame8[i] = (uint8_t)frame[i];
+    }
+
+    setup_rtcd_flags(flags);
+    if (use_high_bit_depth) {
+        av1_add_film_grain_run(&params, (uint8_t *)frame.data(),
+            (uint8_t *)(frame.data() + luma_size), (uint8_t *)(frame.data() + luma_size + chroma_size),
+            height, width, luma_stride, chroma_stride, 1, chroma_subsamp, chroma_subsamp);
+    }
+    else {
+        av1_add_film_grain_run(&params, frame8.data(), frame8.data() + luma_size,
+            frame8.data() + luma_size + chroma_size, height, width, luma_stride,
+            chroma_stride, 0, chroma_subsamp, chroma_subsamp);
+        frame.assign(frame8.begin(), frame8.end());
+    }
+    return frame;
+}
+
+TEST(FilmGrain, add_film_grain_simd)
+{
+    const int32_t base_flags = HAS_MMX | HAS_SSE | HAS_SSE2 | HAS_SSE3 | HAS_SSSE3 |
+        HAS_SSE4_1 | HAS_SSE4_2 | HAS_AVX;
+
+    if (GetCpuAsmType() < ASM_AVX2)
+        return;
+
+    for (int vector = 0; vector < 3; ++vector) {
+        for (int variant = 0; variant < 16; ++variant) {
+            aom_film_grain_t params = film_grain_test_vectors[vector];
+            const int32_t use_high_bit_depth = variant & 1;
+            const int32_t chroma_subsamp = (variant >> 1) & 1;
+
+            params.bit_depth = use_high_bit_depth ? 10 : 8;
+            params.chroma_scaling_from_luma = (variant >> 2) & 1;
+            params.overlap_flag ^= (variant >> 3) & 1;
+            params.random_seed += (uint16_t)variant;
+
+            const std::vector<uint16_t> ref = add_film_grain_frame(params,
+                use_high_bit_depth, chroma_subsamp, 0);
+            const std::vector<uint16_t> tst = add_film_grain_frame(params,
+                use_high_bit_depth, chroma_subsamp, base_flags | HAS_AVX2);
+            EXPECT_TRUE(ref == tst) << "test vector " << vector << " variant " << variant;
+        }
+    }
+    setup_rtcd_flags(base_flags | HAS_AVX2 | (GetCpuAsmType() == ASM_AVX512 ? HAS_AVX512 : 0));
+}
+
 
@@ -0,0 +1,241 @@
+/*
+* Copyright(c) 2019 Intel Corporation
+* SPDX - License - Identifier: BSD - 2 - Clause - Patent
+*/
+
+// Encodes the same pictures with and without low_latency_tile_output and
+// parses both streams down to the tiles: the streamed tile groups must
+// come one per tile in decode order, each picture's first one after its
+// frame header, and carry the tile data of the regular stream. A picture
+// coded ahead of one before it in decode order has no partial packets.
+
+#include <stdlib.h>
+#include <string.h>
+#include <condition_variable>
+#include <mutex>
+#include <vector>
+
+#include "EbApi.h"
+#include "gtest/gtest.h"
+
+#define TILE_OUTPUT_WIDTH           256
+#define TILE_OUTPUT_HEIGHT          256
+#define TILE_OUTPUT_FRAME_COUNT     6
+#define TILE_OUTPUT_LOG2_COLS       1
+#define TILE_OUTPUT_LOG2_ROWS       1
+#define TILE_OUTPUT_TILE_COUNT      (1 << (TILE_OUTPUT_LOG2_COLS + TILE_OUTPUT_LOG2_ROWS))
+
+#define OBU_SEQUENCE_HEADER         1
+#define OBU_TEMPORAL_DELIMITER      2
+#define OBU_FRAME_HEADER            3
+#define OBU_TILE_GROUP              4
+#define OBU_FRAME                   6
+
+struct OutputStream {
+    std::mutex              mutex;
+    std::condition_variable done_condition;
+    std::vector<uint8_t>    bytes;
+    uint32_t                partial_count = 0;
+    bool                    done = false;
+};
+
+struct Obu {
+    uint8_t              type;
+    std::vector<uint8_t> payload;
+};
+
+static void OutputPacket(
+    void               *output_context,
+    EbBufferHeaderType *p_buffer)
+{
+    OutputStream *stream = (OutputStream*)output_context;
+    std::lock_guard<std::mutex> lock(stream->mutex);
+
+    stream->bytes.insert(stream->bytes.end(), p_buffer->p_buffer, p_buffer->p_buffer + p_buffer->n_filled_len);
+    if (p_buffer->flags & EB_BUFFERFLAG_PARTIAL)
+        ++stream->partial_count;
+    if (p_buffer->flags & EB_BUFFERFLAG_EOS) {
+        stream->done = true;
+        stream->done_condition.notify_all();
+    }
+    eb_svt_release_out_buffer(&p_buffer);
+}
+
+static void EncodeStream(
+    bool          tile_output,
+    OutputStream *stream)
+{
+    EbComponentType          *handle;
+    EbSvtAv1EncConfiguration  config;
+    EbBufferHeaderType        header;
+    EbSvtEncInput             input;
+    std::vector<uint8_t>      luma(TILE_OUTPUT_WIDTH * TILE_OUTPUT_HEIGHT);
+    std::vector<uint8_t>      chroma(TILE_OUTPUT_WIDTH * TILE_OUTPUT_HEIGHT / 4);
+
+    ASSERT_EQ(EB_ErrorNone, eb_init_handle(&handle, NULL, &config));
+    config.source_width = TILE_OUTPUT_WIDTH;
+    config.source_height = TILE_OUTPUT_HEIGHT;
+    config.super_block_size = 64;
+    config.tile_columns = TILE_OUTPUT_LOG2_COLS;
+    config.tile_rows = TILE_OUTPUT_LOG2_ROWS;
+    config.low_latency_tile_output = tile_output ? 1 : 0;
+    config.output_packet_callback = OutputPacket;
+    config.output_callback_context = stream;
+    ASSERT_EQ(EB_ErrorNone, eb_svt_enc_set_parameter(handle, &config));
+    ASSERT_EQ(EB_ErrorNone, eb_init_encoder(handle));
+
+    memset(&input, 0, sizeof(input));
+    input.luma = luma.data();
+    input.cb = chroma.data();
+    input.cr = chroma.data();
+    input.yStride = TILE_OUTPUT_WIDTH;
+    input.cbStride = TILE_OUTPUT_WIDTH / 2;
+    input.crStride = TILE_OUTPUT_WIDTH / 2;
+
+    // Moving gradients with some noise, the same for both streams
+    srand(0);
+    for (uint32_t frame = 0; frame < TILE_OUTPUT_FRAME_COUNT; ++frame) {
+        for (uint32_t y = 0; y < TILE_OUTPUT_HEIGHT; ++y)
+            for (uint32_t x = 0; x < TILE_OUTPUT_WIDTH; ++x)
+                luma[y * TILE_OUTPUT_WIDTH + x] = (uint8_t)(x + 2 * y + 3 * frame + (rand() & 7));
+        for (uint32_t i = 0; i < chroma.size(); ++i)
+            chroma[i] = (uint8_t)(128 + (i & 15) + frame);
+
+        memset(&header, 0, sizeof(header));
+        header.size = sizeof(header);
+        header.p_buffer = (uint8_t*)&input;
+        header.n_filled_len = TILE_OUTPUT_WIDTH * TILE_OUTPUT_HEIGHT * 3 / 2;
+        header.pts = frame;
+        header.pic_type = EB_INVALID_PICTURE;
+        ASSERT_EQ(EB_ErrorNone, eb_svt_enc_send_picture(handle, &header));
+    }
+
+    memset(&header, 0, sizeof(header));
+    header.flags = EB_BUFFERFLAG_EOS;
+    header.pic_type = EB_INVALID_PICTURE;
+    ASSERT_EQ(EB_ErrorNone, eb_svt_enc_send_picture(handle, &header));
+
+    {
+        std::unique_lock<std::mutex> lock(stream->mutex);
+        stream->done_condition.wait(lock, [stream] { return stream->done; });
+    }
+
+    EXPECT_EQ(EB_ErrorNone, eb_deinit_encoder(handle));
+    EXPECT_EQ(EB_ErrorNone, eb_deinit_handle(handle));
+}
+
+static std::vector<Obu> ParseObus(
+    const std::vector<uint8_t> &bytes)
+{
+    std::vector<Obu> obus;
+    size_t offset = 0;
+
+    while (offset < bytes.size()) {
+        Obu obu;
+        uint64_t size = 0;
+        const uint8_t obu_header = bytes[offset++];
+
+        obu.type = (obu_header >> 3) & 15;
+        EXPECT_EQ(0, obu_header & 0x80) << "forbidden bit at " << offset - 1;
+        EXPECT_NE(0, obu_header & 2) << "OBU without size at " << offset - 1;
+        if (obu_header & 4)
+            ++offset;
+        for (uint32_t shift = 0; offset < bytes.size(); shift += 7) {
+            const uint8_t byte = bytes[offset++];
+            size |= (uint64_t)(byte & 0x7f) << shift;
+            if (!(byte & 0x80))
+                break;
+        }
+        if (offset + size > bytes.size()) {
+            ADD_FAILURE() << "OBU of " << size << " bytes past the end of the stream";
+            break;
+        }
+        obu.payload.assign(bytes.begin() + offset, bytes.begin() + offset + size);
+        offset += size;
+        obus.push_back(obu);
+    }
+
+    return obus;
+}
+
+TEST(TileOutput, streamed_tile_groups_decode)
+{
+    OutputStream regular;
+    OutputStream streamed;
+    std::vector<Obu> regular_obus;
+    std::vector<Obu> streamed_obus;
+    const uint32_t tile_bits = TILE_OUTPUT_LOG2_COLS + TILE_OUTPUT_LOG2_ROWS;
+    uint32_t frame_count = 0;
+    size_t index = 0;
+
+    EncodeStream(false, &regular);
+    EncodeStream(true, &streamed);
+    regular_obus = ParseObus(regular.bytes);
+    streamed_obus = ParseObus(streamed.bytes);
+
+    for (size_t regular_index = 0; regular_index < regular_obus.size(); ++regular_index) {
+        const Obu &obu = regular_obus[regular_index];
+        std::vector<uint8_t> frame_tiles;
+
+        ASSERT_LT(index, streamed_obus.size());
+        if (obu.type != OBU_FRAME) {
+            // Temporal delimiters, sequence headers, shown existing frames
+            EXPECT_EQ(obu.type, streamed_obus[index].type) << "OBU " << regular_index;
+            EXPECT_EQ(obu.payload, streamed_obus[index].payload) << "OBU " << regular_index;
+            ++index;
+            continue;
+        }
+
+        // The frame header, then one tile group per tile in order
+        ASSERT_EQ(OBU_FRAME_HEADER, streamed_obus[index++].type) << "OBU " << regular_index;
+        frame_tiles = obu.payload;
+        for (uint32_t tile_idx = 0; tile_idx < TILE_OUTPUT_TILE_COUNT; ++tile_idx) {
+            ASSERT_LT(index, streamed_obus.size());
+            const Obu &tile_group = streamed_obus[index++];
+            const uint32_t tg_start = (tile_group.payload[0] >> (7 - tile_bits)) & ((1 << tile_bits) - 1);
+            const uint32_t tg_end = (tile_group.payload[0] >> (7 - 2 * tile_bits)) & ((1 << tile_bits) - 1);
+
+            ASSERT_EQ(OBU_TILE_GROUP, tile_group.type);
+            ASSERT_GT(tile_group.payload.size(), 1u);
+            EXPECT_NE(0, tile_group.payload[0] & 0x80) << "tile_start_and_end_present_flag";
+            EXPECT_EQ(tile_idx, tg_start);
+            EXPECT_EQ(tile_idx, tg_end);
+        }
+
+        // The tiles of the regular frame OBU, from the last one: every
+        //   tile but the last follows its size field
+        for (uint32_t tile_idx = TILE_OUTPUT_TILE_COUNT; tile_idx-- > 0;) {
+            const Obu &tile_group = streamed_obus[index - TILE_OUTPUT_TILE_COUNT + tile_idx];
+            const std::vector<uint8_t> tile(tile_group.payload.begin() + 1, tile_group.payload.end());
+
+            ASSERT_GE(frame_tiles.size(), tile.size());
+            ASSERT_TRUE(std::equal(tile.begin(), tile.end(), frame_tiles.end() - tile.size()))
+                << "frame " << frame_count << " tile " << tile_idx;
+            frame_tiles.resize(frame_tiles.size() - tile.size());
+            if (tile_idx + 1 < TILE_OUTPUT_TILE_COUNT) {
+                uint32_t tile_size_bytes;
+                bool size_found = false;
+
+                for (tile_size_bytes = 1; tile_size_bytes <= 4 && !size_found; ++tile_size_bytes) {
+                    uint64_t tile_size_minus_1 = 0;
+
+                    if (frame_tiles.size() < tile_size_bytes)
+                        break;
+                    for (uint32_t byte = 0; byte < tile_size_bytes; ++byte)
+                        tile_size_minus_1 |= (uint64_t)frame_tiles[frame_tiles.size() - tile_size_bytes + byte] << (8 * byte);
+                    size_found = tile_size_minus_1 + 1 == tile.size();
+                }
+                ASSERT_TRUE(size_found) << "frame " << frame_count << " tile " << tile_idx;
+                frame_tiles.resize(frame_tiles.size() - (tile_size_bytes - 1));
+            }
+        }
+        ++frame_count;
+    }
+
+    EXPECT_EQ(streamed_obus.size(), index);
+    EXPECT_GT(frame_count, 0u);
+    EXPECT_GT(streamed.partial_count, 0u);
+    EXPECT_LE(streamed.partial_count, frame_count * (TILE_OUTPUT_TILE_COUNT - 1));
+    EXPECT_EQ(0u, streamed.partial_count % (TILE_OUTPUT_TILE_COUNT - 1));
+    EXPECT_EQ(0u, regular.partial_count);
+}
@@ -0,0 +1,230 @@
+/*
+* Copyright(c) 2019 Intel Corporation
+* SPDX - License - Identifier: BSD - 2 - Clause - Patent
+*/
+
+/*
+* Copyright (c) 2016, Alliance for Open Media. All rights reserved
+*
+* This source code is subject to the terms of the BSD 2 Clause License and
+* the Alliance for Open Media Patent License 1.0. If the BSD 2 Clause License
+* was not distributed with this source code in the LICENSE file, you can
+* obtain it at www.aomedia.org/license/software. If the Alliance for Open
+* Media Patent License 1.0 was not distributed with this source code in the
+* PATENTS file, you can obtain it at www.aomedia.org/license/patent.
+*/
+
+// Checks the SIMD warp kernels against the C reference bit for bit, on
+// random warp models including blocks whose filter taps cross the frame
+// edges, for every prediction mode (single, compound, averaged compound,
+// distance weighted compound).
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "gtest/gtest.h"
+#include "EbDefinitions.h"
+
+extern "C" {
+    EbAsm GetCpuAsmType();
+
+    typedef void(*WarpAffineFunc)(const int32_t *mat, const uint8_t *ref,
+        int width, int height, int stride, uint8_t *pred, int p_col, int p_row,
+        int p_width, int p_height, int p_stride, int subsampling_x,
+        int subsampling_y, ConvolveParams *conv_params, int16_t alpha,
+        int16_t beta, int16_t gamma, int16_t delta);
+    typedef void(*HighbdWarpAffineFunc)(const int32_t *mat,
+        const uint16_t *ref, int width, int height, int stride,
+        uint16_t *pred, int p_col, int p_row, int p_width, int p_height,
+        int p_stride, int subsampling_x, int subsampling_y, int bd,
+        ConvolveParams *conv_params, int16_t alpha, int16_t beta,
+        int16_t gamma, int16_t delta);
+
+    void av1_warp_affine_c(const int32_t *mat, const uint8_t *ref, int width, int height, int stride, uint8_t *pred, int p_col, int p_row, int p_width, int p_height, int p_stride, int subsampling_x, int subsampling_y, ConvolveParams *conv_params, int16_t alpha, int16_t beta, int16_t gamma, int16_t delta);
+    void av1_warp_affine_sse4_1(const int32_t *mat, const uint8_t *ref, int width, int height, int stride, uint8_t *pred, int p_col, int p_row, int p_width, int p_height, int p_stride, int subsampling_x, int subsampling_y, ConvolveParams *conv_params, int16_t alpha, int16_t beta, int16_t gamma, int16_t delta);
+    void av1_warp_affine_avx2(const int32_t *mat, const uint8_t *ref, int width, int height, int stride, uint8_t *pred, int p_col, int p_row, int p_width, int p_height, int p_stride, int subsampling_x, int subsampling_y, ConvolveParams *conv_params, int16_t alpha, int16_t beta, int16_t gamma, int16_t delta);
+    void av1_highbd_warp_affine_c(const int32_t *mat, const uint16_t *ref, int width, int height, int stride, uint16_t *pred, int p_col, int p_row, int p_width, int p_height, int p_stride, int subsampling_x, int subsampling_y, int bd, ConvolveParams *conv_params, int16_t alpha, int16_t beta, int16_t gamma, int16_t delta);
+    void av1_highbd_warp_affine_sse4_1(const int32_t *mat, const uint16_t *ref, int width, int height, int stride, uint16_t *pred, int p_col, int p_row, int p_width, int p_height, int p_stride, int subsampling_x, int subsampling_y, int bd, ConvolveParams *conv_params, int16_t alpha, int16_t beta, int16_t gamma, int16_t delta);
+    void av1_highbd_warp_affine_avx2(const int32_t *mat, const uint16_t *ref, int width, int height, int stride, uint16_t *pred, int p_col, int p_row, int p_width, int p_height, int p_stride, int subsampling_x, int subsampling_y, int bd, ConvolveParams *conv_params, int16_t alpha, int16_t beta, int16_t gamma, int16_t delta);
+}
+
+#define WARP_TEST_ITERATIONS    400
+#define WARP_TEST_FRAME_WIDTH   48
+#define WARP_TEST_FRAME_HEIGHT  48
+#define WARP_TEST_BORDER        16
+#define WARP_TEST_STRIDE        (WARP_TEST_FRAME_WIDTH + 2 * WARP_TEST_BORDER)
+#define WARP_TEST_MAX_BLOCK     32
+
+static const int warp_test_block_sizes[][2] = {
+    { 4, 4 }, { 4, 8 }, { 8, 4 }, { 8, 8 }, { 8, 16 }, { 16, 8 },
+    { 16, 16 }, { 16, 32 }, { 32, 16 }, { 32, 32 }
+};
+
+static int warp_test_rand(int range) {
+    return rand() % range;
+}
+
+// Random model meeting the shear constraints of the warp filter:
+// 4 * |alpha| + 7 * |beta| < 1 and 4 * |gamma| + 4 * |delta| < 1
+static void warp_test_model(int32_t *mat, int16_t *alpha, int16_t *beta,
+    int16_t *gamma, int16_t *delta) {
+    *alpha = (int16_t)((warp_test_rand(4096) - 2048) & ~63);
+    *beta = (int16_t)((warp_test_rand(4096) - 2048) & ~63);
+    *gamma = (int16_t)((warp_test_rand(4096) - 2048) & ~63);
+    *delta = (int16_t)((warp_test_rand(4096) - 2048) & ~63);
+
+    // Translation reaching past every frame edge
+    mat[0] = (warp_test_rand(64) - 32) * (1 << 16) + warp_test_rand(1 << 16);
+    mat[1] = (warp_test_rand(64) - 32) * (1 << 16) + warp_test_rand(1 << 16);
+    mat[2] = (1 << 16) + warp_test_rand(8192) - 4096;
+    mat[3] = warp_test_rand(8192) - 4096;
+    mat[4] = warp_test_rand(8192) - 4096;
+    mat[5] = (1 << 16) + warp_test_rand(8192) - 4096;
+}
+
+static void warp_test_conv_params(ConvolveParams *conv_params, int bd,
+    int mode, CONV_BUF_TYPE *dst) {
+    static const int dist_offsets[4][2] = { { 9, 7 }, { 11, 5 }, { 12, 4 }, { 13, 3 } };
+    const int is_compound = mode > 0;
+    const int dist = warp_test_rand(4);
+
+    memset(conv_params, 0, sizeof(*conv_params));
+    conv_params->round_0 = 3;
+    conv_params->round_1 = is_compound ? 7 : 2 * 7 - conv_params->round_0;
+    const int intbufrange = bd + 7 - conv_params->round_0 + 2;
+    if (intbufrange > 16) {
+        conv_params->round_0 += intbufrange - 16;
+        if (!is_compound) conv_params->round_1 -= intbufrange - 16;
+    }
+    conv_params->is_compound = is_compound;
+    conv_params->do_average = mode >= 2;
+    conv_params->use_jnt_comp_avg = mode == 3;
+    conv_params->fwd_offset = dist_offsets[dist][0];
+    conv_params->bck_offset = dist_offsets[dist][1];
+    conv_params->dst = dst;
+    conv_params->dst_stride = WARP_TEST_MAX_BLOCK;
+}
+
+static void warp_test_lowbd(WarpAffineFunc func) {
+    uint8_t *ref_buffer = (uint8_t*)malloc(WARP_TEST_STRIDE * (WARP_TEST_FRAME_HEIGHT + 2 * WARP_TEST_BORDER));
+    uint8_t *ref = ref_buffer + WARP_TEST_BORDER * WARP_TEST_STRIDE + WARP_TEST_BORDER;
+    uint8_t pred_ref[WARP_TEST_MAX_BLOCK * WARP_TEST_MAX_BLOCK];
+    uint8_t pred_tst[WARP_TEST_MAX_BLOCK * WARP_TEST_MAX_BLOCK];
+    CONV_BUF_TYPE dst_ref[WARP_TEST_MAX_BLOCK * WARP_TEST_MAX_BLOCK];
+    CONV_BUF_TYPE dst_tst[WARP_TEST_MAX_BLOCK * WARP_TEST_MAX_BLOCK];
+    ConvolveParams params_ref, params_tst;
+    int32_t mat[8];
+    int16_t alpha, beta, gamma, delta;
+
+    srand(0);
+    for (int iteration = 0; iteration < WARP_TEST_ITERATIONS; ++iteration) {
+        const int *block = warp_test_block_sizes[iteration % (sizeof(warp_test_block_sizes) / sizeof(warp_test_block_sizes[0]))];
+        const int mode = warp_test_rand(4);
+        const int subsampling = warp_test_rand(2);
+        const int p_col = warp_test_rand(WARP_TEST_FRAME_WIDTH - block[0] + 1);
+        const int p_row = warp_test_rand(WARP_TEST_FRAME_HEIGHT - block[1] + 1);
+
+        for (int i = 0; i < WARP_TEST_STRIDE * (WARP_TEST_FRAME_HEIGHT + 2 * WARP_TEST_BORDER); ++i)
+            ref_buffer[i] = (uint8_t)warp_test_rand(256);
+        for (int i = 0; i < WARP_TEST_MAX_BLOCK * WARP_TEST_MAX_BLOCK; ++i) {
+            pred_ref[i] = pred_tst[i] = (uint8_t)warp_test_rand(256);
+            dst_ref[i] = dst_tst[i] = (CONV_BUF_TYPE)warp_test_rand(1 << 14);
+        }
+
+        warp_test_model(mat, &alpha, &beta, &gamma, &delta);
+        warp_test_conv_params(&params_ref, 8, mode, dst_ref);
+        params_tst = params_ref;
+        params_tst.dst = dst_tst;
+
+        av1_warp_affine_c(mat, ref, WARP_TEST_FRAME_WIDTH, WARP_TEST_FRAME_HEIGHT, WARP_TEST_STRIDE,
+            pred_ref, p_col, p_row, block[0], block[1], WARP_TEST_MAX_BLOCK, subsampling, subsampling,
+            &params_ref, alpha, beta, gamma, delta);
+        func(mat, ref, WARP_TEST_FRAME_WIDTH, WARP_TEST_FRAME_HEIGHT, WARP_TEST_STRIDE,
+            pred_tst, p_col, p_row, block[0], block[1], WARP_TEST_MAX_BLOCK, subsampling, subsampling,
+            &params_tst, alpha, beta, gamma, delta);
+
+        ASSERT_EQ(0, memcmp(pred_ref, pred_tst, sizeof(pred_ref)))
+            << "prediction mismatch, iteration " << iteration << " mode " << mode
+            << " block " << block[0] << "x" << block[1];
+        ASSERT_EQ(0, memcmp(dst_ref, dst_tst, sizeof(dst_ref)))
+            << "compound buffer mismatch, iteration " << iteration << " mode " << mode
+            << " block " << block[0] << "x" << block[1];
+    }
+
+    free(ref_buffer);
+}
+
+static void warp_test_highbd(HighbdWarpAffineFunc func, int bd) {
+    uint16_t *ref_buffer = (uint16_t*)malloc(sizeof(uint16_t) * WARP_TEST_STRIDE * (WARP_TEST_FRAME_HEIGHT + 2 * WARP_TEST_BORDER));
+    uint16_t *ref = ref_buffer + WARP_TEST_BORDER * WARP_TEST_STRIDE + WARP_TEST_BORDER;
+    uint16_t pred_ref[WARP_TEST_MAX_BLOCK * WARP_TEST_MAX_BLOCK];
+    uint16_t pred_tst[WARP_TEST_MAX_BLOCK * WARP_TEST_MAX_BLOCK];
+    CONV_BUF_TYPE dst_ref[WARP_TEST_MAX_BLOCK * WARP_TEST_MAX_BLOCK];
+    CONV_BUF_TYPE dst_tst[WARP_TEST_MAX_BLOCK * WARP_TEST_MAX_BLOCK];
+    ConvolveParams params_ref, params_tst;
+    int32_t mat[8];
+    int16_t alpha, beta, gamma, delta;
+
+    srand(bd);
+    for (int iteration = 0; iteration < WARP_TEST_ITERATIONS; ++iteration) {
+        const int *block = warp_test_block_sizes[iteration % (sizeof(warp_test_block_sizes) / sizeof(warp_test_block_sizes[0]))];
+        const int mode = warp_test_rand(4);
+        const int subsampling = warp_test_rand(2);
+        const int p_col = warp_test_rand(WARP_TEST_FRAME_WIDTH - block[0] + 1);
+        const int p_row = warp_test_rand(WARP_TEST_FRAME_HEIGHT - block[1] + 1);
+
+        for (int i = 0; i < WARP_TEST_STRIDE * (WARP_TEST_FRAME_HEIGHT + 2 * WARP_TEST_BORDER); ++i)
+            ref_buffer[i] = (uint16_t)warp_test_rand(1 << bd);
+        for (int i = 0; i < WARP_TEST_MAX_BLOCK * WARP_TEST_MAX_BLOCK; ++i) {
+            pred_ref[i] = pred_tst[i] = (uint16_t)warp_test_rand(1 << bd);
+            dst_ref[i] = dst_tst[i] = (CONV_BUF_TYPE)warp_test_rand(1 << 16);
+        }
+
+        warp_test_model(mat, &alpha, &beta, &gamma, &delta);
+        warp_test_conv_params(&params_ref, bd, mode, dst_ref);
+        params_tst = params_ref;
+        params_tst.dst = dst_tst;
+
+        av1_highbd_warp_affine_c(mat, ref, WARP_TEST_FRAME_WIDTH, WARP_TEST_FRAME_HEIGHT, WARP_TEST_STRIDE,
+            pred_ref, p_col, p_row, block[0], block[1], WARP_TEST_MAX_BLOCK, subsampling, subsampling, bd,
+            &params_ref, alpha, beta, gamma, delta);
+        func(mat, ref, WARP_TEST_FRAME_WIDTH, WARP_TEST_FRAME_HEIGHT, WARP_TEST_STRIDE,
+            pred_tst, p_col, p_row, block[0], block[1], WARP_TEST_MAX_BLOCK, subsampling, subsampling, bd,
+            &params_tst, alpha, beta, gamma, delta);
+
+        ASSERT_EQ(0, memcmp(pred_ref, pred_tst, sizeof(pred_ref)))
+            << "prediction mismatch, bd " << bd << " iteration " << iteration << " mode " << mode
+            << " block " << block[0] << "x" << block[1];
+        ASSERT_EQ(0, memcmp(dst_ref, dst_tst, sizeof(dst_ref)))
+            << "compound buffer mismatch, bd " << bd << " iteration " << iteration << " mode " << mode
+            << " block " << block[0] << "x" << block[1];
+    }
+
+    free(ref_buffer);
+}
+
+TEST(WarpAffine, sse4_1_matches_c)
+{
+    warp_test_lowbd(av1_warp_affine_sse4_1);
+}
+
+TEST(WarpAffine, avx2_matches_c)
+{
+    if (GetCpuAsmType() < ASM_AVX2)
+        return;
+    warp_test_lowbd(av1_warp_affine_avx2);
+}
+
+TEST(WarpAffine, highbd_sse4_1_matches_c)
+{
+    warp_test_highbd(av1_highbd_warp_affine_sse4_1, 10);
+    warp_test_highbd(av1_highbd_warp_affine_sse4_1, 12);
+}
+
+TEST(WarpAffine, highbd_avx2_matches_c)
+{
+    if (GetCpuAsmType() < ASM_AVX2)
+        return;
+    warp_test_highbd(av1_highbd_warp_affine_avx2, 10);
+    warp_test_highbd(av1_highbd_warp_affine_avx2, 12);
+}
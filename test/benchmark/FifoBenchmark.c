@@ -0,0 +1,251 @@
+/*
+* Copyright(c) 2019 Intel Corporation
+* SPDX - License - Identifier: BSD - 2 - Clause - Patent
+*/
+
+// Summary:
+// Measures the object round-trip rate of EbSystemResource_t (the fifos
+// connecting the encoder pipeline stages) with the mutex and semaphore
+// based muxing queues and with the lock-free queues.
+//
+// Each producer process gets an empty object and posts it full, each
+// consumer process gets a full object and releases it. The results are
+// printed as CSV: queue,producers,consumers,objects,ops_per_sec,ns_per_op
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "EbDefinitions.h"
+#include "EbThreads.h"
+#include "EbSystemResourceManager.h"
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <time.h>
+#endif
+
+#define BENCH_MEMORY_MAP_SIZE       (1 << 16)
+#define BENCH_OBJECT_COUNT          16
+#define BENCH_OBJECTS_PER_PRODUCER  200000
+#define BENCH_MAX_PROCESS_COUNT     16
+
+// The library binds it per encoder handle
+EB_THREAD_LOCAL EbMemoryMap *memory_map;
+
+// Thread binding of the library, left to the OS here
+uint8_t                        num_groups = 0;
+#ifdef _WIN32
+EB_THREAD_LOCAL GROUP_AFFINITY group_affinity;
+EB_THREAD_LOCAL EbBool         alternate_groups = 0;
+#else
+EB_THREAD_LOCAL cpu_set_t      group_affinity;
+#endif
+
+typedef struct BenchContext {
+    EbFifo_t   *fifo_ptr;
+    EbHandle    done_semaphore;
+} BenchContext;
+
+static double BenchSeconds(void)
+{
+#ifdef _WIN32
+    LARGE_INTEGER frequency, counter;
+    QueryPerformanceFrequency(&frequency);
+    QueryPerformanceCounter(&counter);
+    return (double)counter.QuadPart / (double)frequency.QuadPart;
+#else
+    struct timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (double)now.tv_sec + (double)now.tv_nsec * 1e-9;
+#endif
+}
+
+/**************************************
+ * Producer: empty -> full
+ **************************************/
+static void* BenchProducerKernel(void *input_ptr)
+{
+    BenchContext      *context_ptr = (BenchContext*)input_ptr;
+    EbObjectWrapper_t *wrapper_ptr;
+    uint32_t           objectIndex;
+
+    for (objectIndex = 0; objectIndex < BENCH_OBJECTS_PER_PRODUCER; ++objectIndex) {
+        eb_get_empty_object(context_ptr->fifo_ptr, &wrapper_ptr);
+        wrapper_ptr->object_ptr = (EbPtr)context_ptr;
+        eb_post_full_object(wrapper_ptr);
+    }
+
+    eb_post_semaphore(context_ptr->done_semaphore);
+
+    return EB_NULL;
+}
+
+/**************************************
+ * Consumer: full -> empty, until a
+ * NULL object is received
+ **************************************/
+static void* BenchConsumerKernel(void *input_ptr)
+{
+    BenchContext      *context_ptr = (BenchContext*)input_ptr;
+    EbObjectWrapper_t *wrapper_ptr;
+    EbBool             stop;
+
+    do {
+        eb_get_full_object(context_ptr->fifo_ptr, &wrapper_ptr);
+        stop = (wrapper_ptr->object_ptr == EB_NULL) ? EB_TRUE : EB_FALSE;
+        eb_release_object(wrapper_ptr);
+    } while (stop == EB_FALSE);
+
+    eb_post_semaphore(context_ptr->done_semaphore);
+
+    return EB_NULL;
+}
+
+/**************************************
+ * Free what the run registered
+ **************************************/
+static void BenchReleaseMemoryMap(
+    EbMemoryMap *map_ptr)
+{
+    while (map_ptr->index) {
+        EbMemoryMapEntry *entry_ptr = &map_ptr->entries[--map_ptr->index];
+        switch (entry_ptr->ptrType) {
+        case EB_N_PTR:
+            free(entry_ptr->ptr);
+            break;
+        case EB_SEMAPHORE:
+            eb_destroy_semaphore(entry_ptr->ptr);
+            break;
+        case EB_MUTEX:
+            eb_destroy_mutex(entry_ptr->ptr);
+            break;
+        default:
+            break;
+        }
+    }
+}
+
+static EbErrorType BenchRun(
+    EbBool      lock_free,
+    uint32_t    producer_count,
+    uint32_t    consumer_count)
+{
+    EbMemoryMap         map;
+    EbSystemResource_t *resource_ptr;
+    EbFifo_t          **producer_fifo_ptr_array;
+    EbFifo_t          **consumer_fifo_ptr_array;
+    BenchContext        producer_context_array[BENCH_MAX_PROCESS_COUNT];
+    BenchContext        consumer_context_array[BENCH_MAX_PROCESS_COUNT];
+    EbHandle            thread_handle_array[2 * BENCH_MAX_PROCESS_COUNT];
+    EbHandle            doneSemaphore;
+    EbObjectWrapper_t  *wrapper_ptr;
+    EbErrorType         return_error;
+    uint32_t            processIndex;
+    uint32_t            threadCount = 0;
+    double              startTime, duration;
+    double              opCount = (double)producer_count * BENCH_OBJECTS_PER_PRODUCER;
+
+    memset(&map, 0, sizeof(EbMemoryMap));
+    map.entries = (EbMemoryMapEntry*)malloc(sizeof(EbMemoryMapEntry) * BENCH_MEMORY_MAP_SIZE);
+    if (map.entries == (EbMemoryMapEntry*)EB_NULL)
+        return EB_ErrorInsufficientResources;
+    map.capacity = BENCH_MEMORY_MAP_SIZE;
+    memory_map = &map;
+
+    eb_system_resource_set_lock_free(lock_free);
+    return_error = eb_system_resource_ctor(
+        &resource_ptr,
+        BENCH_OBJECT_COUNT,
+        producer_count,
+        consumer_count,
+        &producer_fifo_ptr_array,
+        &consumer_fifo_ptr_array,
+        EB_TRUE,
+        EB_NULL,
+        EB_NULL);
+    doneSemaphore = eb_create_semaphore(0, 2 * BENCH_MAX_PROCESS_COUNT);
+    if (return_error != EB_ErrorNone || doneSemaphore == (EbHandle)EB_NULL) {
+        BenchReleaseMemoryMap(&map);
+        free(map.entries);
+        return EB_ErrorInsufficientResources;
+    }
+
+    startTime = BenchSeconds();
+
+    for (processIndex = 0; processIndex < consumer_count; ++processIndex) {
+        consumer_context_array[processIndex].fifo_ptr = consumer_fifo_ptr_array[processIndex];
+        consumer_context_array[processIndex].done_semaphore = doneSemaphore;
+        thread_handle_array[threadCount++] = eb_create_thread(BenchConsumerKernel, &consumer_context_array[processIndex]);
+    }
+    for (processIndex = 0; processIndex < producer_count; ++processIndex) {
+        producer_context_array[processIndex].fifo_ptr = producer_fifo_ptr_array[processIndex];
+        producer_context_array[processIndex].done_semaphore = doneSemaphore;
+        thread_handle_array[threadCount++] = eb_create_thread(BenchProducerKernel, &producer_context_array[processIndex]);
+    }
+
+    for (processIndex = 0; processIndex < producer_count; ++processIndex)
+        eb_block_on_semaphore(doneSemaphore);
+
+    // One stop object per consumer
+    for (processIndex = 0; processIndex < consumer_count; ++processIndex) {
+        eb_get_empty_object(producer_fifo_ptr_array[0], &wrapper_ptr);
+        wrapper_ptr->object_ptr = EB_NULL;
+        eb_post_full_object(wrapper_ptr);
+    }
+
+    for (processIndex = 0; processIndex < consumer_count; ++processIndex)
+        eb_block_on_semaphore(doneSemaphore);
+
+    duration = BenchSeconds() - startTime;
+
+    printf("%s,%u,%u,%u,%.0f,%.1f\n",
+        lock_free ? "lock_free" : "mutex",
+        producer_count,
+        consumer_count,
+        BENCH_OBJECT_COUNT,
+        opCount / duration,
+        duration * 1e9 / opCount);
+    fflush(stdout);
+
+    for (processIndex = 0; processIndex < threadCount; ++processIndex)
+        eb_destroy_thread(thread_handle_array[processIndex]);
+    eb_destroy_semaphore(doneSemaphore);
+
+    BenchReleaseMemoryMap(&map);
+    free(map.entries);
+    memory_map = (EbMemoryMap*)EB_NULL;
+
+    return EB_ErrorNone;
+}
+
+int main(int argc, char *argv[])
+{
+    static const uint32_t processCountArray[] = { 1, 2, 4, 8, 16 };
+    uint32_t maxProcessCount = (argc > 1) ? (uint32_t)atoi(argv[1]) : 8;
+    uint32_t configIndex;
+    int32_t  lockFree;
+
+    if (maxProcessCount > BENCH_MAX_PROCESS_COUNT)
+        maxProcessCount = BENCH_MAX_PROCESS_COUNT;
+
+    printf("queue,producers,consumers,objects,ops_per_sec,ns_per_op\n");
+
+    for (configIndex = 0; configIndex < sizeof(processCountArray) / sizeof(processCountArray[0]); ++configIndex) {
+        if (processCountArray[configIndex] > maxProcessCount)
+            break;
+        for (lockFree = 0; lockFree <= 1; ++lockFree) {
+            if (BenchRun(
+                    lockFree ? EB_TRUE : EB_FALSE,
+                    processCountArray[configIndex],
+                    processCountArray[configIndex]) != EB_ErrorNone)
+            {
+                fprintf(stderr, "Error: benchmark setup failed\n");
+                return 1;
+            }
+        }
+    }
+
+    return 0;
+}
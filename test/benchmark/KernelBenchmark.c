@@ -0,0 +1,595 @@
+/*
+* Copyright(c) 2019 Intel Corporation
+* SPDX - License - Identifier: BSD - 2 - Clause - Patent
+*/
+
+// Summary:
+// Measures the cost of the SIMD kernels the encoder dispatches at run time,
+// in cycles per pixel, for every block size they are called with and every
+// instruction set level they are written for.
+//
+// The aom_dsp_rtcd.h entries are re-dispatched with setup_rtcd_flags() for
+// each level (c, sse2, ssse3, sse4_1, avx2, avx512) and a kernel is only
+// timed at the levels where its pointer changes, so each implementation is
+// reported once, under the lowest level that selects it. Entries without a
+// C version (fft, highbd mse) are left out. The func_ptr_array tables are
+// timed per EbAsm index (non_avx2, avx2, avx512), skipping the indices that
+// repeat the previous one. Levels above what the CPU runs are skipped.
+//
+// The results are printed as CSV: family,kernel,block,isa,cycles_per_pixel
+// An optional argument restricts the run to the families or kernels whose
+// name contains it.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "EbDefinitions.h"
+#include "aom_dsp_rtcd.h"
+#include "convolve.h"
+#include "EbComputeSAD.h"
+#include "EbPictureOperators.h"
+#include "EbCdef.h"
+#include "EbRestoration.h"
+
+#ifdef _WIN32
+#include <intrin.h>
+#else
+#include <x86intrin.h>
+#endif
+
+#define BENCH_STRIDE                320
+#define BENCH_ROWS                  320
+#define BENCH_ORIGIN                (16 * BENCH_STRIDE + 32)   // room for the filter taps and borders
+#define BENCH_PIXELS_PER_RUN        (1 << 18)
+#define BENCH_RUN_COUNT             5
+#define BENCH_TX_COEFF_COUNT        (64 * 64)
+
+extern EbAsm GetCpuAsmType();
+extern InterpFilterParams av1_get_interp_filter_params_with_block_size(
+    const InterpFilter interp_filter, const int32_t w);
+
+typedef void(*BenchFn)(void);
+typedef void(*BenchRun)(BenchFn fn, int32_t width, int32_t height);
+typedef BenchFn(*BenchLookup)(EbAsm asm_type, int32_t width);
+
+/**************************************
+ * Entries of aom_dsp_rtcd.h
+ **************************************/
+typedef struct BenchKernel {
+    const char *family;
+    const char *name;
+    int32_t     width;
+    int32_t     height;
+    BenchFn    *slot;       // dispatched pointer
+    BenchRun    run;
+} BenchKernel;
+
+/**************************************
+ * Entries of the func_ptr_array tables
+ **************************************/
+typedef struct BenchTableKernel {
+    const char *family;
+    const char *name;
+    int32_t     width;
+    int32_t     height;
+    BenchLookup lookup;
+    BenchRun    run;
+} BenchTableKernel;
+
+typedef struct BenchIsa {
+    const char *name;
+    int32_t     flags;
+    EbAsm       min_asm_type;
+} BenchIsa;
+
+static const BenchIsa benchIsaArray[] = {
+    { "c",      0,                                                              ASM_NON_AVX2 },
+    { "sse2",   HAS_MMX | HAS_SSE | HAS_SSE2,                                   ASM_NON_AVX2 },
+    { "ssse3",  HAS_MMX | HAS_SSE | HAS_SSE2 | HAS_SSE3 | HAS_SSSE3,            ASM_NON_AVX2 },
+    { "sse4_1", HAS_MMX | HAS_SSE | HAS_SSE2 | HAS_SSE3 | HAS_SSSE3 | HAS_SSE4_1 | HAS_SSE4_2, ASM_NON_AVX2 },
+    { "avx2",   HAS_MMX | HAS_SSE | HAS_SSE2 | HAS_SSE3 | HAS_SSSE3 | HAS_SSE4_1 | HAS_SSE4_2 | HAS_AVX | HAS_AVX2, ASM_AVX2 },
+    { "avx512", HAS_MMX | HAS_SSE | HAS_SSE2 | HAS_SSE3 | HAS_SSSE3 | HAS_SSE4_1 | HAS_SSE4_2 | HAS_AVX | HAS_AVX2 | HAS_AVX512, ASM_AVX512 },
+};
+
+static const char *benchAsmNameArray[ASM_TYPE_TOTAL] = { "non_avx2", "avx2", "avx512" };
+
+/**************************************
+ * Buffers, filled once with random
+ * samples
+ **************************************/
+DECLARE_ALIGNED(64, static uint8_t, src8Buffer[BENCH_STRIDE * BENCH_ROWS]);
+DECLARE_ALIGNED(64, static uint8_t, ref8Buffer[BENCH_STRIDE * BENCH_ROWS]);
+DECLARE_ALIGNED(64, static uint8_t, dst8Buffer[BENCH_STRIDE * BENCH_ROWS]);
+DECLARE_ALIGNED(64, static uint16_t, src16Buffer[BENCH_STRIDE * BENCH_ROWS]);
+DECLARE_ALIGNED(64, static uint16_t, ref16Buffer[BENCH_STRIDE * BENCH_ROWS]);
+DECLARE_ALIGNED(64, static uint16_t, dst16Buffer[BENCH_STRIDE * BENCH_ROWS]);
+DECLARE_ALIGNED(64, static CONV_BUF_TYPE, convBuffer[BENCH_STRIDE * BENCH_ROWS]);
+DECLARE_ALIGNED(64, static int16_t, residualBuffer[BENCH_TX_COEFF_COUNT]);
+DECLARE_ALIGNED(64, static int32_t, coeffBuffer[BENCH_TX_COEFF_COUNT]);
+DECLARE_ALIGNED(64, static tran_low_t, qcoeffBuffer[BENCH_TX_COEFF_COUNT]);
+DECLARE_ALIGNED(64, static tran_low_t, dqcoeffBuffer[BENCH_TX_COEFF_COUNT]);
+DECLARE_ALIGNED(64, static int16_t, scanBuffer[BENCH_TX_COEFF_COUNT]);
+DECLARE_ALIGNED(64, static int32_t, flt0Buffer[RESTORATION_UNITSIZE_MAX * RESTORATION_UNITSIZE_MAX]);
+DECLARE_ALIGNED(64, static int32_t, flt1Buffer[RESTORATION_UNITSIZE_MAX * RESTORATION_UNITSIZE_MAX]);
+DECLARE_ALIGNED(64, static int32_t, sgrTmpBuffer[RESTORATION_TMPBUF_SIZE]);
+DECLARE_ALIGNED(64, static uint16_t, cdefInBuffer[CDEF_INBUF_SIZE]);
+DECLARE_ALIGNED(64, static int64_t, statsM[WIENER_WIN2]);
+DECLARE_ALIGNED(64, static int64_t, statsH[WIENER_WIN2 * WIENER_WIN2]);
+
+static const int16_t benchWienerTaps[8] = { 3, -7, 15, -22, 15, -7, 3, 0 };
+static const int16_t benchQuantParams[2] = { 64, 48 };     // DC, AC
+
+#define SRC8        (src8Buffer + BENCH_ORIGIN)
+#define REF8        (ref8Buffer + BENCH_ORIGIN)
+#define DST8        (dst8Buffer + BENCH_ORIGIN)
+#define SRC16       (src16Buffer + BENCH_ORIGIN)
+#define REF16       (ref16Buffer + BENCH_ORIGIN)
+#define DST16       (dst16Buffer + BENCH_ORIGIN)
+#define CDEF_IN     (cdefInBuffer + CDEF_VBORDER * CDEF_BSTRIDE + CDEF_HBORDER)
+
+static void BenchFillBuffers(void)
+{
+    int32_t i;
+
+    srand(1);
+    for (i = 0; i < BENCH_STRIDE * BENCH_ROWS; ++i) {
+        src8Buffer[i] = (uint8_t)(rand() & 0xFF);
+        ref8Buffer[i] = (uint8_t)((src8Buffer[i] + (rand() & 0xF)) & 0xFF);
+        src16Buffer[i] = (uint16_t)(rand() & 0x3FF);
+        ref16Buffer[i] = (uint16_t)((src16Buffer[i] + (rand() & 0x3F)) & 0x3FF);
+    }
+    for (i = 0; i < BENCH_TX_COEFF_COUNT; ++i) {
+        residualBuffer[i] = (int16_t)((rand() & 0x1FF) - 256);
+        coeffBuffer[i] = (rand() & 0x7F) - 64;
+        scanBuffer[i] = (int16_t)i;
+    }
+    for (i = 0; i < CDEF_INBUF_SIZE; ++i)
+        cdefInBuffer[i] = (uint16_t)(rand() & 0xFF);
+}
+
+/**************************************
+ * Runners, one per signature
+ **************************************/
+typedef void(*IntraLbdFn)(uint8_t *dst, ptrdiff_t y_stride, const uint8_t *above, const uint8_t *left);
+typedef void(*IntraHbdFn)(uint16_t *dst, ptrdiff_t y_stride, const uint16_t *above, const uint16_t *left, int32_t bd);
+typedef void(*FwdTxfmFn)(int16_t *input, int32_t *output, uint32_t input_stride, TxType transform_type, uint8_t bit_depth);
+typedef void(*InvTxfmFn)(const int32_t *input, uint16_t *output, int32_t stride, TxType tx_type, int32_t bd);
+typedef void(*InvTxfmSizeFn)(const int32_t *input, uint16_t *output, int32_t stride, TxType tx_type, TxSize tx_size, int32_t bd);
+typedef void(*InvTxfmEobFn)(const int32_t *input, uint16_t *output, int32_t stride, TxType tx_type, TxSize tx_size, int32_t eob, int32_t bd);
+typedef void(*QuantizeFn)(const tran_low_t *coeff_ptr, intptr_t n_coeffs, int32_t skip_block, const int16_t *zbin_ptr, const int16_t *round_ptr, const int16_t *quant_ptr, const int16_t *quant_shift_ptr, tran_low_t *qcoeff_ptr, tran_low_t *dqcoeff_ptr, const int16_t *dequant_ptr, uint16_t *eob_ptr, const int16_t *scan, const int16_t *iscan);
+typedef void(*ConvolveLbdFn)(const uint8_t *src, int32_t src_stride, uint8_t *dst, int32_t dst_stride, int32_t w, int32_t h, InterpFilterParams *filter_params_x, InterpFilterParams *filter_params_y, const int32_t subpel_x_q4, const int32_t subpel_y_q4, ConvolveParams *conv_params);
+typedef void(*CdefFilterFn)(uint8_t *dst8, uint16_t *dst16, int32_t dstride, const uint16_t *in, int32_t pri_strength, int32_t sec_strength, int32_t dir, int32_t pri_damping, int32_t sec_damping, int32_t bsize, int32_t max, int32_t coeff_shift);
+typedef int32_t(*CdefDirFn)(const uint16_t *img, int32_t stride, int32_t *var, int32_t coeff_shift);
+typedef void(*WienerLbdFn)(const uint8_t *src, ptrdiff_t src_stride, uint8_t *dst, ptrdiff_t dst_stride, const int16_t *filter_x, int32_t x_step_q4, const int16_t *filter_y, int32_t y_step_q4, int32_t w, int32_t h, const ConvolveParams *conv_params);
+typedef void(*WienerHbdFn)(const uint8_t *src, ptrdiff_t src_stride, uint8_t *dst, ptrdiff_t dst_stride, const int16_t *filter_x, int32_t x_step_q4, const int16_t *filter_y, int32_t y_step_q4, int32_t w, int32_t h, const ConvolveParams *conv_params, int32_t bps);
+typedef void(*SelfguidedFn)(const uint8_t *dgd8, int32_t width, int32_t height, int32_t stride, int32_t *flt0, int32_t *flt1, int32_t flt_stride, int32_t sgr_params_idx, int32_t bit_depth, int32_t highbd);
+typedef void(*ApplySelfguidedFn)(const uint8_t *dat, int32_t width, int32_t height, int32_t stride, int32_t eps, const int32_t *xqd, uint8_t *dst, int32_t dst_stride, int32_t *tmpbuf, int32_t bit_depth, int32_t highbd);
+typedef void(*ComputeStatsFn)(int32_t wiener_win, const uint8_t *dgd8, const uint8_t *src8, int32_t h_start, int32_t h_end, int32_t v_start, int32_t v_end, int32_t dgd_stride, int32_t src_stride, int64_t *M, int64_t *H);
+typedef void(*ComputeStatsHbdFn)(int32_t wiener_win, const uint8_t *dgd8, const uint8_t *src8, int32_t h_start, int32_t h_end, int32_t v_start, int32_t v_end, int32_t dgd_stride, int32_t src_stride, int64_t *M, int64_t *H, aom_bit_depth_t bit_depth);
+typedef int64_t(*ProjErrorFn)(const uint8_t *src8, int32_t width, int32_t height, int32_t src_stride, const uint8_t *dat8, int32_t dat_stride, int32_t *flt0, int32_t flt0_stride, int32_t *flt1, int32_t flt1_stride, int32_t xq[2], const sgr_params_type *params);
+
+static void RunIntraLbd(BenchFn fn, int32_t width, int32_t height)
+{
+    (void)width;
+    (void)height;
+    ((IntraLbdFn)fn)(DST8, BENCH_STRIDE, SRC8 - BENCH_STRIDE, SRC8 - 1);
+}
+
+static void RunIntraHbd(BenchFn fn, int32_t width, int32_t height)
+{
+    (void)width;
+    (void)height;
+    ((IntraHbdFn)fn)(DST16, BENCH_STRIDE, SRC16 - BENCH_STRIDE, SRC16 - 1, 10);
+}
+
+static void RunFwdTxfm(BenchFn fn, int32_t width, int32_t height)
+{
+    (void)height;
+    ((FwdTxfmFn)fn)(residualBuffer, coeffBuffer, width, DCT_DCT, 8);
+}
+
+static TxSize BenchTxSize(int32_t width, int32_t height)
+{
+    int32_t txSize;
+
+    for (txSize = 0; txSize < TX_SIZES_ALL; ++txSize) {
+        if (tx_size_wide[txSize] == width && tx_size_high[txSize] == height)
+            break;
+    }
+    return (TxSize)txSize;
+}
+
+// The square sizes take no size, the 4xN and Nx4 ones a size and the
+// others a size and the end of block
+static void RunInvTxfm(BenchFn fn, int32_t width, int32_t height)
+{
+    const TxSize txSize = BenchTxSize(width, height);
+
+    if (width == height)
+        ((InvTxfmFn)fn)(coeffBuffer, DST16, BENCH_STRIDE, DCT_DCT, 8);
+    else if (width == 4 || height == 4)
+        ((InvTxfmSizeFn)fn)(coeffBuffer, DST16, BENCH_STRIDE, DCT_DCT, txSize, 8);
+    else
+        ((InvTxfmEobFn)fn)(coeffBuffer, DST16, BENCH_STRIDE, DCT_DCT, txSize,
+            MIN(width, 32) * MIN(height, 32), 8);
+}
+
+static void RunQuantize(BenchFn fn, int32_t width, int32_t height)
+{
+    uint16_t eob;
+    // The 64 wide transforms code their top left 32x32 coefficients
+    const intptr_t coeffCount = MIN(width, 32) * MIN(height, 32);
+
+    ((QuantizeFn)fn)((const tran_low_t*)coeffBuffer, coeffCount, 0,
+        benchQuantParams, benchQuantParams, benchQuantParams, benchQuantParams,
+        qcoeffBuffer, dqcoeffBuffer, benchQuantParams, &eob, scanBuffer, scanBuffer);
+}
+
+static void RunConvolve(BenchFn fn, int32_t width, int32_t height, int32_t isCompound)
+{
+    InterpFilterParams filterX = av1_get_interp_filter_params_with_block_size(EIGHTTAP_REGULAR, width);
+    InterpFilterParams filterY = av1_get_interp_filter_params_with_block_size(EIGHTTAP_REGULAR, height);
+    ConvolveParams convParams = get_conv_params_no_round(0, 0, 0, convBuffer, BENCH_STRIDE, isCompound, 8);
+
+    ((ConvolveLbdFn)fn)(SRC8, BENCH_STRIDE, DST8, BENCH_STRIDE, width, height,
+        &filterX, &filterY, 8, 8, &convParams);
+}
+
+static void RunConvolveSr(BenchFn fn, int32_t width, int32_t height)
+{
+    RunConvolve(fn, width, height, 0);
+}
+
+static void RunConvolveJnt(BenchFn fn, int32_t width, int32_t height)
+{
+    RunConvolve(fn, width, height, 1);
+}
+
+static void RunConvolveHbd(BenchFn fn, int32_t width, int32_t height, int32_t isCompound)
+{
+    InterpFilterParams filterX = av1_get_interp_filter_params_with_block_size(EIGHTTAP_REGULAR, width);
+    InterpFilterParams filterY = av1_get_interp_filter_params_with_block_size(EIGHTTAP_REGULAR, height);
+    ConvolveParams convParams = get_conv_params_no_round(0, 0, 0, convBuffer, BENCH_STRIDE, isCompound, 10);
+
+    ((aom_highbd_convolve_fn_t)fn)(SRC16, BENCH_STRIDE, DST16, BENCH_STRIDE, width, height,
+        &filterX, &filterY, 8, 8, &convParams, 10);
+}
+
+static void RunConvolveHbdSr(BenchFn fn, int32_t width, int32_t height)
+{
+    RunConvolveHbd(fn, width, height, 0);
+}
+
+static void RunConvolveHbdJnt(BenchFn fn, int32_t width, int32_t height)
+{
+    RunConvolveHbd(fn, width, height, 1);
+}
+
+static void RunCdefFilter(BenchFn fn, int32_t width, int32_t height)
+{
+    const int32_t bsize = (width == 8) ?
+        ((height == 8) ? BLOCK_8X8 : BLOCK_8X4) :
+        ((height == 8) ? BLOCK_4X8 : BLOCK_4X4);
+
+    ((CdefFilterFn)fn)(DST8, NULL, BENCH_STRIDE, CDEF_IN, 4, 2, 3, 5, 5, bsize, 255, 0);
+}
+
+static void RunCdefDir(BenchFn fn, int32_t width, int32_t height)
+{
+    int32_t var;
+
+    (void)width;
+    (void)height;
+    ((CdefDirFn)fn)(CDEF_IN, CDEF_BSTRIDE, &var, 0);
+}
+
+static void RunWienerLbd(BenchFn fn, int32_t width, int32_t height)
+{
+    const ConvolveParams convParams = get_conv_params_wiener(8);
+
+    ((WienerLbdFn)fn)(SRC8, BENCH_STRIDE, DST8, BENCH_STRIDE,
+        benchWienerTaps, 16, benchWienerTaps, 16, width, height, &convParams);
+}
+
+static void RunWienerHbd(BenchFn fn, int32_t width, int32_t height)
+{
+    const ConvolveParams convParams = get_conv_params_wiener(10);
+
+    ((WienerHbdFn)fn)(CONVERT_TO_BYTEPTR(SRC16), BENCH_STRIDE, CONVERT_TO_BYTEPTR(DST16), BENCH_STRIDE,
+        benchWienerTaps, 16, benchWienerTaps, 16, width, height, &convParams, 10);
+}
+
+static void RunSelfguidedLbd(BenchFn fn, int32_t width, int32_t height)
+{
+    ((SelfguidedFn)fn)(SRC8, width, height, BENCH_STRIDE, flt0Buffer, flt1Buffer, width, 0, 8, 0);
+}
+
+static void RunSelfguidedHbd(BenchFn fn, int32_t width, int32_t height)
+{
+    ((SelfguidedFn)fn)(CONVERT_TO_BYTEPTR(SRC16), width, height, BENCH_STRIDE, flt0Buffer, flt1Buffer, width, 0, 10, 1);
+}
+
+static void RunApplySelfguidedLbd(BenchFn fn, int32_t width, int32_t height)
+{
+    static const int32_t xqd[2] = { -32, 31 };
+
+    ((ApplySelfguidedFn)fn)(SRC8, width, height, BENCH_STRIDE, 0, xqd, DST8, BENCH_STRIDE, sgrTmpBuffer, 8, 0);
+}
+
+static void RunComputeStatsLbd(BenchFn fn, int32_t width, int32_t height)
+{
+    ((ComputeStatsFn)fn)(WIENER_WIN, REF8, SRC8, 0, width, 0, height, BENCH_STRIDE, BENCH_STRIDE, statsM, statsH);
+}
+
+static void RunComputeStatsHbd(BenchFn fn, int32_t width, int32_t height)
+{
+    ((ComputeStatsHbdFn)fn)(WIENER_WIN, CONVERT_TO_BYTEPTR(REF16), CONVERT_TO_BYTEPTR(SRC16),
+        0, width, 0, height, BENCH_STRIDE, BENCH_STRIDE, statsM, statsH, AOM_BITS_10);
+}
+
+static void RunProjErrorLbd(BenchFn fn, int32_t width, int32_t height)
+{
+    int32_t xq[2] = { -32, 31 };
+
+    ((ProjErrorFn)fn)(SRC8, width, height, BENCH_STRIDE, REF8, BENCH_STRIDE,
+        flt0Buffer, width, flt1Buffer, width, xq, &sgr_params[0]);
+}
+
+static void RunSad(BenchFn fn, int32_t width, int32_t height)
+{
+    ((EB_SADKERNELNxM_TYPE)fn)(SRC8, BENCH_STRIDE, REF8, BENCH_STRIDE, height, width);
+}
+
+static void RunCombinedAveragingSsd(BenchFn fn, int32_t width, int32_t height)
+{
+    ((CombinedAveragingSsd)fn)(SRC8, BENCH_STRIDE, REF8, BENCH_STRIDE, DST8, BENCH_STRIDE, height, width);
+}
+
+#if M0_SPATIAL_SSE || SPATIAL_SSE_I_B_SLICES || M0_SSD_HALF_QUARTER_PEL_BIPRED_SEARCH
+static void RunSpatialFullDistortion(BenchFn fn, int32_t width, int32_t height)
+{
+    ((EB_SPATIALFULLDIST_TYPE)fn)(SRC8, BENCH_STRIDE, REF8, BENCH_STRIDE, width, height);
+}
+#endif
+
+/**************************************
+ * Table lookups
+ **************************************/
+static BenchFn LookupSad(EbAsm asm_type, int32_t width)
+{
+    return (BenchFn)NxMSadKernel_funcPtrArray[asm_type][width >> 3];
+}
+
+static BenchFn LookupCombinedAveragingSsd(EbAsm asm_type, int32_t width)
+{
+    (void)width;
+    return (BenchFn)combined_averaging_ssd_func_ptr_array[asm_type];
+}
+
+#if M0_SPATIAL_SSE || SPATIAL_SSE_I_B_SLICES || M0_SSD_HALF_QUARTER_PEL_BIPRED_SEARCH
+static BenchFn LookupSpatialFullDistortion(EbAsm asm_type, int32_t width)
+{
+    int32_t sizeIndex = 0;
+
+    while ((4 << sizeIndex) < width)
+        sizeIndex++;
+    return (BenchFn)spatial_full_distortion_kernel_func_ptr_array[asm_type][sizeIndex];
+}
+#endif
+
+/**************************************
+ * Kernel lists
+ **************************************/
+#define BENCH_INTRA_SIZES(X, mode) \
+    X(mode, 4, 4) X(mode, 4, 8) X(mode, 4, 16) \
+    X(mode, 8, 4) X(mode, 8, 8) X(mode, 8, 16) X(mode, 8, 32) \
+    X(mode, 16, 4) X(mode, 16, 8) X(mode, 16, 16) X(mode, 16, 32) X(mode, 16, 64) \
+    X(mode, 32, 8) X(mode, 32, 16) X(mode, 32, 32) X(mode, 32, 64) \
+    X(mode, 64, 16) X(mode, 64, 32) X(mode, 64, 64)
+
+#define BENCH_INTRA_MODES(X) \
+    BENCH_INTRA_SIZES(X, dc) BENCH_INTRA_SIZES(X, dc_left) BENCH_INTRA_SIZES(X, dc_top) \
+    BENCH_INTRA_SIZES(X, dc_128) BENCH_INTRA_SIZES(X, v) BENCH_INTRA_SIZES(X, h) \
+    BENCH_INTRA_SIZES(X, smooth) BENCH_INTRA_SIZES(X, smooth_v) BENCH_INTRA_SIZES(X, smooth_h)
+
+#define BENCH_INTRA_LBD(mode, w, h) \
+    { "intra", #mode, w, h, (BenchFn*)&aom_##mode##_predictor_##w##x##h, RunIntraLbd },
+#define BENCH_INTRA_HBD(mode, w, h) \
+    { "intra_highbd", #mode, w, h, (BenchFn*)&aom_highbd_##mode##_predictor_##w##x##h, RunIntraHbd },
+
+#define BENCH_TXFM_SIZES(X) \
+    X(4, 4) X(8, 8) X(16, 16) X(32, 32) X(64, 64) \
+    X(4, 8) X(8, 4) X(8, 16) X(16, 8) X(16, 32) X(32, 16) X(32, 64) X(64, 32) \
+    X(4, 16) X(16, 4) X(8, 32) X(32, 8) X(16, 64) X(64, 16)
+
+#define BENCH_FWD_TXFM(w, h) \
+    { "fwd_txfm", "dct_dct", w, h, (BenchFn*)&av1_fwd_txfm2d_##w##x##h, RunFwdTxfm },
+#define BENCH_INV_TXFM(w, h) \
+    { "inv_txfm", "dct_dct", w, h, (BenchFn*)&av1_inv_txfm2d_add_##w##x##h, RunInvTxfm },
+
+#define BENCH_CONVOLVE_SIZES(X, family, name, fn, run) \
+    X(family, name, fn, run, 4, 4) X(family, name, fn, run, 8, 8) X(family, name, fn, run, 16, 16) \
+    X(family, name, fn, run, 32, 32) X(family, name, fn, run, 64, 64) X(family, name, fn, run, 128, 128)
+
+#define BENCH_ENTRY(family, name, fn, run, w, h) \
+    { family, name, w, h, (BenchFn*)&fn, run },
+
+static const BenchKernel benchKernelArray[] = {
+    BENCH_INTRA_MODES(BENCH_INTRA_LBD)
+    BENCH_INTRA_MODES(BENCH_INTRA_HBD)
+
+    BENCH_TXFM_SIZES(BENCH_FWD_TXFM)
+    BENCH_TXFM_SIZES(BENCH_INV_TXFM)
+
+    BENCH_ENTRY("quantize", "quantize_b", aom_quantize_b, RunQuantize, 4, 4)
+    BENCH_ENTRY("quantize", "quantize_b", aom_quantize_b, RunQuantize, 8, 8)
+    BENCH_ENTRY("quantize", "quantize_b", aom_quantize_b, RunQuantize, 16, 16)
+    BENCH_ENTRY("quantize", "quantize_b_32x32", aom_quantize_b_32x32, RunQuantize, 32, 32)
+    BENCH_ENTRY("quantize", "quantize_b_64x64", aom_quantize_b_64x64, RunQuantize, 64, 64)
+    BENCH_ENTRY("quantize", "highbd_quantize_b", aom_highbd_quantize_b, RunQuantize, 16, 16)
+    BENCH_ENTRY("quantize", "highbd_quantize_b_32x32", aom_highbd_quantize_b_32x32, RunQuantize, 32, 32)
+    BENCH_ENTRY("quantize", "highbd_quantize_b_64x64", aom_highbd_quantize_b_64x64, RunQuantize, 64, 64)
+
+    BENCH_CONVOLVE_SIZES(BENCH_ENTRY, "convolve", "2d_sr", av1_convolve_2d_sr, RunConvolveSr)
+    BENCH_CONVOLVE_SIZES(BENCH_ENTRY, "convolve", "x_sr", av1_convolve_x_sr, RunConvolveSr)
+    BENCH_CONVOLVE_SIZES(BENCH_ENTRY, "convolve", "y_sr", av1_convolve_y_sr, RunConvolveSr)
+    BENCH_CONVOLVE_SIZES(BENCH_ENTRY, "convolve", "2d_copy_sr", av1_convolve_2d_copy_sr, RunConvolveSr)
+    BENCH_CONVOLVE_SIZES(BENCH_ENTRY, "convolve", "jnt_2d", av1_jnt_convolve_2d, RunConvolveJnt)
+    BENCH_CONVOLVE_SIZES(BENCH_ENTRY, "convolve", "jnt_x", av1_jnt_convolve_x, RunConvolveJnt)
+    BENCH_CONVOLVE_SIZES(BENCH_ENTRY, "convolve", "jnt_y", av1_jnt_convolve_y, RunConvolveJnt)
+    BENCH_CONVOLVE_SIZES(BENCH_ENTRY, "convolve", "jnt_2d_copy", av1_jnt_convolve_2d_copy, RunConvolveJnt)
+    BENCH_CONVOLVE_SIZES(BENCH_ENTRY, "convolve_highbd", "2d_sr", av1_highbd_convolve_2d_sr, RunConvolveHbdSr)
+    BENCH_CONVOLVE_SIZES(BENCH_ENTRY, "convolve_highbd", "x_sr", av1_highbd_convolve_x_sr, RunConvolveHbdSr)
+    BENCH_CONVOLVE_SIZES(BENCH_ENTRY, "convolve_highbd", "y_sr", av1_highbd_convolve_y_sr, RunConvolveHbdSr)
+    BENCH_CONVOLVE_SIZES(BENCH_ENTRY, "convolve_highbd", "2d_copy_sr", av1_highbd_convolve_2d_copy_sr, RunConvolveHbdSr)
+    BENCH_CONVOLVE_SIZES(BENCH_ENTRY, "convolve_highbd", "jnt_2d", av1_highbd_jnt_convolve_2d, RunConvolveHbdJnt)
+    BENCH_CONVOLVE_SIZES(BENCH_ENTRY, "convolve_highbd", "jnt_x", av1_highbd_jnt_convolve_x, RunConvolveHbdJnt)
+    BENCH_CONVOLVE_SIZES(BENCH_ENTRY, "convolve_highbd", "jnt_y", av1_highbd_jnt_convolve_y, RunConvolveHbdJnt)
+    BENCH_CONVOLVE_SIZES(BENCH_ENTRY, "convolve_highbd", "jnt_2d_copy", av1_highbd_jnt_convolve_2d_copy, RunConvolveHbdJnt)
+
+    BENCH_ENTRY("cdef", "filter_block", cdef_filter_block, RunCdefFilter, 4, 4)
+    BENCH_ENTRY("cdef", "filter_block", cdef_filter_block, RunCdefFilter, 4, 8)
+    BENCH_ENTRY("cdef", "filter_block", cdef_filter_block, RunCdefFilter, 8, 4)
+    BENCH_ENTRY("cdef", "filter_block", cdef_filter_block, RunCdefFilter, 8, 8)
+    BENCH_ENTRY("cdef", "find_dir", cdef_find_dir, RunCdefDir, 8, 8)
+
+    BENCH_ENTRY("restoration", "wiener_convolve_add_src", av1_wiener_convolve_add_src, RunWienerLbd, 32, 32)
+    BENCH_ENTRY("restoration", "wiener_convolve_add_src", av1_wiener_convolve_add_src, RunWienerLbd, 64, 64)
+    BENCH_ENTRY("restoration", "highbd_wiener_convolve_add_src", av1_highbd_wiener_convolve_add_src, RunWienerHbd, 32, 32)
+    BENCH_ENTRY("restoration", "highbd_wiener_convolve_add_src", av1_highbd_wiener_convolve_add_src, RunWienerHbd, 64, 64)
+    BENCH_ENTRY("restoration", "selfguided_restoration", av1_selfguided_restoration, RunSelfguidedLbd, 64, 64)
+    BENCH_ENTRY("restoration", "highbd_selfguided_restoration", av1_selfguided_restoration, RunSelfguidedHbd, 64, 64)
+    BENCH_ENTRY("restoration", "apply_selfguided_restoration", apply_selfguided_restoration, RunApplySelfguidedLbd, 64, 64)
+    BENCH_ENTRY("restoration", "compute_stats", av1_compute_stats, RunComputeStatsLbd, 64, 64)
+    BENCH_ENTRY("restoration", "compute_stats_highbd", av1_compute_stats_highbd, RunComputeStatsHbd, 64, 64)
+    BENCH_ENTRY("restoration", "lowbd_pixel_proj_error", av1_lowbd_pixel_proj_error, RunProjErrorLbd, 64, 64)
+};
+
+#define BENCH_TABLE_ENTRY(family, name, lookup, run, w, h) \
+    { family, name, w, h, lookup, run },
+
+static const BenchTableKernel benchTableKernelArray[] = {
+    BENCH_TABLE_ENTRY("sad", "nxm_sad_kernel", LookupSad, RunSad, 4, 4)
+    BENCH_TABLE_ENTRY("sad", "nxm_sad_kernel", LookupSad, RunSad, 8, 8)
+    BENCH_TABLE_ENTRY("sad", "nxm_sad_kernel", LookupSad, RunSad, 16, 16)
+    BENCH_TABLE_ENTRY("sad", "nxm_sad_kernel", LookupSad, RunSad, 24, 24)
+    BENCH_TABLE_ENTRY("sad", "nxm_sad_kernel", LookupSad, RunSad, 32, 32)
+    BENCH_TABLE_ENTRY("sad", "nxm_sad_kernel", LookupSad, RunSad, 48, 48)
+    BENCH_TABLE_ENTRY("sad", "nxm_sad_kernel", LookupSad, RunSad, 64, 64)
+    BENCH_TABLE_ENTRY("variance", "combined_averaging_ssd", LookupCombinedAveragingSsd, RunCombinedAveragingSsd, 8, 8)
+    BENCH_TABLE_ENTRY("variance", "combined_averaging_ssd", LookupCombinedAveragingSsd, RunCombinedAveragingSsd, 16, 16)
+    BENCH_TABLE_ENTRY("variance", "combined_averaging_ssd", LookupCombinedAveragingSsd, RunCombinedAveragingSsd, 32, 32)
+    BENCH_TABLE_ENTRY("variance", "combined_averaging_ssd", LookupCombinedAveragingSsd, RunCombinedAveragingSsd, 64, 64)
+#if M0_SPATIAL_SSE || SPATIAL_SSE_I_B_SLICES || M0_SSD_HALF_QUARTER_PEL_BIPRED_SEARCH
+    BENCH_TABLE_ENTRY("variance", "spatial_full_distortion", LookupSpatialFullDistortion, RunSpatialFullDistortion, 4, 4)
+    BENCH_TABLE_ENTRY("variance", "spatial_full_distortion", LookupSpatialFullDistortion, RunSpatialFullDistortion, 8, 8)
+    BENCH_TABLE_ENTRY("variance", "spatial_full_distortion", LookupSpatialFullDistortion, RunSpatialFullDistortion, 16, 16)
+    BENCH_TABLE_ENTRY("variance", "spatial_full_distortion", LookupSpatialFullDistortion, RunSpatialFullDistortion, 32, 32)
+    BENCH_TABLE_ENTRY("variance", "spatial_full_distortion", LookupSpatialFullDistortion, RunSpatialFullDistortion, 64, 64)
+#endif
+};
+
+#define BENCH_KERNEL_COUNT          (sizeof(benchKernelArray) / sizeof(benchKernelArray[0]))
+#define BENCH_TABLE_KERNEL_COUNT    (sizeof(benchTableKernelArray) / sizeof(benchTableKernelArray[0]))
+#define BENCH_ISA_COUNT             (sizeof(benchIsaArray) / sizeof(benchIsaArray[0]))
+
+/**************************************
+ * Timing: best of BENCH_RUN_COUNT runs
+ * of about BENCH_PIXELS_PER_RUN pixels
+ **************************************/
+static double BenchCyclesPerPixel(
+    BenchRun run,
+    BenchFn  fn,
+    int32_t  width,
+    int32_t  height)
+{
+    const int32_t pixelCount = width * height;
+    const int32_t iterationCount = MAX(BENCH_PIXELS_PER_RUN / pixelCount, 1);
+    uint64_t bestCycles = ~0ull;
+    int32_t runIndex, iterationIndex;
+
+    // Warm up the caches and the branch predictors
+    for (iterationIndex = 0; iterationIndex < iterationCount; ++iterationIndex)
+        run(fn, width, height);
+
+    for (runIndex = 0; runIndex < BENCH_RUN_COUNT; ++runIndex) {
+        const uint64_t start = __rdtsc();
+        uint64_t cycles;
+
+        for (iterationIndex = 0; iterationIndex < iterationCount; ++iterationIndex)
+            run(fn, width, height);
+
+        cycles = __rdtsc() - start;
+        bestCycles = MIN(bestCycles, cycles);
+    }
+
+    return (double)bestCycles / ((double)iterationCount * pixelCount);
+}
+
+static EbBool BenchSelected(
+    const char *filter,
+    const char *family,
+    const char *name)
+{
+    return (filter == NULL || strstr(family, filter) || strstr(name, filter)) ? EB_TRUE : EB_FALSE;
+}
+
+int main(int argc, char *argv[])
+{
+    const char *filter = (argc > 1) ? argv[1] : NULL;
+    const EbAsm cpuAsmType = GetCpuAsmType();
+    BenchFn lastFnArray[BENCH_KERNEL_COUNT];
+    uint32_t isaIndex, kernelIndex;
+    int32_t asmIndex;
+
+    BenchFillBuffers();
+    memset(lastFnArray, 0, sizeof(lastFnArray));
+
+    printf("family,kernel,block,isa,cycles_per_pixel\n");
+
+    for (isaIndex = 0; isaIndex < BENCH_ISA_COUNT; ++isaIndex) {
+        const BenchIsa *isa = &benchIsaArray[isaIndex];
+
+        if (isa->min_asm_type > cpuAsmType)
+            break;
+
+        setup_rtcd_flags(isa->flags);
+
+        for (kernelIndex = 0; kernelIndex < BENCH_KERNEL_COUNT; ++kernelIndex) {
+            const BenchKernel *kernel = &benchKernelArray[kernelIndex];
+            const BenchFn fn = *kernel->slot;
+
+            if (fn == lastFnArray[kernelIndex])
+                continue;
+            lastFnArray[kernelIndex] = fn;
+
+            if (BenchSelected(filter, kernel->family, kernel->name) == EB_FALSE)
+                continue;
+
+            printf("%s,%s,%dx%d,%s,%.3f\n", kernel->family, kernel->name, kernel->width, kernel->height,
+                isa->name, BenchCyclesPerPixel(kernel->run, fn, kernel->width, kernel->height));
+            fflush(stdout);
+        }
+    }
+
+    for (kernelIndex = 0; kernelIndex < BENCH_TABLE_KERNEL_COUNT; ++kernelIndex) {
+        const BenchTableKernel *kernel = &benchTableKernelArray[kernelIndex];
+
+        if (BenchSelected(filter, kernel->family, kernel->name) == EB_FALSE)
+            continue;
+
+        for (asmIndex = ASM_NON_AVX2; asmIndex <= (int32_t)cpuAsmType; ++asmIndex) {
+            const BenchFn fn = kernel->lookup((EbAsm)asmIndex, kernel->width);
+
+            if (asmIndex > ASM_NON_AVX2 && fn == kernel->lookup((EbAsm)(asmIndex - 1), kernel->width))
+                continue;
+
+            printf("%s,%s,%dx%d,%s,%.3f\n", kernel->family, kernel->name, kernel->width, kernel->height,
+                benchAsmNameArray[asmIndex], BenchCyclesPerPixel(kernel->run, fn, kernel->width, kernel->height));
+            fflush(stdout);
+        }
+    }
+
+    return 0;
+}